@@ -2115,7 +2115,7 @@ class AMDSMICommands():
                     }
 
                 try:
-                    violation_status = amdsmi_interface.amdsmi_get_violation_status(args.gpu)
+                    violation_status = self.helpers.get_violation_status(args.gpu)
                     throttle_status['accumulation_counter'] = violation_status['acc_counter']
                     throttle_status['prochot_accumulated'] = violation_status['acc_prochot_thrm']
                     throttle_status['ppt_accumulated'] = violation_status['acc_ppt_pwr']
@@ -4816,7 +4816,7 @@ class AMDSMICommands():
                 "hbm_tviol": "N/A",
             }
             try:
-                violations = amdsmi_interface.amdsmi_get_violation_status(args.gpu)
+                violations = self.helpers.get_violation_status(args.gpu)
                 violation_status['pviol'] = violations['per_ppt_pwr']
                 violation_status['tviol'] = violations['per_socket_thrm']
                 violation_status['phot_tviol'] = violations['per_prochot_thrm']
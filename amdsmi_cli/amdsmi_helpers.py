@@ -657,6 +657,22 @@ class AMDSMIHelpers():
         return gpu_bdfs
 
 
+    def get_violation_status(self, device_handle):
+        """Return the violation status of a GPU over a non-empty window
+
+        amdsmi_get_violation_status() only records a baseline on the first
+        call for a GPU, so a one-shot command samples again once the firmware
+        updated its accumulators (fastest SMU sample time is 100 ms).
+
+        param device_handle: GPU device handle
+        """
+        violation_status = amdsmi_interface.amdsmi_get_violation_status(device_handle)
+        if violation_status['window_us'] == "N/A":
+            time.sleep(0.1)
+            violation_status = amdsmi_interface.amdsmi_get_violation_status(device_handle)
+        return violation_status
+
+
     def is_amd_device(self, device_handle):
         """ Return whether the specified device is an AMD device or not
 
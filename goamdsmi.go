@@ -45,6 +45,7 @@ package goamdsmi
 #include <amdsmi_go_shim.h>
 */
 import "C"
+import "unsafe"
 
 //GPU ROCM or AMDSMI calls
 func GO_gpu_init() (bool) {
@@ -143,6 +144,23 @@ func GO_gpu_dev_gpu_memory_total_get (i int) (C.uint64_t) {
 	return C.goamdsmi_gpu_dev_gpu_memory_total_get(C.uint(i))
 }
 
+// GO_gpu_dev_fields_get reads all fieldIds (amdsmi_field_id_t) of a GPU in one
+// call. It returns one value and one amdsmi_status_t per field; signed fields
+// are returned as their uint64 bit pattern.
+func GO_gpu_dev_fields_get(i int, fieldIds []uint32) ([]uint64, []uint32) {
+	values := make([]uint64, len(fieldIds))
+	status := make([]uint32, len(fieldIds))
+	if len(fieldIds) == 0 {
+		return values, status
+	}
+	C.goamdsmi_gpu_dev_fields_get(C.uint(i),
+		(*C.uint32_t)(unsafe.Pointer(&fieldIds[0])),
+		(*C.uint64_t)(unsafe.Pointer(&values[0])),
+		(*C.uint32_t)(unsafe.Pointer(&status[0])),
+		C.uint32_t(len(fieldIds)))
+	return values, status
+}
+
 //CPU ESMI or AMDSMI calls
 func GO_cpu_init() (bool) {
 	return bool(C.goamdsmi_cpu_init())
@@ -37,6 +37,7 @@
  */
 
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include "amdsmi_go_shim.h"
 #include <amd_smi/amdsmi.h>
@@ -674,3 +675,36 @@ uint64_t goamdsmi_gpu_dev_gpu_memory_total_get(uint32_t dv_ind)
         
     return gpu_memory_total;
 }
+
+uint32_t goamdsmi_gpu_dev_fields_get(uint32_t dv_ind, const uint32_t* field_ids, uint64_t* values, uint32_t* status, uint32_t num_fields)
+{
+    uint32_t num_read              = GOAMDSMI_VALUE_0;
+    amdsmi_field_value_t* fields   = nullptr;
+
+    if ((dv_ind >= num_gpu_devices_inAllSocket) || (nullptr == field_ids) || (nullptr == values) || (nullptr == status) || (GOAMDSMI_VALUE_0 == num_fields)) return num_read;
+
+    fields = (amdsmi_field_value_t*)calloc(num_fields, sizeof(amdsmi_field_value_t));
+    if (nullptr == fields) return num_read;
+
+    for (uint32_t field_ind = 0; field_ind < num_fields; field_ind++)
+    {
+        fields[field_ind].field_id = (amdsmi_field_id_t)field_ids[field_ind];
+        values[field_ind]          = GOAMDSMI_UINT64_MAX;
+        status[field_ind]          = AMDSMI_STATUS_INVAL;
+    }
+
+    if (AMDSMI_STATUS_SUCCESS == amdsmi_get_gpu_fields(amdsmi_processor_handle_all_gpu_device_across_socket[dv_ind], fields, num_fields))
+    {
+        for (uint32_t field_ind = 0; field_ind < num_fields; field_ind++)
+        {
+            status[field_ind] = fields[field_ind].status;
+            if (AMDSMI_STATUS_SUCCESS != fields[field_ind].status) continue;
+            values[field_ind] = fields[field_ind].value.u64;
+            num_read++;
+        }
+    }
+    if (enable_debug_level(GOAMDSMI_DEBUG_LEVEL_1)) {printf("AMDSMI, %s for Gpu:%d, GpuFieldsRead:%u/%u\n", (num_read == num_fields)?"Success":"Failed", dv_ind, num_read, num_fields);}
+
+    free(fields);
+    return num_read;
+}
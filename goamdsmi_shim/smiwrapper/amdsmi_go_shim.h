@@ -572,3 +572,20 @@ uint64_t goamdsmi_gpu_dev_gpu_memory_usage_get(uint32_t dv_ind);
  *
  */
 uint64_t goamdsmi_gpu_dev_gpu_memory_total_get(uint32_t dv_ind);
+
+/**
+ *  @brief Go language stub to read several GPU fields in one call
+ *
+ *  @details This function will call the amdsmi_get_gpu_fields()
+ *  function to read all @p num_fields fields in @p field_ids (::amdsmi_field_id_t)
+ *  under a single device lock. Each value is written to @p values and each
+ *  per-field ::amdsmi_status_t to @p status ; signed fields (temperatures in C,
+ *  fan speeds) are passed back as their uint64_t bit pattern.
+ *
+ *  @param[in] ::uint32_t device index, field ids, output arrays, number of fields
+ *
+ *  @retval ::uint32_t number of fields read successfully
+ *  @retval zero is returned upon failure.
+ *
+ */
+uint32_t goamdsmi_gpu_dev_fields_get(uint32_t dv_ind, const uint32_t* field_ids, uint64_t* values, uint32_t* status, uint32_t num_fields);
@@ -72,7 +72,32 @@ typedef enum {
   AMDSMI_INIT_AMD_GPUS = (1 << 1),
   AMDSMI_INIT_NON_AMD_CPUS = (1 << 2),
   AMDSMI_INIT_NON_AMD_GPUS = (1 << 3),
-  AMDSMI_INIT_AMD_APUS = (AMDSMI_INIT_AMD_CPUS | AMDSMI_INIT_AMD_GPUS) // Default option
+  AMDSMI_INIT_AMD_APUS = (AMDSMI_INIT_AMD_CPUS | AMDSMI_INIT_AMD_GPUS), // Default option
+  AMDSMI_INIT_LOCKLESS_READS = 0x20000000000000,  //!< Getters that only read
+                                       //!< sysfs files don't take the device
+                                       //!< lock. Also set by the
+                                       //!< RSMI_LOCKLESS_READS env. var.
+  AMDSMI_INIT_DISCOVERY_CACHE = 0x40000000000000,  //!< Reuse the static
+                                       //!< GPU discovery results of an
+                                       //!< earlier process in the same boot,
+                                       //!< kept in /run/amdsmi. Also set by
+                                       //!< the RSMI_DISCOVERY_CACHE env. var.
+                                       //!< in debug and test builds.
+  AMDSMI_INIT_LAZY = 0x80000000000000,  //!< Only enumerate the GPUs; the rest of
+                                       //!< their state (hwmon, io links, DRM
+                                       //!< render nodes, ...) is discovered on
+                                       //!< first use. Also set by the
+                                       //!< RSMI_LAZY_INIT env. var.
+  AMDSMI_INIT_GPU_METRICS_CACHE = 0x100000000000000,  //!< Let gpu_metrics
+                                       //!< derived queries share one snapshot
+                                       //!< of the metrics table for up to
+                                       //!< 1 ms. The RSMI_GPU_METRICS_CACHE_TTL_US
+                                       //!< env. var. overrides the age. See
+                                       //!< ::amdsmi_set_gpu_metrics_cache_ttl
+  AMDSMI_INIT_SYSFS_FD_CACHE = 0x200000000000000  //!< Keep read-only sysfs
+                                       //!< attribute files open and re-read
+                                       //!< them with pread(). Also set by the
+                                       //!< RSMI_SYSFS_FD_CACHE env. var.
 } amdsmi_init_flags_t;
 
 /* Maximum size definitions AMDSMI */
@@ -526,6 +551,21 @@ typedef struct {
   uint32_t vram_used;
   uint32_t reserved[2];
 } amdsmi_vram_usage_t;
+
+/**
+ * @brief VRAM, CPU visible VRAM and GTT totals and usage, in bytes.
+ * The totals are what is usable by applications, i.e. without memory
+ * pinned or reserved by the kernel.
+ */
+typedef struct {
+  uint64_t vram_total;      //!< Usable VRAM
+  uint64_t vram_used;       //!< VRAM in use
+  uint64_t vis_vram_total;  //!< Usable CPU visible VRAM
+  uint64_t vis_vram_used;   //!< CPU visible VRAM in use
+  uint64_t gtt_total;       //!< Usable GTT
+  uint64_t gtt_used;        //!< GTT in use
+  uint64_t reserved[2];
+} amdsmi_gpu_memory_usage_t;
 /**
  * @brief This structure hold violation status information.
  */
@@ -548,8 +588,27 @@ typedef struct {
   uint8_t active_socket_thrm;    //!< Socket thermal violation; 1 = active 0 = not active; Max uint8 means unsupported
   uint8_t active_vr_thrm;        //!< Voltage regulator violation; 1 = active 0 = not active; Max uint8 means unsupported
   uint8_t active_hbm_thrm;       //!< High Bandwidth Memory (HBM) thermal violation; 1 = active 0 = not active; Max uint8 means unsupported
-  uint64_t reserved[30];         // Reserved for new violation info
+  uint64_t window_us;            //!< Interval the violation % were computed over, in microseconds; Max uint64 means none
+  uint64_t reserved[29];         // Reserved for new violation info
 } amdsmi_violation_status_t;
+
+//! Number of rolling windows reported by ::amdsmi_get_violation_window_stats (1 s, 10 s, 60 s)
+#define AMDSMI_NUM_VIOLATION_WINDOWS 3
+
+/**
+ * @brief Throttle violation residency over a rolling window
+ */
+typedef struct {
+  uint64_t window_us;            //!< Window length, in microseconds
+  uint64_t covered_us;           //!< Time covered by the samples in the window, in microseconds; 0 if not enough samples
+  uint64_t per_prochot_thrm;     //!< Processor hot violation %; Max uint64 means unsupported or not enough samples
+  uint64_t per_ppt_pwr;          //!< PVIOL; Package Power Tracking (PPT) violation %; Max uint64 means unsupported or not enough samples
+  uint64_t per_socket_thrm;      //!< TVIOL; Socket thermal violation %; Max uint64 means unsupported or not enough samples
+  uint64_t per_vr_thrm;          //!< Voltage regulator violation %; Max uint64 means unsupported or not enough samples
+  uint64_t per_hbm_thrm;         //!< High Bandwidth Memory (HBM) thermal violation %; Max uint64 means unsupported or not enough samples
+  uint32_t num_samples;          //!< Number of samples within the window
+  uint32_t reserved[9];
+} amdsmi_violation_window_stats_t;
 typedef struct {
   amdsmi_range_t supported_freq_range;
   amdsmi_range_t current_freq_range;
@@ -720,6 +779,34 @@ typedef struct {
   uint64_t reserved[7];
 } amdsmi_link_metrics_t;
 
+//! Number of entries of ::amdsmi_link_rates_t (every XGMI link plus PCIe)
+#define AMDSMI_MAX_NUM_LINK_RATES (AMDSMI_MAX_NUM_XGMI_LINKS + 1)
+
+/**
+ * @brief Bandwidth of one link over the interval between two samples
+ */
+typedef struct {
+  amdsmi_link_type_t link_type;   //!< AMDSMI_LINK_TYPE_XGMI or AMDSMI_LINK_TYPE_PCIE
+  uint32_t link_index;            //!< XGMI link number; 0 for PCIe
+  float read_gbps;                //!< data received in GB/s; negative if not available
+  float write_gbps;               //!< data transmitted in GB/s; negative if not available
+  float total_gbps;               //!< read + write, or the total reported by firmware; negative if not available
+  float max_gbps;                 //!< max bandwidth of the link per direction in GB/s; 0 if unknown
+  float utilization;              //!< busiest direction (or total for PCIe) vs max_gbps, in %; negative if not available
+  uint32_t reserved[5];
+} amdsmi_link_rate_t;
+
+/**
+ * @brief Per-link bandwidth of one processor
+ */
+typedef struct {
+  uint64_t window_ns;     //!< interval the rates were computed over, in nanoseconds
+  uint32_t num_links;     //!< number of valid entries in links
+  uint32_t reserved0;
+  amdsmi_link_rate_t links[AMDSMI_MAX_NUM_LINK_RATES];
+  uint64_t reserved[6];
+} amdsmi_link_rates_t;
+
 typedef struct {
   amdsmi_vram_type_t vram_type;
   amdsmi_vram_vendor_type_t vram_vendor;
@@ -797,6 +884,53 @@ typedef struct {
   uint32_t reserved[4];
 } amdsmi_proc_info_t;
 
+#define AMDSMI_MAX_DRM_ENGINES 16
+#define AMDSMI_MAX_DRM_MEMORY_REGIONS 8
+#define AMDSMI_DRM_NAME_LENGTH 16
+
+/**
+ * amdsmi_drm_engine_usage_t:
+ * Use of one GPU engine by one process, from the drm-engine-<name> and
+ * drm-cycles-<name> keys of its DRM fdinfo
+ **/
+typedef struct {
+  char name[AMDSMI_DRM_NAME_LENGTH];  //!< Engine, e.g. "gfx", "compute", "dec"
+  uint64_t busy_ns;       //!< Time busy, summed over the DRM clients of the process
+  uint64_t cycles;        //!< Cycles busy, 0 if not reported
+  uint32_t busy_percent;  //!< Share of amdsmi_proc_drm_usage_t::interval_ns spent busy,
+                          //!< summed over the clients (may exceed 100)
+  uint32_t reserved;
+} amdsmi_drm_engine_usage_t;
+
+/**
+ * amdsmi_drm_memory_usage_t:
+ * Memory of one region used by one process, from the drm-memory-<name>,
+ * drm-shared-<name> and drm-resident-<name> keys of its DRM fdinfo
+ **/
+typedef struct {
+  char name[AMDSMI_DRM_NAME_LENGTH];  //!< Region, e.g. "vram", "gtt", "cpu"
+  uint64_t total;     //!< in bytes
+  uint64_t shared;    //!< in bytes
+  uint64_t resident;  //!< in bytes
+} amdsmi_drm_memory_usage_t;
+
+/**
+ * amdsmi_proc_drm_usage_t:
+ * Use of one GPU by one process, summed over its DRM clients (one per
+ * distinct drm-client-id, however many fds refer to it)
+ **/
+typedef struct {
+  amdsmi_process_handle_t pid;
+  uint32_t num_clients;
+  uint64_t interval_ns;  //!< Time covered by the busy_percent values, 0 the first time a process is seen
+  char container_name[AMDSMI_NORMAL_STRING_LENGTH];
+  uint32_t num_engines;
+  uint32_t num_memory_regions;
+  amdsmi_drm_engine_usage_t engines[AMDSMI_MAX_DRM_ENGINES];
+  amdsmi_drm_memory_usage_t memory_regions[AMDSMI_MAX_DRM_MEMORY_REGIONS];
+  uint32_t reserved[4];
+} amdsmi_proc_drm_usage_t;
+
 /**
  * @brief IO Link P2P Capability
  */
@@ -859,6 +993,12 @@ typedef enum {
  */
 typedef uintptr_t amdsmi_event_handle_t;
 
+/**
+ * @brief Handle to a group of performance event counters that are read
+ * together
+ */
+typedef uintptr_t amdsmi_event_group_handle_t;
+
 /**
  * Event Groups
  *
@@ -992,6 +1132,14 @@ typedef struct {
     char message[MAX_EVENT_NOTIFICATION_MSG_SIZE];  //!< Event message
 } amdsmi_evt_notification_data_t;
 
+/**
+ * Function called for each event notification once it is set with
+ * ::amdsmi_set_gpu_event_notification_callback(). @p data is only valid
+ * during the call.
+ */
+typedef void (*amdsmi_evt_notification_callback_t)(
+                    const amdsmi_evt_notification_data_t *data, void *user_data);
+
 /**
  * @brief Temperature Metrics.  This enum is used to identify various
  * temperature metrics. Corresponding values will be in millidegress
@@ -1431,6 +1579,94 @@ typedef struct {
   /// \endcond
 } amd_metrics_table_header_t;
 
+/**
+ * @brief Counters of the per-GPU sysfs file descriptor cache
+ */
+typedef struct {
+  uint64_t hits;           //!< Reads served from an already open descriptor
+  uint64_t misses;         //!< Reads that had to open the attribute file
+  uint64_t invalidations;  //!< Number of times the cache was flushed
+  uint32_t open_fds;       //!< Descriptors currently held open
+  uint32_t enabled;        //!< Non-zero if the cache is enabled
+} amdsmi_sysfs_fd_cache_stats_t;
+
+/**
+ * @brief Field identifiers for ::amdsmi_get_gpu_fields
+ *
+ * Fields that come from the same source (gpu_metrics table, pp_dpm_*
+ * files, mem_info_* files) are read once per call. hwmon fields are read
+ * first, one file per field.
+ */
+typedef enum {
+  AMDSMI_FIELD_TEMP_EDGE = 0,         //!< Edge temperature, in C (int64, hwmon)
+  AMDSMI_FIELD_FIRST = AMDSMI_FIELD_TEMP_EDGE,
+  AMDSMI_FIELD_TEMP_HOTSPOT,          //!< Hotspot/junction temperature, in C (int64, hwmon)
+  AMDSMI_FIELD_TEMP_VRAM,             //!< VRAM temperature, in C (int64, hwmon)
+  AMDSMI_FIELD_FAN_SPEED,             //!< Fan speed, relative to ::AMDSMI_MAX_FAN_SPEED (int64, hwmon)
+  AMDSMI_FIELD_FAN_RPMS,              //!< Fan speed, in RPMs (int64, hwmon)
+  AMDSMI_FIELD_SOCKET_POWER,          //!< Socket power, in W (uint64, gpu_metrics)
+  AMDSMI_FIELD_ENERGY_ACCUMULATOR,    //!< Energy accumulator, in 15.259 uJ units (uint64, gpu_metrics)
+  AMDSMI_FIELD_GFX_ACTIVITY,          //!< Graphics engine activity, in % (uint64, gpu_metrics)
+  AMDSMI_FIELD_UMC_ACTIVITY,          //!< Memory controller activity, in % (uint64, gpu_metrics)
+  AMDSMI_FIELD_MM_ACTIVITY,           //!< Multimedia engine activity, in % (uint64, gpu_metrics)
+  AMDSMI_FIELD_GFX_CLK,               //!< Current graphics clock, in MHz (uint64, gpu_metrics)
+  AMDSMI_FIELD_MEM_CLK,               //!< Current memory clock, in MHz (uint64, gpu_metrics)
+  AMDSMI_FIELD_SOC_CLK,               //!< Current SoC clock, in MHz (uint64, gpu_metrics)
+  AMDSMI_FIELD_THROTTLE_STATUS,       //!< Throttle status bits (uint64, gpu_metrics)
+  AMDSMI_FIELD_PCIE_LINK_WIDTH,       //!< PCIe link width, in lanes (uint64, gpu_metrics)
+  AMDSMI_FIELD_PCIE_LINK_SPEED,       //!< PCIe link speed, in 0.1 GT/s (uint64, gpu_metrics)
+  AMDSMI_FIELD_GFX_CLK_LEVEL,         //!< Current graphics clock DPM level (uint64, pp_dpm_sclk)
+  AMDSMI_FIELD_MEM_CLK_LEVEL,         //!< Current memory clock DPM level (uint64, pp_dpm_mclk)
+  AMDSMI_FIELD_VRAM_TOTAL,            //!< Total VRAM, in bytes (uint64, mem_info_vram_total)
+  AMDSMI_FIELD_VRAM_USED,             //!< Used VRAM, in bytes (uint64, mem_info_vram_used)
+  AMDSMI_FIELD_VIS_VRAM_TOTAL,        //!< Total CPU-visible VRAM, in bytes (uint64, mem_info_vis_vram_total)
+  AMDSMI_FIELD_VIS_VRAM_USED,         //!< Used CPU-visible VRAM, in bytes (uint64, mem_info_vis_vram_used)
+  AMDSMI_FIELD_GTT_TOTAL,             //!< Total GTT, in bytes (uint64, mem_info_gtt_total)
+  AMDSMI_FIELD_GTT_USED,              //!< Used GTT, in bytes (uint64, mem_info_gtt_used)
+  AMDSMI_FIELD_POWER_CAP,             //!< Power cap, in uW (uint64, hwmon)
+  AMDSMI_FIELD__MAX
+} amdsmi_field_id_t;
+
+/**
+ * @brief Type of the value held by an ::amdsmi_field_value_t
+ */
+typedef enum {
+  AMDSMI_FIELD_TYPE_UINT64 = 0,       //!< Value is in amdsmi_field_value_t::value.u64
+  AMDSMI_FIELD_TYPE_INT64             //!< Value is in amdsmi_field_value_t::value.i64
+} amdsmi_field_type_t;
+
+/**
+ * @brief One entry of a ::amdsmi_get_gpu_fields request
+ */
+typedef struct {
+  amdsmi_field_id_t field_id;         //!< [in] Field to read
+  amdsmi_status_t status;             //!< [out] Status of this field's read
+  amdsmi_field_type_t type;           //!< [out] Type of @p value
+  uint32_t reserved;
+  union {
+    uint64_t u64;
+    int64_t i64;
+  } value;                            //!< [out] Value, valid if @p status is ::AMDSMI_STATUS_SUCCESS,
+                                      //!< ::AMDSMI_FIELD_VALUE_INVALID otherwise
+} amdsmi_field_value_t;
+
+//! amdsmi_field_value_t::value.u64 of a field that could not be read
+#define AMDSMI_FIELD_VALUE_INVALID UINT64_MAX
+
+//! Maximum number of fields sampled by ::amdsmi_start_background_sampling
+#define AMDSMI_MAX_SAMPLED_FIELDS 16
+
+/**
+ * @brief One record of a GPU's background sampling
+ */
+typedef struct {
+  uint64_t sequence;                  //!< Record number since sampling started
+  uint64_t timestamp_ns;              //!< CLOCK_MONOTONIC time of the record, in ns
+  uint32_t num_fields;                //!< Number of valid entries in @p fields
+  uint32_t reserved;
+  amdsmi_field_value_t fields[AMDSMI_MAX_SAMPLED_FIELDS];  //!< Values, in the order they were requested
+} amdsmi_field_sample_t;
+
 
 /**
  * @brief The following structures hold the gpu statistics for a device.
@@ -1692,6 +1928,15 @@ typedef struct {
   uint64_t reserved[5];
 } amdsmi_error_count_t;
 
+/**
+ * @brief The error counts of one GPU block, as returned by
+ * amdsmi_get_gpu_ecc_count_all()
+ */
+typedef struct {
+  amdsmi_gpu_block_t block;  //!< The block the counts are for
+  amdsmi_error_count_t ec;   //!< The block's error counts
+} amdsmi_gpu_block_error_count_t;
+
 /**
  * @brief This structure contains information specific to a process.
  */
@@ -1874,6 +2119,33 @@ typedef struct __attribute__((__packed__)){
     uint32_t gfxclk_frequency[8];
 } amdsmi_hsmp_metrics_table_t;
 
+/**
+ * @brief Per socket values of a CPU telemetry snapshot.
+ * Values that could not be read are set to the max value of their type.
+ */
+typedef struct {
+    uint32_t socket_index;      //!< Socket index as used by ESMI
+    uint32_t power;             //!< Socket power in mW
+    uint32_t power_cap;         //!< Socket power cap in mW
+    uint64_t energy;            //!< Socket energy in uJ
+    uint16_t freq_limit;        //!< Current active frequency limit in MHz
+    uint16_t fmax;              //!< Max frequency in MHz
+    uint16_t fmin;              //!< Min frequency in MHz
+    uint16_t reserved;          //!< Reserved
+} amdsmi_cpu_socket_telemetry_t;
+
+/**
+ * @brief Per core values of a CPU telemetry snapshot.
+ * Values that could not be read are set to the max value of their type.
+ */
+typedef struct {
+    uint32_t core_index;        //!< Core index as used by ESMI
+    uint32_t socket_index;      //!< Socket the core belongs to
+    uint64_t energy;            //!< Core energy in uJ
+    uint32_t boostlimit;        //!< Core boost limit in MHz
+    uint32_t freq_limit;        //!< Current frequency limit in MHz
+} amdsmi_cpu_core_telemetry_t;
+
 /**
  * @brief hsmp frequency limit source names
  */
@@ -3259,6 +3531,237 @@ amdsmi_status_t amdsmi_get_gpu_od_volt_info(amdsmi_processor_handle processor_ha
 amdsmi_status_t
 amdsmi_get_gpu_metrics_header_info(amdsmi_processor_handle processor_handle, amd_metrics_table_header_t* header_value);
 
+/**
+ *  @brief Get the counters of the GPU's sysfs file descriptor cache
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details When ::AMDSMI_INIT_SYSFS_FD_CACHE is passed to ::amdsmi_init (or
+ *  the RSMI_SYSFS_FD_CACHE environment variable is set), read-only sysfs attribute files are kept open per GPU and
+ *  re-read with pread() instead of being re-opened on every query. Given a
+ *  processor handle @p processor_handle and a pointer to a
+ *  ::amdsmi_sysfs_fd_cache_stats_t @p stats , this function will write the
+ *  cache's hit/miss/invalidation counters to @p stats .
+ *
+ *  @param[in] processor_handle Device which to query
+ *
+ *  @param[out] stats a pointer to an ::amdsmi_sysfs_fd_cache_stats_t to which
+ *  the counters will be written
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_get_gpu_sysfs_fd_cache_stats(amdsmi_processor_handle processor_handle,
+                                    amdsmi_sysfs_fd_cache_stats_t *stats);
+
+/**
+ *  @brief Set the maximum age of the GPU's gpu_metrics snapshot
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Given a processor handle @p processor_handle and a time in
+ *  microseconds @p ttl_us , queries derived from the GPU metrics table (e.g.
+ *  ::amdsmi_get_gpu_metrics_info, ::amdsmi_get_energy_count, power,
+ *  temperature and activity queries) will be served from the last metrics
+ *  table read from the GPU, as long as it is not older than @p ttl_us .
+ *  A value of 0 (the default) makes every query read the metrics table again.
+ *  ::AMDSMI_INIT_GPU_METRICS_CACHE sets a 1 ms default; the
+ *  RSMI_GPU_METRICS_CACHE_TTL_US environment variable sets any default up to
+ *  10 s before ::amdsmi_init.
+ *
+ *  @param[in] processor_handle Device which to configure
+ *
+ *  @param[in] ttl_us maximum age of the snapshot, in microseconds
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_set_gpu_metrics_cache_ttl(amdsmi_processor_handle processor_handle, uint64_t ttl_us);
+
+/**
+ *  @brief Get the maximum age of the GPU's gpu_metrics snapshot
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Given a processor handle @p processor_handle and a pointer to a
+ *  uint64_t @p ttl_us , this function will write the maximum age, in
+ *  microseconds, of the GPU's metrics snapshot to @p ttl_us .
+ *
+ *  @param[in] processor_handle Device which to query
+ *
+ *  @param[out] ttl_us a pointer to uint64_t to which the maximum age will be
+ *  written
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_get_gpu_metrics_cache_ttl(amdsmi_processor_handle processor_handle, uint64_t *ttl_us);
+
+/**
+ *  @brief Read several GPU fields in one call
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Given a processor handle @p processor_handle and an array of
+ *  @p num_fields ::amdsmi_field_value_t @p fields with amdsmi_field_value_t::field_id
+ *  set, this function will read every requested field and write its value,
+ *  type and status back to the same entry. The device is locked once for the
+ *  whole request, and fields coming from the same source (ie: the gpu_metrics
+ *  table) are read from a single read of that source.
+ *
+ *  A field that cannot be read does not fail the call; its
+ *  amdsmi_field_value_t::status is set instead, and its value is left at
+ *  ::AMDSMI_FIELD_VALUE_INVALID.
+ *
+ *  @param[in] processor_handle Device which to query
+ *
+ *  @param[inout] fields an array of ::amdsmi_field_value_t with the field ids
+ *  set. Values, types and per-field status are written to it.
+ *
+ *  @param[in] num_fields number of entries in @p fields
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success (even if
+ *  some fields could not be read), non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_get_gpu_fields(amdsmi_processor_handle processor_handle,
+                      amdsmi_field_value_t *fields, uint32_t num_fields);
+
+/**
+ *  @brief Get the GPU fields that can be read from a GPU
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Given a processor handle @p processor_handle and a pointer to a
+ *  uint64_t @p bitmap, this function will set bit (1 << ::amdsmi_field_id_t)
+ *  of @p bitmap for every field that ::amdsmi_get_gpu_fields() can read from
+ *  the GPU, and clear the others. hwmon and sysfs fields are checked against
+ *  the support data the library already gathered; gpu_metrics fields take a
+ *  single read of the gpu_metrics table. Tools can use it to build their
+ *  polling set once, instead of probing each field.
+ *
+ *  @param[in] processor_handle Device which to query
+ *
+ *  @param[out] bitmap a pointer to uint64_t to which the supported fields
+ *  will be written
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_get_supported_fields(amdsmi_processor_handle processor_handle, uint64_t *bitmap);
+
+/**
+ *  @brief Read the same GPU fields from several GPUs in parallel
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Given an array of @p num_processors processor handles
+ *  @p processor_handles and an array of @p num_fields field ids @p field_ids ,
+ *  this function will read the fields from every GPU, as
+ *  ::amdsmi_get_gpu_fields does, on a library owned pool of worker threads
+ *  (at most one per GPU). The results for processor @c p are written to
+ *  @p values [p * @p num_fields, (p + 1) * @p num_fields), in the order of
+ *  @p field_ids . Each GPU is still locked while it is read, so the time
+ *  taken follows the slowest GPU instead of the sum of all of them.
+ *
+ *  @param[in] processor_handles array of GPUs which to query
+ *
+ *  @param[in] num_processors number of entries in @p processor_handles
+ *
+ *  @param[in] field_ids array of fields to read from every GPU
+ *
+ *  @param[in] num_fields number of entries in @p field_ids
+ *
+ *  @param[out] values array of @p num_processors * @p num_fields
+ *  ::amdsmi_field_value_t to which the values will be written
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success (even if
+ *  some fields could not be read), non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_get_gpu_fields_multi(amdsmi_processor_handle *processor_handles,
+                            uint32_t num_processors,
+                            const amdsmi_field_id_t *field_ids, uint32_t num_fields,
+                            amdsmi_field_value_t *values);
+
+/**
+ *  @brief Start sampling GPU fields in the background
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Given a processor handle @p processor_handle and an array of
+ *  @p num_fields field ids @p field_ids , this function will start a library
+ *  owned thread that reads those fields (as ::amdsmi_get_gpu_fields does)
+ *  every @p period_us microseconds. Each read is stored as a timestamped
+ *  ::amdsmi_field_sample_t in a ring that keeps the last @p depth records.
+ *  Records are read with ::amdsmi_get_background_samples , which takes no
+ *  lock and makes no syscall.
+ *
+ *  @param[in] processor_handle Device which to sample
+ *
+ *  @param[in] field_ids array of fields to sample
+ *
+ *  @param[in] num_fields number of entries in @p field_ids , at most
+ *  ::AMDSMI_MAX_SAMPLED_FIELDS
+ *
+ *  @param[in] period_us time between two records, in microseconds (at least 1000)
+ *
+ *  @param[in] depth number of records kept
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success,
+ *  ::AMDSMI_STATUS_BUSY if the GPU is already being sampled, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_start_background_sampling(amdsmi_processor_handle processor_handle,
+                                 const amdsmi_field_id_t *field_ids, uint32_t num_fields,
+                                 uint64_t period_us, uint32_t depth);
+
+/**
+ *  @brief Stop sampling GPU fields in the background
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Given a processor handle @p processor_handle , this function will
+ *  stop the sampling started with ::amdsmi_start_background_sampling and
+ *  release its records.
+ *
+ *  @param[in] processor_handle Device which is sampled
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_stop_background_sampling(amdsmi_processor_handle processor_handle);
+
+/**
+ *  @brief Get the records of a GPU's background sampling
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Given a processor handle @p processor_handle , a cursor @p cursor ,
+ *  and an array @p samples of @p num_samples entries, this function will copy
+ *  the records with a sequence number equal or above @p cursor (oldest first)
+ *  to @p samples , write the number copied to @p num_samples , and move
+ *  @p cursor past the last record copied. Start with @p cursor set to 0; any
+ *  number of readers may each use their own cursor. Records that were
+ *  overwritten before they were read show up as a gap in
+ *  amdsmi_field_sample_t::sequence .
+ *
+ *  @param[in] processor_handle Device which is sampled
+ *
+ *  @param[inout] cursor sequence number of the next record to read
+ *
+ *  @param[out] samples array to which the records will be copied
+ *
+ *  @param[inout] num_samples As input, the number of entries in @p samples .
+ *  As output, the number of records copied.
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_get_background_samples(amdsmi_processor_handle processor_handle,
+                              uint64_t *cursor, amdsmi_field_sample_t *samples,
+                              uint32_t *num_samples);
+
 /**
  *  @brief This function retrieves the gpu metrics information. It is not supported
  *  on virtual machine guest
@@ -3357,6 +3860,148 @@ amdsmi_status_t amdsmi_get_gpu_reg_table_info(
                       amdsmi_name_value_t** reg_metrics,
                       uint32_t *num_of_metrics);
 
+/**
+ *  @brief Get the pm metrics table into a caller-provided array
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details As ::amdsmi_get_gpu_pm_metrics_info(), but the name value pairs
+ *  are written to @p pm_metrics, which the caller owns, and no memory is
+ *  allocated. The layout of the table is worked out once per GPU and pm
+ *  metrics version, so repeated calls only read the table and copy the
+ *  values.
+ *
+ *  If @p pm_metrics is nullptr, the number of metrics of the table is
+ *  written to @p num_of_metrics. Otherwise @p num_of_metrics holds the number
+ *  of entries in @p pm_metrics on input, and the number of entries written on
+ *  output.
+ *
+ *  @param[in] processor_handle a processor handle
+ *
+ *  @param[inout] pm_metrics an array to which the metrics are written, or
+ *  nullptr to only query their number
+ *
+ *  @param[inout] num_of_metrics the size of @p pm_metrics on input, the
+ *  number of metrics on output
+ *
+ *  @retval ::AMDSMI_STATUS_SUCCESS call was successful
+ *  @retval ::AMDSMI_STATUS_NOT_SUPPORTED installed software or hardware does not
+ *  support this function with the given arguments
+ *  @retval ::AMDSMI_STATUS_INSUFFICIENT_SIZE @p pm_metrics is smaller than the
+ *  number of metrics, which is written to @p num_of_metrics
+ *  @retval ::AMDSMI_STATUS_INVAL the provided arguments are not valid
+ */
+amdsmi_status_t amdsmi_get_gpu_pm_metrics_values(
+                      amdsmi_processor_handle processor_handle,
+                      amdsmi_name_value_t *pm_metrics,
+                      uint32_t *num_of_metrics);
+
+/**
+ *  @brief Get the pm metrics that changed since the previous call
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details As ::amdsmi_get_gpu_pm_metrics_values(), but only the metrics
+ *  whose value differs from that of the previous call of this function for
+ *  the GPU, in this process, are written. The first call, and the first one
+ *  after the layout of the table changed, write all of them. @p pm_metrics
+ *  must still have room for every metric of the table.
+ *
+ *  @param[in] processor_handle a processor handle
+ *
+ *  @param[inout] pm_metrics an array to which the changed metrics are
+ *  written, or nullptr to only query the number of metrics of the table
+ *
+ *  @param[inout] num_of_metrics the size of @p pm_metrics on input, the
+ *  number of changed metrics on output
+ *
+ *  @retval ::AMDSMI_STATUS_SUCCESS call was successful
+ *  @retval ::AMDSMI_STATUS_NOT_SUPPORTED installed software or hardware does not
+ *  support this function with the given arguments
+ *  @retval ::AMDSMI_STATUS_INSUFFICIENT_SIZE @p pm_metrics is smaller than the
+ *  number of metrics, which is written to @p num_of_metrics
+ *  @retval ::AMDSMI_STATUS_INVAL the provided arguments are not valid
+ */
+amdsmi_status_t amdsmi_get_gpu_pm_metrics_changes(
+                      amdsmi_processor_handle processor_handle,
+                      amdsmi_name_value_t *pm_metrics,
+                      uint32_t *num_of_metrics);
+
+/**
+ *  @brief Get a register table into a caller-provided array
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details As ::amdsmi_get_gpu_reg_table_info(), but the name value pairs
+ *  are written to @p reg_metrics, which the caller owns, and no memory is
+ *  allocated. The layout of the table is worked out once per GPU and number
+ *  of instances and registers, so repeated calls only read the table and
+ *  copy the values.
+ *
+ *  If @p reg_metrics is nullptr, the number of registers of the table is
+ *  written to @p num_of_metrics. Otherwise @p num_of_metrics holds the number
+ *  of entries in @p reg_metrics on input, and the number of entries written
+ *  on output.
+ *
+ *  @param[in] processor_handle a processor handle
+ *
+ *  @param[in] reg_type The register type
+ *
+ *  @param[inout] reg_metrics an array to which the registers are written, or
+ *  nullptr to only query their number
+ *
+ *  @param[inout] num_of_metrics the size of @p reg_metrics on input, the
+ *  number of registers on output
+ *
+ *  @retval ::AMDSMI_STATUS_SUCCESS call was successful
+ *  @retval ::AMDSMI_STATUS_NOT_SUPPORTED installed software or hardware does not
+ *  support this function with the given arguments
+ *  @retval ::AMDSMI_STATUS_INSUFFICIENT_SIZE @p reg_metrics is smaller than the
+ *  number of registers, which is written to @p num_of_metrics
+ *  @retval ::AMDSMI_STATUS_INVAL the provided arguments are not valid
+ */
+amdsmi_status_t amdsmi_get_gpu_reg_table_values(
+                      amdsmi_processor_handle processor_handle,
+                      amdsmi_reg_type_t reg_type,
+                      amdsmi_name_value_t *reg_metrics,
+                      uint32_t *num_of_metrics);
+
+/**
+ *  @brief Get the registers of a register table that changed since the
+ *  previous call
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details As ::amdsmi_get_gpu_reg_table_values(), but only the registers
+ *  whose value differs from that of the previous call of this function for
+ *  the GPU and @p reg_type, in this process, are written. The first call, and
+ *  the first one after the layout of the table changed, write all of them.
+ *  @p reg_metrics must still have room for every register of the table.
+ *  This suits polling the XGMI, WAFL and PCIe counters at a high rate.
+ *
+ *  @param[in] processor_handle a processor handle
+ *
+ *  @param[in] reg_type The register type
+ *
+ *  @param[inout] reg_metrics an array to which the changed registers are
+ *  written, or nullptr to only query the number of registers of the table
+ *
+ *  @param[inout] num_of_metrics the size of @p reg_metrics on input, the
+ *  number of changed registers on output
+ *
+ *  @retval ::AMDSMI_STATUS_SUCCESS call was successful
+ *  @retval ::AMDSMI_STATUS_NOT_SUPPORTED installed software or hardware does not
+ *  support this function with the given arguments
+ *  @retval ::AMDSMI_STATUS_INSUFFICIENT_SIZE @p reg_metrics is smaller than the
+ *  number of registers, which is written to @p num_of_metrics
+ *  @retval ::AMDSMI_STATUS_INVAL the provided arguments are not valid
+ */
+amdsmi_status_t amdsmi_get_gpu_reg_table_changes(
+                      amdsmi_processor_handle processor_handle,
+                      amdsmi_reg_type_t reg_type,
+                      amdsmi_name_value_t *reg_metrics,
+                      uint32_t *num_of_metrics);
+
 /**
  *  @brief This function sets the clock range information. It is not supported on virtual
  *  machine guest
@@ -3895,6 +4540,38 @@ amdsmi_status_t amdsmi_get_gpu_ecc_count(amdsmi_processor_handle processor_handl
 amdsmi_status_t amdsmi_get_gpu_ecc_enabled(amdsmi_processor_handle processor_handle,
                                                     uint64_t *enabled_blocks);
 
+/**
+ *  @brief Retrieve the error counts of all the ECC enabled GPU blocks. It is not
+ *  supported on virtual machine guest
+ *
+ *  @platform{gpu_bm_linux} @platform{host}
+ *
+ *  @details Given a processor handle @p processor_handle, a pointer to a uint32_t
+ *  @p num_blocks and an array of ::amdsmi_gpu_block_error_count_t @p counts, this
+ *  function will write the error counts of every block that has ECC enabled and
+ *  an error counter in the kernel to @p counts, in a single pass. It replaces a
+ *  loop of amdsmi_get_gpu_ecc_status() and amdsmi_get_gpu_ecc_count() calls over
+ *  the ::amdsmi_gpu_block_t values. The enabled block mask is cached for up to
+ *  one second, so a change made through ras_ctrl is seen after that.
+ *
+ *  If @p counts is nullptr, the number of such blocks is written to @p num_blocks.
+ *  Otherwise @p num_blocks holds the number of entries in @p counts on input, and
+ *  the number of entries written on output.
+ *
+ *  @param[in] processor_handle a processor handle
+ *
+ *  @param[in,out] num_blocks the size of @p counts on input, the number of blocks
+ *  on output
+ *
+ *  @param[out] counts an array to which the per block error counts are written,
+ *  or nullptr to only query the number of blocks
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t amdsmi_get_gpu_ecc_count_all(amdsmi_processor_handle processor_handle,
+                                             uint32_t *num_blocks,
+                                             amdsmi_gpu_block_error_count_t *counts);
+
 /**
  *  @brief Retrieve the ECC status for a GPU block. It is not supported on virtual machine
  *  guest
@@ -4157,6 +4834,102 @@ amdsmi_status_t
 amdsmi_gpu_read_counter(amdsmi_event_handle_t evt_handle,
                     amdsmi_counter_value_t *value);
 
+/**
+ *  @brief Create a group of performance counters that are read together
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Create counters for the @p num_events event types in @p types
+ *  on the device with processor handle @p processor_handle and write a handle
+ *  for the group to @p grp_handle. Events of the same ::amdsmi_event_group_t
+ *  share a single kernel perf group, so they are started, stopped and
+ *  sampled atomically with respect to each other, and
+ *  ::amdsmi_gpu_read_counter_group() fetches all of them with one read per
+ *  event group instead of one per counter. The handle should be deallocated
+ *  with ::amdsmi_gpu_destroy_counter_group() when no longer needed.
+ *
+ *  @note This function requires root access
+ *
+ *  @param[in] processor_handle a processor handle
+ *
+ *  @param[in] types array of ::amdsmi_event_type_t to count
+ *
+ *  @param[in] num_events number of entries in @p types
+ *
+ *  @param[in,out] grp_handle A pointer to a ::amdsmi_event_group_handle_t
+ *  which will be associated with the newly allocated group
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_gpu_create_counter_group(amdsmi_processor_handle processor_handle,
+                                const amdsmi_event_type_t *types, uint32_t num_events,
+                                amdsmi_event_group_handle_t *grp_handle);
+
+/**
+ *  @brief Deallocate a group of performance counters
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Stop and deallocate all the counters of the group associated
+ *  with @p grp_handle
+ *
+ *  @note This function requires root access
+ *
+ *  @param[in] grp_handle handle to the group to be deallocated
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_gpu_destroy_counter_group(amdsmi_event_group_handle_t grp_handle);
+
+/**
+ *  @brief Issue performance counter control commands to a counter group
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Issue a command @p cmd to every counter of the group associated
+ *  with @p grp_handle. The counters are enabled and disabled together.
+ *
+ *  @note This function requires root access
+ *
+ *  @param[in] grp_handle a counter group handle
+ *
+ *  @param[in] cmd The event counter command to be issued
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_gpu_control_counter_group(amdsmi_event_group_handle_t grp_handle,
+                                 amdsmi_counter_command_t cmd);
+
+/**
+ *  @brief Read all counters of a counter group
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Read the counters of the group associated with @p grp_handle and
+ *  write one ::amdsmi_counter_value_t per event to @p values, in the order the
+ *  events were passed to ::amdsmi_gpu_create_counter_group(). Each value is
+ *  the number of events since the previous read or start. Counters of the
+ *  same ::amdsmi_event_group_t share the same time_enabled and time_running,
+ *  so rates computed across them cover the same interval.
+ *
+ *  @note This function requires root access
+ *
+ *  @param[in] grp_handle a counter group handle
+ *
+ *  @param[in,out] values array of at least @p num_values elements
+ *
+ *  @param[in] num_values number of elements in @p values; must be at least
+ *  the number of events in the group
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_gpu_read_counter_group(amdsmi_event_group_handle_t grp_handle,
+                              amdsmi_counter_value_t *values, uint32_t num_values);
+
 /**
  *  @brief Get the number of currently available counters. It is not supported on
  *  virtual machine guest
@@ -4351,6 +5124,40 @@ amdsmi_reset_gpu_xgmi_error(amdsmi_processor_handle processor_handle);
 amdsmi_status_t amdsmi_get_link_metrics(amdsmi_processor_handle processor_handle,
           amdsmi_link_metrics_t *link_metrics);
 
+/**
+ *  @brief Return the read/write bandwidth and utilization of every link
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details Rates are computed from the cumulative XGMI counters of the
+ *  gpu_metrics table between this call and the previous one for the same
+ *  processor, so they cover the caller's polling interval. An accumulator
+ *  that went back between two calls was reset (GPU reset, driver reload);
+ *  its rates are reported as -1 for that window and the next call measures
+ *  from the new value. The first call for a processor, or a call made before
+ *  the firmware refreshed the metrics, only takes the baseline and returns an
+ *  empty window (window_ns and num_links set to 0).
+ *
+ *  XGMI links are reported only when the metrics carry XGMI accumulators.
+ *  The XGMI_DATA_OUT performance counters are not used as a source, so no
+ *  time_enabled/time_running scaling is applied; read them with the counter
+ *  group APIs instead.
+ *
+ *  XGMI utilization is taken against the KFD io_link max_bandwidth of the
+ *  device's XGMI peers, falling back to the link speed and width reported in
+ *  gpu_metrics. PCIe utilization is taken against the current PCIe link
+ *  speed and width.
+ *
+ *  @param[in] processor_handle PF of a processor for which to query
+ *
+ *  @param[out] link_rates reference to the link rates struct.
+ *  Must be allocated by user.
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t amdsmi_get_link_rates(amdsmi_processor_handle processor_handle,
+          amdsmi_link_rates_t *link_rates);
+
 /**
  *  @brief Retrieve the NUMA CPU node number for a device
  *
@@ -4737,13 +5544,14 @@ amdsmi_status_t
  * and write up to *@p num_elem event items to @p data. Upon return @p num_elem
  * is updated with the number of events that were actually written. If events
  * are already present when this function is called, it will write the events
- * to the buffer then poll for new events if there is still caller-provided
- * buffer available to write any new events that would be found.
+ * to the buffer, along with any other events that are ready on any device,
+ * and return without waiting. It only waits for up to @p timeout_ms if no
+ * event is ready.
  *
  * This function requires prior calls to ::amdsmi_init_gpu_event_notification() and
- * :: amdsmi_set_gpu_event_notification_mask(). This function polls for the
- * occurrance of the events on the respective devices that were previously
- * specified by :: amdsmi_set_gpu_event_notification_mask().
+ * :: amdsmi_set_gpu_event_notification_mask(). The event files of all the
+ * devices are watched together, and no memory is allocated to collect the
+ * events.
  *
  * @param[in] timeout_ms number of milliseconds to wait for an event
  * to occur
@@ -4765,6 +5573,47 @@ amdsmi_status_t
  amdsmi_get_gpu_event_notification(int timeout_ms,
                      uint32_t *num_elem, amdsmi_evt_notification_data_t *data);
 
+/**
+ * @brief Have event notifications delivered to a callback
+ *
+ * @platform{gpu_bm_linux}
+ *
+ * @details Starts a thread that waits for the events of every GPU set up with
+ * ::amdsmi_init_gpu_event_notification() and
+ * ::amdsmi_set_gpu_event_notification_mask() and calls @p callback with each
+ * of them, passing @p user_data along. The callback runs on that thread and
+ * must not call this function, which returns ::AMDSMI_STATUS_BUSY if it does.
+ * While a callback is set,
+ * ::amdsmi_get_gpu_event_notification() returns ::AMDSMI_STATUS_BUSY.
+ * Passing a nullptr @p callback stops the thread.
+ *
+ * @param[in] callback the function to call for each event, or nullptr
+ *
+ * @param[in] user_data passed to @p callback
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_set_gpu_event_notification_callback(
+            amdsmi_evt_notification_callback_t callback, void *user_data);
+
+/**
+ * @brief Get a file descriptor that becomes readable when events are ready
+ *
+ * @platform{gpu_bm_linux}
+ *
+ * @details Writes to @p fd a file descriptor that an application can add to
+ * its own event loop. It is readable whenever
+ * ::amdsmi_get_gpu_event_notification() would return events without waiting.
+ * The descriptor belongs to the library: it must not be read from or closed,
+ * and it stays valid until ::amdsmi_shut_down().
+ *
+ * @param[out] fd a pointer to an int to which the descriptor is written
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t amdsmi_get_gpu_event_notification_fd(int *fd);
+
 /**
  * @brief Close any file handles and free any resources used by event
  * notification for a GPU
@@ -5097,13 +5946,35 @@ amdsmi_get_clock_info(amdsmi_processor_handle processor_handle, amdsmi_clk_type_
 amdsmi_status_t
 amdsmi_get_gpu_vram_usage(amdsmi_processor_handle processor_handle, amdsmi_vram_usage_t *info);
 
+/**
+ *  @brief          Returns the VRAM, CPU visible VRAM and GTT totals and usage
+ *                  in bytes, read together with one driver query.
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @param[in]      processor_handle Device which to query
+ *
+ *  @param[out]     info Reference to the memory usage information.
+ *                  Must be allocated by user.
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_get_gpu_memory_usage_info(amdsmi_processor_handle processor_handle,
+                                 amdsmi_gpu_memory_usage_t *info);
+
 /**
  *  @brief          Returns the violations for a processor
  *
- *  Warning: API will be slow due to polling driver for 2 samples. Require
- *  a minimum wait of 100ms between the 2 samples in order to calculate. Otherwise
- *  users would need to use amdsmi_get_gpu_metrics_info for BM. See that API's struct
- *  for calculations.
+ *  The violation percentages are computed over the interval since the
+ *  previous call on the same processor (reported in window_us), so polling
+ *  this API at a fixed rate gives the violations of each polling interval
+ *  without blocking. The first call on a processor (or the first one after
+ *  the driver reset its accumulators) has no previous sample: it only records
+ *  the baseline and returns the accumulators with window_us, the percentages
+ *  and the active flags set to their max value (unavailable). A call made
+ *  before the firmware updated the accumulators again returns the previous
+ *  percentages.
  *
  *  @platform{gpu_bm_linux} @platform{host}
  *
@@ -5118,6 +5989,28 @@ amdsmi_status_t
 amdsmi_get_violation_status(amdsmi_processor_handle processor_handle,
                             amdsmi_violation_status_t *info);
 
+/**
+ *  @brief          Returns the violations of a processor over the last
+ *                  1 s, 10 s and 60 s
+ *
+ *  @platform{gpu_bm_linux} @platform{host}
+ *
+ *  @details Computed from the samples taken by this API and
+ *  ::amdsmi_get_violation_status (at most one kept every 250 ms), so they are
+ *  only as fine as the caller's polling rate. covered_us is the time actually
+ *  covered by the samples within each window. Takes a new sample, with no wait.
+ *
+ *  @param[in]      processor_handle Device which to query
+ *
+ *  @param[out]     stats Array of ::AMDSMI_NUM_VIOLATION_WINDOWS entries, for
+ *                  the 1 s, 10 s and 60 s windows. Must be allocated by user.
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t
+amdsmi_get_violation_window_stats(amdsmi_processor_handle processor_handle,
+                                  amdsmi_violation_window_stats_t *stats);
+
 
 /** @} End gpumon */
 
@@ -5176,6 +6069,36 @@ amdsmi_get_violation_status(amdsmi_processor_handle processor_handle,
 amdsmi_status_t
 amdsmi_get_gpu_process_list(amdsmi_processor_handle processor_handle, uint32_t *max_processes, amdsmi_proc_info_t *list);
 
+/**
+ *  @brief          Returns the DRM engine and memory usage of the processes using a given GPU.
+ *
+ *  @platform{gpu_bm_linux}
+ *
+ *  @details        The usage is read from the DRM fdinfo of every process with
+ *                  a DRM fd open on the GPU, and summed over its DRM clients.
+ *                  The busy_percent of each engine is computed against the
+ *                  previous read of the same process (by this or any other
+ *                  process list call), so calling this function periodically,
+ *                  e.g. once per second, gives per process (and per container)
+ *                  GPU utilization.
+ *
+ *  @param[in]      processor_handle Device which to query
+ *
+ *  @param[in,out]  max_processes As input, the number of entries in @p list .
+ *                  As output, the number of processes using the GPU. If it is 0
+ *                  as input, only the number of processes is returned.
+ *
+ *  @param[out]     list Reference to a user-provided buffer of max_processes
+ *                  entries where the usage will be returned.
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success,
+ *                            | ::AMDSMI_STATUS_OUT_OF_RESOURCES, filled list buffer with data, but number of
+ *                                processes is larger than the size provided.
+ */
+amdsmi_status_t
+amdsmi_get_gpu_process_drm_usage(amdsmi_processor_handle processor_handle, uint32_t *max_processes,
+                                 amdsmi_proc_drm_usage_t *list);
+
 /** @} End processinfo */
 
 /*****************************************************************************/
@@ -5188,6 +6111,10 @@ amdsmi_get_gpu_process_list(amdsmi_processor_handle processor_handle, uint32_t *
  *                  uncorrectable and deferred) in the given GPU. It is not supported on
  *                  virtual machine guest
  *
+ *  @details        The counts of all the ECC enabled blocks are summed, as
+ *                  returned by amdsmi_get_gpu_ecc_count_all(). An error
+ *                  from that call is returned as is.
+ *
  *  @platform{gpu_bm_linux}  @platform{host}
  *
  *  @param[in]      processor_handle Device which to query
@@ -5847,6 +6774,40 @@ amdsmi_status_t amdsmi_get_hsmp_metrics_table(amdsmi_processor_handle processor_
 
 /** @} MetQuer */
 
+/*****************************************************************************/
+/**  @defgroup cputelemetry     CPU telemetry snapshot
+ *  @{
+ */
+
+/**
+ *  @brief Get energy, power, frequency limits and boost limits of every CPU
+ *  socket and core in one call.
+ *
+ *  @platform{cpu_bm}
+ *
+ *  @details The socket and core indices are resolved once at ::amdsmi_init,
+ *  so the snapshot does no per-processor handle lookup and keeps no global
+ *  state; it may be called from several threads at once.
+ *
+ *  If @p sockets is NULL, @p num_sockets is set to the number of CPU sockets;
+ *  likewise for @p cores and @p num_cores. Otherwise the count is read as the
+ *  number of entries the buffer can hold and is set to the number filled.
+ *  Values ESMI fails to report are set to the max value of their type.
+ *
+ *  @param[in,out]  sockets - Buffer for the per socket values, or NULL
+ *  @param[in,out]  num_sockets - Number of entries in @p sockets
+ *  @param[in,out]  cores - Buffer for the per core values, or NULL
+ *  @param[in,out]  num_cores - Number of entries in @p cores
+ *
+ *  @return ::amdsmi_status_t | ::AMDSMI_STATUS_SUCCESS on success, non-zero on fail
+ */
+amdsmi_status_t amdsmi_get_cpu_telemetry(amdsmi_cpu_socket_telemetry_t *sockets,
+                                         uint32_t *num_sockets,
+                                         amdsmi_cpu_core_telemetry_t *cores,
+                                         uint32_t *num_cores);
+
+/** @} cputelemetry */
+
 /*****************************************************************************/
 /**  @defgroup auxiquer     Auxillary functions
  *  @{
@@ -94,6 +94,10 @@ amdsmi_status_t rsmi_to_amdsmi_status(rsmi_status_t status);
 
 amdsmi_vram_type_t vram_type_value(unsigned type);
 
+// Splits a BDF id as returned by rsmi_dev_pci_id_get() (domain in bits
+// 63:32, bus in 15:8, device in 7:3, function in 2:0) into amdsmi_bdf_t
+amdsmi_bdf_t rsmi_bdf_to_amdsmi_bdf(uint64_t bdf_rocm);
+
 #ifdef ENABLE_ESMI_LIB
 // Define a map of esmi status codes to amdsmi status codes
 const std::map<esmi_status_t, amdsmi_status_t> esmi_status_map = {
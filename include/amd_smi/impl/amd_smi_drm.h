@@ -46,6 +46,7 @@
 
 #include <unistd.h>
 #include <xf86drm.h>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <mutex>  // NOLINT
@@ -57,17 +58,23 @@ namespace smi {
 
 class AMDSmiDrm {
  public:
-    amdsmi_status_t init();
+    // With lazy, the render node of a GPU is only opened on its first use
+    amdsmi_status_t init(bool lazy = false);
     amdsmi_status_t cleanup();
-    amdsmi_status_t get_drm_fd_by_index(uint32_t gpu_index, uint32_t *fd_info) const;
-    amdsmi_status_t get_bdf_by_index(uint32_t gpu_index, amdsmi_bdf_t *bdf_info) const;
-    amdsmi_status_t get_drm_path_by_index(uint32_t gpu_index, std::string *drm_path) const;
+    amdsmi_status_t get_drm_fd_by_index(uint32_t gpu_index, uint32_t *fd_info);
+    amdsmi_status_t get_bdf_by_index(uint32_t gpu_index, amdsmi_bdf_t *bdf_info);
+    amdsmi_status_t get_drm_path_by_index(uint32_t gpu_index, std::string *drm_path);
     std::vector<amdsmi_bdf_t> get_bdfs();
     std::vector<std::string>& get_drm_paths();
     bool check_if_drm_is_supported();
+    bool is_lazy() const { return lazy_; }
 
    uint32_t get_vendor_id();
 
+    // The queries below take no lock: drmCommandWrite() and drmGetVersion()
+    // keep no state in libdrm and the kernel handles concurrent
+    // DRM_AMDGPU_INFO queries, so threads on different GPUs don't wait on
+    // each other.
     amdsmi_status_t amdgpu_query_info(int fd, unsigned info_id,
                     unsigned size, void *value);
     amdsmi_status_t  amdgpu_query_fw(int fd, unsigned info_id, unsigned fw_type,
@@ -79,14 +86,18 @@ class AMDSmiDrm {
     amdsmi_status_t amdgpu_query_driver_date(int fd, std::string& driver_date);
 
  private:
-    // when file is not found, the empty string will be returned
-    std::string find_file_in_folder(const std::string& folder,
-                  const std::string& regex);
+    // when no render node is found, the empty string will be returned
+    std::string find_render_node(const std::string& folder);
+    // Opens the render node of gpu_index and fills in its fd, path and bdf
+    void open_render_node(uint32_t gpu_index);
+    void open_render_node_once(uint32_t gpu_index);
     using DrmCmdWriteFunc = int (*)(int, unsigned long, void *, unsigned long);
     std::vector<int> drm_fds_;  // drm file descriptor by gpu_index
     std::vector<std::string> drm_paths_; // drm path (renderD128 for example)
     std::vector<amdsmi_bdf_t> drm_bdfs_; // bdf
-    uint32_t vendor_id;
+    std::unique_ptr<std::once_flag[]> drm_open_once_;  // by gpu_index
+    bool lazy_ = false;
+    std::atomic<uint32_t> vendor_id{0};
 
     AMDSmiLibraryLoader lib_loader_;  // lazy load libdrm
     DrmCmdWriteFunc drm_cmd_write_;   // drmCommandWrite
@@ -94,8 +105,10 @@ class AMDSmiDrm {
     using drmFreeVersionFunc = void (*)(drmVersionPtr);  // drmFreeVersion
     drmGetVersionFunc drm_get_version_;
     drmFreeVersionFunc drm_free_version_;
-
-    std::mutex drm_mutex_;
+    using drmGetDeviceFunc = int (*)(int, drmDevicePtr*);  // drmGetDevice
+    using drmFreeDeviceFunc = void (*)(drmDevicePtr*);     // drmFreeDevice
+    drmGetDeviceFunc drm_get_device_;
+    drmFreeDeviceFunc drm_free_device_;
 };
 
 
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2024 Advanced Micro Devices. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AMD_SMI_INCLUDE_AMD_SMI_FIELDS_H_
+#define AMD_SMI_INCLUDE_AMD_SMI_FIELDS_H_
+
+#include <vector>
+
+#include "amd_smi/amdsmi.h"
+#include "amd_smi/impl/amd_smi_gpu_device.h"
+
+// Reads all requested fields of a GPU under a single device lock, reading
+// every field source (gpu_metrics, pp_dpm_*, ...) at most once.
+amdsmi_status_t smi_amdgpu_get_fields(amd::smi::AMDSmiGPUDevice* device,
+                                      amdsmi_field_value_t *fields, uint32_t num_fields);
+
+// Sets bit i of *bitmap if field i can be read from the GPU. hwmon and sysfs
+// fields are checked against the device's support bitmap without reading
+// them; gpu_metrics fields take one gpu_metrics read.
+amdsmi_status_t smi_amdgpu_get_supported_fields(amd::smi::AMDSmiGPUDevice* device,
+                                                uint64_t *bitmap);
+
+// Reads the same fields from every device on the system worker pool; the
+// values of devices[i] go to values[i * num_fields, (i + 1) * num_fields).
+amdsmi_status_t smi_amdgpu_get_fields_multi(const std::vector<amd::smi::AMDSmiGPUDevice*>& devices,
+                                            const amdsmi_field_id_t *field_ids, uint32_t num_fields,
+                                            amdsmi_field_value_t *values);
+
+#endif  // AMD_SMI_INCLUDE_AMD_SMI_FIELDS_H_
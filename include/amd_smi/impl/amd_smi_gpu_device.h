@@ -47,6 +47,9 @@
 #include "amd_smi/amdsmi.h"
 #include "amd_smi/impl/amd_smi_processor.h"
 #include "amd_smi/impl/amd_smi_drm.h"
+#include "amd_smi/impl/amd_smi_link_rate.h"
+#include "amd_smi/impl/amd_smi_sampler.h"
+#include "amd_smi/impl/amd_smi_violation.h"
 #include "shared_mutex.h"  // NOLINT
 #include "rocm_smi/rocm_smi_logger.h"
 
@@ -73,18 +76,34 @@ class AMDSmiGPUDevice: public AMDSmiProcessor {
 
     AMDSmiGPUDevice(uint32_t gpu_id, AMDSmiDrm& drm):
             AMDSmiProcessor(AMDSMI_PROCESSOR_TYPE_AMD_GPU), gpu_id_(gpu_id), drm_(drm) {
-                if (check_if_drm_is_supported()) this->get_drm_data();
+                // The render node is opened on first use; the BDF is the same
+                if (drm_.is_lazy()) {
+                    this->get_rsmi_bdf();
+                    return;
+                }
+                if (!check_if_drm_is_supported() ||
+                    this->get_drm_data() != AMDSMI_STATUS_SUCCESS) {
+                    this->get_rsmi_bdf();
+                }
             }
     ~AMDSmiGPUDevice() {
+        // The sampler thread uses this device; stop it even if a reader
+        // still holds on to the sampler.
+        auto sampler = get_background_sampler();
+        if (sampler) {
+            sampler->stop();
+        }
     }
 
     amdsmi_status_t get_drm_data();
+    amdsmi_status_t get_rsmi_bdf();
     pthread_mutex_t* get_mutex();
+    shared_rwlock_t* get_rwlock();
     uint32_t get_gpu_id() const;
-    uint32_t get_gpu_fd() const;
+    uint32_t get_gpu_fd();
     std::string& get_gpu_path();
     amdsmi_bdf_t  get_bdf();
-    bool check_if_drm_is_supported() { return drm_.check_if_drm_is_supported(); }
+    bool check_if_drm_is_supported();
     uint32_t get_vendor_id();
     const GPUComputeProcessList_t& amdgpu_get_compute_process_list(ComputeProcessListType_t list_type = ComputeProcessListType_t::kAllProcessesOnDevice);
     const GPUComputeProcessList_t& amdgpu_get_all_compute_process_list() {
@@ -101,14 +120,36 @@ class AMDSmiGPUDevice: public AMDSmiProcessor {
     amdsmi_status_t amdgpu_query_driver_name(std::string& name) const;
     amdsmi_status_t amdgpu_query_driver_date(std::string& date) const;
 
+    // Background sampler of this GPU; nullptr if none was started
+    std::shared_ptr<AMDSmiBackgroundSampler> get_background_sampler() const {
+        return std::atomic_load(&background_sampler_);
+    }
+    // Installs sampler if none is running; returns false otherwise
+    bool start_background_sampler(std::shared_ptr<AMDSmiBackgroundSampler> sampler);
+    std::shared_ptr<AMDSmiBackgroundSampler> stop_background_sampler() {
+        return std::atomic_exchange(&background_sampler_,
+                                    std::shared_ptr<AMDSmiBackgroundSampler>());
+    }
+
+    // Last throttle residency sample of this GPU
+    AMDSmiViolationTracker& get_violation_tracker() { return violation_tracker_; }
+
+    // Last link traffic sample of this GPU
+    AMDSmiLinkRateTracker& get_link_rate_tracker() { return link_rate_tracker_; }
+
  private:
     uint32_t gpu_id_;
     uint32_t fd_;
     std::string path_;
-    amdsmi_bdf_t bdf_;
+    amdsmi_bdf_t bdf_ = {};
     uint32_t vendor_id_;
     AMDSmiDrm& drm_;
+    std::once_flag drm_data_once_;  // lazy DRM init only
+    bool drm_data_valid_ = false;
     GPUComputeProcessList_t compute_process_list_;
+    std::shared_ptr<AMDSmiBackgroundSampler> background_sampler_;
+    AMDSmiViolationTracker violation_tracker_;
+    AMDSmiLinkRateTracker link_rate_tracker_;
     int32_t get_compute_process_list_impl(GPUComputeProcessList_t& compute_process_list,
                                           ComputeProcessListType_t list_type);
 
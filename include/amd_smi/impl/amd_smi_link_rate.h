@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2024 Advanced Micro Devices. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AMD_SMI_INCLUDE_AMD_SMI_LINK_RATE_H_
+#define AMD_SMI_INCLUDE_AMD_SMI_LINK_RATE_H_
+
+#include <cstdint>
+#include <mutex>
+
+#include "amd_smi/amdsmi.h"
+
+namespace amd {
+namespace smi {
+
+// Link traffic of one gpu_metrics read. The XGMI accumulators are
+// cumulative.
+struct AMDSmiLinkSample {
+    uint64_t time_ns;       // firmware timestamp, or steady clock
+    uint64_t xgmi_read_kb[AMDSMI_MAX_NUM_XGMI_LINKS];    // UINT64_MAX if unsupported
+    uint64_t xgmi_write_kb[AMDSMI_MAX_NUM_XGMI_LINKS];   // UINT64_MAX if unsupported
+    uint64_t pcie_bandwidth_inst;   // GB/s; UINT64_MAX if unsupported
+    float xgmi_max_gbps;            // 0 if unknown
+    float pcie_max_gbps;            // 0 if unknown
+};
+
+// Keeps the last link sample of one GPU and turns the next one into per-link
+// GB/s and utilization. The caller holds mutex() while reading a sample and
+// calling update().
+class AMDSmiLinkRateTracker {
+ public:
+    AMDSmiLinkRateTracker();
+
+    std::mutex& mutex() { return mutex_; }
+
+    // Makes sample the new baseline and computes the rates since the previous
+    // one. Returns false if there is no previous sample to compare against
+    // (first call, or time went back). A link whose accumulator went back
+    // is reported as not available (-1) for this window. A sample with the
+    // same timestamp as the baseline returns the last result.
+    bool update(const AMDSmiLinkSample& sample, amdsmi_link_rates_t* rates);
+
+    // KFD io_link max bandwidth of the XGMI peers, in GB/s; looked up once
+    bool xgmi_kfd_max_known() const { return xgmi_kfd_max_known_; }
+    float xgmi_kfd_max_gbps() const { return xgmi_kfd_max_gbps_; }
+    void set_xgmi_kfd_max_gbps(float gbps) {
+        xgmi_kfd_max_gbps_ = gbps;
+        xgmi_kfd_max_known_ = true;
+    }
+
+ private:
+    std::mutex mutex_;
+    bool has_baseline_;
+    AMDSmiLinkSample baseline_;
+    bool has_rates_;
+    amdsmi_link_rates_t rates_;
+    bool xgmi_kfd_max_known_;
+    float xgmi_kfd_max_gbps_;
+};
+
+}  // namespace smi
+}  // namespace amd
+
+#endif  // AMD_SMI_INCLUDE_AMD_SMI_LINK_RATE_H_
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024 Advanced Micro Devices. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AMD_SMI_INCLUDE_AMD_SMI_SAMPLER_H_
+#define AMD_SMI_INCLUDE_AMD_SMI_SAMPLER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "amd_smi/amdsmi.h"
+
+namespace amd {
+namespace smi {
+
+class AMDSmiGPUDevice;
+
+// Ring of fixed size sample records with a single producer and any number
+// of readers, each one with its own cursor. Every slot is guarded by a
+// sequence number (seqlock), so readers never take a lock or make a syscall;
+// a reader that falls more than one ring behind skips to the oldest record
+// kept.
+class AMDSmiSampleRing {
+ public:
+    explicit AMDSmiSampleRing(uint32_t depth);
+
+    AMDSmiSampleRing(const AMDSmiSampleRing&) = delete;
+    AMDSmiSampleRing& operator=(const AMDSmiSampleRing&) = delete;
+
+    // Number of records published so far; the next record's sequence
+    uint64_t num_published() const {
+        return num_published_.load(std::memory_order_acquire);
+    }
+
+    // Stores sample as record sample.sequence, which must be num_published().
+    // Only one thread may publish.
+    void publish(const amdsmi_field_sample_t& sample);
+
+    // Copies up to max_samples records with a sequence >= *cursor, oldest
+    // first, and moves *cursor past the last one copied.
+    uint32_t read(uint64_t* cursor, amdsmi_field_sample_t* samples, uint32_t max_samples) const;
+
+ private:
+    struct RingSlot {
+        // 2n + 1 while record n is being written, 2n + 2 once it is complete
+        std::atomic<uint64_t> m_sequence{0};
+        amdsmi_field_sample_t m_sample;
+    };
+
+    uint32_t depth_;
+    std::unique_ptr<RingSlot[]> ring_;
+    std::atomic<uint64_t> num_published_;
+};
+
+// Samples a fixed set of fields of one GPU on its own thread, at a fixed
+// period, into an AMDSmiSampleRing.
+class AMDSmiBackgroundSampler {
+ public:
+    AMDSmiBackgroundSampler(AMDSmiGPUDevice* device,
+                            const amdsmi_field_id_t* field_ids, uint32_t num_fields,
+                            uint64_t period_us, uint32_t depth);
+    ~AMDSmiBackgroundSampler();
+
+    AMDSmiBackgroundSampler(const AMDSmiBackgroundSampler&) = delete;
+    AMDSmiBackgroundSampler& operator=(const AMDSmiBackgroundSampler&) = delete;
+
+    void start();
+    void stop();
+
+    // See AMDSmiSampleRing::read()
+    uint32_t read(uint64_t* cursor, amdsmi_field_sample_t* samples, uint32_t max_samples) const {
+        return ring_.read(cursor, samples, max_samples);
+    }
+
+ private:
+    void sampler_loop();
+
+    AMDSmiGPUDevice* device_;
+    std::vector<amdsmi_field_id_t> field_ids_;
+    uint64_t period_us_;
+    AMDSmiSampleRing ring_;
+
+    std::thread thread_;
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    bool stopping_;
+};
+
+}  // namespace smi
+}  // namespace amd
+
+#endif  // AMD_SMI_INCLUDE_AMD_SMI_SAMPLER_H_
@@ -46,10 +46,13 @@
 
 #include <vector>
 #include <set>
+#include <memory>
+#include <mutex>
 #include "amd_smi/amdsmi.h"
 #include "amd_smi/impl/amd_smi_socket.h"
 #include "amd_smi/impl/amd_smi_processor.h"
 #include "amd_smi/impl/amd_smi_drm.h"
+#include "amd_smi/impl/amd_smi_worker_pool.h"
 
 namespace amd {
 namespace smi {
@@ -78,6 +81,15 @@ class AMDSmiSystem {
     amdsmi_status_t get_cpu_family(uint32_t *cpu_family);
 
     amdsmi_status_t get_cpu_model(uint32_t *cpu_model);
+
+    // CPU topology recorded at init: esmi core c lives on socket
+    // c / cores_per_socket.
+    uint32_t get_cpu_socket_count() const { return cpu_sockets_; }
+    uint32_t get_cpu_cores_per_socket() const { return cpu_cores_per_socket_; }
+
+    // Pool used to query several GPUs in parallel; created on first use.
+    // The returned reference keeps the pool alive across cleanup().
+    std::shared_ptr<AMDSmiWorkerPool> get_worker_pool();
  private:
     AMDSmiSystem() : init_flag_(AMDSMI_INIT_AMD_GPUS) {}
 
@@ -92,6 +104,10 @@ class AMDSmiSystem {
     AMDSmiDrm drm_;
     std::vector<AMDSmiSocket*> sockets_;
     std::set<AMDSmiProcessor*> processors_;     // Track valid processors
+    uint32_t cpu_sockets_ = 0;
+    uint32_t cpu_cores_per_socket_ = 0;
+    std::mutex worker_pool_mutex_;
+    std::shared_ptr<AMDSmiWorkerPool> worker_pool_;
 };
 }  // namespace smi
 }  // namespace amd
@@ -30,10 +30,11 @@
 #include "rocm_smi/rocm_smi_utils.h"
 
 
-#define SMIGPUDEVICE_MUTEX(MUTEX) \
-    amd::smi::pthread_wrap _pw(*(MUTEX)); \
-    amd::smi::ScopedPthread _lock(_pw, true); \
-    if (_lock.mutex_not_acquired()) { \
+// Takes the device lock shared; every user of it is a getter
+#define SMIGPUDEVICE_READ_MUTEX(DEVICE) \
+    amd::smi::ScopedDeviceLock _lock((DEVICE)->get_rwlock(), \
+                                     amd::smi::kDeviceLockShared, true); \
+    if (_lock.lock_not_acquired()) { \
       return AMDSMI_STATUS_BUSY; \
     }
 
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2024 Advanced Micro Devices. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AMD_SMI_INCLUDE_AMD_SMI_VIOLATION_H_
+#define AMD_SMI_INCLUDE_AMD_SMI_VIOLATION_H_
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+#include "amd_smi/amdsmi.h"
+
+namespace amd {
+namespace smi {
+
+enum AMDSmiViolationType {
+    kViolationProchotThrm = 0,
+    kViolationPptPwr,
+    kViolationSocketThrm,
+    kViolationVrThrm,
+    kViolationHbmThrm,
+    kViolationNumTypes
+};
+
+// Throttle residency accumulators of one gpu_metrics read
+struct AMDSmiViolationSample {
+    uint64_t time_us;       // steady clock
+    uint64_t acc_counter;
+    uint64_t residency_acc[kViolationNumTypes];
+};
+
+// Residency % of every violation type over [from, to] of two samples
+struct AMDSmiViolationResidency {
+    uint64_t window_us;
+    uint64_t percent[kViolationNumTypes];  // UINT64_MAX if unsupported
+};
+
+// Keeps the last accumulator sample of one GPU, so violation percentages
+// are computed over the interval between two calls instead of two reads
+// taken 100 ms apart. Samples at least kHistorySpacingUs apart are also kept
+// for the last ~64 s, for rolling window stats; those are computed against
+// the caller's own sample, so they do not depend on other callers' polling.
+class AMDSmiViolationTracker {
+ public:
+    AMDSmiViolationTracker();
+
+    // Makes sample the new baseline and computes the residency since the
+    // previous one. Returns false if there is no previous sample to compare
+    // against (first call, or the accumulators were reset). A sample taken
+    // before the firmware updated the accumulators returns the last result.
+    bool update(const AMDSmiViolationSample& sample, AMDSmiViolationResidency* residency);
+
+    // Adds sample to the kept samples without moving the baseline of
+    // update(); drops them if the accumulators were reset
+    void record(const AMDSmiViolationSample& sample);
+
+    // Residency over the window_us before now, from the oldest kept sample
+    // within that window to now
+    void window_stats(const AMDSmiViolationSample& now, uint64_t window_us,
+                      amdsmi_violation_window_stats_t* stats) const;
+
+    static constexpr uint64_t kHistorySpacingUs = 250000;
+    static constexpr uint32_t kHistoryDepth = 256;
+
+ private:
+    void push_history(const AMDSmiViolationSample& sample);
+
+    mutable std::mutex mutex_;
+    bool has_baseline_;
+    AMDSmiViolationSample baseline_;
+    bool has_residency_;
+    AMDSmiViolationResidency residency_;
+    std::array<AMDSmiViolationSample, kHistoryDepth> history_;
+    uint32_t history_head_;   // next slot written
+    uint32_t history_count_;
+};
+
+}  // namespace smi
+}  // namespace amd
+
+#endif  // AMD_SMI_INCLUDE_AMD_SMI_VIOLATION_H_
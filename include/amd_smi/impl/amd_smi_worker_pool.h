@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2024 Advanced Micro Devices. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AMD_SMI_INCLUDE_AMD_SMI_WORKER_POOL_H_
+#define AMD_SMI_INCLUDE_AMD_SMI_WORKER_POOL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace amd {
+namespace smi {
+
+// Fixed size pool of worker threads used to query several devices at once.
+class AMDSmiWorkerPool {
+ public:
+    explicit AMDSmiWorkerPool(uint32_t num_workers);
+    ~AMDSmiWorkerPool();
+
+    AMDSmiWorkerPool(const AMDSmiWorkerPool&) = delete;
+    AMDSmiWorkerPool& operator=(const AMDSmiWorkerPool&) = delete;
+
+    // Runs all tasks on the pool; returns once every one of them finished.
+    void run_all(const std::vector<std::function<void()>>& tasks);
+    uint32_t size() const { return static_cast<uint32_t>(workers_.size()); }
+
+ private:
+    void worker_loop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable task_cv_;
+    bool stopping_;
+};
+
+}  // namespace smi
+}  // namespace amd
+
+#endif  // AMD_SMI_INCLUDE_AMD_SMI_WORKER_POOL_H_
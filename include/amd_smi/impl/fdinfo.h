@@ -24,15 +24,68 @@
 #ifndef __FDINFO__
 #define __FDINFO__
 
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "amd_smi/amdsmi.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 amdsmi_status_t gpuvsmi_get_pids(const amdsmi_bdf_t &bdf, std::vector<long int> &pids, uint64_t *size);
 amdsmi_status_t gpuvsmi_get_pid_info(const amdsmi_bdf_t &bdf, long int pid, amdsmi_proc_info_t &info);
+amdsmi_status_t gpuvsmi_get_drm_usage(const amdsmi_bdf_t &bdf, std::vector<amdsmi_proc_drm_usage_t> &usage);
 
 #ifdef __cplusplus
 } // extern "C"
 #endif
 
+namespace amd {
+namespace smi {
+
+/* The keys of one DRM fdinfo file; parsing it allocates nothing */
+struct DrmFdinfo {
+	const char *pdev = nullptr;
+	bool has_client_id = false;
+	uint64_t client_id = 0;
+	bool has_pasid = false;
+	int pasid = 0;
+	uint32_t num_engines = 0;
+	amdsmi_drm_engine_usage_t engines[AMDSMI_MAX_DRM_ENGINES];
+	uint32_t num_memory_regions = 0;
+	amdsmi_drm_memory_usage_t memory_regions[AMDSMI_MAX_DRM_MEMORY_REGIONS];
+};
+
+/* Usage of one GPU by one process, summed over its DRM clients */
+struct GpuUsage {
+	std::vector<int> pasids;
+	std::vector<uint64_t> client_ids;
+	uint32_t num_clients = 0;
+	uint32_t num_engines = 0;
+	amdsmi_drm_engine_usage_t engines[AMDSMI_MAX_DRM_ENGINES];
+	uint32_t num_memory_regions = 0;
+	amdsmi_drm_memory_usage_t memory_regions[AMDSMI_MAX_DRM_MEMORY_REGIONS];
+	/* Time of the pass, and time since the previous one */
+	std::chrono::steady_clock::time_point scan_time;
+	uint64_t interval_ns = 0;
+};
+
+
+/*
+ * Parses the DRM fdinfo in buf (modified in place) into fdinfo, in a
+ * single pass over its lines.
+ */
+void parse_drm_fdinfo(char *buf, DrmFdinfo &fdinfo);
+
+/* Adds the usage of one more DRM fd of a process */
+void add_drm_fdinfo(const DrmFdinfo &fdinfo, GpuUsage &usage);
+
+/* Sets the busy_percent of the engines in usage against the previous pass */
+void update_busy_percent(const GpuUsage &previous, GpuUsage &usage);
+
+}  // namespace smi
+}  // namespace amd
+
 #endif
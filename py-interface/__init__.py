@@ -74,6 +74,7 @@ try:
     from .amdsmi_interface import amdsmi_get_cpu_current_xgmi_bw
     from .amdsmi_interface import amdsmi_get_hsmp_metrics_table_version
     from .amdsmi_interface import amdsmi_get_hsmp_metrics_table
+    from .amdsmi_interface import amdsmi_get_cpu_telemetry
     from .amdsmi_interface import amdsmi_first_online_core_on_cpu_socket
     from .amdsmi_interface import amdsmi_get_cpu_family
     from .amdsmi_interface import amdsmi_get_cpu_model
@@ -101,6 +102,7 @@ from .amdsmi_interface import amdsmi_get_fw_info
 # # GPU Monitoring
 from .amdsmi_interface import amdsmi_get_gpu_activity
 from .amdsmi_interface import amdsmi_get_gpu_vram_usage
+from .amdsmi_interface import amdsmi_get_gpu_memory_usage_info
 from .amdsmi_interface import amdsmi_get_power_info
 from .amdsmi_interface import amdsmi_get_clock_info
 
@@ -170,6 +172,7 @@ from .amdsmi_interface import amdsmi_get_gpu_available_counters
 
 # # Error Query
 from .amdsmi_interface import amdsmi_get_gpu_ecc_count
+from .amdsmi_interface import amdsmi_get_gpu_ecc_count_all
 from .amdsmi_interface import amdsmi_get_gpu_ecc_enabled
 from .amdsmi_interface import amdsmi_get_gpu_ecc_status
 from .amdsmi_interface import amdsmi_status_code_to_string
@@ -228,6 +231,8 @@ from .amdsmi_interface import amdsmi_get_gpu_accelerator_partition_profile
 
 # # Individual GPU Metrics Functions
 from .amdsmi_interface import amdsmi_get_gpu_metrics_header_info
+from .amdsmi_interface import amdsmi_get_gpu_fields
+from .amdsmi_interface import amdsmi_get_supported_fields
 
 # # Enums
 from .amdsmi_interface import AmdSmiInitFlags
@@ -237,6 +242,7 @@ from .amdsmi_interface import AmdSmiMmIp
 from .amdsmi_interface import AmdSmiFwBlock
 from .amdsmi_interface import AmdSmiClkType
 from .amdsmi_interface import AmdSmiTemperatureType
+from .amdsmi_interface import AmdSmiFieldId
 from .amdsmi_interface import AmdSmiDevPerfLevel
 from .amdsmi_interface import AmdSmiEventGroup
 from .amdsmi_interface import AmdSmiEventType
@@ -81,6 +81,11 @@ class AmdSmiInitFlags(IntEnum):
     INIT_AMD_APUS = amdsmi_wrapper.AMDSMI_INIT_AMD_APUS
     INIT_NON_AMD_CPUS = amdsmi_wrapper.AMDSMI_INIT_NON_AMD_CPUS
     INIT_NON_AMD_GPUS = amdsmi_wrapper.AMDSMI_INIT_NON_AMD_GPUS
+    INIT_DISCOVERY_CACHE = amdsmi_wrapper.AMDSMI_INIT_DISCOVERY_CACHE
+    INIT_LAZY = amdsmi_wrapper.AMDSMI_INIT_LAZY
+    INIT_LOCKLESS_READS = amdsmi_wrapper.AMDSMI_INIT_LOCKLESS_READS
+    INIT_GPU_METRICS_CACHE = amdsmi_wrapper.AMDSMI_INIT_GPU_METRICS_CACHE
+    INIT_SYSFS_FD_CACHE = amdsmi_wrapper.AMDSMI_INIT_SYSFS_FD_CACHE
 
 
 class AmdSmiContainerTypes(IntEnum):
@@ -377,6 +382,34 @@ class AmdSmiMemoryPageStatus(IntEnum):
     UNRESERVABLE = amdsmi_wrapper.AMDSMI_MEM_PAGE_STATUS_UNRESERVABLE
 
 
+class AmdSmiFieldId(IntEnum):
+    TEMP_EDGE = amdsmi_wrapper.AMDSMI_FIELD_TEMP_EDGE
+    TEMP_HOTSPOT = amdsmi_wrapper.AMDSMI_FIELD_TEMP_HOTSPOT
+    TEMP_VRAM = amdsmi_wrapper.AMDSMI_FIELD_TEMP_VRAM
+    FAN_SPEED = amdsmi_wrapper.AMDSMI_FIELD_FAN_SPEED
+    FAN_RPMS = amdsmi_wrapper.AMDSMI_FIELD_FAN_RPMS
+    SOCKET_POWER = amdsmi_wrapper.AMDSMI_FIELD_SOCKET_POWER
+    ENERGY_ACCUMULATOR = amdsmi_wrapper.AMDSMI_FIELD_ENERGY_ACCUMULATOR
+    GFX_ACTIVITY = amdsmi_wrapper.AMDSMI_FIELD_GFX_ACTIVITY
+    UMC_ACTIVITY = amdsmi_wrapper.AMDSMI_FIELD_UMC_ACTIVITY
+    MM_ACTIVITY = amdsmi_wrapper.AMDSMI_FIELD_MM_ACTIVITY
+    GFX_CLK = amdsmi_wrapper.AMDSMI_FIELD_GFX_CLK
+    MEM_CLK = amdsmi_wrapper.AMDSMI_FIELD_MEM_CLK
+    SOC_CLK = amdsmi_wrapper.AMDSMI_FIELD_SOC_CLK
+    THROTTLE_STATUS = amdsmi_wrapper.AMDSMI_FIELD_THROTTLE_STATUS
+    PCIE_LINK_WIDTH = amdsmi_wrapper.AMDSMI_FIELD_PCIE_LINK_WIDTH
+    PCIE_LINK_SPEED = amdsmi_wrapper.AMDSMI_FIELD_PCIE_LINK_SPEED
+    GFX_CLK_LEVEL = amdsmi_wrapper.AMDSMI_FIELD_GFX_CLK_LEVEL
+    MEM_CLK_LEVEL = amdsmi_wrapper.AMDSMI_FIELD_MEM_CLK_LEVEL
+    VRAM_TOTAL = amdsmi_wrapper.AMDSMI_FIELD_VRAM_TOTAL
+    VRAM_USED = amdsmi_wrapper.AMDSMI_FIELD_VRAM_USED
+    VIS_VRAM_TOTAL = amdsmi_wrapper.AMDSMI_FIELD_VIS_VRAM_TOTAL
+    VIS_VRAM_USED = amdsmi_wrapper.AMDSMI_FIELD_VIS_VRAM_USED
+    GTT_TOTAL = amdsmi_wrapper.AMDSMI_FIELD_GTT_TOTAL
+    GTT_USED = amdsmi_wrapper.AMDSMI_FIELD_GTT_USED
+    POWER_CAP = amdsmi_wrapper.AMDSMI_FIELD_POWER_CAP
+
+
 class AmdSmiIoLinkType(IntEnum):
     UNDEFINED = amdsmi_wrapper.AMDSMI_IOLINK_TYPE_UNDEFINED
     PCIEXPRESS = amdsmi_wrapper.AMDSMI_IOLINK_TYPE_PCIEXPRESS
@@ -444,16 +477,17 @@ class AmdSmiEventReader:
 
     def read(self, timestamp, num_elem=10):
         self.event_info = (amdsmi_wrapper.amdsmi_evt_notification_data_t * num_elem)()
+        num_read = ctypes.c_uint32(num_elem)
         _check_res(
             amdsmi_wrapper.amdsmi_get_gpu_event_notification(
                 ctypes.c_int(timestamp),
-                ctypes.byref(ctypes.c_uint32(num_elem)),
+                ctypes.byref(num_read),
                 self.event_info,
             )
         )
 
         ret = []
-        for i in range(0, num_elem):
+        for i in range(0, num_read.value):
             unique_event_values = set(event.value for event in AmdSmiEvtNotificationType)
             if self.event_info[i].event in unique_event_values:
                 if AmdSmiEvtNotificationType(self.event_info[i].event).name != "NONE":
@@ -467,6 +501,12 @@ class AmdSmiEventReader:
 
         return ret
 
+    def fileno(self):
+        fd = ctypes.c_int32()
+        _check_res(amdsmi_wrapper.amdsmi_get_gpu_event_notification_fd(
+            ctypes.byref(fd)))
+        return fd.value
+
     def stop(self):
         _check_res(amdsmi_wrapper.amdsmi_stop_gpu_event_notification(
             self.processor_handle))
@@ -1556,6 +1596,40 @@ def amdsmi_get_hsmp_metrics_table(
         "mtbl_hbm_thm_residency_acc": mtbl.hbm_thm_residency_acc
     }
 
+def amdsmi_get_cpu_telemetry():
+    num_sockets = ctypes.c_uint32(0)
+    num_cores = ctypes.c_uint32(0)
+    _check_res(
+        amdsmi_wrapper.amdsmi_get_cpu_telemetry(
+            None, ctypes.byref(num_sockets), None, ctypes.byref(num_cores))
+    )
+
+    sockets = (amdsmi_wrapper.amdsmi_cpu_socket_telemetry_t * num_sockets.value)()
+    cores = (amdsmi_wrapper.amdsmi_cpu_core_telemetry_t * num_cores.value)()
+    _check_res(
+        amdsmi_wrapper.amdsmi_get_cpu_telemetry(
+            sockets, ctypes.byref(num_sockets), cores, ctypes.byref(num_cores))
+    )
+
+    return {
+        "sockets": [{
+            "socket_index": sock.socket_index,
+            "power": _validate_if_max_uint(sock.power, MaxUIntegerTypes.UINT32_T),
+            "power_cap": _validate_if_max_uint(sock.power_cap, MaxUIntegerTypes.UINT32_T),
+            "energy": _validate_if_max_uint(sock.energy, MaxUIntegerTypes.UINT64_T),
+            "freq_limit": _validate_if_max_uint(sock.freq_limit, MaxUIntegerTypes.UINT16_T),
+            "fmax": _validate_if_max_uint(sock.fmax, MaxUIntegerTypes.UINT16_T),
+            "fmin": _validate_if_max_uint(sock.fmin, MaxUIntegerTypes.UINT16_T),
+        } for sock in sockets[:num_sockets.value]],
+        "cores": [{
+            "core_index": core.core_index,
+            "socket_index": core.socket_index,
+            "energy": _validate_if_max_uint(core.energy, MaxUIntegerTypes.UINT64_T),
+            "boostlimit": _validate_if_max_uint(core.boostlimit, MaxUIntegerTypes.UINT32_T),
+            "freq_limit": _validate_if_max_uint(core.freq_limit, MaxUIntegerTypes.UINT32_T),
+        } for core in cores[:num_cores.value]],
+    }
+
 def amdsmi_first_online_core_on_cpu_socket(
     processor_handle: amdsmi_wrapper.amdsmi_processor_handle
 ):
@@ -1992,6 +2066,7 @@ def amdsmi_get_violation_status(
     return {
         "reference_timestamp": _validate_if_max_uint(violation_status.reference_timestamp, MaxUIntegerTypes.UINT64_T),
         "violation_timestamp": _validate_if_max_uint(violation_status.violation_timestamp, MaxUIntegerTypes.UINT64_T),
+        "window_us": _validate_if_max_uint(violation_status.window_us, MaxUIntegerTypes.UINT64_T),
         "acc_counter": _validate_if_max_uint(violation_status.acc_counter, MaxUIntegerTypes.UINT64_T),
         "acc_prochot_thrm": _validate_if_max_uint(violation_status.acc_prochot_thrm, MaxUIntegerTypes.UINT64_T),
         "acc_ppt_pwr": _validate_if_max_uint(violation_status.acc_ppt_pwr, MaxUIntegerTypes.UINT64_T),                           #PVIOL
@@ -2332,6 +2407,30 @@ def amdsmi_get_gpu_vram_usage(
     return {"vram_total": vram_usage.vram_total, "vram_used": vram_usage.vram_used}
 
 
+def amdsmi_get_gpu_memory_usage_info(
+    processor_handle: amdsmi_wrapper.amdsmi_processor_handle,
+) -> Dict[str, Any]:
+    if not isinstance(processor_handle, amdsmi_wrapper.amdsmi_processor_handle):
+        raise AmdSmiParameterException(
+            processor_handle, amdsmi_wrapper.amdsmi_processor_handle
+        )
+
+    mem_usage = amdsmi_wrapper.amdsmi_gpu_memory_usage_t()
+    _check_res(
+        amdsmi_wrapper.amdsmi_get_gpu_memory_usage_info(
+            processor_handle, ctypes.byref(mem_usage))
+    )
+
+    return {
+        "vram_total": mem_usage.vram_total,
+        "vram_used": mem_usage.vram_used,
+        "vis_vram_total": mem_usage.vis_vram_total,
+        "vis_vram_used": mem_usage.vis_vram_used,
+        "gtt_total": mem_usage.gtt_total,
+        "gtt_used": mem_usage.gtt_used,
+    }
+
+
 def amdsmi_get_pcie_info(
     processor_handle: amdsmi_wrapper.amdsmi_processor_handle,
 ) -> Dict[str, Any]:
@@ -3962,6 +4061,30 @@ def amdsmi_get_gpu_ecc_count(
     }
 
 
+def amdsmi_get_gpu_ecc_count_all(
+    processor_handle: amdsmi_wrapper.amdsmi_processor_handle,
+) -> List[Dict[str, Any]]:
+    if not isinstance(processor_handle, amdsmi_wrapper.amdsmi_processor_handle):
+        raise AmdSmiParameterException(
+            processor_handle, amdsmi_wrapper.amdsmi_processor_handle
+        )
+
+    # One entry per bit of the block mask is always enough
+    counts = (amdsmi_wrapper.amdsmi_gpu_block_error_count_t * 64)()
+    num_blocks = ctypes.c_uint32(len(counts))
+    _check_res(
+        amdsmi_wrapper.amdsmi_get_gpu_ecc_count_all(
+            processor_handle, ctypes.byref(num_blocks), counts)
+    )
+
+    return [{
+        "block": AmdSmiGpuBlock(count.block),
+        "correctable_count": count.ec.correctable_count,
+        "uncorrectable_count": count.ec.uncorrectable_count,
+        "deferred_count": count.ec.deferred_count,
+    } for count in counts[:num_blocks.value]]
+
+
 def amdsmi_get_gpu_ecc_enabled(
     processor_handle: amdsmi_wrapper.amdsmi_processor_handle,
 ) -> int:
@@ -4158,6 +4281,65 @@ def amdsmi_get_gpu_metrics_header_info(
         "content_revision": header_info.content_revision
     }
 
+def amdsmi_get_gpu_fields(
+    processor_handle: amdsmi_wrapper.amdsmi_processor_handle,
+    field_ids: List[AmdSmiFieldId],
+) -> List[Dict[str, Any]]:
+    if not isinstance(processor_handle, amdsmi_wrapper.amdsmi_processor_handle):
+        raise AmdSmiParameterException(
+            processor_handle, amdsmi_wrapper.amdsmi_processor_handle
+        )
+    if not isinstance(field_ids, list) or not field_ids:
+        raise AmdSmiParameterException(field_ids, List[AmdSmiFieldId])
+    for field_id in field_ids:
+        if not isinstance(field_id, AmdSmiFieldId):
+            raise AmdSmiParameterException(field_id, AmdSmiFieldId)
+
+    fields = (amdsmi_wrapper.amdsmi_field_value_t * len(field_ids))()
+    for index, field_id in enumerate(field_ids):
+        fields[index].field_id = field_id
+    _check_res(
+        amdsmi_wrapper.amdsmi_get_gpu_fields(
+            processor_handle, fields, ctypes.c_uint32(len(field_ids))
+        )
+    )
+
+    field_values = []
+    for field in fields:
+        value = "N/A"
+        if field.status == amdsmi_wrapper.AMDSMI_STATUS_SUCCESS:
+            if field.type == amdsmi_wrapper.AMDSMI_FIELD_TYPE_INT64:
+                value = field.value.i64
+            else:
+                value = field.value.u64
+        field_values.append({
+            "field_id": AmdSmiFieldId(field.field_id),
+            "status": field.status,
+            "value": value,
+        })
+
+    return field_values
+
+
+def amdsmi_get_supported_fields(
+    processor_handle: amdsmi_wrapper.amdsmi_processor_handle,
+) -> List[AmdSmiFieldId]:
+    if not isinstance(processor_handle, amdsmi_wrapper.amdsmi_processor_handle):
+        raise AmdSmiParameterException(
+            processor_handle, amdsmi_wrapper.amdsmi_processor_handle
+        )
+
+    bitmap = ctypes.c_uint64(0)
+    _check_res(
+        amdsmi_wrapper.amdsmi_get_supported_fields(
+            processor_handle, ctypes.byref(bitmap)
+        )
+    )
+
+    return [field_id for field_id in AmdSmiFieldId
+            if bitmap.value & (1 << field_id)]
+
+
 def amdsmi_get_link_topology_nearest(
     processor_handle: amdsmi_wrapper.amdsmi_processor_handle,
     link_type: AmdSmiLinkType,
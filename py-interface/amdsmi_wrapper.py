@@ -192,6 +192,11 @@ amdsmi_init_flags_t__enumvalues = {
     4: 'AMDSMI_INIT_NON_AMD_CPUS',
     8: 'AMDSMI_INIT_NON_AMD_GPUS',
     3: 'AMDSMI_INIT_AMD_APUS',
+    9007199254740992: 'AMDSMI_INIT_LOCKLESS_READS',
+    18014398509481984: 'AMDSMI_INIT_DISCOVERY_CACHE',
+    36028797018963968: 'AMDSMI_INIT_LAZY',
+    72057594037927936: 'AMDSMI_INIT_GPU_METRICS_CACHE',
+    144115188075855872: 'AMDSMI_INIT_SYSFS_FD_CACHE',
 }
 AMDSMI_INIT_ALL_PROCESSORS = 4294967295
 AMDSMI_INIT_AMD_CPUS = 1
@@ -199,7 +204,12 @@ AMDSMI_INIT_AMD_GPUS = 2
 AMDSMI_INIT_NON_AMD_CPUS = 4
 AMDSMI_INIT_NON_AMD_GPUS = 8
 AMDSMI_INIT_AMD_APUS = 3
-amdsmi_init_flags_t = ctypes.c_uint32 # enum
+AMDSMI_INIT_LOCKLESS_READS = 9007199254740992
+AMDSMI_INIT_DISCOVERY_CACHE = 18014398509481984
+AMDSMI_INIT_LAZY = 36028797018963968
+AMDSMI_INIT_GPU_METRICS_CACHE = 72057594037927936
+AMDSMI_INIT_SYSFS_FD_CACHE = 144115188075855872
+amdsmi_init_flags_t = ctypes.c_uint64 # enum
 
 # values for enumeration 'amdsmi_mm_ip_t'
 amdsmi_mm_ip_t__enumvalues = {
@@ -717,6 +727,21 @@ struct_amdsmi_vram_usage_t._fields_ = [
 ]
 
 amdsmi_vram_usage_t = struct_amdsmi_vram_usage_t
+class struct_amdsmi_gpu_memory_usage_t(Structure):
+    pass
+
+struct_amdsmi_gpu_memory_usage_t._pack_ = 1 # source:False
+struct_amdsmi_gpu_memory_usage_t._fields_ = [
+    ('vram_total', ctypes.c_uint64),
+    ('vram_used', ctypes.c_uint64),
+    ('vis_vram_total', ctypes.c_uint64),
+    ('vis_vram_used', ctypes.c_uint64),
+    ('gtt_total', ctypes.c_uint64),
+    ('gtt_used', ctypes.c_uint64),
+    ('reserved', ctypes.c_uint64 * 2),
+]
+
+amdsmi_gpu_memory_usage_t = struct_amdsmi_gpu_memory_usage_t
 class struct_amdsmi_violation_status_t(Structure):
     pass
 
@@ -741,7 +766,8 @@ struct_amdsmi_violation_status_t._fields_ = [
     ('active_vr_thrm', ctypes.c_ubyte),
     ('active_hbm_thrm', ctypes.c_ubyte),
     ('PADDING_0', ctypes.c_ubyte * 3),
-    ('reserved', ctypes.c_uint64 * 30),
+    ('window_us', ctypes.c_uint64),
+    ('reserved', ctypes.c_uint64 * 29),
 ]
 
 amdsmi_violation_status_t = struct_amdsmi_violation_status_t
@@ -1734,6 +1760,95 @@ struct_amd_metrics_table_header_t._fields_ = [
 ]
 
 amd_metrics_table_header_t = struct_amd_metrics_table_header_t
+# values for enumeration 'amdsmi_field_id_t'
+amdsmi_field_id_t__enumvalues = {
+    0: 'AMDSMI_FIELD_TEMP_EDGE',
+    0: 'AMDSMI_FIELD_FIRST',
+    1: 'AMDSMI_FIELD_TEMP_HOTSPOT',
+    2: 'AMDSMI_FIELD_TEMP_VRAM',
+    3: 'AMDSMI_FIELD_FAN_SPEED',
+    4: 'AMDSMI_FIELD_FAN_RPMS',
+    5: 'AMDSMI_FIELD_SOCKET_POWER',
+    6: 'AMDSMI_FIELD_ENERGY_ACCUMULATOR',
+    7: 'AMDSMI_FIELD_GFX_ACTIVITY',
+    8: 'AMDSMI_FIELD_UMC_ACTIVITY',
+    9: 'AMDSMI_FIELD_MM_ACTIVITY',
+    10: 'AMDSMI_FIELD_GFX_CLK',
+    11: 'AMDSMI_FIELD_MEM_CLK',
+    12: 'AMDSMI_FIELD_SOC_CLK',
+    13: 'AMDSMI_FIELD_THROTTLE_STATUS',
+    14: 'AMDSMI_FIELD_PCIE_LINK_WIDTH',
+    15: 'AMDSMI_FIELD_PCIE_LINK_SPEED',
+    16: 'AMDSMI_FIELD_GFX_CLK_LEVEL',
+    17: 'AMDSMI_FIELD_MEM_CLK_LEVEL',
+    18: 'AMDSMI_FIELD_VRAM_TOTAL',
+    19: 'AMDSMI_FIELD_VRAM_USED',
+    20: 'AMDSMI_FIELD_VIS_VRAM_TOTAL',
+    21: 'AMDSMI_FIELD_VIS_VRAM_USED',
+    22: 'AMDSMI_FIELD_GTT_TOTAL',
+    23: 'AMDSMI_FIELD_GTT_USED',
+    24: 'AMDSMI_FIELD_POWER_CAP',
+    25: 'AMDSMI_FIELD__MAX',
+}
+AMDSMI_FIELD_TEMP_EDGE = 0
+AMDSMI_FIELD_FIRST = 0
+AMDSMI_FIELD_TEMP_HOTSPOT = 1
+AMDSMI_FIELD_TEMP_VRAM = 2
+AMDSMI_FIELD_FAN_SPEED = 3
+AMDSMI_FIELD_FAN_RPMS = 4
+AMDSMI_FIELD_SOCKET_POWER = 5
+AMDSMI_FIELD_ENERGY_ACCUMULATOR = 6
+AMDSMI_FIELD_GFX_ACTIVITY = 7
+AMDSMI_FIELD_UMC_ACTIVITY = 8
+AMDSMI_FIELD_MM_ACTIVITY = 9
+AMDSMI_FIELD_GFX_CLK = 10
+AMDSMI_FIELD_MEM_CLK = 11
+AMDSMI_FIELD_SOC_CLK = 12
+AMDSMI_FIELD_THROTTLE_STATUS = 13
+AMDSMI_FIELD_PCIE_LINK_WIDTH = 14
+AMDSMI_FIELD_PCIE_LINK_SPEED = 15
+AMDSMI_FIELD_GFX_CLK_LEVEL = 16
+AMDSMI_FIELD_MEM_CLK_LEVEL = 17
+AMDSMI_FIELD_VRAM_TOTAL = 18
+AMDSMI_FIELD_VRAM_USED = 19
+AMDSMI_FIELD_VIS_VRAM_TOTAL = 20
+AMDSMI_FIELD_VIS_VRAM_USED = 21
+AMDSMI_FIELD_GTT_TOTAL = 22
+AMDSMI_FIELD_GTT_USED = 23
+AMDSMI_FIELD_POWER_CAP = 24
+AMDSMI_FIELD__MAX = 25
+amdsmi_field_id_t = ctypes.c_uint32 # enum
+
+# values for enumeration 'amdsmi_field_type_t'
+amdsmi_field_type_t__enumvalues = {
+    0: 'AMDSMI_FIELD_TYPE_UINT64',
+    1: 'AMDSMI_FIELD_TYPE_INT64',
+}
+AMDSMI_FIELD_TYPE_UINT64 = 0
+AMDSMI_FIELD_TYPE_INT64 = 1
+amdsmi_field_type_t = ctypes.c_uint32 # enum
+class struct_amdsmi_field_value_t(Structure):
+    pass
+
+class union_amdsmi_field_value_t_value(Union):
+    pass
+
+union_amdsmi_field_value_t_value._pack_ = 1 # source:False
+union_amdsmi_field_value_t_value._fields_ = [
+    ('u64', ctypes.c_uint64),
+    ('i64', ctypes.c_int64),
+]
+
+struct_amdsmi_field_value_t._pack_ = 1 # source:False
+struct_amdsmi_field_value_t._fields_ = [
+    ('field_id', amdsmi_field_id_t),
+    ('status', amdsmi_status_t),
+    ('type', amdsmi_field_type_t),
+    ('reserved', ctypes.c_uint32),
+    ('value', union_amdsmi_field_value_t_value),
+]
+
+amdsmi_field_value_t = struct_amdsmi_field_value_t
 class struct_amdsmi_gpu_xcp_metrics_t(Structure):
     pass
 
@@ -1873,6 +1988,16 @@ struct_amdsmi_error_count_t._fields_ = [
 ]
 
 amdsmi_error_count_t = struct_amdsmi_error_count_t
+class struct_amdsmi_gpu_block_error_count_t(Structure):
+    pass
+
+struct_amdsmi_gpu_block_error_count_t._pack_ = 1 # source:False
+struct_amdsmi_gpu_block_error_count_t._fields_ = [
+    ('block', amdsmi_gpu_block_t),
+    ('ec', amdsmi_error_count_t),
+]
+
+amdsmi_gpu_block_error_count_t = struct_amdsmi_gpu_block_error_count_t
 class struct_amdsmi_process_info_t(Structure):
     pass
 
@@ -2060,6 +2185,36 @@ struct_amdsmi_hsmp_metrics_table_t._fields_ = [
 ]
 
 amdsmi_hsmp_metrics_table_t = struct_amdsmi_hsmp_metrics_table_t
+class struct_amdsmi_cpu_socket_telemetry_t(Structure):
+    pass
+
+struct_amdsmi_cpu_socket_telemetry_t._pack_ = 1 # source:False
+struct_amdsmi_cpu_socket_telemetry_t._fields_ = [
+    ('socket_index', ctypes.c_uint32),
+    ('power', ctypes.c_uint32),
+    ('power_cap', ctypes.c_uint32),
+    ('PADDING_0', ctypes.c_ubyte * 4),
+    ('energy', ctypes.c_uint64),
+    ('freq_limit', ctypes.c_uint16),
+    ('fmax', ctypes.c_uint16),
+    ('fmin', ctypes.c_uint16),
+    ('reserved', ctypes.c_uint16),
+]
+
+amdsmi_cpu_socket_telemetry_t = struct_amdsmi_cpu_socket_telemetry_t
+class struct_amdsmi_cpu_core_telemetry_t(Structure):
+    pass
+
+struct_amdsmi_cpu_core_telemetry_t._pack_ = 1 # source:False
+struct_amdsmi_cpu_core_telemetry_t._fields_ = [
+    ('core_index', ctypes.c_uint32),
+    ('socket_index', ctypes.c_uint32),
+    ('energy', ctypes.c_uint64),
+    ('boostlimit', ctypes.c_uint32),
+    ('freq_limit', ctypes.c_uint32),
+]
+
+amdsmi_cpu_core_telemetry_t = struct_amdsmi_cpu_core_telemetry_t
 amdsmi_hsmp_freqlimit_src_names = ['cHTC-Active', 'PROCHOT', 'TDC limit', 'PPT Limit', 'OPN Max', 'Reliability Limit', 'APML Agent', 'HSMP Agent'] # Variable ctypes.POINTER(ctypes.c_char) * 8
 uint64_t = ctypes.c_uint64
 amdsmi_init = _libraries['libamd_smi.so'].amdsmi_init
@@ -2217,12 +2372,30 @@ amdsmi_get_gpu_metrics_header_info.argtypes = [amdsmi_processor_handle, ctypes.P
 amdsmi_get_gpu_metrics_info = _libraries['libamd_smi.so'].amdsmi_get_gpu_metrics_info
 amdsmi_get_gpu_metrics_info.restype = amdsmi_status_t
 amdsmi_get_gpu_metrics_info.argtypes = [amdsmi_processor_handle, ctypes.POINTER(struct_amdsmi_gpu_metrics_t)]
+amdsmi_get_gpu_fields = _libraries['libamd_smi.so'].amdsmi_get_gpu_fields
+amdsmi_get_gpu_fields.restype = amdsmi_status_t
+amdsmi_get_gpu_fields.argtypes = [amdsmi_processor_handle, ctypes.POINTER(struct_amdsmi_field_value_t), uint32_t]
+amdsmi_get_supported_fields = _libraries['libamd_smi.so'].amdsmi_get_supported_fields
+amdsmi_get_supported_fields.restype = amdsmi_status_t
+amdsmi_get_supported_fields.argtypes = [amdsmi_processor_handle, ctypes.POINTER(ctypes.c_uint64)]
 amdsmi_get_gpu_pm_metrics_info = _libraries['libamd_smi.so'].amdsmi_get_gpu_pm_metrics_info
 amdsmi_get_gpu_pm_metrics_info.restype = amdsmi_status_t
 amdsmi_get_gpu_pm_metrics_info.argtypes = [amdsmi_processor_handle, ctypes.POINTER(ctypes.POINTER(struct_amdsmi_name_value_t)), ctypes.POINTER(ctypes.c_uint32)]
 amdsmi_get_gpu_reg_table_info = _libraries['libamd_smi.so'].amdsmi_get_gpu_reg_table_info
 amdsmi_get_gpu_reg_table_info.restype = amdsmi_status_t
 amdsmi_get_gpu_reg_table_info.argtypes = [amdsmi_processor_handle, amdsmi_reg_type_t, ctypes.POINTER(ctypes.POINTER(struct_amdsmi_name_value_t)), ctypes.POINTER(ctypes.c_uint32)]
+amdsmi_get_gpu_pm_metrics_values = _libraries['libamd_smi.so'].amdsmi_get_gpu_pm_metrics_values
+amdsmi_get_gpu_pm_metrics_values.restype = amdsmi_status_t
+amdsmi_get_gpu_pm_metrics_values.argtypes = [amdsmi_processor_handle, ctypes.POINTER(struct_amdsmi_name_value_t), ctypes.POINTER(ctypes.c_uint32)]
+amdsmi_get_gpu_pm_metrics_changes = _libraries['libamd_smi.so'].amdsmi_get_gpu_pm_metrics_changes
+amdsmi_get_gpu_pm_metrics_changes.restype = amdsmi_status_t
+amdsmi_get_gpu_pm_metrics_changes.argtypes = [amdsmi_processor_handle, ctypes.POINTER(struct_amdsmi_name_value_t), ctypes.POINTER(ctypes.c_uint32)]
+amdsmi_get_gpu_reg_table_values = _libraries['libamd_smi.so'].amdsmi_get_gpu_reg_table_values
+amdsmi_get_gpu_reg_table_values.restype = amdsmi_status_t
+amdsmi_get_gpu_reg_table_values.argtypes = [amdsmi_processor_handle, amdsmi_reg_type_t, ctypes.POINTER(struct_amdsmi_name_value_t), ctypes.POINTER(ctypes.c_uint32)]
+amdsmi_get_gpu_reg_table_changes = _libraries['libamd_smi.so'].amdsmi_get_gpu_reg_table_changes
+amdsmi_get_gpu_reg_table_changes.restype = amdsmi_status_t
+amdsmi_get_gpu_reg_table_changes.argtypes = [amdsmi_processor_handle, amdsmi_reg_type_t, ctypes.POINTER(struct_amdsmi_name_value_t), ctypes.POINTER(ctypes.c_uint32)]
 amdsmi_set_gpu_clk_range = _libraries['libamd_smi.so'].amdsmi_set_gpu_clk_range
 amdsmi_set_gpu_clk_range.restype = amdsmi_status_t
 amdsmi_set_gpu_clk_range.argtypes = [amdsmi_processor_handle, uint64_t, uint64_t, amdsmi_clk_type_t]
@@ -2283,6 +2456,9 @@ amdsmi_get_gpu_ecc_count.argtypes = [amdsmi_processor_handle, amdsmi_gpu_block_t
 amdsmi_get_gpu_ecc_enabled = _libraries['libamd_smi.so'].amdsmi_get_gpu_ecc_enabled
 amdsmi_get_gpu_ecc_enabled.restype = amdsmi_status_t
 amdsmi_get_gpu_ecc_enabled.argtypes = [amdsmi_processor_handle, ctypes.POINTER(ctypes.c_uint64)]
+amdsmi_get_gpu_ecc_count_all = _libraries['libamd_smi.so'].amdsmi_get_gpu_ecc_count_all
+amdsmi_get_gpu_ecc_count_all.restype = amdsmi_status_t
+amdsmi_get_gpu_ecc_count_all.argtypes = [amdsmi_processor_handle, ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(struct_amdsmi_gpu_block_error_count_t)]
 amdsmi_get_gpu_ecc_status = _libraries['libamd_smi.so'].amdsmi_get_gpu_ecc_status
 amdsmi_get_gpu_ecc_status.restype = amdsmi_status_t
 amdsmi_get_gpu_ecc_status.argtypes = [amdsmi_processor_handle, amdsmi_gpu_block_t, ctypes.POINTER(amdsmi_ras_err_state_t)]
@@ -2367,6 +2543,9 @@ amdsmi_set_gpu_event_notification_mask.argtypes = [amdsmi_processor_handle, uint
 amdsmi_get_gpu_event_notification = _libraries['libamd_smi.so'].amdsmi_get_gpu_event_notification
 amdsmi_get_gpu_event_notification.restype = amdsmi_status_t
 amdsmi_get_gpu_event_notification.argtypes = [ctypes.c_int32, ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(struct_amdsmi_evt_notification_data_t)]
+amdsmi_get_gpu_event_notification_fd = _libraries['libamd_smi.so'].amdsmi_get_gpu_event_notification_fd
+amdsmi_get_gpu_event_notification_fd.restype = amdsmi_status_t
+amdsmi_get_gpu_event_notification_fd.argtypes = [ctypes.POINTER(ctypes.c_int32)]
 amdsmi_stop_gpu_event_notification = _libraries['libamd_smi.so'].amdsmi_stop_gpu_event_notification
 amdsmi_stop_gpu_event_notification.restype = amdsmi_status_t
 amdsmi_stop_gpu_event_notification.argtypes = [amdsmi_processor_handle]
@@ -2421,6 +2600,9 @@ amdsmi_get_clock_info.argtypes = [amdsmi_processor_handle, amdsmi_clk_type_t, ct
 amdsmi_get_gpu_vram_usage = _libraries['libamd_smi.so'].amdsmi_get_gpu_vram_usage
 amdsmi_get_gpu_vram_usage.restype = amdsmi_status_t
 amdsmi_get_gpu_vram_usage.argtypes = [amdsmi_processor_handle, ctypes.POINTER(struct_amdsmi_vram_usage_t)]
+amdsmi_get_gpu_memory_usage_info = _libraries['libamd_smi.so'].amdsmi_get_gpu_memory_usage_info
+amdsmi_get_gpu_memory_usage_info.restype = amdsmi_status_t
+amdsmi_get_gpu_memory_usage_info.argtypes = [amdsmi_processor_handle, ctypes.POINTER(struct_amdsmi_gpu_memory_usage_t)]
 amdsmi_get_violation_status = _libraries['libamd_smi.so'].amdsmi_get_violation_status
 amdsmi_get_violation_status.restype = amdsmi_status_t
 amdsmi_get_violation_status.argtypes = [amdsmi_processor_handle, ctypes.POINTER(struct_amdsmi_violation_status_t)]
@@ -2548,6 +2730,9 @@ amdsmi_get_hsmp_metrics_table_version.argtypes = [amdsmi_processor_handle, ctype
 amdsmi_get_hsmp_metrics_table = _libraries['libamd_smi.so'].amdsmi_get_hsmp_metrics_table
 amdsmi_get_hsmp_metrics_table.restype = amdsmi_status_t
 amdsmi_get_hsmp_metrics_table.argtypes = [amdsmi_processor_handle, ctypes.POINTER(struct_amdsmi_hsmp_metrics_table_t)]
+amdsmi_get_cpu_telemetry = _libraries['libamd_smi.so'].amdsmi_get_cpu_telemetry
+amdsmi_get_cpu_telemetry.restype = amdsmi_status_t
+amdsmi_get_cpu_telemetry.argtypes = [ctypes.POINTER(struct_amdsmi_cpu_socket_telemetry_t), ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(struct_amdsmi_cpu_core_telemetry_t), ctypes.POINTER(ctypes.c_uint32)]
 amdsmi_first_online_core_on_cpu_socket = _libraries['libamd_smi.so'].amdsmi_first_online_core_on_cpu_socket
 amdsmi_first_online_core_on_cpu_socket.restype = amdsmi_status_t
 amdsmi_first_online_core_on_cpu_socket.argtypes = [amdsmi_processor_handle, ctypes.POINTER(ctypes.c_uint32)]
@@ -2615,6 +2800,21 @@ __all__ = \
     'AMDSMI_EVT_NOTIF_NONE', 'AMDSMI_EVT_NOTIF_RING_HANG',
     'AMDSMI_EVT_NOTIF_THERMAL_THROTTLE', 'AMDSMI_EVT_NOTIF_VMFAULT',
     'AMDSMI_FINE_DECODER_ACTIVITY', 'AMDSMI_FINE_GRAIN_GFX_ACTIVITY',
+    'AMDSMI_FIELD_ENERGY_ACCUMULATOR', 'AMDSMI_FIELD_FAN_RPMS',
+    'AMDSMI_FIELD_FAN_SPEED', 'AMDSMI_FIELD_FIRST',
+    'AMDSMI_FIELD_GFX_ACTIVITY', 'AMDSMI_FIELD_GFX_CLK',
+    'AMDSMI_FIELD_GFX_CLK_LEVEL', 'AMDSMI_FIELD_GTT_TOTAL',
+    'AMDSMI_FIELD_GTT_USED', 'AMDSMI_FIELD_MEM_CLK',
+    'AMDSMI_FIELD_MEM_CLK_LEVEL', 'AMDSMI_FIELD_MM_ACTIVITY',
+    'AMDSMI_FIELD_PCIE_LINK_SPEED', 'AMDSMI_FIELD_PCIE_LINK_WIDTH',
+    'AMDSMI_FIELD_POWER_CAP', 'AMDSMI_FIELD_SOCKET_POWER',
+    'AMDSMI_FIELD_SOC_CLK', 'AMDSMI_FIELD_TEMP_EDGE',
+    'AMDSMI_FIELD_TEMP_HOTSPOT', 'AMDSMI_FIELD_TEMP_VRAM',
+    'AMDSMI_FIELD_THROTTLE_STATUS', 'AMDSMI_FIELD_TYPE_INT64',
+    'AMDSMI_FIELD_TYPE_UINT64', 'AMDSMI_FIELD_UMC_ACTIVITY',
+    'AMDSMI_FIELD_VIS_VRAM_TOTAL', 'AMDSMI_FIELD_VIS_VRAM_USED',
+    'AMDSMI_FIELD_VRAM_TOTAL', 'AMDSMI_FIELD_VRAM_USED',
+    'AMDSMI_FIELD__MAX',
     'AMDSMI_FINE_GRAIN_MEM_ACTIVITY', 'AMDSMI_FREQ_IND_INVALID',
     'AMDSMI_FREQ_IND_MAX', 'AMDSMI_FREQ_IND_MIN', 'AMDSMI_FW_ID_ASD',
     'AMDSMI_FW_ID_CP_CE', 'AMDSMI_FW_ID_CP_ME',
@@ -2668,7 +2868,9 @@ __all__ = \
     'AMDSMI_GPU_BLOCK_UMC', 'AMDSMI_GPU_BLOCK_VCN',
     'AMDSMI_GPU_BLOCK_XGMI_WAFL', 'AMDSMI_INIT_ALL_PROCESSORS',
     'AMDSMI_INIT_AMD_APUS', 'AMDSMI_INIT_AMD_CPUS',
-    'AMDSMI_INIT_AMD_GPUS', 'AMDSMI_INIT_NON_AMD_CPUS',
+    'AMDSMI_INIT_AMD_GPUS', 'AMDSMI_INIT_DISCOVERY_CACHE',
+    'AMDSMI_INIT_GPU_METRICS_CACHE', 'AMDSMI_INIT_LAZY',
+    'AMDSMI_INIT_LOCKLESS_READS', 'AMDSMI_INIT_NON_AMD_CPUS',
     'AMDSMI_INIT_NON_AMD_GPUS', 'AMDSMI_INVALID_POWER',
     'AMDSMI_IOLINK_TYPE_NUMIOLINKTYPES',
     'AMDSMI_IOLINK_TYPE_PCIEXPRESS', 'AMDSMI_IOLINK_TYPE_SIZE',
@@ -2779,15 +2981,19 @@ __all__ = \
     'amdsmi_compute_partition_type_t', 'amdsmi_container_types_t',
     'amdsmi_counter_command_t', 'amdsmi_counter_value_t',
     'amdsmi_cpu_apb_disable', 'amdsmi_cpu_apb_enable',
+    'amdsmi_cpu_core_telemetry_t', 'amdsmi_cpu_socket_telemetry_t',
     'amdsmi_cpusocket_handle', 'amdsmi_ddr_bw_metrics_t',
     'amdsmi_dev_perf_level_t', 'amdsmi_dimm_power_t',
     'amdsmi_dimm_thermal_t', 'amdsmi_dpm_level_t',
     'amdsmi_dpm_policy_entry_t', 'amdsmi_dpm_policy_t',
     'amdsmi_driver_info_t', 'amdsmi_engine_usage_t',
     'amdsmi_error_count_t', 'amdsmi_event_group_t',
+    'amdsmi_gpu_block_error_count_t',
     'amdsmi_event_handle_t', 'amdsmi_event_type_t',
     'amdsmi_evt_notification_data_t',
     'amdsmi_evt_notification_type_t',
+    'amdsmi_field_id_t', 'amdsmi_field_type_t',
+    'amdsmi_field_value_t',
     'amdsmi_first_online_core_on_cpu_socket',
     'amdsmi_free_name_value_pairs', 'amdsmi_freq_ind_t',
     'amdsmi_freq_volt_region_t', 'amdsmi_frequencies_t',
@@ -2814,7 +3020,8 @@ __all__ = \
     'amdsmi_get_cpu_socket_lclk_dpm_level',
     'amdsmi_get_cpu_socket_power', 'amdsmi_get_cpu_socket_power_cap',
     'amdsmi_get_cpu_socket_power_cap_max',
-    'amdsmi_get_cpu_socket_temperature', 'amdsmi_get_cpucore_handles',
+    'amdsmi_get_cpu_socket_temperature', 'amdsmi_get_cpu_telemetry',
+    'amdsmi_get_cpucore_handles',
     'amdsmi_get_energy_count', 'amdsmi_get_esmi_err_msg',
     'amdsmi_get_fw_info',
     'amdsmi_get_gpu_accelerator_partition_profile',
@@ -2828,14 +3035,18 @@ __all__ = \
     'amdsmi_get_gpu_compute_process_info_by_pid',
     'amdsmi_get_gpu_device_bdf', 'amdsmi_get_gpu_device_uuid',
     'amdsmi_get_gpu_driver_info', 'amdsmi_get_gpu_ecc_count',
+    'amdsmi_get_gpu_ecc_count_all',
     'amdsmi_get_gpu_ecc_enabled', 'amdsmi_get_gpu_ecc_status',
-    'amdsmi_get_gpu_event_notification', 'amdsmi_get_gpu_fan_rpms',
+    'amdsmi_get_gpu_event_notification',
+    'amdsmi_get_gpu_event_notification_fd', 'amdsmi_get_gpu_fan_rpms',
+    'amdsmi_get_gpu_fields', 'amdsmi_get_supported_fields',
     'amdsmi_get_gpu_fan_speed', 'amdsmi_get_gpu_fan_speed_max',
     'amdsmi_get_gpu_id', 'amdsmi_get_gpu_kfd_info',
     'amdsmi_get_gpu_mem_overdrive_level',
     'amdsmi_get_gpu_memory_partition',
     'amdsmi_get_gpu_memory_reserved_pages',
     'amdsmi_get_gpu_memory_total', 'amdsmi_get_gpu_memory_usage',
+    'amdsmi_get_gpu_memory_usage_info',
     'amdsmi_get_gpu_metrics_header_info',
     'amdsmi_get_gpu_metrics_info',
     'amdsmi_get_gpu_od_volt_curve_regions',
@@ -2843,12 +3054,16 @@ __all__ = \
     'amdsmi_get_gpu_pci_bandwidth',
     'amdsmi_get_gpu_pci_replay_counter',
     'amdsmi_get_gpu_pci_throughput', 'amdsmi_get_gpu_perf_level',
+    'amdsmi_get_gpu_pm_metrics_changes',
     'amdsmi_get_gpu_pm_metrics_info',
+    'amdsmi_get_gpu_pm_metrics_values',
     'amdsmi_get_gpu_power_profile_presets',
     'amdsmi_get_gpu_process_isolation', 'amdsmi_get_gpu_process_list',
     'amdsmi_get_gpu_ras_block_features_enabled',
     'amdsmi_get_gpu_ras_feature_info',
-    'amdsmi_get_gpu_reg_table_info', 'amdsmi_get_gpu_revision',
+    'amdsmi_get_gpu_reg_table_changes',
+    'amdsmi_get_gpu_reg_table_info',
+    'amdsmi_get_gpu_reg_table_values', 'amdsmi_get_gpu_revision',
     'amdsmi_get_gpu_subsystem_id', 'amdsmi_get_gpu_subsystem_name',
     'amdsmi_get_gpu_topo_numa_affinity',
     'amdsmi_get_gpu_total_ecc_count', 'amdsmi_get_gpu_vbios_info',
@@ -2872,7 +3087,8 @@ __all__ = \
     'amdsmi_get_xgmi_plpd', 'amdsmi_gpu_block_t',
     'amdsmi_gpu_cache_info_t', 'amdsmi_gpu_control_counter',
     'amdsmi_gpu_counter_group_supported', 'amdsmi_gpu_create_counter',
-    'amdsmi_gpu_destroy_counter', 'amdsmi_gpu_metrics_t',
+    'amdsmi_gpu_destroy_counter', 'amdsmi_gpu_memory_usage_t',
+    'amdsmi_gpu_metrics_t',
     'amdsmi_gpu_read_counter', 'amdsmi_gpu_xgmi_error_status',
     'amdsmi_hsmp_freqlimit_src_names', 'amdsmi_hsmp_metrics_table_t',
     'amdsmi_init', 'amdsmi_init_flags_t',
@@ -2931,15 +3147,20 @@ __all__ = \
     'struct_amdsmi_accelerator_partition_profile_t',
     'struct_amdsmi_asic_info_t', 'struct_amdsmi_board_info_t',
     'struct_amdsmi_clk_info_t', 'struct_amdsmi_counter_value_t',
+    'struct_amdsmi_cpu_core_telemetry_t',
+    'struct_amdsmi_cpu_socket_telemetry_t',
     'struct_amdsmi_ddr_bw_metrics_t', 'struct_amdsmi_dimm_power_t',
     'struct_amdsmi_dimm_thermal_t', 'struct_amdsmi_dpm_level_t',
     'struct_amdsmi_dpm_policy_entry_t', 'struct_amdsmi_dpm_policy_t',
     'struct_amdsmi_driver_info_t', 'struct_amdsmi_engine_usage_t',
     'struct_amdsmi_error_count_t',
+    'struct_amdsmi_gpu_block_error_count_t',
     'struct_amdsmi_evt_notification_data_t',
+    'struct_amdsmi_field_value_t',
     'struct_amdsmi_freq_volt_region_t', 'struct_amdsmi_frequencies_t',
     'struct_amdsmi_frequency_range_t', 'struct_amdsmi_fw_info_t',
-    'struct_amdsmi_gpu_cache_info_t', 'struct_amdsmi_gpu_metrics_t',
+    'struct_amdsmi_gpu_cache_info_t',
+    'struct_amdsmi_gpu_memory_usage_t', 'struct_amdsmi_gpu_metrics_t',
     'struct_amdsmi_gpu_xcp_metrics_t',
     'struct_amdsmi_hsmp_metrics_table_t', 'struct_amdsmi_kfd_info_t',
     'struct_amdsmi_link_id_bw_type_t', 'struct_amdsmi_link_metrics_t',
@@ -2964,5 +3185,6 @@ __all__ = \
     'struct_memory_usage_', 'struct_nps_flags_',
     'struct_pcie_metric_', 'struct_pcie_static_',
     'struct_amdsmi_bdf_t', 'uint32_t', 'uint64_t', 'uint8_t',
-    'union_amdsmi_bdf_t', 'union_amdsmi_nps_caps_t']
+    'union_amdsmi_bdf_t', 'union_amdsmi_field_value_t_value',
+    'union_amdsmi_nps_caps_t']
 
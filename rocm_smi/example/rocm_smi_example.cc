@@ -49,6 +49,7 @@
 
 #include <algorithm>
 #include <bitset>
+#include <chrono>
 #include <iostream>
 #include <map>
 #include <vector>
@@ -1038,10 +1039,31 @@ int main() {
         xcp++;
     }
 
+    std::cout << "\n";
+    std::cout << "\t ** -> Per call cost of rsmi_dev_gpu_metrics_info_get() ** " << "\n";
+    constexpr uint32_t kMAX_ITER_BENCH = 1000;
+    rsmi_gpu_metrics_t gpu_metrics_check;
+    auto time_calls_in_usecs = [&](bool with_metrics_dump) {
+      const auto start_time = std::chrono::steady_clock::now();
+      for (auto idx = uint32_t(0); idx < kMAX_ITER_BENCH; ++idx) {
+        rsmi_dev_gpu_metrics_info_get(i, &gpu_metrics_check);
+        if (with_metrics_dump) {
+          rsmi_dev_metrics_log_get(i);
+        }
+      }
+      const auto elapsed_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now() - start_time);
+      return (static_cast<double>(elapsed_time.count()) / kMAX_ITER_BENCH / 1000.0);
+    };
+    // The full table dump is what every call used to pay for
+    std::cout << "\t\t -> with full metrics dump (previous path): "
+              << time_calls_in_usecs(true) << " us/call\n";
+    std::cout << "\t\t -> direct conversion: "
+              << time_calls_in_usecs(false) << " us/call\n";
+
     std::cout << "\n";
     std::cout << "\t ** -> Checking metrics with constant changes ** " << "\n";
     constexpr uint16_t kMAX_ITER_TEST = 10;
-    rsmi_gpu_metrics_t gpu_metrics_check;
     for (auto idx = uint16_t(1); idx <= kMAX_ITER_TEST; ++idx) {
         rsmi_dev_gpu_metrics_info_get(i, &gpu_metrics_check);
         std::cout << "\t\t -> firmware_timestamp [" << idx
@@ -149,6 +149,40 @@ typedef enum {
                                          //!< information can be retrieved. By
                                          //!< default, only AMD devices are
                                          //!<  enumerated by RSMI.
+  RSMI_INIT_FLAG_LOCKLESS_READS = 0x20000000000000,  //!< Getters that only
+                                         //!< read sysfs files don't take
+                                         //!< the device lock, so they never
+                                         //!< wait on other processes; they
+                                         //!< may fail while a setter, reset
+                                         //!< or partition change is running.
+                                         //!< Can also be enabled with the
+                                         //!< RSMI_LOCKLESS_READS env. var.
+  RSMI_INIT_FLAG_DISCOVERY_CACHE = 0x40000000000000,  //!< Reuse the hwmon
+                                         //!< paths, sensor label maps, event
+                                         //!< groups and supported functions
+                                         //!< found by an earlier process in
+                                         //!< the same boot, from
+                                         //!< /run/amdsmi/discovery.cache.
+                                         //!< Can also be enabled with the
+                                         //!< RSMI_DISCOVERY_CACHE env. var.
+                                         //!< in debug and test builds.
+  RSMI_INIT_FLAG_LAZY = 0x80000000000000,  //!< Only enumerate the devices
+                                         //!< in rsmi_init(); monitors, io
+                                         //!< links, boot partition states and
+                                         //!< event groups of a device are
+                                         //!< discovered on first use. Can also
+                                         //!< be enabled with the
+                                         //!< RSMI_LAZY_INIT env. var.
+  RSMI_INIT_FLAG_GPU_METRICS_CACHE = 0x100000000000000,  //!< Let gpu_metrics
+                                         //!< derived queries share one
+                                         //!< snapshot of the metrics table for
+                                         //!< up to 1 ms. See
+                                         //!< ::rsmi_dev_gpu_metrics_cache_ttl_set
+  RSMI_INIT_FLAG_SYSFS_FD_CACHE = 0x200000000000000,  //!< Keep read-only
+                                         //!< sysfs attribute files open and
+                                         //!< re-read them with pread().
+                                         //!< Can also be enabled with the
+                                         //!< RSMI_SYSFS_FD_CACHE env. var.
   RSMI_INIT_FLAG_THRAD_ONLY_MUTEX = 0x400000000000000,   //!< The mutex limit to thread
   RSMI_INIT_FLAG_RESRV_TEST1 = 0x800000000000000,  //!< Reserved for test
 } rsmi_init_flags_t;
@@ -253,6 +287,12 @@ typedef enum {
  */
 typedef uintptr_t rsmi_event_handle_t;
 
+/**
+ * @brief Handle to a group of performance event counters that are read
+ * together
+ */
+typedef uintptr_t rsmi_event_group_handle_t;
+
 /**
  * Event Groups
  *
@@ -386,6 +426,14 @@ typedef struct {
     char message[MAX_EVENT_NOTIFICATION_MSG_SIZE];  //!< Event message
 } rsmi_evt_notification_data_t;
 
+/**
+ * Function called for each event notification once it is set with
+ * ::rsmi_event_notification_callback_set(). @p data is only valid during
+ * the call.
+ */
+typedef void (*rsmi_evt_notification_callback_t)(
+                    const rsmi_evt_notification_data_t *data, void *user_data);
+
 /**
  * Clock types
  */
@@ -908,6 +956,18 @@ typedef struct {
   uint16_t average_mm_activity;   //!< UVD or VCN
 } rsmi_activity_metric_counter_t;
 
+/**
+ * @brief This structure holds the counters of the per-device sysfs file
+ * descriptor cache (see ::RSMI_INIT_FLAG_SYSFS_FD_CACHE).
+ */
+typedef struct {
+  uint64_t hits;           //!< Reads served from an already open descriptor
+  uint64_t misses;         //!< Reads that had to open the attribute file
+  uint64_t invalidations;  //!< Number of times the cache was flushed
+  uint32_t open_fds;       //!< Descriptors currently held open
+  uint32_t enabled;        //!< Non-zero if the cache is enabled
+} rsmi_sysfs_fd_cache_stats_t;
+
 /**
  * @brief This structure holds version information.
  */
@@ -1343,6 +1403,15 @@ typedef struct {
   uint64_t reserved[5];
 } rsmi_error_count_t;
 
+/**
+ * @brief The error counts of one GPU block, as returned by
+ * rsmi_dev_ecc_count_all_get()
+ */
+typedef struct {
+  rsmi_gpu_block_t block;  //!< The block the counts are for
+  rsmi_error_count_t ec;   //!< The block's error counts
+} rsmi_gpu_block_error_count_t;
+
 /**
  * @brief This structure holds ras feature
  */
@@ -1402,6 +1471,21 @@ typedef union id {
         };
 } rsmi_func_id_value_t;
 
+//! Max. number of function ids in an ::rsmi_supported_func_bitmap_t
+#define RSMI_MAX_SUPPORTED_FUNCS 256
+
+/**
+ * @brief Bitmap of the supported functions of a device. Bit i of
+ * bitmap[i / 64] is set if the function with id i is supported; see
+ * ::rsmi_supported_func_name_get for the name of an id. Ids are stable
+ * across library versions; new functions get new ids.
+ */
+typedef struct {
+  uint32_t num_funcs;  //!< Number of function ids currently defined
+  uint32_t reserved;
+  uint64_t bitmap[RSMI_MAX_SUPPORTED_FUNCS / 64];  //!< Supported ids
+} rsmi_supported_func_bitmap_t;
+
 
 /*****************************************************************************/
 /** @defgroup InitShutAdmin Initialization and Shutdown
@@ -3167,6 +3251,138 @@ rsmi_status_t rsmi_dev_reg_table_info_get(uint32_t dv_ind,
                       rsmi_name_value_t** reg_metrics,
                       uint32_t *num_of_metrics);
 
+/**
+ *  @brief Get the pm metrics table into a caller-provided array
+ *
+ *  @details Given a device index @p dv_ind, this function writes the pm
+ *  metrics name value pairs to @p pm_metrics, as ::rsmi_dev_pm_metrics_info_get()
+ *  does, without allocating memory. The layout of the table is worked out
+ *  once per device and pm metrics version, so repeated calls only read the
+ *  table and copy the values.
+ *
+ *  If @p pm_metrics is nullptr, the number of metrics of the table is
+ *  written to @p num_of_metrics. Otherwise @p num_of_metrics holds the number
+ *  of entries in @p pm_metrics on input, and the number of entries written on
+ *  output.
+ *
+ *  @param[in] dv_ind a device index
+ *
+ *  @param[inout] pm_metrics an array to which the metrics are written, or
+ *  nullptr to only query their number
+ *
+ *  @param[inout] num_of_metrics the size of @p pm_metrics on input, the
+ *  number of metrics on output
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_NOT_SUPPORTED installed software or hardware does not
+ *  support this function with the given arguments
+ *  @retval ::RSMI_STATUS_INSUFFICIENT_SIZE @p pm_metrics is smaller than the
+ *  number of metrics, which is written to @p num_of_metrics
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ */
+rsmi_status_t rsmi_dev_pm_metrics_values_get(uint32_t dv_ind,
+                      rsmi_name_value_t *pm_metrics,
+                      uint32_t *num_of_metrics);
+
+/**
+ *  @brief Get the pm metrics that changed since the previous call
+ *
+ *  @details As ::rsmi_dev_pm_metrics_values_get(), but only the metrics whose
+ *  value differs from that of the previous call of this function for the
+ *  device, in this process, are written. The first call, and the first one
+ *  after the layout of the table changed, write all of them. @p pm_metrics
+ *  must still have room for every metric of the table.
+ *
+ *  @param[in] dv_ind a device index
+ *
+ *  @param[inout] pm_metrics an array to which the changed metrics are
+ *  written, or nullptr to only query the number of metrics of the table
+ *
+ *  @param[inout] num_of_metrics the size of @p pm_metrics on input, the
+ *  number of changed metrics on output
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_NOT_SUPPORTED installed software or hardware does not
+ *  support this function with the given arguments
+ *  @retval ::RSMI_STATUS_INSUFFICIENT_SIZE @p pm_metrics is smaller than the
+ *  number of metrics, which is written to @p num_of_metrics
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ */
+rsmi_status_t rsmi_dev_pm_metrics_changes_get(uint32_t dv_ind,
+                      rsmi_name_value_t *pm_metrics,
+                      uint32_t *num_of_metrics);
+
+/**
+ *  @brief Get a register table into a caller-provided array
+ *
+ *  @details Given a device index @p dv_ind and a register type @p reg_type,
+ *  this function writes the register name value pairs to @p reg_metrics, as
+ *  ::rsmi_dev_reg_table_info_get() does, without allocating memory. The
+ *  layout of the table is worked out once per device and number of
+ *  instances and registers, so repeated calls only read the table and copy
+ *  the values.
+ *
+ *  If @p reg_metrics is nullptr, the number of registers of the table is
+ *  written to @p num_of_metrics. Otherwise @p num_of_metrics holds the number
+ *  of entries in @p reg_metrics on input, and the number of entries written
+ *  on output.
+ *
+ *  @param[in] dv_ind a device index
+ *
+ *  @param[in] reg_type The register type
+ *
+ *  @param[inout] reg_metrics an array to which the registers are written, or
+ *  nullptr to only query their number
+ *
+ *  @param[inout] num_of_metrics the size of @p reg_metrics on input, the
+ *  number of registers on output
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_NOT_SUPPORTED installed software or hardware does not
+ *  support this function with the given arguments
+ *  @retval ::RSMI_STATUS_INSUFFICIENT_SIZE @p reg_metrics is smaller than the
+ *  number of registers, which is written to @p num_of_metrics
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ */
+rsmi_status_t rsmi_dev_reg_table_values_get(uint32_t dv_ind,
+                      rsmi_reg_type_t reg_type,
+                      rsmi_name_value_t *reg_metrics,
+                      uint32_t *num_of_metrics);
+
+/**
+ *  @brief Get the registers of a register table that changed since the
+ *  previous call
+ *
+ *  @details As ::rsmi_dev_reg_table_values_get(), but only the registers
+ *  whose value differs from that of the previous call of this function for
+ *  the device and @p reg_type, in this process, are written. The first call,
+ *  and the first one after the layout of the table changed, write all of
+ *  them. @p reg_metrics must still have room for every register of the
+ *  table. This suits polling the XGMI, WAFL and PCIe counters at a high
+ *  rate.
+ *
+ *  @param[in] dv_ind a device index
+ *
+ *  @param[in] reg_type The register type
+ *
+ *  @param[inout] reg_metrics an array to which the changed registers are
+ *  written, or nullptr to only query the number of registers of the table
+ *
+ *  @param[inout] num_of_metrics the size of @p reg_metrics on input, the
+ *  number of changed registers on output
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_NOT_SUPPORTED installed software or hardware does not
+ *  support this function with the given arguments
+ *  @retval ::RSMI_STATUS_INSUFFICIENT_SIZE @p reg_metrics is smaller than the
+ *  number of registers, which is written to @p num_of_metrics
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ */
+rsmi_status_t rsmi_dev_reg_table_changes_get(uint32_t dv_ind,
+                      rsmi_reg_type_t reg_type,
+                      rsmi_name_value_t *reg_metrics,
+                      uint32_t *num_of_metrics);
+
 
 /**
  *  @brief This function sets the clock range information
@@ -3851,6 +4067,37 @@ rsmi_status_t rsmi_dev_ecc_count_get(uint32_t dv_ind,
 rsmi_status_t rsmi_dev_ecc_enabled_get(uint32_t dv_ind,
                                                     uint64_t *enabled_blocks);
 
+/**
+ *  @brief Retrieve the error counts of all the ECC enabled GPU blocks
+ *
+ *  @details Given a device index @p dv_ind, a pointer to a uint32_t
+ *  @p num_blocks and an array of ::rsmi_gpu_block_error_count_t @p counts,
+ *  this function will write the error counts of every block that has ECC
+ *  enabled and an error counter in the kernel to @p counts, in a single pass
+ *  over the device's RAS counters. The enabled block mask is cached for up
+ *  to one second, so a change made through the ras_ctrl interface is seen
+ *  by calls made after that.
+ *
+ *  If @p counts is nullptr, the number of such blocks is written to
+ *  @p num_blocks. Otherwise @p num_blocks holds the number of entries in
+ *  @p counts on input, and the number of entries written on output.
+ *
+ *  @param[in] dv_ind a device index
+ *
+ *  @param[inout] num_blocks the size of @p counts on input, the number of
+ *  blocks on output
+ *
+ *  @param[inout] counts an array to which the per block error counts are
+ *  written, or nullptr to only query the number of blocks
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_NOT_SUPPORTED the device does not report its enabled
+ *  RAS blocks
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ */
+rsmi_status_t rsmi_dev_ecc_count_all_get(uint32_t dv_ind, uint32_t *num_blocks,
+                                       rsmi_gpu_block_error_count_t *counts);
+
 /**
  *  @brief Retrieve the ECC status for a GPU block
  *
@@ -4138,6 +4385,100 @@ rsmi_status_t
 rsmi_counter_read(rsmi_event_handle_t evt_handle,
                                                  rsmi_counter_value_t *value);
 
+/**
+ *  @brief Create a group of performance counters that are read together
+ *
+ *  @details Create counters for the @p num_events event types in @p types
+ *  on the device with index @p dv_ind and write a handle for the group to
+ *  @p grp_handle. Events of the same ::rsmi_event_group_t share a single
+ *  kernel perf group, so they are started, stopped and sampled atomically
+ *  with respect to each other, and ::rsmi_counter_group_read() fetches all
+ *  of them with one read per event group instead of one per counter. The
+ *  handle should be deallocated with ::rsmi_dev_counter_group_destroy().
+ *
+ *  @param[in] dv_ind a device index
+ *
+ *  @param[in] types array of ::rsmi_event_type_t to count
+ *
+ *  @param[in] num_events number of entries in @p types
+ *
+ *  @param[inout] grp_handle A pointer to a ::rsmi_event_group_handle_t
+ *  which will be associated with the newly allocated group
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ *  @retval ::RSMI_STATUS_OUT_OF_RESOURCES unable to allocate memory for group
+ *  @retval ::RSMI_STATUS_PERMISSION function requires root access
+ *
+ */
+rsmi_status_t
+rsmi_dev_counter_group_create(uint32_t dv_ind, const rsmi_event_type_t *types,
+                uint32_t num_events, rsmi_event_group_handle_t *grp_handle);
+
+/**
+ *  @brief Deallocate a group of performance counters
+ *
+ *  @details Stop and deallocate all the counters of the group associated
+ *  with @p grp_handle
+ *
+ *  @param[in] grp_handle handle to the group to be deallocated
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS is returned upon successful call
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ *  @retval ::RSMI_STATUS_PERMISSION function requires root access
+ *
+ */
+rsmi_status_t
+rsmi_dev_counter_group_destroy(rsmi_event_group_handle_t grp_handle);
+
+/**
+ *  @brief Issue performance counter control commands to a counter group
+ *
+ *  @details Issue a command @p cmd to every counter of the group associated
+ *  with @p grp_handle. ::RSMI_CNTR_CMD_START opens the counters on first
+ *  use and enables them together; ::RSMI_CNTR_CMD_STOP disables them
+ *  together.
+ *
+ *  @param[in] grp_handle a counter group handle
+ *
+ *  @param[in] cmd The event counter command to be issued
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS is returned upon successful call
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ *  @retval ::RSMI_STATUS_PERMISSION function requires root access
+ *
+ */
+rsmi_status_t
+rsmi_counter_group_control(rsmi_event_group_handle_t grp_handle,
+                                                   rsmi_counter_command_t cmd);
+
+/**
+ *  @brief Read all counters of a counter group
+ *
+ *  @details Read the counters of the group associated with @p grp_handle
+ *  and write one ::rsmi_counter_value_t per event to @p values, in the
+ *  order the events were passed to ::rsmi_dev_counter_group_create(). As
+ *  with ::rsmi_counter_read(), each value is the number of events since the
+ *  previous read or start. Counters of the same ::rsmi_event_group_t share
+ *  the same time_enabled and time_running.
+ *
+ *  @param[in] grp_handle a counter group handle
+ *
+ *  @param[inout] values array of at least @p num_values elements
+ *
+ *  @param[in] num_values number of elements in @p values; must be at least
+ *  the number of events in the group
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS is returned upon successful call
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ *  @retval ::RSMI_STATUS_INSUFFICIENT_SIZE @p num_values is too small
+ *  @retval ::RSMI_STATUS_PERMISSION function requires root access
+ *
+ */
+rsmi_status_t
+rsmi_counter_group_read(rsmi_event_group_handle_t grp_handle,
+                        rsmi_counter_value_t *values, uint32_t num_values);
+
 /**
  *  @brief Get the number of currently available counters
  *
@@ -4952,6 +5293,48 @@ rsmi_status_t
 rsmi_func_iter_value_get(rsmi_func_id_iter_handle_t handle,
                                                  rsmi_func_id_value_t *value);
 
+/**
+ * @brief Get the supported functions of a device as a bitmap
+ *
+ * @details Given a device index @p dv_ind and a pointer to an
+ * ::rsmi_supported_func_bitmap_t @p funcs, this function will write the set
+ * of functions supported by the device to @p funcs, in one call. This covers
+ * the same functions as ::rsmi_dev_supported_func_iterator_open, without
+ * their variants and monitors.
+ *
+ * @param[in] dv_ind a device index
+ *
+ * @param[inout] funcs a pointer to an ::rsmi_supported_func_bitmap_t to which
+ * the bitmap will be written
+ *
+ * @retval ::RSMI_STATUS_SUCCESS is returned upon successful call.
+ * @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ *
+ */
+rsmi_status_t
+rsmi_dev_supported_func_bitmap_get(uint32_t dv_ind,
+                                   rsmi_supported_func_bitmap_t *funcs);
+
+/**
+ * @brief Get the name of a function id of ::rsmi_supported_func_bitmap_t
+ *
+ * @details Given a function id @p func_id, this function will write a
+ * pointer to the name of the function (e.g., "rsmi_dev_temp_metric_get")
+ * to @p name. The string is owned by the library.
+ *
+ * @param[in] func_id a function id, less than num_funcs of
+ * ::rsmi_supported_func_bitmap_t
+ *
+ * @param[inout] name a pointer to which the name will be written
+ *
+ * @retval ::RSMI_STATUS_SUCCESS is returned upon successful call.
+ * @retval ::RSMI_STATUS_INVALID_ARGS @p func_id is not a valid id or @p name
+ * is nullptr
+ *
+ */
+rsmi_status_t
+rsmi_supported_func_name_get(uint32_t func_id, const char **name);
+
 /** @} */  // end of APISupport
 
 /*****************************************************************************/
@@ -5017,13 +5400,15 @@ rsmi_event_notification_mask_set(uint32_t dv_ind, uint64_t mask);
  * and write up to *@p num_elem event items to @p data. Upon return @p num_elem
  * is updated with the number of events that were actually written. If events
  * are already present when this function is called, it will write the events
- * to the buffer then poll for new events if there is still caller-provided
- * buffer available to write any new events that would be found.
+ * to the buffer, along with any other events that are ready on any device,
+ * and return without waiting. It only waits for up to @p timeout_ms if no
+ * event is ready.
  *
  * This function requires prior calls to ::rsmi_event_notification_init() and
- * ::rsmi_event_notification_mask_set(). This function polls for the
- * occurrance of the events on the respective devices that were previously
- * specified by ::rsmi_event_notification_mask_set().
+ * ::rsmi_event_notification_mask_set(). The event files of all the devices
+ * are watched together with a single epoll instance. The message of an event
+ * is the information that follows the event type in the kernel's record,
+ * truncated to ::MAX_EVENT_NOTIFICATION_MSG_SIZE - 1 characters.
  *
  * @param[in] timeout_ms number of milliseconds to wait for an event
  * to occur
@@ -5045,11 +5430,54 @@ rsmi_event_notification_mask_set(uint32_t dv_ind, uint64_t mask);
  *
  * @retval ::RSMI_STATUS_NO_DATA No events were found to collect.
  *
+ * @retval ::RSMI_STATUS_BUSY A callback set with
+ * ::rsmi_event_notification_callback_set() is receiving the events.
+ *
  */
 rsmi_status_t
 rsmi_event_notification_get(int timeout_ms,
                      uint32_t *num_elem, rsmi_evt_notification_data_t *data);
 
+/**
+ * @brief Have event notifications delivered to a callback
+ *
+ * @details Starts a thread that waits for the events of every device set up
+ * with ::rsmi_event_notification_init() and ::rsmi_event_notification_mask_set()
+ * and calls @p callback with each of them, passing @p user_data along. The
+ * callback runs on that thread and may call other RSMI functions, except
+ * this one. While a callback is set, ::rsmi_event_notification_get() returns
+ * ::RSMI_STATUS_BUSY. Passing a nullptr @p callback stops the thread, after
+ * any call in progress has returned.
+ *
+ * @param[in] callback the function to call for each event, or nullptr
+ *
+ * @param[in] user_data passed to @p callback
+ *
+ * @retval ::RSMI_STATUS_SUCCESS is returned upon successful call
+ * @retval ::RSMI_STATUS_BUSY if called from the callback
+ */
+rsmi_status_t
+rsmi_event_notification_callback_set(rsmi_evt_notification_callback_t callback,
+                                     void *user_data);
+
+/**
+ * @brief Get a file descriptor that becomes readable when events are ready
+ *
+ * @details Writes to @p fd a file descriptor that an application can add to
+ * its own poll(), epoll or other event loop. It is readable whenever
+ * ::rsmi_event_notification_get() would return events without waiting, so the
+ * events can then be collected with a @p timeout_ms of 0. The descriptor
+ * belongs to the library: it must not be read from or closed, and it stays
+ * valid until ::rsmi_shut_down().
+ *
+ * @param[out] fd a pointer to an int to which the descriptor is written
+ *
+ * @retval ::RSMI_STATUS_SUCCESS is returned upon successful call
+ * @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ */
+rsmi_status_t
+rsmi_event_notification_fd_get(int *fd);
+
 /**
  * @brief Close any file handles and free any resources used by event
  * notification for a GPU
@@ -5132,8 +5560,84 @@ rsmi_dev_metrics_xcd_counter_get(uint32_t dv_ind, uint16_t* xcd_counter_value);
 rsmi_status_t
 rsmi_dev_metrics_log_get(uint32_t dv_ind);
 
+/**
+ *  @brief Set the maximum age of the GPU metrics snapshot of a device
+ *
+ *  @details Given a device index @p dv_ind and a time in microseconds
+ *  @p ttl_us , queries derived from the GPU metrics table (e.g.
+ *  ::rsmi_dev_gpu_metrics_info_get, ::rsmi_dev_energy_count_get, and the
+ *  rsmi_dev_metrics_*_get functions) will be served from the last metrics
+ *  table read from the device, as long as it is not older than @p ttl_us .
+ *  A value of 0 disables the snapshot, and every query reads the metrics
+ *  table again. The default is 0, or 1 ms if ::RSMI_INIT_FLAG_GPU_METRICS_CACHE
+ *  was passed to rsmi_init(). The default can also be set with the
+ *  RSMI_GPU_METRICS_CACHE_TTL_US environment variable.
+ *
+ *  @param[in] dv_ind a device index
+ *
+ *  @param[in] ttl_us maximum age of the snapshot, in microseconds
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ *
+ */
+rsmi_status_t
+rsmi_dev_gpu_metrics_cache_ttl_set(uint32_t dv_ind, uint64_t ttl_us);
+
+/**
+ *  @brief Get the maximum age of the GPU metrics snapshot of a device
+ *
+ *  @details Given a device index @p dv_ind and a pointer to a uint64_t
+ *  @p ttl_us , this function will write the maximum age, in microseconds,
+ *  of the GPU metrics snapshot set for the device to @p ttl_us .
+ *
+ *  @param[in] dv_ind a device index
+ *
+ *  @param[inout] ttl_us a pointer to uint64_t to which the maximum age will
+ *  be written
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ *
+ */
+rsmi_status_t
+rsmi_dev_gpu_metrics_cache_ttl_get(uint32_t dv_ind, uint64_t *ttl_us);
+
 /** @} */  // end of DevMetricsHeaderInfoGet
 
+/*****************************************************************************/
+/** @defgroup SysfsFdCache Sysfs File Descriptor Cache
+ *  When ::RSMI_INIT_FLAG_SYSFS_FD_CACHE is passed to rsmi_init() (or the
+ *  RSMI_SYSFS_FD_CACHE environment variable is set), read-only sysfs attribute
+ *  files are kept open per device and re-read with pread(), instead of being
+ *  opened and closed on every query.
+ *  @{
+ */
+
+/**
+ *  @brief Get the sysfs file descriptor cache counters of a device
+ *
+ *  @details Given a device index @p dv_ind and a pointer to a
+ *  ::rsmi_sysfs_fd_cache_stats_t @p stats , this function will write the
+ *  current hit/miss/invalidation counters of the device's sysfs file
+ *  descriptor cache to @p stats . The counters are zero if the cache is not
+ *  enabled.
+ *
+ *  @param[in] dv_ind a device index
+ *
+ *  @param[inout] stats a pointer to a ::rsmi_sysfs_fd_cache_stats_t to which
+ *  the counters will be written
+ *
+ *  @retval ::RSMI_STATUS_SUCCESS call was successful
+ *  @retval ::RSMI_STATUS_INVALID_ARGS the provided arguments are not valid
+ *
+ */
+rsmi_status_t
+rsmi_dev_sysfs_fd_cache_stats_get(uint32_t dv_ind,
+                                  rsmi_sysfs_fd_cache_stats_t *stats);
+
+/** @} */  // end of SysfsFdCache
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
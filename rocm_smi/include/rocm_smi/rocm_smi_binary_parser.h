@@ -47,9 +47,14 @@
 #include "rocm_smi/rocm_smi_common.h"
 #include "rocm_smi/rocm_smi.h"
 
+#include <sys/types.h>
+
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -86,174 +91,82 @@ struct metric_field {
     uint8_t field_flag;
 };
 
-struct metric_field xgmi_regs[] = {
-    { FIELD_TYPE_U16, 1, "structure_size", 0 },
-    { FIELD_TYPE_U8,  1, "format_revision", 0 },
-    { FIELD_TYPE_U8,  1, "content_revision", 0 },
-    { FIELD_TYPE_U8,  1, "state_type", 0 },
-    { FIELD_TYPE_U8,  1, "num_instances", FIELD_FLAG_NUM_INSTANCE },
-    { FIELD_TYPE_U16, 1, "pad", 0 },
-
-    { FIELD_TYPE_U16, 1, "instance", FIELD_FLAG_INSTANCE_START },
-    { FIELD_TYPE_U16, 1, "state", 0 },
-    { FIELD_TYPE_U16, 1, "num_smn_regs", FIELD_FLAG_NUM_SMN },
-    { FIELD_TYPE_U16, 1, "pad", 0 },
-
-    { FIELD_TYPE_U64, 1, "addr", FIELD_FLAG_SMN_START },
-    { FIELD_TYPE_U32, 1, "value", 0 },
-    { FIELD_TYPE_U32, 1, "pad", 0 },
-    { 0, 0, NULL, 0 },
-};
-
-// check me!
-struct metric_field wafl_regs[] = {
-    { FIELD_TYPE_U16, 1, "structure_size", 0 },
-    { FIELD_TYPE_U8,  1, "format_revision", 0 },
-    { FIELD_TYPE_U8,  1, "content_revision", 0 },
-    { FIELD_TYPE_U8,  1, "state_type", 0 },
-    { FIELD_TYPE_U8,  1, "num_instances", FIELD_FLAG_NUM_INSTANCE },
-    { FIELD_TYPE_U16, 1, "pad", 0 },
-
-    { FIELD_TYPE_U16, 1, "instance", FIELD_FLAG_INSTANCE_START },
-    { FIELD_TYPE_U16, 1, "state", 0 },
-    { FIELD_TYPE_U16, 1, "num_smn_regs", FIELD_FLAG_NUM_SMN },
-    { FIELD_TYPE_U16, 1, "pad", 0 },
-
-    { FIELD_TYPE_U64, 1, "addr", FIELD_FLAG_SMN_START },
-    { FIELD_TYPE_U32, 1, "value", 0 },
-    { FIELD_TYPE_U32, 1, "pad", 0 },
-    { 0, 0, NULL, 0 },
-};
-
-struct metric_field pcie_regs[] = {
-    { FIELD_TYPE_U16, 1, "structure_size", 0 },
-    { FIELD_TYPE_U8,  1, "format_revision", 0 },
-    { FIELD_TYPE_U8,  1, "content_revision", 0 },
-    { FIELD_TYPE_U8,  1, "state_type", 0 },
-    { FIELD_TYPE_U8,  1, "num_instances", FIELD_FLAG_NUM_INSTANCE },
-    { FIELD_TYPE_U16, 1, "pad", 0 },
-
-    { FIELD_TYPE_U16, 1, "instance", FIELD_FLAG_INSTANCE_START },
-    { FIELD_TYPE_U16, 1, "state", 0 },
-    { FIELD_TYPE_U16, 1, "num_smn_regs", FIELD_FLAG_NUM_SMN },
-    { FIELD_TYPE_U16, 1, "pad", 0 },
-
-    { FIELD_TYPE_U16, 1, "device_status", 0 },
-    { FIELD_TYPE_U16, 1, "link_status", 0 },
-    { FIELD_TYPE_U32, 1, "sub_bus_number_latency", 0 },
-    { FIELD_TYPE_U32, 1, "pcie_corr_err_status", 0 },
-    { FIELD_TYPE_U32, 1, "pcie_uncorr_err_status", 0 },
-
-    { FIELD_TYPE_U64, 1, "addr", FIELD_FLAG_SMN_START },
-    { FIELD_TYPE_U32, 1, "value", 0 },
-    { FIELD_TYPE_U32, 1, "pad", 0 },
-    { 0, 0, NULL, 0 },
-};
-
-struct metric_field usr_regs[] = {
-    { FIELD_TYPE_U16, 1, "structure_size", 0 },
-    { FIELD_TYPE_U8,  1, "format_revision", 0 },
-    { FIELD_TYPE_U8,  1, "content_revision", 0 },
-    { FIELD_TYPE_U8,  1, "state_type", 0 },
-    { FIELD_TYPE_U8,  1, "num_instances", FIELD_FLAG_NUM_INSTANCE },
-    { FIELD_TYPE_U16, 1, "pad", 0 },
-
-    { FIELD_TYPE_U16, 1, "instance", FIELD_FLAG_INSTANCE_START },
-    { FIELD_TYPE_U16, 1, "state", 0 },
-    { FIELD_TYPE_U16, 1, "num_smn_regs", FIELD_FLAG_NUM_SMN },
-    { FIELD_TYPE_U16, 1, "pad", 0 },
-
-    { FIELD_TYPE_U64, 1, "addr", FIELD_FLAG_SMN_START },
-    { FIELD_TYPE_U32, 1, "value", 0 },
-    { FIELD_TYPE_U32, 1, "pad", 0 },
-    { 0, 0, NULL, 0 },
-};
-
 // definition for pm metrics table
 #define FIELD_FLAG_ACCUMULATOR  0x01
 
-struct metric_field smu_13_0_6_v8[] = {
-    { FIELD_TYPE_U16, 1, "structure_size", 0 },
-    { FIELD_TYPE_U16, 1, "pad", 0 },
-    { FIELD_TYPE_U32, 1, "mp1_ip_discovery_version", 0 },
-    { FIELD_TYPE_U32, 1, "pmfw_version", 0 },
-    { FIELD_TYPE_U32, 1, "pmmetrics_version", 0 },
-
-    { FIELD_TYPE_U32, 1, "AccumulationCounter", 0 },
-
-    { FIELD_TYPE_U32,  1, "MaxSocketTemperature", 0 },
-    { FIELD_TYPE_U32,  1, "MaxVrTemperature", 0 },
-    { FIELD_TYPE_U32,  1, "MaxHbmTemperature", 0 },
-    { FIELD_TYPE_U64,  1, "MaxSocketTemperatureAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U64,  1, "MaxVrTemperatureAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U64,  1, "MaxHbmTemperatureAcc", FIELD_FLAG_ACCUMULATOR },
-
-    { FIELD_TYPE_U32,  1, "SocketPowerLimit", 0 },
-    { FIELD_TYPE_U32,  1, "MaxSocketPowerLimit", 0 },
-    { FIELD_TYPE_U32,  1, "SocketPower", 0 },
-
-    { FIELD_TYPE_U64,  1, "Timestamp", 0 },
-    { FIELD_TYPE_U64,  1, "SocketEnergyAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U64,  1, "CcdEnergyAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U64,  1, "XcdEnergyAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U64,  1, "AidEnergyAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U64,  1, "HbmEnergyAcc", FIELD_FLAG_ACCUMULATOR },
-
-    { FIELD_TYPE_U32,  1, "CclkFrequencyLimit", 0 },
-    { FIELD_TYPE_U32,  1, "GfxclkFrequencyLimit", 0 },
-    { FIELD_TYPE_U32,  1, "FclkFrequency", 0 },
-    { FIELD_TYPE_U32,  1, "UclkFrequency", 0 },
-    { FIELD_TYPE_U32,  4, "SocclkFrequency", 0 },
-    { FIELD_TYPE_U32,  4, "VclkFrequency", 0 },
-    { FIELD_TYPE_U32,  4, "DclkFrequency", 0 },
-    { FIELD_TYPE_U32,  4, "LclkFrequency", 0 },
-    { FIELD_TYPE_U64,  8, "GfxclkFrequencyAcc", FIELD_FLAG_ACCUMULATOR},
-    { FIELD_TYPE_U64,  96, "CclkFrequencyAcc", FIELD_FLAG_ACCUMULATOR },
-
-    { FIELD_TYPE_U32,  1, "MaxCclkFrequency", 0 },
-    { FIELD_TYPE_U32,  1, "MinCclkFrequency", 0 },
-    { FIELD_TYPE_U32,  1, "MaxGfxclkFrequency", 0 },
-    { FIELD_TYPE_U32,  1, "MinGfxclkFrequency", 0 },
-    { FIELD_TYPE_U32,  4, "FclkFrequencyTable", 0 },
-    { FIELD_TYPE_U32,  4, "UclkFrequencyTable", 0 },
-    { FIELD_TYPE_U32,  4, "SocclkFrequencyTable", 0 },
-    { FIELD_TYPE_U32,  4, "VclkFrequencyTable", 0 },
-    { FIELD_TYPE_U32,  4, "DclkFrequencyTable", 0 },
-    { FIELD_TYPE_U32,  4, "LclkFrequencyTable", 0 },
-    { FIELD_TYPE_U32,  1, "MaxLclkDpmRange", 0 },
-    { FIELD_TYPE_U32,  1, "MinLclkDpmRange", 0 },
-
-    { FIELD_TYPE_U32,  1, "XgmiWidth", 0 },
-    { FIELD_TYPE_U32,  1, "XgmiBitrate", 0 },
-    { FIELD_TYPE_U64,  8, "XgmiReadBandwidthAcc", 0 },
-    { FIELD_TYPE_U64,  8, "XgmiWriteBandwidthAcc", 0 },
-
-    { FIELD_TYPE_U32,  1, "SocketC0Residency", 0 },
-    { FIELD_TYPE_U32,  1, "SocketGfxBusy", 0 },
-    { FIELD_TYPE_U32,  1, "DramBandwidthUtilization", 0 },
-    { FIELD_TYPE_U64,  1, "SocketC0ResidencyAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U64,  1, "SocketGfxBusyAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U64,  1, "DramBandwidthAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U32,  1, "MaxDramBandwidth", 0 },
-    { FIELD_TYPE_U64,  1, "DramBandwidthUtilizationAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U64,  4, "PcieBandwidthAcc", FIELD_FLAG_ACCUMULATOR },
-
-    { FIELD_TYPE_U32,  1, "ProchotResidencyAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U32,  1, "PptResidencyAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U32,  1, "SocketThmResidencyAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U32,  1, "VrThmResidencyAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U32,  1, "HbmThmResidencyAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U32,  1, "GfxLockXCDMak", 0 },
-
-    { FIELD_TYPE_U32,  8, "GfxclkFrequency", 0 },
-
-    { FIELD_TYPE_U64,  4, "PublicSerialNumber_AID", 0 },
-    { FIELD_TYPE_U64,  8, "PublicSerialNumber_XCD", 0 },
-    { FIELD_TYPE_U64,  12, "PublicSerialNumber_CCD", 0 },
-
-    { FIELD_TYPE_U64,  8, "XgmiReadDataSizeAcc", FIELD_FLAG_ACCUMULATOR },
-    { FIELD_TYPE_U64,  8, "XgmiWriteDataSizeAcc", FIELD_FLAG_ACCUMULATOR },
-    { 0, 0, NULL, 0 },
+/**
+ *  Decodes the pm_metrics table or one reg_state section into caller-owned
+ *  name/value pairs.
+ *
+ *  The layout of the table (the offset, size and name of every value) is
+ *  compiled on the first read, and again only when one of the fields that
+ *  shape it changes: the pmmetrics_version of pm_metrics, or the number of
+ *  instances and of registers per instance of a reg_state section. Other
+ *  reads copy the values straight from the blob, which is read into a buffer
+ *  owned by the decoder, without allocating or formatting names.
+ */
+class MetricsTableDecoder {
+ public:
+  // The pm_metrics table, laid out according to its pmmetrics_version
+  MetricsTableDecoder(void);
+  // The reg_type section of reg_state
+  explicit MetricsTableDecoder(rsmi_reg_type_t reg_type);
+  MetricsTableDecoder(const MetricsTableDecoder&) = delete;
+  MetricsTableDecoder& operator=(const MetricsTableDecoder&) = delete;
+
+  // Reads the table from path and decodes it. If kv is nullptr, only the
+  // number of values is written to *num. Otherwise *num is the size of kv
+  // on input and the number of values written on output. With changes_only,
+  // only the values that differ from those of the previous changes_only
+  // read are written (all of them the first time, and after the layout
+  // changed). Returns 0, the errno of the read, EINVAL if the table is not
+  // recognized or is truncated, or ENOSPC if kv is too small, with the
+  // number of values of the table in *num.
+  int read(const std::string &path, rsmi_name_value_t *kv, uint32_t *num,
+           bool changes_only);
+  // As read(), into an array allocated with calloc() for the caller to free
+  int read_alloc(const std::string &path, rsmi_name_value_t **kv,
+                 uint32_t *num);
+  // As read(), for a table already in memory
+  int decode(const uint8_t *buf, std::size_t len, rsmi_name_value_t *kv,
+             uint32_t *num, bool changes_only);
+
+ private:
+  struct Field {
+    uint32_t offset;
+    uint8_t size;
+    char name[MAX_RSMI_NAME_LENGTH];
+  };
+  // A field the layout was compiled for, with the value it had
+  struct LayoutKey {
+    uint32_t offset;
+    uint8_t size;
+    uint64_t value;
+  };
+
+  int load_locked(const std::string &path, std::size_t *len);
+  bool layout_matches_locked(const uint8_t *buf, std::size_t len) const;
+  int compile_locked(const uint8_t *buf, std::size_t len);
+  int compile_pmmetrics_locked(const uint8_t *buf, std::size_t len);
+  int compile_reg_state_locked(const uint8_t *buf, std::size_t len);
+  int add_field_locked(const metric_field &field, std::size_t offset,
+                       std::size_t len, const char *name);
+  int decode_locked(const uint8_t *buf, std::size_t len,
+                    rsmi_name_value_t *kv, uint32_t *num, bool changes_only);
+
+  const metric_field *table_;     // nullptr for pm_metrics
+  off_t file_offset_;
+  std::size_t read_size_;
+
+  std::mutex mutex_;
+  std::vector<uint8_t> buf_;
+  bool compiled_;
+  std::size_t min_len_;
+  std::vector<LayoutKey> layout_keys_;
+  std::vector<Field> fields_;
+  // The values of the previous changes_only read, when valid
+  std::vector<uint64_t> prev_values_;
+  bool prev_values_valid_;
 };
 
 }  // namespace amd::smi
@@ -77,27 +77,46 @@
       return RSMI_STATUS_PERMISSION; \
     }
 
-#define DEVICE_MUTEX \
-    amd::smi::pthread_wrap _pw(*amd::smi::GetMutex(dv_ind)); \
+/* Device locking. Getters take the device lock shared, so readers in any
+ * process don't serialize on each other; setters, resets and partition
+ * changes take it exclusive. See amd::smi::ScopedDeviceLock.
+ */
+#define DEVICE_LOCK(MODE) \
     amd::smi::RocmSMI& smi_ = amd::smi::RocmSMI::getInstance(); \
     bool blocking_ = !(smi_.init_options() & \
                           static_cast<uint64_t>(RSMI_INIT_FLAG_RESRV_TEST1)); \
-    amd::smi::ScopedPthread _lock(_pw, blocking_); \
-    if (!blocking_ && _lock.mutex_not_acquired()) { \
-      return RSMI_STATUS_BUSY; \
+    amd::smi::ScopedDeviceLock _lock(amd::smi::GetRWLock(dv_ind), (MODE), \
+                                     blocking_); \
+    if (_lock.lock_not_acquired()) { \
+      return _lock.status(); \
     }
 
+// Setters, resets, partition changes
+#define DEVICE_MUTEX DEVICE_LOCK(amd::smi::kDeviceLockExclusive)
+
+// Getters
+#define DEVICE_READ_MUTEX DEVICE_LOCK(amd::smi::kDeviceLockShared)
+
+// Getters that only read sysfs files, which the kernel already reads
+// atomically; no locking at all with RSMI_INIT_FLAG_LOCKLESS_READS
+#define DEVICE_SYSFS_READ_MUTEX \
+    DEVICE_LOCK(amd::smi::RocmSMI::getInstance().lockless_reads() ? \
+                  amd::smi::kDeviceLockNone : amd::smi::kDeviceLockShared)
+
 /* This group of macros is used to facilitate checking of support for rsmi_dev*
  * "getter" functions. When the return buffer is set to nullptr, the macro will
  * check the previously gathered device support data to see if the function,
  * with possible variants (e.g., memory types, firmware types,...) and
  * subvariants (e.g. monitors/sensors) are supported.
  */
-// This macro assumes dev already available
+// This macro assumes dev already available. The function id is looked up
+// from the name once per call site.
 #define CHK_API_SUPPORT_ONLY(RT_PTR, VR, SUB_VR) \
     if ((RT_PTR) == nullptr) { \
       try { \
-        if (!dev->DeviceAPISupported(__FUNCTION__, (VR), (SUB_VR))) { \
+        static const amd::smi::SupportedFuncId func_id_ = \
+                           amd::smi::SupportedFuncIdFromName(__FUNCTION__); \
+        if (!dev->DeviceAPISupported(func_id_, (VR), (SUB_VR))) { \
           return RSMI_STATUS_NOT_SUPPORTED; \
         }  \
         return RSMI_STATUS_INVALID_ARGS; \
@@ -174,6 +193,43 @@ struct RocmSMI_env_vars {
     // Otherwise unset values, signify logging is turned off.
     uint32_t logging_on;
 
+    // Number of messages the log queue holds (RSMI_LOGGING_QUEUE_SIZE);
+    // 0 for the default
+    uint32_t logging_queue_size;
+
+    // If RSMI_LOGGING_JSON is set (non-zero), logs are written as JSON lines
+    uint32_t logging_json;
+
+    // If RSMI_SYSFS_FD_CACHE is set (non-zero), read-only sysfs attribute
+    // files are kept open and re-read with pread(). Same as passing
+    // RSMI_INIT_FLAG_SYSFS_FD_CACHE to rsmi_init().
+    uint32_t sysfs_fd_cache;
+
+    // If RSMI_LAZY_INIT is set (non-zero), per-device state is discovered on
+    // first use. Same as passing RSMI_INIT_FLAG_LAZY to rsmi_init().
+    uint32_t lazy_init;
+
+    // If RSMI_DISCOVERY_CACHE is set (non-zero), static discovery results
+    // are kept in a cache file across processes. Same as passing
+    // RSMI_INIT_FLAG_DISCOVERY_CACHE to rsmi_init(). Only read by DEBUG and
+    // RSMI_ENABLE_TEST_OVERRIDES builds.
+    uint32_t discovery_cache;
+
+    // If RSMI_LOCKLESS_READS is set (non-zero), getters that only read
+    // sysfs files don't take the device lock. Same as passing
+    // RSMI_INIT_FLAG_LOCKLESS_READS to rsmi_init().
+    uint32_t lockless_reads;
+
+    // Env. var. RSMI_DISCOVERY_CACHE_PATH, the cache file to use instead of
+    // /run/amdsmi/discovery.cache. Only read by DEBUG and
+    // RSMI_ENABLE_TEST_OVERRIDES builds.
+    const char *discovery_cache_path;
+
+    // Default max age (usec) of the per-device gpu_metrics snapshot
+    // (RSMI_GPU_METRICS_CACHE_TTL_US). Overrides the default set by
+    // RSMI_INIT_FLAG_GPU_METRICS_CACHE.
+    uint32_t gpu_metrics_cache_ttl_us;
+
     // Sysfs path overrides
 
     // Env. var. RSMI_DEBUG_DRM_ROOT_OVERRIDE
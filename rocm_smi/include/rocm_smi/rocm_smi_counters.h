@@ -48,6 +48,7 @@
 #include <linux/perf_event.h>
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include <unordered_set>
 #include <string>
@@ -93,11 +94,21 @@ class Event {
     ~Event(void);
 
     int32_t openPerfHandle();
+    // Open this event as a member of a perf group. A leader_fd of -1 makes
+    // this event the group leader; the group is read with PERF_FORMAT_GROUP.
+    int32_t openGroupedPerfHandle(int32_t leader_fd);
+    void closePerfHandle(void);
     int32_t startCounter(void);
     int32_t stopCounter(void);
     uint32_t getValue(rsmi_counter_value_t *val);
+    // Convert an absolute count taken from a group read into a delta
+    void updateValue(uint64_t raw, uint64_t enabled, uint64_t running,
+                                                    rsmi_counter_value_t *val);
     uint32_t dev_file_ind(void) const {return dev_file_ind_;}
     uint32_t dev_ind(void) const {return dev_ind_;}
+    rsmi_event_group_t event_group(void) const {return event_group_;}
+    int32_t fd(void) const {return fd_;}
+    uint64_t perf_id(void) const {return perf_id_;}
 
  private:
     // perf_event_attr fields
@@ -106,13 +117,48 @@ class Event {
     std::string evt_path_root_;
 
     rsmi_event_type_t event_type_;
+    rsmi_event_group_t event_group_;
     uint32_t dev_file_ind_;
     uint32_t dev_ind_;
     int32_t fd_;
+    uint64_t perf_id_;
     perf_event_attr attr_;
     uint64_t prev_cntr_val_;
     int32_t get_event_file_info(void);
     int32_t get_event_type(uint32_t *ev_type);
+    int32_t init_perf_attr(void);
+};
+
+// A set of events on one device which are enabled, disabled and read
+// together. Events are split into one perf group per PMU (a perf group may
+// not span PMUs), so a read costs one syscall per PMU rather than one per
+// event, and all counters in a PMU group cover the same time interval.
+class EventGroup {
+ public:
+    EventGroup(const rsmi_event_type_t *events, uint32_t num_events,
+                                                            uint32_t dev_ind);
+    ~EventGroup(void);
+
+    int32_t openPerfHandles(void);
+    int32_t startCounters(void);
+    int32_t stopCounters(void);
+    uint32_t getValues(rsmi_counter_value_t *vals);
+    uint32_t num_events(void) const {
+      return static_cast<uint32_t>(events_.size());
+    }
+    uint32_t dev_ind(void) const {return dev_ind_;}
+
+ private:
+    uint32_t dev_ind_;
+    // Events in the order they were requested
+    std::vector<std::unique_ptr<Event>> events_;
+    // Indices into events_, one vector per PMU; the first entry is the leader
+    std::vector<std::vector<size_t>> pmu_groups_;
+    std::vector<uint64_t> read_buf_;
+    bool opened_;
+
+    int32_t ioctlGroups(unsigned long req);  // NOLINT(runtime/int)
+    void closePerfHandles(void);
 };
 
 
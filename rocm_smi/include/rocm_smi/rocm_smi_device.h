@@ -45,8 +45,11 @@
 
 #include <pthread.h>
 
+#include <functional>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <atomic>
 #include <utility>
 #include <cstdint>
 #include <vector>
@@ -54,14 +57,18 @@
 #include <map>
 #include <type_traits>
 #include <optional>
+#include <chrono>
 
 #include "rocm_smi/rocm_smi_monitor.h"
+#include "rocm_smi/rocm_smi_discovery_cache.h"
+#include "rocm_smi/rocm_smi_supported_funcs.h"
 #include "rocm_smi/rocm_smi_power_mon.h"
 #include "rocm_smi/rocm_smi_common.h"
 #include "rocm_smi/rocm_smi.h"
 #include "rocm_smi/rocm_smi_counters.h"
 #include "rocm_smi/rocm_smi_properties.h"
 #include "rocm_smi/rocm_smi_gpu_metrics.h"
+#include "rocm_smi/rocm_smi_binary_parser.h"
 #include "shared_mutex.h"   //NOLINT
 
 namespace amd {
@@ -194,6 +201,7 @@ typedef struct {
     std::vector<DevInfoTypes> variants;
 } dev_depends_t;
 
+class SysfsFd;
 
 class Device {
  public:
@@ -201,8 +209,13 @@ class Device {
     ~Device(void);
 
     void set_monitor(std::shared_ptr<Monitor> m) {monitor_ = m;}
+    // The hwmon monitor is only looked up, with this function, on the first
+    // call to monitor()
+    void set_monitor_finder(std::function<std::shared_ptr<Monitor>(void)> f) {
+      monitor_finder_ = std::move(f);
+    }
     std::string path(void) const {return path_;}
-    const std::shared_ptr<Monitor>& monitor() {return monitor_;}
+    const std::shared_ptr<Monitor>& monitor();
     const std::shared_ptr<PowerMon>& power_monitor() {return power_monitor_;}
     void set_power_monitor(std::shared_ptr<PowerMon> pm) {power_monitor_ = pm;}
 
@@ -227,23 +240,39 @@ class Device {
     uint64_t bdfid(void) const {return bdfid_;}
     void set_bdfid(uint64_t val) {bdfid_ = val;}
     pthread_mutex_t *mutex(void) {return mutex_.ptr;}
-    evt::dev_evt_grp_set_t* supported_event_groups(void) {
-                                             return &supported_event_groups_;}
+    // Process-shared reader/writer lock built on mutex(); see
+    // ScopedDeviceLock
+    shared_rwlock_t *rwlock(void) {return &rwlock_;}
+    // Serializes the gpu_metrics snapshot and the device/partition ids
+    // stamped on it between readers holding rwlock() shared
+    std::mutex *gpu_metrics_mutex(void) {return &gpu_metrics_mutex_;}
+    evt::dev_evt_grp_set_t* supported_event_groups(void);
     SupportedFuncMap *supported_funcs(void) {return &supported_funcs_;}
     uint64_t kfd_gpu_id(void) const {return kfd_gpu_id_;}
     void set_kfd_gpu_id(uint64_t id) {kfd_gpu_id_ = id;}
 
-    void set_evt_notif_anon_file_ptr(FILE *f) {evt_notif_anon_file_ptr_ = f;}
-    FILE *evt_notif_anon_file_ptr(void) const {return evt_notif_anon_file_ptr_;}
     void set_evt_notif_anon_fd(int fd) {evt_notif_anon_fd_ = fd;}
     void set_evt_notif_anon_fd(uint32_t fd) {
                                    evt_notif_anon_fd_ = static_cast<int>(fd);}
     int evt_notif_anon_fd(void) const {return evt_notif_anon_fd_;}
 
+    // Runs every support probe and builds supported_funcs() for the
+    // iterator API
     void fillSupportedFuncs(void);
+    // Discovery cache support: fill in a record from this device (probing
+    // what hasn't been yet), or seed the device from a cached record. The
+    // latter must come before the first monitor() and support checks.
+    void exportDiscovery(DiscoveryRecord *rec);
+    void restoreDiscovery(const DiscoveryRecord &rec);
     void DumpSupportedFunctions(void);
     bool DeviceAPISupported(std::string name, uint64_t variant,
                                                         uint64_t sub_variant);
+    // Only runs the probes of the function's family, once; after that a
+    // check is a bit test (or a small map lookup for sub-variants)
+    bool DeviceAPISupported(SupportedFuncId id, uint64_t variant,
+                                                        uint64_t sub_variant);
+    // Bit i of bitmap[i / 64] is set if function id i is supported
+    void supportedFuncBitmap(uint64_t bitmap[kSupportedFuncWords]);
     rsmi_status_t restartAMDGpuDriver(void);
     rsmi_status_t storeDevicePartitions(uint32_t dv_ind);
     template <typename T> std::string readBootPartitionState(uint32_t dv_ind);
@@ -256,19 +285,65 @@ class Device {
     rsmi_status_t dev_read_gpu_metrics_header_data();
     rsmi_status_t dev_read_gpu_metrics_all_data();
     rsmi_status_t run_internal_gpu_metrics_query(AMDGpuMetricsUnitType_t metric_counter, AMDGpuDynamicMetricTblValues_t& values);
+    // Decodes a single metric unit straight from the raw gpu_metrics table
+    rsmi_status_t dev_read_gpu_metrics_unit(AMDGpuMetricsUnitType_t metric_counter,
+                                            GpuMetricUnitValues_t& values,
+                                            uint16_t& num_values);
     rsmi_status_t dev_log_gpu_metrics(std::ostringstream& outstream_metrics);
     AMGpuMetricsPublicLatestTupl_t dev_copy_internal_to_external_metrics();
+    // Refreshes the snapshot (if needed) and converts it straight into the
+    // public metrics struct, without building the dynamic metrics table
+    rsmi_status_t dev_read_gpu_metrics_external(AMGpuMetricsPublicLatest_t& external_metrics);
+    // Max age (usec) of the gpu_metrics snapshot shared by metric queries;
+    // 0 means every query reads the metrics table again.
+    void set_gpu_metrics_cache_ttl(uint64_t ttl_us);
+    uint64_t gpu_metrics_cache_ttl(void) const {return m_gpu_metrics_cache_ttl_us;}
+    void invalidate_gpu_metrics_snapshot(void) {m_gpu_metrics_snapshot_valid = false;}
 
     static const std::map<DevInfoTypes, const char*> devInfoTypesStrings;
     void set_smi_device_id(uint32_t device_id) { m_device_id = device_id; }
-    void set_smi_partition_id(uint32_t partition_id) { m_partition_id = partition_id; }
+    // The partition id is cached along with the compute partition mode it
+    // was found under; a mode change by any process invalidates it.
+    void set_smi_partition_id(uint32_t partition_id,
+                              const std::string& compute_partition) {
+      m_partition_id = partition_id;
+      m_partition_id_mode = compute_partition;
+      m_partition_id_valid = true;
+    }
+    bool smi_partition_id_valid(const std::string& compute_partition) const {
+      return m_partition_id_valid && (compute_partition == m_partition_id_mode);
+    }
+    void invalidate_smi_partition_id(void) {m_partition_id_valid = false;}
     static const char* get_type_string(DevInfoTypes type);
 
+    // Per-device cache of open read-only sysfs attribute files, which are
+    // re-read with pread() rather than re-opened on every query.
+    void set_sysfs_fd_cache_enabled(bool enabled);
+    bool sysfs_fd_cache_enabled(void) const {return sysfs_fd_cache_enabled_;}
+    void invalidateSysfsFdCache(void);
+    void sysfs_fd_cache_stats(rsmi_sysfs_fd_cache_stats_t *stats);
+
+    // The ras/features block mask. A parsed mask (or a failed read) is kept
+    // for kRasFeaturesTtl, so a change made through ras_ctrl is picked up
+    int ras_features_mask(uint64_t *mask);
+    static constexpr std::chrono::milliseconds kRasFeaturesTtl{1000};
+    // Parses one ras/*_err_count file without allocating
+    int readErrCount(DevInfoTypes type, rsmi_error_count_t *ec);
+
+    // Decoders of the pm_metrics table and of each reg_state section, which
+    // keep their compiled layout for the life of the device
+    MetricsTableDecoder &pm_metrics_decoder(void) {return pm_metrics_decoder_;}
+    MetricsTableDecoder *reg_state_decoder(rsmi_reg_type_t reg_type);
+
  private:
     std::shared_ptr<Monitor> monitor_;
+    std::function<std::shared_ptr<Monitor>(void)> monitor_finder_;
+    std::once_flag monitor_once_;
     std::shared_ptr<PowerMon> power_monitor_;
     std::string path_;
     shared_mutex_t mutex_;
+    shared_rwlock_t rwlock_;
+    std::mutex gpu_metrics_mutex_;
     uint32_t card_indx_;  // This index corresponds to the drm index (ie, card#)
     uint32_t drm_render_minor_;
     const RocmSMI_env_vars *env_;
@@ -282,25 +357,77 @@ class Device {
                                             std::vector<std::string> *retVec);
     int readDevInfoBinary(DevInfoTypes type, std::size_t b_size,
                                             void *p_binary_data);
+    int readDevInfoBinaryBlob(DevInfoTypes type, std::size_t buf_sz,
+                              void *p_binary_data, std::size_t *len);
     int writeDevInfoStr(DevInfoTypes type, std::string valStr,
                         bool returnWriteErr = false);
+    int readSysfsFdCached(DevInfoTypes type, char *buf, std::size_t buf_sz,
+                          std::size_t *len);
+    void probeSupportedFuncs(SupportFamily family);
+    void ensureSupportFamily(SupportFamily family);
+    void setSupportedFunc(SupportedFuncId id,
+                          std::shared_ptr<VariantMap> variants);
     rsmi_status_t run_amdgpu_property_reinforcement_query(const AMDGpuPropertyQuery_t& amdgpu_property_query);
+    rsmi_status_t dev_setup_gpu_metrics_object();
+    rsmi_status_t dev_read_gpu_metrics_raw_data();
+    bool dev_gpu_metrics_snapshot_is_fresh() const;
+    void dev_adjust_gpu_metrics_snapshot();
 
     uint64_t bdfid_;
     uint64_t kfd_gpu_id_;
     std::unordered_set<rsmi_event_group_t,
                        evt::RSMIEventGrpHashFunction> supported_event_groups_;
+    std::once_flag supported_event_groups_once_;
     // std::map<std::string, uint64_t> kfdNodePropMap_;
+    // Support data, by function id. Each family fills in its own functions'
+    // entries, so families may be probed concurrently; the bitmap words can
+    // be shared between families and are atomic for that reason.
+    std::once_flag support_family_once_[kSupportFamilyCount];
+    std::atomic<uint64_t> supported_func_bits_[kSupportedFuncWords] = {};
+    uint64_t supported_variant_bits_[kSupportedFuncCount] = {};
+    std::shared_ptr<VariantMap> supported_variants_[kSupportedFuncCount];
     SupportedFuncMap supported_funcs_;
+    std::once_flag supported_funcs_once_;
 
     int evt_notif_anon_fd_;
-    FILE *evt_notif_anon_file_ptr_;
 
     GpuMetricsBasePtr m_gpu_metrics_ptr;
     AMDGpuMetricsHeader_v1_t m_gpu_metrics_header;
     uint64_t m_gpu_metrics_updated_timestamp;
+    uint64_t m_gpu_metrics_cache_ttl_us;
+    std::chrono::steady_clock::time_point m_gpu_metrics_snapshot_time;
+    bool m_gpu_metrics_snapshot_valid;
+    // run_metric_adjustments() was already applied (in place) to the
+    // current snapshot
+    bool m_gpu_metrics_snapshot_adjusted;
+    // The dynamic metrics table was built from the current snapshot
+    bool m_gpu_metrics_snapshot_tbl_built;
     uint32_t m_device_id;
     uint32_t m_partition_id;
+    std::string m_partition_id_mode;
+    bool m_partition_id_valid;
+
+    std::atomic<bool> sysfs_fd_cache_enabled_;
+    // A null entry marks an attribute that could not be cached (not
+    // readable, too long, ...)
+    std::map<DevInfoTypes, std::shared_ptr<SysfsFd>> sysfs_fd_cache_;
+    std::mutex sysfs_fd_cache_mutex_;
+    std::atomic<uint64_t> sysfs_fd_cache_hits_;
+    std::atomic<uint64_t> sysfs_fd_cache_misses_;
+    std::atomic<uint64_t> sysfs_fd_cache_invalidations_;
+
+    std::mutex ras_features_mutex_;
+    bool ras_features_valid_;
+    std::chrono::steady_clock::time_point ras_features_time_;
+    int ras_features_err_;
+    uint64_t ras_features_mask_;
+
+    MetricsTableDecoder pm_metrics_decoder_;
+    MetricsTableDecoder reg_state_decoders_[RSMI_REG_USR1 + 1] = {
+      MetricsTableDecoder(RSMI_REG_XGMI), MetricsTableDecoder(RSMI_REG_WAFL),
+      MetricsTableDecoder(RSMI_REG_PCIE), MetricsTableDecoder(RSMI_REG_USR),
+      MetricsTableDecoder(RSMI_REG_USR1),
+    };
 };
 
 
@@ -0,0 +1,106 @@
+/*
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+#ifndef INCLUDE_ROCM_SMI_ROCM_SMI_DISCOVERY_CACHE_H_
+#define INCLUDE_ROCM_SMI_ROCM_SMI_DISCOVERY_CACHE_H_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rocm_smi/rocm_smi_common.h"
+
+namespace amd {
+namespace smi {
+
+// Default location of the discovery cache (under the RSMI_FS_ROOT, if set).
+// RSMI_DISCOVERY_CACHE_PATH overrides it in test builds only.
+constexpr char kDefaultDiscoveryCachePath[] = "/run/amdsmi/discovery.cache";
+
+// (hwmon file index, sensor type) pairs of a temperature or voltage label map
+typedef std::vector<std::pair<uint64_t, uint32_t>> SensorLabelList;
+
+// The facts about a device that do not change until the next reboot or
+// amdgpu reload, and that otherwise take a sysfs walk to find.
+struct DiscoveryRecord {
+  uint64_t bdfid = 0;
+  std::string dev_path;
+  std::string hwmon_path;  // Empty if the device has no amdgpu hwmon
+  SensorLabelList temp_labels;
+  SensorLabelList volt_labels;
+  std::vector<uint32_t> event_groups;
+  SupportedFuncMap supported_funcs;
+};
+
+// Cache of DiscoveryRecords in a small binary file. The file is only used if
+// its key matches the current boot, amdgpu module and device list (see
+// MakeKey()); anything else (missing, stale, truncated) is a miss.
+class DiscoveryCache {
+ public:
+    explicit DiscoveryCache(std::string path) : path_(std::move(path)) {}
+    const std::string& path(void) const {return path_;}
+
+    // Builds the cache key from the boot id, the amdgpu module version, the
+    // effective uid class and the (bdfid, device path) of every device.
+    // Returns an empty string if the boot id can't be read.
+    static std::string MakeKey(
+                   const std::vector<std::pair<uint64_t, std::string>> &devs);
+
+    // mmap()s the cache file read-only and decodes it. Returns false on a
+    // miss, leaving *records empty. A file not owned by root or by the
+    // effective user, or writable by group or others, is a miss too.
+    bool Load(const std::string &key, std::vector<DiscoveryRecord> *records);
+
+    // Writes the records to a new mkstemp() file and renames it over the
+    // cache file, so concurrent readers see either the old or the new file.
+    int Store(const std::string &key,
+              const std::vector<DiscoveryRecord> &records);
+
+ private:
+    std::string path_;
+};
+
+}  // namespace smi
+}  // namespace amd
+
+#endif  // INCLUDE_ROCM_SMI_ROCM_SMI_DISCOVERY_CACHE_H_
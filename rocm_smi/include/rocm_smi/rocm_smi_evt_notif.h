@@ -0,0 +1,164 @@
+/*
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+#ifndef INCLUDE_ROCM_SMI_ROCM_SMI_EVT_NOTIF_H_
+#define INCLUDE_ROCM_SMI_ROCM_SMI_EVT_NOTIF_H_
+
+#include <sys/epoll.h>
+
+#include <cstddef>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "rocm_smi/rocm_smi.h"
+
+namespace amd {
+namespace smi {
+
+// Splits the records of a KFD SMI event fd, "<event in hex> <information>\n",
+// out of the bytes read from it. A record cut in two by a read() stays in
+// the buffer until the rest arrives. Nothing is allocated per record.
+class EvtRecordParser {
+ public:
+    static const std::size_t kBufSz = 4096;
+
+    // Where the next read() should go; *len is set to the room left
+    char *space(std::size_t *len);
+    // n bytes were read into space()
+    void commit(std::size_t n) {end_ += n;}
+    // Takes the next complete record; false if there is none. The message
+    // is the rest of the line, truncated to message_sz - 1 characters.
+    bool next(rsmi_evt_notification_type_t *event, char *message,
+              std::size_t message_sz);
+    // True if next() would return a record
+    bool has_record(void) const;
+    void clear(void) {begin_ = end_ = 0; discard_ = false;}
+
+ private:
+    char buf_[kBufSz];
+    std::size_t begin_ = 0;
+    std::size_t end_ = 0;
+    // Dropping the rest of a record that did not fit in the buffer
+    bool discard_ = false;
+};
+
+// Watches the event fds of all the devices with one epoll instance, instead
+// of poll()ing them one by one. Records are handed out either through get()
+// or, once a callback is set, from a dispatch thread. The epoll fd itself
+// can be added to an application's own event loop: it is readable whenever
+// get() has records to return.
+class EvtNotifier {
+ public:
+    EvtNotifier(void) = default;
+    ~EvtNotifier(void);
+    EvtNotifier(const EvtNotifier &) = delete;
+    EvtNotifier &operator=(const EvtNotifier &) = delete;
+
+    // Takes ownership of fd, which is made non-blocking, and closes it on
+    // failure. Returns 0 or an errno.
+    int add(uint32_t dv_ind, int fd);
+    // Stops watching, and closes, the fd of the device. ENOENT if there is
+    // none.
+    int remove(uint32_t dv_ind);
+    // Removes every device and stops the dispatch thread. Wakes up, and
+    // waits for, any get() blocked on the epoll fd before closing it.
+    void reset(void);
+
+    // Writes up to *num_elem records to data. Only waits, for up to
+    // timeout_ms, if no record is ready. EBUSY while a callback is set.
+    int get(int timeout_ms, uint32_t *num_elem,
+            rsmi_evt_notification_data_t *data);
+    // Starts, replaces or (with a nullptr callback) stops the dispatch
+    // thread. EBUSY if called from the callback, which runs on that thread.
+    int set_callback(rsmi_evt_notification_callback_t callback,
+                     void *user_data);
+    // The epoll fd, for the application's event loop
+    int fd(int *fd);
+
+ private:
+    struct Source {
+      int fd = -1;
+      // The writer went away; the fd is no longer in the epoll set
+      bool hung_up = false;
+      EvtRecordParser parser;
+    };
+    int init_locked(void);
+    uint32_t collect_locked(const struct epoll_event *events, int num_events,
+                            uint32_t num_elem,
+                            rsmi_evt_notification_data_t *data);
+    uint32_t read_source_locked(uint32_t dv_ind, Source *src,
+                                uint32_t num_elem,
+                                rsmi_evt_notification_data_t *data);
+    void update_pending_locked(void);
+    void stop_dispatch(void);
+    void dispatch(void);
+
+    std::mutex mutex_;
+    int epoll_fd_ = -1;
+    // In the epoll set; written by reset() to wake up get() callers
+    int shutdown_fd_ = -1;
+    // get() callers waiting on epoll_fd_ without the lock. reset() does not
+    // close the fd, whose number could then be reused, until there is none.
+    uint32_t waiters_ = 0;
+    std::condition_variable waiters_cv_;
+    // Set while parsed records are waiting in a Source, which the epoll fd
+    // would otherwise not report
+    int pending_fd_ = -1;
+    bool pending_ = false;
+    std::map<uint32_t, std::unique_ptr<Source>> sources_;
+
+    rsmi_evt_notification_callback_t callback_ = nullptr;
+    void *user_data_ = nullptr;
+    int stop_fd_ = -1;
+    std::thread dispatch_thread_;
+    // Kept until the thread is joined, unlike dispatch_thread_.get_id()
+    std::thread::id dispatch_id_;
+};
+
+}  // namespace smi
+}  // namespace amd
+
+#endif  // INCLUDE_ROCM_SMI_ROCM_SMI_EVT_NOTIF_H_
@@ -52,6 +52,7 @@
 #include <cassert>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <string>
 #include <map>
 #include <memory>
@@ -791,6 +792,31 @@ enum class AMDGpuMetricsUnitType_t : AMDGpuMetricTypeId_t
   kMetricPcieLCPerfOtherEndRecov,            // v1.6
 };
 using AMDGpuMetricsUnitTypeTranslationTbl_t = std::map<AMDGpuMetricsUnitType_t, std::string>;
+constexpr AMDGpuMetricTypeId_t kRSMI_GPU_METRICS_NUM_UNIT_TYPES =
+  static_cast<AMDGpuMetricTypeId_t>(AMDGpuMetricsUnitType_t::kMetricPcieLCPerfOtherEndRecov) + 1;
+
+//  Note: Largest number of values a single metric unit has (jpeg_activity)
+constexpr uint16_t kRSMI_MAX_GPU_METRICS_UNIT_VALUES = kRSMI_MAX_JPEG_ENGINES;
+
+/*
+  *
+  * Where a metric unit lives inside the raw gpu_metrics table of a given
+  * version: byte offset, width of each value in bytes and number of values.
+  * Units not present in a version have m_count == 0.
+  *
+  * m_scale is applied when the value is read (ie: firmware_timestamp is
+  * reported in 10ns units by v1.2+ tables).
+  *
+ */
+struct AMDGpuMetricsFieldLocation_t {
+  uint16_t m_offset;
+  uint16_t m_count;
+  uint8_t  m_width;
+  uint8_t  m_scale;
+};
+using AMDGpuMetricsFieldLocationTbl_t =
+  std::array<AMDGpuMetricsFieldLocation_t, kRSMI_GPU_METRICS_NUM_UNIT_TYPES>;
+using GpuMetricUnitValues_t = std::array<uint64_t, kRSMI_MAX_GPU_METRICS_UNIT_VALUES>;
 
 using AMDGpuMetricsDataTypeId_t = uint8_t;
 enum class AMDGpuMetricsDataType_t : AMDGpuMetricsDataTypeId_t
@@ -830,6 +856,12 @@ enum class AMDGpuMetricVersionFlags_t : AMDGpuMetricVersionFlagId_t
 using AMDGpuMetricVersionTranslationTbl_t = std::map<uint16_t, AMDGpuMetricVersionFlags_t>;
 using GpuMetricTypePtr_t = std::shared_ptr<void>;
 
+//  Returns nullptr if the metric unit is not part of the version's table
+const AMDGpuMetricsFieldLocation_t* gpu_metrics_field_location(
+  AMDGpuMetricVersionFlags_t gpu_metric_version, AMDGpuMetricsUnitType_t metric_unit);
+uint64_t gpu_metrics_field_value(const void* raw_metrics_tbl,
+  const AMDGpuMetricsFieldLocation_t& field_location, uint16_t value_idx);
+
 class GpuMetricsBase_t {
  public:
     virtual ~GpuMetricsBase_t() = default;
@@ -837,11 +869,14 @@ class GpuMetricsBase_t {
     virtual GpuMetricTypePtr_t get_metrics_table() = 0;
     virtual void dump_internal_metrics_table() = 0;
     virtual AMDGpuMetricVersionFlags_t get_gpu_metrics_version_used() = 0;
+    // Version specific fixups (ie: unit scaling), applied in place to the
+    // raw table; must run exactly once per read of the metrics table.
+    virtual void run_metric_adjustments() = 0;
     virtual rsmi_status_t populate_metrics_dynamic_tbl() = 0;
     virtual AMGpuMetricsPublicLatestTupl_t copy_internal_to_external_metrics() = 0;
     virtual void set_device_id(uint32_t device_id) { m_device_id = device_id; }
     virtual void set_partition_id(uint32_t partition_id) { m_partition_id = partition_id; }
-    virtual AMDGpuDynamicMetricsTbl_t get_metrics_dynamic_tbl() {
+    virtual const AMDGpuDynamicMetricsTbl_t& get_metrics_dynamic_tbl() {
       return m_metrics_dynamic_tbl;
     }
 
@@ -853,7 +888,8 @@ class GpuMetricsBase_t {
 
 };
 using GpuMetricsBasePtr = std::shared_ptr<GpuMetricsBase_t>;
-using AMDGpuMetricFactories_t = const std::map<AMDGpuMetricVersionFlags_t, GpuMetricsBasePtr>;
+using AMDGpuMetricFactories_t = const std::map<AMDGpuMetricVersionFlags_t,
+                                               std::function<GpuMetricsBasePtr()>>;
 
 
 class GpuMetricsBase_v11_t final : public GpuMetricsBase_t {
@@ -880,6 +916,7 @@ class GpuMetricsBase_v11_t final : public GpuMetricsBase_t {
       return AMDGpuMetricVersionFlags_t::kGpuMetricV11;
     }
 
+    void run_metric_adjustments() override;
     rsmi_status_t populate_metrics_dynamic_tbl() override;
     AMGpuMetricsPublicLatestTupl_t copy_internal_to_external_metrics() override;
 
@@ -913,6 +950,7 @@ class GpuMetricsBase_v12_t final : public GpuMetricsBase_t {
       return AMDGpuMetricVersionFlags_t::kGpuMetricV12;
     }
 
+    void run_metric_adjustments() override;
     rsmi_status_t populate_metrics_dynamic_tbl() override;
     AMGpuMetricsPublicLatestTupl_t copy_internal_to_external_metrics() override;
 
@@ -943,6 +981,7 @@ class GpuMetricsBase_v13_t final : public GpuMetricsBase_t {
       return AMDGpuMetricVersionFlags_t::kGpuMetricV13;
     }
 
+    void run_metric_adjustments() override;
     rsmi_status_t populate_metrics_dynamic_tbl() override;
     AMGpuMetricsPublicLatestTupl_t copy_internal_to_external_metrics() override;
 
@@ -974,6 +1013,7 @@ class GpuMetricsBase_v14_t final : public GpuMetricsBase_t {
       return AMDGpuMetricVersionFlags_t::kGpuMetricV14;
     }
 
+    void run_metric_adjustments() override;
     rsmi_status_t populate_metrics_dynamic_tbl() override;
     AMGpuMetricsPublicLatestTupl_t copy_internal_to_external_metrics() override;
 
@@ -1005,6 +1045,7 @@ class GpuMetricsBase_v15_t final : public GpuMetricsBase_t {
       return AMDGpuMetricVersionFlags_t::kGpuMetricV15;
     }
 
+    void run_metric_adjustments() override;
     rsmi_status_t populate_metrics_dynamic_tbl() override;
     AMGpuMetricsPublicLatestTupl_t copy_internal_to_external_metrics() override;
 
@@ -1036,6 +1077,7 @@ class GpuMetricsBase_v16_t final : public GpuMetricsBase_t {
     return AMDGpuMetricVersionFlags_t::kGpuMetricV16;
   }
 
+  void run_metric_adjustments() override;
   rsmi_status_t populate_metrics_dynamic_tbl() override;
   AMGpuMetricsPublicLatestTupl_t copy_internal_to_external_metrics() override;
 
@@ -1048,6 +1090,13 @@ template<typename T>
 rsmi_status_t rsmi_dev_gpu_metrics_info_query(uint32_t dv_ind,
                         AMDGpuMetricsUnitType_t metric_counter, T& metric_value);
 
+class Device;
+
+// rsmi_dev_gpu_metrics_info_get() for callers that already looked up the
+// device dv_ind and hold its lock; no argument checks or logging.
+rsmi_status_t dev_gpu_metrics_info_get(uint32_t dv_ind, Device& dev,
+                                       rsmi_gpu_metrics_t& smu);
+
 }  // namespace amd::smi
 
 
@@ -48,6 +48,7 @@
 #include <unordered_set>
 #include <memory>
 #include <map>
+#include <mutex>  // NOLINT
 
 #include "rocm_smi/rocm_smi.h"
 #include "rocm_smi/rocm_smi_device.h"
@@ -61,17 +62,20 @@ class KFDNode {
     explicit KFDNode(uint32_t node_ind) : node_indx_(node_ind) {}
     ~KFDNode();
 
-    int Initialize();
+    // With defer_io_links, the io_links of the node are only read by the
+    // first query that needs them
+    int Initialize(bool defer_io_links = false);
     int ReadProperties(void);
+    int ReadIOLinks(void);
     int get_property_value(std::string property, uint64_t *value);
     uint64_t gpu_id(void) const {return gpu_id_;}
     std::string name(void) const {return name_;}
     uint32_t node_index(void) const {return node_indx_;}
-    uint32_t numa_node_number(void) const {return numa_node_number_;}
-    uint64_t numa_node_weight(void) const {return numa_node_weight_;}
+    uint32_t numa_node_number(void) {ReadIOLinks(); return numa_node_number_;}
+    uint64_t numa_node_weight(void) {ReadIOLinks(); return numa_node_weight_;}
     uint64_t xgmi_hive_id(void) const {return xgmi_hive_id_;}
     uint32_t cu_count(void) const {return cu_count_;}
-    IO_LINK_TYPE numa_node_type(void) const {return numa_node_type_;}
+    IO_LINK_TYPE numa_node_type(void) {ReadIOLinks(); return numa_node_type_;}
     int get_io_link_type(uint32_t node_to, IO_LINK_TYPE *type);
     int get_io_link_weight(uint32_t node_to, uint64_t *weight);
     int get_io_link_bandwidth(uint32_t node_to, uint64_t *max_bandwidth,
@@ -114,12 +118,15 @@ class KFDNode {
     std::map<uint32_t, uint64_t> io_link_max_bandwidth_;
     std::map<uint32_t, uint64_t> io_link_min_bandwidth_;
     std::map<uint32_t, std::shared_ptr<IOLink>> io_link_map_;
+    std::once_flag io_links_once_;
+    int io_links_ret_ = 0;
     std::map<std::string, uint64_t> properties_;
     std::shared_ptr<Device> amdgpu_device_;
 };
 
 int
-DiscoverKFDNodes(std::map<uint64_t, std::shared_ptr<KFDNode>> *nodes);
+DiscoverKFDNodes(std::map<uint64_t, std::shared_ptr<KFDNode>> *nodes,
+                 bool defer_io_links = false);
 
 int
 GetProcessInfo(rsmi_process_info_t *procs, uint32_t num_allocated,
@@ -46,6 +46,13 @@
  *
  * Thread Safe logging mechanism. Compatible with G++ (Linux platform)
  *
+ * Messages are not written by the threads logging them: they are pushed
+ * into a bounded lock-free queue, and a background thread formats and
+ * writes them in batches. When the queue is full, messages are dropped and
+ * counted (see getDroppedLogCount()). RSMI_LOGGING_QUEUE_SIZE sets the
+ * size of the queue, and RSMI_LOGGING_JSON=1 writes JSON lines instead of
+ * text.
+ *
  * Supported Log Type: ERROR, ALARM, ALWAYS, INFO, BUFFER, TRACE, DEBUG
  * No control for ERROR, ALRAM and ALWAYS messages. These type of messages
  * should be always captured -- IF logging is enabled.
@@ -63,12 +70,16 @@
 #define _ROCM_SMI_LOGGER_H_
 
 // C++ Header File(s)
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <mutex>
 
+#include <sys/types.h>
+
 // POSIX Socket Header File(s)
 #include <errno.h>
 
@@ -76,14 +87,75 @@
 
 
 namespace ROCmLogging {
-// Direct Interface for logging into log file or console using MACRO(s)
-#define LOG_ERROR(x) (ROCmLogging::Logger::getInstance()->error(x))
-#define LOG_ALARM(x) (ROCmLogging::Logger::getInstance()->alarm(x))
-#define LOG_ALWAYS(x) (ROCmLogging::Logger::getInstance()->always(x))
-#define LOG_INFO(x) (ROCmLogging::Logger::getInstance()->info(x))
+// Cheap checks of whether a message of a level would be logged. The
+// LOG_<LEVEL>_S() macros below use them to skip building a message:
+//   LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << ...);
+// Building with RSMI_DISABLE_DEBUG_LOGS (cmake -DENABLE_DEBUG_LOGS=OFF)
+// compiles TRACE and DEBUG messages out altogether.
+#define LOG_LEVEL_ON(level) \
+  (ROCmLogging::Logger::getInstance()->isLogLevelOn(level))
+#define LOG_ERROR_ON() LOG_LEVEL_ON(ROCmLogging::DISABLE_LOG)
+#define LOG_ALARM_ON() LOG_LEVEL_ON(ROCmLogging::DISABLE_LOG)
+#define LOG_ALWAYS_ON() LOG_LEVEL_ON(ROCmLogging::DISABLE_LOG)
+#define LOG_INFO_ON() LOG_LEVEL_ON(ROCmLogging::LOG_LEVEL_INFO)
+#ifdef RSMI_DISABLE_DEBUG_LOGS
+#define LOG_TRACE_ON() (false)
+#define LOG_DEBUG_ON() (false)
+#else
+#define LOG_TRACE_ON() LOG_LEVEL_ON(ROCmLogging::LOG_LEVEL_TRACE)
+#define LOG_DEBUG_ON() LOG_LEVEL_ON(ROCmLogging::LOG_LEVEL_DEBUG)
+#endif
+
+// Direct Interface for logging into log file or console using MACRO(s).
+// A message that is not logged is still cleared from its stream, so that
+// call sites reusing one std::ostringstream don't pile up text.
+#define LOG_ERROR(x) do { if (LOG_ERROR_ON()) { \
+  ROCmLogging::Logger::getInstance()->error(x); } \
+  else { ROCmLogging::discardLogMessage(x); } } while (0)
+#define LOG_ALARM(x) do { if (LOG_ALARM_ON()) { \
+  ROCmLogging::Logger::getInstance()->alarm(x); } \
+  else { ROCmLogging::discardLogMessage(x); } } while (0)
+#define LOG_ALWAYS(x) do { if (LOG_ALWAYS_ON()) { \
+  ROCmLogging::Logger::getInstance()->always(x); } \
+  else { ROCmLogging::discardLogMessage(x); } } while (0)
+#define LOG_INFO(x) do { if (LOG_INFO_ON()) { \
+  ROCmLogging::Logger::getInstance()->info(x); } \
+  else { ROCmLogging::discardLogMessage(x); } } while (0)
 #define LOG_BUFFER(x) (ROCmLogging::Logger::getInstance()->buffer(x))
-#define LOG_TRACE(x) (ROCmLogging::Logger::getInstance()->trace(x))
-#define LOG_DEBUG(x) (ROCmLogging::Logger::getInstance()->debug(x))
+#define LOG_TRACE(x) do { if (LOG_TRACE_ON()) { \
+  ROCmLogging::Logger::getInstance()->trace(x); } \
+  else { ROCmLogging::discardLogMessage(x); } } while (0)
+#define LOG_DEBUG(x) do { if (LOG_DEBUG_ON()) { \
+  ROCmLogging::Logger::getInstance()->debug(x); } \
+  else { ROCmLogging::discardLogMessage(x); } } while (0)
+
+// Stream interface: x is an expression writing to an std::ostringstream,
+// e.g. ss << "value " << v. It is only evaluated if the level is on.
+#define LOG_ERROR_S(x) do { if (LOG_ERROR_ON()) { \
+  ROCmLogging::Logger::getInstance()->error( \
+      static_cast<std::ostringstream&>(x)); } } while (0)
+#define LOG_ALARM_S(x) do { if (LOG_ALARM_ON()) { \
+  ROCmLogging::Logger::getInstance()->alarm( \
+      static_cast<std::ostringstream&>(x)); } } while (0)
+#define LOG_ALWAYS_S(x) do { if (LOG_ALWAYS_ON()) { \
+  ROCmLogging::Logger::getInstance()->always( \
+      static_cast<std::ostringstream&>(x)); } } while (0)
+#define LOG_INFO_S(x) do { if (LOG_INFO_ON()) { \
+  ROCmLogging::Logger::getInstance()->info( \
+      static_cast<std::ostringstream&>(x)); } } while (0)
+#define LOG_TRACE_S(x) do { if (LOG_TRACE_ON()) { \
+  ROCmLogging::Logger::getInstance()->trace( \
+      static_cast<std::ostringstream&>(x)); } } while (0)
+#define LOG_DEBUG_S(x) do { if (LOG_DEBUG_ON()) { \
+  ROCmLogging::Logger::getInstance()->debug( \
+      static_cast<std::ostringstream&>(x)); } } while (0)
+
+inline void discardLogMessage(std::ostringstream& stream) {
+  stream.str("");
+  stream.clear();
+}
+inline void discardLogMessage(const std::string&) {}
+inline void discardLogMessage(const char*) {}
 
 // enum for LOG_LEVEL
 typedef enum LOG_LEVEL {
@@ -103,9 +175,12 @@ typedef enum LOG_TYPE {
   BOTH_FILE_AND_CONSOLE = 4
 } LogType;
 
+class AsyncLogWriter;
+
 class Logger {
  public:
   static Logger* getInstance() throw();
+  static bool hasInstance() { return m_Instance != nullptr; }
 
   Logger& operator<<(std::string &s) {
     switch (this->m_LogLevel) {
@@ -192,6 +267,21 @@ class Logger {
   void enableFileLogging();
   std::string getLogSettings();
   bool isLoggerEnabled();
+  // Number of messages dropped because the log queue was full
+  uint64_t getDroppedLogCount();
+  // Returns once all the messages logged so far are written
+  void flush();
+  // Start/stop the thread that writes the messages. Once it is stopped,
+  // messages are written by the thread logging them. rsmi_init() starts it
+  // and the last rsmi_shut_down() stops it.
+  void startWriter();
+  void stopWriter();
+
+  // True if a message of logLevel would be logged. ERROR, ALARM and ALWAYS
+  // messages only need logging to be on (DISABLE_LOG).
+  bool isLogLevelOn(LogLevel logLevel) const {
+    return m_activeLogLevel.load(std::memory_order_relaxed) >= logLevel;
+  }
 
  protected:
   Logger();
@@ -210,11 +300,23 @@ class Logger {
   bool m_loggingIsOn = false;
   LogLevel m_LogLevel;
   LogType m_LogType;
+  // Highest level logged, 0 if nothing is; kept in step with the above
+  std::atomic<int> m_activeLogLevel{0};
   std::mutex m_Mutex;
   std::unique_lock<std::mutex> m_Lock{m_Mutex, std::defer_lock};
 
+  // Written by the background thread; only the fallback for a forked
+  // child (which has no such thread) writes on the caller's thread
+  std::atomic<AsyncLogWriter*> m_Writer{nullptr};
+  // Threads pushing to m_Writer; stopWriter() waits for them
+  std::atomic<uint32_t> m_WriterUsers{0};
+  std::mutex m_WriterMutex;
+  pid_t m_WriterPid = 0;
+
+  void logMessage(const char* level, const char* text, LogLevel minLevel);
   void logIntoFile(std::string& data);
   void logOnConsole(std::string& data);
+  void updateActiveLogLevel();
   void operator=(const Logger&) {}
   void initialize_resources();
   void destroy_resources();
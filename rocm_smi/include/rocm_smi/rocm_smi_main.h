@@ -54,11 +54,13 @@
 #include <unordered_map>
 #include <map>
 #include <mutex>  // NOLINT
+#include <atomic>
 #include <utility>
 
 #include "rocm_smi/rocm_smi_io_link.h"
 #include "rocm_smi/rocm_smi_kfd.h"
 #include "rocm_smi/rocm_smi_device.h"
+#include "rocm_smi/rocm_smi_evt_notif.h"
 #include "rocm_smi/rocm_smi_monitor.h"
 #include "rocm_smi/rocm_smi_power_mon.h"
 #include "rocm_smi/rocm_smi_common.h"
@@ -91,6 +93,12 @@ class RocmSMI {
     uint64_t is_thread_only_mutex() const {
       return init_options_ & RSMI_INIT_FLAG_THRAD_ONLY_MUTEX;
     }
+    // RSMI_INIT_FLAG_LAZY or RSMI_LAZY_INIT: per-device state is discovered
+    // on first use instead of in Initialize()
+    bool lazy_init() const {return lazy_init_;}
+    // RSMI_INIT_FLAG_LOCKLESS_READS or RSMI_LOCKLESS_READS: plain sysfs
+    // getters skip the device lock
+    bool lockless_reads() const {return lockless_reads_;}
 
     uint32_t euid() const {return euid_;}
 
@@ -112,8 +120,13 @@ class RocmSMI {
                                            return ++kfd_notif_evt_fh_refcnt_;}
     uint32_t kfd_notif_evt_fh_refcnt_dec(void) {
                                            return --kfd_notif_evt_fh_refcnt_;}
+    // The event fds of all the devices, see rsmi_event_notification_init()
+    EvtNotifier &evt_notifier(void) {return evt_notifier_;}
     int get_io_link_weight(uint32_t node_from, uint32_t node_to,
                            uint64_t *weight);
+    // Records the boot partition state of every device, once, before the
+    // first partition change
+    void StoreBootPartitions(void);
     int get_node_index(uint32_t dv_ind, uint32_t *node_ind);
     const RocmSMI_env_vars& getEnv(void);
     std::string getRSMIEnvVarInfo(void);
@@ -129,7 +142,17 @@ class RocmSMI {
     std::set<std::string> amd_monitor_types_;
     std::map<std::pair<uint32_t, uint32_t>, std::shared_ptr<IOLink>>
       io_link_map_;
+    bool io_links_discovered_;  // Access to io_link_map_ and this should be
+                                // protected by io_link_map_mutex_
+    std::mutex io_link_map_mutex_;
     std::map<uint32_t, uint32_t> dev_ind_to_node_ind_map_;
+    std::atomic<bool> boot_partitions_stored_;
+    std::mutex boot_partitions_mutex_;
+    bool lazy_init_;
+    bool discovery_cache_;
+    bool lockless_reads_;
+    int DiscoverIOLinksOnce(void);
+    void ApplyDiscoveryCache(void);
     void AddToDeviceList(std::string dev_name, uint64_t bdfid = 0);
     void GetEnvVariables(void);
     std::shared_ptr<Monitor> FindMonitor(std::string monitor_path);
@@ -142,6 +165,7 @@ class RocmSMI {
     std::mutex kfd_notif_evt_fh_mutex_;
     uint32_t kfd_notif_evt_fh_refcnt_;  // Access to this should be protected
                                         // by kfd_notif_evt_fh_mutex_
+    EvtNotifier evt_notifier_;
     std::mutex bootstrap_mutex_;
     uint32_t ref_count_;  // Access to this should be protected
                           // by bootstrap_mutex_
@@ -50,6 +50,7 @@
 #include <map>
 
 #include "rocm_smi/rocm_smi_common.h"
+#include "rocm_smi/rocm_smi_discovery_cache.h"
 #include "rocm_smi/rocm_smi.h"
 
 namespace amd {
@@ -151,6 +152,10 @@ class Monitor {
     uint32_t getVoltSensorIndex(rsmi_voltage_type_t type);
     rsmi_voltage_type_t getVoltSensorEnum(uint64_t ind);
     void fillSupportedFuncs(SupportedFuncMap *supported_funcs);
+    // Label maps as saved in, and restored from, the discovery cache
+    void getSensorLabelMaps(SensorLabelList *temp, SensorLabelList *volt) const;
+    void restoreSensorLabelMaps(const SensorLabelList &temp,
+                                const SensorLabelList &volt);
 
  private:
     std::string MakeMonitorPath(MonitorTypes type, uint32_t sensor_id);
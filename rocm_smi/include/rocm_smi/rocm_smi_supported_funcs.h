@@ -0,0 +1,163 @@
+/*
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+#ifndef INCLUDE_ROCM_SMI_ROCM_SMI_SUPPORTED_FUNCS_H_
+#define INCLUDE_ROCM_SMI_ROCM_SMI_SUPPORTED_FUNCS_H_
+
+#include <cstdint>
+
+namespace amd {
+namespace smi {
+
+// Groups of support probes that are run together, the first time a function
+// of the group is checked
+enum SupportFamily {
+  kSupportFamilyDevice = 0,  // amdgpu sysfs/debugfs files of the device
+  kSupportFamilyMonitor,     // hwmon files
+  kSupportFamilyCount
+};
+
+// Every function name used in the support maps, with the probes that decide
+// its support. The position in this list is the function id, which is also
+// the bit index reported by rsmi_dev_supported_func_bitmap_get(); only ever
+// append to it.
+#define RSMI_SUPPORTED_FUNC_LIST(X) \
+  X(rsmi_dev_vram_vendor_get, kSupportFamilyDevice)            \
+  X(rsmi_dev_id_get, kSupportFamilyDevice)                     \
+  X(rsmi_dev_xgmi_physical_id_get, kSupportFamilyDevice)       \
+  X(rsmi_dev_revision_get, kSupportFamilyDevice)               \
+  X(rsmi_dev_vendor_id_get, kSupportFamilyDevice)              \
+  X(rsmi_dev_name_get, kSupportFamilyDevice)                   \
+  X(rsmi_dev_sku_get, kSupportFamilyDevice)                    \
+  X(rsmi_dev_pcie_slot_type_get, kSupportFamilyDevice)         \
+  X(rsmi_dev_brand_get, kSupportFamilyDevice)                  \
+  X(rsmi_dev_vendor_name_get, kSupportFamilyDevice)            \
+  X(rsmi_dev_serial_number_get, kSupportFamilyDevice)          \
+  X(rsmi_dev_subsystem_id_get, kSupportFamilyDevice)           \
+  X(rsmi_dev_subsystem_name_get, kSupportFamilyDevice)         \
+  X(rsmi_dev_drm_render_minor_get, kSupportFamilyDevice)       \
+  X(rsmi_dev_subsystem_vendor_id_get, kSupportFamilyDevice)    \
+  X(rsmi_dev_unique_id_get, kSupportFamilyDevice)              \
+  X(rsmi_dev_pci_bandwidth_get, kSupportFamilyDevice)          \
+  X(rsmi_dev_pci_id_get, kSupportFamilyDevice)                 \
+  X(rsmi_dev_pci_throughput_get, kSupportFamilyDevice)         \
+  X(rsmi_dev_pci_replay_counter_get, kSupportFamilyDevice)     \
+  X(rsmi_dev_pci_bandwidth_set, kSupportFamilyDevice)          \
+  X(rsmi_dev_power_profile_set, kSupportFamilyDevice)          \
+  X(rsmi_dev_memory_busy_percent_get, kSupportFamilyDevice)    \
+  X(rsmi_dev_busy_percent_get, kSupportFamilyDevice)           \
+  X(rsmi_dev_memory_reserved_pages_get, kSupportFamilyDevice)  \
+  X(rsmi_dev_overdrive_level_get, kSupportFamilyDevice)        \
+  X(rsmi_dev_mem_overdrive_level_get, kSupportFamilyDevice)    \
+  X(rsmi_dev_power_profile_presets_get, kSupportFamilyDevice)  \
+  X(rsmi_dev_perf_level_set, kSupportFamilyDevice)             \
+  X(rsmi_dev_perf_level_set_v1, kSupportFamilyDevice)          \
+  X(rsmi_dev_perf_level_get, kSupportFamilyDevice)             \
+  X(rsmi_dev_soc_pstate_set, kSupportFamilyDevice)             \
+  X(rsmi_dev_soc_pstate_get, kSupportFamilyDevice)             \
+  X(rsmi_dev_xgmi_plpd_set, kSupportFamilyDevice)              \
+  X(rsmi_dev_xgmi_plpd_get, kSupportFamilyDevice)              \
+  X(rsmi_dev_process_isolation_set, kSupportFamilyDevice)      \
+  X(rsmi_dev_process_isolation_get, kSupportFamilyDevice)      \
+  X(rsmi_dev_gpu_shader_clean, kSupportFamilyDevice)           \
+  X(rsmi_perf_determinism_mode_set, kSupportFamilyDevice)      \
+  X(rsmi_dev_overdrive_level_set, kSupportFamilyDevice)        \
+  X(rsmi_dev_vbios_version_get, kSupportFamilyDevice)          \
+  X(rsmi_dev_od_volt_info_get, kSupportFamilyDevice)           \
+  X(rsmi_dev_od_volt_info_set, kSupportFamilyDevice)           \
+  X(rsmi_dev_od_volt_curve_regions_get, kSupportFamilyDevice)  \
+  X(rsmi_dev_ecc_enabled_get, kSupportFamilyDevice)            \
+  X(rsmi_dev_ecc_status_get, kSupportFamilyDevice)             \
+  X(rsmi_ras_feature_info_get, kSupportFamilyDevice)           \
+  X(rsmi_dev_counter_group_supported, kSupportFamilyDevice)    \
+  X(rsmi_dev_counter_create, kSupportFamilyDevice)             \
+  X(rsmi_dev_counter_group_create, kSupportFamilyDevice)       \
+  X(rsmi_dev_xgmi_error_status, kSupportFamilyDevice)          \
+  X(rsmi_dev_xgmi_error_reset, kSupportFamilyDevice)           \
+  X(rsmi_topo_numa_affinity_get, kSupportFamilyDevice)         \
+  X(rsmi_dev_gpu_metrics_info_get, kSupportFamilyDevice)       \
+  X(rsmi_dev_pm_metrics_info_get, kSupportFamilyDevice)        \
+  X(rsmi_dev_reg_table_info_get, kSupportFamilyDevice)         \
+  X(rsmi_dev_gpu_reset, kSupportFamilyDevice)                  \
+  X(rsmi_dev_compute_partition_get, kSupportFamilyDevice)      \
+  X(rsmi_dev_compute_partition_set, kSupportFamilyDevice)      \
+  X(rsmi_dev_memory_partition_get, kSupportFamilyDevice)       \
+  X(rsmi_dev_memory_partition_set, kSupportFamilyDevice)       \
+  X(rsmi_dev_memory_total_get, kSupportFamilyDevice)           \
+  X(rsmi_dev_memory_usage_get, kSupportFamilyDevice)           \
+  X(rsmi_dev_gpu_clk_freq_get, kSupportFamilyDevice)           \
+  X(rsmi_dev_gpu_clk_freq_set, kSupportFamilyDevice)           \
+  X(rsmi_dev_firmware_version_get, kSupportFamilyDevice)       \
+  X(rsmi_dev_ecc_count_get, kSupportFamilyDevice)              \
+  X(rsmi_counter_available_counters_get, kSupportFamilyDevice) \
+  X(rsmi_dev_power_ave_get, kSupportFamilyMonitor)             \
+  X(rsmi_dev_power_cap_get, kSupportFamilyMonitor)             \
+  X(rsmi_dev_power_cap_default_get, kSupportFamilyMonitor)     \
+  X(rsmi_dev_power_cap_range_get, kSupportFamilyMonitor)       \
+  X(rsmi_dev_power_cap_set, kSupportFamilyMonitor)             \
+  X(rsmi_dev_fan_rpms_get, kSupportFamilyMonitor)              \
+  X(rsmi_dev_fan_speed_get, kSupportFamilyMonitor)             \
+  X(rsmi_dev_fan_speed_max_get, kSupportFamilyMonitor)         \
+  X(rsmi_dev_temp_metric_get, kSupportFamilyMonitor)           \
+  X(rsmi_dev_fan_reset, kSupportFamilyMonitor)                 \
+  X(rsmi_dev_fan_speed_set, kSupportFamilyMonitor)             \
+  X(rsmi_dev_volt_metric_get, kSupportFamilyMonitor)
+
+enum SupportedFuncId : uint32_t {
+#define RSMI_SUPPORTED_FUNC_ID(name, family) kSupportedFunc_##name,
+  RSMI_SUPPORTED_FUNC_LIST(RSMI_SUPPORTED_FUNC_ID)
+#undef RSMI_SUPPORTED_FUNC_ID
+  kSupportedFuncCount,
+  kSupportedFuncInvalid = kSupportedFuncCount
+};
+
+static const uint32_t kSupportedFuncWords = (kSupportedFuncCount + 63) / 64;
+
+// Returns kSupportedFuncInvalid for names that aren't in the list
+SupportedFuncId SupportedFuncIdFromName(const char *name);
+const char *SupportedFuncName(SupportedFuncId id);
+SupportFamily SupportedFuncFamily(SupportedFuncId id);
+
+}  // namespace smi
+}  // namespace amd
+
+#endif  // INCLUDE_ROCM_SMI_ROCM_SMI_SUPPORTED_FUNCS_H_
@@ -78,8 +78,15 @@ namespace amd {
 namespace smi {
 
 pthread_mutex_t *GetMutex(uint32_t dv_ind);
+shared_rwlock_t *GetRWLock(uint32_t dv_ind);
 int SameFile(const std::string fileA, const std::string fileB);
 bool FileExists(char const *filename);
+// Prefix for every sysfs, procfs and /dev path the library touches, taken
+// from RSMI_FS_ROOT once per process; empty on a real system. Lets the
+// library run against a synthetic tree (see tools/fake_sysfs_tree.py).
+// Only DEBUG (non-Release) and -DENABLE_TEST_OVERRIDES=ON builds read it.
+const std::string& FsRoot(void);
+std::string FsPath(const std::string& path);
 std::vector<std::string> globFilesExist(const std::string& filePattern);
 int isRegularFile(std::string fname, bool *is_reg);
 int isReadOnlyForAll(const std::string& fname, bool *is_read_only);
@@ -230,6 +237,38 @@ struct ScopedPthread {
      bool mutex_not_acquired_;  // Use for AcquireNB (not for Aquire())
 };
 
+enum DeviceLockMode {
+  kDeviceLockNone,       // Don't lock (lockless sysfs reads)
+  kDeviceLockShared,     // Getters
+  kDeviceLockExclusive,  // Setters, resets, partition changes
+};
+
+// Holds a device lock for its scope. Shared holders take the device rwlock
+// for reading. Exclusive holders take it for writing, which holds the
+// device mutex that older versions of the library use for every call.
+//
+// A thread that already holds the lock of the device doesn't lock it
+// again, so rsmi calls can still be nested. The rwlock can't be upgraded:
+// an exclusive request nested in a shared hold is refused with
+// RSMI_STATUS_INTERNAL_EXCEPTION instead of deadlocking, so getters must
+// not call setters.
+struct ScopedDeviceLock {
+     ScopedDeviceLock(shared_rwlock_t *rwlock, DeviceLockMode mode,
+                      bool blocking = true);
+     ~ScopedDeviceLock();
+
+     // RSMI_STATUS_BUSY if the lock is held elsewhere (non-blocking attempt,
+     // or live readers outlasting RSMI_MUTEX_TIMEOUT)
+     rsmi_status_t status() const {return status_;}
+     bool lock_not_acquired() const {return status_ != RSMI_STATUS_SUCCESS;}
+
+ private:
+     ScopedDeviceLock(const ScopedDeviceLock&);
+     shared_rwlock_t *rwlock_;
+     bool held_;                // This object counts as one hold of rwlock_
+     rsmi_status_t status_;
+};
+
 
 #define PASTE2(x, y) x##y
 #define PASTE(x, y) PASTE2(x, y)
@@ -42,7 +42,6 @@
  */
 
 #include <fcntl.h>
-#include <poll.h>
 #include <pthread.h>
 #include <cstddef>
 #include <string>
@@ -109,14 +108,6 @@ static const std::map<rsmi_clk_type_t, amd::smi::DevInfoTypes> kClkTypeMap = {
 #define TRY try {
 #define CATCH } catch (...) {return amd::smi::handleException();}
 
-// declare pm metrics and register table function
-namespace amd::smi {
-int present_pmmetrics(const char* sysfs_file_name,
-        rsmi_name_value_t **kv, uint32_t *kvnum);
-int present_reg_state(const char* fname, rsmi_reg_type_t reg_type,
-        rsmi_name_value_t **kv, uint32_t *kvnum);
-}
-
 static uint64_t get_multiplier_from_str(char units_char) {
   uint32_t multiplier = 0;
 
@@ -150,8 +141,11 @@ static uint64_t get_multiplier_from_str(char units_char) {
 /**
  * Parse a string of the form:
  *        "<int index>:  <int freq><freq. unit string> <|*>"
+ *
+ * Not static, so that tests/amd_smi_bench can time it directly.
  */
-static uint64_t freq_string_to_int(const std::vector<std::string> &freq_lines,
+namespace amd::smi {
+uint64_t freq_string_to_int(const std::vector<std::string> &freq_lines,
                                 bool *is_curr, uint32_t lanes[], uint32_t i) {
   assert(i < freq_lines.size());
   if (i >= freq_lines.size()) {
@@ -206,6 +200,8 @@ static uint64_t freq_string_to_int(const std::vector<std::string> &freq_lines,
   }
   return static_cast<uint64_t>(freq*multiplier);
 }
+}  // namespace amd::smi
+using amd::smi::freq_string_to_int;
 
 static void freq_volt_string_to_point(std::string in_line,
                                                      rsmi_od_vddc_point_t *pt) {
@@ -545,7 +541,7 @@ rsmi_status_t rsmi_driver_status(rsmi_driver_state_t* state) {
 
   // live, coming, going
   static const char *kDevInitStateID = "/sys/module/amdgpu/initstate";
-  std::ifstream infile(kDevInitStateID);
+  std::ifstream infile(amd::smi::FsPath(kDevInitStateID));
   if (!infile) {
     *state = RSMI_DRIVER_NOT_FOUND;
     return RSMI_STATUS_SUCCESS;
@@ -582,43 +578,20 @@ rsmi_status_t rsmi_dev_ecc_enabled_get(uint32_t dv_ind,
                                                     uint64_t *enabled_blks) {
   TRY
   rsmi_status_t ret;
-  std::string feature_line;
-  std::string tmp_str;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   CHK_SUPPORT_NAME_ONLY(enabled_blks)
 
-  DEVICE_MUTEX
-
-  ret = get_dev_value_line(amd::smi::kDevErrCntFeatures, dv_ind, &feature_line);
-  if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
-       << ", returning get_dev_value_line() response = "
-       << amd::smi::getRSMIStatusString(ret);
-    LOG_ERROR(ss);
-    return ret;
-  }
-
-  std::istringstream fs1(feature_line);
-
-  fs1 >> tmp_str;  // ignore
-  assert(tmp_str == "feature");
-  fs1 >> tmp_str;  // ignore
-  assert(tmp_str == "mask:");
-  fs1 >> tmp_str;
-
-  errno = 0;
-  *enabled_blks = strtoul(tmp_str.c_str(), nullptr, 16);
-  assert(errno == 0);
-
-  ss << __PRETTY_FUNCTION__ << " | ======= end ======="
-     << ", returning strtoul() response = "
-     << amd::smi::getRSMIStatusString(amd::smi::ErrnoToRsmiStatus(errno));
-  LOG_TRACE(ss);
+  // Cached for a short time; the re-read is serialized by the
+  // device itself, so no device lock is needed here
+  int err = dev->ras_features_mask(enabled_blks);
+  ret = amd::smi::ErrnoToRsmiStatus(err);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+     << ", returning ras_features_mask() response = "
+     << amd::smi::getRSMIStatusString(ret));
 
-  return amd::smi::ErrnoToRsmiStatus(errno);
+  return ret;
   CATCH
 }
 
@@ -640,152 +613,158 @@ rsmi_status_t rsmi_dev_ecc_status_get(uint32_t dv_ind, rsmi_gpu_block_t block,
                                                  rsmi_ras_err_state_t *state) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   CHK_SUPPORT_NAME_ONLY(state)
 
   if (!is_power_of_2(block)) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", ret was not power of 2 "
-       << "-> reporting RSMI_STATUS_INVALID_ARGS";
-    LOG_ERROR(ss);
+       << "-> reporting RSMI_STATUS_INVALID_ARGS");
     return RSMI_STATUS_INVALID_ARGS;
   }
   rsmi_status_t ret;
   uint64_t features_mask;
 
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
 
   ret = rsmi_dev_ecc_enabled_get(dv_ind, &features_mask);
 
   if (ret == RSMI_STATUS_FILE_ERROR) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", rsmi_dev_ecc_enabled_get() ret was RSMI_STATUS_FILE_ERROR "
-       << "-> reporting RSMI_STATUS_NOT_SUPPORTED";
-    LOG_ERROR(ss);
+       << "-> reporting RSMI_STATUS_NOT_SUPPORTED");
     return RSMI_STATUS_NOT_SUPPORTED;
   }
   if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", returning rsmi_dev_ecc_enabled_get() response = "
-       << amd::smi::getRSMIStatusString(ret);
-    LOG_ERROR(ss);
+       << amd::smi::getRSMIStatusString(ret));
     return ret;
   }
 
   *state = (features_mask & block) ?
                      RSMI_RAS_ERR_STATE_ENABLED : RSMI_RAS_ERR_STATE_DISABLED;
 
-  ss << __PRETTY_FUNCTION__ << " | ======= end ======="
-     << ", reporting RSMI_STATUS_SUCCESS";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+     << ", reporting RSMI_STATUS_SUCCESS");
   return RSMI_STATUS_SUCCESS;
   CATCH
 }
 
+// The GPU blocks that have a ras/<block>_err_count file
+struct ErrCntBlock {
+  rsmi_gpu_block_t block;
+  amd::smi::DevInfoTypes type;
+};
+static const ErrCntBlock kErrCntBlocks[] = {
+  {RSMI_GPU_BLOCK_UMC, amd::smi::kDevErrCntUMC},
+  {RSMI_GPU_BLOCK_SDMA, amd::smi::kDevErrCntSDMA},
+  {RSMI_GPU_BLOCK_GFX, amd::smi::kDevErrCntGFX},
+  {RSMI_GPU_BLOCK_MMHUB, amd::smi::kDevErrCntMMHUB},
+  {RSMI_GPU_BLOCK_PCIE_BIF, amd::smi::kDevErrCntPCIEBIF},
+  {RSMI_GPU_BLOCK_HDP, amd::smi::kDevErrCntHDP},
+  {RSMI_GPU_BLOCK_XGMI_WAFL, amd::smi::kDevErrCntXGMIWAFL},
+};
+
 rsmi_status_t
 rsmi_dev_ecc_count_get(uint32_t dv_ind, rsmi_gpu_block_t block,
                                                      rsmi_error_count_t *ec) {
-  std::vector<std::string> val_vec;
   rsmi_status_t ret(RSMI_STATUS_NOT_SUPPORTED);
   std::ostringstream ss;
 
   TRY
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_VAR(ec, block)
 
-
-  amd::smi::DevInfoTypes type;
-  switch (block) {
-    case RSMI_GPU_BLOCK_UMC:
-      type = amd::smi::kDevErrCntUMC;
-      break;
-
-    case RSMI_GPU_BLOCK_SDMA:
-      type = amd::smi::kDevErrCntSDMA;
-      break;
-
-    case RSMI_GPU_BLOCK_GFX:
-      type = amd::smi::kDevErrCntGFX;
-      break;
-
-    case RSMI_GPU_BLOCK_MMHUB:
-      type = amd::smi::kDevErrCntMMHUB;
-      break;
-
-    case RSMI_GPU_BLOCK_PCIE_BIF:
-      type = amd::smi::kDevErrCntPCIEBIF;
-      break;
-
-    case RSMI_GPU_BLOCK_HDP:
-      type = amd::smi::kDevErrCntHDP;
-      break;
-
-    case RSMI_GPU_BLOCK_XGMI_WAFL:
-      type = amd::smi::kDevErrCntXGMIWAFL;
-      break;
-
-    default:
-      ss << __PRETTY_FUNCTION__ << " | ======= end ======="
-         << ", default case -> reporting "
-         << amd::smi::getRSMIStatusString(RSMI_STATUS_NOT_SUPPORTED);
-      LOG_ERROR(ss);
-      return RSMI_STATUS_NOT_SUPPORTED;
+  const auto *blk = std::find_if(std::begin(kErrCntBlocks),
+                                 std::end(kErrCntBlocks),
+                                 [block](const ErrCntBlock &b) {
+                                   return b.block == block;
+                                 });
+  if (blk == std::end(kErrCntBlocks)) {
+    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+       << ", default case -> reporting "
+       << amd::smi::getRSMIStatusString(RSMI_STATUS_NOT_SUPPORTED);
+    LOG_ERROR(ss);
+    return RSMI_STATUS_NOT_SUPPORTED;
   }
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
-  ret = GetDevValueVec(type, dv_ind, &val_vec);
-  if (val_vec.size() < 2 ) ret = RSMI_STATUS_FILE_ERROR;
+  ret = amd::smi::ErrnoToRsmiStatus(dev->readErrCount(blk->type, ec));
 
   if (ret == RSMI_STATUS_FILE_ERROR) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
-       << ", GetDevValueVec() ret was RSMI_STATUS_FILE_ERROR "
-       << "-> reporting RSMI_STATUS_NOT_SUPPORTED";
-    LOG_ERROR(ss);
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+       << ", readErrCount() ret was RSMI_STATUS_FILE_ERROR "
+       << "-> reporting RSMI_STATUS_NOT_SUPPORTED");
     return RSMI_STATUS_NOT_SUPPORTED;
   }
   if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
-       << ", GetDevValueVec() ret was not RSMI_STATUS_SUCCESS"
-       << " -> reporting " << amd::smi::getRSMIStatusString(ret);
-    LOG_ERROR(ss);
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+       << ", readErrCount() ret was not RSMI_STATUS_SUCCESS"
+       << " -> reporting " << amd::smi::getRSMIStatusString(ret));
     return ret;
   }
 
-  std::string junk;
-  std::istringstream fs1(val_vec[0]);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+     << ", reporting " << amd::smi::getRSMIStatusString(ret));
+  return ret;
+  CATCH
+}
 
-  fs1 >> junk;
-  assert(junk == "ue:");
-  fs1 >> ec->uncorrectable_err;
+rsmi_status_t
+rsmi_dev_ecc_count_all_get(uint32_t dv_ind, uint32_t *num_blocks,
+                           rsmi_gpu_block_error_count_t *counts) {
+  TRY
+  std::ostringstream ss;
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
+  if (num_blocks == nullptr) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+  GET_DEV_FROM_INDX
 
-  std::istringstream fs2(val_vec[1]);
+  uint64_t enabled_blks = 0;
+  rsmi_status_t ret =
+      amd::smi::ErrnoToRsmiStatus(dev->ras_features_mask(&enabled_blks));
+  if (ret == RSMI_STATUS_FILE_ERROR) {
+    ret = RSMI_STATUS_NOT_SUPPORTED;
+  }
+  if (ret != RSMI_STATUS_SUCCESS) {
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+       << ", ras_features_mask() failed -> reporting "
+       << amd::smi::getRSMIStatusString(ret));
+    return ret;
+  }
 
-  fs2 >> junk;
-  assert(junk == "ce:");
-  fs2 >> ec->correctable_err;
+  // One lock for all the blocks. Blocks that are enabled but have no
+  // counter file are left out, as rsmi_dev_ecc_count_get() reports them
+  // as not supported.
+  DEVICE_SYSFS_READ_MUTEX
 
-  ec->deferred_err = 0;
-  if (val_vec.size() > 2) {
-    std::istringstream fs3(val_vec[2]);
-    fs3 >> junk;
-    if (junk == "de:") {
-      fs3 >> ec->deferred_err;
-    } else {
-      ss << __PRETTY_FUNCTION__
-       << "Trying to get the de count, but got " << junk
-       << " ignore the defer count";
-    LOG_ERROR(ss);
+  uint32_t n = 0;
+  for (const auto &b : kErrCntBlocks) {
+    if (!(enabled_blks & b.block)) {
+      continue;
+    }
+    if (counts != nullptr && n == *num_blocks) {
+      break;
+    }
+    rsmi_error_count_t ec = {};
+    if (dev->readErrCount(b.type, &ec) != 0) {
+      continue;
     }
+    if (counts != nullptr) {
+      counts[n].block = b.block;
+      counts[n].ec = ec;
+    }
+    ++n;
   }
+  *num_blocks = n;
 
-  ss << __PRETTY_FUNCTION__ << " | ======= end ======="
-     << ", reporting " << amd::smi::getRSMIStatusString(ret);
-  LOG_TRACE(ss);
-  return ret;
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+     << ", " << n << " blocks, reporting RSMI_STATUS_SUCCESS");
+  return RSMI_STATUS_SUCCESS;
   CATCH
 }
 
@@ -793,12 +772,11 @@ rsmi_status_t
 rsmi_dev_pci_id_get(uint32_t dv_ind, uint64_t *bdfid) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   GET_DEV_AND_KFDNODE_FROM_INDX
   CHK_API_SUPPORT_ONLY(bdfid, RSMI_DEFAULT_VARIANT, RSMI_DEFAULT_VARIANT)
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   *bdfid = dev->bdfid();
 
@@ -824,16 +802,14 @@ rsmi_dev_pci_id_get(uint32_t dv_ind, uint64_t *bdfid) {
   uint64_t pci_id = *bdfid;
   uint32_t node = UINT32_MAX;
   rsmi_dev_node_id_get(dv_ind, &node);
-  ss << __PRETTY_FUNCTION__ << " | kfd node = "
+  LOG_INFO_S(ss << __PRETTY_FUNCTION__ << " | kfd node = "
   << std::to_string(node) << "\n"
   << " returning pci_id = "
   << std::to_string(pci_id) << " ("
-  << amd::smi::print_int_as_hex(pci_id) << ")";
-  LOG_INFO(ss);
+  << amd::smi::print_int_as_hex(pci_id) << ")");
 
-  ss << __PRETTY_FUNCTION__ << " | ======= end ======="
-     << ", reporting RSMI_STATUS_SUCCESS";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+     << ", reporting RSMI_STATUS_SUCCESS");
   return RSMI_STATUS_SUCCESS;
   CATCH
 }
@@ -845,7 +821,7 @@ rsmi_topo_numa_affinity_get(uint32_t dv_ind, int32_t *numa_node) {
 
   CHK_SUPPORT_NAME_ONLY(numa_node)
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   std::string str_val;
   ret = get_dev_value_str(amd::smi::kDevNumaNode, dv_ind, &str_val);
   *numa_node = std::stoi(str_val, nullptr);
@@ -865,7 +841,7 @@ get_id(uint32_t dv_ind, amd::smi::DevInfoTypes typ, uint16_t *id) {
     return RSMI_STATUS_INVALID_ARGS;
   }
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   rsmi_status_t ret = get_dev_value_str(typ, dv_ind, &val_str);
 
@@ -895,20 +871,18 @@ rsmi_status_t rsmi_ras_feature_info_get(
   std::string feature_line;
   std::string tmp_str;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   CHK_SUPPORT_NAME_ONLY(ras_feature)
 
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
 
   ret = get_dev_value_line(amd::smi::kDevErrTableVersion,
                 dv_ind, &feature_line);
   if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", returning get_dev_value_line() response = "
-       << amd::smi::getRSMIStatusString(ret);
-    LOG_ERROR(ss);
+       << amd::smi::getRSMIStatusString(ret));
     return ret;
   }
 
@@ -930,10 +904,9 @@ rsmi_status_t rsmi_ras_feature_info_get(
   ret = get_dev_value_line(amd::smi::kDevErrRASSchema,
                 dv_ind, &feature_line);
   if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", returning get_dev_value_line() response = "
-       << amd::smi::getRSMIStatusString(ret);
-    LOG_ERROR(ss);
+       << amd::smi::getRSMIStatusString(ret));
     return ret;
   }
   // schema: 0xf
@@ -959,14 +932,12 @@ rsmi_status_t
 rsmi_dev_id_get(uint32_t dv_ind, uint16_t *id) {
   std::ostringstream ss;
   rsmi_status_t ret;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(id)
 
   ret = get_id(dv_ind, amd::smi::kDevDevID, id);
-  ss << __PRETTY_FUNCTION__ << " | ======= end ======="
-     << ", reporting " << amd::smi::getRSMIStatusString(ret);
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+     << ", reporting " << amd::smi::getRSMIStatusString(ret));
   return ret;
 }
 
@@ -974,15 +945,13 @@ rsmi_status_t
 rsmi_dev_xgmi_physical_id_get(uint32_t dv_ind, uint16_t *id) {
   std::ostringstream ss;
   rsmi_status_t ret;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(id)
   *id = std::numeric_limits<uint16_t>::max();
 
   ret = get_id(dv_ind, amd::smi::kDevXGMIPhysicalID, id);
-  ss << __PRETTY_FUNCTION__ << " | ======= end ======="
-     << ", reporting " << amd::smi::getRSMIStatusString(ret);
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+     << ", reporting " << amd::smi::getRSMIStatusString(ret));
   return ret;
 }
 
@@ -990,14 +959,12 @@ rsmi_status_t
 rsmi_dev_revision_get(uint32_t dv_ind, uint16_t *revision) {
   std::ostringstream outss;
   rsmi_status_t ret;
-  outss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(outss);
+  LOG_TRACE_S(outss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(revision)
 
   ret = get_id(dv_ind, amd::smi::kDevDevRevID, revision);
-  outss << __PRETTY_FUNCTION__ << " | ======= end ======="
-     << ", reporting " << amd::smi::getRSMIStatusString(ret);
-  LOG_TRACE(outss);
+  LOG_TRACE_S(outss << __PRETTY_FUNCTION__ << " | ======= end ======="
+     << ", reporting " << amd::smi::getRSMIStatusString(ret));
   return ret;
 }
 
@@ -1006,13 +973,11 @@ rsmi_dev_sku_get(uint32_t dv_ind, uint16_t *id) {
   TRY
   std::ostringstream ss;
   rsmi_status_t ret;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(id)
   ret = get_id(dv_ind, amd::smi::kDevDevProdNum, id);
-  ss << __PRETTY_FUNCTION__ << " | ======= end ======="
-     << ", reporting " << amd::smi::getRSMIStatusString(ret);
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+     << ", reporting " << amd::smi::getRSMIStatusString(ret));
   return ret;
   CATCH
 }
@@ -1020,8 +985,7 @@ rsmi_dev_sku_get(uint32_t dv_ind, uint16_t *id) {
 rsmi_status_t
 rsmi_dev_subsystem_id_get(uint32_t dv_ind, uint16_t *id) {
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(id)
   return get_id(dv_ind, amd::smi::kDevSubSysDevID, id);
 }
@@ -1029,8 +993,7 @@ rsmi_dev_subsystem_id_get(uint32_t dv_ind, uint16_t *id) {
 rsmi_status_t
 rsmi_dev_vendor_id_get(uint32_t dv_ind, uint16_t *id) {
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(id)
   return get_id(dv_ind, amd::smi::kDevVendorID, id);
 }
@@ -1040,10 +1003,9 @@ rsmi_dev_pcie_slot_type_get(uint32_t dv_ind, rsmi_pcie_slot_type_t* type) {
   TRY
 
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(type)
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   std::string value;
   int ret = dev->readDevInfo(amd::smi::kDevBoardInfo, "type", value);
@@ -1061,8 +1023,7 @@ rsmi_dev_pcie_slot_type_get(uint32_t dv_ind, rsmi_pcie_slot_type_t* type) {
 rsmi_status_t
 rsmi_dev_subsystem_vendor_id_get(uint32_t dv_ind, uint16_t *id) {
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(id)
   return get_id(dv_ind, amd::smi::kDevSubSysVendorID, id);
 }
@@ -1072,11 +1033,10 @@ rsmi_dev_perf_level_get(uint32_t dv_ind, rsmi_dev_perf_level_t *perf) {
   TRY
   std::string val_str;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   CHK_SUPPORT_NAME_ONLY(perf)
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   rsmi_status_t ret = get_dev_value_str(amd::smi::kDevPerfLevel, dv_ind,
                                                                     &val_str);
@@ -1103,8 +1063,7 @@ rsmi_perf_determinism_mode_set(uint32_t dv_ind, uint64_t clkvalue) {
   TRY
   DEVICE_MUTEX
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   // Set perf. level to performance determinism so that we can then set the power profile
   rsmi_status_t ret = rsmi_dev_perf_level_set_v1(dv_ind,
@@ -1140,10 +1099,9 @@ rsmi_dev_overdrive_level_get(uint32_t dv_ind, uint32_t *od) {
   TRY
   std::string val_str;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(od)
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   // Bare Metal only feature
   if (amd::smi::is_vm_guest()) {
@@ -1175,10 +1133,9 @@ rsmi_dev_mem_overdrive_level_get(uint32_t dv_ind, uint32_t *od) {
   TRY
   std::string val_str;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(od)
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   rsmi_status_t ret = get_dev_value_str(amd::smi::kDevMemOverDriveLevel, dv_ind,
                                                                     &val_str);
@@ -1203,8 +1160,7 @@ rsmi_dev_mem_overdrive_level_get(uint32_t dv_ind, uint32_t *od) {
 rsmi_status_t
 rsmi_dev_overdrive_level_set(uint32_t dv_ind, uint32_t od) {
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   return rsmi_dev_overdrive_level_set_v1(static_cast<uint32_t>(dv_ind), od);
 }
 
@@ -1212,8 +1168,7 @@ rsmi_status_t
 rsmi_dev_overdrive_level_set_v1(uint32_t dv_ind, uint32_t od) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   REQUIRE_ROOT_ACCESS
 
   if (od > kMaxOverdriveLevel) {
@@ -1233,8 +1188,7 @@ rsmi_dev_overdrive_level_set_v1(uint32_t dv_ind, uint32_t od) {
 rsmi_status_t
 rsmi_dev_perf_level_set(uint32_t dv_ind, rsmi_dev_perf_level_t perf_level) {
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   return rsmi_dev_perf_level_set_v1(dv_ind, perf_level);
 }
 
@@ -1242,8 +1196,7 @@ rsmi_status_t
 rsmi_dev_perf_level_set_v1(uint32_t dv_ind, rsmi_dev_perf_level_t perf_level) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   REQUIRE_ROOT_ACCESS
 
   if (perf_level > RSMI_DEV_PERF_LEVEL_LAST) {
@@ -1554,8 +1507,7 @@ rsmi_status_t rsmi_dev_clk_extremum_set(uint32_t dv_ind, rsmi_freq_ind_t level,
  TRY
   rsmi_status_t ret;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   if (clkType != RSMI_CLK_TYPE_SYS && clkType != RSMI_CLK_TYPE_MEM) {
     return RSMI_STATUS_INVALID_ARGS;
@@ -1606,8 +1558,7 @@ rsmi_status_t rsmi_dev_clk_range_set(uint32_t dv_ind, uint64_t minclkvalue,
   TRY
   rsmi_status_t ret;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   if (minclkvalue >= maxclkvalue) {
     return RSMI_STATUS_INVALID_ARGS;
@@ -1675,8 +1626,7 @@ rsmi_status_t rsmi_dev_od_clk_info_set(uint32_t dv_ind, rsmi_freq_ind_t level,
   TRY
   rsmi_status_t ret;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   std::string sysvalue;
   std::map<rsmi_clk_type_t, std::string> clk_char_map = {
@@ -1727,8 +1677,7 @@ rsmi_status_t rsmi_dev_od_volt_info_set(uint32_t dv_ind, uint32_t vpoint,
   TRY
   rsmi_status_t ret;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   DEVICE_MUTEX
 
@@ -1766,8 +1715,7 @@ rsmi_status_t rsmi_dev_od_volt_info_set(uint32_t dv_ind, uint32_t vpoint,
 static void get_vc_region(const std::vector<std::string>& val_vec, rsmi_freq_volt_region_t& p)
 {
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   //
   amd::smi::TextFileTagContents_t txt_power_dev_od_voltage(val_vec);
@@ -1815,28 +1763,25 @@ static rsmi_status_t get_od_clk_volt_curve_regions(uint32_t dv_ind,
 
   ret = GetDevValueVec(amd::smi::kDevPowerODVoltage, dv_ind, &val_vec);
   if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | Issue: could not retreive kDevPowerODVoltage" << "; returning "
-       << getRSMIStatusString(ret);
-    LOG_ERROR(ss);
+       << getRSMIStatusString(ret));
     return ret;
   }
 
   // This is a work-around to handle systems where kDevPowerODVoltage is not
   // fully supported yet.
   if (val_vec.size() < kMIN_VALID_LINES) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | Issue: val_vec.size() < " << kMIN_VALID_LINES << "; returning "
-       << getRSMIStatusString(RSMI_STATUS_NOT_YET_IMPLEMENTED);
-    LOG_ERROR(ss);
+       << getRSMIStatusString(RSMI_STATUS_NOT_YET_IMPLEMENTED));
     return RSMI_STATUS_NOT_YET_IMPLEMENTED;
   }
 
   uint32_t val_vec_size = static_cast<uint32_t>(val_vec.size());
-  ss << __PRETTY_FUNCTION__
+  LOG_DEBUG_S(ss << __PRETTY_FUNCTION__
      << " | val_vec_size = " << std::dec
-     << val_vec_size;
-  LOG_DEBUG(ss);
+     << val_vec_size);
 
   // Note: No curve entries.
   *num_regions = 0;
@@ -1916,8 +1861,7 @@ rsmi_dev_gpu_clk_freq_get(uint32_t dv_ind, rsmi_clk_type_t clk_type,
   TRY
   amd::smi::DevInfoTypes dev_type;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   CHK_SUPPORT_VAR(f, clk_type)
 
@@ -1928,7 +1872,7 @@ rsmi_dev_gpu_clk_freq_get(uint32_t dv_ind, rsmi_clk_type_t clk_type,
     return RSMI_STATUS_INVALID_ARGS;
   }
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   return get_frequencies(dev_type, clk_type, dv_ind, f);
 
@@ -1940,8 +1884,7 @@ rsmi_dev_firmware_version_get(uint32_t dv_ind, rsmi_fw_block_t block,
                                                        uint64_t *fw_version) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_VAR(fw_version, block)
 
   std::string val_str;
@@ -1980,7 +1923,7 @@ rsmi_dev_firmware_version_get(uint32_t dv_ind, rsmi_fw_block_t block,
     return RSMI_STATUS_INVALID_ARGS;
   }
 
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   return get_dev_value_int(dev_type, dv_ind, fw_version);
   CATCH
 }
@@ -2011,8 +1954,7 @@ rsmi_dev_gpu_clk_freq_set(uint32_t dv_ind,
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
   REQUIRE_ROOT_ACCESS
   DEVICE_MUTEX
 
@@ -2085,9 +2027,8 @@ rsmi_dev_gpu_clk_freq_set(uint32_t dv_ind,
 rsmi_status_t rsmi_dev_process_isolation_get(uint32_t dv_ind,
                              uint32_t* pisolate) {
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start ======= dev_ind:"
-    << dv_ind;
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start ======= dev_ind:"
+    << dv_ind);
   CHK_SUPPORT_NAME_ONLY(pisolate)
 
   // the enforce_isolation sysfs is in this format <partition_id, enable_flag>
@@ -2095,22 +2036,20 @@ rsmi_status_t rsmi_dev_process_isolation_get(uint32_t dv_ind,
   uint32_t partition_id = 0;
   rsmi_dev_partition_id_get(dv_ind, &partition_id);
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   std::string str_val;
   rsmi_status_t ret = get_dev_value_line(amd::smi::kDevProcessIsolation, dv_ind, &str_val);
   if (ret == RSMI_STATUS_FILE_ERROR) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", get_dev_value_str() ret was RSMI_STATUS_FILE_ERROR "
-       << "-> reporting RSMI_STATUS_NOT_SUPPORTED";
-    LOG_ERROR(ss);
+       << "-> reporting RSMI_STATUS_NOT_SUPPORTED");
     return RSMI_STATUS_NOT_SUPPORTED;
   }
   if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", get_dev_value_str() ret was not RSMI_STATUS_SUCCESS"
-       << " -> reporting " << amd::smi::getRSMIStatusString(ret);
-    LOG_ERROR(ss);
+       << " -> reporting " << amd::smi::getRSMIStatusString(ret));
     return ret;
   }
 
@@ -2143,8 +2082,7 @@ rsmi_status_t rsmi_dev_process_isolation_set(uint32_t dv_ind,
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
   REQUIRE_ROOT_ACCESS
   DEVICE_MUTEX
   GET_DEV_FROM_INDX
@@ -2157,17 +2095,15 @@ rsmi_status_t rsmi_dev_process_isolation_set(uint32_t dv_ind,
   std::string str_val;
   rsmi_status_t ret = get_dev_value_line(amd::smi::kDevProcessIsolation, dv_ind, &str_val);
   if (ret == RSMI_STATUS_FILE_ERROR) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", get_dev_value_str() ret was RSMI_STATUS_FILE_ERROR "
-       << "-> reporting RSMI_STATUS_NOT_SUPPORTED";
-    LOG_ERROR(ss);
+       << "-> reporting RSMI_STATUS_NOT_SUPPORTED");
     return RSMI_STATUS_NOT_SUPPORTED;
   }
   if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", get_dev_value_str() ret was not RSMI_STATUS_SUCCESS"
-       << " -> reporting " << amd::smi::getRSMIStatusString(ret);
-    LOG_ERROR(ss);
+       << " -> reporting " << amd::smi::getRSMIStatusString(ret));
     return ret;
   }
 
@@ -2182,11 +2118,10 @@ rsmi_status_t rsmi_dev_process_isolation_set(uint32_t dv_ind,
 
   // (2) Validate the data
   if (partition_status.size() <= partition_id) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
               << ", the sysfs line " << str_val
               << " does not have the partition_id "
-              << partition_id;
-    LOG_ERROR(ss);
+              << partition_id);
     return RSMI_STATUS_UNEXPECTED_DATA;
   }
 
@@ -2208,8 +2143,7 @@ rsmi_status_t rsmi_dev_gpu_run_cleaner_shader(uint32_t dv_ind) {
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
   REQUIRE_ROOT_ACCESS
   DEVICE_MUTEX
   GET_DEV_FROM_INDX
@@ -2239,23 +2173,20 @@ rsmi_dev_xgmi_plpd_get(uint32_t dv_ind,
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
-  DEVICE_MUTEX
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
+  DEVICE_SYSFS_READ_MUTEX
 
   ret = GetDevValueVec(amd::smi::kDevXgmiPlpd, dv_ind, &val_vec);
   if (ret == RSMI_STATUS_FILE_ERROR) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", GetDevValueVec() ret was RSMI_STATUS_FILE_ERROR "
-       << "-> reporting RSMI_STATUS_NOT_SUPPORTED";
-    LOG_ERROR(ss);
+       << "-> reporting RSMI_STATUS_NOT_SUPPORTED");
     return RSMI_STATUS_NOT_SUPPORTED;
   }
   if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", GetDevValueVec() ret was not RSMI_STATUS_SUCCESS"
-       << " -> reporting " << amd::smi::getRSMIStatusString(ret);
-    LOG_ERROR(ss);
+       << " -> reporting " << amd::smi::getRSMIStatusString(ret));
     return ret;
   }
   /*
@@ -2324,8 +2255,7 @@ rsmi_dev_xgmi_plpd_set(uint32_t dv_ind,
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
   REQUIRE_ROOT_ACCESS
   DEVICE_MUTEX
   GET_DEV_FROM_INDX
@@ -2352,23 +2282,20 @@ rsmi_dev_soc_pstate_get(uint32_t dv_ind,
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
-  DEVICE_MUTEX
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
+  DEVICE_SYSFS_READ_MUTEX
 
   ret = GetDevValueVec(amd::smi::kDevSocPstate, dv_ind, &val_vec);
   if (ret == RSMI_STATUS_FILE_ERROR) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", GetDevValueVec() ret was RSMI_STATUS_FILE_ERROR "
-       << "-> reporting RSMI_STATUS_NOT_SUPPORTED";
-    LOG_ERROR(ss);
+       << "-> reporting RSMI_STATUS_NOT_SUPPORTED");
     return RSMI_STATUS_NOT_SUPPORTED;
   }
   if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======="
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======="
        << ", GetDevValueVec() ret was not RSMI_STATUS_SUCCESS"
-       << " -> reporting " << amd::smi::getRSMIStatusString(ret);
-    LOG_ERROR(ss);
+       << " -> reporting " << amd::smi::getRSMIStatusString(ret));
     return ret;
   }
   /*
@@ -2438,8 +2365,7 @@ rsmi_dev_soc_pstate_set(uint32_t dv_ind,
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
   REQUIRE_ROOT_ACCESS
   DEVICE_MUTEX
   GET_DEV_FROM_INDX
@@ -2753,15 +2679,14 @@ rsmi_dev_name_get(uint32_t dv_ind, char *name, size_t len) {
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(name)
 
   if (len == 0) {
     return RSMI_STATUS_INVALID_ARGS;
   }
 
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
 
   ret = get_dev_name_from_file(dv_ind, name, len);
 
@@ -2779,15 +2704,14 @@ rsmi_dev_pcie_vendor_name_get(uint32_t dv_ind, char *name, size_t len) {
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(name)
 
   if (len == 0) {
     return RSMI_STATUS_INVALID_ARGS;
   }
 
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   uint16_t id = 0;
   ret = get_id(dv_ind, amd::smi::kDevPCieVendorID, &id);
   if (ret != RSMI_STATUS_SUCCESS) return ret;
@@ -2806,13 +2730,12 @@ rsmi_status_t
 rsmi_dev_brand_get(uint32_t dv_ind, char *brand, uint32_t len) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(brand)
   if (len == 0) {
     return RSMI_STATUS_INVALID_ARGS;
   }
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
 
   std::map<std::string, std::string> brand_names = {
     {"D05121", "mi25"},
@@ -2855,15 +2778,14 @@ rsmi_status_t
 rsmi_dev_vram_vendor_get(uint32_t dv_ind, char *brand, uint32_t len) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(brand)
 
   if (len == 0) {
     return RSMI_STATUS_INVALID_ARGS;
   }
   std::string val_str;
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   int ret = dev->readDevInfo(amd::smi::kDevVramVendor, &val_str);
 
   if (ret != 0) {
@@ -2888,15 +2810,14 @@ rsmi_dev_subsystem_name_get(uint32_t dv_ind, char *name, size_t len) {
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(name)
 
   if (len == 0) {
     return RSMI_STATUS_INVALID_ARGS;
   }
 
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
 
   ret = get_dev_name_from_id(dv_ind, name, len, NAME_STR_SUBSYS);
   return ret;
@@ -2909,11 +2830,10 @@ rsmi_dev_drm_render_minor_get(uint32_t dv_ind, uint32_t *minor) {
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(minor)
 
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   ret = get_dev_drm_render_minor(dv_ind, minor);
   return ret;
   CATCH
@@ -2925,8 +2845,7 @@ rsmi_dev_vendor_name_get(uint32_t dv_ind, char *name, size_t len) {
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(name)
 
   assert(len > 0);
@@ -2934,7 +2853,7 @@ rsmi_dev_vendor_name_get(uint32_t dv_ind, char *name, size_t len) {
     return RSMI_STATUS_INVALID_ARGS;
   }
 
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   ret = get_dev_name_from_id(dv_ind, name, len, NAME_STR_VENDOR);
   return ret;
   CATCH
@@ -2944,13 +2863,13 @@ rsmi_status_t rsmi_dev_pm_metrics_info_get(uint32_t dv_ind,
                       rsmi_name_value_t** pm_metrics,
                       uint32_t *num_of_metrics) {
   TRY
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   CHK_SUPPORT_NAME_ONLY(num_of_metrics)
   std::string file_path = dev->
           get_sys_file_path_by_type(amd::smi::kDevPmMetrics);
 
-  int ret = amd::smi::present_pmmetrics(
-          file_path.c_str(), pm_metrics, num_of_metrics);
+  int ret = dev->pm_metrics_decoder().read_alloc(
+          file_path, pm_metrics, num_of_metrics);
   if (ret == 0) return RSMI_STATUS_SUCCESS;
   return RSMI_STATUS_NOT_SUPPORTED;
 
@@ -2962,30 +2881,104 @@ rsmi_status_t rsmi_dev_reg_table_info_get(uint32_t dv_ind,
                       rsmi_name_value_t** reg_metrics,
                       uint32_t *num_of_metrics) {
   TRY
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   CHK_SUPPORT_NAME_ONLY(num_of_metrics)
+  amd::smi::MetricsTableDecoder *decoder = dev->reg_state_decoder(reg_type);
+  if (decoder == nullptr) {
+    return RSMI_STATUS_NOT_SUPPORTED;
+  }
   std::string file_path = dev->
           get_sys_file_path_by_type(amd::smi::kDevRegMetrics);
 
-  int ret = amd::smi::present_reg_state(
-          file_path.c_str(), reg_type, reg_metrics, num_of_metrics);
+  int ret = decoder->read_alloc(file_path, reg_metrics, num_of_metrics);
   if (ret == 0) return RSMI_STATUS_SUCCESS;
   return RSMI_STATUS_NOT_SUPPORTED;
 
   CATCH
 }
 
+static rsmi_status_t metrics_table_status(int ret) {
+  if (ret == 0) {
+    return RSMI_STATUS_SUCCESS;
+  }
+  if (ret == ENOSPC) {
+    return RSMI_STATUS_INSUFFICIENT_SIZE;
+  }
+  return RSMI_STATUS_NOT_SUPPORTED;
+}
+
+static rsmi_status_t pm_metrics_read(uint32_t dv_ind,
+                      rsmi_name_value_t *pm_metrics, uint32_t *num_of_metrics,
+                      bool changes_only) {
+  TRY
+  if (num_of_metrics == nullptr) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+  GET_DEV_FROM_INDX
+  DEVICE_SYSFS_READ_MUTEX
+  int ret = dev->pm_metrics_decoder().read(
+          dev->get_sys_file_path_by_type(amd::smi::kDevPmMetrics),
+          pm_metrics, num_of_metrics, changes_only);
+  return metrics_table_status(ret);
+  CATCH
+}
+
+static rsmi_status_t reg_table_read(uint32_t dv_ind, rsmi_reg_type_t reg_type,
+                      rsmi_name_value_t *reg_metrics, uint32_t *num_of_metrics,
+                      bool changes_only) {
+  TRY
+  if (num_of_metrics == nullptr) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+  GET_DEV_FROM_INDX
+  DEVICE_SYSFS_READ_MUTEX
+  amd::smi::MetricsTableDecoder *decoder = dev->reg_state_decoder(reg_type);
+  if (decoder == nullptr) {
+    return RSMI_STATUS_NOT_SUPPORTED;
+  }
+  int ret = decoder->read(
+          dev->get_sys_file_path_by_type(amd::smi::kDevRegMetrics),
+          reg_metrics, num_of_metrics, changes_only);
+  return metrics_table_status(ret);
+  CATCH
+}
+
+rsmi_status_t rsmi_dev_pm_metrics_values_get(uint32_t dv_ind,
+                      rsmi_name_value_t *pm_metrics,
+                      uint32_t *num_of_metrics) {
+  return pm_metrics_read(dv_ind, pm_metrics, num_of_metrics, false);
+}
+
+rsmi_status_t rsmi_dev_pm_metrics_changes_get(uint32_t dv_ind,
+                      rsmi_name_value_t *pm_metrics,
+                      uint32_t *num_of_metrics) {
+  return pm_metrics_read(dv_ind, pm_metrics, num_of_metrics, true);
+}
+
+rsmi_status_t rsmi_dev_reg_table_values_get(uint32_t dv_ind,
+                      rsmi_reg_type_t reg_type,
+                      rsmi_name_value_t *reg_metrics,
+                      uint32_t *num_of_metrics) {
+  return reg_table_read(dv_ind, reg_type, reg_metrics, num_of_metrics, false);
+}
+
+rsmi_status_t rsmi_dev_reg_table_changes_get(uint32_t dv_ind,
+                      rsmi_reg_type_t reg_type,
+                      rsmi_name_value_t *reg_metrics,
+                      uint32_t *num_of_metrics) {
+  return reg_table_read(dv_ind, reg_type, reg_metrics, num_of_metrics, true);
+}
+
 rsmi_status_t
 rsmi_dev_pci_bandwidth_get(uint32_t dv_ind, rsmi_pcie_bandwidth_t *b) {
   rsmi_status_t ret;
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   GET_DEV_AND_KFDNODE_FROM_INDX
   CHK_API_SUPPORT_ONLY((b), RSMI_DEFAULT_VARIANT, RSMI_DEFAULT_VARIANT)
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   ret = get_frequencies(amd::smi::kDevPCIEClk, RSMI_CLK_TYPE_PCIE, dv_ind,
                                         &b->transfer_rate, b->lanes);
   if (ret == RSMI_STATUS_SUCCESS) {
@@ -3059,8 +3052,7 @@ rsmi_dev_pci_bandwidth_set(uint32_t dv_ind, uint64_t bw_bitmask) {
 
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   REQUIRE_ROOT_ACCESS
   DEVICE_MUTEX
   // Bare Metal only feature
@@ -3108,8 +3100,7 @@ rsmi_dev_pci_throughput_get(uint32_t dv_ind, uint64_t *sent,
                                    uint64_t *received, uint64_t *max_pkt_sz) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   rsmi_status_t ret;
   std::string val_str;
 
@@ -3118,7 +3109,7 @@ rsmi_dev_pci_throughput_get(uint32_t dv_ind, uint64_t *sent,
   // get_dev_value_line() tell if this function is supported or not.
   // CHK_SUPPORT_NAME_ONLY(...)
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   ret = get_dev_value_line(amd::smi::kDevPCIEThruPut, dv_ind, &val_str);
 
@@ -3147,8 +3138,7 @@ rsmi_dev_temp_metric_get(uint32_t dv_ind, uint32_t sensor_type,
                        rsmi_temperature_metric_t metric, int64_t *temperature) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   rsmi_status_t ret;
   amd::smi::MonitorTypes mon_type = amd::smi::kMonInvalid;
@@ -3178,15 +3168,14 @@ rsmi_dev_temp_metric_get(uint32_t dv_ind, uint32_t sensor_type,
   }
 
   if (temperature == nullptr) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
        << " | Type: " << monitorTypesToString.at(mon_type)
        << " | Cause: temperature was a null ptr reference"
        << " | Returning = "
-       << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |");
     return RSMI_STATUS_INVALID_ARGS;
   }
 
@@ -3212,7 +3201,7 @@ rsmi_dev_temp_metric_get(uint32_t dv_ind, uint32_t sensor_type,
     rsmi_gpu_metrics_t gpu_metrics;
     ret = rsmi_dev_gpu_metrics_info_get(dv_ind, &gpu_metrics);
     if (ret != RSMI_STATUS_SUCCESS) {
-      ss << __PRETTY_FUNCTION__
+      LOG_ERROR_S(ss << __PRETTY_FUNCTION__
          << " | ======= end ======= "
          << " | Fail "
          << " | Device #: " << dv_ind
@@ -3220,8 +3209,7 @@ rsmi_dev_temp_metric_get(uint32_t dv_ind, uint32_t sensor_type,
          << " | Cause: rsmi_dev_gpu_metrics_info_get returned "
          << getRSMIStatusString(ret)
          << " | Returning = "
-         << getRSMIStatusString(ret) << " |";
-      LOG_ERROR(ss);
+         << getRSMIStatusString(ret) << " |");
       return ret;
     }
 
@@ -3242,46 +3230,43 @@ rsmi_dev_temp_metric_get(uint32_t dv_ind, uint32_t sensor_type,
         return RSMI_STATUS_INVALID_ARGS;
     }
     if (val_ui16 == UINT16_MAX) {
-      ss << __PRETTY_FUNCTION__
+      LOG_ERROR_S(ss << __PRETTY_FUNCTION__
          << " | ======= end ======= "
          << " | Fail "
          << " | Device #: " << dv_ind
          << " | Type: " << monitorTypesToString.at(mon_type)
          << " | Cause: Reached UINT16 max value, overflow"
          << " | Returning = "
-         << getRSMIStatusString(RSMI_STATUS_NOT_SUPPORTED) << " |";
-      LOG_ERROR(ss);
+         << getRSMIStatusString(RSMI_STATUS_NOT_SUPPORTED) << " |");
       return RSMI_STATUS_NOT_SUPPORTED;
     }
 
     *temperature =
       static_cast<int64_t>(val_ui16) * CENTRIGRADE_TO_MILLI_CENTIGRADE;
 
-    ss << __PRETTY_FUNCTION__ << " | ======= end ======= "
+    LOG_INFO_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======= "
        << " | Success "
        << " | Device #: " << dv_ind
        << " | Type: " << monitorTypesToString.at(mon_type)
        << " | Data: " << *temperature
        << " | Returning = "
-       << getRSMIStatusString(RSMI_STATUS_SUCCESS) << " | ";
-    LOG_INFO(ss);
+       << getRSMIStatusString(RSMI_STATUS_SUCCESS) << " | ");
     return RSMI_STATUS_SUCCESS;
   }  // end HBM temperature
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   GET_DEV_FROM_INDX
 
   if (dev->monitor() == nullptr) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
        << " | Type: " << monitorTypesToString.at(mon_type)
        << " | Cause: monitor returned nullptr"
        << " | Returning = "
-       << getRSMIStatusString(RSMI_STATUS_NOT_SUPPORTED) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(RSMI_STATUS_NOT_SUPPORTED) << " |");
     return RSMI_STATUS_NOT_SUPPORTED;
   }
   std::shared_ptr<amd::smi::Monitor> m = dev->monitor();
@@ -3295,15 +3280,14 @@ rsmi_dev_temp_metric_get(uint32_t dv_ind, uint32_t sensor_type,
   CHK_API_SUPPORT_ONLY(temperature, metric, sensor_index)
 
   ret = get_dev_mon_value(mon_type, dv_ind, sensor_index, temperature);
-  ss << __PRETTY_FUNCTION__ << " | ======= end ======= "
+  LOG_INFO_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======= "
      << " | Success "
      << " | Device #: " << dv_ind
      << " | Sensor_index: " << sensor_index
      << " | Type: " << monitorTypesToString.at(mon_type)
      << " | Data: " << *temperature
      << " | Returning = "
-     << getRSMIStatusString(ret) << " | ";
-  LOG_INFO(ss);
+     << getRSMIStatusString(ret) << " | ");
 
   return ret;
   CATCH
@@ -3314,8 +3298,7 @@ rsmi_dev_volt_metric_get(uint32_t dv_ind, rsmi_voltage_type_t sensor_type,
                        rsmi_voltage_metric_t metric, int64_t *voltage) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   rsmi_status_t ret;
   amd::smi::MonitorTypes mon_type;
@@ -3349,7 +3332,7 @@ rsmi_dev_volt_metric_get(uint32_t dv_ind, rsmi_voltage_type_t sensor_type,
       mon_type = amd::smi::kMonInvalid;
   }
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   GET_DEV_FROM_INDX
 
@@ -3379,8 +3362,7 @@ rsmi_status_t
 rsmi_dev_fan_speed_get(uint32_t dv_ind, uint32_t sensor_ind, int64_t *speed) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   rsmi_status_t ret;
 
@@ -3388,7 +3370,7 @@ rsmi_dev_fan_speed_get(uint32_t dv_ind, uint32_t sensor_ind, int64_t *speed) {
 
   CHK_SUPPORT_SUBVAR_ONLY(speed, sensor_ind)
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   ret = get_dev_mon_value(amd::smi::kMonFanSpeed, dv_ind, sensor_ind, speed);
 
@@ -3400,8 +3382,7 @@ rsmi_status_t
 rsmi_dev_fan_rpms_get(uint32_t dv_ind, uint32_t sensor_ind, int64_t *speed) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   ++sensor_ind;  // fan sysfs files have 1-based indices
 
@@ -3409,7 +3390,7 @@ rsmi_dev_fan_rpms_get(uint32_t dv_ind, uint32_t sensor_ind, int64_t *speed) {
 
   rsmi_status_t ret;
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   ret = get_dev_mon_value(amd::smi::kMonFanRPMs, dv_ind, sensor_ind, speed);
 
@@ -3422,8 +3403,7 @@ rsmi_dev_fan_reset(uint32_t dv_ind, uint32_t sensor_ind) {
   TRY
   rsmi_status_t ret;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   ++sensor_ind;  // fan sysfs files have 1-based indices
   REQUIRE_ROOT_ACCESS
@@ -3442,8 +3422,7 @@ rsmi_dev_fan_speed_set(uint32_t dv_ind, uint32_t sensor_ind, uint64_t speed) {
   rsmi_status_t ret;
   uint64_t max_speed;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   REQUIRE_ROOT_ACCESS
   DEVICE_MUTEX
@@ -3485,11 +3464,10 @@ rsmi_dev_fan_speed_max_get(uint32_t dv_ind, uint32_t sensor_ind,
   TRY
   rsmi_status_t ret;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   ++sensor_ind;  // fan sysfs files have 1-based indices
   CHK_SUPPORT_SUBVAR_ONLY(max_speed, sensor_ind)
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   ret = get_dev_mon_value(amd::smi::kMonMaxFanSpeed, dv_ind, sensor_ind,
                                       reinterpret_cast<int64_t *>(max_speed));
@@ -3502,9 +3480,8 @@ rsmi_status_t
 rsmi_dev_od_volt_info_get(uint32_t dv_ind, rsmi_od_volt_freq_data_t *odv) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
-  DEVICE_MUTEX
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
+  DEVICE_SYSFS_READ_MUTEX
   CHK_SUPPORT_NAME_ONLY(odv)
   rsmi_status_t ret = get_od_clk_volt_info(dv_ind, odv);
 
@@ -3516,8 +3493,7 @@ rsmi_status_t
 rsmi_dev_gpu_reset(uint32_t dv_ind) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   REQUIRE_ROOT_ACCESS
   // No longer using DEVICE_MUTEX as it blocks long running processes
   // DEVICE_MUTEX
@@ -3536,8 +3512,7 @@ rsmi_status_t rsmi_dev_od_volt_curve_regions_get(uint32_t dv_ind,
                      uint32_t *num_regions, rsmi_freq_volt_region_t *buffer) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   CHK_SUPPORT_NAME_ONLY((num_regions == nullptr || buffer == nullptr) ?
                                                         nullptr : num_regions)
@@ -3545,15 +3520,14 @@ rsmi_status_t rsmi_dev_od_volt_curve_regions_get(uint32_t dv_ind,
     return RSMI_STATUS_INVALID_ARGS;
   }
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   rsmi_status_t ret = get_od_clk_volt_curve_regions(dv_ind, num_regions,
                                                                       buffer);
   if (*num_regions == 0) {
     ret = RSMI_STATUS_NOT_SUPPORTED;
   }
-  ss << __PRETTY_FUNCTION__ << " | ======= end ======= | returning "
-     << getRSMIStatusString(ret);
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= end ======= | returning "
+     << getRSMIStatusString(ret));
   return ret;
   CATCH
 }
@@ -3562,8 +3536,7 @@ rsmi_status_t
 rsmi_dev_power_max_get(uint32_t dv_ind, uint32_t sensor_ind, uint64_t *power) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   (void)sensor_ind;  // Not used yet
   // ++sensor_ind;  // power sysfs files have 1-based indices
@@ -3571,7 +3544,7 @@ rsmi_dev_power_max_get(uint32_t dv_ind, uint32_t sensor_ind, uint64_t *power) {
 
   rsmi_status_t ret;
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   ret = get_power_mon_value(amd::smi::kPowerMaxGPUPower, dv_ind, power);
 
   return ret;
@@ -3582,15 +3555,14 @@ rsmi_status_t
 rsmi_dev_power_ave_get(uint32_t dv_ind, uint32_t sensor_ind, uint64_t *power) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   ++sensor_ind;  // power sysfs files have 1-based indices
 
   CHK_SUPPORT_SUBVAR_ONLY(power, sensor_ind)
   rsmi_status_t ret;
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   ret = get_dev_mon_value(amd::smi::kMonPowerAve, dv_ind, sensor_ind, power);
 
   return ret;
@@ -3605,35 +3577,32 @@ rsmi_dev_current_socket_power_get(uint32_t dv_ind, uint64_t *socket_power) {
   std::string val_str;
   uint32_t sensor_ind = 1;  // socket_power sysfs files have 1-based indices
   amd::smi::MonitorTypes mon_type = amd::smi::kMonPowerInput;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======, dv_ind="
-     << std::to_string(dv_ind);
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======, dv_ind="
+     << std::to_string(dv_ind));
   if (socket_power == nullptr) {
     rsmiReturn = RSMI_STATUS_INVALID_ARGS;
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
        << " | Type: " << monitorTypesToString.at(mon_type)
        << " | Cause: socket_power was a null ptr reference"
        << " | Returning = "
-       << getRSMIStatusString(rsmiReturn) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(rsmiReturn) << " |");
     return RSMI_STATUS_INVALID_ARGS;
   }
   CHK_SUPPORT_SUBVAR_ONLY(socket_power, sensor_ind)
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   if (dev->monitor() == nullptr) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
        << " | Type: " << monitorTypesToString.at(mon_type)
        << " | Cause: hwmon monitor was a null ptr reference"
        << " | Returning = "
-       << getRSMIStatusString(rsmiReturn) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(rsmiReturn) << " |");
     return rsmiReturn;
   }
 
@@ -3643,7 +3612,7 @@ rsmi_dev_current_socket_power_get(uint32_t dv_ind, uint64_t *socket_power) {
     if (ret != 0) {
       rsmiReturn = amd::smi::ErrnoToRsmiStatus(ret);
     }
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
@@ -3652,21 +3621,19 @@ rsmi_dev_current_socket_power_get(uint32_t dv_ind, uint64_t *socket_power) {
        << " or Socket Power label did not show PPT or size of label data was"
        << " unexpected"
        << " | Returning = "
-       << getRSMIStatusString(rsmiReturn) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(rsmiReturn) << " |");
     return rsmiReturn;
   }
   rsmiReturn = get_dev_mon_value(mon_type, dv_ind, sensor_ind,
                                  socket_power);
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success "
      << " | Device #: " << dv_ind
      << " | Type: " << monitorTypesToString.at(mon_type)
      << " | Data: " << *socket_power
      << " | Returning = "
-     << getRSMIStatusString(rsmiReturn) << " |";
-  LOG_TRACE(ss);
+     << getRSMIStatusString(rsmiReturn) << " |");
   return rsmiReturn;
   CATCH
 }
@@ -3675,24 +3642,22 @@ rsmi_status_t rsmi_dev_power_get(uint32_t dv_ind, uint64_t *power,
                                  RSMI_POWER_TYPE *type) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======, dv_ind="
-     << std::to_string(dv_ind);
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======, dv_ind="
+     << std::to_string(dv_ind));
   rsmi_status_t ret = RSMI_STATUS_NOT_SUPPORTED;
   RSMI_POWER_TYPE temp_power_type = RSMI_INVALID_POWER;
   uint64_t temp_power = 0;
 
   if (type == nullptr || power == nullptr) {
     ret = RSMI_STATUS_INVALID_ARGS;
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
        << " | Type: " << amd::smi::power_type_string(temp_power_type)
        << " | Cause: power or monitor type was a null ptr reference"
        << " | Returning = "
-       << getRSMIStatusString(ret) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(ret) << " |");
     return ret;
   }
 
@@ -3710,15 +3675,14 @@ rsmi_status_t rsmi_dev_power_get(uint32_t dv_ind, uint64_t *power,
   }
   *power = temp_power;
   *type = temp_power_type;
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success "
      << " | Device #: " << dv_ind
      << " | Type: " << amd::smi::power_type_string(temp_power_type)
      << " | Data: " << *power
      << " | Returning = "
-     << getRSMIStatusString(ret) << " |";
-  LOG_TRACE(ss);
+     << getRSMIStatusString(ret) << " |");
   return ret;
   CATCH
 }
@@ -3728,8 +3692,7 @@ rsmi_dev_energy_count_get(uint32_t dv_ind, uint64_t *power,
                           float *counter_resolution, uint64_t *timestamp) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   if (power == nullptr ||
       timestamp == nullptr) {
@@ -3758,15 +3721,14 @@ rsmi_status_t
 rsmi_dev_power_cap_default_get(uint32_t dv_ind, uint64_t *default_cap) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   uint32_t sensor_ind = 1; // power sysfs files have 1-based indices
   CHK_SUPPORT_SUBVAR_ONLY(default_cap, sensor_ind)
 
   rsmi_status_t ret;
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   ret = get_dev_mon_value(amd::smi::kMonPowerCapDefault, dv_ind, sensor_ind, default_cap);
 
   return ret;
@@ -3777,15 +3739,14 @@ rsmi_status_t
 rsmi_dev_power_cap_get(uint32_t dv_ind, uint32_t sensor_ind, uint64_t *cap) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   ++sensor_ind;  // power sysfs files have 1-based indices
   CHK_SUPPORT_SUBVAR_ONLY(cap, sensor_ind)
 
   rsmi_status_t ret;
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   ret = get_dev_mon_value(amd::smi::kMonPowerCap, dv_ind, sensor_ind, cap);
 
   return ret;
@@ -3797,15 +3758,14 @@ rsmi_dev_power_cap_range_get(uint32_t dv_ind, uint32_t sensor_ind,
                                                uint64_t *max, uint64_t *min) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   ++sensor_ind;  // power sysfs files have 1-based indices
   CHK_SUPPORT_SUBVAR_ONLY((min == nullptr || max == nullptr ?nullptr : min),
                                                                    sensor_ind)
   rsmi_status_t ret;
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   ret = get_dev_mon_value(amd::smi::kMonPowerCapMax, dv_ind, sensor_ind, max);
 
   if (ret == RSMI_STATUS_SUCCESS) {
@@ -3823,8 +3783,7 @@ rsmi_dev_power_cap_set(uint32_t dv_ind, uint32_t sensor_ind, uint64_t cap) {
   uint64_t min;
   uint64_t max;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   REQUIRE_ROOT_ACCESS
   DEVICE_MUTEX
@@ -3859,13 +3818,12 @@ rsmi_dev_power_profile_presets_get(uint32_t dv_ind, uint32_t reserved,
                                         rsmi_power_profile_status_t *status) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   (void)reserved;
   CHK_SUPPORT_NAME_ONLY(status)
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   rsmi_status_t ret = get_power_profiles(dv_ind, status, nullptr);
 
   return ret;
@@ -3877,8 +3835,7 @@ rsmi_dev_power_profile_set(uint32_t dv_ind, uint32_t dummy,
                                   rsmi_power_profile_preset_masks_t profile) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   REQUIRE_ROOT_ACCESS
 
   (void)dummy;
@@ -3900,8 +3857,7 @@ rsmi_dev_memory_total_get(uint32_t dv_ind, rsmi_memory_type_t mem_type,
   rsmi_status_t ret;
   amd::smi::DevInfoTypes mem_type_file;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   CHK_SUPPORT_VAR(total, mem_type)
 
@@ -3923,31 +3879,29 @@ rsmi_dev_memory_total_get(uint32_t dv_ind, rsmi_memory_type_t mem_type,
       return RSMI_STATUS_INVALID_ARGS;
   }
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   ret = get_dev_value_int(mem_type_file, dv_ind, total);
 
   // Fallback to KFD reported memory if VRAM total is 0
   if (mem_type == RSMI_MEM_TYPE_VRAM && *total == 0) {
     GET_DEV_AND_KFDNODE_FROM_INDX
     if (kfd_node->get_total_memory(total) == 0 && *total > 0) {
-      ss << __PRETTY_FUNCTION__
+      LOG_DEBUG_S(ss << __PRETTY_FUNCTION__
          << " | inside success fallback... "
          << " | Device #: " << std::to_string(dv_ind)
          << " | Type = " << amd::smi::Device::get_type_string(mem_type_file)
          << " | Data: total = " << std::to_string(*total)
-         << " | ret = " << getRSMIStatusString(RSMI_STATUS_SUCCESS);
-      LOG_DEBUG(ss);
+         << " | ret = " << getRSMIStatusString(RSMI_STATUS_SUCCESS));
       return RSMI_STATUS_SUCCESS;
     }
   }
 
-  ss << __PRETTY_FUNCTION__
+  LOG_DEBUG_S(ss << __PRETTY_FUNCTION__
      << " | after fallback... "
      << " | Device #: " << std::to_string(dv_ind)
      << " | Type = " << amd::smi::Device::get_type_string(mem_type_file)
      << " | Data: total = " << std::to_string(*total)
-     << " | ret = " << getRSMIStatusString(ret);
-  LOG_DEBUG(ss);
+     << " | ret = " << getRSMIStatusString(ret));
   return ret;
   CATCH
 }
@@ -3958,8 +3912,7 @@ rsmi_status_t rsmi_dev_cache_info_get(
   TRY
   rsmi_status_t ret;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   if (info == nullptr) return RSMI_STATUS_INVALID_ARGS;
 
@@ -3978,8 +3931,7 @@ rsmi_dev_memory_usage_get(uint32_t dv_ind, rsmi_memory_type_t mem_type,
   rsmi_status_t ret;
   amd::smi::DevInfoTypes mem_type_file;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   CHK_SUPPORT_VAR(used, mem_type)
 
@@ -4001,7 +3953,7 @@ rsmi_dev_memory_usage_get(uint32_t dv_ind, rsmi_memory_type_t mem_type,
       return RSMI_STATUS_INVALID_ARGS;
   }
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   ret = get_dev_value_int(mem_type_file, dv_ind, used);
 
   // Fallback to KFD reported memory if no VRAM
@@ -4010,35 +3962,32 @@ rsmi_dev_memory_usage_get(uint32_t dv_ind, rsmi_memory_type_t mem_type,
     uint64_t total = 0;
     ret = get_dev_value_int(amd::smi::kDevMemTotVRAM, dv_ind, &total);
     if (total != 0) {
-      ss << __PRETTY_FUNCTION__
+      LOG_DEBUG_S(ss << __PRETTY_FUNCTION__
          << " no fallback needed! - "
          << " | Device #: " << std::to_string(dv_ind)
          << " | Type = " << amd::smi::Device::get_type_string(mem_type_file)
          << " | Data: Used = " << std::to_string(*used)
          << " | Data: total = " << std::to_string(total)
-         << " | ret = " << getRSMIStatusString(ret);
-    LOG_DEBUG(ss);
+         << " | ret = " << getRSMIStatusString(ret));
       return ret;  // do not need to fallback
     }
     if ( kfd_node->get_used_memory(used) == 0 ) {
-      ss << __PRETTY_FUNCTION__
+      LOG_DEBUG_S(ss << __PRETTY_FUNCTION__
          << " | in fallback == success ..."
          << " | Device #: " << std::to_string(dv_ind)
          << " | Type = " << amd::smi::Device::get_type_string(mem_type_file)
          << " | Data: Used = " << std::to_string(*used)
          << " | Data: total = " << std::to_string(total)
-         << " | ret = " << getRSMIStatusString(RSMI_STATUS_SUCCESS);
-      LOG_DEBUG(ss);
+         << " | ret = " << getRSMIStatusString(RSMI_STATUS_SUCCESS));
       return RSMI_STATUS_SUCCESS;
     }
   }
-  ss << __PRETTY_FUNCTION__
+  LOG_DEBUG_S(ss << __PRETTY_FUNCTION__
      << " | at end!!!! after fallback ..."
      << " | Device #: " << std::to_string(dv_ind)
      << " | Type = " << amd::smi::Device::get_type_string(mem_type_file)
      << " | Data: Used = " << std::to_string(*used)
-     << " | ret = " << getRSMIStatusString(ret);
-  LOG_DEBUG(ss);
+     << " | ret = " << getRSMIStatusString(ret));
 
   return ret;
   CATCH
@@ -4049,14 +3998,13 @@ rsmi_dev_memory_busy_percent_get(uint32_t dv_ind, uint32_t *busy_percent) {
   TRY
   rsmi_status_t ret;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   CHK_SUPPORT_NAME_ONLY(busy_percent)
 
   uint64_t tmp_util = 0;
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   ret = get_dev_value_int(amd::smi::kDevMemBusyPercent, dv_ind, &tmp_util);
 
   if (tmp_util > 100) {
@@ -4201,12 +4149,11 @@ rsmi_dev_busy_percent_get(uint32_t dv_ind, uint32_t *busy_percent) {
   TRY
   std::string val_str;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   CHK_SUPPORT_NAME_ONLY(busy_percent)
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   rsmi_status_t ret = get_dev_value_str(amd::smi::kDevUsage, dv_ind,
                                                                     &val_str);
   if (ret != RSMI_STATUS_SUCCESS) {
@@ -4318,19 +4265,17 @@ rsmi_dev_activity_metric_get(uint32_t dv_ind,
 
   TRY
   std::ostringstream ostrstream;
-  ostrstream << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ostrstream);
+  LOG_TRACE_S(ostrstream << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   if (!activity_metric_counter) {
-    ostrstream << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ostrstream << __PRETTY_FUNCTION__
                << " | ======= end ======= "
                << " | Fail "
                << " | Device #: " << dv_ind
                << " | Metric Type: " << activity_metric_type
                << " | Cause: rsmi_activity_metric_counter_t was a null ptr reference"
                << " | Returning = "
-               << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |";
-    LOG_ERROR(ostrstream);
+               << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |");
     return rsmi_status_t::RSMI_STATUS_INVALID_ARGS;
   }
 
@@ -4338,7 +4283,7 @@ rsmi_dev_activity_metric_get(uint32_t dv_ind,
   rsmi_gpu_metrics_t gpu_metrics;
   status_code = rsmi_dev_gpu_metrics_info_get(dv_ind, &gpu_metrics);
   if (status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) {
-    ostrstream << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ostrstream << __PRETTY_FUNCTION__
                << " | ======= end ======= "
                << " | Fail "
                << " | Device #: " << dv_ind
@@ -4346,38 +4291,33 @@ rsmi_dev_activity_metric_get(uint32_t dv_ind,
                << " | Cause: rsmi_dev_gpu_metrics_info_get returned "
                << getRSMIStatusString(status_code)
                << " | Returning = "
-               << status_code << " |";
-    LOG_ERROR(ostrstream);
+               << status_code << " |");
     return status_code;
   }
 
   if (activity_metric_type & rsmi_activity_metric_t::RSMI_ACTIVITY_GFX) {
     activity_metric_counter->average_gfx_activity = gpu_metrics.average_gfx_activity;
-    ostrstream << __PRETTY_FUNCTION__
-               << " | For GFX: " << activity_metric_counter->average_gfx_activity;
-    LOG_INFO(ostrstream);
+    LOG_INFO_S(ostrstream << __PRETTY_FUNCTION__
+               << " | For GFX: " << activity_metric_counter->average_gfx_activity);
   }
   if (activity_metric_type & rsmi_activity_metric_t::RSMI_ACTIVITY_UMC) {
     activity_metric_counter->average_umc_activity = gpu_metrics.average_umc_activity;
-    ostrstream << __PRETTY_FUNCTION__
-               << " | For UMC: " << activity_metric_counter->average_umc_activity;
-    LOG_INFO(ostrstream);
+    LOG_INFO_S(ostrstream << __PRETTY_FUNCTION__
+               << " | For UMC: " << activity_metric_counter->average_umc_activity);
   }
   if (activity_metric_type & rsmi_activity_metric_t::RSMI_ACTIVITY_MM) {
     activity_metric_counter->average_mm_activity  = gpu_metrics.average_mm_activity;
-    ostrstream << __PRETTY_FUNCTION__
-               << " | For MM: " << activity_metric_counter->average_mm_activity;
-    LOG_INFO(ostrstream);
+    LOG_INFO_S(ostrstream << __PRETTY_FUNCTION__
+               << " | For MM: " << activity_metric_counter->average_mm_activity);
   }
 
-  ostrstream << __PRETTY_FUNCTION__
+  LOG_INFO_S(ostrstream << __PRETTY_FUNCTION__
              << " | ======= end ======= "
              << " | Success "
              << " | Device #: " << dv_ind
              << " | Metric Type: " << activity_metric_type
              << " | Returning = "
-             << getRSMIStatusString(status_code) << " |";
-  LOG_INFO(ostrstream);
+             << getRSMIStatusString(status_code) << " |");
 
   return status_code;
   CATCH
@@ -4388,19 +4328,17 @@ rsmi_dev_activity_avg_mm_get(uint32_t dv_ind, uint16_t* avg_activity) {
 
   TRY
   std::ostringstream ostrstream;
-  ostrstream << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ostrstream);
+  LOG_TRACE_S(ostrstream << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   if (!avg_activity) {
-    ostrstream << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ostrstream << __PRETTY_FUNCTION__
                << " | ======= end ======= "
                << " | Fail "
                << " | Device #: " << dv_ind
                << " | Metric Type: " << rsmi_activity_metric_t::RSMI_ACTIVITY_MM
                << " | Cause: avg_activity was a null ptr reference"
                << " | Returning = "
-               << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |";
-    LOG_ERROR(ostrstream);
+               << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |");
     return rsmi_status_t::RSMI_STATUS_INVALID_ARGS;
   }
 
@@ -4409,14 +4347,13 @@ rsmi_dev_activity_avg_mm_get(uint32_t dv_ind, uint16_t* avg_activity) {
   status_code = rsmi_dev_activity_metric_get(dv_ind, rsmi_activity_metric_t::RSMI_ACTIVITY_MM, &activity_metric_counter);
   avg_activity = &activity_metric_counter.average_mm_activity;
 
-  ostrstream << __PRETTY_FUNCTION__
+  LOG_INFO_S(ostrstream << __PRETTY_FUNCTION__
              << " | ======= end ======= "
              << " | Success "
              << " | Device #: " << dv_ind
              << " | Metric Type: " << rsmi_activity_metric_t::RSMI_ACTIVITY_MM
              << " | Returning = "
-             << getRSMIStatusString(status_code) << " |";
-  LOG_INFO(ostrstream);
+             << getRSMIStatusString(status_code) << " |");
 
   return status_code;
   CATCH
@@ -4426,8 +4363,7 @@ rsmi_status_t
 rsmi_dev_vbios_version_get(uint32_t dv_ind, char *vbios, uint32_t len) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(vbios)
 
   if (len == 0) {
@@ -4436,7 +4372,7 @@ rsmi_dev_vbios_version_get(uint32_t dv_ind, char *vbios, uint32_t len) {
 
   std::string val_str;
 
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   int ret = dev->readDevInfo(amd::smi::kDevVBiosVer, &val_str);
 
   if (ret != 0) {
@@ -4489,7 +4425,7 @@ rsmi_version_str_get(rsmi_sw_component_t component, char *ver_str,
 
   switch (component) {
     case RSMI_SW_COMP_DRIVER:
-      ver_path = kROCmDriverVersionPath;
+      ver_path = amd::smi::FsPath(kROCmDriverVersionPath);
       break;
 
     default:
@@ -4525,15 +4461,14 @@ rsmi_version_str_get(rsmi_sw_component_t component, char *ver_str,
 rsmi_status_t rsmi_dev_serial_number_get(uint32_t dv_ind,
                                              char *serial_num, uint32_t len) {
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(serial_num)
   if (len == 0) {
     return RSMI_STATUS_INVALID_ARGS;
   }
 
   TRY
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
 
   std::string val_str;
   rsmi_status_t ret = get_dev_value_str(amd::smi::kDevSerialNumber,
@@ -4559,13 +4494,12 @@ rsmi_status_t
 rsmi_dev_pci_replay_counter_get(uint32_t dv_ind, uint64_t *counter) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(counter)
 
   rsmi_status_t ret;
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   ret = get_dev_value_int(amd::smi::kDevPCIEReplayCount, dv_ind, counter);
   return ret;
 
@@ -4577,12 +4511,11 @@ rsmi_dev_unique_id_get(uint32_t dv_ind, uint64_t *unique_id) {
   TRY
   rsmi_status_t ret;
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   CHK_SUPPORT_NAME_ONLY(unique_id)
 
-  DEVICE_MUTEX
+  DEVICE_SYSFS_READ_MUTEX
   ret = get_dev_value_int(amd::smi::kDevUniqueId, dv_ind, unique_id);
   return ret;
 
@@ -4593,8 +4526,7 @@ rsmi_dev_counter_create(uint32_t dv_ind, rsmi_event_type_t type,
                                            rsmi_event_handle_t *evnt_handle) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   REQUIRE_ROOT_ACCESS
 
   // Note we don't need to pass in the variant to CHK_SUPPORT_VAR because
@@ -4616,8 +4548,7 @@ rsmi_status_t
 rsmi_dev_counter_destroy(rsmi_event_handle_t evnt_handle) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   if (evnt_handle == 0) {
     return RSMI_STATUS_INVALID_ARGS;
@@ -4644,8 +4575,11 @@ rsmi_counter_control(rsmi_event_handle_t evt_handle,
 
   amd::smi::evt::Event *evt =
                          reinterpret_cast<amd::smi::evt::Event *>(evt_handle);
-  amd::smi::pthread_wrap _pw(*amd::smi::GetMutex(evt->dev_ind()));
-  amd::smi::ScopedPthread _lock(_pw);
+  amd::smi::ScopedDeviceLock _lock(amd::smi::GetRWLock(evt->dev_ind()),
+                                   amd::smi::kDeviceLockExclusive);
+  if (_lock.lock_not_acquired()) {
+    return _lock.status();
+  }
 
   REQUIRE_ROOT_ACCESS
 
@@ -4686,6 +4620,7 @@ rsmi_counter_read(rsmi_event_handle_t evt_handle,
                          reinterpret_cast<amd::smi::evt::Event *>(evt_handle);
 
   uint32_t dv_ind = evt->dev_ind();
+  // Exclusive: the read updates the event's previous counter value
   DEVICE_MUTEX
   REQUIRE_ROOT_ACCESS
 
@@ -4706,6 +4641,128 @@ rsmi_counter_read(rsmi_event_handle_t evt_handle,
   CATCH
 }
 
+rsmi_status_t
+rsmi_dev_counter_group_create(uint32_t dv_ind, const rsmi_event_type_t *types,
+                uint32_t num_events, rsmi_event_group_handle_t *grp_handle) {
+  TRY
+  std::ostringstream ss;
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
+  REQUIRE_ROOT_ACCESS
+
+  CHK_SUPPORT_NAME_ONLY(grp_handle)
+  if (types == nullptr || num_events == 0) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+  DEVICE_MUTEX
+  *grp_handle = reinterpret_cast<uintptr_t>(
+             new amd::smi::evt::EventGroup(types, num_events, dv_ind));
+
+  return RSMI_STATUS_SUCCESS;
+  CATCH
+}
+
+rsmi_status_t
+rsmi_dev_counter_group_destroy(rsmi_event_group_handle_t grp_handle) {
+  TRY
+  std::ostringstream ss;
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
+
+  if (grp_handle == 0) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+
+  amd::smi::evt::EventGroup *grp =
+                  reinterpret_cast<amd::smi::evt::EventGroup *>(grp_handle);
+  uint32_t dv_ind = grp->dev_ind();
+  DEVICE_MUTEX
+  REQUIRE_ROOT_ACCESS
+
+  // A group that was never started has nothing to stop
+  int ret = grp->stopCounters();
+  if (ret == EBADF) {
+    ret = 0;
+  }
+
+  delete grp;
+  return amd::smi::ErrnoToRsmiStatus(ret);
+  CATCH
+}
+
+rsmi_status_t
+rsmi_counter_group_control(rsmi_event_group_handle_t grp_handle,
+                                                  rsmi_counter_command_t cmd) {
+  TRY
+
+  if (grp_handle == 0) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+
+  amd::smi::evt::EventGroup *grp =
+                  reinterpret_cast<amd::smi::evt::EventGroup *>(grp_handle);
+  uint32_t dv_ind = grp->dev_ind();
+  DEVICE_MUTEX
+  REQUIRE_ROOT_ACCESS
+
+  int ret = 0;
+
+  switch (cmd) {
+    case RSMI_CNTR_CMD_START:
+      ret = grp->startCounters();
+      break;
+
+    case RSMI_CNTR_CMD_STOP:
+      ret = grp->stopCounters();
+      break;
+
+    default:
+      return RSMI_STATUS_INVALID_ARGS;
+  }
+  return amd::smi::ErrnoToRsmiStatus(ret);
+
+  CATCH
+}
+
+rsmi_status_t
+rsmi_counter_group_read(rsmi_event_group_handle_t grp_handle,
+                        rsmi_counter_value_t *values, uint32_t num_values) {
+  TRY
+
+  if (values == nullptr || grp_handle == 0) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+
+  amd::smi::evt::EventGroup *grp =
+                  reinterpret_cast<amd::smi::evt::EventGroup *>(grp_handle);
+  if (num_values < grp->num_events()) {
+    return RSMI_STATUS_INSUFFICIENT_SIZE;
+  }
+
+  uint32_t dv_ind = grp->dev_ind();
+  // Exclusive: the read fills the group's read buffer and the previous
+  // counter values of its events
+  DEVICE_MUTEX
+  REQUIRE_ROOT_ACCESS
+
+  uint32_t ret = grp->getValues(values);
+
+  // Same overflow handling as rsmi_counter_read(): a delta above 2^48 means
+  // a counter wrapped, so discard the sample and re-read the whole group.
+  if (ret == 0) {
+    for (uint32_t i = 0; i < grp->num_events(); ++i) {
+      if (values[i].value > 0xFFFFFFFFFFFF) {
+        ret = grp->getValues(values);
+        break;
+      }
+    }
+  }
+  if (ret == 0) {
+    return RSMI_STATUS_SUCCESS;
+  }
+
+  return RSMI_STATUS_UNEXPECTED_SIZE;
+  CATCH
+}
+
 rsmi_status_t
 rsmi_counter_available_counters_get(uint32_t dv_ind,
                                 rsmi_event_group_t grp, uint32_t *available) {
@@ -4713,7 +4770,7 @@ rsmi_counter_available_counters_get(uint32_t dv_ind,
 
   TRY
   CHK_SUPPORT_VAR(available, grp)
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   uint64_t val = 0;
 
   switch (grp) {
@@ -4739,9 +4796,8 @@ rsmi_status_t
 rsmi_dev_counter_group_supported(uint32_t dv_ind, rsmi_event_group_t group) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
-  DEVICE_MUTEX
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
+  DEVICE_READ_MUTEX
   GET_DEV_FROM_INDX
 
   amd::smi::evt::dev_evt_grp_set_t *grp = dev->supported_event_groups();
@@ -4843,8 +4899,7 @@ rsmi_dev_memory_reserved_pages_get(uint32_t dv_ind, uint32_t *num_pages,
                                           rsmi_retired_page_record_t *records) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   rsmi_status_t ret;
   CHK_SUPPORT_NAME_ONLY(num_pages)
@@ -4971,14 +5026,13 @@ rsmi_status_t
 rsmi_dev_xgmi_error_status(uint32_t dv_ind, rsmi_xgmi_status_t *status) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   CHK_SUPPORT_NAME_ONLY(status)
 
   rsmi_status_t ret;
   uint64_t status_code;
 
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   ret = get_dev_value_int(amd::smi::kDevXGMIError, dv_ind, &status_code);
 
   if (ret != RSMI_STATUS_SUCCESS) {
@@ -5011,8 +5065,7 @@ rsmi_status_t
 rsmi_dev_xgmi_error_reset(uint32_t dv_ind) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   DEVICE_MUTEX
 
   rsmi_status_t ret;
@@ -5029,8 +5082,7 @@ rsmi_status_t
 rsmi_dev_xgmi_hive_id_get(uint32_t dv_ind, uint64_t *hive_id) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   if (hive_id == nullptr) {
     return RSMI_STATUS_INVALID_ARGS;
@@ -5059,7 +5111,7 @@ rsmi_topo_get_link_weight(uint32_t dv_ind_src, uint32_t dv_ind_dst,
 
   uint32_t dv_ind = dv_ind_src;
   GET_DEV_AND_KFDNODE_FROM_INDX
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
 
   if (weight == nullptr) {
     return RSMI_STATUS_INVALID_ARGS;
@@ -5133,7 +5185,7 @@ rsmi_topo_get_link_weight(uint32_t dv_ind_src, uint32_t dv_ind_dst,
 
   uint32_t dv_ind = dv_ind_src;
   GET_DEV_AND_KFDNODE_FROM_INDX
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
 
   if (min_bandwidth == nullptr || max_bandwidth == nullptr) {
     return RSMI_STATUS_INVALID_ARGS;
@@ -5322,7 +5374,7 @@ rsmi_topo_get_p2p_status(uint32_t dv_ind_src, uint32_t dv_ind_dst,
 
   uint32_t dv_ind = dv_ind_src;
   GET_DEV_AND_KFDNODE_FROM_INDX
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
 
   if (type == nullptr || cap == nullptr) {
     return RSMI_STATUS_INVALID_ARGS;
@@ -5412,12 +5464,11 @@ static rsmi_status_t get_compute_partition(uint32_t dv_ind,
                                           std::string &compute_partition) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind;
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind);
   CHK_SUPPORT_NAME_ONLY(compute_partition.c_str())
   std::string compute_partition_str;
 
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   rsmi_status_t ret = get_dev_value_str(amd::smi::kDevComputePartition,
                                         dv_ind, &compute_partition_str);
   if (ret != RSMI_STATUS_SUCCESS) {
@@ -5437,8 +5488,7 @@ static rsmi_status_t get_compute_partition(uint32_t dv_ind,
       return RSMI_STATUS_UNEXPECTED_DATA;
   }
   compute_partition = compute_partition_str;
-  ss << __PRETTY_FUNCTION__ << " | ======= END =======, " << dv_ind;
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= END =======, " << dv_ind);
   return RSMI_STATUS_SUCCESS;
   CATCH
 }
@@ -5448,11 +5498,10 @@ rsmi_dev_compute_partition_get(uint32_t dv_ind, char *compute_partition,
                                uint32_t len) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======, dv_ind = "
-     << dv_ind;
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======, dv_ind = "
+     << dv_ind);
   if ((len == 0) || (compute_partition == nullptr)) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
@@ -5460,8 +5509,7 @@ rsmi_dev_compute_partition_get(uint32_t dv_ind, char *compute_partition,
        << amd::smi::Device::get_type_string(amd::smi::kDevComputePartition)
        << " | Cause: len was 0 or compute_partition variable was null"
        << " | Returning = "
-       << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |");
     return RSMI_STATUS_INVALID_ARGS;
   }
   CHK_SUPPORT_NAME_ONLY(compute_partition)
@@ -5471,7 +5519,7 @@ rsmi_dev_compute_partition_get(uint32_t dv_ind, char *compute_partition,
                                returning_compute_partition);
 
   if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
@@ -5479,8 +5527,7 @@ rsmi_dev_compute_partition_get(uint32_t dv_ind, char *compute_partition,
        << amd::smi::Device::get_type_string(amd::smi::kDevComputePartition)
        << " | Cause: could not retrieve current compute partition"
        << " | Returning = "
-       << getRSMIStatusString(ret) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(ret) << " |");
     return ret;
   }
 
@@ -5488,7 +5535,7 @@ rsmi_dev_compute_partition_get(uint32_t dv_ind, char *compute_partition,
   compute_partition[length]='\0';
 
   if (len < (returning_compute_partition.size() + 1)) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
@@ -5496,11 +5543,10 @@ rsmi_dev_compute_partition_get(uint32_t dv_ind, char *compute_partition,
        << amd::smi::Device::get_type_string(amd::smi::kDevComputePartition)
        << " | Cause: requested size was insufficient"
        << " | Returning = "
-       << getRSMIStatusString(RSMI_STATUS_INSUFFICIENT_SIZE) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(RSMI_STATUS_INSUFFICIENT_SIZE) << " |");
     return RSMI_STATUS_INSUFFICIENT_SIZE;
   }
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success "
      << " | Device #: " << dv_ind
@@ -5508,8 +5554,7 @@ rsmi_dev_compute_partition_get(uint32_t dv_ind, char *compute_partition,
      << amd::smi::Device::get_type_string(amd::smi::kDevComputePartition)
      << " | Data: " << compute_partition
      << " | Returning = "
-     << getRSMIStatusString(ret) << " |";
-  LOG_TRACE(ss);
+     << getRSMIStatusString(ret) << " |");
   return ret;
   CATCH
 }
@@ -5519,15 +5564,14 @@ is_available_compute_partition(uint32_t dv_ind,
                                std::string new_compute_partition) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind;
-  LOG_TRACE(ss);
-  DEVICE_MUTEX
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind);
+  DEVICE_READ_MUTEX
   std::string availableComputePartitions;
   rsmi_status_t ret =
       get_dev_value_line(amd::smi::kDevAvailableComputePartition,
                          dv_ind, &availableComputePartitions);
   if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | FAIL "
        << " | Device #: " << dv_ind
@@ -5535,8 +5579,7 @@ is_available_compute_partition(uint32_t dv_ind,
        << amd::smi::Device::get_type_string(amd::smi::kDevAvailableComputePartition)
        << " | Data: could not retrieve requested data"
        << " | Returning = "
-       << getRSMIStatusString(ret) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(ret) << " |");
     return ret;
   }
 
@@ -5546,7 +5589,7 @@ is_available_compute_partition(uint32_t dv_ind,
 
   ret = ((isComputePartitionAvailable) ? RSMI_STATUS_SUCCESS :
                                          RSMI_STATUS_SETTING_UNAVAILABLE);
-  ss << __PRETTY_FUNCTION__
+  LOG_INFO_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success "
      << " | Device #: " << dv_ind
@@ -5556,8 +5599,7 @@ is_available_compute_partition(uint32_t dv_ind,
      << " | Data: isComputePartitionAvailable = "
      << (isComputePartitionAvailable ? "True" : "False")
      << " | Returning = "
-     << getRSMIStatusString(ret) << " |";
-  LOG_INFO(ss);
+     << getRSMIStatusString(ret) << " |");
   return ret;
   CATCH
 }
@@ -5567,9 +5609,10 @@ rsmi_dev_compute_partition_set(uint32_t dv_ind,
                               rsmi_compute_partition_type_t compute_partition) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind;
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind);
   REQUIRE_ROOT_ACCESS
+  // With lazy init, the boot partition states were not recorded yet
+  amd::smi::RocmSMI::getInstance().StoreBootPartitions();
   if (!amd::smi::is_sudo_user()) {
     return RSMI_STATUS_PERMISSION;
   }
@@ -5589,7 +5632,7 @@ rsmi_dev_compute_partition_set(uint32_t dv_ind,
     default:
       newComputePartitionStr =
         mapRSMIToStringComputePartitionTypes.at(RSMI_COMPUTE_PARTITION_INVALID);
-      ss << __PRETTY_FUNCTION__
+      LOG_ERROR_S(ss << __PRETTY_FUNCTION__
          << " | ======= end ======= "
          << " | Fail "
          << " | Device #: " << dv_ind
@@ -5598,8 +5641,7 @@ rsmi_dev_compute_partition_set(uint32_t dv_ind,
          << " | Data: " << newComputePartitionStr
          << " | Cause: requested setting was invalid"
          << " | Returning = "
-         << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |";
-      LOG_ERROR(ss);
+         << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |");
       return RSMI_STATUS_INVALID_ARGS;
   }
 
@@ -5608,7 +5650,7 @@ rsmi_dev_compute_partition_set(uint32_t dv_ind,
   rsmi_status_t available_ret =
       is_available_compute_partition(dv_ind, newComputePartitionStr);
   if (available_ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
@@ -5617,8 +5659,7 @@ rsmi_dev_compute_partition_set(uint32_t dv_ind,
        << " | Data: " << newComputePartitionStr
        << " | Cause: not an available compute partition setting"
        << " | Returning = "
-       << getRSMIStatusString(available_ret) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(available_ret) << " |");
     return available_ret;
   }
 
@@ -5628,7 +5669,7 @@ rsmi_dev_compute_partition_set(uint32_t dv_ind,
   // we can try to set, even if we get unexpected data
   if (ret_get != RSMI_STATUS_SUCCESS
       && ret_get != RSMI_STATUS_UNEXPECTED_DATA) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
@@ -5637,14 +5678,13 @@ rsmi_dev_compute_partition_set(uint32_t dv_ind,
        << " | Cause: could retrieve current compute partition or retrieved"
        << " unexpected data"
        << " | Returning = "
-       << getRSMIStatusString(ret_get) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(ret_get) << " |");
     return ret_get;
   }
   rsmi_compute_partition_type_t currRSMIComputePartition
     = mapStringToRSMIComputePartitionTypes.at(currentComputePartition);
   if (currRSMIComputePartition == compute_partition) {
-    ss << __PRETTY_FUNCTION__
+    LOG_TRACE_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Success - compute partition was already set at requested value"
        << " | Device #: " << dv_ind
@@ -5652,25 +5692,24 @@ rsmi_dev_compute_partition_set(uint32_t dv_ind,
        << amd::smi::Device::get_type_string(amd::smi::kDevComputePartition)
        << " | Data: " << newComputePartitionStr
        << " | Returning = "
-       << getRSMIStatusString(RSMI_STATUS_SUCCESS) << " |";
-    LOG_TRACE(ss);
+       << getRSMIStatusString(RSMI_STATUS_SUCCESS) << " |");
     return RSMI_STATUS_SUCCESS;
   }
 
-  ss <<  __PRETTY_FUNCTION__ << " | about to try writing |"
+  LOG_DEBUG_S(ss <<  __PRETTY_FUNCTION__ << " | about to try writing |"
      << newComputePartitionStr
      << "| size of string = " << newComputePartitionStr.size()
      << "| size of c-string = "<< std::dec
      << sizeof(newComputePartitionStr.c_str())/sizeof(newComputePartitionStr[0])
      << "| sizeof string = " << std::dec
-     << sizeof(newComputePartitionStr);
-  LOG_DEBUG(ss);
+     << sizeof(newComputePartitionStr));
   GET_DEV_FROM_INDX
   DEVICE_MUTEX
   int ret = dev->writeDevInfo(amd::smi::kDevComputePartition,
                               newComputePartitionStr);
   rsmi_status_t returnResponse = amd::smi::ErrnoToRsmiStatus(ret);
-  ss << __PRETTY_FUNCTION__
+  dev->invalidate_smi_partition_id();
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success "
      << " | Device #: " << dv_ind
@@ -5678,8 +5717,7 @@ rsmi_dev_compute_partition_set(uint32_t dv_ind,
      << amd::smi::Device::get_type_string(amd::smi::kDevComputePartition)
      << " | Data: " << newComputePartitionStr
      << " | Returning = "
-     << getRSMIStatusString(returnResponse) << " |";
-  LOG_TRACE(ss);
+     << getRSMIStatusString(returnResponse) << " |");
 
   return returnResponse;
   CATCH
@@ -5689,12 +5727,11 @@ static rsmi_status_t get_memory_partition(uint32_t dv_ind,
                                           std::string &memory_partition) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind;
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind);
   CHK_SUPPORT_NAME_ONLY(memory_partition.c_str())
   std::string val_str;
 
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   rsmi_status_t ret = get_dev_value_str(amd::smi::kDevMemoryPartition,
                                         dv_ind, &val_str);
 
@@ -5714,8 +5751,7 @@ static rsmi_status_t get_memory_partition(uint32_t dv_ind,
       return RSMI_STATUS_UNEXPECTED_DATA;
   }
   memory_partition = val_str;
-  ss << __PRETTY_FUNCTION__ << " | ======= END =======, " << dv_ind;
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= END =======, " << dv_ind);
   return RSMI_STATUS_SUCCESS;
   CATCH
 }
@@ -5725,9 +5761,9 @@ rsmi_dev_memory_partition_set(uint32_t dv_ind,
                               rsmi_memory_partition_type_t memory_partition) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind;
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind);
   REQUIRE_ROOT_ACCESS
+  amd::smi::RocmSMI::getInstance().StoreBootPartitions();
   DEVICE_MUTEX
   bool isCorrectDevice = false;
   char boardName[128];
@@ -5788,7 +5824,7 @@ rsmi_dev_memory_partition_set(uint32_t dv_ind,
   // we can try to set, even if we get unexpected data
   if (ret_get != RSMI_STATUS_SUCCESS
       && ret_get != RSMI_STATUS_UNEXPECTED_DATA) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
@@ -5797,14 +5833,13 @@ rsmi_dev_memory_partition_set(uint32_t dv_ind,
        << " | Cause: could retrieve current memory partition or retrieved"
        << " unexpected data"
        << " | Returning = "
-       << getRSMIStatusString(ret_get) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(ret_get) << " |");
     return ret_get;
   }
   rsmi_memory_partition_type_t currRSMIMemoryPartition
     = mapStringToMemoryPartitionTypes.at(currentMemoryPartition);
   if (currRSMIMemoryPartition == memory_partition) {
-    ss << __PRETTY_FUNCTION__
+    LOG_TRACE_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success - no change, current memory partition was already requested"
      << " setting"
@@ -5813,8 +5848,7 @@ rsmi_dev_memory_partition_set(uint32_t dv_ind,
      << amd::smi::Device::get_type_string(amd::smi::kDevMemoryPartition)
      << " | Data: " << newMemoryPartition
      << " | Returning = "
-     << getRSMIStatusString(RSMI_STATUS_SUCCESS) << " |";
-    LOG_TRACE(ss);
+     << getRSMIStatusString(RSMI_STATUS_SUCCESS) << " |");
     return RSMI_STATUS_SUCCESS;
   }
 
@@ -5827,7 +5861,7 @@ rsmi_dev_memory_partition_set(uint32_t dv_ind,
     if (ret == EACCES) {
       err = RSMI_STATUS_NOT_SUPPORTED;  // already verified permissions
     }
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
@@ -5835,13 +5869,12 @@ rsmi_dev_memory_partition_set(uint32_t dv_ind,
        << amd::smi::Device::get_type_string(amd::smi::kDevMemoryPartition)
        << " | Cause: issue writing reqested setting of " + newMemoryPartition
        << " | Returning = "
-       << getRSMIStatusString(err) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(err) << " |");
     return err;
   }
 
   rsmi_status_t restartRet = dev->restartAMDGpuDriver();
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success - if restart completed successfully"
      << " | Device #: " << dv_ind
@@ -5849,8 +5882,7 @@ rsmi_dev_memory_partition_set(uint32_t dv_ind,
      << amd::smi::Device::get_type_string(amd::smi::kDevMemoryPartition)
      << " | Data: " << newMemoryPartition
      << " | Returning = "
-     << getRSMIStatusString(restartRet) << " |";
-  LOG_TRACE(ss);
+     << getRSMIStatusString(restartRet) << " |");
   return restartRet;
   CATCH
 }
@@ -5860,10 +5892,9 @@ rsmi_dev_memory_partition_get(uint32_t dv_ind, char *memory_partition,
                                uint32_t len) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind;
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind);
   if ((len == 0) || (memory_partition == nullptr)) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
@@ -5872,8 +5903,7 @@ rsmi_dev_memory_partition_get(uint32_t dv_ind, char *memory_partition,
        << " | Cause: user sent invalid arguments, len = 0 or memory partition"
        << " was a null ptr"
        << " | Returning = "
-       << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |");
     return RSMI_STATUS_INVALID_ARGS;
   }
   CHK_SUPPORT_NAME_ONLY(memory_partition)
@@ -5883,7 +5913,7 @@ rsmi_dev_memory_partition_get(uint32_t dv_ind, char *memory_partition,
                                returning_memory_partition);
 
   if (ret != RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
@@ -5891,8 +5921,7 @@ rsmi_dev_memory_partition_get(uint32_t dv_ind, char *memory_partition,
        << amd::smi::Device::get_type_string(amd::smi::kDevMemoryPartition)
        << " | Cause: could not successfully retrieve current memory partition "
        << " | Returning = "
-       << getRSMIStatusString(ret) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(ret) << " |");
     return ret;
   }
 
@@ -5901,7 +5930,7 @@ rsmi_dev_memory_partition_get(uint32_t dv_ind, char *memory_partition,
   memory_partition[buff_size] = '\0';
 
   if (len < (returning_memory_partition.size() + 1)) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Fail "
        << " | Device #: " << dv_ind
@@ -5909,11 +5938,10 @@ rsmi_dev_memory_partition_get(uint32_t dv_ind, char *memory_partition,
        << amd::smi::Device::get_type_string(amd::smi::kDevMemoryPartition)
        << " | Cause: could not successfully retrieve current memory partition "
        << " | Returning = "
-       << getRSMIStatusString(ret) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(ret) << " |");
     return RSMI_STATUS_INSUFFICIENT_SIZE;
   }
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success "
      << " | Device #: " << dv_ind
@@ -5921,8 +5949,7 @@ rsmi_dev_memory_partition_get(uint32_t dv_ind, char *memory_partition,
      << amd::smi::Device::get_type_string(amd::smi::kDevMemoryPartition)
      << " | Data: " << memory_partition
      << " | Returning = "
-     << getRSMIStatusString(ret) << " |";
-  LOG_TRACE(ss);
+     << getRSMIStatusString(ret) << " |");
   return ret;
   CATCH
 }
@@ -5930,9 +5957,9 @@ rsmi_dev_memory_partition_get(uint32_t dv_ind, char *memory_partition,
 rsmi_status_t rsmi_dev_compute_partition_reset(uint32_t dv_ind) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind;
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======, " << dv_ind);
   REQUIRE_ROOT_ACCESS
+  amd::smi::RocmSMI::getInstance().StoreBootPartitions();
   DEVICE_MUTEX
   GET_DEV_FROM_INDX
   rsmi_status_t ret = RSMI_STATUS_NOT_SUPPORTED;
@@ -5952,7 +5979,7 @@ rsmi_status_t rsmi_dev_compute_partition_reset(uint32_t dv_ind) {
       mapStringToRSMIComputePartitionTypes.at(bootState);
     ret = rsmi_dev_compute_partition_set(dv_ind, compute_partition);
   }
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success - if original boot state was not unknown or valid setting"
      << " | Device #: " << dv_ind
@@ -5960,8 +5987,7 @@ rsmi_status_t rsmi_dev_compute_partition_reset(uint32_t dv_ind) {
      << amd::smi::Device::get_type_string(amd::smi::kDevComputePartition)
      << " | Data: " << bootState
      << " | Returning = "
-     << getRSMIStatusString(ret) << " |";
-  LOG_TRACE(ss);
+     << getRSMIStatusString(ret) << " |");
   return ret;
   CATCH
 }
@@ -5969,9 +5995,9 @@ rsmi_status_t rsmi_dev_compute_partition_reset(uint32_t dv_ind) {
 rsmi_status_t rsmi_dev_memory_partition_reset(uint32_t dv_ind) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======, " << dv_ind;
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======, " << dv_ind);
   REQUIRE_ROOT_ACCESS
+  amd::smi::RocmSMI::getInstance().StoreBootPartitions();
   DEVICE_MUTEX
   GET_DEV_FROM_INDX
   rsmi_status_t ret = RSMI_STATUS_NOT_SUPPORTED;
@@ -5991,7 +6017,7 @@ rsmi_status_t rsmi_dev_memory_partition_reset(uint32_t dv_ind) {
       mapStringToMemoryPartitionTypes.at(bootState);
     ret = rsmi_dev_memory_partition_set(dv_ind, memory_partition);
   }
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success - if original boot state was not unknown or valid setting"
      << " | Device #: " << dv_ind
@@ -5999,8 +6025,7 @@ rsmi_status_t rsmi_dev_memory_partition_reset(uint32_t dv_ind) {
      << amd::smi::Device::get_type_string(amd::smi::kDevMemoryPartition)
      << " | Data: " << bootState
      << " | Returning = "
-     << getRSMIStatusString(ret) << " |";
-  LOG_TRACE(ss);
+     << getRSMIStatusString(ret) << " |");
   return ret;
   CATCH
 }
@@ -6009,21 +6034,19 @@ rsmi_status_t
 rsmi_dev_partition_id_get(uint32_t dv_ind, uint32_t *partition_id) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======, " << dv_ind;
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======, " << dv_ind);
   if (partition_id == nullptr) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | FAIL"
        << " | Device #: " << dv_ind
        << " | Type: partition_id"
        << " | Data: nullptr"
        << " | Returning = "
-       << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |";
-    LOG_ERROR(ss);
+       << getRSMIStatusString(RSMI_STATUS_INVALID_ARGS) << " |");
     return RSMI_STATUS_INVALID_ARGS;
   }
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   std::string strCompPartition = "UNKNOWN";
   const uint32_t PARTITION_LEN = 10;
   char compute_partition[PARTITION_LEN];
@@ -6058,15 +6081,14 @@ rsmi_dev_partition_id_get(uint32_t dv_ind, uint32_t *partition_id) {
      || strCompPartition == "CPX" || strCompPartition == "QPX")) {
     *partition_id = static_cast<uint32_t>(pci_id & 0x7);
   }
-  ss << __PRETTY_FUNCTION__
+  LOG_INFO_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success"
      << " | Device #: " << dv_ind
      << " | Type: partition_id"
      << " | Data: " << *partition_id
      << " | Returning = "
-     << getRSMIStatusString(RSMI_STATUS_SUCCESS) << " |";
-  LOG_INFO(ss);
+     << getRSMIStatusString(RSMI_STATUS_SUCCESS) << " |");
   return ret;
   CATCH
 }
@@ -6075,9 +6097,8 @@ rsmi_status_t rsmi_dev_target_graphics_version_get(uint32_t dv_ind,
                                             uint64_t *gfx_version) {
     TRY
     std::ostringstream ss;
-    ss << __PRETTY_FUNCTION__ << " | ======= start ======="
-       << " | Device #: " << dv_ind;
-    LOG_TRACE(ss);
+    LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start ======="
+       << " | Device #: " << dv_ind);
     rsmi_status_t ret = RSMI_STATUS_NOT_SUPPORTED;
     std::string version = "";
     const uint64_t undefined_gfx_version = std::numeric_limits<uint64_t>::max();
@@ -6091,15 +6112,14 @@ rsmi_status_t rsmi_dev_target_graphics_version_get(uint32_t dv_ind,
       version = amd::smi::removeString(version, "gfx");
       *gfx_version = std::stoull(version);
     }
-    ss << __PRETTY_FUNCTION__
+    LOG_TRACE_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Returning: " << getRSMIStatusString(ret, false)
        << " | Device #: " << dv_ind
        << " | Type: Target_graphics_version"
        << " | Data: "
        << ((gfx_version == nullptr) ? "nullptr" :
-           amd::smi::print_unsigned_hex_and_int(*gfx_version));
-    LOG_TRACE(ss);
+           amd::smi::print_unsigned_hex_and_int(*gfx_version)));
     return ret;
     CATCH
 }
@@ -6107,9 +6127,8 @@ rsmi_status_t rsmi_dev_target_graphics_version_get(uint32_t dv_ind,
 rsmi_status_t rsmi_dev_guid_get(uint32_t dv_ind, uint64_t *guid) {
     TRY
     std::ostringstream ss;
-    ss << __PRETTY_FUNCTION__ << " | ======= start ======="
-       << " | Device #: " << dv_ind;
-    LOG_TRACE(ss);
+    LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start ======="
+       << " | Device #: " << dv_ind);
     GET_DEV_AND_KFDNODE_FROM_INDX
     uint64_t kgd_gpu_id = 0;
     rsmi_status_t resp = RSMI_STATUS_NOT_SUPPORTED;
@@ -6122,14 +6141,13 @@ rsmi_status_t rsmi_dev_guid_get(uint32_t dv_ind, uint64_t *guid) {
       *guid = kgd_gpu_id;
     }
 
-    ss << __PRETTY_FUNCTION__
+    LOG_INFO_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Returning: " << getRSMIStatusString(resp, false)
        << " | Device #: " << dv_ind
        << " | Type: GUID (gpu_id)"
        << " | Data: " << ((guid == nullptr) ? "nullptr" :
-          amd::smi::print_unsigned_hex_and_int(*guid));
-    LOG_INFO(ss);
+          amd::smi::print_unsigned_hex_and_int(*guid)));
     return resp;
     CATCH
 }
@@ -6137,9 +6155,8 @@ rsmi_status_t rsmi_dev_guid_get(uint32_t dv_ind, uint64_t *guid) {
 rsmi_status_t rsmi_dev_node_id_get(uint32_t dv_ind, uint32_t *node_id) {
     TRY
      std::ostringstream ss;
-    ss << __PRETTY_FUNCTION__ << " | ======= start ======="
-       << " | Device #: " << dv_ind;
-    LOG_TRACE(ss);
+    LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start ======="
+       << " | Device #: " << dv_ind);
     GET_DEV_AND_KFDNODE_FROM_INDX
     uint32_t kfd_node_id = std::numeric_limits<uint32_t>::max();
     rsmi_status_t resp = RSMI_STATUS_NOT_SUPPORTED;
@@ -6155,14 +6172,13 @@ rsmi_status_t rsmi_dev_node_id_get(uint32_t dv_ind, uint32_t *node_id) {
       }
     }
 
-    ss << __PRETTY_FUNCTION__
+    LOG_INFO_S(ss << __PRETTY_FUNCTION__
        << " | ======= end ======= "
        << " | Returning: " << getRSMIStatusString(resp, false)
        << " | Device #: " << dv_ind
        << " | Type: node_id"
        << " | Data: " << ((node_id == nullptr) ? "nullptr" :
-          amd::smi::print_unsigned_hex_and_int(*node_id));
-    LOG_INFO(ss);
+          amd::smi::print_unsigned_hex_and_int(*node_id)));
     return resp;
     CATCH
 }
@@ -6178,8 +6194,7 @@ rsmi_dev_supported_func_iterator_open(uint32_t dv_ind,
                                          rsmi_func_id_iter_handle_t *handle) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
   GET_DEV_FROM_INDX
 
   if (handle == nullptr) {
@@ -6223,8 +6238,7 @@ rsmi_dev_supported_variant_iterator_open(
                                        rsmi_func_id_iter_handle_t *var_iter) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   if (var_iter == nullptr || parent_iter->id_type == SUBVARIANT_ITER) {
     return RSMI_STATUS_INVALID_ARGS;
@@ -6296,8 +6310,7 @@ rsmi_status_t
 rsmi_dev_supported_func_iterator_close(rsmi_func_id_iter_handle_t *handle) {
   TRY
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   if (handle == nullptr) {
     return RSMI_STATUS_INVALID_ARGS;
@@ -6370,6 +6383,40 @@ rsmi_func_iter_value_get(rsmi_func_id_iter_handle_t handle,
   return RSMI_STATUS_SUCCESS;
 }
 
+static_assert(amd::smi::kSupportedFuncCount <= RSMI_MAX_SUPPORTED_FUNCS,
+              "RSMI_MAX_SUPPORTED_FUNCS is too small");
+
+rsmi_status_t
+rsmi_dev_supported_func_bitmap_get(uint32_t dv_ind,
+                                   rsmi_supported_func_bitmap_t *funcs) {
+  TRY
+  std::ostringstream ss;
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
+  GET_DEV_FROM_INDX
+
+  if (funcs == nullptr) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+  *funcs = {};
+  funcs->num_funcs = amd::smi::kSupportedFuncCount;
+  dev->supportedFuncBitmap(funcs->bitmap);
+
+  return RSMI_STATUS_SUCCESS;
+  CATCH
+}
+
+rsmi_status_t
+rsmi_supported_func_name_get(uint32_t func_id, const char **name) {
+  TRY
+  if (name == nullptr || func_id >= amd::smi::kSupportedFuncCount) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+  *name = amd::smi::SupportedFuncName(
+                             static_cast<amd::smi::SupportedFuncId>(func_id));
+  return RSMI_STATUS_SUCCESS;
+  CATCH
+}
+
 rsmi_status_t
 rsmi_func_iter_next(rsmi_func_id_iter_handle_t handle) {
   TRY
@@ -6443,8 +6490,7 @@ rsmi_event_notification_init(uint32_t dv_ind) {
 
   std::lock_guard<std::mutex> guard(*smi.kfd_notif_evt_fh_mutex());
   if (smi.kfd_notif_evt_fh() == -1) {
-    assert(smi.kfd_notif_evt_fh_refcnt() == 0);
-    int kfd_fd = open(kPathKFDIoctl, O_RDWR | O_CLOEXEC);
+    int kfd_fd = open(amd::smi::FsPath(kPathKFDIoctl).c_str(), O_RDWR | O_CLOEXEC);
 
     if (kfd_fd <= 0) {
       return RSMI_STATUS_FILE_ERROR;
@@ -6465,19 +6511,23 @@ rsmi_event_notification_init(uint32_t dv_ind) {
 
   int ret = ioctl(smi.kfd_notif_evt_fh(), AMDKFD_IOC_SMI_EVENTS, &args);
   if (ret < 0) {
-    return amd::smi::ErrnoToRsmiStatus(errno);
+    int err = errno;
+    (void)smi.kfd_notif_evt_fh_refcnt_dec();
+    return amd::smi::ErrnoToRsmiStatus(err);
   }
   if (args.anon_fd < 1) {
+    (void)smi.kfd_notif_evt_fh_refcnt_dec();
     return RSMI_STATUS_NO_DATA;
   }
 
-  dev->set_evt_notif_anon_fd(args.anon_fd);
-  FILE *anon_file_ptr = fdopen(static_cast<int>(args.anon_fd), "r");
-  if (anon_file_ptr == nullptr) {
-    close(dev->evt_notif_anon_fd());
-    return amd::smi::ErrnoToRsmiStatus(errno);
+  ret = smi.evt_notifier().add(dv_ind, static_cast<int>(args.anon_fd));
+  if (ret != 0) {
+    // add() has already closed the fd
+    (void)smi.kfd_notif_evt_fh_refcnt_dec();
+    return (ret == EEXIST) ? RSMI_STATUS_INVALID_ARGS :
+                             amd::smi::ErrnoToRsmiStatus(ret);
   }
-  dev->set_evt_notif_anon_file_ptr(anon_file_ptr);
+  dev->set_evt_notif_anon_fd(args.anon_fd);
 
   return RSMI_STATUS_SUCCESS;
 
@@ -6512,83 +6562,10 @@ rsmi_event_notification_get(int timeout_ms,
     return RSMI_STATUS_INVALID_ARGS;
   }
 
-  uint32_t buffer_size = *num_elem;
-  *num_elem = 0;
-
-  rsmi_evt_notification_data_t *data_item;
-
-  //  struct pollfd {
-  //      int   fd;         /* file descriptor */
-  //      short events;     /* requested events */
-  //      short revents;    /* returned events */
-  //  };
-  std::vector<struct pollfd> fds;
   amd::smi::RocmSMI& smi = amd::smi::RocmSMI::getInstance();
-  std::vector<uint32_t> fd_indx_to_dev_id;
-
-  for (uint32_t i = 0; i < smi.devices().size(); ++i) {
-    if (smi.devices()[i]->evt_notif_anon_fd() == -1) {
-      continue;
-    }
-    fds.push_back({smi.devices()[i]->evt_notif_anon_fd(),
-                                                     POLLIN | POLLRDNORM, 0});
-    fd_indx_to_dev_id.push_back(i);
-  }
-
-  auto fill_data_buffer = [&](bool did_poll) {
-    for (uint32_t i = 0; i < fds.size(); ++i) {
-      if (did_poll) {
-        if (!(fds[i].revents & (POLLIN | POLLRDNORM))) {
-          continue;
-        }
-      }
-
-      if (*num_elem >= buffer_size) {
-        return;
-      }
-
-      FILE *anon_fp =
-         smi.devices()[fd_indx_to_dev_id[i]]->evt_notif_anon_file_ptr();
-      data_item =
-           reinterpret_cast<rsmi_evt_notification_data_t *>(&data[*num_elem]);
-
-      uint32_t event;
-      while (fscanf(anon_fp, "%x %63s\n", &event,
-                          reinterpret_cast<char *>(&data_item->message)) == 2) {
-        /* Output is in format as "event information\n"
-         * Both event are expressed in hex.
-         * information is a string
-         */
-        data_item->event = (rsmi_evt_notification_type_t)event;
-        data_item->dv_ind = fd_indx_to_dev_id[i];
-        ++(*num_elem);
-
-        if (*num_elem >= buffer_size) {
-          break;
-        }
-        data_item =
-             reinterpret_cast<rsmi_evt_notification_data_t *>(&data[*num_elem]);
-      }
-    }
-  };
-
-  // Collect any left-over events from a poll in a previous call to
-  // rsmi_event_notification_get()
-  fill_data_buffer(false);
-
-  if (*num_elem < buffer_size && errno != EAGAIN) {
-    return amd::smi::ErrnoToRsmiStatus(errno);
-  }
-  if (*num_elem >= buffer_size) {
-    return RSMI_STATUS_SUCCESS;
-  }
-
-  // We still have buffer left, see if there are any new events
-  int p_ret = poll(fds.data(), fds.size(), timeout_ms);
-  if (p_ret > 0) {
-    fill_data_buffer(true);
-  } else if (p_ret < 0) {
-    return amd::smi::ErrnoToRsmiStatus(errno);
+  int ret = smi.evt_notifier().get(timeout_ms, num_elem, data);
+  if (ret != 0) {
+    return amd::smi::ErrnoToRsmiStatus(ret);
   }
   if (*num_elem == 0) {
     return RSMI_STATUS_NO_DATA;
@@ -6598,6 +6575,28 @@ rsmi_event_notification_get(int timeout_ms,
   CATCH
 }
 
+rsmi_status_t
+rsmi_event_notification_callback_set(rsmi_evt_notification_callback_t callback,
+                                     void *user_data) {
+  TRY
+  amd::smi::RocmSMI& smi = amd::smi::RocmSMI::getInstance();
+  int ret = smi.evt_notifier().set_callback(callback, user_data);
+  return amd::smi::ErrnoToRsmiStatus(ret);
+  CATCH
+}
+
+rsmi_status_t
+rsmi_event_notification_fd_get(int *fd) {
+  TRY
+  if (fd == nullptr) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+  amd::smi::RocmSMI& smi = amd::smi::RocmSMI::getInstance();
+  int ret = smi.evt_notifier().fd(fd);
+  return amd::smi::ErrnoToRsmiStatus(ret);
+  CATCH
+}
+
 rsmi_status_t rsmi_event_notification_stop(uint32_t dv_ind) {
   TRY
   GET_DEV_FROM_INDX
@@ -6608,14 +6607,11 @@ rsmi_status_t rsmi_event_notification_stop(uint32_t dv_ind) {
   if (dev->evt_notif_anon_fd() == -1) {
     return RSMI_STATUS_INVALID_ARGS;
   }
-//  close(dev->evt_notif_anon_fd());
-  FILE *anon_fp = smi.devices()[dv_ind]->evt_notif_anon_file_ptr();
-  fclose(anon_fp);
-  assert(errno == 0 || errno == EAGAIN);
-  dev->set_evt_notif_anon_file_ptr(nullptr);
+  (void)smi.evt_notifier().remove(dv_ind);
   dev->set_evt_notif_anon_fd(-1);
 
-  if (smi.kfd_notif_evt_fh_refcnt_dec() == 0) {
+  if (smi.kfd_notif_evt_fh_refcnt_dec() == 0 &&
+      smi.kfd_notif_evt_fh() >= 0) {
     int ret = close(smi.kfd_notif_evt_fh());
     smi.set_kfd_notif_evt_fh(-1);
     if (ret < 0) {
@@ -6632,8 +6628,7 @@ rsmi_dev_metrics_header_info_get(uint32_t dv_ind, metrics_table_header_t* header
 {
   TRY
   std::ostringstream ostrstream;
-  ostrstream << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ostrstream);
+  LOG_TRACE_S(ostrstream << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   assert(header_value != nullptr);
   if (header_value == nullptr) {
@@ -6641,15 +6636,14 @@ rsmi_dev_metrics_header_info_get(uint32_t dv_ind, metrics_table_header_t* header
   }
 
   auto status_code = rsmi_dev_gpu_metrics_header_info_get(dv_ind, *header_value);
-  ostrstream << __PRETTY_FUNCTION__
+  LOG_INFO_S(ostrstream << __PRETTY_FUNCTION__
              << " | ======= end ======= "
              << " | End Result "
              << " | Device #:  " << dv_ind
              << " | Format Revision: " << header_value->format_revision
              << " | Content Revision: " << header_value->content_revision
              << " | Header Size: " << header_value->structure_size
-             << " | Returning = " << status_code << " " << getRSMIStatusString(status_code) << " |";
-  LOG_INFO(ostrstream);
+             << " | Returning = " << status_code << " " << getRSMIStatusString(status_code) << " |");
 
   return status_code;
   CATCH
@@ -6661,8 +6655,7 @@ rsmi_dev_metrics_xcd_counter_get(uint32_t dv_ind, uint16_t* xcd_counter_value)
 {
   TRY
   std::ostringstream ostrstream;
-  ostrstream << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ostrstream);
+  LOG_TRACE_S(ostrstream << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   assert(xcd_counter_value != nullptr);
   if (xcd_counter_value == nullptr) {
@@ -6684,13 +6677,12 @@ rsmi_dev_metrics_xcd_counter_get(uint32_t dv_ind, uint16_t* xcd_counter_value)
   }
 
   *xcd_counter_value = xcd_counter;
-  ostrstream << __PRETTY_FUNCTION__
+  LOG_INFO_S(ostrstream << __PRETTY_FUNCTION__
              << " | ======= end ======= "
              << " | End Result "
              << " | Device #:  " << dv_ind
              << " | XCDs counter: " << xcd_counter
-             << " | Returning = " << status_code << " " << getRSMIStatusString(status_code) << " |";
-  LOG_INFO(ostrstream);
+             << " | Returning = " << status_code << " " << getRSMIStatusString(status_code) << " |");
 
   return status_code;
   CATCH
@@ -6701,23 +6693,76 @@ rsmi_dev_metrics_log_get(uint32_t dv_ind)
 {
   TRY
   std::ostringstream ostrstream;
-  ostrstream << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ostrstream);
+  LOG_TRACE_S(ostrstream << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   GET_DEV_FROM_INDX
+  std::lock_guard<std::mutex> metrics_guard(*dev->gpu_metrics_mutex());
   auto status_code = dev->dev_log_gpu_metrics(ostrstream);
-  ostrstream << __PRETTY_FUNCTION__
+  LOG_INFO_S(ostrstream << __PRETTY_FUNCTION__
              << " | ======= end ======= "
              << " | End Result "
              << " | Device #:  " << dv_ind
              << " | Metric Type: " << "All GPU Metrics..."
-             << " | Returning = " << status_code << " " << getRSMIStatusString(status_code) << " |";
-  LOG_INFO(ostrstream);
+             << " | Returning = " << status_code << " " << getRSMIStatusString(status_code) << " |");
 
   return status_code;
   CATCH
 }
 
+rsmi_status_t
+rsmi_dev_gpu_metrics_cache_ttl_set(uint32_t dv_ind, uint64_t ttl_us)
+{
+  TRY
+  std::ostringstream ostrstream;
+  LOG_TRACE_S(ostrstream << __PRETTY_FUNCTION__ << "| ======= start =======");
+
+  DEVICE_MUTEX
+  GET_DEV_FROM_INDX
+  dev->set_gpu_metrics_cache_ttl(ttl_us);
+  LOG_INFO_S(ostrstream << __PRETTY_FUNCTION__
+             << " | ======= end ======= "
+             << " | End Result "
+             << " | Device #:  " << dv_ind
+             << " | Cache TTL (usec): " << ttl_us
+             << " | Returning = " << getRSMIStatusString(RSMI_STATUS_SUCCESS) << " |");
+
+  return RSMI_STATUS_SUCCESS;
+  CATCH
+}
+
+rsmi_status_t
+rsmi_dev_gpu_metrics_cache_ttl_get(uint32_t dv_ind, uint64_t *ttl_us)
+{
+  TRY
+  std::ostringstream ostrstream;
+  LOG_TRACE_S(ostrstream << __PRETTY_FUNCTION__ << "| ======= start =======");
+
+  if (ttl_us == nullptr) {
+    return rsmi_status_t::RSMI_STATUS_INVALID_ARGS;
+  }
+
+  GET_DEV_FROM_INDX
+  *ttl_us = dev->gpu_metrics_cache_ttl();
+  return RSMI_STATUS_SUCCESS;
+  CATCH
+}
+
+rsmi_status_t
+rsmi_dev_sysfs_fd_cache_stats_get(uint32_t dv_ind,
+                                  rsmi_sysfs_fd_cache_stats_t *stats) {
+  TRY
+  std::ostringstream ss;
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======, " << dv_ind);
+  if (stats == nullptr) {
+    return RSMI_STATUS_INVALID_ARGS;
+  }
+  GET_DEV_FROM_INDX
+
+  dev->sysfs_fd_cache_stats(stats);
+  return RSMI_STATUS_SUCCESS;
+  CATCH
+}
+
 
 // UNDOCUMENTED FUNCTIONS
 // This functions are not declared in rocm_smi.h. They are either not fully
@@ -6726,20 +6771,37 @@ rsmi_dev_metrics_log_get(uint32_t dv_ind)
 // This function acquires a mutex and waits for a number of seconds
 rsmi_status_t
 rsmi_test_sleep(uint32_t dv_ind, uint32_t seconds) {
-//  DEVICE_MUTEX
-  amd::smi::pthread_wrap _pw(*amd::smi::GetMutex(dv_ind));
-  amd::smi::RocmSMI& smi_ = amd::smi::RocmSMI::getInstance();
-  bool blocking_ = !(smi_.init_options() &
-                      static_cast<uint64_t>(RSMI_INIT_FLAG_RESRV_TEST1));
-  amd::smi::ScopedPthread _lock(_pw, blocking_);
-  if (!blocking_ && _lock.mutex_not_acquired()) {
-    return RSMI_STATUS_BUSY;
-  }
+  DEVICE_MUTEX
 
   sleep(seconds);
   return RSMI_STATUS_SUCCESS;
 }
 
+// Watches fd (e.g. one end of a pipe or socketpair) for the events of a
+// device as if it were the event file returned by KFD, so that event
+// notification can be exercised without a driver. rsmi_event_notification_stop()
+// closes it, and so does a failure here.
+rsmi_status_t
+rsmi_test_event_notification_fd_set(uint32_t dv_ind, int fd) {
+  MAKE_NAMED_SCOPE_GUARD(fdGuard, [&]() { close(fd); });
+  TRY
+  GET_DEV_FROM_INDX
+  DEVICE_MUTEX
+
+  std::lock_guard<std::mutex> guard(*smi.kfd_notif_evt_fh_mutex());
+  // add() owns fd from here on, and closes it if it fails
+  fdGuard.Dismiss();
+  int ret = smi.evt_notifier().add(dv_ind, fd);
+  if (ret != 0) {
+    return (ret == EEXIST) ? RSMI_STATUS_INVALID_ARGS :
+                             amd::smi::ErrnoToRsmiStatus(ret);
+  }
+  (void)smi.kfd_notif_evt_fh_refcnt_inc();
+  dev->set_evt_notif_anon_fd(fd);
+  return RSMI_STATUS_SUCCESS;
+  CATCH
+}
+
 int32_t
 rsmi_test_refcount(uint64_t refcnt_type) {
   (void)refcnt_type;
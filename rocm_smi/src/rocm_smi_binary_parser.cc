@@ -44,170 +44,397 @@
 #include "rocm_smi/rocm_smi_binary_parser.h"
 #include "rocm_smi/rocm_smi_common.h"  // Should go before rocm_smi.h
 #include "rocm_smi/rocm_smi.h"
-#include "rocm_smi/rocm_smi_main.h"
-#include "rocm_smi/rocm_smi_utils.h"
-#include "rocm_smi/rocm_smi_exception.h"
-#include "rocm_smi/rocm_smi_device.h"
 #include "rocm_smi/rocm_smi_logger.h"
 
-#include <dirent.h>
-#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <algorithm>
 #include <cassert>
+#include <cerrno>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
-#include <fstream>
-#include <iostream>
-#include <map>
-#include <memory>
+#include <sstream>
 #include <string>
-#include <utility>
-#include <variant>
 #include <vector>
 
 namespace amd::smi {
-static uint64_t get_value(uint8_t **ptr, struct metric_field *field) {
-    uint64_t v;
-    switch (field->field_type) {
+
+static const struct metric_field xgmi_regs[] = {
+    { FIELD_TYPE_U16, 1, "structure_size", 0 },
+    { FIELD_TYPE_U8,  1, "format_revision", 0 },
+    { FIELD_TYPE_U8,  1, "content_revision", 0 },
+    { FIELD_TYPE_U8,  1, "state_type", 0 },
+    { FIELD_TYPE_U8,  1, "num_instances", FIELD_FLAG_NUM_INSTANCE },
+    { FIELD_TYPE_U16, 1, "pad", 0 },
+
+    { FIELD_TYPE_U16, 1, "instance", FIELD_FLAG_INSTANCE_START },
+    { FIELD_TYPE_U16, 1, "state", 0 },
+    { FIELD_TYPE_U16, 1, "num_smn_regs", FIELD_FLAG_NUM_SMN },
+    { FIELD_TYPE_U16, 1, "pad", 0 },
+
+    { FIELD_TYPE_U64, 1, "addr", FIELD_FLAG_SMN_START },
+    { FIELD_TYPE_U32, 1, "value", 0 },
+    { FIELD_TYPE_U32, 1, "pad", 0 },
+    { 0, 0, NULL, 0 },
+};
+
+// check me!
+static const struct metric_field wafl_regs[] = {
+    { FIELD_TYPE_U16, 1, "structure_size", 0 },
+    { FIELD_TYPE_U8,  1, "format_revision", 0 },
+    { FIELD_TYPE_U8,  1, "content_revision", 0 },
+    { FIELD_TYPE_U8,  1, "state_type", 0 },
+    { FIELD_TYPE_U8,  1, "num_instances", FIELD_FLAG_NUM_INSTANCE },
+    { FIELD_TYPE_U16, 1, "pad", 0 },
+
+    { FIELD_TYPE_U16, 1, "instance", FIELD_FLAG_INSTANCE_START },
+    { FIELD_TYPE_U16, 1, "state", 0 },
+    { FIELD_TYPE_U16, 1, "num_smn_regs", FIELD_FLAG_NUM_SMN },
+    { FIELD_TYPE_U16, 1, "pad", 0 },
+
+    { FIELD_TYPE_U64, 1, "addr", FIELD_FLAG_SMN_START },
+    { FIELD_TYPE_U32, 1, "value", 0 },
+    { FIELD_TYPE_U32, 1, "pad", 0 },
+    { 0, 0, NULL, 0 },
+};
+
+static const struct metric_field pcie_regs[] = {
+    { FIELD_TYPE_U16, 1, "structure_size", 0 },
+    { FIELD_TYPE_U8,  1, "format_revision", 0 },
+    { FIELD_TYPE_U8,  1, "content_revision", 0 },
+    { FIELD_TYPE_U8,  1, "state_type", 0 },
+    { FIELD_TYPE_U8,  1, "num_instances", FIELD_FLAG_NUM_INSTANCE },
+    { FIELD_TYPE_U16, 1, "pad", 0 },
+
+    { FIELD_TYPE_U16, 1, "instance", FIELD_FLAG_INSTANCE_START },
+    { FIELD_TYPE_U16, 1, "state", 0 },
+    { FIELD_TYPE_U16, 1, "num_smn_regs", FIELD_FLAG_NUM_SMN },
+    { FIELD_TYPE_U16, 1, "pad", 0 },
+
+    { FIELD_TYPE_U16, 1, "device_status", 0 },
+    { FIELD_TYPE_U16, 1, "link_status", 0 },
+    { FIELD_TYPE_U32, 1, "sub_bus_number_latency", 0 },
+    { FIELD_TYPE_U32, 1, "pcie_corr_err_status", 0 },
+    { FIELD_TYPE_U32, 1, "pcie_uncorr_err_status", 0 },
+
+    { FIELD_TYPE_U64, 1, "addr", FIELD_FLAG_SMN_START },
+    { FIELD_TYPE_U32, 1, "value", 0 },
+    { FIELD_TYPE_U32, 1, "pad", 0 },
+    { 0, 0, NULL, 0 },
+};
+
+static const struct metric_field usr_regs[] = {
+    { FIELD_TYPE_U16, 1, "structure_size", 0 },
+    { FIELD_TYPE_U8,  1, "format_revision", 0 },
+    { FIELD_TYPE_U8,  1, "content_revision", 0 },
+    { FIELD_TYPE_U8,  1, "state_type", 0 },
+    { FIELD_TYPE_U8,  1, "num_instances", FIELD_FLAG_NUM_INSTANCE },
+    { FIELD_TYPE_U16, 1, "pad", 0 },
+
+    { FIELD_TYPE_U16, 1, "instance", FIELD_FLAG_INSTANCE_START },
+    { FIELD_TYPE_U16, 1, "state", 0 },
+    { FIELD_TYPE_U16, 1, "num_smn_regs", FIELD_FLAG_NUM_SMN },
+    { FIELD_TYPE_U16, 1, "pad", 0 },
+
+    { FIELD_TYPE_U64, 1, "addr", FIELD_FLAG_SMN_START },
+    { FIELD_TYPE_U32, 1, "value", 0 },
+    { FIELD_TYPE_U32, 1, "pad", 0 },
+    { 0, 0, NULL, 0 },
+};
+
+static const struct metric_field smu_13_0_6_v8[] = {
+    { FIELD_TYPE_U16, 1, "structure_size", 0 },
+    { FIELD_TYPE_U16, 1, "pad", 0 },
+    { FIELD_TYPE_U32, 1, "mp1_ip_discovery_version", 0 },
+    { FIELD_TYPE_U32, 1, "pmfw_version", 0 },
+    { FIELD_TYPE_U32, 1, "pmmetrics_version", 0 },
+
+    { FIELD_TYPE_U32, 1, "AccumulationCounter", 0 },
+
+    { FIELD_TYPE_U32,  1, "MaxSocketTemperature", 0 },
+    { FIELD_TYPE_U32,  1, "MaxVrTemperature", 0 },
+    { FIELD_TYPE_U32,  1, "MaxHbmTemperature", 0 },
+    { FIELD_TYPE_U64,  1, "MaxSocketTemperatureAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U64,  1, "MaxVrTemperatureAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U64,  1, "MaxHbmTemperatureAcc", FIELD_FLAG_ACCUMULATOR },
+
+    { FIELD_TYPE_U32,  1, "SocketPowerLimit", 0 },
+    { FIELD_TYPE_U32,  1, "MaxSocketPowerLimit", 0 },
+    { FIELD_TYPE_U32,  1, "SocketPower", 0 },
+
+    { FIELD_TYPE_U64,  1, "Timestamp", 0 },
+    { FIELD_TYPE_U64,  1, "SocketEnergyAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U64,  1, "CcdEnergyAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U64,  1, "XcdEnergyAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U64,  1, "AidEnergyAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U64,  1, "HbmEnergyAcc", FIELD_FLAG_ACCUMULATOR },
+
+    { FIELD_TYPE_U32,  1, "CclkFrequencyLimit", 0 },
+    { FIELD_TYPE_U32,  1, "GfxclkFrequencyLimit", 0 },
+    { FIELD_TYPE_U32,  1, "FclkFrequency", 0 },
+    { FIELD_TYPE_U32,  1, "UclkFrequency", 0 },
+    { FIELD_TYPE_U32,  4, "SocclkFrequency", 0 },
+    { FIELD_TYPE_U32,  4, "VclkFrequency", 0 },
+    { FIELD_TYPE_U32,  4, "DclkFrequency", 0 },
+    { FIELD_TYPE_U32,  4, "LclkFrequency", 0 },
+    { FIELD_TYPE_U64,  8, "GfxclkFrequencyAcc", FIELD_FLAG_ACCUMULATOR},
+    { FIELD_TYPE_U64,  96, "CclkFrequencyAcc", FIELD_FLAG_ACCUMULATOR },
+
+    { FIELD_TYPE_U32,  1, "MaxCclkFrequency", 0 },
+    { FIELD_TYPE_U32,  1, "MinCclkFrequency", 0 },
+    { FIELD_TYPE_U32,  1, "MaxGfxclkFrequency", 0 },
+    { FIELD_TYPE_U32,  1, "MinGfxclkFrequency", 0 },
+    { FIELD_TYPE_U32,  4, "FclkFrequencyTable", 0 },
+    { FIELD_TYPE_U32,  4, "UclkFrequencyTable", 0 },
+    { FIELD_TYPE_U32,  4, "SocclkFrequencyTable", 0 },
+    { FIELD_TYPE_U32,  4, "VclkFrequencyTable", 0 },
+    { FIELD_TYPE_U32,  4, "DclkFrequencyTable", 0 },
+    { FIELD_TYPE_U32,  4, "LclkFrequencyTable", 0 },
+    { FIELD_TYPE_U32,  1, "MaxLclkDpmRange", 0 },
+    { FIELD_TYPE_U32,  1, "MinLclkDpmRange", 0 },
+
+    { FIELD_TYPE_U32,  1, "XgmiWidth", 0 },
+    { FIELD_TYPE_U32,  1, "XgmiBitrate", 0 },
+    { FIELD_TYPE_U64,  8, "XgmiReadBandwidthAcc", 0 },
+    { FIELD_TYPE_U64,  8, "XgmiWriteBandwidthAcc", 0 },
+
+    { FIELD_TYPE_U32,  1, "SocketC0Residency", 0 },
+    { FIELD_TYPE_U32,  1, "SocketGfxBusy", 0 },
+    { FIELD_TYPE_U32,  1, "DramBandwidthUtilization", 0 },
+    { FIELD_TYPE_U64,  1, "SocketC0ResidencyAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U64,  1, "SocketGfxBusyAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U64,  1, "DramBandwidthAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U32,  1, "MaxDramBandwidth", 0 },
+    { FIELD_TYPE_U64,  1, "DramBandwidthUtilizationAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U64,  4, "PcieBandwidthAcc", FIELD_FLAG_ACCUMULATOR },
+
+    { FIELD_TYPE_U32,  1, "ProchotResidencyAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U32,  1, "PptResidencyAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U32,  1, "SocketThmResidencyAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U32,  1, "VrThmResidencyAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U32,  1, "HbmThmResidencyAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U32,  1, "GfxLockXCDMak", 0 },
+
+    { FIELD_TYPE_U32,  8, "GfxclkFrequency", 0 },
+
+    { FIELD_TYPE_U64,  4, "PublicSerialNumber_AID", 0 },
+    { FIELD_TYPE_U64,  8, "PublicSerialNumber_XCD", 0 },
+    { FIELD_TYPE_U64,  12, "PublicSerialNumber_CCD", 0 },
+
+    { FIELD_TYPE_U64,  8, "XgmiReadDataSizeAcc", FIELD_FLAG_ACCUMULATOR },
+    { FIELD_TYPE_U64,  8, "XgmiWriteDataSizeAcc", FIELD_FLAG_ACCUMULATOR },
+    { 0, 0, NULL, 0 },
+};
+
+// pm_metrics is read whole; each reg_state section is at most 4 KB
+static const std::size_t kPmMetricsReadSize = 65536;
+static const std::size_t kRegStateReadSize = 4096;
+// Offset of pmmetrics_version in pm_metrics
+static const uint32_t kPmMetricsVersionOffset = 12;
+
+static uint64_t field_value(const uint8_t *p, uint8_t size) {
+    switch (size) {
         case FIELD_TYPE_U8:
-            v = *(uint8_t*)(*ptr);
-            ++(*ptr);
+            return *p;
+        case FIELD_TYPE_U16: {
+            uint16_t v;
+            memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        case FIELD_TYPE_U32: {
+            uint32_t v;
+            memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        default: {
+            uint64_t v;
+            memcpy(&v, p, sizeof(v));
+            return v;
+        }
+    }
+}
+
+MetricsTableDecoder::MetricsTableDecoder(void)
+    : table_(nullptr), file_offset_(0), read_size_(kPmMetricsReadSize),
+      compiled_(false), min_len_(0), prev_values_valid_(false) {
+}
+
+MetricsTableDecoder::MetricsTableDecoder(rsmi_reg_type_t reg_type)
+    : table_(nullptr), file_offset_(0), read_size_(kRegStateReadSize),
+      compiled_(false), min_len_(0), prev_values_valid_(false) {
+    switch (reg_type) {
+        case RSMI_REG_XGMI:
+            file_offset_ = AMDGPU_SYS_REG_STATE_XGMI;
+            table_ = &xgmi_regs[0];
+            break;
+        case RSMI_REG_WAFL:
+            file_offset_ = AMDGPU_SYS_REG_STATE_WAFL;
+            table_ = &wafl_regs[0];
             break;
-        case FIELD_TYPE_U16:
-            v = *(uint16_t*)(*ptr);
-            (*ptr) += 2;
+        case RSMI_REG_PCIE:
+            file_offset_ = AMDGPU_SYS_REG_STATE_PCIE;
+            table_ = &pcie_regs[0];
             break;
-        case FIELD_TYPE_U32:
-            v = *(uint32_t*)(*ptr);
-            (*ptr) += 4;
+        case RSMI_REG_USR:
+            file_offset_ = AMDGPU_SYS_REG_STATE_USR;
+            table_ = &usr_regs[0];
             break;
-        case FIELD_TYPE_U64:
-            v = *(uint64_t*)(*ptr);
-            (*ptr) += 8;
+        case RSMI_REG_USR1:
+            file_offset_ = AMDGPU_SYS_REG_STATE_USR_1;
+            table_ = &usr_regs[0];
             break;
     }
-    return v;
+    assert(table_ != nullptr);
 }
 
-static int parse_pmmetric_table(uint8_t *buf, struct metric_field *table,
-              int32_t buflen, rsmi_name_value_t **kv, uint32_t *kvnum) {
-    uint64_t v1;
-    int x, y;
-    uint8_t *origbuf = buf;
-    uint32_t kvsize = 64;
-
-    *kv = reinterpret_cast<rsmi_name_value_t*>(calloc(kvsize, sizeof **kv));
-    *kvnum = 0;
-
-    for (x = 0; table[x].field_name; x++) {
-        for (y = 0; y < table[x].field_arr_size; y++) {
-            v1 = get_value(&buf, &table[x]);
-            if ((intptr_t)(buf - origbuf) > buflen) {
-                fprintf(stderr,
-                    "[ERROR]: Invalid buffer as buffer length exceeded\n");
-                return -1;
-            }
-
-            if (*kvnum == kvsize) {
-                kvsize += 64;
-                *kv = reinterpret_cast<rsmi_name_value_t*>
-                              (realloc(*kv,kvsize * (sizeof **kv)));
-            }
-            if (table[x].field_arr_size == 1) {
-                sprintf((*kv)[*kvnum].name, "%s", table[x].field_name);
-            } else {
-                sprintf((*kv)[*kvnum].name, "%s[%d]", table[x].field_name, y);
-            }
-            (*kv)[*kvnum].value = v1;
-
-            ++(*kvnum);
-        }
+int MetricsTableDecoder::load_locked(const std::string &path,
+                                     std::size_t *len) {
+    if (buf_.empty()) {
+        buf_.resize(read_size_);
     }
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno;
+    }
+    ssize_t n;
+    do {
+        n = pread(fd, buf_.data(), buf_.size(), file_offset_);
+    } while (n < 0 && errno == EINTR);
+    int err = (n < 0) ? errno : 0;
+    close(fd);
+    if (err != 0) {
+        return err;
+    }
+    *len = static_cast<std::size_t>(n);
     return 0;
 }
 
-/** present the PM metrics data
- *
- * @dri_instance: which card to pick under /sys/class/drm/card${instance}/device/
- * @kv: pointer to pointer of rsmi_name_value pairs
- * @kvnum: pointer to number of used rsmi_name_value pairs
- */
-int present_pmmetrics(const char* fname,
-                    rsmi_name_value_t **kv, uint32_t *kvnum)
-{
-    uint8_t *buf1;
-    FILE *infile;
-    uint32_t pmmetrics_version;
-    metric_field *table;
-    int r;
-    int32_t len;
-
-    infile = fopen(fname, "rb");
-    if (!infile) {
-        fprintf(stderr, "[ERROR]: pm_metrics file not found \n");
-        return -1;
+bool MetricsTableDecoder::layout_matches_locked(const uint8_t *buf,
+                                                std::size_t len) const {
+    if (!compiled_ || len < min_len_) {
+        return false;
+    }
+    for (const auto &key : layout_keys_) {
+        if (field_value(buf + key.offset, key.size) != key.value) {
+            return false;
+        }
     }
+    return true;
+}
 
-    buf1 = reinterpret_cast<uint8_t *>(calloc(1, 65536));
-    if (!buf1) {
-        return -1;
+int MetricsTableDecoder::add_field_locked(const metric_field &field,
+                          std::size_t offset, std::size_t len, const char *name) {
+    std::size_t end = offset + field.field_type;
+    if (end > len) {
+        return EINVAL;
     }
+    min_len_ = std::max(min_len_, end);
+    Field f;
+    f.offset = static_cast<uint32_t>(offset);
+    f.size = field.field_type;
+    snprintf(f.name, sizeof(f.name), "%s", name);
+    fields_.push_back(f);
+    return 0;
+}
 
-    table = NULL;
-    len = fread(buf1, 1, 65536, infile);
-    fseek(infile, 0, SEEK_SET);
-    memcpy(&pmmetrics_version, &buf1[12], 4);
+int MetricsTableDecoder::compile_locked(const uint8_t *buf, std::size_t len) {
+    compiled_ = false;
+    prev_values_valid_ = false;
+    min_len_ = 0;
+    layout_keys_.clear();
+    fields_.clear();
 
+    int ret = (table_ == nullptr) ? compile_pmmetrics_locked(buf, len) :
+                                    compile_reg_state_locked(buf, len);
+    if (ret != 0) {
+        std::ostringstream ss;
+        LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | "
+           << (table_ == nullptr ? "pm_metrics" : "reg_state")
+           << " table of " << len << " bytes is not supported or is"
+           << " truncated");
+        return ret;
+    }
+    prev_values_.resize(fields_.size());
+    compiled_ = true;
+    return 0;
+}
+
+// pm_metrics is a flat table whose layout is given by its pmmetrics_version
+int MetricsTableDecoder::compile_pmmetrics_locked(const uint8_t *buf,
+                                                  std::size_t len) {
+    if (len < 16) {
+        return EINVAL;
+    }
+    uint32_t pmmetrics_version = static_cast<uint32_t>(
+        field_value(buf + kPmMetricsVersionOffset, FIELD_TYPE_U32));
+    const metric_field *table;
     switch (pmmetrics_version) {
         case 4:   // ??? why 4?
             table = &smu_13_0_6_v8[0];
             break;
         default:
-            fprintf(stderr, "Metrics version %d not supported\n"
-                , pmmetrics_version);
-            return -1;
+            return EINVAL;
+    }
+    layout_keys_.push_back(
+        {kPmMetricsVersionOffset, FIELD_TYPE_U32, pmmetrics_version});
+
+    std::size_t off = 0;
+    char name[MAX_RSMI_NAME_LENGTH];
+    for (int x = 0; table[x].field_name; x++) {
+        for (int y = 0; y < table[x].field_arr_size; y++) {
+            if (table[x].field_arr_size == 1) {
+                snprintf(name, sizeof(name), "%s", table[x].field_name);
+            } else {
+                snprintf(name, sizeof(name), "%s[%d]", table[x].field_name, y);
+            }
+            int ret = add_field_locked(table[x], off, len, name);
+            if (ret != 0) {
+                return ret;
+            }
+            off += table[x].field_type;
+        }
     }
-    r = parse_pmmetric_table(buf1, table, len, kv, kvnum);
-    fclose(infile);
-    free(buf1);
-    return r;
+    return 0;
 }
 
-static int parse_reg_state_table(uint8_t *buf, int32_t buflen,
-            struct metric_field *table,
-            rsmi_name_value_t **kv, uint32_t *kvnum) {
+// A reg_state section is a header followed by num_instances instance
+// blocks, each with num_smn_regs register entries. The walk, and the names
+// it gives the values, are those of the original parser; only the counts
+// decide the layout.
+int MetricsTableDecoder::compile_reg_state_locked(const uint8_t *buf,
+                                                  std::size_t len) {
+    const metric_field *table = table_;
     int skip_smn, x, y, cur_instance, cur_smn,
               num_instance, num_smn, instance_start, smn_start;
+    std::size_t off, field_off;
     uint64_t v;
-    uint8_t *obuf, *origbuf;
-    int kvsize = 64;
-
-    *kv = reinterpret_cast<rsmi_name_value_t*>(calloc(kvsize, sizeof **kv));
-    *kvnum = 0;
+    char name[MAX_RSMI_NAME_LENGTH];
 
-    skip_smn = cur_instance = num_instance = num_smn = 0;
+    skip_smn = cur_instance = cur_smn = num_instance = num_smn = 0;
     instance_start = smn_start = 0x1000;
     x = 0;
-    origbuf = buf;
+    off = 0;
 top:
     while (table[x].field_name != NULL) {
         for (y = 0; y < table[x].field_arr_size; y++) {
-            obuf = buf;
-            v = get_value(&buf, &table[x]);
-            if ((intptr_t)(buf - origbuf) > buflen) {
-                fprintf(stderr,
-                    "[ERROR] Invalid buffer as read length was exceeded\n");
-                return -1;
+            field_off = off;
+            off += table[x].field_type;
+            if (off > len) {
+                return EINVAL;
             }
+            min_len_ = std::max(min_len_, off);
+            v = field_value(buf + field_off, table[x].field_type);
             switch (table[x].field_flag) {
                 case FIELD_FLAG_INSTANCE_START:
                     instance_start = x;
                     num_smn = cur_smn = 0;
                     break;
                 case FIELD_FLAG_SMN_START:
-                    // if we hit an SMN start but there are no registers then skip back to the start
-                    // of the instance block
+                    // if we hit an SMN start but there are no registers then
+                    // skip back to the start of the instance block
                     if (skip_smn) {
                         // out of instances we're done so bail!
                         if (!num_instance)
@@ -215,9 +442,8 @@ top:
                         x = instance_start;
                         --num_instance;
                         ++cur_instance;
-                        // rewind the buffer since we didn't actually consume
-                        // this word
-                        buf = obuf;
+                        // rewind since we didn't actually consume this word
+                        off = field_off;
                         goto top;
                     } else {
                         smn_start = x;
@@ -225,30 +451,31 @@ top:
                     break;
                 case FIELD_FLAG_NUM_INSTANCE:
                     num_instance = v;
+                    layout_keys_.push_back(
+                        {static_cast<uint32_t>(field_off), table[x].field_type, v});
                     break;
                 case FIELD_FLAG_NUM_SMN:
                     num_smn = v;
-                    if (v)
-                        skip_smn = 0;
-                    else
-                        skip_smn = 1;
+                    skip_smn = v ? 0 : 1;
+                    layout_keys_.push_back(
+                        {static_cast<uint32_t>(field_off), table[x].field_type, v});
                     break;
             }
-            if (*kvnum == kvsize) {
-                kvsize += 64;
-                *kv = reinterpret_cast<rsmi_name_value_t*>(
-                              realloc(*kv, kvsize * (sizeof **kv)));
-            }
-            sprintf((*kv)[*kvnum].name, "%s", table[x].field_name);
+            int n = snprintf(name, sizeof(name), "%s", table[x].field_name);
             if (table[x].field_arr_size > 1) {
-                sprintf((*kv)[*kvnum].name + strlen((*kv)[*kvnum].name), "[%d]", y);
+                n += snprintf(name + n, sizeof(name) - n, "[%d]", y);
+            }
+            if (x >= instance_start) {
+                n += snprintf(name + n, sizeof(name) - n, ".instance[%d]",
+                              cur_instance);
+            }
+            if (x >= smn_start) {
+                snprintf(name + n, sizeof(name) - n, ".smn[%d]", cur_smn);
+            }
+            int ret = add_field_locked(table[x], field_off, len, name);
+            if (ret != 0) {
+                return ret;
             }
-            if (x >= instance_start)
-                sprintf((*kv)[*kvnum].name + strlen((*kv)[*kvnum].name), ".instance[%d]", cur_instance);
-            if (x >= smn_start)
-                sprintf((*kv)[*kvnum].name + strlen((*kv)[*kvnum].name), ".smn[%d]", cur_smn);
-            (*kv)[*kvnum].value = v;
-            ++(*kvnum);
         }
 
         // done move to next or loop
@@ -264,57 +491,89 @@ top:
     return 0;
 }
 
-/** present_reg_state: present register state data
- *
- * @dri_instance: The DRI instance to select under /sys/class/drm/card${instance}/device
- * @table: Name of the table to read {"xgmi', "wafl", "pcie", "usr", "usr_1"}
- * @kv: pointer to pointer of rsmi_name_value pairs
- * @kvnum: pointer to number of used rsmi_name_value pairs
- */
-int present_reg_state(const char* fname,
-      rsmi_reg_type_t reg_type, rsmi_name_value_t **kv, uint32_t *kvnum) {
-    uint8_t buf[4096];
-    FILE *infile;
-    struct metric_field *tab;
-    int32_t len;
-
-    infile = fopen(fname, "rb");
-    if (!infile) {
-        fprintf(stderr, "[ERROR]: reg_state file not found\n");
-        return -1;
+int MetricsTableDecoder::decode_locked(const uint8_t *buf, std::size_t len,
+                     rsmi_name_value_t *kv, uint32_t *num, bool changes_only) {
+    if (!layout_matches_locked(buf, len)) {
+        int ret = compile_locked(buf, len);
+        if (ret != 0) {
+            return ret;
+        }
     }
 
-    tab = NULL;
-    if (reg_type == RSMI_REG_XGMI) {
-        fseek(infile, AMDGPU_SYS_REG_STATE_XGMI, SEEK_SET);
-        tab = &xgmi_regs[0];
+    uint32_t n_fields = static_cast<uint32_t>(fields_.size());
+    if (kv == nullptr || *num < n_fields) {
+        *num = n_fields;
+        return (kv == nullptr) ? 0 : ENOSPC;
     }
-    if (reg_type == RSMI_REG_WAFL) {
-        fseek(infile, AMDGPU_SYS_REG_STATE_WAFL, SEEK_SET);
-        tab = &wafl_regs[0];
+
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < n_fields; ++i) {
+        const Field &f = fields_[i];
+        uint64_t v = field_value(buf + f.offset, f.size);
+        if (changes_only) {
+            bool changed = !prev_values_valid_ || prev_values_[i] != v;
+            prev_values_[i] = v;
+            if (!changed) {
+                continue;
+            }
+        }
+        memcpy(kv[n].name, f.name, sizeof(kv[n].name));
+        kv[n].value = v;
+        ++n;
     }
-    if (reg_type == RSMI_REG_PCIE) {
-        fseek(infile, AMDGPU_SYS_REG_STATE_PCIE, SEEK_SET);
-        tab = &pcie_regs[0];
+    if (changes_only) {
+        prev_values_valid_ = true;
     }
-    if (reg_type == RSMI_REG_USR) {
-        fseek(infile, AMDGPU_SYS_REG_STATE_USR, SEEK_SET);
-         tab = &usr_regs[0];
+    *num = n;
+    return 0;
+}
+
+int MetricsTableDecoder::read(const std::string &path, rsmi_name_value_t *kv,
+                              uint32_t *num, bool changes_only) {
+    assert(num != nullptr);
+    std::lock_guard<std::mutex> guard(mutex_);
+    std::size_t len = 0;
+    int ret = load_locked(path, &len);
+    if (ret != 0) {
+        return ret;
     }
-    if (reg_type == RSMI_REG_USR1) {
-        fseek(infile, AMDGPU_SYS_REG_STATE_USR_1, SEEK_SET);
-        tab = &usr_regs[0];
+    return decode_locked(buf_.data(), len, kv, num, changes_only);
+}
+
+int MetricsTableDecoder::read_alloc(const std::string &path,
+                                    rsmi_name_value_t **kv, uint32_t *num) {
+    assert(kv != nullptr && num != nullptr);
+    std::lock_guard<std::mutex> guard(mutex_);
+    std::size_t len = 0;
+    int ret = load_locked(path, &len);
+    if (ret != 0) {
+        return ret;
     }
-    if (!tab) {
-        fprintf(stderr, "[ERROR]: Invalid register space named <%d>\n", reg_type);
-        fclose(infile);
-        return -2;
+    uint32_t n = 0;
+    ret = decode_locked(buf_.data(), len, nullptr, &n, false);
+    if (ret != 0) {
+        return ret;
     }
-
-    len = fread(buf, 1, sizeof buf, infile);
-    fclose(infile);
-    return parse_reg_state_table(buf, len, tab, kv, kvnum);
+    *kv = static_cast<rsmi_name_value_t *>(
+        calloc(std::max<uint32_t>(n, 1), sizeof(rsmi_name_value_t)));
+    if (*kv == nullptr) {
+        return ENOMEM;
+    }
+    ret = decode_locked(buf_.data(), len, *kv, &n, false);
+    if (ret != 0) {
+        free(*kv);
+        *kv = nullptr;
+        return ret;
+    }
+    *num = n;
+    return 0;
 }
 
+int MetricsTableDecoder::decode(const uint8_t *buf, std::size_t len,
+                     rsmi_name_value_t *kv, uint32_t *num, bool changes_only) {
+    assert(buf != nullptr && num != nullptr);
+    std::lock_guard<std::mutex> guard(mutex_);
+    return decode_locked(buf, len, kv, num, changes_only);
+}
 
 }    //  namespace amd::smi
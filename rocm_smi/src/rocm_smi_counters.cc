@@ -140,7 +140,7 @@ GetSupportedEventGroups(uint32_t dev_num, dev_evt_grp_set_t *supported_grps) {
   std::string grp_path;
   int32_t ret;
 
-  grp_path_base = kPathDeviceEventRoot;
+  grp_path_base = FsPath(kPathDeviceEventRoot);
   grp_path_base += '/';
   struct stat file_stat;
 
@@ -164,11 +164,12 @@ GetSupportedEventGroups(uint32_t dev_num, dev_evt_grp_set_t *supported_grps) {
 }
 //  /sys/bus/event_source/devices/<hw block>_<instance>/type
 Event::Event(rsmi_event_type_t event, uint32_t dev_ind)  :
-                                       event_type_(event), fd_(-1), prev_cntr_val_(0) {
+                 event_type_(event), fd_(-1), perf_id_(0), prev_cntr_val_(0) {
   rsmi_event_group_t grp = EvtGrpFromEvtID(event);
   assert(grp != RSMI_EVNT_GRP_INVALID);  // This should have failed before now
+  event_group_ = grp;
 
-  evt_path_root_ = kPathDeviceEventRoot;
+  evt_path_root_ = FsPath(kPathDeviceEventRoot);
   evt_path_root_ += '/';
   evt_path_root_ += kEvtGrpFNameMap.at(grp);
 
@@ -185,6 +186,11 @@ Event::Event(rsmi_event_type_t event, uint32_t dev_ind)  :
                                       static_cast<char>('0' + dev_file_ind_));
 }
 Event::~Event(void) {
+  closePerfHandle();
+}
+
+void
+Event::closePerfHandle(void) {
   int ret;
   if (fd_ != -1) {
     ret = close(fd_);
@@ -192,6 +198,8 @@ Event::~Event(void) {
     if (ret == -1) {
       perror("Failed to close file descriptor.");
     }
+    fd_ = -1;
+    perf_id_ = 0;
   }
 }
 
@@ -316,10 +324,11 @@ get_perf_attr_config(std::vector<evnt_info_t> *ev_info) {
 }
 
 int32_t
-amd::smi::evt::Event::openPerfHandle(void) {
+amd::smi::evt::Event::init_perf_attr(void) {
   int32_t ret;
 
   memset(&attr_, 0, sizeof(struct perf_event_attr));
+  event_info_.clear();
 
   ret = get_event_file_info();
   if (ret) {
@@ -333,6 +342,17 @@ amd::smi::evt::Event::openPerfHandle(void) {
   attr_.size = sizeof(struct perf_event_attr);
   attr_.config = get_perf_attr_config(&event_info_);
   attr_.sample_type = PERF_SAMPLE_IDENTIFIER;
+  return 0;
+}
+
+int32_t
+amd::smi::evt::Event::openPerfHandle(void) {
+  int32_t ret;
+
+  ret = init_perf_attr();
+  if (ret) {
+    return ret;
+  }
   attr_.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED |
                           PERF_FORMAT_TOTAL_TIME_RUNNING;
   attr_.disabled = 1;
@@ -349,6 +369,39 @@ amd::smi::evt::Event::openPerfHandle(void) {
   return 0;
 }
 
+int32_t
+amd::smi::evt::Event::openGroupedPerfHandle(int32_t leader_fd) {
+  int32_t ret;
+
+  ret = init_perf_attr();
+  if (ret) {
+    return ret;
+  }
+  attr_.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                      PERF_FORMAT_TOTAL_TIME_ENABLED |
+                      PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // Only the leader starts disabled; members follow the leader's state so
+  // the whole group is scheduled on and off the PMU together. Group reads
+  // are not allowed on inherited events.
+  attr_.disabled = (leader_fd == -1) ? 1 : 0;
+  attr_.inherit = 0;
+
+  int64_t p_ret = syscall(__NR_perf_event_open, &attr_, -1, 0, leader_fd, 0);
+
+  if (p_ret < 0) {
+    return errno;
+  }
+  fd_ = static_cast<int>(p_ret);
+
+  if (ioctl(fd_, PERF_EVENT_IOC_ID, &perf_id_) == -1) {
+    ret = errno;
+    close(fd_);
+    fd_ = -1;
+    return ret;
+  }
+  return 0;
+}
+
 int32_t
 amd::smi::evt::Event::startCounter(void) {
   int32_t ret;
@@ -433,6 +486,157 @@ amd::smi::evt::Event::getValue(rsmi_counter_value_t *val) {
   return 0;
 }
 
+void
+amd::smi::evt::Event::updateValue(uint64_t raw, uint64_t enabled,
+                               uint64_t running, rsmi_counter_value_t *val) {
+  assert(val != nullptr);
+  val->value = raw - prev_cntr_val_;
+  prev_cntr_val_ = raw;
+  val->time_enabled = enabled;
+  val->time_running = running;
+}
+
+EventGroup::EventGroup(const rsmi_event_type_t *events, uint32_t num_events,
+                          uint32_t dev_ind) : dev_ind_(dev_ind), opened_(false) {
+  assert(events != nullptr);
+  std::map<rsmi_event_group_t, size_t> pmu_slot;
+
+  for (uint32_t i = 0; i < num_events; ++i) {
+    rsmi_event_group_t grp = EvtGrpFromEvtID(events[i]);
+    if (grp == RSMI_EVNT_GRP_INVALID) {
+      throw amd::smi::rsmi_exception(RSMI_STATUS_INVALID_ARGS, __FUNCTION__);
+    }
+    events_.emplace_back(new Event(events[i], dev_ind));
+
+    auto it = pmu_slot.find(grp);
+    if (it == pmu_slot.end()) {
+      it = pmu_slot.emplace(grp, pmu_groups_.size()).first;
+      pmu_groups_.emplace_back();
+    }
+    pmu_groups_[it->second].push_back(i);
+  }
+}
+
+EventGroup::~EventGroup(void) {
+  closePerfHandles();
+}
+
+void
+EventGroup::closePerfHandles(void) {
+  // Members must be closed before their leader
+  for (auto& grp : pmu_groups_) {
+    for (auto it = grp.rbegin(); it != grp.rend(); ++it) {
+      events_[*it]->closePerfHandle();
+    }
+  }
+  opened_ = false;
+}
+
+int32_t
+EventGroup::openPerfHandles(void) {
+  int32_t ret;
+
+  for (auto& grp : pmu_groups_) {
+    int32_t leader_fd = -1;
+    for (size_t ind : grp) {
+      ret = events_[ind]->openGroupedPerfHandle(leader_fd);
+      if (ret != 0) {
+        // Leave nothing half open, so a later start can retry from scratch
+        closePerfHandles();
+        return ret;
+      }
+      if (leader_fd == -1) {
+        leader_fd = events_[ind]->fd();
+      }
+    }
+  }
+
+  // Largest group read: nr, time_enabled, time_running, {value, id}[nr]
+  size_t max_grp = 0;
+  for (auto& grp : pmu_groups_) {
+    max_grp = std::max(max_grp, grp.size());
+  }
+  read_buf_.resize(3 + 2 * max_grp);
+  opened_ = true;
+  return 0;
+}
+
+int32_t
+EventGroup::ioctlGroups(unsigned long req) {  // NOLINT(runtime/int)
+  for (auto& grp : pmu_groups_) {
+    int32_t leader_fd = events_[grp.front()]->fd();
+    if (ioctl(leader_fd, req, PERF_IOC_FLAG_GROUP) == -1) {
+      return errno;
+    }
+  }
+  return 0;
+}
+
+int32_t
+EventGroup::startCounters(void) {
+  int32_t ret;
+
+  if (!opened_) {
+    ret = openPerfHandles();
+    if (ret != 0) {
+      return ret;
+    }
+  }
+  return ioctlGroups(PERF_EVENT_IOC_ENABLE);
+}
+
+int32_t
+EventGroup::stopCounters(void) {
+  if (!opened_) {
+    return EBADF;
+  }
+  return ioctlGroups(PERF_EVENT_IOC_DISABLE);
+}
+
+uint32_t
+EventGroup::getValues(rsmi_counter_value_t *vals) {
+  assert(vals != nullptr);
+
+  if (!opened_) {
+    return EBADF;
+  }
+
+  for (auto& grp : pmu_groups_) {
+    int32_t leader_fd = events_[grp.front()]->fd();
+    size_t exp_sz = (3 + 2 * grp.size()) * sizeof(uint64_t);
+
+    ssize_t ret = readn(leader_fd, read_buf_.data(), exp_sz);
+    if (ret < 0) {
+      return static_cast<uint32_t>(-ret);
+    }
+    if (static_cast<size_t>(ret) != exp_sz || read_buf_[0] != grp.size()) {
+      return EIO;
+    }
+
+    uint64_t enabled = read_buf_[1];
+    uint64_t running = read_buf_[2];
+    const uint64_t *entries = &read_buf_[3];
+
+    // The kernel reports the leader followed by members in creation order;
+    // match on id anyway so the mapping never depends on that.
+    for (size_t i = 0; i < grp.size(); ++i) {
+      uint64_t value = entries[2 * i];
+      uint64_t id = entries[2 * i + 1];
+      size_t ind = grp[i];
+      if (events_[ind]->perf_id() != id) {
+        auto it = std::find_if(grp.begin(), grp.end(),
+                      [&](size_t e) { return events_[e]->perf_id() == id; });
+        if (it == grp.end()) {
+          return EIO;
+        }
+        ind = *it;
+      }
+      events_[ind]->updateValue(value, enabled, running, &vals[ind]);
+    }
+  }
+  return 0;
+}
+
 }  // namespace evt
 }  // namespace smi
 }  // namespace amd
@@ -41,6 +41,7 @@
  *
  */
 
+#include <fcntl.h>
 #include <pthread.h>
 #include <unistd.h>
 #include <sys/stat.h>
@@ -48,7 +49,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cerrno>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iostream>
@@ -546,6 +550,7 @@ static const std::map<const char *, dev_depends_t> kDevFuncDependsMap = {
                                            kDevErrTableVersionFName}, {}}},
   {"rsmi_dev_counter_group_supported",   {{}, {}}},
   {"rsmi_dev_counter_create",            {{}, {}}},
+  {"rsmi_dev_counter_group_create",      {{}, {}}},
   {"rsmi_dev_xgmi_error_status",         {{kDevXGMIErrorFName}, {}}},
   {"rsmi_dev_xgmi_error_reset",          {{kDevXGMIErrorFName}, {}}},
   {"rsmi_dev_memory_reserved_pages_get", {{kDevMemPageBadFName}, {}}},
@@ -649,9 +654,37 @@ static const std::map<const char *, dev_depends_t> kDevFuncDependsMap = {
   if (X) return X; \
 }
 
+// Max. number of attribute files a device keeps open in its sysfs fd cache
+static const std::size_t kSysfsFdCacheMaxFds = 64;
+// sysfs attributes are at most a page long. The extra byte lets us detect
+// anything longer, which is then read through the regular stream path.
+static const std::size_t kSysfsFdCacheBufSz = 4096 + 1;
+// An open attribute file of the sysfs fd cache. Readers take a reference
+// and pread() it outside of the cache lock; the fd is closed only once the
+// cache and every such reader have dropped it, so an invalidation can never
+// close (and let the kernel reuse) a descriptor that is still being read.
+class SysfsFd {
+ public:
+  explicit SysfsFd(int fd) : fd_(fd) {}
+  ~SysfsFd() {close(fd_);}
+  SysfsFd(const SysfsFd &) = delete;
+  SysfsFd &operator=(const SysfsFd &) = delete;
+  int get(void) const {return fd_;}
+
+ private:
+  int fd_;
+};
+
 Device::Device(std::string p, RocmSMI_env_vars const *e) :
             monitor_(nullptr), path_(p), env_(e), evt_notif_anon_fd_(-1),
-                                                   m_gpu_metrics_header{0, 0, 0} {
+                                                   m_gpu_metrics_header{0, 0, 0},
+            m_gpu_metrics_cache_ttl_us(0), m_gpu_metrics_snapshot_valid(false),
+            m_gpu_metrics_snapshot_adjusted(false),
+            m_gpu_metrics_snapshot_tbl_built(false), m_partition_id_valid(false),
+            sysfs_fd_cache_enabled_(false), sysfs_fd_cache_hits_(0),
+            sysfs_fd_cache_misses_(0), sysfs_fd_cache_invalidations_(0),
+            ras_features_valid_(false), ras_features_err_(0),
+            ras_features_mask_(0) {
 #ifndef DEBUG
     env_ = nullptr;
 #endif
@@ -669,17 +702,152 @@ Device::Device(std::string p, RocmSMI_env_vars const *e) :
     throw amd::smi::rsmi_exception(RSMI_INITIALIZATION_ERROR,
                                        "Failed to create shared mem. mutex.");
   }
+
+  std::string rw_name("/rocm_smi_rdslots_");
+  rw_name += dev;
+
+  rwlock_ = shared_rwlock_init(rw_name.c_str(), 0777, mutex_.ptr);
+
+  if (rwlock_.ptr == nullptr) {
+    shared_mutex_close(mutex_);
+    throw amd::smi::rsmi_exception(RSMI_INITIALIZATION_ERROR,
+                                       "Failed to create shared mem. rwlock.");
+  }
 }
 
 Device:: ~Device() {
+  shared_rwlock_close(rwlock_);
   shared_mutex_close(mutex_);
 }
 
+void Device::set_sysfs_fd_cache_enabled(bool enabled) {
+  std::lock_guard<std::mutex> guard(sysfs_fd_cache_mutex_);
+  if (!enabled) {
+    sysfs_fd_cache_.clear();
+  }
+  sysfs_fd_cache_enabled_ = enabled;
+}
+
+void Device::invalidateSysfsFdCache(void) {
+  std::lock_guard<std::mutex> guard(sysfs_fd_cache_mutex_);
+  if (sysfs_fd_cache_.empty()) {
+    return;
+  }
+  sysfs_fd_cache_.clear();
+  ++sysfs_fd_cache_invalidations_;
+}
+
+void Device::sysfs_fd_cache_stats(rsmi_sysfs_fd_cache_stats_t *stats) {
+  assert(stats != nullptr);
+  std::lock_guard<std::mutex> guard(sysfs_fd_cache_mutex_);
+  stats->hits = sysfs_fd_cache_hits_;
+  stats->misses = sysfs_fd_cache_misses_;
+  stats->invalidations = sysfs_fd_cache_invalidations_;
+  stats->open_fds = static_cast<uint32_t>(
+      std::count_if(sysfs_fd_cache_.begin(), sysfs_fd_cache_.end(),
+          [](const std::pair<const DevInfoTypes,
+                             std::shared_ptr<SysfsFd>> &fd) {
+            return fd.second != nullptr;
+          }));
+  stats->enabled = sysfs_fd_cache_enabled_ ? 1 : 0;
+}
+
+// Reads the attribute through the sysfs fd cache into buf. Returns 0 and
+// the number of bytes read in len on success. Any other return value means
+// the attribute is not served by the cache, and the caller should fall back
+// to the regular stream path (which also takes care of error reporting).
+//
+// Only the lookup and the insertion hold sysfs_fd_cache_mutex_; the open()
+// of a new attribute and the pread() run unlocked, so concurrent readers of
+// a device do not serialize on the cache.
+int Device::readSysfsFdCached(DevInfoTypes type, char *buf,
+                              std::size_t buf_sz, std::size_t *len) {
+  assert(buf != nullptr && len != nullptr);
+  if (!sysfs_fd_cache_enabled_) {
+    return ENOTSUP;
+  }
+  // PCIe attributes live outside of the device directory and debug
+  // overrides redirect the path; leave both to openSysfsFileStream().
+  if (type >= kDevPCieTypeStart && type <= kDevPCieTypeEND) {
+    return ENOTSUP;
+  }
+#ifdef DEBUG
+  if (env_->path_DRM_root_override
+      && (env_->enum_overrides.find(type) != env_->enum_overrides.end())) {
+    return ENOTSUP;
+  }
+#endif
+
+  std::shared_ptr<SysfsFd> fd;
+  {
+    std::lock_guard<std::mutex> guard(sysfs_fd_cache_mutex_);
+    auto it = sysfs_fd_cache_.find(type);
+    if (it != sysfs_fd_cache_.end()) {
+      if (it->second == nullptr) {
+        ++sysfs_fd_cache_misses_;
+        return ENOTSUP;
+      }
+      ++sysfs_fd_cache_hits_;
+      fd = it->second;
+    } else {
+      ++sysfs_fd_cache_misses_;
+      if (sysfs_fd_cache_.size() >= kSysfsFdCacheMaxFds) {
+        return EMFILE;
+      }
+    }
+  }
+
+  if (fd == nullptr) {
+    int raw_fd = open(get_sys_file_path_by_type(type).c_str(),
+                      O_RDONLY | O_CLOEXEC);
+    int err = raw_fd < 0 ? errno : 0;
+    if (raw_fd >= 0) {
+      fd = std::make_shared<SysfsFd>(raw_fd);
+    }
+    std::lock_guard<std::mutex> guard(sysfs_fd_cache_mutex_);
+    if (!sysfs_fd_cache_enabled_) {
+      return ENOTSUP;
+    }
+    // Another reader may have cached the attribute in the meantime; use
+    // its descriptor and let ours go
+    auto ins = sysfs_fd_cache_.emplace(type, fd);
+    if (!ins.second) {
+      if (ins.first->second == nullptr) {
+        return ENOTSUP;
+      }
+      fd = ins.first->second;
+    } else if (fd == nullptr) {
+      return err;
+    }
+  }
+
+  ssize_t n = pread(fd->get(), buf, buf_sz, 0);
+  if (n < 0 || static_cast<std::size_t>(n) >= buf_sz) {
+    int err = n < 0 ? errno : EFBIG;
+    std::lock_guard<std::mutex> guard(sysfs_fd_cache_mutex_);
+    auto it = sysfs_fd_cache_.find(type);
+    // Leave the cache alone if it was invalidated while we were reading
+    if (it == sysfs_fd_cache_.end() || it->second != fd) {
+      return err;
+    }
+    if (err == ENODEV || err == ESTALE) {
+      // The device went away (e.g. driver reload); drop every descriptor
+      sysfs_fd_cache_.clear();
+      ++sysfs_fd_cache_invalidations_;
+    } else {
+      it->second = nullptr;
+    }
+    return err;
+  }
+  *len = static_cast<std::size_t>(n);
+  return 0;
+}
+
 template <typename T>
 int Device::openDebugFileStream(DevInfoTypes type, T *fs, const char *str) {
   std::string debugfs_path;
 
-  debugfs_path = kPathDebugRootFName;
+  debugfs_path = FsPath(kPathDebugRootFName);
   debugfs_path += std::to_string(index());
   debugfs_path += "/";
   debugfs_path += kDevAttribNameMap.at(type);
@@ -727,11 +895,10 @@ int Device::openSysfsFileStream(DevInfoTypes type, T *fs, const char *str) {
 
   // For the file under PCI sysfs
   if (type >= kDevPCieTypeStart && type <= kDevPCieTypeEND) {
-    sysfs_path = "/sys/bus/pci/devices/";
+    sysfs_path = FsPath("/sys/bus/pci/devices/");
     std::string bdf_str;
     if (getBDFWithDomain(bdfid_, bdf_str) != RSMI_STATUS_SUCCESS) {
-      ss << "Fail to craft the bdf string";
-      LOG_ERROR(ss);
+      LOG_ERROR_S(ss << "Fail to craft the bdf string");
       return 1;
     }
     sysfs_path += bdf_str;
@@ -744,40 +911,36 @@ int Device::openSysfsFileStream(DevInfoTypes type, T *fs, const char *str) {
 
   int ret = isRegularFile(sysfs_path, &reg_file);
   if (ret != 0) {
-    ss << __PRETTY_FUNCTION__ << " | Issue: File did not exist - SYSFS file ("
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | Issue: File did not exist - SYSFS file ("
        << sysfs_path
        << ") for DevInfoInfoType (" << get_type_string(type)
-       << "), returning " << std::to_string(ret);
-    LOG_ERROR(ss);
+       << "), returning " << std::to_string(ret));
     return ret;
   }
   if (!reg_file) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | Issue: File is not a regular file - SYSFS file ("
        << sysfs_path << ") for "
        << "DevInfoInfoType (" << get_type_string(type) << "),"
-       << " returning ENOENT (" << std::strerror(ENOENT) << ")";
-    LOG_ERROR(ss);
+       << " returning ENOENT (" << std::strerror(ENOENT) << ")");
     return ENOENT;
   }
 
   fs->open(sysfs_path);
 
   if (!fs->is_open()) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
        << " | Issue: Could not open - SYSFS file (" << sysfs_path << ") for "
        << "DevInfoInfoType (" << get_type_string(type) << "), "
        << ", returning " << std::to_string(errno) << " ("
-       << std::strerror(errno) << ")";
-    LOG_ERROR(ss);
+       << std::strerror(errno) << ")");
     return errno;
   }
 
-  ss << __PRETTY_FUNCTION__ << " | Successfully opened SYSFS file ("
+  LOG_INFO_S(ss << __PRETTY_FUNCTION__ << " | Successfully opened SYSFS file ("
      << sysfs_path
      << ") for DevInfoInfoType (" << get_type_string(type)
-     << ")";
-  LOG_INFO(ss);
+     << ")");
   return 0;
 }
 
@@ -791,10 +954,9 @@ int Device::readDebugInfoStr(DevInfoTypes type, std::string *retStr) {
 
   ret = openDebugFileStream(type, &fs);
   if (ret != 0) {
-    ss << "Could not read debugInfoStr for DevInfoType ("
+    LOG_ERROR_S(ss << "Could not read debugInfoStr for DevInfoType ("
      << get_type_string(type)<< "), returning "
-     << std::to_string(ret);
-    LOG_ERROR(ss);
+     << std::to_string(ret));
     return ret;
   }
 
@@ -805,9 +967,8 @@ int Device::readDebugInfoStr(DevInfoTypes type, std::string *retStr) {
 
   fs.close();
 
-  ss << "Successfully read debugInfoStr for DevInfoType ("
-     << get_type_string(type)<< "), retString= " << *retStr;
-  LOG_INFO(ss);
+  LOG_INFO_S(ss << "Successfully read debugInfoStr for DevInfoType ("
+     << get_type_string(type)<< "), retString= " << *retStr);
 
   return 0;
 }
@@ -819,18 +980,36 @@ int Device::readDevInfoStr(DevInfoTypes type, std::string *retStr) {
 
   assert(retStr != nullptr);
 
+  char buf[kSysfsFdCacheBufSz];
+  std::size_t len = 0;
+  if (readSysfsFdCached(type, buf, sizeof(buf), &len) == 0) {
+    // Same as "fs >> *retStr": the first whitespace delimited token
+    const char *b = buf;
+    const char *e = buf + len;
+    while (b != e && std::isspace(static_cast<unsigned char>(*b))) {
+      ++b;
+    }
+    const char *t = b;
+    while (t != e && !std::isspace(static_cast<unsigned char>(*t))) {
+      ++t;
+    }
+    if (t != b) {
+      retStr->assign(b, t);
+    }
+    return 0;
+  }
+
   ret = openSysfsFileStream(type, &fs);
   if (ret != 0) {
-    ss << "Could not read device info string for DevInfoType ("
+    LOG_ERROR_S(ss << "Could not read device info string for DevInfoType ("
      << get_type_string(type) << "), returning "
-     << std::to_string(ret);
-    LOG_ERROR(ss);
+     << std::to_string(ret));
     return ret;
   }
 
   fs >> *retStr;
   fs.close();
-  ss << __PRETTY_FUNCTION__
+  LOG_INFO_S(ss << __PRETTY_FUNCTION__
      << "Successfully read device info string for DevInfoType (" <<
             get_type_string(type) << "): " + *retStr
      << " | "
@@ -842,8 +1021,7 @@ int Device::readDevInfoStr(DevInfoTypes type, std::string *retStr) {
      << " | " << (fs.eof() ? "[ERROR] Failed read - EOF error" :
      "[GOOD] No eof - Successful read operation")
      << " | " << (fs.good() ? "[GOOD] read good - Successful read operation" :
-     "[ERROR] Failed read - good error");
-  LOG_INFO(ss);
+     "[ERROR] Failed read - good error"));
   return 0;
 }
 
@@ -865,11 +1043,10 @@ int Device::writeDevInfoStr(DevInfoTypes type, std::string valStr,
   ret = openSysfsFileStream(type, &fs, valStr.c_str());
   if (ret != 0) {
     fs.close();
-    ss << __PRETTY_FUNCTION__ << " | Issue: Could not open fileStream; "
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__ << " | Issue: Could not open fileStream; "
        << "Could not write device info string (" << valStr
        << ") for DevInfoType (" << get_type_string(type)
-       << "), returning " << std::to_string(ret);
-    LOG_ERROR(ss);
+       << "), returning " << std::to_string(ret));
     return ret;
   }
 
@@ -877,10 +1054,9 @@ int Device::writeDevInfoStr(DevInfoTypes type, std::string valStr,
   if (fs << valStr) {
     fs.flush();
     fs.close();
-    ss << "Successfully wrote device info string (" << valStr
+    LOG_INFO_S(ss << "Successfully wrote device info string (" << valStr
        << ") for DevInfoType (" << get_type_string(type)
-       << "), returning RSMI_STATUS_SUCCESS";
-    LOG_INFO(ss);
+       << "), returning RSMI_STATUS_SUCCESS");
     ret = RSMI_STATUS_SUCCESS;
   } else {
     if (returnWriteErr) {
@@ -963,8 +1139,13 @@ int Device::writeDevInfo(DevInfoTypes type, std::string val) {
     case kDevSOCClk:
       return writeDevInfoStr(type, val);
     case kDevComputePartition:
-    case kDevMemoryPartition:
-      return writeDevInfoStr(type, val, true);
+    case kDevMemoryPartition: {
+      int ret = writeDevInfoStr(type, val, true);
+      // Partition changes re-create the device's sysfs attributes
+      invalidateSysfsFdCache();
+      invalidate_gpu_metrics_snapshot();
+      return ret;
+    }
 
     default:
       return EINVAL;
@@ -980,19 +1161,25 @@ int Device::readDevInfoLine(DevInfoTypes type, std::string *line) {
 
   assert(line != nullptr);
 
+  char buf[kSysfsFdCacheBufSz];
+  std::size_t len = 0;
+  if (readSysfsFdCached(type, buf, sizeof(buf), &len) == 0) {
+    const char *nl = static_cast<const char *>(std::memchr(buf, '\n', len));
+    line->assign(buf, (nl != nullptr) ? static_cast<std::size_t>(nl - buf) : len);
+    return 0;
+  }
+
   ret = openSysfsFileStream(type, &fs);
   if (ret != 0) {
-    ss << "Could not read DevInfoLine for DevInfoType ("
-       << get_type_string(type) << ")";
-    LOG_ERROR(ss);
+    LOG_ERROR_S(ss << "Could not read DevInfoLine for DevInfoType ("
+       << get_type_string(type) << ")");
     return ret;
   }
 
   std::getline(fs, *line);
-  ss << "Successfully read DevInfoLine for DevInfoType ("
+  LOG_INFO_S(ss << "Successfully read DevInfoLine for DevInfoType ("
      << get_type_string(type) << "), returning *line = "
-     << *line;
-  LOG_INFO(ss);
+     << *line);
 
   return 0;
 }
@@ -1018,19 +1205,18 @@ int Device::readDevInfoBinary(DevInfoTypes type, std::size_t b_size,
 
   ptr = fopen(sysfs_path.c_str(), "rb");
   if (!ptr) {
-    ss << "Could not read DevInfoBinary for DevInfoType ("
+    LOG_ERROR_S(ss << "Could not read DevInfoBinary for DevInfoType ("
        << get_type_string(type) << ")"
        << " - SYSFS (" << sysfs_path << ")"
        << ", returning " << std::to_string(errno) << " ("
-       << std::strerror(errno) << ")";
-    LOG_ERROR(ss);
+       << std::strerror(errno) << ")");
     return errno;
   }
 
   size_t num = fread(p_binary_data, b_size, 1, ptr);
   fclose(ptr);
   if ((num*b_size) != b_size) {
-    ss << "Could not read DevInfoBinary for DevInfoType ("
+    LOG_ERROR_S(ss << "Could not read DevInfoBinary for DevInfoType ("
        << get_type_string(type) << ") - SYSFS ("
        << sysfs_path << "), binary size error; "
        << "[buff: "
@@ -1040,8 +1226,7 @@ int Device::readDevInfoBinary(DevInfoTypes type, std::size_t b_size,
        << " read: "
        << num
        << "]"
-       << ", returning ENOENT (" << std::strerror(ENOENT) << ")";
-    LOG_ERROR(ss);
+       << ", returning ENOENT (" << std::strerror(ENOENT) << ")");
     return ENOENT;
   }
   if (ROCmLogging::Logger::getInstance()->isLoggerEnabled()) {
@@ -1058,6 +1243,127 @@ int Device::readDevInfoBinary(DevInfoTypes type, std::size_t b_size,
   return 0;
 }
 
+// Reads a binary attribute with a single read() of up to buf_sz bytes,
+// through the sysfs fd cache when enabled. Unlike readDevInfoBinary(), an
+// attribute shorter than the buffer is not an error; the number of bytes
+// read is returned in len.
+int Device::readDevInfoBinaryBlob(DevInfoTypes type, std::size_t buf_sz,
+                                  void *p_binary_data, std::size_t *len) {
+  assert(p_binary_data != nullptr && len != nullptr);
+  std::ostringstream ss;
+  auto *buf = static_cast<char *>(p_binary_data);
+
+  *len = 0;
+  if (readSysfsFdCached(type, buf, buf_sz, len) == 0) {
+    return 0;
+  }
+
+  const auto sysfs_path = get_sys_file_path_by_type(type);
+  int fd = open(sysfs_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    int err = errno;
+    LOG_ERROR_S(ss << "Could not read DevInfoBinary for DevInfoType ("
+       << get_type_string(type) << ")"
+       << " - SYSFS (" << sysfs_path << ")"
+       << ", returning " << std::to_string(err) << " ("
+       << std::strerror(err) << ")");
+    return err;
+  }
+
+  ssize_t n = 0;
+  do {
+    n = read(fd, buf, buf_sz);
+  } while ((n < 0) && (errno == EINTR));
+  int err = (n < 0) ? errno : 0;
+  close(fd);
+  if (err != 0) {
+    LOG_ERROR_S(ss << "Could not read DevInfoBinary for DevInfoType ("
+       << get_type_string(type) << ")"
+       << " - SYSFS (" << sysfs_path << ")"
+       << ", returning " << std::to_string(err) << " ("
+       << std::strerror(err) << ")");
+    return err;
+  }
+  *len = static_cast<std::size_t>(n);
+
+  LOG_INFO_S(ss << "Successfully read DevInfoBinary for DevInfoType ("
+     << get_type_string(type) << ") - SYSFS ("
+     << sysfs_path << "), returning binaryData = " << p_binary_data
+     << "; byte_size = " << std::dec << *len);
+  return 0;
+}
+
+// ras/features reads "feature mask: 0x<mask>". The mask only changes when a
+// block is enabled or disabled through ras_ctrl, so it is re-parsed at most
+// once per kRasFeaturesTtl; a failed read is kept for as long.
+int Device::ras_features_mask(uint64_t *mask) {
+  assert(mask != nullptr);
+  std::lock_guard<std::mutex> guard(ras_features_mutex_);
+  const auto now = std::chrono::steady_clock::now();
+  if (!ras_features_valid_ || now - ras_features_time_ >= kRasFeaturesTtl) {
+    ras_features_valid_ = true;
+    ras_features_time_ = now;
+    ras_features_mask_ = 0;
+    std::string line;
+    ras_features_err_ = readDevInfoLine(kDevErrCntFeatures, &line);
+    if (ras_features_err_ == 0) {
+      const std::size_t pos = line.find(':');
+      if (pos == std::string::npos) {
+        ras_features_err_ = EBADF;
+      } else {
+        errno = 0;
+        ras_features_mask_ =
+            std::strtoull(line.c_str() + pos + 1, nullptr, 16);
+        ras_features_err_ = errno;
+      }
+    }
+  }
+  *mask = ras_features_mask_;
+  return ras_features_err_;
+}
+
+// A ras/*_err_count file is "ue: <n>\nce: <n>\n", followed by "de: <n>\n" on
+// kernels that count deferred errors. A file missing either of the first two
+// counts is reported as EBADF.
+int Device::readErrCount(DevInfoTypes type, rsmi_error_count_t *ec) {
+  assert(ec != nullptr);
+  char buf[128];
+  std::size_t len = 0;
+
+  int ret = readDevInfoBinaryBlob(type, sizeof(buf) - 1, buf, &len);
+  if (ret != 0) {
+    return ret;
+  }
+  buf[len] = '\0';
+
+  bool have_ue = false;
+  bool have_ce = false;
+  ec->deferred_err = 0;
+  for (const char *p = buf; p != nullptr && *p != '\0'; ) {
+    if (std::strncmp(p, "ue:", 3) == 0) {
+      ec->uncorrectable_err = std::strtoull(p + 3, nullptr, 10);
+      have_ue = true;
+    } else if (std::strncmp(p, "ce:", 3) == 0) {
+      ec->correctable_err = std::strtoull(p + 3, nullptr, 10);
+      have_ce = true;
+    } else if (std::strncmp(p, "de:", 3) == 0) {
+      ec->deferred_err = std::strtoull(p + 3, nullptr, 10);
+    }
+    p = std::strchr(p, '\n');
+    if (p != nullptr) {
+      ++p;
+    }
+  }
+  return (have_ue && have_ce) ? 0 : EBADF;
+}
+
+MetricsTableDecoder *Device::reg_state_decoder(rsmi_reg_type_t reg_type) {
+  if (reg_type < RSMI_REG_XGMI || reg_type > RSMI_REG_USR1) {
+    return nullptr;
+  }
+  return &reg_state_decoders_[reg_type];
+}
+
 int Device::readDevInfoMultiLineStr(DevInfoTypes type,
                                            std::vector<std::string> *retVec) {
   std::string line;
@@ -1068,20 +1374,36 @@ int Device::readDevInfoMultiLineStr(DevInfoTypes type,
 
   assert(retVec != nullptr);
 
-  ret = openSysfsFileStream(type, &fs);
-  if (ret != 0) {
-    return ret;
-  }
+  char buf[kSysfsFdCacheBufSz];
+  std::size_t len = 0;
+  if (readSysfsFdCached(type, buf, sizeof(buf), &len) == 0) {
+    const char *b = buf;
+    const char *e = buf + len;
+    while (b != e) {
+      const char *nl = static_cast<const char *>(std::memchr(b, '\n',
+                                               static_cast<std::size_t>(e - b)));
+      if (nl == nullptr) {
+        retVec->emplace_back(b, e);
+        break;
+      }
+      retVec->emplace_back(b, nl);
+      b = nl + 1;
+    }
+  } else {
+    ret = openSysfsFileStream(type, &fs);
+    if (ret != 0) {
+      return ret;
+    }
 
-  while (std::getline(fs, line)) {
-    retVec->push_back(line);
+    while (std::getline(fs, line)) {
+      retVec->push_back(line);
+    }
   }
 
   if (retVec->empty()) {
-    ss << "Read devInfoMultiLineStr for DevInfoType ("
+    LOG_ERROR_S(ss << "Read devInfoMultiLineStr for DevInfoType ("
        << get_type_string(type) << ")"
-       << ", but contained no string lines";
-    LOG_ERROR(ss);
+       << ", but contained no string lines");
     return ENXIO;
   }
   // Remove any *trailing* empty (whitespace) lines
@@ -1096,15 +1418,13 @@ int Device::readDevInfoMultiLineStr(DevInfoTypes type,
   }
 
   if (!allLines.empty()) {
-    ss << "Successfully read devInfoMultiLineStr for DevInfoType ("
+    LOG_INFO_S(ss << "Successfully read devInfoMultiLineStr for DevInfoType ("
        << get_type_string(type) << ") "
-       << ", returning lines read = " << allLines;
-    LOG_INFO(ss);
+       << ", returning lines read = " << allLines);
   } else {
-    ss << "Read devInfoMultiLineStr for DevInfoType ("
+    LOG_INFO_S(ss << "Read devInfoMultiLineStr for DevInfoType ("
        << get_type_string(type) << ")"
-       << ", but lines were empty";
-    LOG_INFO(ss);
+       << ", but lines were empty");
     return ENXIO;
   }
   return 0;
@@ -1197,6 +1517,8 @@ int Device::readDevInfo(DevInfoTypes type, uint64_t *val) {
 
     case kDevGpuReset:
       ret = readDebugInfoStr(type, &tempStr);
+      invalidateSysfsFdCache();
+      invalidate_gpu_metrics_snapshot();
       RET_IF_NONZERO(ret);
       break;
 
@@ -1362,17 +1684,189 @@ void Device::DumpSupportedFunctions(void) {
   }
 }
 
+const std::shared_ptr<Monitor>& Device::monitor() {
+  std::call_once(monitor_once_, [this]() {
+    if (monitor_finder_) {
+      monitor_ = monitor_finder_();
+    }
+  });
+  return monitor_;
+}
+
+evt::dev_evt_grp_set_t* Device::supported_event_groups(void) {
+  std::call_once(supported_event_groups_once_, [this]() {
+    evt::GetSupportedEventGroups(card_indx_, &supported_event_groups_);
+  });
+  return &supported_event_groups_;
+}
+
+static const char *kSupportedFuncNames[kSupportedFuncCount] = {
+#define RSMI_SUPPORTED_FUNC_NAME(name, family) #name,
+  RSMI_SUPPORTED_FUNC_LIST(RSMI_SUPPORTED_FUNC_NAME)
+#undef RSMI_SUPPORTED_FUNC_NAME
+};
+
+static const SupportFamily kSupportedFuncFamilies[kSupportedFuncCount] = {
+#define RSMI_SUPPORTED_FUNC_FAMILY(name, family) family,
+  RSMI_SUPPORTED_FUNC_LIST(RSMI_SUPPORTED_FUNC_FAMILY)
+#undef RSMI_SUPPORTED_FUNC_FAMILY
+};
+
+// Called once per CHK_SUPPORT call site and per probed function, so a linear
+// scan is fine
+SupportedFuncId SupportedFuncIdFromName(const char *name) {
+  for (uint32_t i = 0; i < kSupportedFuncCount; ++i) {
+    if (strcmp(kSupportedFuncNames[i], name) == 0) {
+      return static_cast<SupportedFuncId>(i);
+    }
+  }
+  return kSupportedFuncInvalid;
+}
+
+const char *SupportedFuncName(SupportedFuncId id) {
+  return (id < kSupportedFuncCount) ? kSupportedFuncNames[id] : nullptr;
+}
+
+SupportFamily SupportedFuncFamily(SupportedFuncId id) {
+  assert(id < kSupportedFuncCount);
+  return kSupportedFuncFamilies[id];
+}
+
+// The first support checks of a device may come from several threads at once
+void Device::ensureSupportFamily(SupportFamily family) {
+  std::call_once(support_family_once_[family],
+                 [this, family]() { probeSupportedFuncs(family); });
+}
+
 void Device::fillSupportedFuncs(void) {
-  if (!supported_funcs_.empty()) {
+  for (uint32_t f = 0; f < kSupportFamilyCount; ++f) {
+    ensureSupportFamily(static_cast<SupportFamily>(f));
+  }
+  std::call_once(supported_funcs_once_, [this]() {
+    for (uint32_t i = 0; i < kSupportedFuncCount; ++i) {
+      if (supported_func_bits_[i / 64].load(std::memory_order_relaxed) &
+                                                    (1ULL << (i % 64))) {
+        supported_funcs_[kSupportedFuncNames[i]] = supported_variants_[i];
+      }
+    }
+  });
+}
+
+void Device::setSupportedFunc(SupportedFuncId id,
+                              std::shared_ptr<VariantMap> variants) {
+  assert(id < kSupportedFuncCount);
+  if (id >= kSupportedFuncCount) {
+    return;
+  }
+  uint64_t variant_bits = 0;
+  if (variants != nullptr) {
+    for (const auto &v : *variants) {
+      if (v.first < 64) {
+        variant_bits |= 1ULL << v.first;
+      }
+    }
+  }
+  supported_variant_bits_[id] = variant_bits;
+  supported_variants_[id] = std::move(variants);
+  supported_func_bits_[id / 64].fetch_or(1ULL << (id % 64),
+                                          std::memory_order_relaxed);
+}
+
+void Device::supportedFuncBitmap(uint64_t bitmap[kSupportedFuncWords]) {
+  for (uint32_t f = 0; f < kSupportFamilyCount; ++f) {
+    ensureSupportFamily(static_cast<SupportFamily>(f));
+  }
+  for (uint32_t w = 0; w < kSupportedFuncWords; ++w) {
+    bitmap[w] = supported_func_bits_[w].load(std::memory_order_relaxed);
+  }
+}
+
+void Device::exportDiscovery(DiscoveryRecord *rec) {
+  assert(rec != nullptr);
+  fillSupportedFuncs();
+
+  rec->bdfid = bdfid_;
+  rec->dev_path = path_;
+  rec->hwmon_path.clear();
+  rec->temp_labels.clear();
+  rec->volt_labels.clear();
+  if (monitor() != nullptr) {
+    rec->hwmon_path = monitor()->path();
+    monitor()->getSensorLabelMaps(&rec->temp_labels, &rec->volt_labels);
+  }
+  rec->event_groups.clear();
+  for (auto grp : *supported_event_groups()) {
+    rec->event_groups.push_back(static_cast<uint32_t>(grp));
+  }
+  rec->supported_funcs = supported_funcs_;
+}
+
+void Device::restoreDiscovery(const DiscoveryRecord &rec) {
+  std::string hwmon_path = rec.hwmon_path;
+  SensorLabelList temp_labels = rec.temp_labels;
+  SensorLabelList volt_labels = rec.volt_labels;
+  monitor_finder_ = [this, hwmon_path, temp_labels, volt_labels]() {
+    std::shared_ptr<Monitor> m;
+    if (!hwmon_path.empty()) {
+      m = std::make_shared<Monitor>(hwmon_path, env_);
+      m->restoreSensorLabelMaps(temp_labels, volt_labels);
+    }
+    return m;
+  };
+
+  std::call_once(supported_event_groups_once_, [this, &rec]() {
+    for (uint32_t grp : rec.event_groups) {
+      supported_event_groups_.insert(static_cast<rsmi_event_group_t>(grp));
+    }
+  });
+  // The record covers every family
+  for (uint32_t f = 0; f < kSupportFamilyCount; ++f) {
+    std::call_once(support_family_once_[f], [this, &rec, f]() {
+      for (const auto &func : rec.supported_funcs) {
+        SupportedFuncId id = SupportedFuncIdFromName(func.first.c_str());
+        if (id != kSupportedFuncInvalid && SupportedFuncFamily(id) == f) {
+          setSupportedFunc(id, func.second);
+        }
+      }
+    });
+  }
+}
+
+void Device::probeSupportedFuncs(SupportFamily family) {
+  if (family == kSupportFamilyMonitor) {
+    SupportedFuncMap mon_funcs;
+    if (monitor() != nullptr) {
+      monitor()->fillSupportedFuncs(&mon_funcs);
+    }
+    for (auto &func : mon_funcs) {
+      SupportedFuncId id = SupportedFuncIdFromName(func.first.c_str());
+      // Every name in kMonFuncDependsMap must be in RSMI_SUPPORTED_FUNC_LIST
+      assert(id != kSupportedFuncInvalid);
+      if (id != kSupportedFuncInvalid) {
+        setSupportedFunc(id, std::move(func.second));
+      }
+    }
     return;
   }
+
   std::map<const char *, dev_depends_t>::const_iterator it =
                                                    kDevFuncDependsMap.begin();
   std::string dev_rt = path_ + "/device";
+  std::string debugfs_rt = FsPath(kPathDebugRootFName);
+  debugfs_rt += std::to_string(index());
+  debugfs_rt += "/";
   bool mand_depends_met;
   std::shared_ptr<VariantMap> supported_variants;
 
   while (it != kDevFuncDependsMap.end()) {
+    SupportedFuncId id = SupportedFuncIdFromName(it->first);
+    // Every name in kDevFuncDependsMap must be in RSMI_SUPPORTED_FUNC_LIST
+    assert(id != kSupportedFuncInvalid);
+    if (id == kSupportedFuncInvalid) {
+      it++;
+      continue;
+    }
+
     // First, see if all the mandatory dependencies are there
     std::vector<const char *>::const_iterator dep =
                                          it->second.mandatory_depends.begin();
@@ -1380,11 +1874,7 @@ void Device::fillSupportedFuncs(void) {
     mand_depends_met = true;
     for (; dep != it->second.mandatory_depends.end(); dep++) {
       std::string dep_path = dev_rt + "/" + *dep;
-      std::string debugfs_path;
-      debugfs_path = kPathDebugRootFName;
-      debugfs_path += std::to_string(index());
-      debugfs_path += "/";
-      debugfs_path += *dep;
+      std::string debugfs_path = debugfs_rt + *dep;
       if (!FileExists(dep_path.c_str()) && !FileExists(debugfs_path.c_str())) {
         mand_depends_met = false;
         break;
@@ -1400,7 +1890,7 @@ void Device::fillSupportedFuncs(void) {
                                                   it->second.variants.begin();
 
     if (it->second.variants.empty()) {
-      supported_funcs_[it->first] = nullptr;
+      setSupportedFunc(id, nullptr);
       it++;
       continue;
     }
@@ -1416,14 +1906,11 @@ void Device::fillSupportedFuncs(void) {
     }
 
     if (!(*supported_variants).empty()) {
-      supported_funcs_[it->first] = supported_variants;
+      setSupportedFunc(id, supported_variants);
     }
 
     it++;
   }
-  if (monitor() != nullptr) {
-    monitor()->fillSupportedFuncs(&supported_funcs_);
-  }
   // DumpSupportedFunctions();
 }
 
@@ -1442,22 +1929,41 @@ static bool subvariant_match(const std::shared_ptr<SubVariant> *sv,
 
 bool Device::DeviceAPISupported(std::string name, uint64_t variant,
                                                        uint64_t sub_variant) {
-  SupportedFuncMapIt func_it;
-  VariantMapIt var_it;
+  return DeviceAPISupported(SupportedFuncIdFromName(name.c_str()), variant,
+                                                                 sub_variant);
+}
 
-  fillSupportedFuncs();
-  func_it = supported_funcs_.find(name);
+bool Device::DeviceAPISupported(SupportedFuncId id, uint64_t variant,
+                                                       uint64_t sub_variant) {
+  VariantMapIt var_it;
 
-  if (func_it == supported_funcs_.end()) {
+  if (id >= kSupportedFuncCount) {
+    return false;
+  }
+  ensureSupportFamily(kSupportedFuncFamilies[id]);
+  if (!(supported_func_bits_[id / 64].load(std::memory_order_relaxed) &
+                                                     (1ULL << (id % 64)))) {
     return false;
   }
+  const std::shared_ptr<VariantMap> &variants = supported_variants_[id];
 
   if (variant != RSMI_DEFAULT_VARIANT) {
     // if variant is != RSMI_DEFAULT_VARIANT, we should not have a nullptr
-    assert(func_it->second != nullptr);
-    var_it = func_it->second->find(variant);
+    assert(variants != nullptr);
+    if (variants == nullptr) {
+      return false;
+    }
+    if (variant < 64) {
+      if (!(supported_variant_bits_[id] & (1ULL << variant))) {
+        return false;
+      }
+      if (sub_variant == RSMI_DEFAULT_VARIANT) {
+        return true;
+      }
+    }
+    var_it = variants->find(variant);
 
-    if (var_it == func_it->second->end()) {
+    if (var_it == variants->end()) {
       return false;
     }
 
@@ -1471,19 +1977,21 @@ bool Device::DeviceAPISupported(std::string name, uint64_t variant,
     return subvariant_match(&(var_it->second), sub_variant);
   }
   // variant == RSMI_DEFAULT_VARIANT
-  if (func_it->second != nullptr) {
-    var_it = func_it->second->find(variant);
-  }
   if (sub_variant == RSMI_DEFAULT_VARIANT) {
     return true;
   }
   // sub_variant != RSMI_DEFAULT_VARIANT
-  if (func_it->second == nullptr) {
+  if (variants == nullptr) {
+    return false;
+  }
+  var_it = variants->find(variant);
+  if (var_it == variants->end() || var_it->second == nullptr) {
     return false;
   }
   return subvariant_match(&(var_it->second), sub_variant);
 }
 
+
 rsmi_status_t Device::restartAMDGpuDriver(void) {
   REQUIRE_ROOT_ACCESS
   bool restartSuccessful = true;
@@ -1518,6 +2026,12 @@ rsmi_status_t Device::restartAMDGpuDriver(void) {
     restartSuccessful &= success;
   }
 
+  // Reloading amdgpu invalidates every cached sysfs descriptor
+  for (auto &dev : RocmSMI::getInstance().devices()) {
+    dev->invalidateSysfsFdCache();
+    dev->invalidate_gpu_metrics_snapshot();
+  }
+
   return (restartSuccessful ? RSMI_STATUS_SUCCESS :
           RSMI_STATUS_AMDGPU_RESTART_ERR);
 }
@@ -0,0 +1,412 @@
+/*
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rocm_smi/rocm_smi_discovery_cache.h"
+#include "rocm_smi/rocm_smi_utils.h"
+#include "rocm_smi/rocm_smi_logger.h"
+
+namespace amd {
+namespace smi {
+
+static const char kDiscoveryCacheMagic[8] = {'R', 'S', 'M', 'I',
+                                             'D', 'S', 'C', '\0'};
+// Bump this whenever the record layout below changes
+static const uint32_t kDiscoveryCacheVersion = 1;
+
+static const char *kPathBootId = "/proc/sys/kernel/random/boot_id";
+static const char *kPathAmdgpuVersion = "/sys/module/amdgpu/version";
+static const char *kPathAmdgpuSrcVersion = "/sys/module/amdgpu/srcversion";
+
+// File layout (native endianness, no padding):
+//   magic[8] | u32 version | str key | u32 num_records | records
+// record:
+//   u64 bdfid | str dev_path | str hwmon_path
+//   u32 n | n * (u64 index, u32 type)    temperature labels
+//   u32 n | n * (u64 index, u32 type)    voltage labels
+//   u32 n | n * u32                      event groups
+//   u32 n | n * func                     supported functions
+// func:    str name | u8 has_variants | [u32 n | n * variant]
+// variant: u64 id | u8 has_sub_variants | [u32 n | n * u64]
+// str:     u32 len | len bytes
+
+namespace {
+
+class CacheWriter {
+ public:
+    void u8(uint8_t v) {raw(&v, sizeof(v));}
+    void u32(uint32_t v) {raw(&v, sizeof(v));}
+    void u64(uint64_t v) {raw(&v, sizeof(v));}
+    void str(const std::string &s) {
+      u32(static_cast<uint32_t>(s.size()));
+      buf_.append(s);
+    }
+    void raw(const void *p, size_t n) {
+      buf_.append(static_cast<const char *>(p), n);
+    }
+    const std::string &buf(void) const {return buf_;}
+
+ private:
+    std::string buf_;
+};
+
+// Reads from the mapped file; every read is bounds checked and a short read
+// makes all later reads fail too.
+class CacheReader {
+ public:
+    CacheReader(const char *p, size_t n) : p_(p), end_(p + n) {}
+    bool ok(void) const {return ok_;}
+    bool raw(void *dst, size_t n) {
+      if (!ok_ || static_cast<size_t>(end_ - p_) < n) {
+        ok_ = false;
+        return false;
+      }
+      memcpy(dst, p_, n);
+      p_ += n;
+      return true;
+    }
+    uint8_t u8(void) {uint8_t v = 0; raw(&v, sizeof(v)); return v;}
+    uint32_t u32(void) {uint32_t v = 0; raw(&v, sizeof(v)); return v;}
+    uint64_t u64(void) {uint64_t v = 0; raw(&v, sizeof(v)); return v;}
+    std::string str(void) {
+      uint32_t len = u32();
+      if (!ok_ || static_cast<size_t>(end_ - p_) < len) {
+        ok_ = false;
+        return std::string();
+      }
+      std::string s(p_, len);
+      p_ += len;
+      return s;
+    }
+    // Element counts are checked against the bytes left, so a corrupt count
+    // can't make us reserve() a huge vector
+    uint32_t count(size_t min_elem_size) {
+      uint32_t n = u32();
+      if (ok_ && n > static_cast<size_t>(end_ - p_) / min_elem_size) {
+        ok_ = false;
+      }
+      return ok_ ? n : 0;
+    }
+    bool at_end(void) const {return p_ == end_;}
+
+ private:
+    const char *p_;
+    const char *end_;
+    bool ok_ = true;
+};
+
+void WriteLabels(CacheWriter *w, const SensorLabelList &labels) {
+  w->u32(static_cast<uint32_t>(labels.size()));
+  for (const auto &l : labels) {
+    w->u64(l.first);
+    w->u32(l.second);
+  }
+}
+
+SensorLabelList ReadLabels(CacheReader *r) {
+  SensorLabelList labels;
+  uint32_t n = r->count(sizeof(uint64_t) + sizeof(uint32_t));
+  labels.reserve(n);
+  for (uint32_t i = 0; i < n && r->ok(); ++i) {
+    uint64_t ind = r->u64();
+    labels.emplace_back(ind, r->u32());
+  }
+  return labels;
+}
+
+void WriteRecord(CacheWriter *w, const DiscoveryRecord &rec) {
+  w->u64(rec.bdfid);
+  w->str(rec.dev_path);
+  w->str(rec.hwmon_path);
+  WriteLabels(w, rec.temp_labels);
+  WriteLabels(w, rec.volt_labels);
+  w->u32(static_cast<uint32_t>(rec.event_groups.size()));
+  for (uint32_t g : rec.event_groups) {
+    w->u32(g);
+  }
+  w->u32(static_cast<uint32_t>(rec.supported_funcs.size()));
+  for (const auto &func : rec.supported_funcs) {
+    w->str(func.first);
+    w->u8(func.second != nullptr);
+    if (func.second == nullptr) {
+      continue;
+    }
+    w->u32(static_cast<uint32_t>(func.second->size()));
+    for (const auto &var : *func.second) {
+      w->u64(var.first);
+      w->u8(var.second != nullptr);
+      if (var.second == nullptr) {
+        continue;
+      }
+      w->u32(static_cast<uint32_t>(var.second->size()));
+      for (uint64_t sub : *var.second) {
+        w->u64(sub);
+      }
+    }
+  }
+}
+
+bool ReadRecord(CacheReader *r, DiscoveryRecord *rec) {
+  rec->bdfid = r->u64();
+  rec->dev_path = r->str();
+  rec->hwmon_path = r->str();
+  rec->temp_labels = ReadLabels(r);
+  rec->volt_labels = ReadLabels(r);
+
+  uint32_t n = r->count(sizeof(uint32_t));
+  rec->event_groups.reserve(n);
+  for (uint32_t i = 0; i < n && r->ok(); ++i) {
+    rec->event_groups.push_back(r->u32());
+  }
+
+  n = r->count(sizeof(uint32_t) + sizeof(uint8_t));
+  for (uint32_t i = 0; i < n && r->ok(); ++i) {
+    std::string name = r->str();
+    if (!r->u8()) {
+      rec->supported_funcs[name] = nullptr;
+      continue;
+    }
+    auto variants = std::make_shared<VariantMap>();
+    uint32_t n_var = r->count(sizeof(uint64_t) + sizeof(uint8_t));
+    for (uint32_t v = 0; v < n_var && r->ok(); ++v) {
+      uint64_t id = r->u64();
+      if (!r->u8()) {
+        (*variants)[id] = nullptr;
+        continue;
+      }
+      auto subs = std::make_shared<SubVariant>();
+      uint32_t n_sub = r->count(sizeof(uint64_t));
+      subs->reserve(n_sub);
+      for (uint32_t s = 0; s < n_sub && r->ok(); ++s) {
+        subs->push_back(r->u64());
+      }
+      (*variants)[id] = subs;
+    }
+    rec->supported_funcs[name] = variants;
+  }
+  return r->ok();
+}
+
+// Creates every missing directory above path, like mkdir -p of its dirname
+int MakeParentDirs(const std::string &path) {
+  std::string::size_type slash = path.find('/', 1);
+  while (slash != std::string::npos) {
+    std::string dir = path.substr(0, slash);
+    if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+      return errno;
+    }
+    slash = path.find('/', slash + 1);
+  }
+  return 0;
+}
+
+}  // namespace
+
+std::string DiscoveryCache::MakeKey(
+                  const std::vector<std::pair<uint64_t, std::string>> &devs) {
+  std::string boot_id;
+  std::string amdgpu_ver;
+
+  if (ReadSysfsStr(FsPath(kPathBootId), &boot_id) != 0 || boot_id.empty()) {
+    return std::string();
+  }
+  // In-tree amdgpu has no "version", but srcversion changes with the module
+  if (ReadSysfsStr(FsPath(kPathAmdgpuVersion), &amdgpu_ver) != 0) {
+    amdgpu_ver.clear();
+  }
+  std::string src_ver;
+  if (ReadSysfsStr(FsPath(kPathAmdgpuSrcVersion), &src_ver) == 0) {
+    amdgpu_ver += "/" + src_ver;
+  }
+
+  std::ostringstream key;
+  // Some attributes (e.g. debugfs) are only visible to root, so root and
+  // other users find different supported functions
+  key << boot_id << "|" << amdgpu_ver << "|" << (geteuid() == 0 ? "r" : "u");
+  for (const auto &d : devs) {
+    key << "|" << std::hex << d.first << "=" << d.second;
+  }
+  return key.str();
+}
+
+bool DiscoveryCache::Load(const std::string &key,
+                          std::vector<DiscoveryRecord> *records) {
+  std::ostringstream ss;
+  records->clear();
+  if (key.empty()) {
+    return false;
+  }
+
+  int fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+  if (fd < 0) {
+    ss << __PRETTY_FUNCTION__ << " | no discovery cache at " << path_;
+    LOG_DEBUG(ss);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return false;
+  }
+  // The records decide which sysfs files are read, so only trust a file
+  // that no other unprivileged user could have written
+  if (!S_ISREG(st.st_mode) || (st.st_uid != geteuid() && st.st_uid != 0) ||
+      (st.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+    close(fd);
+    ss << __PRETTY_FUNCTION__ << " | ignoring discovery cache " << path_
+       << ": bad owner or mode";
+    LOG_INFO(ss);
+    return false;
+  }
+  size_t len = static_cast<size_t>(st.st_size);
+  void *map = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+
+  CacheReader r(static_cast<const char *>(map), len);
+  char magic[sizeof(kDiscoveryCacheMagic)];
+  bool hit = r.raw(magic, sizeof(magic)) &&
+             memcmp(magic, kDiscoveryCacheMagic, sizeof(magic)) == 0 &&
+             r.u32() == kDiscoveryCacheVersion &&
+             r.str() == key && r.ok();
+  if (hit) {
+    uint32_t n = r.count(sizeof(uint64_t));
+    records->resize(n);
+    for (uint32_t i = 0; i < n && hit; ++i) {
+      hit = ReadRecord(&r, &(*records)[i]);
+    }
+    // A short count reads as 0 records; r.ok() tells it from an empty list
+    hit = hit && r.ok() && r.at_end();
+  }
+  munmap(map, len);
+
+  if (!hit) {
+    records->clear();
+  }
+  ss << __PRETTY_FUNCTION__ << " | discovery cache " << path_
+     << (hit ? " hit, " : " miss, ") << records->size() << " devices";
+  LOG_DEBUG(ss);
+  return hit;
+}
+
+int DiscoveryCache::Store(const std::string &key,
+                          const std::vector<DiscoveryRecord> &records) {
+  std::ostringstream ss;
+  if (key.empty()) {
+    return EINVAL;
+  }
+
+  CacheWriter w;
+  w.raw(kDiscoveryCacheMagic, sizeof(kDiscoveryCacheMagic));
+  w.u32(kDiscoveryCacheVersion);
+  w.str(key);
+  w.u32(static_cast<uint32_t>(records.size()));
+  for (const auto &rec : records) {
+    WriteRecord(&w, rec);
+  }
+
+  // e.g. /run/amdsmi, or the whole path under an RSMI_FS_ROOT tree; a
+  // failure shows up as a mkostemp() error below
+  (void)MakeParentDirs(path_);
+  // A fresh file with an unpredictable name, never one planted in advance
+  std::string tmp_path = path_ + ".XXXXXX";
+  int fd = mkostemp(&tmp_path[0], O_CLOEXEC);
+  if (fd < 0) {
+    int ret = errno;
+    ss << __PRETTY_FUNCTION__ << " | can't create " << tmp_path << ": "
+       << strerror(ret);
+    LOG_DEBUG(ss);
+    return ret;
+  }
+
+  const char *p = w.buf().data();
+  size_t left = w.buf().size();
+  int ret = 0;
+  // mkostemp() creates it 0600; other processes of this user class read it
+  if (fchmod(fd, 0644) != 0) {
+    ret = errno;
+  }
+  while (ret == 0 && left > 0) {
+    ssize_t n = write(fd, p, left);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ret = errno;
+      break;
+    }
+    p += n;
+    left -= static_cast<size_t>(n);
+  }
+  if (close(fd) != 0 && ret == 0) {
+    ret = errno;
+  }
+  if (ret == 0 && rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    ret = errno;
+  }
+  if (ret != 0) {
+    (void)unlink(tmp_path.c_str());
+  }
+
+  ss << __PRETTY_FUNCTION__ << " | wrote " << w.buf().size() << " bytes to "
+     << path_ << " | Returning: " << ret;
+  LOG_DEBUG(ss);
+  return ret;
+}
+
+}  // namespace smi
+}  // namespace amd
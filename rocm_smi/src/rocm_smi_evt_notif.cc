@@ -0,0 +1,491 @@
+/*
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "rocm_smi/rocm_smi_evt_notif.h"
+#include "rocm_smi/rocm_smi_utils.h"
+
+namespace amd {
+namespace smi {
+
+// epoll data of the pending records and shutdown eventfds; devices use
+// their index
+static const uint64_t kPendingKey = UINT64_MAX;
+static const uint64_t kShutdownKey = UINT64_MAX - 1;
+static const int kMaxEpollEvents = 16;
+// Records handed to the callback per wakeup
+static const uint32_t kDispatchBatch = 32;
+
+char *EvtRecordParser::space(std::size_t *len) {
+  assert(len != nullptr);
+  if (begin_ == end_) {
+    begin_ = end_ = 0;
+  } else if (begin_ > 0) {
+    std::memmove(buf_, buf_ + begin_, end_ - begin_);
+    end_ -= begin_;
+    begin_ = 0;
+  }
+  *len = kBufSz - end_;
+  return buf_ + end_;
+}
+
+bool EvtRecordParser::has_record(void) const {
+  if (begin_ == end_) {
+    return false;
+  }
+  return std::memchr(buf_ + begin_, '\n', end_ - begin_) != nullptr ||
+         (begin_ == 0 && end_ == kBufSz);
+}
+
+bool EvtRecordParser::next(rsmi_evt_notification_type_t *event,
+                           char *message, std::size_t message_sz) {
+  assert(event != nullptr && message != nullptr && message_sz > 0);
+  while (begin_ != end_) {
+    const char *p = buf_ + begin_;
+    const char *e = static_cast<const char *>(
+                          std::memchr(p, '\n', end_ - begin_));
+    std::size_t consumed;
+    bool truncated = false;
+    if (e != nullptr) {
+      consumed = static_cast<std::size_t>(e - p) + 1;
+    } else if (begin_ == 0 && end_ == kBufSz) {
+      // A record longer than the buffer; keep its start, drop the rest
+      e = buf_ + end_;
+      consumed = kBufSz;
+      truncated = true;
+    } else {
+      return false;
+    }
+    begin_ += consumed;
+    if (discard_) {
+      discard_ = truncated;
+      continue;
+    }
+    discard_ = truncated;
+
+    while (p != e && (*p == ' ' || *p == '\t')) {
+      ++p;
+    }
+    uint32_t value = 0;
+    const char *digits = p;
+    for (; p != e; ++p) {
+      int d;
+      if (*p >= '0' && *p <= '9') {
+        d = *p - '0';
+      } else if (*p >= 'a' && *p <= 'f') {
+        d = *p - 'a' + 10;
+      } else if (*p >= 'A' && *p <= 'F') {
+        d = *p - 'A' + 10;
+      } else {
+        break;
+      }
+      value = (value << 4) | static_cast<uint32_t>(d);
+    }
+    if (p == digits) {
+      continue;  // Not a record
+    }
+    while (p != e && (*p == ' ' || *p == '\t')) {
+      ++p;
+    }
+    std::size_t len = static_cast<std::size_t>(e - p);
+    if (len > message_sz - 1) {
+      len = message_sz - 1;
+    }
+    std::memcpy(message, p, len);
+    message[len] = '\0';
+    *event = static_cast<rsmi_evt_notification_type_t>(value);
+    return true;
+  }
+  return false;
+}
+
+EvtNotifier::~EvtNotifier(void) {
+  reset();
+}
+
+int EvtNotifier::init_locked(void) {
+  if (epoll_fd_ >= 0) {
+    return 0;
+  }
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd_ < 0) {
+    return errno;
+  }
+  pending_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  shutdown_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  struct epoll_event pending_ev = {};
+  pending_ev.events = EPOLLIN;
+  pending_ev.data.u64 = kPendingKey;
+  struct epoll_event shutdown_ev = {};
+  shutdown_ev.events = EPOLLIN;
+  shutdown_ev.data.u64 = kShutdownKey;
+  if (pending_fd_ < 0 || shutdown_fd_ < 0 ||
+      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, pending_fd_, &pending_ev) < 0 ||
+      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, shutdown_fd_, &shutdown_ev) < 0) {
+    int err = errno;
+    if (pending_fd_ >= 0) {
+      close(pending_fd_);
+    }
+    if (shutdown_fd_ >= 0) {
+      close(shutdown_fd_);
+    }
+    close(epoll_fd_);
+    pending_fd_ = shutdown_fd_ = epoll_fd_ = -1;
+    return err;
+  }
+  return 0;
+}
+
+int EvtNotifier::add(uint32_t dv_ind, int fd) {
+  MAKE_NAMED_SCOPE_GUARD(fdGuard, [&]() { close(fd); });
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (sources_.find(dv_ind) != sources_.end()) {
+    return EEXIST;
+  }
+  int ret = init_locked();
+  if (ret != 0) {
+    return ret;
+  }
+  int flags = fcntl(fd, F_GETFL);
+  if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+    return errno;
+  }
+  struct epoll_event ev = {};
+  ev.events = EPOLLIN;
+  ev.data.u64 = dv_ind;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+    return errno;
+  }
+  std::unique_ptr<Source> src(new Source());
+  src->fd = fd;
+  sources_.emplace(dv_ind, std::move(src));
+  fdGuard.Dismiss();
+  return 0;
+}
+
+int EvtNotifier::remove(uint32_t dv_ind) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = sources_.find(dv_ind);
+  if (it == sources_.end()) {
+    return ENOENT;
+  }
+  if (!it->second->hung_up) {
+    (void)epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->second->fd, nullptr);
+  }
+  int ret = (close(it->second->fd) < 0) ? errno : 0;
+  sources_.erase(it);
+  update_pending_locked();
+  return ret;
+}
+
+void EvtNotifier::reset(void) {
+  stop_dispatch();
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (waiters_ > 0) {
+    // Never read back, so get() calls made until the fds are closed return
+    // at once too
+    uint64_t val = 1;
+    (void)write(shutdown_fd_, &val, sizeof(val));
+    waiters_cv_.wait(lock, [this]() { return waiters_ == 0; });
+  }
+  for (auto &s : sources_) {
+    close(s.second->fd);
+  }
+  sources_.clear();
+  if (pending_fd_ >= 0) {
+    close(pending_fd_);
+    pending_fd_ = -1;
+  }
+  if (shutdown_fd_ >= 0) {
+    close(shutdown_fd_);
+    shutdown_fd_ = -1;
+  }
+  if (epoll_fd_ >= 0) {
+    close(epoll_fd_);
+    epoll_fd_ = -1;
+  }
+  pending_ = false;
+}
+
+// Reads the source until num_elem records are parsed or it has no more
+uint32_t EvtNotifier::read_source_locked(uint32_t dv_ind, Source *src,
+                                         uint32_t num_elem,
+                                         rsmi_evt_notification_data_t *data) {
+  uint32_t n = 0;
+  while (n < num_elem) {
+    if (src->parser.next(&data[n].event, data[n].message,
+                         sizeof(data[n].message))) {
+      data[n].dv_ind = dv_ind;
+      ++n;
+      continue;
+    }
+    if (src->hung_up) {
+      break;
+    }
+    std::size_t room = 0;
+    char *p = src->parser.space(&room);
+    if (room == 0) {
+      break;
+    }
+    ssize_t r = read(src->fd, p, room);
+    if (r < 0 && errno == EINTR) {
+      continue;
+    }
+    if (r == 0) {
+      // Level triggered, a closed writer would wake every epoll_wait()
+      (void)epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, src->fd, nullptr);
+      src->hung_up = true;
+    }
+    if (r <= 0) {
+      break;
+    }
+    src->parser.commit(static_cast<std::size_t>(r));
+  }
+  return n;
+}
+
+// Takes the records already parsed, then reads the sources epoll reported
+uint32_t EvtNotifier::collect_locked(const struct epoll_event *events,
+                                     int num_events, uint32_t num_elem,
+                                     rsmi_evt_notification_data_t *data) {
+  uint32_t n = 0;
+  for (auto &s : sources_) {
+    while (n < num_elem &&
+           s.second->parser.next(&data[n].event, data[n].message,
+                                 sizeof(data[n].message))) {
+      data[n].dv_ind = s.first;
+      ++n;
+    }
+  }
+  for (int i = 0; i < num_events && n < num_elem; ++i) {
+    if (events[i].data.u64 == kPendingKey ||
+        events[i].data.u64 == kShutdownKey) {
+      continue;
+    }
+    const uint32_t dv_ind = static_cast<uint32_t>(events[i].data.u64);
+    auto it = sources_.find(dv_ind);
+    if (it == sources_.end()) {
+      continue;  // Removed while we were waiting
+    }
+    n += read_source_locked(dv_ind, it->second.get(), num_elem - n, data + n);
+  }
+  return n;
+}
+
+// Keeps the pending eventfd, and so the epoll fd, readable while records
+// that were read from the kernel are still waiting in a parser
+void EvtNotifier::update_pending_locked(void) {
+  bool pending = false;
+  for (const auto &s : sources_) {
+    if (s.second->parser.has_record()) {
+      pending = true;
+      break;
+    }
+  }
+  if (pending == pending_ || pending_fd_ < 0) {
+    return;
+  }
+  uint64_t val = 1;
+  ssize_t r = pending ? write(pending_fd_, &val, sizeof(val))
+                      : read(pending_fd_, &val, sizeof(val));
+  if (r == sizeof(val)) {
+    pending_ = pending;
+  }
+}
+
+int EvtNotifier::get(int timeout_ms, uint32_t *num_elem,
+                     rsmi_evt_notification_data_t *data) {
+  assert(num_elem != nullptr && data != nullptr);
+  const uint32_t buffer_size = *num_elem;
+  *num_elem = 0;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (callback_ != nullptr) {
+    return EBUSY;
+  }
+  if (sources_.empty()) {
+    return 0;
+  }
+
+  uint32_t n = collect_locked(nullptr, 0, buffer_size, data);
+  int err = 0;
+  if (n < buffer_size) {
+    // Only block if there is nothing to return yet. Counted in waiters_,
+    // so that reset() keeps epoll_fd_ open until the wait is over.
+    struct epoll_event events[kMaxEpollEvents];
+    const int epoll_fd = epoll_fd_;
+    ++waiters_;
+    lock.unlock();
+    int num_events = epoll_wait(epoll_fd, events, kMaxEpollEvents,
+                                (n == 0) ? timeout_ms : 0);
+    err = (num_events < 0) ? errno : 0;
+    lock.lock();
+    if (--waiters_ == 0) {
+      waiters_cv_.notify_all();
+    }
+    if (num_events > 0) {
+      n += collect_locked(events, num_events, buffer_size - n, data + n);
+    }
+  }
+  update_pending_locked();
+  *num_elem = n;
+  return (n == 0) ? err : 0;
+}
+
+int EvtNotifier::fd(int *fd) {
+  assert(fd != nullptr);
+  std::lock_guard<std::mutex> guard(mutex_);
+  int ret = init_locked();
+  *fd = epoll_fd_;
+  return ret;
+}
+
+int EvtNotifier::set_callback(rsmi_evt_notification_callback_t callback,
+                              void *user_data) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    // Stopping the dispatch thread from itself would join() it from itself
+    if (dispatch_id_ == std::this_thread::get_id()) {
+      return EBUSY;
+    }
+  }
+  stop_dispatch();
+  if (callback == nullptr) {
+    return 0;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  int ret = init_locked();
+  if (ret != 0) {
+    return ret;
+  }
+  stop_fd_ = eventfd(0, EFD_CLOEXEC);
+  if (stop_fd_ < 0) {
+    return errno;
+  }
+  callback_ = callback;
+  user_data_ = user_data;
+  dispatch_thread_ = std::thread(&EvtNotifier::dispatch, this);
+  dispatch_id_ = dispatch_thread_.get_id();
+  return 0;
+}
+
+void EvtNotifier::stop_dispatch(void) {
+  std::thread thread;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!dispatch_thread_.joinable()) {
+      return;
+    }
+    uint64_t val = 1;
+    (void)write(stop_fd_, &val, sizeof(val));
+    thread = std::move(dispatch_thread_);
+  }
+  thread.join();
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  close(stop_fd_);
+  stop_fd_ = -1;
+  dispatch_id_ = std::thread::id();
+  callback_ = nullptr;
+  user_data_ = nullptr;
+}
+
+// The dispatch thread: waits on the epoll fd and the stop eventfd, and
+// calls the callback without holding the lock, so that it may call back
+// into the library
+void EvtNotifier::dispatch(void) {
+  rsmi_evt_notification_data_t batch[kDispatchBatch];
+  struct pollfd fds[2] = {};
+  rsmi_evt_notification_callback_t callback;
+  void *user_data;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    fds[0].fd = epoll_fd_;
+    fds[1].fd = stop_fd_;
+    callback = callback_;
+    user_data = user_data_;
+  }
+  fds[0].events = POLLIN;
+  fds[1].events = POLLIN;
+
+  while (true) {
+    int r = poll(fds, 2, -1);
+    if (r < 0 && errno == EINTR) {
+      continue;
+    }
+    if (r < 0 || fds[1].revents != 0) {
+      break;
+    }
+
+    uint32_t n;
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      struct epoll_event events[kMaxEpollEvents];
+      int num_events = epoll_wait(epoll_fd_, events, kMaxEpollEvents, 0);
+      n = collect_locked(events, (num_events > 0) ? num_events : 0,
+                         kDispatchBatch, batch);
+      update_pending_locked();
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+      callback(&batch[i], user_data);
+    }
+  }
+}
+
+}  // namespace smi
+}  // namespace amd
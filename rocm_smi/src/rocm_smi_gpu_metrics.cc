@@ -292,33 +292,30 @@ AMDGpuMetricVersionFlags_t translate_header_to_flag_version(const AMDGpuMetricsH
 {
   std::ostringstream ss;
   auto version_id(AMDGpuMetricVersionFlags_t::kGpuMetricNone);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   const auto flag_version = join_metrics_version(metrics_header);
   if (amdgpu_metric_version_translation_table.find(flag_version) != amdgpu_metric_version_translation_table.end()) {
     version_id = amdgpu_metric_version_translation_table.at(flag_version);
-    ss << __PRETTY_FUNCTION__
+    LOG_TRACE_S(ss << __PRETTY_FUNCTION__
                 << " | ======= end ======= "
                 << " | Success "
                 << " | Translation Tbl: " << flag_version
                 << " | Metric Version: " << stringfy_metrics_header(metrics_header)
                 << " | Returning = "
                 << static_cast<AMDGpuMetricVersionFlagId_t>(version_id)
-                << " |";
-    LOG_TRACE(ss);
+                << " |");
     return version_id;
   }
 
-  ss << __PRETTY_FUNCTION__
+  LOG_ERROR_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Fail "
               << " | Translation Tbl: " << flag_version
               << " | Metric Version: " << stringfy_metrics_header(metrics_header)
               << " | Returning = "
               << static_cast<AMDGpuMetricVersionFlagId_t>(version_id)
-              << " |";
-  LOG_ERROR(ss);
+              << " |");
   return version_id;
 }
 
@@ -326,32 +323,29 @@ uint16_t translate_flag_to_metric_version(AMDGpuMetricVersionFlags_t version_fla
 {
   std::ostringstream ss;
   auto version_id = uint16_t(0);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   for (const auto& [key, value] : amdgpu_metric_version_translation_table) {
       if (value == version_flag) {
         version_id = key;
-        ss << __PRETTY_FUNCTION__
+        LOG_TRACE_S(ss << __PRETTY_FUNCTION__
                    << " | ======= end ======= "
                    << " | Success "
                    << " | Version Flag: " << static_cast<AMDGpuMetricVersionFlagId_t>(version_flag)
                    << " | Unified Version: " << version_id
                    << " | Str. Version: " << stringfy_metric_header_version(disjoin_metrics_version(version_id))
-                   << " |";
-        LOG_TRACE(ss);
+                   << " |");
         return version_id;
       }
   }
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Fail "
               << " | Version Flag: " << static_cast<AMDGpuMetricVersionFlagId_t>(version_flag)
               << " | Unified Version: " << version_id
               << " | Str. Version: " << stringfy_metric_header_version(disjoin_metrics_version(version_id))
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
   return version_id;
 }
 
@@ -365,49 +359,402 @@ rsmi_status_t is_gpu_metrics_version_supported(const AMDGpuMetricsHeader_v1_t& m
 }
 
 
+//  Each device gets its own metrics object, so it can be kept (and reused)
+//  across queries while the device's metrics header stays the same.
 AMDGpuMetricFactories_t amd_gpu_metrics_factory_table
 {
-  {AMDGpuMetricVersionFlags_t::kGpuMetricV11, std::make_shared<GpuMetricsBase_v11_t>(GpuMetricsBase_v11_t{})},
-  {AMDGpuMetricVersionFlags_t::kGpuMetricV12, std::make_shared<GpuMetricsBase_v12_t>(GpuMetricsBase_v12_t{})},
-  {AMDGpuMetricVersionFlags_t::kGpuMetricV13, std::make_shared<GpuMetricsBase_v13_t>(GpuMetricsBase_v13_t{})},
-  {AMDGpuMetricVersionFlags_t::kGpuMetricV14, std::make_shared<GpuMetricsBase_v14_t>(GpuMetricsBase_v14_t{})},
-  {AMDGpuMetricVersionFlags_t::kGpuMetricV15, std::make_shared<GpuMetricsBase_v15_t>(GpuMetricsBase_v15_t{})},
-  {AMDGpuMetricVersionFlags_t::kGpuMetricV16, std::make_shared<GpuMetricsBase_v16_t>(GpuMetricsBase_v16_t{})},
+  {AMDGpuMetricVersionFlags_t::kGpuMetricV11, []() { return std::make_shared<GpuMetricsBase_v11_t>(); }},
+  {AMDGpuMetricVersionFlags_t::kGpuMetricV12, []() { return std::make_shared<GpuMetricsBase_v12_t>(); }},
+  {AMDGpuMetricVersionFlags_t::kGpuMetricV13, []() { return std::make_shared<GpuMetricsBase_v13_t>(); }},
+  {AMDGpuMetricVersionFlags_t::kGpuMetricV14, []() { return std::make_shared<GpuMetricsBase_v14_t>(); }},
+  {AMDGpuMetricVersionFlags_t::kGpuMetricV15, []() { return std::make_shared<GpuMetricsBase_v15_t>(); }},
+  {AMDGpuMetricVersionFlags_t::kGpuMetricV16, []() { return std::make_shared<GpuMetricsBase_v16_t>(); }},
 };
 
 GpuMetricsBasePtr amdgpu_metrics_factory(AMDGpuMetricVersionFlags_t gpu_metric_version)
 {
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   auto contains = [](const AMDGpuMetricVersionFlags_t metric_version) {
     return (amd_gpu_metrics_factory_table.find(metric_version) != amd_gpu_metrics_factory_table.end());
   };
 
   if (contains(gpu_metric_version)) {
-    ss << __PRETTY_FUNCTION__
+    LOG_TRACE_S(ss << __PRETTY_FUNCTION__
                 << " | ======= end ======= "
                 << " | Success "
                 << " | Factory Version: " << static_cast<AMDGpuMetricVersionFlagId_t>(gpu_metric_version)
-                << " |";
-    LOG_TRACE(ss);
+                << " |");
 
-    return (amd_gpu_metrics_factory_table.at(gpu_metric_version));
+    return (amd_gpu_metrics_factory_table.at(gpu_metric_version)());
   }
 
-  ss << __PRETTY_FUNCTION__
+  LOG_ERROR_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Fail "
               << " | Factory Version: " << static_cast<AMDGpuMetricVersionFlagId_t>(gpu_metric_version)
               << " | Returning = "
               << "No object from factory."
-              << " |";
-  LOG_ERROR(ss);
+              << " |");
   return nullptr;
 }
 
 
+//
+//  Compile time (offset, count, width) location of every metric unit, per
+//  gpu_metrics version. They mirror populate_metrics_dynamic_tbl(), so any
+//  metric unit added there should be added here as well.
+//
+using AMDGpuMetricsFieldEntry_t = std::pair<AMDGpuMetricsUnitType_t, AMDGpuMetricsFieldLocation_t>;
+
+#define AMDGPU_METRICS_FIELD_ELEM_T(tbl_type, member) \
+  std::remove_all_extents_t<std::remove_reference_t<decltype(std::declval<tbl_type&>().member)>>
+
+#define AMDGPU_METRICS_FIELD_SCALED(tbl_type, unit, member, scale) \
+  AMDGpuMetricsFieldEntry_t{AMDGpuMetricsUnitType_t::unit, \
+    AMDGpuMetricsFieldLocation_t{ \
+      static_cast<uint16_t>(offsetof(tbl_type, member)), \
+      static_cast<uint16_t>(sizeof(std::declval<tbl_type&>().member) / \
+                            sizeof(AMDGPU_METRICS_FIELD_ELEM_T(tbl_type, member))), \
+      static_cast<uint8_t>(sizeof(AMDGPU_METRICS_FIELD_ELEM_T(tbl_type, member))), \
+      static_cast<uint8_t>(scale)}}
+
+#define AMDGPU_METRICS_FIELD(tbl_type, unit, member) \
+  AMDGPU_METRICS_FIELD_SCALED(tbl_type, unit, member, 1)
+
+constexpr AMDGpuMetricsFieldLocationTbl_t make_field_location_tbl(
+  std::initializer_list<AMDGpuMetricsFieldEntry_t> fields)
+{
+  AMDGpuMetricsFieldLocationTbl_t field_location_tbl{};
+  for (const auto& [metric_unit, field_location] : fields) {
+    field_location_tbl[static_cast<AMDGpuMetricTypeId_t>(metric_unit)] = field_location;
+  }
+  return field_location_tbl;
+}
+
+constexpr bool is_field_location_tbl_valid(
+  const AMDGpuMetricsFieldLocationTbl_t& field_location_tbl, size_t metrics_tbl_size)
+{
+  for (const auto& field_location : field_location_tbl) {
+    if ((field_location.m_count > kRSMI_MAX_GPU_METRICS_UNIT_VALUES) ||
+        ((static_cast<size_t>(field_location.m_offset) +
+          (static_cast<size_t>(field_location.m_count) * field_location.m_width)) >
+         metrics_tbl_size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+constexpr auto kGpuMetricsFieldLocations_v11 = make_field_location_tbl({
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricTempEdge, m_temperature_edge),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricTempHotspot, m_temperature_hotspot),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricTempMem, m_temperature_mem),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricTempVrGfx, m_temperature_vrgfx),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricTempVrSoc, m_temperature_vrsoc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricTempVrMem, m_temperature_vrmem),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricTempHbm, m_temperature_hbm),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricAvgSocketPower, m_average_socket_power),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricEnergyAccumulator, m_energy_accumulator),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricAvgGfxActivity, m_average_gfx_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricAvgUmcActivity, m_average_umc_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricAvgMmActivity, m_average_mm_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricGfxActivityAccumulator, m_gfx_activity_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricMemActivityAccumulator, m_mem_activity_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricTSClockCounter, m_system_clock_counter),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricCurrFanSpeed, m_current_fan_speed),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricThrottleStatus, m_throttle_status),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricAvgGfxClockFrequency, m_average_gfxclk_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricAvgSocClockFrequency, m_average_socclk_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricAvgUClockFrequency, m_average_uclk_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricAvgVClock0Frequency, m_average_vclk0_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricAvgDClock0Frequency, m_average_dclk0_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricAvgVClock1Frequency, m_average_vclk1_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricAvgDClock1Frequency, m_average_dclk1_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricCurrGfxClock, m_current_gfxclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricCurrSocClock, m_current_socclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricCurrUClock, m_current_uclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricCurrVClock0, m_current_vclk0),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricCurrDClock0, m_current_dclk0),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricCurrVClock1, m_current_vclk1),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricCurrDClock1, m_current_dclk1),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricPcieLinkWidth, m_pcie_link_width),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v11_t, kMetricPcieLinkSpeed, m_pcie_link_speed),
+});
+
+constexpr auto kGpuMetricsFieldLocations_v12 = make_field_location_tbl({
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricTempEdge, m_temperature_edge),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricTempHotspot, m_temperature_hotspot),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricTempMem, m_temperature_mem),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricTempVrGfx, m_temperature_vrgfx),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricTempVrSoc, m_temperature_vrsoc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricTempVrMem, m_temperature_vrmem),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricTempHbm, m_temperature_hbm),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricAvgSocketPower, m_average_socket_power),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricEnergyAccumulator, m_energy_accumulator),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricAvgGfxActivity, m_average_gfx_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricAvgUmcActivity, m_average_umc_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricAvgMmActivity, m_average_mm_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricGfxActivityAccumulator, m_gfx_activity_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricMemActivityAccumulator, m_mem_activity_acc),
+  AMDGPU_METRICS_FIELD_SCALED(AMDGpuMetrics_v12_t, kMetricTSFirmware, m_firmware_timestamp, 10),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricTSClockCounter, m_system_clock_counter),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricCurrFanSpeed, m_current_fan_speed),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricThrottleStatus, m_throttle_status),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricAvgGfxClockFrequency, m_average_gfxclk_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricAvgSocClockFrequency, m_average_socclk_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricAvgUClockFrequency, m_average_uclk_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricAvgVClock0Frequency, m_average_vclk0_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricAvgDClock0Frequency, m_average_dclk0_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricAvgVClock1Frequency, m_average_vclk1_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricAvgDClock1Frequency, m_average_dclk1_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricCurrGfxClock, m_current_gfxclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricCurrSocClock, m_current_socclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricCurrUClock, m_current_uclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricCurrVClock0, m_current_vclk0),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricCurrDClock0, m_current_dclk0),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricCurrVClock1, m_current_vclk1),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricCurrDClock1, m_current_dclk1),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricPcieLinkWidth, m_pcie_link_width),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v12_t, kMetricPcieLinkSpeed, m_pcie_link_speed),
+});
+
+constexpr auto kGpuMetricsFieldLocations_v13 = make_field_location_tbl({
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricTempEdge, m_temperature_edge),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricTempHotspot, m_temperature_hotspot),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricTempMem, m_temperature_mem),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricTempVrGfx, m_temperature_vrgfx),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricTempVrSoc, m_temperature_vrsoc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricTempVrMem, m_temperature_vrmem),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricTempHbm, m_temperature_hbm),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricAvgSocketPower, m_average_socket_power),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricEnergyAccumulator, m_energy_accumulator),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricAvgGfxActivity, m_average_gfx_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricAvgUmcActivity, m_average_umc_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricAvgMmActivity, m_average_mm_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricGfxActivityAccumulator, m_gfx_activity_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricMemActivityAccumulator, m_mem_activity_acc),
+  AMDGPU_METRICS_FIELD_SCALED(AMDGpuMetrics_v13_t, kMetricTSFirmware, m_firmware_timestamp, 10),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricTSClockCounter, m_system_clock_counter),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricCurrFanSpeed, m_current_fan_speed),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricThrottleStatus, m_throttle_status),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricIndepThrottleStatus, m_indep_throttle_status),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricAvgGfxClockFrequency, m_average_gfxclk_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricAvgSocClockFrequency, m_average_socclk_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricAvgUClockFrequency, m_average_uclk_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricAvgVClock0Frequency, m_average_vclk0_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricAvgDClock0Frequency, m_average_dclk0_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricAvgVClock1Frequency, m_average_vclk1_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricAvgDClock1Frequency, m_average_dclk1_frequency),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricCurrGfxClock, m_current_gfxclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricCurrSocClock, m_current_socclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricCurrUClock, m_current_uclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricCurrVClock0, m_current_vclk0),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricCurrDClock0, m_current_dclk0),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricCurrVClock1, m_current_vclk1),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricCurrDClock1, m_current_dclk1),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricPcieLinkWidth, m_pcie_link_width),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricPcieLinkSpeed, m_pcie_link_speed),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricVoltageSoc, m_voltage_soc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricVoltageGfx, m_voltage_gfx),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v13_t, kMetricVoltageMem, m_voltage_mem),
+});
+
+constexpr auto kGpuMetricsFieldLocations_v14 = make_field_location_tbl({
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricTempHotspot, m_temperature_hotspot),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricTempMem, m_temperature_mem),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricTempVrSoc, m_temperature_vrsoc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricCurrSocketPower, m_current_socket_power),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricEnergyAccumulator, m_energy_accumulator),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricAvgGfxActivity, m_average_gfx_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricAvgUmcActivity, m_average_umc_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricVcnActivity, m_vcn_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricGfxActivityAccumulator, m_gfx_activity_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricMemActivityAccumulator, m_mem_activity_acc),
+  AMDGPU_METRICS_FIELD_SCALED(AMDGpuMetrics_v14_t, kMetricTSFirmware, m_firmware_timestamp, 10),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricTSClockCounter, m_system_clock_counter),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricThrottleStatus, m_throttle_status),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricGfxClkLockStatus, m_gfxclk_lock_status),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricPcieLinkWidth, m_pcie_link_width),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricPcieLinkSpeed, m_pcie_link_speed),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricXgmiLinkWidth, m_xgmi_link_width),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricXgmiLinkSpeed, m_xgmi_link_speed),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricPcieBandwidthAccumulator, m_pcie_bandwidth_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricPcieBandwidthInst, m_pcie_bandwidth_inst),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricPcieL0RecovCountAccumulator, m_pcie_l0_to_recov_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricPcieReplayCountAccumulator, m_pcie_replay_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricPcieReplayRollOverCountAccumulator, m_pcie_replay_rover_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricXgmiReadDataAccumulator, m_xgmi_read_data_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricXgmiWriteDataAccumulator, m_xgmi_write_data_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricCurrGfxClock, m_current_gfxclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricCurrSocClock, m_current_socclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricCurrVClock0, m_current_vclk0),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricCurrDClock0, m_current_dclk0),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v14_t, kMetricCurrUClock, m_current_uclk),
+});
+
+constexpr auto kGpuMetricsFieldLocations_v15 = make_field_location_tbl({
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricTempHotspot, m_temperature_hotspot),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricTempMem, m_temperature_mem),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricTempVrSoc, m_temperature_vrsoc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricCurrSocketPower, m_current_socket_power),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricEnergyAccumulator, m_energy_accumulator),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricAvgGfxActivity, m_average_gfx_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricAvgUmcActivity, m_average_umc_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricVcnActivity, m_vcn_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricJpegActivity, m_jpeg_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricGfxActivityAccumulator, m_gfx_activity_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricMemActivityAccumulator, m_mem_activity_acc),
+  AMDGPU_METRICS_FIELD_SCALED(AMDGpuMetrics_v15_t, kMetricTSFirmware, m_firmware_timestamp, 10),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricTSClockCounter, m_system_clock_counter),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricThrottleStatus, m_throttle_status),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricGfxClkLockStatus, m_gfxclk_lock_status),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricPcieLinkWidth, m_pcie_link_width),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricPcieLinkSpeed, m_pcie_link_speed),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricXgmiLinkWidth, m_xgmi_link_width),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricXgmiLinkSpeed, m_xgmi_link_speed),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricPcieBandwidthAccumulator, m_pcie_bandwidth_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricPcieBandwidthInst, m_pcie_bandwidth_inst),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricPcieL0RecovCountAccumulator, m_pcie_l0_to_recov_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricPcieReplayCountAccumulator, m_pcie_replay_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricPcieReplayRollOverCountAccumulator, m_pcie_replay_rover_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricPcieNakSentCountAccumulator, m_pcie_nak_sent_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricPcieNakReceivedCountAccumulator, m_pcie_nak_rcvd_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricXgmiReadDataAccumulator, m_xgmi_read_data_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricXgmiWriteDataAccumulator, m_xgmi_write_data_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricCurrGfxClock, m_current_gfxclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricCurrSocClock, m_current_socclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricCurrVClock0, m_current_vclk0),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricCurrDClock0, m_current_dclk0),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v15_t, kMetricCurrUClock, m_current_uclk),
+});
+
+constexpr auto kGpuMetricsFieldLocations_v16 = make_field_location_tbl({
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricTempHotspot, m_temperature_hotspot),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricTempMem, m_temperature_mem),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricTempVrSoc, m_temperature_vrsoc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricCurrSocketPower, m_current_socket_power),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricEnergyAccumulator, m_energy_accumulator),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricAvgGfxActivity, m_average_gfx_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricAvgUmcActivity, m_average_umc_activity),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricGfxActivityAccumulator, m_gfx_activity_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricMemActivityAccumulator, m_mem_activity_acc),
+  AMDGPU_METRICS_FIELD_SCALED(AMDGpuMetrics_v16_t, kMetricTSFirmware, m_firmware_timestamp, 10),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricTSClockCounter, m_system_clock_counter),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricGfxClkLockStatus, m_gfxclk_lock_status),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricPcieLinkWidth, m_pcie_link_width),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricPcieLinkSpeed, m_pcie_link_speed),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricXgmiLinkWidth, m_xgmi_link_width),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricXgmiLinkSpeed, m_xgmi_link_speed),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricPcieBandwidthAccumulator, m_pcie_bandwidth_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricPcieBandwidthInst, m_pcie_bandwidth_inst),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricPcieL0RecovCountAccumulator, m_pcie_l0_to_recov_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricPcieReplayCountAccumulator, m_pcie_replay_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricPcieReplayRollOverCountAccumulator, m_pcie_replay_rover_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricPcieNakSentCountAccumulator, m_pcie_nak_sent_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricPcieNakReceivedCountAccumulator, m_pcie_nak_rcvd_count_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricXgmiReadDataAccumulator, m_xgmi_read_data_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricXgmiWriteDataAccumulator, m_xgmi_write_data_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricCurrGfxClock, m_current_gfxclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricCurrSocClock, m_current_socclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricCurrVClock0, m_current_vclk0),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricCurrDClock0, m_current_dclk0),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricCurrUClock, m_current_uclk),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricAccumulationCounter, m_accumulation_counter),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricProchotResidencyAccumulator, m_prochot_residency_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricPPTResidencyAccumulator, m_ppt_residency_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricSocketThmResidencyAccumulator, m_socket_thm_residency_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricVRThmResidencyAccumulator, m_vr_thm_residency_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricHBMThmResidencyAccumulator, m_hbm_thm_residency_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kGpuMetricNumPartition, m_num_partition),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricGfxBusyInst, m_xcp_stats[0].gfx_busy_inst),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricVcnBusy, m_xcp_stats[0].vcn_busy),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricJpegBusy, m_xcp_stats[0].jpeg_busy),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricGfxBusyAcc, m_xcp_stats[0].gfx_busy_acc),
+  AMDGPU_METRICS_FIELD(AMDGpuMetrics_v16_t, kMetricPcieLCPerfOtherEndRecov, m_pcie_lc_perf_other_end_recovery),
+});
+
+static_assert(is_field_location_tbl_valid(kGpuMetricsFieldLocations_v11, sizeof(AMDGpuMetrics_v11_t)));
+static_assert(is_field_location_tbl_valid(kGpuMetricsFieldLocations_v12, sizeof(AMDGpuMetrics_v12_t)));
+static_assert(is_field_location_tbl_valid(kGpuMetricsFieldLocations_v13, sizeof(AMDGpuMetrics_v13_t)));
+static_assert(is_field_location_tbl_valid(kGpuMetricsFieldLocations_v14, sizeof(AMDGpuMetrics_v14_t)));
+static_assert(is_field_location_tbl_valid(kGpuMetricsFieldLocations_v15, sizeof(AMDGpuMetrics_v15_t)));
+static_assert(is_field_location_tbl_valid(kGpuMetricsFieldLocations_v16, sizeof(AMDGpuMetrics_v16_t)));
+
+const AMDGpuMetricsFieldLocation_t* gpu_metrics_field_location(
+  AMDGpuMetricVersionFlags_t gpu_metric_version, AMDGpuMetricsUnitType_t metric_unit)
+{
+  const AMDGpuMetricsFieldLocationTbl_t* field_location_tbl = nullptr;
+  switch (gpu_metric_version) {
+    case AMDGpuMetricVersionFlags_t::kGpuMetricV11:
+      field_location_tbl = &kGpuMetricsFieldLocations_v11;
+      break;
+    case AMDGpuMetricVersionFlags_t::kGpuMetricV12:
+      field_location_tbl = &kGpuMetricsFieldLocations_v12;
+      break;
+    case AMDGpuMetricVersionFlags_t::kGpuMetricV13:
+      field_location_tbl = &kGpuMetricsFieldLocations_v13;
+      break;
+    case AMDGpuMetricVersionFlags_t::kGpuMetricV14:
+      field_location_tbl = &kGpuMetricsFieldLocations_v14;
+      break;
+    case AMDGpuMetricVersionFlags_t::kGpuMetricV15:
+      field_location_tbl = &kGpuMetricsFieldLocations_v15;
+      break;
+    case AMDGpuMetricVersionFlags_t::kGpuMetricV16:
+      field_location_tbl = &kGpuMetricsFieldLocations_v16;
+      break;
+    default:
+      return nullptr;
+  }
+
+  const auto metric_unit_idx = static_cast<AMDGpuMetricTypeId_t>(metric_unit);
+  if ((metric_unit_idx >= field_location_tbl->size()) ||
+      ((*field_location_tbl)[metric_unit_idx].m_count == 0)) {
+    return nullptr;
+  }
+  return &(*field_location_tbl)[metric_unit_idx];
+}
+
+uint64_t gpu_metrics_field_value(const void* raw_metrics_tbl,
+  const AMDGpuMetricsFieldLocation_t& field_location, uint16_t value_idx)
+{
+  assert(raw_metrics_tbl != nullptr);
+  assert(value_idx < field_location.m_count);
+  const auto* value_ptr = static_cast<const uint8_t*>(raw_metrics_tbl) +
+                          field_location.m_offset +
+                          (value_idx * field_location.m_width);
+
+  auto value = uint64_t(0);
+  switch (field_location.m_width) {
+    case sizeof(uint8_t):
+      value = *value_ptr;
+      break;
+    case sizeof(uint16_t):
+      {
+        uint16_t tmp_value;
+        std::memcpy(&tmp_value, value_ptr, sizeof(tmp_value));
+        value = tmp_value;
+      }
+      break;
+    case sizeof(uint32_t):
+      {
+        uint32_t tmp_value;
+        std::memcpy(&tmp_value, value_ptr, sizeof(tmp_value));
+        value = tmp_value;
+      }
+      break;
+    case sizeof(uint64_t):
+      std::memcpy(&value, value_ptr, sizeof(value));
+      break;
+    default:
+      assert(false);
+      break;
+  }
+  return (value * field_location.m_scale);
+}
+
 template<typename>
 constexpr bool is_dependent_false_v = false;
 
@@ -677,44 +1024,38 @@ void GpuMetricsBase_v16_t::dump_internal_metrics_table()
   LOG_DEBUG(ss);
 }
 
+//
+//  Note: Any metric treatment/changes (if any) should happen before they
+//        get written to internal/external tables.
+//
+void GpuMetricsBase_v16_t::run_metric_adjustments() {
+  std::ostringstream ss;
+  const auto gpu_metrics_version =
+    translate_flag_to_metric_version(get_gpu_metrics_version_used());
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
+              << " | ======= info ======= "
+              << " | Applying adjustments "
+              << " | Metric Version: " << stringfy_metric_header_version(
+                                            disjoin_metrics_version(gpu_metrics_version))
+              << " |");
+
+  // firmware_timestamp is at 10ns resolution
+  LOG_DEBUG_S(ss << __PRETTY_FUNCTION__
+              << " | ======= Changes ======= "
+              << " | {m_firmware_timestamp} from: " << m_gpu_metrics_tbl.m_firmware_timestamp
+              << " to: " << (m_gpu_metrics_tbl.m_firmware_timestamp * 10));
+  m_gpu_metrics_tbl.m_firmware_timestamp = (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
+}
+
 rsmi_status_t GpuMetricsBase_v16_t::populate_metrics_dynamic_tbl() {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   if (!m_metrics_dynamic_tbl.empty()) {
     m_metrics_dynamic_tbl.clear();
   }
 
-  //
-  //  Note: Any metric treatment/changes (if any) should happen before they
-  //        get written to internal/external tables.
-  //
-  auto run_metric_adjustments_v16 = [&]() {
-    ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-    const auto gpu_metrics_version =
-      translate_flag_to_metric_version(get_gpu_metrics_version_used());
-    ss << __PRETTY_FUNCTION__
-                << " | ======= info ======= "
-                << " | Applying adjustments "
-                << " | Metric Version: " << stringfy_metric_header_version(
-                                              disjoin_metrics_version(gpu_metrics_version))
-                << " |";
-    LOG_TRACE(ss);
-
-    // firmware_timestamp is at 10ns resolution
-    ss << __PRETTY_FUNCTION__
-                << " | ======= Changes ======= "
-                << " | {m_firmware_timestamp} from: " << m_gpu_metrics_tbl.m_firmware_timestamp
-                << " to: " << (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
-    m_gpu_metrics_tbl.m_firmware_timestamp = (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
-    LOG_DEBUG(ss);
-  };
-
-  //  Adjustments/Changes specific to this version
-  run_metric_adjustments_v16();
-
   // Temperature Info
   m_metrics_dynamic_tbl[AMDGpuMetricsClassId_t::kGpuMetricTemperature]
     .insert(std::make_pair(AMDGpuMetricsUnitType_t::kMetricTempHotspot,
@@ -908,12 +1249,11 @@ rsmi_status_t GpuMetricsBase_v16_t::populate_metrics_dynamic_tbl() {
            format_metric_row(m_gpu_metrics_tbl.m_pcie_lc_perf_other_end_recovery,
           "pcie_lc_perf_other_end_recovery")));
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Returning = " << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
 
   return status_code;
 }
@@ -1022,48 +1362,40 @@ void GpuMetricsBase_v15_t::dump_internal_metrics_table()
     ++idx;
   }
 
-  ss  << " padding: " << m_gpu_metrics_tbl.m_padding << "\n";
-  LOG_DEBUG(ss);
+  LOG_DEBUG_S(ss  << " padding: " << m_gpu_metrics_tbl.m_padding << "\n");
+}
+
+//
+//  Note: Any metric treatment/changes (if any) should happen before they
+//        get written to internal/external tables.
+//
+void GpuMetricsBase_v15_t::run_metric_adjustments() {
+  std::ostringstream ss;
+  const auto gpu_metrics_version = translate_flag_to_metric_version(get_gpu_metrics_version_used());
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
+              << " | ======= info ======= "
+              << " | Applying adjustments "
+              << " | Metric Version: " << stringfy_metric_header_version(
+                                            disjoin_metrics_version(gpu_metrics_version))
+              << " |");
+
+  // firmware_timestamp is at 10ns resolution
+  LOG_DEBUG_S(ss << __PRETTY_FUNCTION__
+              << " | ======= Changes ======= "
+              << " | {m_firmware_timestamp} from: " << m_gpu_metrics_tbl.m_firmware_timestamp
+              << " to: " << (m_gpu_metrics_tbl.m_firmware_timestamp * 10));
+  m_gpu_metrics_tbl.m_firmware_timestamp = (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
 }
 
 rsmi_status_t GpuMetricsBase_v15_t::populate_metrics_dynamic_tbl() {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   if (!m_metrics_dynamic_tbl.empty()) {
     m_metrics_dynamic_tbl.clear();
   }
 
-  //
-  //  Note: Any metric treatment/changes (if any) should happen before they
-  //        get written to internal/external tables.
-  //
-  auto run_metric_adjustments_v15 = [&]() {
-    ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-    const auto gpu_metrics_version = translate_flag_to_metric_version(get_gpu_metrics_version_used());
-    ss << __PRETTY_FUNCTION__
-                << " | ======= info ======= "
-                << " | Applying adjustments "
-                << " | Metric Version: " << stringfy_metric_header_version(
-                                              disjoin_metrics_version(gpu_metrics_version))
-                << " |";
-    LOG_TRACE(ss);
-
-    // firmware_timestamp is at 10ns resolution
-    ss << __PRETTY_FUNCTION__
-                << " | ======= Changes ======= "
-                << " | {m_firmware_timestamp} from: " << m_gpu_metrics_tbl.m_firmware_timestamp
-                << " to: " << (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
-    m_gpu_metrics_tbl.m_firmware_timestamp = (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
-    LOG_DEBUG(ss);
-  };
-
-
-  //  Adjustments/Changes specific to this version
-  run_metric_adjustments_v15();
-
   // Temperature Info
   m_metrics_dynamic_tbl[AMDGpuMetricsClassId_t::kGpuMetricTemperature]
     .insert(std::make_pair(AMDGpuMetricsUnitType_t::kMetricTempHotspot,
@@ -1245,12 +1577,11 @@ rsmi_status_t GpuMetricsBase_v15_t::populate_metrics_dynamic_tbl() {
                                 "current_uclk"))
            );
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Returning = " << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
 
   return status_code;
 }
@@ -1351,48 +1682,40 @@ void GpuMetricsBase_v14_t::dump_internal_metrics_table()
     ++idx;
   }
 
-  ss  << " padding: " << m_gpu_metrics_tbl.m_padding << "\n";
-  LOG_DEBUG(ss);
+  LOG_DEBUG_S(ss  << " padding: " << m_gpu_metrics_tbl.m_padding << "\n");
+}
+
+//
+//  Note: Any metric treatment/changes (if any) should happen before they
+//        get written to internal/external tables.
+//
+void GpuMetricsBase_v14_t::run_metric_adjustments() {
+  std::ostringstream ss;
+  const auto gpu_metrics_version = translate_flag_to_metric_version(get_gpu_metrics_version_used());
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
+              << " | ======= info ======= "
+              << " | Applying adjustments "
+              << " | Metric Version: " << stringfy_metric_header_version(
+                                            disjoin_metrics_version(gpu_metrics_version))
+              << " |");
+
+  // firmware_timestamp is at 10ns resolution
+  LOG_DEBUG_S(ss << __PRETTY_FUNCTION__
+              << " | ======= Changes ======= "
+              << " | {m_firmware_timestamp} from: " << m_gpu_metrics_tbl.m_firmware_timestamp
+              << " to: " << (m_gpu_metrics_tbl.m_firmware_timestamp * 10));
+  m_gpu_metrics_tbl.m_firmware_timestamp = (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
 }
 
 rsmi_status_t GpuMetricsBase_v14_t::populate_metrics_dynamic_tbl() {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   if (!m_metrics_dynamic_tbl.empty()) {
     m_metrics_dynamic_tbl.clear();
   }
 
-  //
-  //  Note: Any metric treatment/changes (if any) should happen before they
-  //        get written to internal/external tables.
-  //
-  auto run_metric_adjustments_v14 = [&]() {
-    ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-    const auto gpu_metrics_version = translate_flag_to_metric_version(get_gpu_metrics_version_used());
-    ss << __PRETTY_FUNCTION__
-                << " | ======= info ======= "
-                << " | Applying adjustments "
-                << " | Metric Version: " << stringfy_metric_header_version(
-                                              disjoin_metrics_version(gpu_metrics_version))
-                << " |";
-    LOG_TRACE(ss);
-
-    // firmware_timestamp is at 10ns resolution
-    ss << __PRETTY_FUNCTION__
-                << " | ======= Changes ======= "
-                << " | {m_firmware_timestamp} from: " << m_gpu_metrics_tbl.m_firmware_timestamp
-                << " to: " << (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
-    m_gpu_metrics_tbl.m_firmware_timestamp = (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
-    LOG_DEBUG(ss);
-  };
-
-
-  //  Adjustments/Changes specific to this version
-  run_metric_adjustments_v14();
-
   // Temperature Info
   m_metrics_dynamic_tbl[AMDGpuMetricsClassId_t::kGpuMetricTemperature]
     .insert(std::make_pair(AMDGpuMetricsUnitType_t::kMetricTempHotspot,
@@ -1559,12 +1882,11 @@ rsmi_status_t GpuMetricsBase_v14_t::populate_metrics_dynamic_tbl() {
                                 "current_uclk"))
            );
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success "
      << " | Returning = " << getRSMIStatusString(status_code)
-     << " |";
-  LOG_TRACE(ss);
+     << " |");
 
   return status_code;
 }
@@ -1573,8 +1895,7 @@ rsmi_status_t init_max_public_gpu_matrics(AMGpuMetricsPublicLatest_t& rsmi_gpu_m
 {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   rsmi_gpu_metrics.temperature_edge = init_max_uint_types<decltype(rsmi_gpu_metrics.temperature_edge)>();
   rsmi_gpu_metrics.temperature_hotspot = init_max_uint_types<decltype(rsmi_gpu_metrics.temperature_hotspot)>();
@@ -1687,12 +2008,11 @@ rsmi_status_t init_max_public_gpu_matrics(AMGpuMetricsPublicLatest_t& rsmi_gpu_m
               init_max_uint_types<std::uint64_t>());
   }
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success "
      << " | Returning = " << getRSMIStatusString(status_code)
-     << " |";
-  LOG_TRACE(ss);
+     << " |");
 
   return status_code;
 }
@@ -1701,8 +2021,7 @@ AMGpuMetricsPublicLatestTupl_t GpuMetricsBase_v16_t::copy_internal_to_external_m
 {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   auto copy_data_from_internal_metrics_tbl = [&]() {
     AMGpuMetricsPublicLatest_t metrics_public_init{};
@@ -1892,12 +2211,11 @@ AMGpuMetricsPublicLatestTupl_t GpuMetricsBase_v16_t::copy_internal_to_external_m
     return metrics_public_init;
   }();
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
      << " | ======= end ======= "
      << " | Success "
      << " | Returning = " << getRSMIStatusString(status_code)
-     << " |";
-  LOG_TRACE(ss);
+     << " |");
 
   return std::make_tuple(status_code, copy_data_from_internal_metrics_tbl);
 }
@@ -1906,8 +2224,7 @@ AMGpuMetricsPublicLatestTupl_t GpuMetricsBase_v15_t::copy_internal_to_external_m
 {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   auto copy_data_from_internal_metrics_tbl = [&]() {
     AMGpuMetricsPublicLatest_t metrics_public_init{};
@@ -2082,12 +2399,11 @@ AMGpuMetricsPublicLatestTupl_t GpuMetricsBase_v15_t::copy_internal_to_external_m
     return metrics_public_init;
   }();
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Returning = " << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
 
   return std::make_tuple(status_code, copy_data_from_internal_metrics_tbl);
 }
@@ -2096,8 +2412,7 @@ AMGpuMetricsPublicLatestTupl_t GpuMetricsBase_v14_t::copy_internal_to_external_m
 {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   auto copy_data_from_internal_metrics_tbl = [&]() {
     AMGpuMetricsPublicLatest_t metrics_public_init{};
@@ -2257,12 +2572,11 @@ AMGpuMetricsPublicLatestTupl_t GpuMetricsBase_v14_t::copy_internal_to_external_m
     return metrics_public_init;
   }();
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Returning = " << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
 
   return std::make_tuple(status_code, copy_data_from_internal_metrics_tbl);
 }
@@ -2339,44 +2653,37 @@ void GpuMetricsBase_v13_t::dump_internal_metrics_table()
   LOG_DEBUG(ss);
 }
 
+//
+//  Note: Any metric treatment/changes (if any) should happen before they
+//        get written to internal/external tables.
+//
+void GpuMetricsBase_v13_t::run_metric_adjustments() {
+  std::ostringstream ss;
+  const auto gpu_metrics_version = translate_flag_to_metric_version(get_gpu_metrics_version_used());
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
+              << " | ======= info ======= "
+              << " | Applying adjustments "
+              << " | Metric Version: " << stringfy_metric_header_version(
+                                            disjoin_metrics_version(gpu_metrics_version))
+              << " |");
+
+  // firmware_timestamp is at 10ns resolution
+  LOG_DEBUG_S(ss << __PRETTY_FUNCTION__
+              << " | ======= Changes ======= "
+              << " | {m_firmware_timestamp} from: " << m_gpu_metrics_tbl.m_firmware_timestamp
+              << " to: " << (m_gpu_metrics_tbl.m_firmware_timestamp * 10));
+  m_gpu_metrics_tbl.m_firmware_timestamp = (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
+}
+
 rsmi_status_t GpuMetricsBase_v13_t::populate_metrics_dynamic_tbl() {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   if (!m_metrics_dynamic_tbl.empty()) {
     m_metrics_dynamic_tbl.clear();
   }
 
-  //
-  //  Note: Any metric treatment/changes (if any) should happen before they
-  //        get written to internal/external tables.
-  //
-  auto run_metric_adjustments_v13 = [&]() {
-    ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-    const auto gpu_metrics_version = translate_flag_to_metric_version(get_gpu_metrics_version_used());
-    ss << __PRETTY_FUNCTION__
-                << " | ======= info ======= "
-                << " | Applying adjustments "
-                << " | Metric Version: " << stringfy_metric_header_version(
-                                              disjoin_metrics_version(gpu_metrics_version))
-                << " |";
-    LOG_TRACE(ss);
-
-    // firmware_timestamp is at 10ns resolution
-    ss << __PRETTY_FUNCTION__
-                << " | ======= Changes ======= "
-                << " | {m_firmware_timestamp} from: " << m_gpu_metrics_tbl.m_firmware_timestamp
-                << " to: " << (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
-    m_gpu_metrics_tbl.m_firmware_timestamp = (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
-    LOG_DEBUG(ss);
-  };
-
-
-  //  Adjustments/Changes specific to this version
-  run_metric_adjustments_v13();
-
   // Temperature Info
   m_metrics_dynamic_tbl[AMDGpuMetricsClassId_t::kGpuMetricTemperature]
     .insert(std::make_pair(AMDGpuMetricsUnitType_t::kMetricTempEdge,
@@ -2587,12 +2894,11 @@ rsmi_status_t GpuMetricsBase_v13_t::populate_metrics_dynamic_tbl() {
                                 "voltage_mem"))
            );
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Returning = " << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
 
   return status_code;
 }
@@ -2601,8 +2907,7 @@ AMGpuMetricsPublicLatestTupl_t GpuMetricsBase_v13_t::copy_internal_to_external_m
 {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   auto copy_data_from_internal_metrics_tbl = [&]() {
     AMGpuMetricsPublicLatest_t metrics_public_init{};
@@ -2712,54 +3017,46 @@ AMGpuMetricsPublicLatestTupl_t GpuMetricsBase_v13_t::copy_internal_to_external_m
     return metrics_public_init;
   }();
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Returning = " << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
 
   return std::make_tuple(status_code, copy_data_from_internal_metrics_tbl);
 }
 
+//
+//  Note: Any metric treatment/changes (if any) should happen before they
+//        get written to internal/external tables.
+//
+void GpuMetricsBase_v12_t::run_metric_adjustments() {
+  std::ostringstream ss;
+  const auto gpu_metrics_version = translate_flag_to_metric_version(get_gpu_metrics_version_used());
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
+              << " | ======= info ======= "
+              << " | Applying adjustments "
+              << " | Metric Version: " << stringfy_metric_header_version(
+                                            disjoin_metrics_version(gpu_metrics_version))
+              << " |");
+
+  // firmware_timestamp is at 10ns resolution
+  LOG_DEBUG_S(ss << __PRETTY_FUNCTION__
+              << " | ======= Changes ======= "
+              << " | {m_firmware_timestamp} from: " << m_gpu_metrics_tbl.m_firmware_timestamp
+              << " to: " << (m_gpu_metrics_tbl.m_firmware_timestamp * 10));
+  m_gpu_metrics_tbl.m_firmware_timestamp = (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
+}
+
 rsmi_status_t GpuMetricsBase_v12_t::populate_metrics_dynamic_tbl() {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   if (!m_metrics_dynamic_tbl.empty()) {
     m_metrics_dynamic_tbl.clear();
   }
 
-  //
-  //  Note: Any metric treatment/changes (if any) should happen before they
-  //        get written to internal/external tables.
-  //
-  auto run_metric_adjustments_v12 = [&]() {
-    ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-    const auto gpu_metrics_version = translate_flag_to_metric_version(get_gpu_metrics_version_used());
-    ss << __PRETTY_FUNCTION__
-                << " | ======= info ======= "
-                << " | Applying adjustments "
-                << " | Metric Version: " << stringfy_metric_header_version(
-                                              disjoin_metrics_version(gpu_metrics_version))
-                << " |";
-    LOG_TRACE(ss);
-
-    // firmware_timestamp is at 10ns resolution
-    ss << __PRETTY_FUNCTION__
-                << " | ======= Changes ======= "
-                << " | {m_firmware_timestamp} from: " << m_gpu_metrics_tbl.m_firmware_timestamp
-                << " to: " << (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
-    m_gpu_metrics_tbl.m_firmware_timestamp = (m_gpu_metrics_tbl.m_firmware_timestamp * 10);
-    LOG_DEBUG(ss);
-  };
-
-
-  //  Adjustments/Changes specific to this version
-  run_metric_adjustments_v12();
-
   // Temperature Info
   m_metrics_dynamic_tbl[AMDGpuMetricsClassId_t::kGpuMetricTemperature]
     .insert(std::make_pair(AMDGpuMetricsUnitType_t::kMetricTempEdge,
@@ -2948,12 +3245,11 @@ rsmi_status_t GpuMetricsBase_v12_t::populate_metrics_dynamic_tbl() {
                                 "pcie_link_speed"))
            );
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Returning = " << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
 
   return status_code;
 }
@@ -2962,8 +3258,7 @@ AMGpuMetricsPublicLatestTupl_t GpuMetricsBase_v12_t::copy_internal_to_external_m
 {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   auto copy_data_from_internal_metrics_tbl = [&]() {
     AMGpuMetricsPublicLatest_t metrics_public_init{};
@@ -3049,46 +3344,39 @@ AMGpuMetricsPublicLatestTupl_t GpuMetricsBase_v12_t::copy_internal_to_external_m
     return metrics_public_init;
   }();
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Returning = " << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
 
   return std::make_tuple(status_code, copy_data_from_internal_metrics_tbl);
 }
 
+//
+//  Note: Any metric treatment/changes (if any) should happen before they
+//        get written to internal/external tables.
+//
+void GpuMetricsBase_v11_t::run_metric_adjustments() {
+  std::ostringstream ss;
+  const auto gpu_metrics_version = translate_flag_to_metric_version(get_gpu_metrics_version_used());
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
+              << " | ======= info ======= "
+              << " | Applying adjustments "
+              << " | Metric Version: " << stringfy_metric_header_version(
+                                            disjoin_metrics_version(gpu_metrics_version))
+              << " |");
+}
+
 rsmi_status_t GpuMetricsBase_v11_t::populate_metrics_dynamic_tbl() {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   if (!m_metrics_dynamic_tbl.empty()) {
     m_metrics_dynamic_tbl.clear();
   }
 
-  //
-  //  Note: Any metric treatment/changes (if any) should happen before they
-  //        get written to internal/external tables.
-  //
-  auto run_metric_adjustments_v11 = [&]() {
-    ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-    const auto gpu_metrics_version = translate_flag_to_metric_version(get_gpu_metrics_version_used());
-    ss << __PRETTY_FUNCTION__
-                << " | ======= info ======= "
-                << " | Applying adjustments "
-                << " | Metric Version: " << stringfy_metric_header_version(
-                                              disjoin_metrics_version(gpu_metrics_version))
-                << " |";
-    LOG_TRACE(ss);
-  };
-
-
-  //  Adjustments/Changes specific to this version
-  run_metric_adjustments_v11();
-
   // Temperature Info
   m_metrics_dynamic_tbl[AMDGpuMetricsClassId_t::kGpuMetricTemperature]
     .insert(std::make_pair(AMDGpuMetricsUnitType_t::kMetricTempEdge,
@@ -3272,12 +3560,11 @@ rsmi_status_t GpuMetricsBase_v11_t::populate_metrics_dynamic_tbl() {
                                 "pcie_link_speed"))
            );
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Returning = " << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
 
   return status_code;
 }
@@ -3286,8 +3573,7 @@ AMGpuMetricsPublicLatestTupl_t GpuMetricsBase_v11_t::copy_internal_to_external_m
 {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   auto copy_data_from_internal_metrics_tbl = [&]() {
     AMGpuMetricsPublicLatest_t metrics_public_init{};
@@ -3370,12 +3656,11 @@ AMGpuMetricsPublicLatestTupl_t GpuMetricsBase_v11_t::copy_internal_to_external_m
     return metrics_public_init;
   }();
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Returning = " << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
 
   return std::make_tuple(status_code, copy_data_from_internal_metrics_tbl);
 }
@@ -3385,8 +3670,7 @@ rsmi_status_t Device::dev_read_gpu_metrics_header_data()
 {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   // Check if/when metrics table needs to be refreshed.
   auto op_result = readDevInfo(DevInfoTypes::kDevGpuMetrics,
@@ -3394,7 +3678,7 @@ rsmi_status_t Device::dev_read_gpu_metrics_header_data()
                                 &m_gpu_metrics_header);
   if ((status_code = ErrnoToRsmiStatus(op_result)) !=
       rsmi_status_t::RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                 << " | ======= end ======= "
                 << " | Fail "
                 << " | Device #: " << index()
@@ -3404,13 +3688,12 @@ rsmi_status_t Device::dev_read_gpu_metrics_header_data()
                 << getRSMIStatusString(status_code)
                 << " Could not read Metrics Header: "
                 << print_unsigned_int(m_gpu_metrics_header.m_structure_size)
-                << " |";
-    LOG_ERROR(ss);
+                << " |");
     return status_code;
   }
   if ((status_code = is_gpu_metrics_version_supported(m_gpu_metrics_header)) ==
       rsmi_status_t::RSMI_STATUS_NOT_SUPPORTED) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                 << " | ======= end ======= "
                 << " | Fail "
                 << " | Device #: " << index()
@@ -3420,13 +3703,12 @@ rsmi_status_t Device::dev_read_gpu_metrics_header_data()
                 << getRSMIStatusString(status_code)
                 << " Could not read Metrics Header: "
                 << print_unsigned_int(m_gpu_metrics_header.m_structure_size)
-                << " |";
-    LOG_ERROR(ss);
+                << " |");
     return status_code;
   }
   m_gpu_metrics_updated_timestamp = actual_timestamp_in_secs();
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
              << " | ======= end ======= "
              << " | Success "
              << " | Device #: " << index()
@@ -3434,62 +3716,158 @@ rsmi_status_t Device::dev_read_gpu_metrics_header_data()
              << " | Update Timestamp: " << m_gpu_metrics_updated_timestamp
              << " | Returning = "
              << getRSMIStatusString(status_code)
-             << " |";
-  LOG_TRACE(ss);
+             << " |");
   return status_code;
 }
 
-rsmi_status_t Device::dev_read_gpu_metrics_all_data()
+//  Large enough for any supported gpu_metrics table; the driver never
+//  exports more than a page.
+constexpr std::size_t kGpuMetricsMaxBlobSize = 4096;
+static_assert(std::max({sizeof(AMDGpuMetrics_v11_t), sizeof(AMDGpuMetrics_v12_t),
+                        sizeof(AMDGpuMetrics_v13_t), sizeof(AMDGpuMetrics_v14_t),
+                        sizeof(AMDGpuMetrics_v15_t), sizeof(AMDGpuMetrics_v16_t)})
+                < kGpuMetricsMaxBlobSize,
+              "gpu_metrics blob buffer is too small");
+
+rsmi_status_t Device::dev_read_gpu_metrics_raw_data()
 {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
-
-  //  At this point we should have a valid gpu_metrics pointer, and
-  //  we already read the header; setup_gpu_metrics_reading()
-  if ((!m_gpu_metrics_ptr) ||
-      ((!m_gpu_metrics_header.m_structure_size)  ||
-       (!m_gpu_metrics_header.m_format_revision) ||
-       (!m_gpu_metrics_header.m_content_revision))) {
-    status_code = rsmi_status_t::RSMI_STATUS_SETTING_UNAVAILABLE;
-    ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
+
+  //  One read of the whole blob; the header is taken from it, and the
+  //  metrics object is (re)created only when the version changes.
+  m_gpu_metrics_snapshot_valid = false;
+  alignas(std::uint64_t) std::uint8_t metrics_blob[kGpuMetricsMaxBlobSize];
+  std::size_t blob_size = 0;
+  auto op_result = readDevInfoBinaryBlob(DevInfoTypes::kDevGpuMetrics,
+                                         sizeof(metrics_blob),
+                                         metrics_blob,
+                                         &blob_size);
+  if ((status_code = ErrnoToRsmiStatus(op_result)) !=
+      rsmi_status_t::RSMI_STATUS_SUCCESS) {
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                 << " | ======= end ======= "
                 << " | Fail "
                 << " | Device #: " << index()
-                << " | Metric Version: " << stringfy_metrics_header(dev_get_metrics_header())
-                << " | Cause: Couldn't get a valid metric object. setup_gpu_metrics_reading()"
+                << " | Cause: readDevInfoBinaryBlob(kDevGpuMetrics)"
                 << " | Returning = "
                 << getRSMIStatusString(status_code)
-                << " |";
-    LOG_ERROR(ss);
+                << " |");
     return status_code;
   }
 
-  auto op_result = readDevInfo(DevInfoTypes::kDevGpuMetrics,
-                          m_gpu_metrics_header.m_structure_size,
-                          m_gpu_metrics_ptr->get_metrics_table().get());
-  if ((status_code = ErrnoToRsmiStatus(op_result)) !=
-      rsmi_status_t::RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__
+  if (blob_size < sizeof(AMDGpuMetricsHeader_v1_t)) {
+    status_code = rsmi_status_t::RSMI_STATUS_UNEXPECTED_SIZE;
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
+                << " | ======= end ======= "
+                << " | Fail "
+                << " | Device #: " << index()
+                << " | Cause: gpu_metrics shorter than its header: " << blob_size
+                << " | Returning = "
+                << getRSMIStatusString(status_code)
+                << " |");
+    return status_code;
+  }
+  std::memcpy(&m_gpu_metrics_header, metrics_blob, sizeof(AMDGpuMetricsHeader_v1_t));
+  if ((status_code = is_gpu_metrics_version_supported(m_gpu_metrics_header)) ==
+      rsmi_status_t::RSMI_STATUS_NOT_SUPPORTED) {
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                 << " | ======= end ======= "
                 << " | Fail "
                 << " | Device #: " << index()
                 << " | Metric Version: " << stringfy_metrics_header(m_gpu_metrics_header)
-                << " | Cause: readDevInfo(kDevGpuMetrics)"
+                << " | Cause: gpu metric file version is not supported: "
                 << " | Returning = "
                 << getRSMIStatusString(status_code)
-                << " Could not read Metrics Header: "
-                << print_unsigned_int(m_gpu_metrics_header.m_structure_size)
-                << " |";
-    LOG_ERROR(ss);
+                << " |");
+    return status_code;
+  }
+
+  status_code = dev_setup_gpu_metrics_object();
+  if (status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) {
+    return status_code;
+  }
+
+  //  Never copy past the end of the metrics object's table
+  const auto copy_size = std::min<size_t>(m_gpu_metrics_header.m_structure_size,
+                                          m_gpu_metrics_ptr->sizeof_metric_table());
+  if (blob_size < copy_size) {
+    status_code = rsmi_status_t::RSMI_STATUS_UNEXPECTED_SIZE;
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
+                << " | ======= end ======= "
+                << " | Fail "
+                << " | Device #: " << index()
+                << " | Metric Version: " << stringfy_metrics_header(m_gpu_metrics_header)
+                << " | Cause: gpu_metrics size " << blob_size
+                << " is less than expected " << copy_size
+                << " | Returning = "
+                << getRSMIStatusString(status_code)
+                << " |");
+    return status_code;
+  }
+  std::memcpy(m_gpu_metrics_ptr->get_metrics_table().get(), metrics_blob, copy_size);
+
+  m_gpu_metrics_updated_timestamp = actual_timestamp_in_secs();
+  m_gpu_metrics_snapshot_time = std::chrono::steady_clock::now();
+  m_gpu_metrics_snapshot_valid = true;
+  m_gpu_metrics_snapshot_adjusted = false;
+  m_gpu_metrics_snapshot_tbl_built = false;
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
+             << " | ======= end ======= "
+             << " | Success "
+             << " | Device #: " << index()
+             << " | Metric Version: " << stringfy_metrics_header(m_gpu_metrics_header)
+             << " | Update Timestamp: " << m_gpu_metrics_updated_timestamp
+             << " | Returning = "
+             << getRSMIStatusString(status_code)
+             << " |");
+  return status_code;
+}
+
+void Device::dev_adjust_gpu_metrics_snapshot()
+{
+  if (!m_gpu_metrics_snapshot_adjusted && m_gpu_metrics_ptr) {
+    m_gpu_metrics_ptr->run_metric_adjustments();
+    m_gpu_metrics_snapshot_adjusted = true;
+  }
+}
+
+bool Device::dev_gpu_metrics_snapshot_is_fresh() const
+{
+  if ((m_gpu_metrics_cache_ttl_us == 0) || !m_gpu_metrics_snapshot_valid || !m_gpu_metrics_ptr) {
+    return false;
+  }
+
+  const auto snapshot_age = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - m_gpu_metrics_snapshot_time);
+  return (static_cast<uint64_t>(snapshot_age.count()) < m_gpu_metrics_cache_ttl_us);
+}
+
+void Device::set_gpu_metrics_cache_ttl(uint64_t ttl_us)
+{
+  m_gpu_metrics_cache_ttl_us = ttl_us;
+  m_gpu_metrics_snapshot_valid = false;
+}
+
+rsmi_status_t Device::dev_read_gpu_metrics_all_data()
+{
+  std::ostringstream ss;
+  auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
+
+  status_code = dev_read_gpu_metrics_raw_data();
+  if (status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) {
     return status_code;
   }
 
   //  All metric units are pushed in.
+  dev_adjust_gpu_metrics_snapshot();
   status_code = m_gpu_metrics_ptr->populate_metrics_dynamic_tbl();
+  m_gpu_metrics_snapshot_tbl_built = true;
   if (status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__
+    m_gpu_metrics_snapshot_valid = false;
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Fail "
               << " | Device #: " << index()
@@ -3497,12 +3875,10 @@ rsmi_status_t Device::dev_read_gpu_metrics_all_data()
               << " | Update Timestamp: " << m_gpu_metrics_updated_timestamp
               << " | Returning = "
               << getRSMIStatusString(status_code)
-              << " |";
-    LOG_ERROR(ss);
+              << " |");
   }
 
-  m_gpu_metrics_updated_timestamp = actual_timestamp_in_secs();
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
              << " | ======= end ======= "
              << " | Success "
              << " | Device #: " << index()
@@ -3510,27 +3886,22 @@ rsmi_status_t Device::dev_read_gpu_metrics_all_data()
              << " | Update Timestamp: " << m_gpu_metrics_updated_timestamp
              << " | Returning = "
              << getRSMIStatusString(status_code)
-             << " |";
-  LOG_TRACE(ss);
+             << " |");
   return status_code;
 }
 
-rsmi_status_t Device::setup_gpu_metrics_reading()
+rsmi_status_t Device::dev_setup_gpu_metrics_object()
 {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
-
-  status_code = dev_read_gpu_metrics_header_data();
-  if (status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) {
-    return status_code;
-  }
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
+  //  m_gpu_metrics_header holds the header of the table just read;
+  //  dev_read_gpu_metrics_raw_data()
   const auto gpu_metrics_flag_version = translate_header_to_flag_version(dev_get_metrics_header());
   if (gpu_metrics_flag_version == AMDGpuMetricVersionFlags_t::kGpuMetricNone) {
     status_code = rsmi_status_t::RSMI_STATUS_NOT_SUPPORTED;
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                 << " | ======= end ======= "
                 << " | Fail "
                 << " | Device #: " << index()
@@ -3540,17 +3911,23 @@ rsmi_status_t Device::setup_gpu_metrics_reading()
                 << " | Cause: Metric version found is not supported!"
                 << " | Returning = "
                 << getRSMIStatusString(status_code)
-                << " |";
-    LOG_ERROR(ss);
+                << " |");
+    return status_code;
+  }
+
+  //  Same metrics version as the last read; keep using the same object
+  if (m_gpu_metrics_ptr &&
+      (m_gpu_metrics_ptr->get_gpu_metrics_version_used() == gpu_metrics_flag_version)) {
+    m_gpu_metrics_ptr->set_device_id(m_device_id);
+    m_gpu_metrics_ptr->set_partition_id(m_partition_id);
     return status_code;
   }
 
-  //
   m_gpu_metrics_ptr.reset();
   m_gpu_metrics_ptr = amdgpu_metrics_factory(gpu_metrics_flag_version);
   if (!m_gpu_metrics_ptr) {
     status_code = rsmi_status_t::RSMI_STATUS_UNEXPECTED_DATA;
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                 << " | ======= end ======= "
                 << " | Fail "
                 << " | Device #: " << index()
@@ -3558,18 +3935,60 @@ rsmi_status_t Device::setup_gpu_metrics_reading()
                 << " | Cause: amdgpu_metrics_factory() couldn't get a valid metric object"
                 << " | Returning = "
                 << getRSMIStatusString(status_code)
-                << " |";
-    LOG_ERROR(ss);
+                << " |");
     return status_code;
   }
   m_gpu_metrics_ptr->set_device_id(m_device_id);
   m_gpu_metrics_ptr->set_partition_id(m_partition_id);
 
-  //
-  // m_gpu_metrics_ptr has the pointer to the proper object type/version.
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
+              << " | ======= end ======= "
+              << " | Success "
+              << " | Device #: " << index()
+              << " | Metric Version: " << stringfy_metrics_header(dev_get_metrics_header())
+              << " | Fabric: [" << &m_gpu_metrics_ptr
+              << " ]"
+              << " | Returning = "
+              << getRSMIStatusString(status_code)
+              << " |");
+  return status_code;
+}
+
+rsmi_status_t Device::setup_gpu_metrics_reading()
+{
+  std::ostringstream ss;
+  auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
+
+  //  Serve from the current snapshot while it is within the cache ttl;
+  //  the dynamic table only needs to be built once per snapshot.
+  if (dev_gpu_metrics_snapshot_is_fresh()) {
+    m_gpu_metrics_ptr->set_device_id(m_device_id);
+    m_gpu_metrics_ptr->set_partition_id(m_partition_id);
+    if (!m_gpu_metrics_snapshot_tbl_built) {
+      dev_adjust_gpu_metrics_snapshot();
+      status_code = m_gpu_metrics_ptr->populate_metrics_dynamic_tbl();
+      m_gpu_metrics_snapshot_tbl_built = true;
+      if (status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) {
+        m_gpu_metrics_snapshot_valid = false;
+      }
+    }
+    LOG_TRACE_S(ss << __PRETTY_FUNCTION__
+                << " | ======= end ======= "
+                << " | Cached Snapshot "
+                << " | Device #: " << index()
+                << " | Metric Version: " << stringfy_metrics_header(dev_get_metrics_header())
+                << " | Returning = "
+                << getRSMIStatusString(status_code)
+                << " |");
+    return status_code;
+  }
+
+  //  Reads the table, and sets m_gpu_metrics_ptr to the proper
+  //  object type/version.
   status_code = dev_read_gpu_metrics_all_data();
   if (status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                 << " | ======= end ======= "
                 << " | Fail "
                 << " | Device #: " << index()
@@ -3577,12 +3996,11 @@ rsmi_status_t Device::setup_gpu_metrics_reading()
                 << " | Cause: dev_read_gpu_metrics_all_data() couldn't read gpu metric data!"
                 << " | Returning = "
                 << getRSMIStatusString(status_code)
-                << " |";
-    LOG_ERROR(ss);
+                << " |");
     return status_code;
   }
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Device #: " << index()
@@ -3591,8 +4009,7 @@ rsmi_status_t Device::setup_gpu_metrics_reading()
               << " ]"
               << " | Returning = "
               << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
   return status_code;
 }
 
@@ -3634,8 +4051,7 @@ rsmi_status_t Device::dev_log_gpu_metrics(std::ostringstream& outstream_metrics)
   std::ostringstream ss;
   std::ostringstream tmp_outstream_metrics;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   //  If we still don't have a valid gpu_metrics pointer;
   //  meaning, we didn't run any queries, and just want to
@@ -3645,7 +4061,7 @@ rsmi_status_t Device::dev_log_gpu_metrics(std::ostringstream& outstream_metrics)
   if ((status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) || (!m_gpu_metrics_ptr)) {
     // At this point we should have a valid gpu_metrics pointer.
     status_code = rsmi_status_t::RSMI_STATUS_UNEXPECTED_DATA;
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                 << " | ======= end ======= "
                 << " | Fail "
                 << " | Device #: " << index()
@@ -3653,8 +4069,7 @@ rsmi_status_t Device::dev_log_gpu_metrics(std::ostringstream& outstream_metrics)
                 << " | Cause: Couldn't get a valid metric object"
                 << " | Returning = "
                 << getRSMIStatusString(status_code)
-                << " |";
-    LOG_ERROR(ss);
+                << " |");
     return status_code;
   }
 
@@ -3690,7 +4105,7 @@ rsmi_status_t Device::dev_log_gpu_metrics(std::ostringstream& outstream_metrics)
 
   //  Metrics info
   auto table_content_output = [&]() {
-    const auto gpu_metrics_tbl = m_gpu_metrics_ptr->get_metrics_dynamic_tbl();
+    const auto& gpu_metrics_tbl = m_gpu_metrics_ptr->get_metrics_dynamic_tbl();
     tmp_outstream_metrics << "\n";
     tmp_outstream_metrics << "*** GPU Metrics Data: *** \n";
     for (const auto& [metric_class, metric_data] : gpu_metrics_tbl) {
@@ -3740,7 +4155,7 @@ rsmi_status_t Device::dev_log_gpu_metrics(std::ostringstream& outstream_metrics)
   outstream_metrics << tmp_outstream_metrics.rdbuf();
   LOG_DEBUG(tmp_outstream_metrics);
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Device #: " << index()
@@ -3749,8 +4164,7 @@ rsmi_status_t Device::dev_log_gpu_metrics(std::ostringstream& outstream_metrics)
               << " ]"
               << " | Returning = "
               << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
   return status_code;
 }
 
@@ -3758,13 +4172,12 @@ AMGpuMetricsPublicLatestTupl_t Device::dev_copy_internal_to_external_metrics()
 {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   if (!m_gpu_metrics_ptr) {
     // At this point we should have a valid gpu_metrics pointer.
     status_code = rsmi_status_t::RSMI_STATUS_UNEXPECTED_DATA;
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                << " | ======= end ======= "
                << " | Fail "
                << " | Device #: " << index()
@@ -3772,12 +4185,11 @@ AMGpuMetricsPublicLatestTupl_t Device::dev_copy_internal_to_external_metrics()
                << " | Cause: Couldn't get a valid metric object"
                << " | Returning = "
                << getRSMIStatusString(status_code)
-               << " |";
-    LOG_ERROR(ss);
+               << " |");
     return std::make_tuple(status_code, AMGpuMetricsPublicLatest_t());
   }
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Device #: " << index()
@@ -3786,24 +4198,60 @@ AMGpuMetricsPublicLatestTupl_t Device::dev_copy_internal_to_external_metrics()
               << " ]"
               << " | Returning = "
               << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
 
   return m_gpu_metrics_ptr->copy_internal_to_external_metrics();
 }
 
+rsmi_status_t Device::dev_read_gpu_metrics_external(AMGpuMetricsPublicLatest_t& external_metrics)
+{
+  std::ostringstream ss;
+  auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
+
+  //  Same snapshot shared by the metric unit queries; one read when stale.
+  if (!dev_gpu_metrics_snapshot_is_fresh()) {
+    status_code = dev_read_gpu_metrics_raw_data();
+    if (status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) {
+      return status_code;
+    }
+  }
 
-rsmi_status_t Device::run_internal_gpu_metrics_query(AMDGpuMetricsUnitType_t metric_counter, AMDGpuDynamicMetricTblValues_t& values)
+  m_gpu_metrics_ptr->set_device_id(m_device_id);
+  m_gpu_metrics_ptr->set_partition_id(m_partition_id);
+  dev_adjust_gpu_metrics_snapshot();
+  auto [error_code, metrics] = dev_copy_internal_to_external_metrics();
+  if (error_code == rsmi_status_t::RSMI_STATUS_SUCCESS) {
+    external_metrics = metrics;
+  }
+  status_code = error_code;
+
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
+              << " | ======= end ======= "
+              << " | Device #: " << index()
+              << " | Metric Version: " << stringfy_metrics_header(dev_get_metrics_header())
+              << " | Returning = "
+              << getRSMIStatusString(status_code)
+              << " |");
+  return status_code;
+}
+
+
+rsmi_status_t Device::dev_read_gpu_metrics_unit(AMDGpuMetricsUnitType_t metric_counter,
+                                                GpuMetricUnitValues_t& values,
+                                                uint16_t& num_values)
 {
   std::ostringstream ss;
-  auto status_code(rsmi_status_t::RSMI_STATUS_NOT_SUPPORTED);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
-  status_code = setup_gpu_metrics_reading();
+  num_values = 0;
+  if (!dev_gpu_metrics_snapshot_is_fresh()) {
+    status_code = dev_read_gpu_metrics_raw_data();
+  }
   if ((status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) || (!m_gpu_metrics_ptr)) {
     status_code = rsmi_status_t::RSMI_STATUS_UNEXPECTED_DATA;
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                 << " | ======= end ======= "
                 << " | Fail "
                 << " | Device #: " << index()
@@ -3811,49 +4259,80 @@ rsmi_status_t Device::run_internal_gpu_metrics_query(AMDGpuMetricsUnitType_t met
                 << " | Cause: Couldn't get a valid metric object"
                 << " | Returning = "
                 << getRSMIStatusString(status_code)
-                << " |";
-    LOG_ERROR(ss);
+                << " |");
     return status_code;
   }
 
-  // Lookup the dynamic table
-  ss << __PRETTY_FUNCTION__
-              << " | ======= info ======= "
-              << " | Device #: " << index()
-              << " | Metric Version: " << stringfy_metrics_header(dev_get_metrics_header())
-              << " | Metric Unit: " << static_cast<AMDGpuMetricTypeId_t>(metric_counter)
-              << " |";
-  LOG_INFO(ss);
-  const auto gpu_metrics_tbl = m_gpu_metrics_ptr->get_metrics_dynamic_tbl();
-  for (const auto& [metric_class, metric_data] : gpu_metrics_tbl) {
-    for (const auto& [metric_unit, metric_values] : metric_data) {
-      if (metric_unit == metric_counter) {
-        values = metric_values;
-        status_code = rsmi_status_t::RSMI_STATUS_SUCCESS;
-        ss << __PRETTY_FUNCTION__
-                    << " | ======= end ======= "
-                    << " | Success "
-                    << " | Device #: " << index()
-                    << " | Metric Version: " << stringfy_metrics_header(dev_get_metrics_header())
-                    << " | Metric Unit: " << static_cast<AMDGpuMetricTypeId_t>(metric_counter)
-                    << " | Returning = "
-                    << getRSMIStatusString(status_code)
-                    << " |";
-        LOG_TRACE(ss);
-        return status_code;
-      }
-    }
+  //  Decode straight from the raw table; no dynamic table needed.
+  const auto* field_location =
+    gpu_metrics_field_location(m_gpu_metrics_ptr->get_gpu_metrics_version_used(), metric_counter);
+  if (field_location == nullptr) {
+    status_code = rsmi_status_t::RSMI_STATUS_NOT_SUPPORTED;
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
+                << " | ======= end ======= "
+                << " | Fail "
+                << " | Device #: " << index()
+                << " | Metric Version: " << stringfy_metrics_header(dev_get_metrics_header())
+                << " | Metric Unit: " << static_cast<AMDGpuMetricTypeId_t>(metric_counter)
+                << " | Cause: Metric unit not part of the metric version"
+                << " | Returning = "
+                << getRSMIStatusString(status_code)
+                << " |");
+    return status_code;
   }
 
-  ss << __PRETTY_FUNCTION__
+  //  A snapshot shared with setup_gpu_metrics_reading() may already carry the
+  //  version adjustments; those must not be applied twice.
+  auto unit_location = *field_location;
+  if (m_gpu_metrics_snapshot_adjusted) {
+    unit_location.m_scale = 1;
+  }
+  const auto* raw_metrics_tbl = m_gpu_metrics_ptr->get_metrics_table().get();
+  for (auto idx = uint16_t(0); idx < unit_location.m_count; ++idx) {
+    values[idx] = gpu_metrics_field_value(raw_metrics_tbl, unit_location, idx);
+  }
+  num_values = field_location->m_count;
+
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
-              << " | Fail "
+              << " | Success "
               << " | Device #: " << index()
               << " | Metric Version: " << stringfy_metrics_header(dev_get_metrics_header())
+              << " | Metric Unit: " << static_cast<AMDGpuMetricTypeId_t>(metric_counter)
+              << " | Values: " << num_values
               << " | Returning = "
               << getRSMIStatusString(status_code)
-              << " |";
-  LOG_ERROR(ss);
+              << " |");
+  return status_code;
+}
+
+rsmi_status_t Device::run_internal_gpu_metrics_query(AMDGpuMetricsUnitType_t metric_counter, AMDGpuDynamicMetricTblValues_t& values)
+{
+  GpuMetricUnitValues_t tmp_values{};
+  auto num_values = uint16_t(0);
+  auto status_code = dev_read_gpu_metrics_unit(metric_counter, tmp_values, num_values);
+  if (status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) {
+    return status_code;
+  }
+
+  const auto* field_location =
+    gpu_metrics_field_location(m_gpu_metrics_ptr->get_gpu_metrics_version_used(), metric_counter);
+  const auto data_type = [&]() {
+    switch (field_location->m_width) {
+      case sizeof(uint8_t):  return AMDGpuMetricsDataType_t::kUInt8;
+      case sizeof(uint16_t): return AMDGpuMetricsDataType_t::kUInt16;
+      case sizeof(uint32_t): return AMDGpuMetricsDataType_t::kUInt32;
+      default:               return AMDGpuMetricsDataType_t::kUInt64;
+    }
+  }();
+  values.clear();
+  values.reserve(num_values);
+  for (auto idx = uint16_t(0); idx < num_values; ++idx) {
+    values.push_back({tmp_values[idx],
+                      (amdgpu_metrics_unit_type_translation_table.at(metric_counter) +
+                       " : " + std::to_string(idx)),
+                      data_type});
+  }
   return status_code;
 }
 
@@ -3888,8 +4367,7 @@ rsmi_status_t rsmi_dev_gpu_metrics_info_query(uint32_t dv_ind, AMDGpuMetricsUnit
 {
   std::ostringstream ss;
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  ss << __PRETTY_FUNCTION__ << " | ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << " | ======= start =======");
 
   static constexpr bool is_supported_vector_type = [&]() {
     if constexpr (is_std_vector_v<T>) {
@@ -3903,11 +4381,12 @@ rsmi_status_t rsmi_dev_gpu_metrics_info_query(uint32_t dv_ind, AMDGpuMetricsUnit
 
   if constexpr ((is_supported_vector_type) || (is_metric_data_type_supported_v<T>)) {
     // Get all stored values for the metric unit/counter
-    AMDGpuDynamicMetricTblValues_t tmp_values{};
+    GpuMetricUnitValues_t tmp_values{};
+    auto num_values = uint16_t(0);
     GET_DEV_FROM_INDX
-    status_code = dev->run_internal_gpu_metrics_query(metric_counter, tmp_values);
-    if ((status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) || tmp_values.empty()) {
-      ss << __PRETTY_FUNCTION__
+    status_code = dev->dev_read_gpu_metrics_unit(metric_counter, tmp_values, num_values);
+    if ((status_code != rsmi_status_t::RSMI_STATUS_SUCCESS) || (num_values == 0)) {
+      LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                   << " | ======= end ======= "
                   << " | Fail "
                   << " | Device #: " << dv_ind
@@ -3915,41 +4394,36 @@ rsmi_status_t rsmi_dev_gpu_metrics_info_query(uint32_t dv_ind, AMDGpuMetricsUnit
                   << " | Cause: Couldn't find metric/counter requested"
                   << " | Metric Type: " << static_cast<uint32_t>(metric_counter)
                   << " " << amdgpu_metrics_unit_type_translation_table.at(metric_counter)
-                  << " | Values: " << tmp_values.size()
+                  << " | Values: " << num_values
                   << " | Returning = "
                   << getRSMIStatusString(status_code)
-                  << " |";
-      LOG_ERROR(ss);
+                  << " |");
       return status_code;
     }
 
     if constexpr (is_std_vector_v<T>) {
       using ValueType_t = typename T::value_type;
-      ValueType_t tmp_value;
 
-      for (const auto& value : tmp_values) {
-        tmp_value = static_cast<ValueType_t>(value.m_value);
-        metric_value.push_back(tmp_value);
+      metric_value.reserve(metric_value.size() + num_values);
+      for (auto idx = uint16_t(0); idx < num_values; ++idx) {
+        metric_value.push_back(static_cast<ValueType_t>(tmp_values[idx]));
       }
     }
     else if constexpr (is_metric_data_type_supported_v<T>) {
-      T tmp_value(0);
-      tmp_value = static_cast<decltype(tmp_value)>(tmp_values[0].m_value);
-      metric_value = tmp_value;
+      metric_value = static_cast<T>(tmp_values[0]);
     }
   }
   else {
     static_assert(is_dependent_false_v<T>, "Error: Data Type not supported...");
   }
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Device #: " << dv_ind
               << " | Metric Type: " << static_cast<uint32_t>(metric_counter)
               << " | Returning = "
               << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
   return status_code;
 }
 
@@ -3986,8 +4460,7 @@ rsmi_dev_gpu_metrics_header_info_get(uint32_t dv_ind, metrics_table_header_t& he
   TRY
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
   std::ostringstream ss;
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   GET_DEV_FROM_INDX
   status_code = dev->dev_read_gpu_metrics_header_data();
@@ -3996,14 +4469,13 @@ rsmi_dev_gpu_metrics_header_info_get(uint32_t dv_ind, metrics_table_header_t& he
     std::memcpy(&header_value, &tmp_header_info, sizeof(metrics_table_header_t));
   }
 
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
               << " | ======= end ======= "
               << " | Success "
               << " | Device #: " << dv_ind
               << " | Returning = "
               << getRSMIStatusString(status_code)
-              << " |";
-  LOG_TRACE(ss);
+              << " |");
 
   return status_code;
   CATCH
@@ -4011,6 +4483,42 @@ rsmi_dev_gpu_metrics_header_info_get(uint32_t dv_ind, metrics_table_header_t& he
 
 //dev_read_gpu_metrics_header_data
 
+rsmi_status_t
+amd::smi::dev_gpu_metrics_info_get(uint32_t dv_ind, Device& dev,
+                                   rsmi_gpu_metrics_t& smu) {
+  //  Other readers of the device may hold the device lock at the same time
+  std::lock_guard<std::mutex> metrics_guard(*dev.gpu_metrics_mutex());
+  dev.set_smi_device_id(dv_ind);
+  //  The partition id only changes with the compute partition mode, which
+  //  another process may have changed; the mode is one small sysfs read,
+  //  while finding the id again also reads the KFD node. GPUs without
+  //  partitions have no mode file, and keep an empty mode.
+  std::string compute_partition;
+  if (dev.readDevInfo(amd::smi::kDevComputePartition, &compute_partition) != 0) {
+    compute_partition.clear();
+  }
+  if (!dev.smi_partition_id_valid(compute_partition)) {
+    uint32_t partition_id = UINT32_MAX;
+    if (rsmi_dev_partition_id_get(dv_ind, &partition_id) == rsmi_status_t::RSMI_STATUS_SUCCESS) {
+      dev.set_smi_partition_id(partition_id, compute_partition);
+    }
+  }
+
+  //  Converts the raw table straight into the public struct; the full
+  //  table dump is only produced when debug logging is on, or through
+  //  rsmi_dev_metrics_log_get().
+  AMGpuMetricsPublicLatest_t external_metrics{};
+  const auto error_code = dev.dev_read_gpu_metrics_external(external_metrics);
+  if (LOG_DEBUG_ON()) {
+    std::ostringstream ostrstream;
+    dev.dev_log_gpu_metrics(ostrstream);
+  }
+  if (error_code == rsmi_status_t::RSMI_STATUS_SUCCESS) {
+    smu = external_metrics;
+  }
+  return error_code;
+}
+
 /**
  *  Note: These keep backwards compatibility with previous GPU metrics work
  */
@@ -4019,57 +4527,46 @@ rsmi_dev_gpu_metrics_header_info_get(uint32_t dv_ind, metrics_table_header_t& he
 rsmi_status_t
 rsmi_dev_gpu_metrics_info_get(uint32_t dv_ind, rsmi_gpu_metrics_t* smu) {
   TRY
-  DEVICE_MUTEX
+  DEVICE_READ_MUTEX
   CHK_SUPPORT_NAME_ONLY(smu)
 
   auto status_code(rsmi_status_t::RSMI_STATUS_SUCCESS);
-  std::ostringstream ostrstream;
   std::ostringstream ss;
 
-  ss << __PRETTY_FUNCTION__ << "| ======= start =======";
-  LOG_TRACE(ss);
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__ << "| ======= start =======");
 
   assert(smu != nullptr);
   if (smu == nullptr) {
     status_code = rsmi_status_t::RSMI_STATUS_INVALID_ARGS;
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                << " | ======= end ======= "
                << " | Fail "
                << " | Device #: " << dv_ind
                << " | Returning = "
                << getRSMIStatusString(status_code)
-               << " |";
-    LOG_ERROR(ss);
+               << " |");
     return status_code;
   }
 
-  dev->set_smi_device_id(dv_ind);
-  uint32_t partition_id = 0;
-  auto ret = rsmi_dev_partition_id_get(dv_ind, &partition_id);
-  dev->set_smi_partition_id(partition_id);
-  dev->dev_log_gpu_metrics(ostrstream);
-  const auto [error_code, external_metrics] = dev->dev_copy_internal_to_external_metrics();
+  const auto error_code = amd::smi::dev_gpu_metrics_info_get(dv_ind, *dev, *smu);
   if (error_code != rsmi_status_t::RSMI_STATUS_SUCCESS) {
-    ss << __PRETTY_FUNCTION__
+    LOG_ERROR_S(ss << __PRETTY_FUNCTION__
                << " | ======= end ======= "
                << " | Fail "
                << " | Device #: " << dv_ind
                << " | Returning = "
                << getRSMIStatusString(error_code)
-               << " |";
-    LOG_ERROR(ss);
+               << " |");
     return error_code;
   }
 
-  *smu = external_metrics;
-  ss << __PRETTY_FUNCTION__
+  LOG_TRACE_S(ss << __PRETTY_FUNCTION__
       << " | ======= end ======= "
       << " | Success "
       << " | Device #: " << dv_ind
       << " | Returning = "
       << getRSMIStatusString(status_code)
-      << " |";
-  LOG_TRACE(ss);
+      << " |");
 
   return status_code;
   CATCH
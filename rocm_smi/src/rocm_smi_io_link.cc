@@ -93,7 +93,7 @@ static bool is_number(const std::string &s) {
 
 static std::string LinkPathRoot(uint32_t node_indx,
                                 LINK_DIRECTORY_TYPE directory) {
-  std::string link_path_root = kKFDNodesPathRoot;
+  std::string link_path_root = FsPath(kKFDNodesPathRoot);
   link_path_root += '/';
   link_path_root += std::to_string(node_indx);
   link_path_root += '/';
@@ -194,11 +194,11 @@ static int DiscoverLinks(std::map<std::pair<uint32_t, uint32_t>,
 
   links->clear();
 
-  auto kfd_node_dir = opendir(kKFDNodesPathRoot);
+  auto kfd_node_dir = opendir(FsPath(kKFDNodesPathRoot).c_str());
 
   if (kfd_node_dir == nullptr) {
     std::string err_msg = "Failed to open KFD nodes directory ";
-    err_msg += kKFDNodesPathRoot;
+    err_msg += FsPath(kKFDNodesPathRoot);
     err_msg += ".";
     perror(err_msg.c_str());
     return 1;
@@ -249,7 +249,7 @@ static int DiscoverLinks(std::map<std::pair<uint32_t, uint32_t>,
 
     if (closedir(io_link_dir)) {
       std::string err_msg = "Failed to close KFD nodes directory ";
-      err_msg += kKFDNodesPathRoot;
+      err_msg += FsPath(kKFDNodesPathRoot);
       err_msg += ".";
       perror(err_msg.c_str());
       return 1;
@@ -125,7 +125,7 @@ static bool is_number(const std::string &s) {
 }
 
 static std::string KFDDevicePath(uint32_t dev_id) {
-  std::string node_path = kKFDNodesPathRoot;
+  std::string node_path = FsPath(kKFDNodesPathRoot);
   node_path += '/';
   node_path += std::to_string(dev_id);
   return node_path;
@@ -299,7 +299,7 @@ int GetProcessInfo(rsmi_process_info_t *procs, uint32_t num_allocated,
 
   *num_procs_found = 0;
   errno = 0;
-  auto proc_dir = opendir(kKFDProcPathRoot);
+  auto proc_dir = opendir(FsPath(kKFDProcPathRoot).c_str());
 
   if (proc_dir == nullptr) {
     perror("Unable to open process directory");
@@ -329,7 +329,7 @@ int GetProcessInfo(rsmi_process_info_t *procs, uint32_t num_allocated,
       procs[*num_procs_found].process_id =
                                 static_cast<uint32_t>(std::stoi(proc_id_str));
 
-      std::string pasid_str_path = kKFDProcPathRoot;
+      std::string pasid_str_path = FsPath(kKFDProcPathRoot);
       pasid_str_path += "/";
       pasid_str_path += proc_id_str;
       pasid_str_path += "/";
@@ -373,7 +373,7 @@ int GetProcessGPUs(uint32_t pid, std::unordered_set<uint64_t> *gpu_set) {
   }
   errno = 0;
 
-  std::string queues_dir = kKFDProcPathRoot;
+  std::string queues_dir = FsPath(kKFDProcPathRoot);
   queues_dir += "/";
   queues_dir += std::to_string(pid);
   queues_dir += "/queues";
@@ -449,7 +449,7 @@ int GetProcessInfoForPID(uint32_t pid, rsmi_process_info_t *proc,
   std::string tmp;
   std::unordered_set<uint64_t>::iterator itr;
 
-  std::string proc_str_path = kKFDProcPathRoot;
+  std::string proc_str_path = FsPath(kKFDProcPathRoot);
   proc_str_path += "/";
   proc_str_path +=  std::to_string(pid);
 
@@ -551,7 +551,8 @@ int GetProcessInfoForPID(uint32_t pid, rsmi_process_info_t *proc,
   return 0;
 }
 
-int DiscoverKFDNodes(std::map<uint64_t, std::shared_ptr<KFDNode>> *nodes) {
+int DiscoverKFDNodes(std::map<uint64_t, std::shared_ptr<KFDNode>> *nodes,
+                     bool defer_io_links) {
   assert(nodes != nullptr);
 
   if (nodes == nullptr) {
@@ -564,7 +565,7 @@ int DiscoverKFDNodes(std::map<uint64_t, std::shared_ptr<KFDNode>> *nodes) {
   std::shared_ptr<KFDNode> node;
   uint32_t node_indx;
 
-  auto kfd_node_dir = opendir(kKFDNodesPathRoot);
+  auto kfd_node_dir = opendir(FsPath(kKFDNodesPathRoot).c_str());
   if (kfd_node_dir == nullptr) {
     return errno;
   }
@@ -590,7 +591,7 @@ int DiscoverKFDNodes(std::map<uint64_t, std::shared_ptr<KFDNode>> *nodes) {
 
     node = std::make_shared<KFDNode>(node_indx);
 
-    node->Initialize();
+    node->Initialize(defer_io_links);
 
     if (node->gpu_id() == 0) {
       // Don't add; this is a cpu node.
@@ -628,7 +629,7 @@ int DiscoverKFDNodes(std::map<uint64_t, std::shared_ptr<KFDNode>> *nodes) {
 
   if (closedir(kfd_node_dir)) {
     std::string err_str = "Failed to close KFD node directory ";
-    err_str += kKFDNodesPathRoot;
+    err_str += FsPath(kKFDNodesPathRoot);
     err_str += ".";
     perror(err_str.c_str());
     return 1;
@@ -679,7 +680,7 @@ int KFDNode::ReadProperties(void) {
 }
 
 int
-KFDNode::Initialize(void) {
+KFDNode::Initialize(bool defer_io_links) {
   int ret = 0;
   ret = ReadProperties();
   if (ret) {return ret;}
@@ -695,44 +696,9 @@ KFDNode::Initialize(void) {
     "Failed to initialize rocm_smi library (get xgmi hive id).");
   }
 
-  std::map<uint32_t, std::shared_ptr<IOLink>> io_link_map_tmp;
-  ret = DiscoverIOLinksPerNode(node_indx_, &io_link_map_tmp);
-  if (ret != 0) {
-    throw amd::smi::rsmi_exception(RSMI_INITIALIZATION_ERROR,
-    "Failed to initialize rocm_smi library (IO Links discovery per node).");
-  }
-
-  std::map<uint32_t, std::shared_ptr<IOLink>>::iterator it;
-  uint32_t node_to;
-  uint64_t node_to_gpu_id;
-  std::shared_ptr<IOLink> link;
-  bool numa_node_found = false;
-  for (it = io_link_map_tmp.begin(); it != io_link_map_tmp.end(); it++) {
-    io_link_map_[it->first] = it->second;
-    node_to = it->first;
-    link = it->second;
-    ret = ReadKFDGpuId(node_to, &node_to_gpu_id);
+  if (!defer_io_links) {
+    ret = ReadIOLinks();
     if (ret) {return ret;}
-    if (node_to_gpu_id == 0) {  //  CPU node
-      if (numa_node_found) {
-        if (numa_node_weight_ > link->weight()) {
-          numa_node_number_ = node_to;
-          numa_node_weight_ = link->weight();
-          numa_node_type_ = link->type();
-        }
-      } else {
-        numa_node_number_ = node_to;
-        numa_node_weight_ = link->weight();
-        numa_node_type_ = link->type();
-        numa_node_found = true;
-      }
-    } else {
-      io_link_type_[node_to] = link->type();
-      io_link_weight_[node_to] = link->weight();
-      io_link_max_bandwidth_[node_to] = link->max_bandwidth();
-      io_link_min_bandwidth_[node_to] = link->min_bandwidth();
-
-    }
   }
 
   // Pre-compute the total number of compute units a device has
@@ -760,6 +726,54 @@ KFDNode::Initialize(void) {
   return ret;
 }
 
+int
+KFDNode::ReadIOLinks(void) {
+  std::call_once(io_links_once_, [this]() {
+    std::map<uint32_t, std::shared_ptr<IOLink>> io_link_map_tmp;
+    int ret = DiscoverIOLinksPerNode(node_indx_, &io_link_map_tmp);
+    if (ret != 0) {
+      throw amd::smi::rsmi_exception(RSMI_INITIALIZATION_ERROR,
+      "Failed to initialize rocm_smi library (IO Links discovery per node).");
+    }
+
+    std::map<uint32_t, std::shared_ptr<IOLink>>::iterator it;
+    uint32_t node_to;
+    uint64_t node_to_gpu_id;
+    std::shared_ptr<IOLink> link;
+    bool numa_node_found = false;
+    for (it = io_link_map_tmp.begin(); it != io_link_map_tmp.end(); it++) {
+      io_link_map_[it->first] = it->second;
+      node_to = it->first;
+      link = it->second;
+      ret = ReadKFDGpuId(node_to, &node_to_gpu_id);
+      if (ret) {
+        io_links_ret_ = ret;
+        return;
+      }
+      if (node_to_gpu_id == 0) {  //  CPU node
+        if (numa_node_found) {
+          if (numa_node_weight_ > link->weight()) {
+            numa_node_number_ = node_to;
+            numa_node_weight_ = link->weight();
+            numa_node_type_ = link->type();
+          }
+        } else {
+          numa_node_number_ = node_to;
+          numa_node_weight_ = link->weight();
+          numa_node_type_ = link->type();
+          numa_node_found = true;
+        }
+      } else {
+        io_link_type_[node_to] = link->type();
+        io_link_weight_[node_to] = link->weight();
+        io_link_max_bandwidth_[node_to] = link->max_bandwidth();
+        io_link_min_bandwidth_[node_to] = link->min_bandwidth();
+      }
+    }
+  });
+  return io_links_ret_;
+}
+
 int
 KFDNode::get_property_value(std::string property, uint64_t *value) {
   assert(value != nullptr);
@@ -779,6 +793,7 @@ KFDNode::get_io_link_type(uint32_t node_to, IO_LINK_TYPE *type) {
   if (type == nullptr) {
     return EINVAL;
   }
+  ReadIOLinks();
   if (io_link_type_.find(node_to) == io_link_type_.end()) {
     return EINVAL;
   }
@@ -792,6 +807,7 @@ KFDNode::get_io_link_weight(uint32_t node_to, uint64_t *weight) {
   if (weight == nullptr) {
     return EINVAL;
   }
+  ReadIOLinks();
   if (io_link_weight_.find(node_to) == io_link_weight_.end()) {
     return EINVAL;
   }
@@ -807,6 +823,7 @@ KFDNode::get_io_link_bandwidth(uint32_t node_to, uint64_t *max_bandwidth,
     return EINVAL;
   }
 
+  ReadIOLinks();
   if (io_link_max_bandwidth_.find(node_to) == io_link_max_bandwidth_.end() ||
       io_link_min_bandwidth_.find(node_to) == io_link_min_bandwidth_.end()){
         return EINVAL;
@@ -826,7 +843,7 @@ int KFDNode::get_total_memory(uint64_t* total) {
   }
   *total = 0;
 
-  std::string f_path  = kKFDNodesPathRoot;
+  std::string f_path  = FsPath(kKFDNodesPathRoot);
   f_path += "/";
   f_path += std::to_string(node_indx_);
   f_path += "/mem_banks";
@@ -895,7 +912,7 @@ int KFDNode::get_used_memory(uint64_t* used) {
   if (used == nullptr) return EINVAL;
   static const char *kPathKFDIoctl = "/dev/kfd";
 
-  int kfd_fd = open(kPathKFDIoctl, O_RDWR | O_CLOEXEC);
+  int kfd_fd = open(FsPath(kPathKFDIoctl).c_str(), O_RDWR | O_CLOEXEC);
   if (kfd_fd <= 0) {
       return 1;
   }
@@ -925,7 +942,7 @@ int KFDNode::get_cache_info(rsmi_gpu_cache_info_t *info) {
   if (ret != 0)  return ret;
 
   // /sys/class/kfd/kfd/topology/nodes/1/caches/0/properties
-  std::string f_path  = kKFDNodesPathRoot;
+  std::string f_path  = FsPath(kKFDNodesPathRoot);
   f_path += "/";
   f_path += std::to_string(node_indx_);
   f_path += "/";
@@ -986,7 +1003,7 @@ int KFDNode::get_cache_info(rsmi_gpu_cache_info_t *info) {
 int read_node_properties(uint32_t node, std::string property_name,
                          uint64_t *val) {
   std::ostringstream ss;
-  std::string propertiesFullPath = "/sys/class/kfd/kfd/topology/nodes/"
+  std::string propertiesFullPath = FsPath("/sys/class/kfd/kfd/topology/nodes/")
     + std::to_string(node) + "/properties";
   int retVal = EINVAL;
   if (property_name.empty() || val == nullptr) {
@@ -999,9 +1016,11 @@ int read_node_properties(uint32_t node, std::string property_name,
     LOG_DEBUG(ss);
     return retVal;
   }
+  // Only the properties file is needed here; a full Initialize() would also
+  // walk every io_link of the node, once per property read.
   std::shared_ptr<KFDNode> myNode = std::shared_ptr<KFDNode>(new KFDNode(node));
-  myNode->Initialize();
   if (KFDNodeSupported(node)) {
+    myNode->ReadProperties();
     retVal = myNode->get_property_value(property_name, val);
     ss << __PRETTY_FUNCTION__
        << " | File: " << propertiesFullPath
@@ -1028,7 +1047,7 @@ int read_node_properties(uint32_t node, std::string property_name,
 // /sys/class/kfd/kfd/topology/nodes/*/gpu_id
 int get_gpu_id(uint32_t node, uint64_t *gpu_id) {
   std::ostringstream ss;
-  std::string gpu_id_FullPath = "/sys/class/kfd/kfd/topology/nodes/"
+  std::string gpu_id_FullPath = FsPath("/sys/class/kfd/kfd/topology/nodes/")
     + std::to_string(node) + "/gpu_id";
   int retVal = EINVAL;
   if (gpu_id == nullptr) {
@@ -1041,8 +1060,6 @@ int get_gpu_id(uint32_t node, uint64_t *gpu_id) {
     LOG_DEBUG(ss);
     return retVal;
   }
-  std::shared_ptr<KFDNode> myNode = std::shared_ptr<KFDNode>(new KFDNode(node));
-  myNode->Initialize();
   if (KFDNodeSupported(node)) {
     retVal = ReadKFDGpuId(node, gpu_id);
     ss << __PRETTY_FUNCTION__
@@ -1070,7 +1087,7 @@ int get_gpu_id(uint32_t node, uint64_t *gpu_id) {
 // /sys/class/kfd/kfd/topology/nodes/*/properties | grep gfx_target_version
 int KFDNode::get_gfx_target_version(uint64_t *gfx_target_version) {
   std::ostringstream ss;
-  std::string properties_path = "/sys/class/kfd/kfd/topology/nodes/"
+  std::string properties_path = FsPath("/sys/class/kfd/kfd/topology/nodes/")
     + std::to_string(this->node_indx_) + "/properties";
   uint64_t gfx_version = 0;
   int ret = read_node_properties(this->node_indx_, "gfx_target_version",
@@ -1090,7 +1107,7 @@ int KFDNode::get_gfx_target_version(uint64_t *gfx_target_version) {
 }
 
 int32_t KFDNode::get_simd_per_cu(uint64_t* simd_per_cu) const {
-    const std::string properties_path("/sys/class/kfd/kfd/topology/nodes/" +
+    const std::string properties_path(FsPath("/sys/class/kfd/kfd/topology/nodes/") +
                                       std::to_string(this->node_indx_) +
                                       "/properties");
 
@@ -1102,7 +1119,7 @@ int32_t KFDNode::get_simd_per_cu(uint64_t* simd_per_cu) const {
 }
 
 int32_t KFDNode::get_simd_count(uint64_t* simd_count) const {
-    const std::string properties_path("/sys/class/kfd/kfd/topology/nodes/" +
+    const std::string properties_path(FsPath("/sys/class/kfd/kfd/topology/nodes/") +
                                       std::to_string(this->node_indx_) +
                                       "/properties");
 
@@ -1117,7 +1134,7 @@ int32_t KFDNode::get_simd_count(uint64_t* simd_count) const {
 // /sys/class/kfd/kfd/topology/nodes/*/gpu_id
 int KFDNode::get_gpu_id(uint64_t *gpu_id) {
   std::ostringstream ss;
-  std::string gpuid_path = "/sys/class/kfd/kfd/topology/nodes/"
+  std::string gpuid_path = FsPath("/sys/class/kfd/kfd/topology/nodes/")
     + std::to_string(this->node_indx_) + "/gpu_id";
   const uint64_t undefined_gpu_id = std::numeric_limits<uint64_t>::max();
   std::string gpu_id_string = "";
@@ -1156,7 +1173,7 @@ int KFDNode::get_gpu_id(uint64_t *gpu_id) {
 int KFDNode::get_node_id(uint32_t *node_id) {
   std::ostringstream ss;
   int ret = 0;
-  std::string nodeid_path = "/sys/class/kfd/kfd/topology/nodes/"
+  std::string nodeid_path = FsPath("/sys/class/kfd/kfd/topology/nodes/")
     + std::to_string(this->node_indx_);
   ss << __PRETTY_FUNCTION__
      << " | File: " << nodeid_path
@@ -60,18 +60,329 @@
  */
 
 // C++ Header File(s)
+#include <cstdio>
 #include <cstdlib>
 #include <chrono>
+#include <condition_variable>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <thread>
+
+#include <sys/syscall.h>
+#include <unistd.h>
 
 // Code Specific Header Files(s)
 #include "rocm_smi/rocm_smi_logger.h"
 #include "rocm_smi/rocm_smi_main.h"
 
 
+namespace ROCmLogging {
+
+// Default number of messages the log queue holds (RSMI_LOGGING_QUEUE_SIZE)
+static const uint32_t kDefaultLogQueueSize = 8192;
+// How long the writer thread sleeps when the queue is empty
+static const auto kLogWriterPollInterval = std::chrono::milliseconds(10);
+// Queue slots keep the text buffer of their last message, up to this size
+static const size_t kMaxKeptRecordSize = 4096;
+// Initial size of the file and console batches
+static const size_t kLogBatchReserve = 64 * 1024;
+
+static const uint8_t kLogToFile = 0x1;
+static const uint8_t kLogToConsole = 0x2;
+
+// One message, as handed over to the writer thread. Records live in the
+// queue's slots and are written in place, so a slot's text buffer is reused
+// by the next message that lands in it.
+struct LogRecord {
+  uint64_t m_TimeUs = 0;         // system_clock, in usec
+  const char* m_Level = nullptr;  // nullptr for BUFFER (raw) messages
+  uint32_t m_ThreadId = 0;
+  uint8_t m_Destinations = 0;
+  std::string m_Text;
+};
+
+// Bounded multi-producer, single-consumer queue of LogRecord (Vyukov's
+// bounded queue), drained by a thread that formats and writes the records
+// in batches.
+class AsyncLogWriter {
+ public:
+  AsyncLogWriter(uint32_t queueSize, bool jsonLines, std::ofstream* file)
+      : m_File(file), m_JsonLines(jsonLines) {
+    uint32_t size = 64;
+    while (size < queueSize && size < (1U << 20)) {
+      size <<= 1;
+    }
+    m_Mask = size - 1;
+    m_Cells.reset(new Cell[size]);
+    for (uint32_t i = 0; i < size; ++i) {
+      m_Cells[i].m_Sequence.store(i, std::memory_order_relaxed);
+    }
+    m_FileBatch.reserve(kLogBatchReserve);
+    m_ConsoleBatch.reserve(kLogBatchReserve);
+    m_Thread = std::thread(&AsyncLogWriter::writerLoop, this);
+  }
+
+  ~AsyncLogWriter() {
+    {
+      std::lock_guard<std::mutex> guard(m_WakeMutex);
+      m_Stopping = true;
+    }
+    m_WakeCv.notify_all();
+    if (m_Thread.joinable()) {
+      m_Thread.join();
+    }
+  }
+
+  // Never blocks; returns false and counts the message as dropped if the
+  // queue is full
+  bool push(uint64_t timeUs, const char* level, uint32_t threadId,
+            uint8_t destinations, const char* text) {
+    uint64_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &m_Cells[pos & m_Mask];
+      uint64_t seq = cell->m_Sequence.load(std::memory_order_acquire);
+      int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        m_Dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        pos = m_EnqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    LogRecord& record = cell->m_Record;
+    record.m_TimeUs = timeUs;
+    record.m_Level = level;
+    record.m_ThreadId = threadId;
+    record.m_Destinations = destinations;
+    record.m_Text.assign(text);
+    cell->m_Sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  void flush() {
+    uint64_t target = m_EnqueuePos.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(m_WakeMutex);
+    m_FlushRequested = true;
+    m_WakeCv.notify_all();
+    m_FlushedCv.wait(lock, [&]() { return m_Written >= target || m_Stopping; });
+  }
+
+  uint64_t dropped() const {
+    return m_Dropped.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Cell {
+    std::atomic<uint64_t> m_Sequence{0};
+    LogRecord m_Record;
+  };
+
+  // Oldest complete record, or nullptr if there is none
+  Cell* front() {
+    Cell& cell = m_Cells[m_DequeuePos & m_Mask];
+    uint64_t seq = cell.m_Sequence.load(std::memory_order_acquire);
+    return (seq == m_DequeuePos + 1) ? &cell : nullptr;
+  }
+
+  // Hands the slot of front() back to the producers
+  void release(Cell* cell) {
+    std::string& text = cell->m_Record.m_Text;
+    if (text.capacity() > kMaxKeptRecordSize) {
+      std::string().swap(text);
+    }
+    cell->m_Sequence.store(m_DequeuePos + m_Mask + 1, std::memory_order_release);
+    ++m_DequeuePos;
+  }
+
+  void writerLoop() {
+    std::string* fileBatch = &m_FileBatch;
+    std::string* consoleBatch = &m_ConsoleBatch;
+    for (;;) {
+      Cell* cell;
+      while ((cell = front()) != nullptr) {
+        appendRecord(cell->m_Record, fileBatch, consoleBatch);
+        release(cell);
+        // Keep batches bounded when the queue is refilled as fast as it drains
+        if (fileBatch->size() + consoleBatch->size() > (1U << 20)) {
+          writeBatches(fileBatch, consoleBatch);
+        }
+      }
+      reportDropped(fileBatch, consoleBatch);
+      writeBatches(fileBatch, consoleBatch);
+
+      std::unique_lock<std::mutex> lock(m_WakeMutex);
+      m_Written = m_DequeuePos;
+      m_FlushedCv.notify_all();
+      if (m_Stopping && !hasPending()) {
+        return;
+      }
+      if (!m_FlushRequested) {
+        m_WakeCv.wait_for(lock, kLogWriterPollInterval,
+                          [this]() { return m_Stopping || m_FlushRequested; });
+      }
+      m_FlushRequested = false;
+    }
+  }
+
+  bool hasPending() const {
+    const Cell& cell = m_Cells[m_DequeuePos & m_Mask];
+    return cell.m_Sequence.load(std::memory_order_acquire) == m_DequeuePos + 1;
+  }
+
+  void reportDropped(std::string* fileBatch, std::string* consoleBatch) {
+    uint64_t dropped = m_Dropped.load(std::memory_order_relaxed);
+    if (dropped == m_DroppedReported) {
+      return;
+    }
+    LogRecord record;
+    record.m_TimeUs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    record.m_Level = "ALARM";
+    record.m_Destinations = m_LastDestinations;
+    record.m_Text = "Log queue full, dropped "
+                    + std::to_string(dropped - m_DroppedReported)
+                    + " messages";
+    m_DroppedReported = dropped;
+    appendRecord(record, fileBatch, consoleBatch);
+  }
+
+  // YYYY-MM-DD HH:MM:SS.microseconds; localtime() only runs once a second
+  void appendTime(uint64_t timeUs, std::string* out) {
+    time_t seconds = static_cast<time_t>(timeUs / 1000000);
+    if (seconds != m_CachedSeconds) {
+      std::tm bt;
+      localtime_r(&seconds, &bt);
+      char buf[32];
+      strftime(buf, sizeof(buf), "%F %T", &bt);
+      m_CachedTime = buf;
+      m_CachedSeconds = seconds;
+    }
+    char usec[16];
+    snprintf(usec, sizeof(usec), ".%06u",
+             static_cast<unsigned>(timeUs % 1000000));
+    out->append(m_CachedTime);
+    out->append(usec);
+  }
+
+  static void appendJsonString(const std::string& text, std::string* out) {
+    out->push_back('"');
+    for (char c : text) {
+      switch (c) {
+        case '"':  out->append("\\\""); break;
+        case '\\': out->append("\\\\"); break;
+        case '\n': out->append("\\n"); break;
+        case '\r': out->append("\\r"); break;
+        case '\t': out->append("\\t"); break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+            out->append(buf);
+          } else {
+            out->push_back(c);
+          }
+      }
+    }
+    out->push_back('"');
+  }
+
+  void appendRecord(const LogRecord& record, std::string* fileBatch,
+                    std::string* consoleBatch) {
+    std::string& line = m_Line;
+    line.clear();
+    if (m_JsonLines) {
+      line.append("{\"time\":\"");
+      appendTime(record.m_TimeUs, &line);
+      line.append("\",\"level\":\"");
+      line.append(record.m_Level != nullptr ? record.m_Level : "BUFFER");
+      line.append("\",\"tid\":");
+      line.append(std::to_string(record.m_ThreadId));
+      line.append(",\"message\":");
+      appendJsonString(record.m_Text, &line);
+      line.append("}\n");
+    } else if (record.m_Level == nullptr) {
+      // Buffer is the special case: just the raw bytes
+      line.append(record.m_Text);
+      line.push_back('\n');
+    } else {
+      appendTime(record.m_TimeUs, &line);
+      line.append("  [");
+      line.append(record.m_Level);
+      line.append("]: ");
+      line.append(record.m_Text);
+      line.push_back('\n');
+    }
+    if (record.m_Destinations & kLogToFile) {
+      fileBatch->append(line);
+    }
+    if (record.m_Destinations & kLogToConsole) {
+      consoleBatch->append(line);
+    }
+    if (record.m_Destinations != 0) {
+      m_LastDestinations = record.m_Destinations;
+    }
+  }
+
+  void writeBatches(std::string* fileBatch, std::string* consoleBatch) {
+    if (!fileBatch->empty()) {
+      if (m_File != nullptr && m_File->is_open()) {
+        m_File->write(fileBatch->data(),
+                      static_cast<std::streamsize>(fileBatch->size()));
+        m_File->flush();
+      } else {
+        std::cout << "WARNING: log file is not open."
+                  << " Unable to print the following messages." << std::endl;
+        std::cout.write(fileBatch->data(),
+                        static_cast<std::streamsize>(fileBatch->size()));
+        std::cout.flush();
+      }
+      fileBatch->clear();
+    }
+    if (!consoleBatch->empty()) {
+      std::cout.write(consoleBatch->data(),
+                      static_cast<std::streamsize>(consoleBatch->size()));
+      std::cout.flush();
+      consoleBatch->clear();
+    }
+  }
+
+  std::ofstream* m_File;
+  bool m_JsonLines;
+  uint64_t m_Mask = 0;
+  std::unique_ptr<Cell[]> m_Cells;
+  alignas(64) std::atomic<uint64_t> m_EnqueuePos{0};
+  alignas(64) std::atomic<uint64_t> m_Dropped{0};
+
+  // Writer thread only
+  uint64_t m_DequeuePos = 0;
+  uint64_t m_DroppedReported = 0;
+  uint8_t m_LastDestinations = kLogToFile;
+  time_t m_CachedSeconds = -1;
+  std::string m_CachedTime;
+  std::string m_Line;
+  std::string m_FileBatch;
+  std::string m_ConsoleBatch;
+
+  std::thread m_Thread;
+  std::mutex m_WakeMutex;
+  std::condition_variable m_WakeCv;
+  std::condition_variable m_FlushedCv;
+  bool m_Stopping = false;
+  bool m_FlushRequested = false;
+  uint64_t m_Written = 0;
+};
+
+}  // namespace ROCmLogging
+
 ROCmLogging::Logger *ROCmLogging::Logger::m_Instance = nullptr;
 
 // Log file name
@@ -157,28 +468,72 @@ std::string ROCmLogging::Logger::getCurrentTime(void) {
   return currentTime;
 }
 
-// Interface for Error Log
-void ROCmLogging::Logger::error(const char* text) throw() {
-  // By default, logging is disabled
+// Hands a message over to the writer thread. level is nullptr for BUFFER
+// messages, which are written without level and timestamp.
+void ROCmLogging::Logger::logMessage(const char* level, const char* text,
+                                     LogLevel minLevel) {
+  // By default, logging is disabled (ie. no RSMI_LOGGING)
   // The check below allows us to toggle logging through RSMI_LOGGING
   // set or unset
-  if (!m_loggingIsOn) {
+  if (!m_loggingIsOn || (m_LogLevel < minLevel)) {
     return;
   }
 
-  std::string data;
-  data.append("[ERROR]: ");
-  data.append(text);
-
-  // ERROR must be capture
+  uint8_t destinations = 0;
   if (m_LogType == FILE_LOG) {
-    logIntoFile(data);
+    destinations = kLogToFile;
   } else if (m_LogType == CONSOLE) {
-    logOnConsole(data);
+    destinations = kLogToConsole;
   } else if (m_LogType == BOTH_FILE_AND_CONSOLE) {
-    logOnConsole(data);
-    logIntoFile(data);
+    destinations = kLogToFile | kLogToConsole;
   }
+  if (destinations == 0) {
+    return;
+  }
+
+  // stopWriter() waits for the messages being pushed before it frees the
+  // writer
+  m_WriterUsers.fetch_add(1);
+  AsyncLogWriter* writer = m_Writer.load();
+
+  // A forked child does not have the writer thread of its parent
+  if (writer == nullptr || m_WriterPid != getpid()) {
+    m_WriterUsers.fetch_sub(1, std::memory_order_release);
+    std::string data;
+    if (level == nullptr) {
+      data.append(text);
+      std::lock_guard<std::mutex> guard(m_Mutex);
+      if ((destinations & kLogToConsole) != 0) {
+        std::cout << data << std::endl;
+      }
+      if ((destinations & kLogToFile) != 0 && m_File.is_open()) {
+        m_File << data << std::endl;
+      }
+      return;
+    }
+    data.append("[").append(level).append("]: ").append(text);
+    if ((destinations & kLogToConsole) != 0) {
+      logOnConsole(data);
+    }
+    if ((destinations & kLogToFile) != 0) {
+      logIntoFile(data);
+    }
+    return;
+  }
+
+  thread_local uint32_t threadId =
+      static_cast<uint32_t>(syscall(SYS_gettid));
+  uint64_t timeUs = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count());
+  writer->push(timeUs, level, threadId, destinations, text);
+  m_WriterUsers.fetch_sub(1, std::memory_order_release);
+}
+
+// Interface for Error Log
+void ROCmLogging::Logger::error(const char* text) throw() {
+  // ERROR must be capture
+  logMessage("ERROR", text, DISABLE_LOG);
 }
 
 void ROCmLogging::Logger::error(std::string& text) throw() {
@@ -193,26 +548,8 @@ void ROCmLogging::Logger::error(std::ostringstream& stream) throw() {
 
 // Interface for Alarm Log
 void ROCmLogging::Logger::alarm(const char* text) throw() {
-  // By default, logging is disabled (ie. no RSMI_LOGGING)
-  // The check below allows us to toggle logging through RSMI_LOGGING
-  // set or unset
-  if (!m_loggingIsOn) {
-    return;
-  }
-
-  std::string data;
-  data.append("[ALARM]: ");
-  data.append(text);
-
   // ALARM must be capture
-  if (m_LogType == FILE_LOG) {
-    logIntoFile(data);
-  } else if (m_LogType == CONSOLE) {
-    logOnConsole(data);
-  } else if (m_LogType == BOTH_FILE_AND_CONSOLE) {
-    logOnConsole(data);
-    logIntoFile(data);
-  }
+  logMessage("ALARM", text, DISABLE_LOG);
 }
 
 void ROCmLogging::Logger::alarm(std::string& text) throw() {
@@ -227,26 +564,8 @@ void ROCmLogging::Logger::alarm(std::ostringstream& stream) throw() {
 
 // Interface for Always Log
 void ROCmLogging::Logger::always(const char* text) throw() {
-  // By default, logging is disabled (ie. no RSMI_LOGGING)
-  // The check below allows us to toggle logging through RSMI_LOGGING
-  // set or unset
-  if (!m_loggingIsOn) {
-    return;
-  }
-
-  std::string data;
-  data.append("[ALWAYS]: ");
-  data.append(text);
-
   // No check for ALWAYS logs
-  if (m_LogType == FILE_LOG) {
-    logIntoFile(data);
-  } else if (m_LogType == CONSOLE) {
-    logOnConsole(data);
-  } else if (m_LogType == BOTH_FILE_AND_CONSOLE) {
-    logOnConsole(data);
-    logIntoFile(data);
-  }
+  logMessage("ALWAYS", text, DISABLE_LOG);
 }
 
 void ROCmLogging::Logger::always(std::string& text) throw() {
@@ -263,24 +582,7 @@ void ROCmLogging::Logger::always(std::ostringstream& stream) throw() {
 void ROCmLogging::Logger::buffer(const char* text) throw() {
   // Buffer is the special case. So don't add log level
   // and timestamp in the buffer message. Just log the raw bytes.
-  if ((m_LogType == FILE_LOG) && (m_LogLevel >= LOG_LEVEL_BUFFER)) {
-    lock();
-    if(!m_File.is_open()) {
-      initialize_resources();
-      if (!m_File.is_open()) {
-        std::cout << "WARNING: re-initializing resources was unsuccessful."
-                  <<" Unable to print the following message." << std::endl;
-        std::string txtStr(text);
-        std::cout << txtStr << std::endl;
-        unlock();
-        return;
-      }
-    }
-    m_File << text << std::endl;
-    unlock();
-  } else if ((m_LogType == CONSOLE) && (m_LogLevel >= LOG_LEVEL_BUFFER)) {
-    std::cout << text << std::endl;
-  }
+  logMessage(nullptr, text, LOG_LEVEL_BUFFER);
 }
 
 void ROCmLogging::Logger::buffer(std::string& text) throw() {
@@ -295,26 +597,7 @@ void ROCmLogging::Logger::buffer(std::ostringstream& stream) throw() {
 
 // Interface for Info Log
 void ROCmLogging::Logger::info(const char* text) throw() {
-  // By default, logging is disabled (ie. no RSMI_LOGGING)
-  // The check below allows us to toggle logging through RSMI_LOGGING
-  // set or unset
-  if (!m_loggingIsOn) {
-    return;
-  }
-
-  std::string data;
-  data.append("[INFO]: ");
-  data.append(text);
-
-  if ((m_LogType == FILE_LOG) && (m_LogLevel >= LOG_LEVEL_INFO)) {
-    logIntoFile(data);
-  } else if ((m_LogType == CONSOLE) && (m_LogLevel >= LOG_LEVEL_INFO)) {
-    logOnConsole(data);
-  } else if ((m_LogType == BOTH_FILE_AND_CONSOLE)
-             && (m_LogLevel >= LOG_LEVEL_INFO)) {
-    logOnConsole(data);
-    logIntoFile(data);
-  }
+  logMessage("INFO", text, LOG_LEVEL_INFO);
 }
 
 void ROCmLogging::Logger::info(std::string& text) throw() {
@@ -329,26 +612,7 @@ void ROCmLogging::Logger::info(std::ostringstream& stream) throw() {
 
 // Interface for Trace Log
 void ROCmLogging::Logger::trace(const char* text) throw() {
-  // By default, logging is disabled (ie. no RSMI_LOGGING)
-  // The check below allows us to toggle logging through RSMI_LOGGING
-  // set or unset
-  if (!m_loggingIsOn) {
-    return;
-  }
-
-  std::string data;
-  data.append("[TRACE]: ");
-  data.append(text);
-
-  if ((m_LogType == FILE_LOG) && (m_LogLevel >= LOG_LEVEL_TRACE)) {
-    logIntoFile(data);
-  } else if ((m_LogType == CONSOLE) && (m_LogLevel >= LOG_LEVEL_TRACE)) {
-    logOnConsole(data);
-  } else if ((m_LogType == BOTH_FILE_AND_CONSOLE)
-             && (m_LogLevel >= LOG_LEVEL_TRACE)) {
-    logOnConsole(data);
-    logIntoFile(data);
-  }
+  logMessage("TRACE", text, LOG_LEVEL_TRACE);
 }
 
 void ROCmLogging::Logger::trace(std::string& text) throw() {
@@ -363,26 +627,7 @@ void ROCmLogging::Logger::trace(std::ostringstream& stream) throw() {
 
 // Interface for Debug Log
 void ROCmLogging::Logger::debug(const char* text) throw() {
-  // By default, logging is disabled (ie. no RSMI_LOGGING)
-  // The check below allows us to toggle logging through RSMI_LOGGING
-  // set or unset
-  if (!m_loggingIsOn) {
-    return;
-  }
-
-  std::string data;
-  data.append("[DEBUG]: ");
-  data.append(text);
-
-  if ((m_LogType == FILE_LOG) && (m_LogLevel >= LOG_LEVEL_DEBUG)) {
-    logIntoFile(data);
-  } else if ((m_LogType == CONSOLE) && (m_LogLevel >= LOG_LEVEL_DEBUG)) {
-    logOnConsole(data);
-  } else if ((m_LogType == BOTH_FILE_AND_CONSOLE)
-             && (m_LogLevel >= LOG_LEVEL_DEBUG)) {
-    logOnConsole(data);
-    logIntoFile(data);
-  }
+  logMessage("DEBUG", text, LOG_LEVEL_DEBUG);
 }
 
 void ROCmLogging::Logger::debug(std::string& text) throw() {
@@ -398,28 +643,34 @@ void ROCmLogging::Logger::debug(std::ostringstream& stream) throw() {
 // Interfaces to control log levels
 void ROCmLogging::Logger::updateLogLevel(LogLevel logLevel) {
   m_LogLevel = logLevel;
+  updateActiveLogLevel();
 }
 
 void ROCmLogging::Logger::enableAllLogLevels() {
   m_LogLevel = ENABLE_LOG;
+  updateActiveLogLevel();
 }
 
 // Disable all log levels, except error and alarm
 void ROCmLogging::Logger::disableLog() {
   m_LogLevel = DISABLE_LOG;
+  updateActiveLogLevel();
 }
 
 // Interfaces to control log Types
 void ROCmLogging::Logger::updateLogType(LogType logType) {
   m_LogType = logType;
+  updateActiveLogLevel();
 }
 
 void ROCmLogging::Logger::enableConsoleLogging() {
   m_LogType = CONSOLE;
+  updateActiveLogLevel();
 }
 
 void ROCmLogging::Logger::enableFileLogging() {
   m_LogType = FILE_LOG;
+  updateActiveLogLevel();
 }
 
 // Returns a string of details on current log settings
@@ -475,10 +726,79 @@ std::string ROCmLogging::Logger::getLogSettings() {
     default:
       logSettings += "LogLevel = <undefined>";
   }
+  logSettings += ", DroppedMessages = " + std::to_string(getDroppedLogCount());
 
   return logSettings;
 }
 
+void ROCmLogging::Logger::updateActiveLogLevel() {
+  if (!m_loggingIsOn || (m_LogType == NO_LOG)) {
+    m_activeLogLevel.store(0, std::memory_order_relaxed);
+  } else {
+    m_activeLogLevel.store(m_LogLevel, std::memory_order_relaxed);
+  }
+}
+
+uint64_t ROCmLogging::Logger::getDroppedLogCount() {
+  std::lock_guard<std::mutex> guard(m_WriterMutex);
+  AsyncLogWriter* writer = m_Writer.load(std::memory_order_acquire);
+  return (writer != nullptr) ? writer->dropped() : 0;
+}
+
+void ROCmLogging::Logger::flush() {
+  std::lock_guard<std::mutex> guard(m_WriterMutex);
+  AsyncLogWriter* writer = m_Writer.load(std::memory_order_acquire);
+  if (writer != nullptr && m_WriterPid == getpid()) {
+    writer->flush();
+  }
+}
+
+void ROCmLogging::Logger::startWriter() {
+  std::lock_guard<std::mutex> guard(m_WriterMutex);
+  if (!m_loggingIsOn || m_LogType == NO_LOG ||
+      m_Writer.load(std::memory_order_relaxed) != nullptr) {
+    return;
+  }
+  const auto& env = amd::smi::RocmSMI::getInstance().getEnv();
+  uint32_t queueSize = (env.logging_queue_size != 0) ?
+                       env.logging_queue_size : kDefaultLogQueueSize;
+  m_WriterPid = getpid();
+  m_Writer.store(new AsyncLogWriter(queueSize, env.logging_json != 0, &m_File),
+                 std::memory_order_release);
+}
+
+void ROCmLogging::Logger::stopWriter() {
+  std::lock_guard<std::mutex> guard(m_WriterMutex);
+  AsyncLogWriter* writer = m_Writer.exchange(nullptr);
+  if (writer == nullptr) {
+    return;
+  }
+  // Messages logged from now on are written by their caller; wait for the
+  // ones already being pushed
+  while (m_WriterUsers.load() != 0) {
+    std::this_thread::yield();
+  }
+  if (m_WriterPid != getpid()) {
+    // The thread of a forked child's writer only exists in the parent
+    return;
+  }
+  // Writes out what is queued and joins the writer thread
+  delete writer;
+}
+
+namespace {
+// Stops the writer thread while this library is still loaded, whether the
+// process exits or the library is unloaded without rsmi_shut_down()
+struct LogWriterStopper {
+  ~LogWriterStopper() {
+    if (ROCmLogging::Logger::hasInstance()) {
+      ROCmLogging::Logger::getInstance()->stopWriter();
+    }
+  }
+};
+LogWriterStopper logWriterStopper;
+}  // namespace
+
 // Returns current reported enabled logging state. State is controlled by
 // user's environment variable RSMI_LOGGING.
 bool ROCmLogging::Logger::isLoggerEnabled() {
@@ -491,6 +811,7 @@ void ROCmLogging::Logger::initialize_resources() {
   // set or unset
   m_loggingIsOn = amd::smi::RocmSMI::getInstance().isLoggingOn();
   if (!m_loggingIsOn) {
+    updateActiveLogLevel();
     return;
   }
   m_File.open(logFileName, std::ios::out | std::ios::app);
@@ -515,6 +836,7 @@ void ROCmLogging::Logger::initialize_resources() {
       m_LogType = NO_LOG;
       break;
   }
+  updateActiveLogLevel();
   if (!m_File.is_open()) {
     std::cout << "WARNING: Issue opening log file (" << logFileName
               << ") to write." << std::endl;
@@ -523,8 +845,11 @@ void ROCmLogging::Logger::initialize_resources() {
     std::cout << "WARNING: Failed opening log file." << std::endl;
   }
   chmod(logFileName, S_IRUSR|S_IRGRP|S_IROTH|S_IWUSR|S_IWGRP|S_IWOTH);
+
+  startWriter();
 }
 
 void ROCmLogging::Logger::destroy_resources() {
+  stopWriter();
   m_File.close();
 }
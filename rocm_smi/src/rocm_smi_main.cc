@@ -45,6 +45,7 @@
 #include <unistd.h>
 
 #include <cassert>
+#include <cctype>
 #include <cerrno>
 #include <cstdint>
 #include <cstdlib>
@@ -57,6 +58,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -77,6 +79,13 @@ static const char *kDeviceNamePrefix = "card";
 
 static const char *kAMDMonitorTypes[] = {"radeon", "amdgpu", ""};
 
+// gpu_metrics snapshot max age used with RSMI_INIT_FLAG_GPU_METRICS_CACHE
+static const uint64_t kDefaultGpuMetricsCacheTtlUs = 1000;
+// Upper bounds of the RSMI_GPU_METRICS_CACHE_TTL_US and
+// RSMI_LOGGING_QUEUE_SIZE env. variables
+static const uint32_t kMaxGpuMetricsCacheTtlUs = 10000000;
+static const uint32_t kMaxLogQueueSize = 65536;
+
 namespace amd {
 namespace smi {
 
@@ -248,11 +257,23 @@ RocmSMI::Initialize(uint64_t flags) {
   euid_ = geteuid();
 
   GetEnvVariables();
+  lazy_init_ = (flags & static_cast<uint64_t>(RSMI_INIT_FLAG_LAZY)) ||
+               (env_vars_.lazy_init != 0);
+  discovery_cache_ =
+      (flags & static_cast<uint64_t>(RSMI_INIT_FLAG_DISCOVERY_CACHE)) ||
+      (env_vars_.discovery_cache != 0);
+  lockless_reads_ =
+      (flags & static_cast<uint64_t>(RSMI_INIT_FLAG_LOCKLESS_READS)) ||
+      (env_vars_.lockless_reads != 0);
+  io_links_discovered_ = false;
+  boot_partitions_stored_ = false;
   // To help debug env variable issues
   // debugRSMIEnvVarInfo();
 
   if (ROCmLogging::Logger::getInstance()->isLoggerEnabled()) {
     ROCmLogging::Logger::getInstance()->enableAllLogLevels();
+    // Stopped by the Cleanup() of a previous rsmi_shut_down()
+    ROCmLogging::Logger::getInstance()->startWriter();
     LOG_ALWAYS("=============== ROCM SMI initialize ================");
     logSystemDetails();
   }
@@ -309,6 +330,20 @@ RocmSMI::Initialize(uint64_t flags) {
       LOG_TRACE(ss);
   }
 
+  const bool sysfs_fd_cache =
+      (flags & static_cast<uint64_t>(RSMI_INIT_FLAG_SYSFS_FD_CACHE)) ||
+      (env_vars_.sysfs_fd_cache != 0);
+  uint64_t gpu_metrics_cache_ttl_us =
+      (flags & static_cast<uint64_t>(RSMI_INIT_FLAG_GPU_METRICS_CACHE)) ?
+      kDefaultGpuMetricsCacheTtlUs : 0;
+  if (env_vars_.gpu_metrics_cache_ttl_us != 0) {
+    gpu_metrics_cache_ttl_us = env_vars_.gpu_metrics_cache_ttl_us;
+  }
+  for (auto & device : devices_) {
+    device->set_sysfs_fd_cache_enabled(sysfs_fd_cache);
+    device->set_gpu_metrics_cache_ttl(gpu_metrics_cache_ttl_us);
+  }
+
   std::shared_ptr<amd::smi::Device> dev;
   // Sort index based on the BDF, collect BDF id firstly.
   std::vector<std::pair<uint64_t, std::shared_ptr<amd::smi::Device>>> dv_to_id;
@@ -336,22 +371,19 @@ RocmSMI::Initialize(uint64_t flags) {
   }
 
   std::map<uint64_t, std::shared_ptr<KFDNode>> tmp_map;
-  i_ret = DiscoverKFDNodes(&tmp_map);
+  i_ret = DiscoverKFDNodes(&tmp_map, lazy_init_);
   if (i_ret != 0) {
     throw amd::smi::rsmi_exception(RSMI_INITIALIZATION_ERROR,
                  "Failed to initialize rocm_smi library (KFD node discovery).");
   }
 
-  std::map<std::pair<uint32_t, uint32_t>, std::shared_ptr<IOLink>>
-    io_link_map_tmp;
-  i_ret = DiscoverIOLinks(&io_link_map_tmp);
-  if (i_ret != 0) {
-    throw amd::smi::rsmi_exception(RSMI_INITIALIZATION_ERROR,
+  if (!lazy_init_) {
+    i_ret = DiscoverIOLinksOnce();
+    if (i_ret != 0) {
+      throw amd::smi::rsmi_exception(RSMI_INITIALIZATION_ERROR,
                  "Failed to initialize rocm_smi library (IO Links discovery).");
+    }
   }
-  std::map<std::pair<uint32_t, uint32_t>, std::shared_ptr<IOLink>>::iterator it;
-  for (it = io_link_map_tmp.begin(); it != io_link_map_tmp.end(); it++)
-    io_link_map_[it->first] = it->second;
 
 
   // Remove any drm nodes that don't have  a corresponding readable kfd node.
@@ -372,7 +404,6 @@ RocmSMI::Initialize(uint64_t flags) {
   // 1. construct kfd_node_map_ with gpu_id as key and *Device as value
   // 2. for each kfd node, write the corresponding dv_ind
   // 3. for each amdgpu device, write the corresponding gpu_id
-  // 4. for each amdgpu device, attempt to store it's boot partition
   for (uint32_t dv_ind = 0; dv_ind < devices_.size(); ++dv_ind) {
     dev = devices_[dv_ind];
     uint64_t bdfid = dev->bdfid();
@@ -387,9 +418,15 @@ RocmSMI::Initialize(uint64_t flags) {
     uint64_t gpu_id = tmp_map[bdfid]->gpu_id();
     dev->set_kfd_gpu_id(gpu_id);
     kfd_node_map_[gpu_id] = tmp_map[bdfid];
+  }
 
-    // store each device boot partition state, if file doesn't exist
-    dev->storeDevicePartitions(dv_ind);
+  if (discovery_cache_) {
+    ApplyDiscoveryCache();
+  }
+
+  // 4. for each amdgpu device, attempt to store it's boot partition
+  if (!lazy_init_) {
+    StoreBootPartitions();
   }
 
   // Assists displaying GPU information after device enumeration
@@ -409,9 +446,22 @@ void
 RocmSMI::Cleanup() {
   devices_.clear();
   monitors_.clear();
+  {
+    std::lock_guard<std::mutex> guard(io_link_map_mutex_);
+    io_link_map_.clear();
+    io_links_discovered_ = false;
+  }
+
+  evt_notifier_.reset();
+  kfd_notif_evt_fh_refcnt_ = 0;
 
+  // Write out the queued log messages and join the log writer thread
+  if (ROCmLogging::Logger::hasInstance()) {
+    ROCmLogging::Logger::getInstance()->stopWriter();
+  }
   if (kfd_notif_evt_fh() >= 0) {
     int ret = close(kfd_notif_evt_fh());
+    set_kfd_notif_evt_fh(-1);
     if (ret < 0) {
       throw amd::smi::rsmi_exception(RSMI_STATUS_FILE_ERROR,
                  "Failed to close kfd file handle on shutdown.");
@@ -419,7 +469,10 @@ RocmSMI::Cleanup() {
   }
 }
 
-RocmSMI::RocmSMI(uint64_t flags) : init_options_(flags),
+RocmSMI::RocmSMI(uint64_t flags) : io_links_discovered_(false),
+                          boot_partitions_stored_(false), lazy_init_(false),
+                          discovery_cache_(false), lockless_reads_(false),
+                          init_options_(flags),
                           kfd_notif_evt_fh_(-1), kfd_notif_evt_fh_refcnt_(0) {
 }
 
@@ -447,19 +500,50 @@ static uint32_t GetEnvVarUInteger(const char *ev_str) {
   return 0;
 }
 
+// Parses an env. variable value as an unsigned decimal or hex number. Unset,
+// empty, negative or malformed values read as 0 (the knob's default); larger
+// values are clamped to max_val.
+static uint32_t parseRSMIEnvVar_UInteger(const char *ev_str, uint32_t max_val) {
+  if (ev_str == nullptr) {
+    return 0;
+  }
+  while (std::isspace(static_cast<unsigned char>(*ev_str))) {
+    ++ev_str;
+  }
+  // strtoul() would accept "-1" and wrap it around
+  if (!std::isdigit(static_cast<unsigned char>(*ev_str))) {
+    return 0;
+  }
+  char *end = nullptr;
+  errno = 0;
+  unsigned long val = strtoul(ev_str, &end, 0);  // NOLINT
+  while (std::isspace(static_cast<unsigned char>(*end))) {
+    ++end;
+  }
+  if (*end != '\0') {
+    return 0;
+  }
+  if (errno == ERANGE || val > max_val) {
+    return max_val;
+  }
+  return static_cast<uint32_t>(val);
+}
+
+// Reads a non-debug env. variable (honored in all builds), see
+// parseRSMIEnvVar_UInteger()
+static uint32_t getRSMIEnvVar_UInteger(const char *ev_str, uint32_t max_val) {
+  return parseRSMIEnvVar_UInteger(getenv(ev_str), max_val);
+}
+
 // provides a way to get env variable detail in both debug & release
 // helps enable full logging
 // RSMI_LOGGING = 1, output to logs only
 // RSMI_LOGGING = 2, output to console only
 // RSMI_LOGGING = 3, output to logs and console
+// Any other value leaves logging off.
 static uint32_t getRSMIEnvVar_LoggingEnabled(const char *ev_str) {
-  uint32_t ret = 0;
-  ev_str = getenv(ev_str);
-  if (ev_str != nullptr) {
-    int ev_ret = atoi(ev_str);
-    ret = static_cast<uint32_t>(ev_ret);
-  }
-  return ret;
+  uint32_t ret = getRSMIEnvVar_UInteger(ev_str, UINT32_MAX);
+  return (ret <= 3) ? ret : 0;
 }
 
 static inline std::unordered_set<uint32_t> GetEnvVarUIntegerSets(
@@ -491,6 +575,25 @@ static inline std::unordered_set<uint32_t> GetEnvVarUIntegerSets(
 // Get and store env. variables in this method
 void RocmSMI::GetEnvVariables(void) {
   env_vars_.logging_on = getRSMIEnvVar_LoggingEnabled("RSMI_LOGGING");
+  env_vars_.logging_queue_size =
+      getRSMIEnvVar_UInteger("RSMI_LOGGING_QUEUE_SIZE", kMaxLogQueueSize);
+  env_vars_.logging_json = getRSMIEnvVar_UInteger("RSMI_LOGGING_JSON", 1);
+  env_vars_.sysfs_fd_cache = getRSMIEnvVar_UInteger("RSMI_SYSFS_FD_CACHE", 1);
+  env_vars_.gpu_metrics_cache_ttl_us = getRSMIEnvVar_UInteger(
+      "RSMI_GPU_METRICS_CACHE_TTL_US", kMaxGpuMetricsCacheTtlUs);
+  env_vars_.lazy_init = getRSMIEnvVar_UInteger("RSMI_LAZY_INIT", 1);
+  // The discovery cache file is created and renamed over by the caller, so
+  // its env. overrides are only for test builds, and setuid callers never
+  // see them; release builds use the fixed root-owned path (or the flag).
+#if defined(DEBUG) || defined(RSMI_ENABLE_TEST_OVERRIDES)
+  env_vars_.discovery_cache =
+      parseRSMIEnvVar_UInteger(secure_getenv("RSMI_DISCOVERY_CACHE"), 1);
+  env_vars_.discovery_cache_path = secure_getenv("RSMI_DISCOVERY_CACHE_PATH");
+#else
+  env_vars_.discovery_cache = 0;
+  env_vars_.discovery_cache_path = nullptr;
+#endif
+  env_vars_.lockless_reads = getRSMIEnvVar_UInteger("RSMI_LOCKLESS_READS", 1);
 #ifndef DEBUG
   (void)GetEnvVarUInteger(nullptr);  // This is to quiet release build warning.
   env_vars_.debug_output_bitfield = 0;
@@ -556,6 +659,26 @@ std::string RocmSMI::getRSMIEnvVarInfo(void) {
      << std::endl;
   ss << "\tRSMI_LOGGING = "
             << getLogSetting() << std::endl;
+  ss << "\tRSMI_LOGGING_QUEUE_SIZE = "
+     << env_vars_.logging_queue_size << std::endl;
+  ss << "\tRSMI_LOGGING_JSON = "
+     << env_vars_.logging_json << std::endl;
+  ss << "\tRSMI_SYSFS_FD_CACHE = "
+     << env_vars_.sysfs_fd_cache << std::endl;
+  ss << "\tRSMI_GPU_METRICS_CACHE_TTL_US = "
+     << env_vars_.gpu_metrics_cache_ttl_us << std::endl;
+  ss << "\tRSMI_LAZY_INIT = "
+     << env_vars_.lazy_init << std::endl;
+  ss << "\tRSMI_DISCOVERY_CACHE = "
+     << env_vars_.discovery_cache << std::endl;
+  ss << "\tRSMI_LOCKLESS_READS = "
+     << env_vars_.lockless_reads << std::endl;
+  ss << "\tRSMI_DISCOVERY_CACHE_PATH = "
+     << ((env_vars_.discovery_cache_path == nullptr)
+          ? "<undefined>" : env_vars_.discovery_cache_path)
+     << std::endl;
+  ss << "\tRSMI_FS_ROOT = "
+     << (FsRoot().empty() ? "<undefined>" : FsRoot()) << std::endl;
   bool isLoggingOn = RocmSMI::isLoggingOn() ? true : false;
   ss << "\tRSMI_LOGGING (are logs on) = "
             << (isLoggingOn ? "TRUE" : "FALSE") << std::endl;
@@ -633,7 +756,7 @@ RocmSMI::FindMonitor(std::string monitor_path) {
 
   if (closedir(mon_dir)) {
     err_msg = "Failed to close monitor directory ";
-    err_msg += kPathHWMonRoot;
+    err_msg += FsPath(kPathHWMonRoot);
     err_msg += ".";
     perror(err_msg.c_str());
     return nullptr;
@@ -646,20 +769,28 @@ void RocmSMI::AddToDeviceList(std::string dev_name, uint64_t bdfid) {
   std::ostringstream ss;
   ss << __PRETTY_FUNCTION__ << " | ======= start =======";
   LOG_TRACE(ss);
-  auto dev_path = std::string(kPathDRMRoot);
+  auto dev_path = FsPath(kPathDRMRoot);
   dev_path += "/";
   dev_path += dev_name;
 
   auto dev = std::make_shared<Device>(dev_path, &env_vars_);
 
-  std::shared_ptr<Monitor> m = FindMonitor(dev_path + "/device/hwmon");
-  dev->set_monitor(m);
+  std::string monitor_path = dev_path + "/device/hwmon";
+  dev->set_monitor_finder([this, monitor_path]() {
+    return FindMonitor(monitor_path);
+  });
 
   const std::string& d_name = dev_name;
   uint32_t card_indx = GetDeviceIndex(d_name);
   dev->set_drm_render_minor(GetDrmRenderMinor(dev_path));
   dev->set_card_index(card_indx);
-  GetSupportedEventGroups(card_indx, dev->supported_event_groups());
+  // With lazy init, the hwmon scan and the perf event group probes are left
+  // to the first query of this device. With the discovery cache, they are
+  // left to ApplyDiscoveryCache().
+  if (!lazy_init_ && !discovery_cache_) {
+    (void)dev->monitor();
+    (void)dev->supported_event_groups();
+  }
   if (bdfid != 0) {
     dev->set_bdfid(bdfid);
   }
@@ -722,10 +853,10 @@ uint32_t RocmSMI::DiscoverAmdgpuDevices(void) {
   devices_.clear();
   monitors_.clear();
 
-  auto drm_dir = opendir(kPathDRMRoot);
+  auto drm_dir = opendir(FsPath(kPathDRMRoot).c_str());
   if (drm_dir == nullptr) {
     err_msg = "Failed to open drm root directory ";
-    err_msg += kPathDRMRoot;
+    err_msg += FsPath(kPathDRMRoot);
     err_msg += ".";
     perror(err_msg.c_str());
     return 1;
@@ -825,7 +956,7 @@ uint32_t RocmSMI::DiscoverAmdgpuDevices(void) {
   uint32_t cardAdded = 0;
   // Discover all root cards & gpu partitions associated with each
   for (uint32_t cardId = 0; cardId <= max_cardId; cardId++) {
-    std::string path = kPathDRMRoot;
+    std::string path = FsPath(kPathDRMRoot);
     path += "/card";
     path += std::to_string(cardId);
     uint64_t primary_unique_id = 0;
@@ -1069,7 +1200,7 @@ uint32_t RocmSMI::DiscoverAmdgpuDevices(void) {
 
   if (closedir(drm_dir)) {
     err_msg = "Failed to close drm root directory ";
-    err_msg += kPathDRMRoot;
+    err_msg += FsPath(kPathDRMRoot);
     err_msg += ".";
     perror(err_msg.c_str());
     return 1;
@@ -1093,7 +1224,7 @@ int RocmSMI::DiscoverAMDPowerMonitors(bool force_update) {
   }
 
   errno = 0;
-  auto dri_dir = opendir(kPathPowerRoot);
+  auto dri_dir = opendir(FsPath(kPathPowerRoot).c_str());
 
   if (dri_dir == nullptr) {
     return errno;
@@ -1109,7 +1240,7 @@ int RocmSMI::DiscoverAMDPowerMonitors(bool force_update) {
       continue;
     }
 
-    mon_name = kPathPowerRoot;
+    mon_name = FsPath(kPathPowerRoot);
     mon_name += "/";
     mon_name += dentry->d_name;
     tmp = mon_name + "/amdgpu_pm_info";
@@ -1168,12 +1299,114 @@ int RocmSMI::get_node_index(uint32_t dv_ind, uint32_t *node_ind) {
   return 0;
 }
 
+// Seeds every device from the discovery cache if it matches this boot and
+// device list. On a miss, probes the devices (even with lazy init) and
+// writes a new cache for the next process; failing to write it, e.g. as a
+// non-root user, is not an error.
+void RocmSMI::ApplyDiscoveryCache(void) {
+  std::ostringstream ss;
+  std::vector<std::pair<uint64_t, std::string>> dev_ids;
+  dev_ids.reserve(devices_.size());
+  for (auto &dev : devices_) {
+    dev_ids.emplace_back(dev->bdfid(), dev->path());
+  }
+  std::string key = DiscoveryCache::MakeKey(dev_ids);
+  if (key.empty()) {
+    ss << __PRETTY_FUNCTION__ << " | no boot id, discovery cache disabled";
+    LOG_INFO(ss);
+    return;
+  }
+
+  std::string path = (env_vars_.discovery_cache_path != nullptr)
+                         ? env_vars_.discovery_cache_path
+                         : FsPath(kDefaultDiscoveryCachePath);
+  DiscoveryCache cache(path);
+  std::vector<DiscoveryRecord> records;
+
+  if (cache.Load(key, &records) && records.size() == devices_.size()) {
+    for (uint32_t i = 0; i < devices_.size(); ++i) {
+      devices_[i]->restoreDiscovery(records[i]);
+    }
+  } else {
+    // Probing is mostly sysfs/debugfs reads, so devices are probed in
+    // parallel; each thread only touches its own Device and record.
+    records.assign(devices_.size(), DiscoveryRecord());
+    std::vector<std::thread> probes;
+    std::vector<char> ok(devices_.size(), 0);
+    probes.reserve(devices_.size());
+    for (uint32_t i = 0; i < devices_.size(); ++i) {
+      probes.emplace_back([this, i, &records, &ok]() {
+        try {
+          devices_[i]->exportDiscovery(&records[i]);
+          ok[i] = 1;
+        } catch (...) {
+          ok[i] = 0;
+        }
+      });
+    }
+    for (auto &t : probes) {
+      t.join();
+    }
+    if (std::find(ok.begin(), ok.end(), 0) != ok.end()) {
+      ss << __PRETTY_FUNCTION__
+         << " | probing failed on a device, discovery cache not stored";
+      LOG_INFO(ss);
+    } else {
+      (void)cache.Store(key, records);
+    }
+  }
+
+  if (!lazy_init_) {
+    for (auto &dev : devices_) {
+      (void)dev->monitor();
+    }
+  }
+}
+
+int RocmSMI::DiscoverIOLinksOnce(void) {
+  std::lock_guard<std::mutex> guard(io_link_map_mutex_);
+  if (io_links_discovered_) {
+    return 0;
+  }
+  std::map<std::pair<uint32_t, uint32_t>, std::shared_ptr<IOLink>>
+    io_link_map_tmp;
+  int ret = DiscoverIOLinks(&io_link_map_tmp);
+  if (ret != 0) {
+    return ret;
+  }
+  std::map<std::pair<uint32_t, uint32_t>, std::shared_ptr<IOLink>>::iterator it;
+  for (it = io_link_map_tmp.begin(); it != io_link_map_tmp.end(); it++)
+    io_link_map_[it->first] = it->second;
+  io_links_discovered_ = true;
+  return 0;
+}
+
+void RocmSMI::StoreBootPartitions(void) {
+  if (boot_partitions_stored_) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(boot_partitions_mutex_);
+  if (boot_partitions_stored_) {
+    return;
+  }
+  // store each device boot partition state, if file doesn't exist
+  for (uint32_t dv_ind = 0; dv_ind < devices_.size(); ++dv_ind) {
+    devices_[dv_ind]->storeDevicePartitions(dv_ind);
+  }
+  boot_partitions_stored_ = true;
+}
+
 int RocmSMI::get_io_link_weight(uint32_t node_from, uint32_t node_to,
                                 uint64_t *weight) {
   assert(weight != nullptr);
   if (weight == nullptr) {
     return EINVAL;
   }
+  int ret = DiscoverIOLinksOnce();
+  if (ret != 0) {
+    return ret;
+  }
+  std::lock_guard<std::mutex> guard(io_link_map_mutex_);
   if (io_link_map_.find(std::make_pair(node_from, node_to)) ==
       io_link_map_.end()) {
     return EINVAL;
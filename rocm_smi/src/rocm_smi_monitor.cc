@@ -407,6 +407,44 @@ Monitor::setVoltSensorLabelMap(void) {
   return 0;
 }
 
+void
+Monitor::getSensorLabelMaps(SensorLabelList *temp,
+                            SensorLabelList *volt) const {
+  assert(temp != nullptr && volt != nullptr);
+  temp->assign(index_temp_type_map_.begin(), index_temp_type_map_.end());
+  volt->assign(index_volt_type_map_.begin(), index_volt_type_map_.end());
+}
+
+// Rebuilds the same maps setTempSensorLabelMap()/setVoltSensorLabelMap()
+// would, without reading the label files
+void
+Monitor::restoreSensorLabelMaps(const SensorLabelList &temp,
+                                const SensorLabelList &volt) {
+  temp_type_index_map_.clear();
+  index_temp_type_map_.clear();
+  volt_type_index_map_.clear();
+  index_volt_type_map_.clear();
+
+  for (uint32_t t = RSMI_TEMP_TYPE_FIRST; t <= RSMI_TEMP_TYPE_LAST; ++t) {
+    temp_type_index_map_.insert(
+       {static_cast<rsmi_temperature_type_t>(t), RSMI_TEMP_TYPE_INVALID});
+  }
+  for (const auto &l : temp) {
+    auto t_type = static_cast<rsmi_temperature_type_t>(l.second);
+    if (t_type != RSMI_TEMP_TYPE_INVALID) {
+      temp_type_index_map_[t_type] = static_cast<uint32_t>(l.first);
+    }
+    index_temp_type_map_.insert({l.first, t_type});
+  }
+  for (const auto &l : volt) {
+    auto v_type = static_cast<rsmi_voltage_type_t>(l.second);
+    if (v_type != RSMI_VOLT_TYPE_INVALID) {
+      volt_type_index_map_[v_type] = static_cast<uint32_t>(l.first);
+    }
+    index_volt_type_map_.insert({l.first, v_type});
+  }
+}
+
 static int get_supported_sensors(std::string dir_path, std::string fn_reg_ex,
                                               std::vector<uint64_t> *sensors) {
   auto hwmon_dir = opendir(dir_path.c_str());
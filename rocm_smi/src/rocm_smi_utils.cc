@@ -109,6 +109,29 @@ bool FileExists(char const *filename) {
   return (stat(filename, &buf) == 0);
 }
 
+const std::string& FsRoot(void) {
+  static const std::string root = [] {
+    // Redirecting every path is only for synthetic test trees; release
+    // builds ignore it, and setuid callers never see it.
+#if defined(DEBUG) || defined(RSMI_ENABLE_TEST_OVERRIDES)
+    const char *env = secure_getenv("RSMI_FS_ROOT");
+#else
+    const char *env = nullptr;
+#endif
+    std::string r = (env == nullptr) ? "" : env;
+    while (!r.empty() && r.back() == '/') {
+      r.pop_back();
+    }
+    return r;
+  }();
+  return root;
+}
+
+std::string FsPath(const std::string& path) {
+  const std::string& root = FsRoot();
+  return root.empty() ? path : root + path;
+}
+
 static inline void debugFilesDiscovered(std::vector<std::string> files) {
   std::ostringstream ss;
   int numberOfFilesFound = static_cast<int>(files.size());
@@ -319,6 +342,96 @@ pthread_mutex_t *GetMutex(uint32_t dv_ind) {
   return dev->mutex();
 }
 
+shared_rwlock_t *GetRWLock(uint32_t dv_ind) {
+  amd::smi::RocmSMI& smi = amd::smi::RocmSMI::getInstance();
+
+  if (dv_ind >= smi.devices().size()) {
+    return nullptr;
+  }
+  std::shared_ptr<amd::smi::Device> dev = smi.devices()[dv_ind];
+  assert(dev != nullptr);
+
+  return dev->rwlock();
+}
+
+namespace {
+
+// Device locks held by the calling thread. Only a few are ever held at
+// once (nested rsmi calls), so a linear search is fine.
+struct HeldDeviceLock {
+  shared_rwlock_t *rwlock;
+  uint32_t depth;
+  bool exclusive;
+  int slot;  // Reader slot for shared_rwlock_rdunlock()
+};
+thread_local std::vector<HeldDeviceLock> t_held_device_locks;
+
+HeldDeviceLock *FindHeldDeviceLock(shared_rwlock_t *rwlock) {
+  for (auto &held : t_held_device_locks) {
+    if (held.rwlock == rwlock) {
+      return &held;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+ScopedDeviceLock::ScopedDeviceLock(shared_rwlock_t *rwlock,
+                                   DeviceLockMode mode, bool blocking) :
+                      rwlock_(rwlock), held_(false),
+                      status_(RSMI_STATUS_SUCCESS) {
+  if (mode == kDeviceLockNone || rwlock_ == nullptr || rwlock_->ptr == nullptr) {
+    return;
+  }
+  const bool exclusive = (mode == kDeviceLockExclusive);
+
+  HeldDeviceLock *held = FindHeldDeviceLock(rwlock_);
+  if (held != nullptr) {
+    if (exclusive && !held->exclusive) {
+      // Waiting for the readers to leave would wait for ourselves
+      std::ostringstream ss;
+      ss << __PRETTY_FUNCTION__
+         << " | exclusive device lock requested while holding it shared";
+      LOG_ERROR(ss);
+      status_ = RSMI_STATUS_INTERNAL_EXCEPTION;
+      return;
+    }
+    held->depth++;
+    held_ = true;
+    return;
+  }
+
+  int slot = -1;
+  int ret = exclusive ? shared_rwlock_wrlock(rwlock_, blocking) :
+                        shared_rwlock_rdlock(rwlock_, blocking, &slot);
+  if (ret != 0) {
+    status_ = (ret == EBUSY || ret == ETIMEDOUT) ? RSMI_STATUS_BUSY :
+                                                   ErrnoToRsmiStatus(ret);
+    return;
+  }
+  t_held_device_locks.push_back({rwlock_, 1, exclusive, slot});
+  held_ = true;
+}
+
+ScopedDeviceLock::~ScopedDeviceLock() {
+  if (!held_) {
+    return;
+  }
+  auto it = std::find_if(t_held_device_locks.begin(), t_held_device_locks.end(),
+                [this](const HeldDeviceLock &h) {return h.rwlock == rwlock_;});
+  assert(it != t_held_device_locks.end());
+  if (it == t_held_device_locks.end() || --it->depth > 0) {
+    return;
+  }
+  if (it->exclusive) {
+    shared_rwlock_wrunlock(rwlock_);
+  } else {
+    shared_rwlock_rdunlock(rwlock_, it->slot);
+  }
+  t_held_device_locks.erase(it);
+}
+
 rsmi_status_t GetDevValueVec(amd::smi::DevInfoTypes type,
                          uint32_t dv_ind, std::vector<std::string> *val_vec) {
   assert(val_vec != nullptr);
@@ -367,7 +480,7 @@ bool is_vm_guest() {
   std::string line;
 
   // default to false if cannot find the file
-  std::ifstream infile("/proc/cpuinfo");
+  std::ifstream infile(FsPath("/proc/cpuinfo"));
   if (infile.fail()) {
     return false;
   }
@@ -70,14 +70,12 @@
 #include "rocm_smi/rocm_smi_common.h"
 #include "amd_smi/impl/amdgpu_drm.h"
 #include "amd_smi/impl/amd_smi_utils.h"
+#include "amd_smi/impl/amd_smi_fields.h"
 #include "amd_smi/impl/amd_smi_processor.h"
 #include "rocm_smi/rocm_smi_logger.h"
 
 static bool initialized_lib = false;
 
-#define	SIZE	10
-char proc_id[SIZE] = "\0";
-
 #define AMDSMI_CHECK_INIT() do { \
 	if (!initialized_lib) { \
 		return AMDSMI_STATUS_NOT_INIT; \
@@ -120,11 +118,13 @@ amdsmi_status_t rsmi_wrapper(F && f,
     auto rstatus = std::forward<F>(f)(gpu_index,
                     std::forward<Args>(args)...);
     r = amd::smi::rsmi_to_amdsmi_status(rstatus);
-    std::ostringstream ss;
-    const char *status_string;
-    amdsmi_status_code_to_string(r, &status_string);
-    ss << __PRETTY_FUNCTION__ << " | returning status = " << status_string;
-    LOG_INFO(ss);
+    if (LOG_INFO_ON()) {
+        std::ostringstream ss;
+        const char *status_string;
+        amdsmi_status_code_to_string(r, &status_string);
+        ss << __PRETTY_FUNCTION__ << " | returning status = " << status_string;
+        LOG_INFO(ss);
+    }
     return r;
 }
 
@@ -418,14 +418,13 @@ amdsmi_status_t amdsmi_get_gpu_board_info(amdsmi_processor_handle processor_hand
     }
 
     std::ostringstream ss;
-    ss << __PRETTY_FUNCTION__ << "[Before rocm smi correction] "
+    LOG_INFO_S(ss << __PRETTY_FUNCTION__ << "[Before rocm smi correction] "
        << "Returning status = AMDSMI_STATUS_SUCCESS"
        << "\n; info->model_number: |" << board_info->model_number << "|"
        << "\n; info->product_serial: |" << board_info->product_serial << "|"
        << "\n; info->fru_id: |" << board_info->fru_id << "|"
        << "\n; info->manufacturer_name: |" << board_info->manufacturer_name << "|"
-       << "\n; info->product_name: |" << board_info->product_name << "|";
-    LOG_INFO(ss);
+       << "\n; info->product_name: |" << board_info->product_name << "|");
 
     if (board_info->product_serial[0] == '\0') {
         status = rsmi_wrapper(rsmi_dev_serial_number_get, processor_handle,
@@ -434,9 +433,8 @@ amdsmi_status_t amdsmi_get_gpu_board_info(amdsmi_processor_handle processor_hand
             memset(board_info->product_serial, 0,
                    AMDSMI_NORMAL_STRING_LENGTH * sizeof(board_info->product_serial[0]));
         }
-        ss << __PRETTY_FUNCTION__ << " | [rsmi_correction] board_info->product_serial= |"
-        << board_info->product_serial << "|";
-        LOG_INFO(ss);
+        LOG_INFO_S(ss << __PRETTY_FUNCTION__ << " | [rsmi_correction] board_info->product_serial= |"
+        << board_info->product_serial << "|");
     }
 
     if (board_info->product_name[0] == '\0') {
@@ -454,9 +452,8 @@ amdsmi_status_t amdsmi_get_gpu_board_info(amdsmi_processor_handle processor_hand
             memset(board_info->product_name, 0,
                     AMDSMI_256_LENGTH * sizeof(board_info->product_name[0]));
         }
-        ss << __PRETTY_FUNCTION__ << " | [rsmi_correction] board_info->product_name= |"
-        << board_info->product_name << "|";
-        LOG_INFO(ss);
+        LOG_INFO_S(ss << __PRETTY_FUNCTION__ << " | [rsmi_correction] board_info->product_name= |"
+        << board_info->product_name << "|");
     }
 
     if (board_info->manufacturer_name[0] == '\0') {
@@ -467,19 +464,17 @@ amdsmi_status_t amdsmi_get_gpu_board_info(amdsmi_processor_handle processor_hand
             memset(board_info->manufacturer_name, 0,
                    AMDSMI_MAX_STRING_LENGTH * sizeof(board_info->manufacturer_name[0]));
         }
-        ss << __PRETTY_FUNCTION__ << " | [rsmi_correction] board_info->manufacturer_name= |"
-        << board_info->manufacturer_name << "|";
-        LOG_INFO(ss);
+        LOG_INFO_S(ss << __PRETTY_FUNCTION__ << " | [rsmi_correction] board_info->manufacturer_name= |"
+        << board_info->manufacturer_name << "|");
     }
 
-    ss << __PRETTY_FUNCTION__ << " | [After rocm smi correction] "
+    LOG_INFO_S(ss << __PRETTY_FUNCTION__ << " | [After rocm smi correction] "
        << "Returning status = AMDSMI_STATUS_SUCCESS"
        << "\n; info->model_number: |" << board_info->model_number << "|"
        << "\n; info->product_serial: |" << board_info->product_serial << "|"
        << "\n; info->fru_id: |" << board_info->fru_id << "|"
        << "\n; info->manufacturer_name: |" << board_info->manufacturer_name << "|"
-       << "\n; info->product_name: |" << board_info->product_name << "|";
-    LOG_INFO(ss);
+       << "\n; info->product_name: |" << board_info->product_name << "|");
 
     return AMDSMI_STATUS_SUCCESS;
 }
@@ -557,15 +552,9 @@ amdsmi_status_t  amdsmi_get_temp_metric(amdsmi_processor_handle processor_handle
     return amdsmi_status;
 }
 
-amdsmi_status_t amdsmi_get_gpu_vram_usage(amdsmi_processor_handle processor_handle,
-            amdsmi_vram_usage_t *vram_info) {
-
-    AMDSMI_CHECK_INIT();
-
-    if (vram_info == nullptr) {
-        return AMDSMI_STATUS_INVAL;
-    }
-
+// VRAM, visible VRAM and GTT usage all come from one AMDGPU_INFO_MEMORY query
+static amdsmi_status_t get_gpu_memory_info(amdsmi_processor_handle processor_handle,
+            struct drm_amdgpu_memory_info *mem) {
     amd::smi::AMDSmiProcessor* device = nullptr;
     amdsmi_status_t ret = amd::smi::AMDSmiSystem::getInstance()
                     .handle_to_processor(processor_handle, &device);
@@ -583,45 +572,95 @@ amdsmi_status_t amdsmi_get_gpu_vram_usage(amdsmi_processor_handle processor_hand
         return r;
     }
 
-    struct drm_amdgpu_info_vram_gtt gtt;
-    uint64_t vram_used = 0;
+    memset(mem, 0, sizeof(*mem));
+    return gpu_device->amdgpu_query_info(AMDGPU_INFO_MEMORY,
+                sizeof(struct drm_amdgpu_memory_info), mem);
+}
+
+amdsmi_status_t amdsmi_get_gpu_vram_usage(amdsmi_processor_handle processor_handle,
+            amdsmi_vram_usage_t *vram_info) {
+
+    AMDSMI_CHECK_INIT();
 
-    r = gpu_device->amdgpu_query_info(AMDGPU_INFO_VRAM_GTT,
-                sizeof(struct drm_amdgpu_memory_info), &gtt);
-    if (r != AMDSMI_STATUS_SUCCESS)  return r;
+    if (vram_info == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
 
+    struct drm_amdgpu_memory_info mem;
+    amdsmi_status_t r = get_gpu_memory_info(processor_handle, &mem);
+    if (r != AMDSMI_STATUS_SUCCESS) {
+        return r;
+    }
+
+    // usable_heap_size is the vram_size AMDGPU_INFO_VRAM_GTT reports, and
+    // heap_usage the value of AMDGPU_INFO_VRAM_USAGE
     vram_info->vram_total = static_cast<uint32_t>(
-        gtt.vram_size / (1024 * 1024));
+        mem.vram.usable_heap_size / (1024 * 1024));
+    vram_info->vram_used = static_cast<uint32_t>(
+        mem.vram.heap_usage / (1024 * 1024));
+
+    return AMDSMI_STATUS_SUCCESS;
+}
+
+amdsmi_status_t amdsmi_get_gpu_memory_usage_info(amdsmi_processor_handle processor_handle,
+            amdsmi_gpu_memory_usage_t *info) {
+
+    AMDSMI_CHECK_INIT();
 
-    r = gpu_device->amdgpu_query_info(AMDGPU_INFO_VRAM_USAGE,
-                sizeof(vram_used), &vram_used);
+    if (info == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+
+    struct drm_amdgpu_memory_info mem;
+    amdsmi_status_t r = get_gpu_memory_info(processor_handle, &mem);
     if (r != AMDSMI_STATUS_SUCCESS) {
         return r;
     }
 
-    vram_info->vram_used = static_cast<uint32_t>(vram_used / (1024 * 1024));
+    memset(info, 0, sizeof(*info));
+    info->vram_total = mem.vram.usable_heap_size;
+    info->vram_used = mem.vram.heap_usage;
+    info->vis_vram_total = mem.cpu_accessible_vram.usable_heap_size;
+    info->vis_vram_used = mem.cpu_accessible_vram.heap_usage;
+    info->gtt_total = mem.gtt.usable_heap_size;
+    info->gtt_used = mem.gtt.heap_usage;
 
     return AMDSMI_STATUS_SUCCESS;
 }
 
-static void system_wait(int milli_seconds) {
-  std::ostringstream ss;
-  auto start = std::chrono::high_resolution_clock::now();
-  // 1 ms = 1000 us
-  int waitTime = milli_seconds * 1000;
+// Reads the throttle residency accumulators of a GPU
+static amdsmi_status_t read_violation_sample(amdsmi_processor_handle processor_handle,
+                                             amd::smi::AMDSmiViolationSample* sample,
+                                             amdsmi_gpu_metrics_t* metric_info) {
+    amdsmi_status_t status = amdsmi_get_gpu_metrics_info(processor_handle, metric_info);
+    if (status != AMDSMI_STATUS_SUCCESS) {
+        return status;
+    }
 
-  ss << __PRETTY_FUNCTION__ << " | "
-     << "** Waiting for " << std::dec << waitTime
-     << " us (" << waitTime/1000 << " seconds) **";
-  LOG_DEBUG(ss);
-  usleep(waitTime);
-  auto stop = std::chrono::high_resolution_clock::now();
-  auto duration =
-      std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
-  ss << __PRETTY_FUNCTION__ << " | "
-     << "** Waiting took " << duration.count() / 1000
-     << " milli-seconds **";
-  LOG_DEBUG(ss);
+    // if all of these values are "undefined" then the feature is not supported on the ASIC
+    if (metric_info->accumulation_counter == std::numeric_limits<uint64_t>::max()
+        && metric_info->prochot_residency_acc == std::numeric_limits<uint64_t>::max()
+        && metric_info->ppt_residency_acc == std::numeric_limits<uint64_t>::max()
+        && metric_info->socket_thm_residency_acc == std::numeric_limits<uint64_t>::max()
+        && metric_info->vr_thm_residency_acc == std::numeric_limits<uint64_t>::max()
+        && metric_info->hbm_thm_residency_acc == std::numeric_limits<uint64_t>::max()) {
+        std::ostringstream ss;
+        LOG_INFO_S(ss << __PRETTY_FUNCTION__
+           << " | ASIC does not support throttle violations!, "
+           << "returning AMDSMI_STATUS_NOT_SUPPORTED");
+        return AMDSMI_STATUS_NOT_SUPPORTED;
+    }
+
+    sample->time_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    sample->acc_counter = metric_info->accumulation_counter;
+    sample->residency_acc[amd::smi::kViolationProchotThrm] = metric_info->prochot_residency_acc;
+    sample->residency_acc[amd::smi::kViolationPptPwr] = metric_info->ppt_residency_acc;
+    sample->residency_acc[amd::smi::kViolationSocketThrm] = metric_info->socket_thm_residency_acc;
+    sample->residency_acc[amd::smi::kViolationVrThrm] = metric_info->vr_thm_residency_acc;
+    sample->residency_acc[amd::smi::kViolationHbmThrm] = metric_info->hbm_thm_residency_acc;
+    return AMDSMI_STATUS_SUCCESS;
 }
 
 amdsmi_status_t amdsmi_get_violation_status(amdsmi_processor_handle processor_handle,
@@ -633,12 +672,9 @@ amdsmi_status_t amdsmi_get_violation_status(amdsmi_processor_handle processor_ha
         return AMDSMI_STATUS_INVAL;
     }
 
-    // 1 sec = 1000 ms = 1000000 us
-    // 0.1 sec = 100 ms = 100000 us
-    constexpr uint64_t kFASTEST_POLL_TIME_MS = 100;  // fastest SMU FW sample time is 100 ms
-
     violation_status->reference_timestamp = std::numeric_limits<uint64_t>::max();
     violation_status->violation_timestamp = std::numeric_limits<uint64_t>::max();
+    violation_status->window_us = std::numeric_limits<uint64_t>::max();
 
     violation_status->acc_counter = std::numeric_limits<uint64_t>::max();
     violation_status->acc_prochot_thrm = std::numeric_limits<uint64_t>::max();
@@ -664,200 +700,77 @@ amdsmi_status_t amdsmi_get_violation_status(amdsmi_processor_handle processor_ha
                                                 p1.time_since_epoch()).count();
     violation_status->reference_timestamp = current_time;
 
-    amd::smi::AMDSmiProcessor* device = nullptr;
-    amdsmi_status_t ret = amd::smi::AMDSmiSystem::getInstance()
-                    .handle_to_processor(processor_handle, &device);
-    if (ret != AMDSMI_STATUS_SUCCESS) {
-        return ret;
-    }
-
-    if (device->get_processor_type() != AMDSMI_PROCESSOR_TYPE_AMD_GPU) {
-        return AMDSMI_STATUS_NOT_SUPPORTED;
-    }
-
     amd::smi::AMDSmiGPUDevice* gpu_device = nullptr;
     amdsmi_status_t r = get_gpu_device_from_handle(processor_handle, &gpu_device);
     if (r != AMDSMI_STATUS_SUCCESS) {
         return r;
     }
 
-    amdsmi_gpu_metrics_t metric_info_a = {};
-    amdsmi_status_t status =  amdsmi_get_gpu_metrics_info(
-            processor_handle, &metric_info_a);
-    if (status != AMDSMI_STATUS_SUCCESS) {
-        return status;
-    }
-
-    // if all of these values are "undefined" then the feature is not supported on the ASIC
-    if (metric_info_a.accumulation_counter == std::numeric_limits<uint64_t>::max()
-        && metric_info_a.prochot_residency_acc == std::numeric_limits<uint64_t>::max()
-        && metric_info_a.ppt_residency_acc == std::numeric_limits<uint64_t>::max()
-        && metric_info_a.socket_thm_residency_acc == std::numeric_limits<uint64_t>::max()
-        && metric_info_a.vr_thm_residency_acc == std::numeric_limits<uint64_t>::max()
-        && metric_info_a.hbm_thm_residency_acc == std::numeric_limits<uint64_t>::max()) {
-        ss << __PRETTY_FUNCTION__
-           << " | ASIC does not support throttle violations!, "
-           << "returning AMDSMI_STATUS_NOT_SUPPORTED";
-        LOG_INFO(ss);
-        return AMDSMI_STATUS_NOT_SUPPORTED;
-    }
-
-    // wait 100ms before reading again
-    system_wait(static_cast<int>(kFASTEST_POLL_TIME_MS));
-
-    amdsmi_gpu_metrics_t metric_info_b = {};
-    status =  amdsmi_get_gpu_metrics_info(
-            processor_handle, &metric_info_b);
+    // Residency since the previous sample of this GPU. A first call (or the
+    // first one after a counter reset) only seeds the baseline; window_us and
+    // the percentages are then left at max to mark them unavailable.
+    auto& tracker = gpu_device->get_violation_tracker();
+    amd::smi::AMDSmiViolationSample sample{};
+    amd::smi::AMDSmiViolationResidency residency{};
+    amdsmi_gpu_metrics_t metric_info = {};
+    amdsmi_status_t status = read_violation_sample(processor_handle, &sample, &metric_info);
     if (status != AMDSMI_STATUS_SUCCESS) {
         return status;
     }
+    const bool has_residency = tracker.update(sample, &residency);
 
     // Insert current accumulator counters into struct
-    violation_status->acc_counter = metric_info_b.accumulation_counter;
-    violation_status->acc_prochot_thrm = metric_info_b.prochot_residency_acc;
-    violation_status->acc_ppt_pwr = metric_info_b.ppt_residency_acc;
-    violation_status->acc_socket_thrm = metric_info_b.socket_thm_residency_acc;
-    violation_status->acc_vr_thrm = metric_info_b.vr_thm_residency_acc;
-    violation_status->acc_hbm_thrm = metric_info_b.hbm_thm_residency_acc;
-
-    ss << __PRETTY_FUNCTION__ << " | "
-       << "[gpu_metrics A] metric_info_a.accumulation_counter: " << std::dec
-       << metric_info_a.accumulation_counter
-       << "; metric_info_a.prochot_residency_acc: " << std::dec
-       << metric_info_a.prochot_residency_acc
-       << "; metric_info_a.ppt_residency_acc (pviol): " << std::dec
-       << metric_info_a.ppt_residency_acc
-       << "; metric_info_a.socket_thm_residency_acc (tviol): " << std::dec
-       << metric_info_a.socket_thm_residency_acc
-       << "; metric_info_a.vr_thm_residency_acc: " << std::dec
-       << metric_info_a.vr_thm_residency_acc
-       << "; metric_info_a.hbm_thm_residency_acc: " << std::dec
-       << metric_info_a.hbm_thm_residency_acc << "\n"
-       << " [gpu_metrics B] metric_info_b.accumulation_counter: " << std::dec
-       << metric_info_b.accumulation_counter
-       << "; metric_info_b.prochot_residency_acc: " << std::dec
-       << metric_info_b.prochot_residency_acc
-       << "; metric_info_b.ppt_residency_acc (pviol): " << std::dec
-       << metric_info_b.ppt_residency_acc
-       << "; metric_info_b.socket_thm_residency_acc (tviol): " << std::dec
-       << metric_info_b.socket_thm_residency_acc
-       << "; metric_info_b.vr_thm_residency_acc: " << std::dec
-       << metric_info_b.vr_thm_residency_acc
-       << "; metric_info_b.hbm_thm_residency_acc: " << std::dec
-       << metric_info_b.hbm_thm_residency_acc
-       << "\n";
-    LOG_DEBUG(ss);
-
-    if ( (metric_info_b.prochot_residency_acc != std::numeric_limits<uint64_t>::max()
-        || metric_info_a.prochot_residency_acc != std::numeric_limits<uint64_t>::max())
-        && (metric_info_b.prochot_residency_acc >= metric_info_a.prochot_residency_acc)
-        && ((metric_info_b.accumulation_counter - metric_info_a.accumulation_counter) > 0)) {
-        violation_status->per_prochot_thrm =
-            (((metric_info_b.prochot_residency_acc - metric_info_a.prochot_residency_acc) * 100) /
-            (metric_info_b.accumulation_counter - metric_info_a.accumulation_counter));
-
-        if (violation_status->per_prochot_thrm > 0) {
-            violation_status->active_prochot_thrm = 1;
-            violation_status->violation_timestamp = kFASTEST_POLL_TIME_MS;
-        } else {
-            violation_status->active_prochot_thrm = 0;
-        }
-        ss << __PRETTY_FUNCTION__ << " | "
-           << "ENTERED prochot_residency_acc | per_prochot_thrm: " << std::dec
-           << violation_status->per_prochot_thrm
-           << "%; active_prochot_thrm = " << std::dec
-           << violation_status->active_prochot_thrm << "\n";
-        LOG_DEBUG(ss);
-    }
-    if ( (metric_info_b.ppt_residency_acc != std::numeric_limits<uint64_t>::max()
-        || metric_info_a.ppt_residency_acc != std::numeric_limits<uint64_t>::max())
-        && (metric_info_b.ppt_residency_acc >= metric_info_a.ppt_residency_acc)
-        && ((metric_info_b.accumulation_counter - metric_info_a.accumulation_counter) > 0)) {
-        violation_status->per_ppt_pwr =
-            (((metric_info_b.ppt_residency_acc - metric_info_a.ppt_residency_acc) * 100) /
-            (metric_info_b.accumulation_counter - metric_info_a.accumulation_counter));
-
-        if (violation_status->per_ppt_pwr > 0) {
-            violation_status->active_ppt_pwr = 1;
-            violation_status->violation_timestamp = kFASTEST_POLL_TIME_MS;
-        } else {
-            violation_status->active_ppt_pwr = 0;
-        }
-        ss << __PRETTY_FUNCTION__ << " | "
-           << "ENTERED ppt_residency_acc | per_ppt_pwr: " << std::dec
-           << violation_status->per_ppt_pwr
-           << "%; active_ppt_pwr = " << std::dec
-           << violation_status->active_ppt_pwr << "\n";
-        LOG_DEBUG(ss);
-    }
-    if ( (metric_info_b.socket_thm_residency_acc != std::numeric_limits<uint64_t>::max()
-        || metric_info_a.socket_thm_residency_acc != std::numeric_limits<uint64_t>::max())
-        && (metric_info_b.socket_thm_residency_acc >= metric_info_a.socket_thm_residency_acc)
-        && ((metric_info_b.accumulation_counter - metric_info_a.accumulation_counter) > 0)) {
-        violation_status->per_socket_thrm =
-            (((metric_info_b.socket_thm_residency_acc -
-                metric_info_a.socket_thm_residency_acc) * 100) /
-            (metric_info_b.accumulation_counter - metric_info_a.accumulation_counter));
-
-        if (violation_status->per_socket_thrm > 0) {
-            violation_status->active_socket_thrm = 1;
-            violation_status->violation_timestamp = kFASTEST_POLL_TIME_MS;
-        } else {
-            violation_status->active_socket_thrm = 0;
-        }
-        ss << __PRETTY_FUNCTION__ << " | "
-           << "ENTERED socket_thm_residency_acc | per_socket_thrm: " << std::dec
-           << violation_status->per_socket_thrm
-           << "%; active_ppt_pwr = " << std::dec
-           << violation_status->active_socket_thrm << "\n";
-        LOG_DEBUG(ss);
-    }
-    if ( (metric_info_b.vr_thm_residency_acc != std::numeric_limits<uint64_t>::max()
-        || metric_info_a.vr_thm_residency_acc != std::numeric_limits<uint64_t>::max())
-        && (metric_info_b.vr_thm_residency_acc >= metric_info_a.vr_thm_residency_acc)
-        && ((metric_info_b.accumulation_counter - metric_info_a.accumulation_counter) > 0)) {
-        violation_status->per_vr_thrm =
-            (((metric_info_b.vr_thm_residency_acc -
-                metric_info_a.vr_thm_residency_acc) * 100) /
-            (metric_info_b.accumulation_counter - metric_info_a.accumulation_counter));
-
-        if (violation_status->per_vr_thrm > 0) {
-            violation_status->active_vr_thrm = 1;
-            violation_status->violation_timestamp = kFASTEST_POLL_TIME_MS;
-        } else {
-            violation_status->active_vr_thrm = 0;
-        }
-        ss << __PRETTY_FUNCTION__ << " | "
-           << "ENTERED vr_thm_residency_acc | per_vr_thrm: " << std::dec
-           << violation_status->per_vr_thrm
-           << "%; active_ppt_pwr = " << std::dec
-           << violation_status->active_vr_thrm << "\n";
-        LOG_DEBUG(ss);
-    }
-    if ( (metric_info_b.hbm_thm_residency_acc != std::numeric_limits<uint64_t>::max()
-        || metric_info_a.hbm_thm_residency_acc != std::numeric_limits<uint64_t>::max())
-        && (metric_info_b.hbm_thm_residency_acc >= metric_info_a.hbm_thm_residency_acc)
-        && ((metric_info_b.accumulation_counter - metric_info_a.accumulation_counter) > 0) ) {
-        violation_status->per_hbm_thrm =
-            (((metric_info_b.hbm_thm_residency_acc -
-                metric_info_a.hbm_thm_residency_acc) * 100) /
-            (metric_info_b.accumulation_counter - metric_info_a.accumulation_counter));
-
-        if (violation_status->per_hbm_thrm > 0) {
-            violation_status->active_hbm_thrm = 1;
-            violation_status->violation_timestamp = kFASTEST_POLL_TIME_MS;
-        } else {
-            violation_status->active_hbm_thrm = 0;
-        }
-        ss << __PRETTY_FUNCTION__ << " | "
-           << "ENTERED hbm_thm_residency_acc | per_hbm_thrm: " << std::dec
-           << violation_status->per_hbm_thrm
-           << "%; active_ppt_pwr = " << std::dec
-           << violation_status->active_hbm_thrm << "\n";
-        LOG_DEBUG(ss);
+    violation_status->acc_counter = metric_info.accumulation_counter;
+    violation_status->acc_prochot_thrm = metric_info.prochot_residency_acc;
+    violation_status->acc_ppt_pwr = metric_info.ppt_residency_acc;
+    violation_status->acc_socket_thrm = metric_info.socket_thm_residency_acc;
+    violation_status->acc_vr_thrm = metric_info.vr_thm_residency_acc;
+    violation_status->acc_hbm_thrm = metric_info.hbm_thm_residency_acc;
+
+    LOG_DEBUG_S(ss << __PRETTY_FUNCTION__ << " | "
+       << "[gpu_metrics] accumulation_counter: " << std::dec
+       << metric_info.accumulation_counter
+       << "; prochot_residency_acc: " << std::dec
+       << metric_info.prochot_residency_acc
+       << "; ppt_residency_acc (pviol): " << std::dec
+       << metric_info.ppt_residency_acc
+       << "; socket_thm_residency_acc (tviol): " << std::dec
+       << metric_info.socket_thm_residency_acc
+       << "; vr_thm_residency_acc: " << std::dec
+       << metric_info.vr_thm_residency_acc
+       << "; hbm_thm_residency_acc: " << std::dec
+       << metric_info.hbm_thm_residency_acc
+       << "; has_residency: " << has_residency
+       << "; window_us: " << std::dec << residency.window_us
+       << "\n");
+
+    if (has_residency) {
+        violation_status->window_us = residency.window_us;
+        const auto window_ms = residency.window_us / 1000;
+        auto set_violation = [&](amd::smi::AMDSmiViolationType type,
+                                 uint64_t* percent, uint8_t* active) {
+            if (residency.percent[type] == std::numeric_limits<uint64_t>::max()) {
+                return;
+            }
+            *percent = residency.percent[type];
+            *active = (*percent > 0) ? 1 : 0;
+            if (*active) {
+                violation_status->violation_timestamp = window_ms;
+            }
+        };
+        set_violation(amd::smi::kViolationProchotThrm,
+                      &violation_status->per_prochot_thrm, &violation_status->active_prochot_thrm);
+        set_violation(amd::smi::kViolationPptPwr,
+                      &violation_status->per_ppt_pwr, &violation_status->active_ppt_pwr);
+        set_violation(amd::smi::kViolationSocketThrm,
+                      &violation_status->per_socket_thrm, &violation_status->active_socket_thrm);
+        set_violation(amd::smi::kViolationVrThrm,
+                      &violation_status->per_vr_thrm, &violation_status->active_vr_thrm);
+        set_violation(amd::smi::kViolationHbmThrm,
+                      &violation_status->per_hbm_thrm, &violation_status->active_hbm_thrm);
     }
 
-    ss << __PRETTY_FUNCTION__ << " | "
+    LOG_INFO_S(ss << __PRETTY_FUNCTION__ << " | "
        << "RETURNING AMDSMI_STATUS_SUCCESS | "
        << "violation_status->reference_timestamp (time since epoch): " << std::dec
        << violation_status->reference_timestamp
@@ -883,12 +796,44 @@ amdsmi_status_t amdsmi_get_violation_status(amdsmi_processor_handle processor_ha
        << static_cast<int>(violation_status->active_vr_thrm)
        << "; violation_status->active_hbm_thrm (bool): " << std::dec
        << static_cast<int>(violation_status->active_hbm_thrm)
-       << "\n";
-    LOG_INFO(ss);
+       << "\n");
 
     return AMDSMI_STATUS_SUCCESS;
 }
 
+amdsmi_status_t amdsmi_get_violation_window_stats(amdsmi_processor_handle processor_handle,
+            amdsmi_violation_window_stats_t *stats) {
+    AMDSMI_CHECK_INIT();
+
+    if (stats == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+
+    amd::smi::AMDSmiGPUDevice* gpu_device = nullptr;
+    amdsmi_status_t r = get_gpu_device_from_handle(processor_handle, &gpu_device);
+    if (r != AMDSMI_STATUS_SUCCESS) {
+        return r;
+    }
+
+    auto& tracker = gpu_device->get_violation_tracker();
+    amd::smi::AMDSmiViolationSample sample{};
+    amdsmi_gpu_metrics_t metric_info = {};
+    amdsmi_status_t status = read_violation_sample(processor_handle, &sample, &metric_info);
+    if (status != AMDSMI_STATUS_SUCCESS) {
+        return status;
+    }
+    // The windows end at this call's own sample; the baseline used by
+    // amdsmi_get_violation_status() is left alone
+    tracker.record(sample);
+
+    constexpr uint64_t kWindowsUs[AMDSMI_NUM_VIOLATION_WINDOWS] = {
+        1000000, 10000000, 60000000 };
+    for (uint32_t i = 0; i < AMDSMI_NUM_VIOLATION_WINDOWS; ++i) {
+        tracker.window_stats(sample, kWindowsUs[i], &stats[i]);
+    }
+    return AMDSMI_STATUS_SUCCESS;
+}
+
 amdsmi_status_t amdsmi_get_gpu_fan_rpms(amdsmi_processor_handle processor_handle,
                             uint32_t sensor_ind, int64_t *speed) {
     return rsmi_wrapper(rsmi_dev_fan_rpms_get, processor_handle, sensor_ind,
@@ -997,9 +942,9 @@ amdsmi_get_gpu_asic_info(amdsmi_processor_handle processor_handle, amdsmi_asic_i
         status = gpu_device->amdgpu_query_info(AMDGPU_INFO_DEV_INFO, sizeof(struct drm_amdgpu_info_device), &dev_info);
         if (status != AMDSMI_STATUS_SUCCESS) return status;
 
-        SMIGPUDEVICE_MUTEX(gpu_device->get_mutex())
+        SMIGPUDEVICE_READ_MUTEX(gpu_device)
 
-        std::string path = "/sys/class/drm/" + gpu_device->get_gpu_path() + "/device/unique_id";
+        std::string path = amd::smi::FsPath("/sys/class/drm/") + gpu_device->get_gpu_path() + "/device/unique_id";
         FILE *fp = fopen(path.c_str(), "r");
         if (fp) {
             fscanf(fp, "%s", info->asic_serial);
@@ -1220,32 +1165,109 @@ amdsmi_get_gpu_event_notification(int timeout_ms,
                     uint32_t *num_elem, amdsmi_evt_notification_data_t *data) {
     AMDSMI_CHECK_INIT();
 
-    if (num_elem == nullptr || data == nullptr) {
+    if (num_elem == nullptr || data == nullptr || *num_elem == 0) {
         return AMDSMI_STATUS_INVAL;
     }
 
-    // Get the rsmi data
-    std::vector<rsmi_evt_notification_data_t> r_data(*num_elem);
-    rsmi_status_t r = rsmi_event_notification_get(
-                        timeout_ms, num_elem, &r_data[0]);
-    if (r != RSMI_STATUS_SUCCESS) {
-        return amd::smi::rsmi_to_amdsmi_status(r);
-    }
-    // convert output
-    for (uint32_t i=0; i < *num_elem; i++) {
-        rsmi_evt_notification_data_t rsmi_data = r_data[i];
-        data[i].event = static_cast<amdsmi_evt_notification_type_t>(
-                rsmi_data.event);
-        strncpy(data[i].message, rsmi_data.message,
-                MAX_EVENT_NOTIFICATION_MSG_SIZE);
-        amdsmi_status_t r = amd::smi::AMDSmiSystem::getInstance()
-            .gpu_index_to_handle(rsmi_data.dv_ind, &(data[i].processor_handle));
-        if (r != AMDSMI_STATUS_SUCCESS) return r;
+    // Collect the rsmi data a chunk at a time into a stack buffer, only
+    // waiting for the first one.
+    constexpr uint32_t kEvtChunk = 64;
+    rsmi_evt_notification_data_t r_data[kEvtChunk];
+    uint32_t total = 0;
+    int wait_ms = timeout_ms;
+    while (total < *num_elem) {
+        uint32_t want = std::min(*num_elem - total, kEvtChunk);
+        uint32_t got = want;
+        rsmi_status_t r = rsmi_event_notification_get(wait_ms, &got, r_data);
+        if (r == RSMI_STATUS_NO_DATA) {
+            break;
+        }
+        if (r != RSMI_STATUS_SUCCESS) {
+            if (total == 0) {
+                *num_elem = 0;
+                return amd::smi::rsmi_to_amdsmi_status(r);
+            }
+            break;
+        }
+        // convert output
+        for (uint32_t i = 0; i < got; i++) {
+            const rsmi_evt_notification_data_t &rsmi_data = r_data[i];
+            amdsmi_evt_notification_data_t &out = data[total + i];
+            out.event = static_cast<amdsmi_evt_notification_type_t>(
+                    rsmi_data.event);
+            strncpy(out.message, rsmi_data.message,
+                    MAX_EVENT_NOTIFICATION_MSG_SIZE);
+            amdsmi_status_t status = amd::smi::AMDSmiSystem::getInstance()
+                .gpu_index_to_handle(rsmi_data.dv_ind, &(out.processor_handle));
+            if (status != AMDSMI_STATUS_SUCCESS) {
+                *num_elem = total + i;
+                return status;
+            }
+        }
+        total += got;
+        wait_ms = 0;
+        if (got < want) {
+            break;
+        }
     }
 
+    *num_elem = total;
+    if (total == 0) {
+        return AMDSMI_STATUS_NO_DATA;
+    }
     return AMDSMI_STATUS_SUCCESS;
 }
 
+struct EvtCallback {
+    amdsmi_evt_notification_callback_t callback = nullptr;
+    void *user_data = nullptr;
+};
+
+static EvtCallback evt_callback;
+
+// Converts each rsmi event to the amdsmi one on the stack before handing it
+// to the application's callback.
+static void evt_callback_trampoline(
+        const rsmi_evt_notification_data_t *rsmi_data, void *user_data) {
+    const EvtCallback *cb = static_cast<const EvtCallback *>(user_data);
+    amdsmi_evt_notification_data_t data;
+    data.event = static_cast<amdsmi_evt_notification_type_t>(rsmi_data->event);
+    strncpy(data.message, rsmi_data->message, MAX_EVENT_NOTIFICATION_MSG_SIZE);
+    if (amd::smi::AMDSmiSystem::getInstance().gpu_index_to_handle(
+            rsmi_data->dv_ind, &data.processor_handle) != AMDSMI_STATUS_SUCCESS) {
+        return;
+    }
+    cb->callback(&data, cb->user_data);
+}
+
+amdsmi_status_t
+amdsmi_set_gpu_event_notification_callback(
+        amdsmi_evt_notification_callback_t callback, void *user_data) {
+    AMDSMI_CHECK_INIT();
+
+    // Stop the thread running the previous callback before replacing it.
+    rsmi_status_t r = rsmi_event_notification_callback_set(nullptr, nullptr);
+    if (r != RSMI_STATUS_SUCCESS || callback == nullptr) {
+        return amd::smi::rsmi_to_amdsmi_status(r);
+    }
+    evt_callback.callback = callback;
+    evt_callback.user_data = user_data;
+    r = rsmi_event_notification_callback_set(evt_callback_trampoline,
+                                             &evt_callback);
+    return amd::smi::rsmi_to_amdsmi_status(r);
+}
+
+amdsmi_status_t
+amdsmi_get_gpu_event_notification_fd(int *fd) {
+    AMDSMI_CHECK_INIT();
+
+    if (fd == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+    rsmi_status_t r = rsmi_event_notification_fd_get(fd);
+    return amd::smi::rsmi_to_amdsmi_status(r);
+}
+
 amdsmi_status_t amdsmi_stop_gpu_event_notification(
                 amdsmi_processor_handle processor_handle) {
     return rsmi_wrapper(rsmi_event_notification_stop, processor_handle);
@@ -1287,6 +1309,40 @@ amdsmi_gpu_read_counter(amdsmi_event_handle_t evt_handle,
     return amd::smi::rsmi_to_amdsmi_status(r);
 }
 
+amdsmi_status_t
+amdsmi_gpu_create_counter_group(amdsmi_processor_handle processor_handle,
+        const amdsmi_event_type_t *types, uint32_t num_events,
+        amdsmi_event_group_handle_t *grp_handle) {
+    return rsmi_wrapper(rsmi_dev_counter_group_create, processor_handle,
+                    reinterpret_cast<const rsmi_event_type_t*>(types), num_events,
+                    static_cast<rsmi_event_group_handle_t*>(grp_handle));
+}
+
+amdsmi_status_t
+amdsmi_gpu_destroy_counter_group(amdsmi_event_group_handle_t grp_handle) {
+    rsmi_status_t r = rsmi_dev_counter_group_destroy(
+        static_cast<rsmi_event_group_handle_t>(grp_handle));
+    return amd::smi::rsmi_to_amdsmi_status(r);
+}
+
+amdsmi_status_t
+amdsmi_gpu_control_counter_group(amdsmi_event_group_handle_t grp_handle,
+                                amdsmi_counter_command_t cmd) {
+    rsmi_status_t r = rsmi_counter_group_control(
+        static_cast<rsmi_event_group_handle_t>(grp_handle),
+        static_cast<rsmi_counter_command_t>(cmd));
+    return amd::smi::rsmi_to_amdsmi_status(r);
+}
+
+amdsmi_status_t
+amdsmi_gpu_read_counter_group(amdsmi_event_group_handle_t grp_handle,
+                            amdsmi_counter_value_t *values, uint32_t num_values) {
+    rsmi_status_t r = rsmi_counter_group_read(
+        static_cast<rsmi_event_group_handle_t>(grp_handle),
+        reinterpret_cast<rsmi_counter_value_t*>(values), num_values);
+    return amd::smi::rsmi_to_amdsmi_status(r);
+}
+
 amdsmi_status_t
  amdsmi_get_gpu_available_counters(amdsmi_processor_handle processor_handle,
                             amdsmi_event_group_t grp, uint32_t *available) {
@@ -1359,6 +1415,111 @@ amdsmi_status_t amdsmi_get_link_metrics(amdsmi_processor_handle processor_handle
     return AMDSMI_STATUS_SUCCESS;
 }
 
+// Max KFD io_link bandwidth from this GPU to any XGMI peer, in GB/s
+static float xgmi_kfd_max_gbps(uint32_t gpu_id) {
+    uint32_t num_devices = 0;
+    if (rsmi_num_monitor_devices(&num_devices) != RSMI_STATUS_SUCCESS) {
+        return 0;
+    }
+    uint64_t max_mbps = 0;
+    for (uint32_t peer = 0; peer < num_devices; ++peer) {
+        uint64_t min_bw = 0;
+        uint64_t max_bw = 0;
+        if (peer != gpu_id &&
+            rsmi_minmax_bandwidth_get(gpu_id, peer, &min_bw, &max_bw) == RSMI_STATUS_SUCCESS) {
+            max_mbps = std::max(max_mbps, max_bw);
+        }
+    }
+    return static_cast<float>(max_mbps) / 1000;
+}
+
+// Caller holds tracker.mutex()
+static amdsmi_status_t read_link_sample(amdsmi_processor_handle processor_handle,
+                                        uint32_t gpu_id,
+                                        amd::smi::AMDSmiLinkRateTracker& tracker,
+                                        amd::smi::AMDSmiLinkSample* sample) {
+    amdsmi_gpu_metrics_t metric_info = {};
+    amdsmi_status_t status = amdsmi_get_gpu_metrics_info(processor_handle, &metric_info);
+    if (status != AMDSMI_STATUS_SUCCESS) {
+        return status;
+    }
+
+    *sample = {};
+    bool has_xgmi_acc = false;
+    for (uint32_t i = 0; i < AMDSMI_MAX_NUM_XGMI_LINKS; ++i) {
+        sample->xgmi_read_kb[i] = metric_info.xgmi_read_data_acc[i];
+        sample->xgmi_write_kb[i] = metric_info.xgmi_write_data_acc[i];
+        has_xgmi_acc |= (sample->xgmi_read_kb[i] != std::numeric_limits<uint64_t>::max() ||
+                         sample->xgmi_write_kb[i] != std::numeric_limits<uint64_t>::max());
+    }
+    sample->pcie_bandwidth_inst = metric_info.pcie_bandwidth_inst;
+
+    if (sample->pcie_bandwidth_inst == std::numeric_limits<uint64_t>::max() &&
+        !has_xgmi_acc) {
+        return AMDSMI_STATUS_NOT_SUPPORTED;
+    }
+
+    // The accumulators are stamped by firmware
+    if (has_xgmi_acc && metric_info.firmware_timestamp != 0 &&
+        metric_info.firmware_timestamp != std::numeric_limits<uint64_t>::max()) {
+        sample->time_ns = metric_info.firmware_timestamp;
+    } else {
+        sample->time_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    if (!tracker.xgmi_kfd_max_known()) {
+        tracker.set_xgmi_kfd_max_gbps(xgmi_kfd_max_gbps(gpu_id));
+    }
+    sample->xgmi_max_gbps = tracker.xgmi_kfd_max_gbps();
+    if (sample->xgmi_max_gbps <= 0 &&
+        metric_info.xgmi_link_speed != std::numeric_limits<uint16_t>::max() &&
+        metric_info.xgmi_link_width != std::numeric_limits<uint16_t>::max()) {
+        // Gb/s per lane times lanes
+        sample->xgmi_max_gbps = static_cast<float>(metric_info.xgmi_link_speed) *
+                                metric_info.xgmi_link_width / 8;
+    }
+    if (metric_info.pcie_link_speed != std::numeric_limits<uint16_t>::max() &&
+        metric_info.pcie_link_width != std::numeric_limits<uint16_t>::max()) {
+        // 0.1 GT/s per lane, 128b/130b encoding
+        sample->pcie_max_gbps = static_cast<float>(metric_info.pcie_link_speed) / 10 *
+                                metric_info.pcie_link_width * 128 / 130 / 8;
+    }
+    return AMDSMI_STATUS_SUCCESS;
+}
+
+amdsmi_status_t amdsmi_get_link_rates(amdsmi_processor_handle processor_handle,
+          amdsmi_link_rates_t *link_rates) {
+    AMDSMI_CHECK_INIT();
+    if (link_rates == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+
+    amd::smi::AMDSmiGPUDevice* gpu_device = nullptr;
+    amdsmi_status_t r = get_gpu_device_from_handle(processor_handle, &gpu_device);
+    if (r != AMDSMI_STATUS_SUCCESS) {
+        return r;
+    }
+
+    // Rates since the previous sample of this GPU. A first call, or one made
+    // before the firmware refreshed the metrics, only takes the baseline and
+    // returns an empty window.
+    auto& tracker = gpu_device->get_link_rate_tracker();
+    std::lock_guard<std::mutex> guard(tracker.mutex());
+
+    amd::smi::AMDSmiLinkSample sample;
+    amdsmi_status_t status = read_link_sample(processor_handle, gpu_device->get_gpu_id(),
+                                              tracker, &sample);
+    if (status != AMDSMI_STATUS_SUCCESS) {
+        return status;
+    }
+    if (!tracker.update(sample, link_rates)) {
+        *link_rates = {};
+    }
+    return AMDSMI_STATUS_SUCCESS;
+}
+
 amdsmi_status_t
 amdsmi_topo_get_link_type(amdsmi_processor_handle processor_handle_src, amdsmi_processor_handle processor_handle_dst,
                         uint64_t *hops, amdsmi_io_link_type_t *type) {
@@ -1541,6 +1702,17 @@ amdsmi_status_t  amdsmi_get_gpu_ecc_enabled(amdsmi_processor_handle processor_ha
     return rsmi_wrapper(rsmi_dev_ecc_enabled_get, processor_handle,
                     enabled_blocks);
 }
+amdsmi_status_t  amdsmi_get_gpu_ecc_count_all(amdsmi_processor_handle processor_handle,
+                        uint32_t *num_blocks, amdsmi_gpu_block_error_count_t *counts) {
+    AMDSMI_CHECK_INIT();
+
+    if (num_blocks == nullptr)
+        return AMDSMI_STATUS_INVAL;
+
+    return rsmi_wrapper(rsmi_dev_ecc_count_all_get, processor_handle,
+                    num_blocks,
+                    reinterpret_cast<rsmi_gpu_block_error_count_t*>(counts));
+}
 amdsmi_status_t  amdsmi_get_gpu_ecc_status(amdsmi_processor_handle processor_handle,
                                 amdsmi_gpu_block_t block,
                                 amdsmi_ras_err_state_t *state) {
@@ -1563,6 +1735,182 @@ amdsmi_get_gpu_metrics_header_info(amdsmi_processor_handle processor_handle,
                     reinterpret_cast<metrics_table_header_t*>(header_value));
 }
 
+amdsmi_status_t
+amdsmi_get_gpu_sysfs_fd_cache_stats(amdsmi_processor_handle processor_handle,
+                amdsmi_sysfs_fd_cache_stats_t *stats)
+{
+    AMDSMI_CHECK_INIT();
+    if (stats == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+
+    return rsmi_wrapper(rsmi_dev_sysfs_fd_cache_stats_get, processor_handle,
+                    reinterpret_cast<rsmi_sysfs_fd_cache_stats_t*>(stats));
+}
+
+amdsmi_status_t
+amdsmi_set_gpu_metrics_cache_ttl(amdsmi_processor_handle processor_handle,
+                uint64_t ttl_us)
+{
+    AMDSMI_CHECK_INIT();
+
+    return rsmi_wrapper(rsmi_dev_gpu_metrics_cache_ttl_set, processor_handle,
+                    ttl_us);
+}
+
+amdsmi_status_t
+amdsmi_get_gpu_metrics_cache_ttl(amdsmi_processor_handle processor_handle,
+                uint64_t *ttl_us)
+{
+    AMDSMI_CHECK_INIT();
+    if (ttl_us == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+
+    return rsmi_wrapper(rsmi_dev_gpu_metrics_cache_ttl_get, processor_handle,
+                    ttl_us);
+}
+
+amdsmi_status_t
+amdsmi_get_gpu_fields(amdsmi_processor_handle processor_handle,
+                amdsmi_field_value_t *fields, uint32_t num_fields)
+{
+    AMDSMI_CHECK_INIT();
+    if (fields == nullptr || num_fields == 0) {
+        return AMDSMI_STATUS_INVAL;
+    }
+
+    amd::smi::AMDSmiGPUDevice* gpu_device = nullptr;
+    amdsmi_status_t r = get_gpu_device_from_handle(processor_handle, &gpu_device);
+    if (r != AMDSMI_STATUS_SUCCESS) {
+        return r;
+    }
+
+    return smi_amdgpu_get_fields(gpu_device, fields, num_fields);
+}
+
+amdsmi_status_t
+amdsmi_get_supported_fields(amdsmi_processor_handle processor_handle,
+                uint64_t *bitmap)
+{
+    AMDSMI_CHECK_INIT();
+    if (bitmap == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+
+    amd::smi::AMDSmiGPUDevice* gpu_device = nullptr;
+    amdsmi_status_t r = get_gpu_device_from_handle(processor_handle, &gpu_device);
+    if (r != AMDSMI_STATUS_SUCCESS) {
+        return r;
+    }
+
+    return smi_amdgpu_get_supported_fields(gpu_device, bitmap);
+}
+
+amdsmi_status_t
+amdsmi_get_gpu_fields_multi(amdsmi_processor_handle *processor_handles,
+                uint32_t num_processors,
+                const amdsmi_field_id_t *field_ids, uint32_t num_fields,
+                amdsmi_field_value_t *values)
+{
+    AMDSMI_CHECK_INIT();
+    if (processor_handles == nullptr || num_processors == 0 ||
+        field_ids == nullptr || num_fields == 0 || values == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+
+    std::vector<amd::smi::AMDSmiGPUDevice*> gpu_devices(num_processors, nullptr);
+    for (uint32_t i = 0; i < num_processors; ++i) {
+        amdsmi_status_t r = get_gpu_device_from_handle(processor_handles[i], &gpu_devices[i]);
+        if (r != AMDSMI_STATUS_SUCCESS) {
+            return r;
+        }
+    }
+
+    return smi_amdgpu_get_fields_multi(gpu_devices, field_ids, num_fields, values);
+}
+
+amdsmi_status_t
+amdsmi_start_background_sampling(amdsmi_processor_handle processor_handle,
+                const amdsmi_field_id_t *field_ids, uint32_t num_fields,
+                uint64_t period_us, uint32_t depth)
+{
+    AMDSMI_CHECK_INIT();
+    if (field_ids == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+    // Below 1ms the sampler would mostly measure its own reads
+    static const uint64_t kMinSamplingPeriodUs = 1000;
+    static const uint32_t kMaxSamplingDepth = 65536;
+    if (num_fields == 0 || num_fields > AMDSMI_MAX_SAMPLED_FIELDS ||
+        period_us < kMinSamplingPeriodUs || depth == 0 || depth > kMaxSamplingDepth) {
+        return AMDSMI_STATUS_INPUT_OUT_OF_BOUNDS;
+    }
+    for (uint32_t i = 0; i < num_fields; ++i) {
+        if (field_ids[i] >= AMDSMI_FIELD__MAX) {
+            return AMDSMI_STATUS_INVAL;
+        }
+    }
+
+    amd::smi::AMDSmiGPUDevice* gpu_device = nullptr;
+    amdsmi_status_t r = get_gpu_device_from_handle(processor_handle, &gpu_device);
+    if (r != AMDSMI_STATUS_SUCCESS) {
+        return r;
+    }
+    if (gpu_device->get_background_sampler() != nullptr) {
+        return AMDSMI_STATUS_BUSY;
+    }
+
+    auto sampler = std::make_shared<amd::smi::AMDSmiBackgroundSampler>(
+                        gpu_device, field_ids, num_fields, period_us, depth);
+    if (!gpu_device->start_background_sampler(sampler)) {
+        return AMDSMI_STATUS_BUSY;
+    }
+    return AMDSMI_STATUS_SUCCESS;
+}
+
+amdsmi_status_t
+amdsmi_stop_background_sampling(amdsmi_processor_handle processor_handle)
+{
+    AMDSMI_CHECK_INIT();
+    amd::smi::AMDSmiGPUDevice* gpu_device = nullptr;
+    amdsmi_status_t r = get_gpu_device_from_handle(processor_handle, &gpu_device);
+    if (r != AMDSMI_STATUS_SUCCESS) {
+        return r;
+    }
+
+    auto sampler = gpu_device->stop_background_sampler();
+    if (sampler == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+    sampler->stop();
+    return AMDSMI_STATUS_SUCCESS;
+}
+
+amdsmi_status_t
+amdsmi_get_background_samples(amdsmi_processor_handle processor_handle,
+                uint64_t *cursor, amdsmi_field_sample_t *samples,
+                uint32_t *num_samples)
+{
+    AMDSMI_CHECK_INIT();
+    if (cursor == nullptr || samples == nullptr || num_samples == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+    amd::smi::AMDSmiGPUDevice* gpu_device = nullptr;
+    amdsmi_status_t r = get_gpu_device_from_handle(processor_handle, &gpu_device);
+    if (r != AMDSMI_STATUS_SUCCESS) {
+        return r;
+    }
+
+    auto sampler = gpu_device->get_background_sampler();
+    if (sampler == nullptr) {
+        *num_samples = 0;
+        return AMDSMI_STATUS_INVAL;
+    }
+    *num_samples = sampler->read(cursor, samples, *num_samples);
+    return AMDSMI_STATUS_SUCCESS;
+}
+
 amdsmi_status_t  amdsmi_get_gpu_metrics_info(
         amdsmi_processor_handle processor_handle,
         amdsmi_gpu_metrics_t *pgpu_metrics) {
@@ -1600,6 +1948,54 @@ amdsmi_status_t amdsmi_get_gpu_reg_table_info(
                     num_of_metrics);
 }
 
+amdsmi_status_t amdsmi_get_gpu_pm_metrics_values(
+                      amdsmi_processor_handle processor_handle,
+                      amdsmi_name_value_t *pm_metrics,
+                      uint32_t *num_of_metrics) {
+    AMDSMI_CHECK_INIT();
+
+    return rsmi_wrapper(rsmi_dev_pm_metrics_values_get, processor_handle,
+                    reinterpret_cast<rsmi_name_value_t*>(pm_metrics),
+                    num_of_metrics);
+}
+
+amdsmi_status_t amdsmi_get_gpu_pm_metrics_changes(
+                      amdsmi_processor_handle processor_handle,
+                      amdsmi_name_value_t *pm_metrics,
+                      uint32_t *num_of_metrics) {
+    AMDSMI_CHECK_INIT();
+
+    return rsmi_wrapper(rsmi_dev_pm_metrics_changes_get, processor_handle,
+                    reinterpret_cast<rsmi_name_value_t*>(pm_metrics),
+                    num_of_metrics);
+}
+
+amdsmi_status_t amdsmi_get_gpu_reg_table_values(
+                      amdsmi_processor_handle processor_handle,
+                      amdsmi_reg_type_t reg_type,
+                      amdsmi_name_value_t *reg_metrics,
+                      uint32_t *num_of_metrics) {
+    AMDSMI_CHECK_INIT();
+
+    return rsmi_wrapper(rsmi_dev_reg_table_values_get, processor_handle,
+                    static_cast<rsmi_reg_type_t>(reg_type),
+                    reinterpret_cast<rsmi_name_value_t*>(reg_metrics),
+                    num_of_metrics);
+}
+
+amdsmi_status_t amdsmi_get_gpu_reg_table_changes(
+                      amdsmi_processor_handle processor_handle,
+                      amdsmi_reg_type_t reg_type,
+                      amdsmi_name_value_t *reg_metrics,
+                      uint32_t *num_of_metrics) {
+    AMDSMI_CHECK_INIT();
+
+    return rsmi_wrapper(rsmi_dev_reg_table_changes_get, processor_handle,
+                    static_cast<rsmi_reg_type_t>(reg_type),
+                    reinterpret_cast<rsmi_name_value_t*>(reg_metrics),
+                    num_of_metrics);
+}
+
 void amdsmi_free_name_value_pairs(void *p) {
     free(p);
 }
@@ -2239,24 +2635,20 @@ amdsmi_get_gpu_total_ecc_count(amdsmi_processor_handle processor_handle, amdsmi_
         return status;
 
     if (gpu_device->check_if_drm_is_supported()){
-        amdsmi_ras_err_state_t state = {};
-        // Iterate through the ecc blocks
-        for (auto block = AMDSMI_GPU_BLOCK_FIRST; block <= AMDSMI_GPU_BLOCK_LAST;
-                block = (amdsmi_gpu_block_t)(block * 2)) {
-            // Clear the previous ecc block counts
-            amdsmi_error_count_t block_ec = {};
-            // Check if the current ecc block is enabled
-            status = amdsmi_get_gpu_ras_block_features_enabled(processor_handle, block, &state);
-            if (status == AMDSMI_STATUS_SUCCESS && state == AMDSMI_RAS_ERR_STATE_ENABLED) {
-                // Increment the total ecc counts by the ecc block counts
-                status = amdsmi_get_gpu_ecc_count(processor_handle, block, &block_ec);
-                if (status == AMDSMI_STATUS_SUCCESS) {
-                    // Increase the total ecc counts
-                    ec->correctable_count += block_ec.correctable_count;
-                    ec->uncorrectable_count += block_ec.uncorrectable_count;
-                    ec->deferred_count += block_ec.deferred_count;
-                }
-            }
+        // All the enabled blocks in one pass, rather than a feature mask read
+        // and a counter read for every amdsmi_gpu_block_t. One entry per bit
+        // of the block mask is always enough.
+        amdsmi_gpu_block_error_count_t counts[64];
+        uint32_t num_blocks = sizeof(counts) / sizeof(counts[0]);
+        *ec = {};
+        status = amdsmi_get_gpu_ecc_count_all(processor_handle, &num_blocks, counts);
+        if (status != AMDSMI_STATUS_SUCCESS) {
+            return status;
+        }
+        for (uint32_t i = 0; i < num_blocks; i++) {
+            ec->correctable_count += counts[i].ec.correctable_count;
+            ec->uncorrectable_count += counts[i].ec.uncorrectable_count;
+            ec->deferred_count += counts[i].ec.deferred_count;
         }
     }
     else {
@@ -2310,6 +2702,41 @@ amdsmi_get_gpu_process_list(amdsmi_processor_handle processor_handle, uint32_t *
             ? AMDSMI_STATUS_SUCCESS : amdsmi_status_t::AMDSMI_STATUS_OUT_OF_RESOURCES;
 }
 
+amdsmi_status_t
+amdsmi_get_gpu_process_drm_usage(amdsmi_processor_handle processor_handle, uint32_t *max_processes,
+                                 amdsmi_proc_drm_usage_t *list) {
+    AMDSMI_CHECK_INIT();
+    if (!max_processes) {
+        return AMDSMI_STATUS_INVAL;
+    }
+
+    amd::smi::AMDSmiGPUDevice* gpu_device = nullptr;
+    amdsmi_status_t status_code = get_gpu_device_from_handle(processor_handle, &gpu_device);
+    if (status_code != amdsmi_status_t::AMDSMI_STATUS_SUCCESS) {
+        return status_code;
+    }
+
+    std::vector<amdsmi_proc_drm_usage_t> drm_usage;
+    status_code = gpuvsmi_get_drm_usage(gpu_device->get_bdf(), drm_usage);
+    if (status_code != amdsmi_status_t::AMDSMI_STATUS_SUCCESS) {
+        return status_code;
+    }
+    if ((*max_processes == 0) || drm_usage.empty()) {
+        *max_processes = static_cast<uint32_t>(drm_usage.size());
+        return amdsmi_status_t::AMDSMI_STATUS_SUCCESS;
+    }
+    if (!list) {
+        return amdsmi_status_t::AMDSMI_STATUS_INVAL;
+    }
+
+    const auto max_processes_original_size(*max_processes);
+    std::copy_n(drm_usage.begin(), std::min(max_processes_original_size,
+                static_cast<uint32_t>(drm_usage.size())), list);
+    *max_processes = static_cast<uint32_t>(drm_usage.size());
+    return (max_processes_original_size >= static_cast<uint32_t>(drm_usage.size()))
+            ? AMDSMI_STATUS_SUCCESS : amdsmi_status_t::AMDSMI_STATUS_OUT_OF_RESOURCES;
+}
+
 amdsmi_status_t
 amdsmi_get_power_info(amdsmi_processor_handle processor_handle, amdsmi_power_info_t *info) {
     AMDSMI_CHECK_INIT();
@@ -2406,7 +2833,7 @@ amdsmi_get_gpu_device_uuid(amdsmi_processor_handle processor_handle, unsigned in
         return r;
 
     amdsmi_status_t status = AMDSMI_STATUS_SUCCESS;
-    SMIGPUDEVICE_MUTEX(gpu_device->get_mutex())
+    SMIGPUDEVICE_READ_MUTEX(gpu_device)
 
     size_t len = AMDSMI_GPU_UUID_SIZE;
     amdsmi_asic_info_t asic_info = {};
@@ -2438,7 +2865,7 @@ amdsmi_status_t amdsmi_get_pcie_info(amdsmi_processor_handle processor_handle, a
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    SMIGPUDEVICE_MUTEX(gpu_device->get_mutex())
+    SMIGPUDEVICE_READ_MUTEX(gpu_device)
 
     char buff[AMDSMI_NORMAL_STRING_LENGTH];
     FILE* fp;
@@ -2447,7 +2874,7 @@ amdsmi_status_t amdsmi_get_pcie_info(amdsmi_processor_handle processor_handle, a
 
     memset((void *)info, 0, sizeof(*info));
 
-    std::string path_max_link_width = "/sys/class/drm/" +
+    std::string path_max_link_width = amd::smi::FsPath("/sys/class/drm/") +
         gpu_device->get_gpu_path() + "/device/max_link_width";
     fp = fopen(path_max_link_width.c_str(), "r");
     if (fp) {
@@ -2459,7 +2886,7 @@ amdsmi_status_t amdsmi_get_pcie_info(amdsmi_processor_handle processor_handle, a
     }
     info->pcie_static.max_pcie_width = (uint16_t)pcie_width;
 
-    std::string path_max_link_speed = "/sys/class/drm/" +
+    std::string path_max_link_speed = amd::smi::FsPath("/sys/class/drm/") +
         gpu_device->get_gpu_path() + "/device/max_link_speed";
     fp = fopen(path_max_link_speed.c_str(), "r");
     if (fp) {
@@ -2792,6 +3219,23 @@ static amdsmi_status_t amdsmi_errno_to_esmi_status(amdsmi_status_t status)
     return AMDSMI_STATUS_SUCCESS;
 }
 
+// The socket or core index is recorded on the processor at init, so this is
+// a lookup rather than a round trip through amdsmi_get_processor_info().
+template <typename T>
+static amdsmi_status_t get_cpu_processor_index(amdsmi_processor_handle processor_handle,
+                                               T *index)
+{
+    amd::smi::AMDSmiProcessor* processor = nullptr;
+    amdsmi_status_t r = amd::smi::AMDSmiSystem::getInstance()
+                    .handle_to_processor(processor_handle, &processor);
+    if (r != AMDSMI_STATUS_SUCCESS)
+        return r;
+
+    *index = static_cast<T>(processor->get_processor_index());
+
+    return AMDSMI_STATUS_SUCCESS;
+}
+
 amdsmi_status_t amdsmi_get_threads_per_core(uint32_t *threads_per_core)
 {
     amdsmi_status_t status;
@@ -2862,12 +3306,10 @@ amdsmi_status_t amdsmi_get_cpu_core_energy(amdsmi_processor_handle processor_han
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &core_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    core_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_core_energy_get(core_ind, &core_input));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -2890,12 +3332,10 @@ amdsmi_status_t amdsmi_get_cpu_socket_energy(amdsmi_processor_handle processor_h
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_socket_energy_get(sock_ind, &pkg_input));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -2917,12 +3357,10 @@ amdsmi_status_t amdsmi_get_cpu_prochot_status(amdsmi_processor_handle processor_
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_prochot_status_get(sock_ind, &phot));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -2944,12 +3382,10 @@ amdsmi_status_t amdsmi_get_cpu_fclk_mclk(amdsmi_processor_handle processor_handl
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_fclk_mclk_get(sock_ind, &f_clk, &m_clk));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -2972,12 +3408,10 @@ amdsmi_status_t amdsmi_get_cpu_cclk_limit(amdsmi_processor_handle processor_hand
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_cclk_limit_get(sock_ind, &c_clk));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -2999,12 +3433,10 @@ amdsmi_status_t amdsmi_get_cpu_socket_current_active_freq_limit(amdsmi_processor
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_socket_current_active_freq_limit_get(sock_ind, &limit, src_type));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3027,12 +3459,10 @@ amdsmi_status_t amdsmi_get_cpu_socket_freq_range(amdsmi_processor_handle process
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_socket_freq_range_get(sock_ind, &f_max, &f_min));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3055,12 +3485,10 @@ amdsmi_status_t amdsmi_get_cpu_core_current_freq_limit(amdsmi_processor_handle p
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &core_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    core_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_current_freq_limit_core_get(core_ind, &c_clk));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3083,12 +3511,10 @@ amdsmi_status_t amdsmi_get_cpu_socket_power(amdsmi_processor_handle processor_ha
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_socket_power_get(sock_ind, &avg_power));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3110,12 +3536,10 @@ amdsmi_status_t amdsmi_get_cpu_socket_power_cap(amdsmi_processor_handle processo
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_socket_power_cap_get(sock_ind, &p_cap));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3137,12 +3561,10 @@ amdsmi_status_t amdsmi_get_cpu_socket_power_cap_max(amdsmi_processor_handle proc
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_socket_power_cap_max_get(sock_ind, &p_max));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3164,12 +3586,10 @@ amdsmi_status_t amdsmi_get_cpu_pwr_svi_telemetry_all_rails(amdsmi_processor_hand
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_pwr_svi_telemetry_all_rails_get(sock_ind, &pow));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3190,12 +3610,10 @@ amdsmi_status_t amdsmi_set_cpu_socket_power_cap(amdsmi_processor_handle processo
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_socket_power_cap_set(sock_ind, pcap));
 
     if (status != AMDSMI_STATUS_SUCCESS)
@@ -3215,12 +3633,10 @@ amdsmi_status_t amdsmi_set_cpu_pwr_efficiency_mode(amdsmi_processor_handle proce
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_pwr_efficiency_mode_set(sock_ind, mode));
 
     if (status != AMDSMI_STATUS_SUCCESS)
@@ -3241,12 +3657,10 @@ amdsmi_status_t amdsmi_get_cpu_core_boostlimit(amdsmi_processor_handle processor
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &core_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    core_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_core_boostlimit_get(core_ind, &boostlimit));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3268,12 +3682,10 @@ amdsmi_status_t amdsmi_get_cpu_socket_c0_residency(amdsmi_processor_handle proce
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_socket_c0_residency_get(sock_ind, &res));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3294,12 +3706,10 @@ amdsmi_status_t amdsmi_set_cpu_core_boostlimit(amdsmi_processor_handle processor
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &core_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    core_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_core_boostlimit_set(core_ind, boostlimit));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3318,12 +3728,10 @@ amdsmi_status_t amdsmi_set_cpu_socket_boostlimit(amdsmi_processor_handle process
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_socket_boostlimit_set(sock_ind, boostlimit));
 
     if (status != AMDSMI_STATUS_SUCCESS)
@@ -3366,12 +3774,10 @@ amdsmi_status_t amdsmi_get_cpu_socket_temperature(amdsmi_processor_handle proces
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_socket_temperature_get(sock_ind, &tmon));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3394,13 +3800,10 @@ amdsmi_status_t amdsmi_get_cpu_dimm_temp_range_and_refresh_rate(
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_dimm_temp_range_and_refresh_rate_get(
                                             sock_ind, dimm_addr, &dimm_rate));
     if (status != AMDSMI_STATUS_SUCCESS)
@@ -3424,12 +3827,10 @@ amdsmi_status_t amdsmi_get_cpu_dimm_power_consumption(amdsmi_processor_handle pr
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_dimm_power_consumption_get(sock_ind,
                                                               dimm_addr, &d_power));
     if (status != AMDSMI_STATUS_SUCCESS)
@@ -3454,12 +3855,10 @@ amdsmi_status_t amdsmi_get_cpu_dimm_thermal_sensor(amdsmi_processor_handle proce
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_dimm_thermal_sensor_get(sock_ind,
                                                               dimm_addr, &d_sensor));
     if (status != AMDSMI_STATUS_SUCCESS)
@@ -3500,12 +3899,10 @@ amdsmi_status_t amdsmi_set_cpu_gmi3_link_width_range(amdsmi_processor_handle pro
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_gmi3_link_width_range_set(sock_ind,
                                                         min_link_width, max_link_width));
     if (status != AMDSMI_STATUS_SUCCESS)
@@ -3524,12 +3921,10 @@ amdsmi_status_t amdsmi_cpu_apb_enable(amdsmi_processor_handle processor_handle)
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_apb_enable(sock_ind));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3548,12 +3943,10 @@ amdsmi_status_t amdsmi_cpu_apb_disable(amdsmi_processor_handle processor_handle,
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_apb_disable(sock_ind, pstate));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3572,12 +3965,10 @@ amdsmi_status_t amdsmi_set_cpu_socket_lclk_dpm_level(amdsmi_processor_handle pro
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_socket_lclk_dpm_level_set(sock_ind, nbio_id, min, max));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3597,12 +3988,10 @@ amdsmi_status_t amdsmi_get_cpu_socket_lclk_dpm_level(amdsmi_processor_handle pro
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_socket_lclk_dpm_level_get(sock_ind,
                                                                         nbio_id, &nb));
     if (status != AMDSMI_STATUS_SUCCESS)
@@ -3626,12 +4015,10 @@ amdsmi_status_t amdsmi_set_cpu_pcie_link_rate(amdsmi_processor_handle processor_
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_pcie_link_rate_set(sock_ind,
                                                                         rate_ctrl, &p_mode));
     if (status != AMDSMI_STATUS_SUCCESS)
@@ -3653,12 +4040,10 @@ amdsmi_status_t amdsmi_set_cpu_df_pstate_range(amdsmi_processor_handle processor
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_df_pstate_range_set(sock_ind,
                                                                         max_pstate, min_pstate));
     if (status != AMDSMI_STATUS_SUCCESS)
@@ -3680,12 +4065,10 @@ amdsmi_status_t amdsmi_get_cpu_current_io_bandwidth(amdsmi_processor_handle proc
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     io_link.link_name = link.link_name;
     io_link.bw_type = static_cast<io_bw_encoding>(link.bw_type);
 
@@ -3758,12 +4141,10 @@ amdsmi_status_t amdsmi_get_hsmp_metrics_table(amdsmi_processor_handle processor_
     if(sizeof(amdsmi_hsmp_metrics_table_t) != sizeof(struct hsmp_metric_table))
         return AMDSMI_STATUS_UNEXPECTED_SIZE;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_metrics_table_get(sock_ind, &metrics_tbl));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
@@ -3773,6 +4154,72 @@ amdsmi_status_t amdsmi_get_hsmp_metrics_table(amdsmi_processor_handle processor_
     return AMDSMI_STATUS_SUCCESS;
 }
 
+amdsmi_status_t amdsmi_get_cpu_telemetry(amdsmi_cpu_socket_telemetry_t *sockets,
+                                         uint32_t *num_sockets,
+                                         amdsmi_cpu_core_telemetry_t *cores,
+                                         uint32_t *num_cores)
+{
+    AMDSMI_CHECK_INIT();
+
+    if (num_sockets == nullptr || num_cores == nullptr)
+        return AMDSMI_STATUS_INVAL;
+
+    amd::smi::AMDSmiSystem& system = amd::smi::AMDSmiSystem::getInstance();
+    const uint32_t socket_count = system.get_cpu_socket_count();
+    const uint32_t cores_per_socket = system.get_cpu_cores_per_socket();
+    if (socket_count == 0)
+        return AMDSMI_STATUS_NOT_INIT;
+
+    if (sockets == nullptr) {
+        *num_sockets = socket_count;
+    } else {
+        *num_sockets = std::min(*num_sockets, socket_count);
+        for (uint32_t i = 0; i < *num_sockets; i++) {
+            amdsmi_cpu_socket_telemetry_t& t = sockets[i];
+            const uint8_t sock_ind = static_cast<uint8_t>(i);
+            char *src_type[sizeof(amdsmi_hsmp_freqlimit_src_names) /
+                           sizeof(amdsmi_hsmp_freqlimit_src_names[0])] = {};
+
+            t.socket_index = i;
+            t.reserved = 0;
+            if (esmi_socket_power_get(sock_ind, &t.power) != ESMI_SUCCESS)
+                t.power = std::numeric_limits<uint32_t>::max();
+            if (esmi_socket_power_cap_get(sock_ind, &t.power_cap) != ESMI_SUCCESS)
+                t.power_cap = std::numeric_limits<uint32_t>::max();
+            if (esmi_socket_energy_get(sock_ind, &t.energy) != ESMI_SUCCESS)
+                t.energy = std::numeric_limits<uint64_t>::max();
+            if (esmi_socket_current_active_freq_limit_get(sock_ind, &t.freq_limit,
+                                                          src_type) != ESMI_SUCCESS)
+                t.freq_limit = std::numeric_limits<uint16_t>::max();
+            if (esmi_socket_freq_range_get(sock_ind, &t.fmax, &t.fmin) != ESMI_SUCCESS) {
+                t.fmax = std::numeric_limits<uint16_t>::max();
+                t.fmin = std::numeric_limits<uint16_t>::max();
+            }
+        }
+    }
+
+    const uint32_t core_count = socket_count * cores_per_socket;
+    if (cores == nullptr) {
+        *num_cores = core_count;
+    } else {
+        *num_cores = std::min(*num_cores, core_count);
+        for (uint32_t c = 0; c < *num_cores; c++) {
+            amdsmi_cpu_core_telemetry_t& t = cores[c];
+
+            t.core_index = c;
+            t.socket_index = c / cores_per_socket;
+            if (esmi_core_energy_get(c, &t.energy) != ESMI_SUCCESS)
+                t.energy = std::numeric_limits<uint64_t>::max();
+            if (esmi_core_boostlimit_get(c, &t.boostlimit) != ESMI_SUCCESS)
+                t.boostlimit = std::numeric_limits<uint32_t>::max();
+            if (esmi_current_freq_limit_core_get(c, &t.freq_limit) != ESMI_SUCCESS)
+                t.freq_limit = std::numeric_limits<uint32_t>::max();
+        }
+    }
+
+    return AMDSMI_STATUS_SUCCESS;
+}
+
 amdsmi_status_t amdsmi_first_online_core_on_cpu_socket(amdsmi_processor_handle processor_handle,
         uint32_t *pcore_ind)
 {
@@ -3785,12 +4232,10 @@ amdsmi_status_t amdsmi_first_online_core_on_cpu_socket(amdsmi_processor_handle p
     if (processor_handle == nullptr)
         return AMDSMI_STATUS_INVAL;
 
-    amdsmi_status_t r = amdsmi_get_processor_info(processor_handle, SIZE, proc_id);
+    amdsmi_status_t r = get_cpu_processor_index(processor_handle, &sock_ind);
     if (r != AMDSMI_STATUS_SUCCESS)
         return r;
 
-    sock_ind = (uint8_t)std::stoi(proc_id, NULL, 0);
-
     status = static_cast<amdsmi_status_t>(esmi_first_online_core_on_socket(sock_ind, &online_core));
     if (status != AMDSMI_STATUS_SUCCESS)
         return amdsmi_errno_to_esmi_status(status);
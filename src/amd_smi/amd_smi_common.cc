@@ -74,6 +74,15 @@ amdsmi_vram_type_t vram_type_value(unsigned type) {
     return value;
 }
 
+amdsmi_bdf_t rsmi_bdf_to_amdsmi_bdf(uint64_t bdf_rocm) {
+    amdsmi_bdf_t bdf = {};
+    bdf.function_number = bdf_rocm & 0x7;
+    bdf.device_number = (bdf_rocm >> 3) & 0x1F;
+    bdf.bus_number = (bdf_rocm >> 8) & 0xFF;
+    bdf.domain_number = static_cast<uint32_t>(bdf_rocm >> 32);
+    return bdf;
+}
+
 
 #ifdef ENABLE_ESMI_LIB
 amdsmi_status_t esmi_to_amdsmi_status(esmi_status_t status) {
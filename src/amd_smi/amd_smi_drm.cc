@@ -44,9 +44,10 @@
 #include <dirent.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <stdlib.h>
 #include <string.h>
+#include <cctype>
 #include <memory>
-#include <regex>
 #include "amd_smi/impl/amd_smi_drm.h"
 #include "amd_smi/impl/amdgpu_drm.h"
 #include "amd_smi/impl/amd_smi_common.h"
@@ -58,18 +59,18 @@
 namespace amd {
 namespace smi {
 
-std::string AMDSmiDrm::find_file_in_folder(const std::string& folder,
-               const std::string& regex) {
+std::string AMDSmiDrm::find_render_node(const std::string& folder) {
+    static const char kRenderPrefix[] = "renderD";
+    static const size_t kRenderPrefixLen = sizeof(kRenderPrefix) - 1;
     std::string file_name;
     using dir_ptr = std::unique_ptr<DIR, decltype(&closedir)>;
 
     struct dirent *dir = nullptr;
-    std::regex file_regex(regex);
     auto drm_dir = dir_ptr(opendir(folder.c_str()), &closedir);
     if (drm_dir == nullptr) return file_name;
-    std::cmatch m;
     while ((dir = readdir(drm_dir.get())) != NULL) {
-        if (std::regex_search(dir->d_name, m, file_regex)) {
+        if (strncmp(dir->d_name, kRenderPrefix, kRenderPrefixLen) == 0 &&
+            isdigit(static_cast<unsigned char>(dir->d_name[kRenderPrefixLen]))) {
             file_name = dir->d_name;
             break;
         }
@@ -77,18 +78,19 @@ std::string AMDSmiDrm::find_file_in_folder(const std::string& folder,
     return file_name;
 }
 
-amdsmi_status_t AMDSmiDrm::init() {
-    // A few RAII handler
-    using drm_version_ptr = std::unique_ptr<drmVersion,
-            decltype(&drmFreeVersion)>;
-    // using drm_device_ptr = std::unique_ptr(drmDevicePtr,
-    //         decltype(&drmFreeDevice));
-
-    struct dirent *dir = nullptr;
-    int fd = -1;
-
-
-    amdsmi_status_t status = lib_loader_.load("libdrm.so.2");
+amdsmi_status_t AMDSmiDrm::init(bool lazy) {
+    // AMDSMI_LIBDRM_PATH loads another libdrm, such as tests/fake_libdrm,
+    // in place of the system one. It dlopen()s any library, so only test
+    // builds honor it, and never for setuid callers.
+#if defined(DEBUG) || defined(RSMI_ENABLE_TEST_OVERRIDES)
+    const char* libdrm_path = secure_getenv("AMDSMI_LIBDRM_PATH");
+#else
+    const char* libdrm_path = nullptr;
+#endif
+    if (libdrm_path == nullptr || *libdrm_path == '\0') {
+        libdrm_path = "libdrm.so.2";
+    }
+    amdsmi_status_t status = lib_loader_.load(libdrm_path);
     if (status != AMDSMI_STATUS_SUCCESS) {
         return status;
     }
@@ -100,11 +102,8 @@ amdsmi_status_t AMDSmiDrm::init() {
         return status;
     }
 
-    using drmGetDeviceType = int(*)(int, drmDevicePtr*);   // drmGetDevice
-    using drmFreeDeviceType = void(*)(drmDevicePtr*);     // drmFreeDevice
-
-    drmGetDeviceType drm_get_device = nullptr;
-    drmFreeDeviceType drm_free_device = nullptr;
+    drm_get_device_ = nullptr;
+    drm_free_device_ = nullptr;
     drm_get_version_ = nullptr;
     drm_free_version_ = nullptr;
 
@@ -117,89 +116,32 @@ amdsmi_status_t AMDSmiDrm::init() {
         return status;
     }
 
-    status = lib_loader_.load_symbol(&drm_get_device, "drmGetDevice");
+    status = lib_loader_.load_symbol(&drm_get_device_, "drmGetDevice");
     if (status != AMDSMI_STATUS_SUCCESS) {
         return status;
     }
-    status = lib_loader_.load_symbol(&drm_free_device, "drmFreeDevice");
+    status = lib_loader_.load_symbol(&drm_free_device_, "drmFreeDevice");
     if (status != AMDSMI_STATUS_SUCCESS) {
         return status;
     }
 
-    /* Need to map the /dev/dri/render* file to /sys/class/drm/card*
-       The former is for drm fd and the latter is used for rocm-smi gpu index.
-       Here it will search the /sys/class/drm/card0/../renderD128
-    */
-    amd::smi::RocmSMI& smi = amd::smi::RocmSMI::getInstance();
-    auto devices = smi.devices();
+    // even if a node fails to open, its entry is kept to prevent mismatch the index
+    const size_t num_devices = amd::smi::RocmSMI::getInstance().devices().size();
+    drm_fds_.assign(num_devices, -1);
+    drm_paths_.assign(num_devices, "");
+    drm_bdfs_.assign(num_devices, amdsmi_bdf_t{});
+    drm_open_once_.reset(new std::once_flag[num_devices]);
+    lazy_ = lazy;
+    if (lazy_) {
+        return AMDSMI_STATUS_SUCCESS;
+    }
 
     bool has_valid_fds = false;
-    for (uint32_t i=0; i < devices.size(); i++) {
-        auto rocm_smi_device = devices[i];
-        std::string render_file_name;
-        drmDevicePtr device;
-
-        const std::string regex("renderD([0-9]+)");
-        const std::string renderD_folder = "/sys/class/drm/card"
-                    + std::to_string(rocm_smi_device->index()) + "/../";
-
-        // looking for /sys/class/drm/card0/../renderD*
-        std::string render_name = find_file_in_folder(renderD_folder, regex);
-        fd = -1;
-        std::string name = "/dev/dri/" + render_name;
-        if (render_name != "") {
-            fd = open(name.c_str(), O_RDWR | O_CLOEXEC);
+    for (uint32_t i = 0; i < num_devices; i++) {
+        open_render_node(i);
+        if (drm_fds_[i] >= 0) {
+            has_valid_fds = true;
         }
-
-        amdsmi_bdf_t bdf;
-        if (fd >= 0) {
-            auto version = drm_version_ptr(
-                drm_get_version_(fd), drm_free_version_);
-            if (strcmp("amdgpu", version->name)) {  // only amdgpu
-                close(fd);
-                fd = -1;
-            }
-            if (fd  >= 0 && drm_get_device(fd, &device) != 0) {
-                drm_free_device(&device);
-                close(fd);
-                fd = -1;
-            }
-        }
-
-        drm_fds_.push_back(fd);
-        drm_paths_.push_back(render_name);
-        // even if fail, still add to prevent mismatch the index
-        if (fd < 0) {
-            drm_bdfs_.push_back(bdf);
-            continue;
-        }
-
-        has_valid_fds = true;
-        std::ostringstream ss;
-        uint64_t bdf_rocm = 0;
-        rsmi_dev_pci_id_get(i, &bdf_rocm);
-        ss << __PRETTY_FUNCTION__ << " | "
-           << "bdf_rocm | Received bdf: "
-           << "\nWhole BDF: " << amd::smi::print_unsigned_hex_and_int(bdf_rocm)
-           << "\nDomain = "
-           << amd::smi::print_unsigned_hex_and_int((bdf_rocm & 0xFFFFFFFF00000000) >> 32)
-           << "; \nBus# = " << amd::smi::print_unsigned_hex_and_int((bdf_rocm & 0xFF00) >> 8)
-           << "; \nDevice# = "<< amd::smi::print_unsigned_hex_and_int((bdf_rocm & 0xF8) >> 3)
-           << "; \nFunction# = " << amd::smi::print_unsigned_hex_and_int((bdf_rocm & 0x7));
-        LOG_INFO(ss);
-        bdf.function_number = ((bdf_rocm & 0x7));
-        bdf.device_number = ((bdf_rocm & 0xF8) >> 3);
-        bdf.bus_number = ((bdf_rocm & 0xFF00) >> 8);
-        bdf.domain_number = ((bdf_rocm & 0xFFFFFFFF00000000) >> 32);
-        ss << __PRETTY_FUNCTION__ << " | " << "Received bdf: Domain = " << bdf.domain_number
-           << "; Bus# = " << bdf.bus_number << "; Device# = "<< bdf.device_number
-           << "; Function# = " << bdf.function_number;
-        LOG_INFO(ss);
-
-        vendor_id = device->deviceinfo.pci->vendor_id;
-
-        drm_bdfs_.push_back(bdf);
-        drm_free_device(&device);
     }
 
     // cannot find any valid fds.
@@ -211,6 +153,80 @@ amdsmi_status_t AMDSmiDrm::init() {
     return AMDSMI_STATUS_SUCCESS;
 }
 
+void AMDSmiDrm::open_render_node(uint32_t gpu_index) {
+    // A few RAII handler
+    using drm_version_ptr = std::unique_ptr<drmVersion,
+            decltype(&drmFreeVersion)>;
+
+    /* Need to map the /dev/dri/render* file to /sys/class/drm/card*
+       The former is for drm fd and the latter is used for rocm-smi gpu index.
+       The render minor was found by rocm-smi in /sys/class/drm/card0/device/drm,
+       otherwise it will search the /sys/class/drm/card0/../renderD128
+    */
+    amd::smi::RocmSMI& smi = amd::smi::RocmSMI::getInstance();
+    auto rocm_smi_device = smi.devices()[gpu_index];
+    drmDevicePtr device;
+
+    std::string render_name;
+    if (rocm_smi_device->drm_render_minor() != 0) {
+        render_name = "renderD" + std::to_string(rocm_smi_device->drm_render_minor());
+    } else {
+        const std::string renderD_folder = amd::smi::FsPath("/sys/class/drm/card")
+                    + std::to_string(rocm_smi_device->index()) + "/../";
+        render_name = find_render_node(renderD_folder);
+    }
+    int fd = -1;
+    std::string name = amd::smi::FsPath("/dev/dri/") + render_name;
+    if (render_name != "") {
+        fd = open(name.c_str(), O_RDWR | O_CLOEXEC);
+    }
+
+    if (fd >= 0) {
+        auto version = drm_version_ptr(
+            drm_get_version_(fd), drm_free_version_);
+        // Not a DRM node at all, e.g. a file of a synthetic RSMI_FS_ROOT tree
+        if (version == nullptr || strcmp("amdgpu", version->name)) {  // only amdgpu
+            close(fd);
+            fd = -1;
+        }
+        if (fd  >= 0 && drm_get_device_(fd, &device) != 0) {
+            drm_free_device_(&device);
+            close(fd);
+            fd = -1;
+        }
+    }
+
+    drm_fds_[gpu_index] = fd;
+    drm_paths_[gpu_index] = render_name;
+    if (fd < 0) {
+        return;
+    }
+
+    std::ostringstream ss;
+    uint64_t bdf_rocm = 0;
+    rsmi_dev_pci_id_get(gpu_index, &bdf_rocm);
+    ss << __PRETTY_FUNCTION__ << " | "
+       << "bdf_rocm | Received bdf: "
+       << "\nWhole BDF: " << amd::smi::print_unsigned_hex_and_int(bdf_rocm);
+    LOG_INFO(ss);
+    amdsmi_bdf_t bdf = amd::smi::rsmi_bdf_to_amdsmi_bdf(bdf_rocm);
+    ss << __PRETTY_FUNCTION__ << " | " << "Received bdf: Domain = " << bdf.domain_number
+       << "; Bus# = " << bdf.bus_number << "; Device# = "<< bdf.device_number
+       << "; Function# = " << bdf.function_number;
+    LOG_INFO(ss);
+
+    vendor_id = device->deviceinfo.pci->vendor_id;
+
+    drm_bdfs_[gpu_index] = bdf;
+    drm_free_device_(&device);
+}
+
+void AMDSmiDrm::open_render_node_once(uint32_t gpu_index) {
+    if (!lazy_ || gpu_index >= drm_fds_.size()) return;
+    std::call_once(drm_open_once_[gpu_index],
+                   [this, gpu_index]() { open_render_node(gpu_index); });
+}
+
 amdsmi_status_t AMDSmiDrm::cleanup() {
     for (unsigned int i=0; i < drm_fds_.size(); i++) {
         close(drm_fds_[i]);
@@ -219,6 +235,8 @@ amdsmi_status_t AMDSmiDrm::cleanup() {
     drm_fds_.clear();
     drm_paths_.clear();
     drm_bdfs_.clear();
+    drm_open_once_.reset();
+    lazy_ = false;
     lib_loader_.unload();
     return AMDSMI_STATUS_SUCCESS;
 }
@@ -227,7 +245,6 @@ amdsmi_status_t AMDSmiDrm::amdgpu_query_driver_name(int fd, std::string& driver_
     // RAII handler
     using drm_version_ptr = std::unique_ptr<drmVersion,
             decltype(&drmFreeVersion)>;
-    std::lock_guard<std::mutex> guard(drm_mutex_);
     auto version = drm_version_ptr(
                 drm_get_version_(fd), drm_free_version_);
     if (version == nullptr) return AMDSMI_STATUS_DRM_ERROR;
@@ -239,7 +256,6 @@ amdsmi_status_t AMDSmiDrm::amdgpu_query_driver_date(int fd, std::string& driver_
     // RAII handler
     using drm_version_ptr = std::unique_ptr<drmVersion,
             decltype(&drmFreeVersion)>;
-    std::lock_guard<std::mutex> guard(drm_mutex_);
     auto version = drm_version_ptr(
                 drm_get_version_(fd), drm_free_version_);
     if (version == nullptr) return AMDSMI_STATUS_DRM_ERROR;
@@ -250,7 +266,6 @@ amdsmi_status_t AMDSmiDrm::amdgpu_query_driver_date(int fd, std::string& driver_
 amdsmi_status_t AMDSmiDrm::amdgpu_query_info(int fd, unsigned info_id,
             unsigned size, void *value) {
     if (drm_cmd_write_ == nullptr) return AMDSMI_STATUS_NOT_SUPPORTED;
-    std::lock_guard<std::mutex> guard(drm_mutex_);
 
     struct drm_amdgpu_info request;
     memset(&request, 0, sizeof(request));
@@ -267,7 +282,6 @@ amdsmi_status_t AMDSmiDrm::amdgpu_query_fw(int fd, unsigned info_id,
         unsigned fw_type, unsigned size, void *value) {
     if (drm_cmd_write_ == nullptr) return AMDSMI_STATUS_NOT_SUPPORTED;
 
-    std::lock_guard<std::mutex> guard(drm_mutex_);
 
     struct drm_amdgpu_info request;
     memset(&request, 0, sizeof(request));
@@ -285,7 +299,6 @@ amdsmi_status_t AMDSmiDrm::amdgpu_query_hw_ip(int fd, unsigned info_id,
         unsigned hw_ip_type, unsigned size, void *value) {
     if (drm_cmd_write_ == nullptr) return AMDSMI_STATUS_NOT_SUPPORTED;
 
-    std::lock_guard<std::mutex> guard(drm_mutex_);
 
     struct drm_amdgpu_info request;
     memset(&request, 0, sizeof(request));
@@ -302,7 +315,6 @@ amdsmi_status_t AMDSmiDrm::amdgpu_query_hw_ip(int fd, unsigned info_id,
 amdsmi_status_t AMDSmiDrm::amdgpu_query_vbios(int fd, void *info) {
     if (drm_cmd_write_ == nullptr) return AMDSMI_STATUS_NOT_SUPPORTED;
 
-    std::lock_guard<std::mutex> guard(drm_mutex_);
 
     struct drm_amdgpu_info request;
     memset(&request, 0, sizeof request);
@@ -317,14 +329,16 @@ amdsmi_status_t AMDSmiDrm::amdgpu_query_vbios(int fd, void *info) {
 }
 
 
-amdsmi_status_t AMDSmiDrm::get_drm_fd_by_index(uint32_t gpu_index, uint32_t *fd_info) const {
+amdsmi_status_t AMDSmiDrm::get_drm_fd_by_index(uint32_t gpu_index, uint32_t *fd_info) {
+    open_render_node_once(gpu_index);
     if (gpu_index + 1 > drm_fds_.size()) return AMDSMI_STATUS_NOT_SUPPORTED;
     if (drm_fds_[gpu_index] < 0 ) return AMDSMI_STATUS_NOT_SUPPORTED;
     *fd_info = drm_fds_[gpu_index];
     return AMDSMI_STATUS_SUCCESS;
 }
 
-amdsmi_status_t AMDSmiDrm::get_bdf_by_index(uint32_t gpu_index, amdsmi_bdf_t *bdf_info) const {
+amdsmi_status_t AMDSmiDrm::get_bdf_by_index(uint32_t gpu_index, amdsmi_bdf_t *bdf_info) {
+    open_render_node_once(gpu_index);
     if (gpu_index + 1 > drm_bdfs_.size()) return AMDSMI_STATUS_NOT_SUPPORTED;
     *bdf_info = drm_bdfs_[gpu_index];
     std::ostringstream ss;
@@ -338,7 +352,8 @@ amdsmi_status_t AMDSmiDrm::get_bdf_by_index(uint32_t gpu_index, amdsmi_bdf_t *bd
     return AMDSMI_STATUS_SUCCESS;
 }
 
-amdsmi_status_t AMDSmiDrm::get_drm_path_by_index(uint32_t gpu_index, std::string *drm_path) const {
+amdsmi_status_t AMDSmiDrm::get_drm_path_by_index(uint32_t gpu_index, std::string *drm_path) {
+    open_render_node_once(gpu_index);
     if (gpu_index + 1 > drm_paths_.size()) return AMDSMI_STATUS_NOT_SUPPORTED;
     *drm_path = drm_paths_[gpu_index];
     return AMDSMI_STATUS_SUCCESS;
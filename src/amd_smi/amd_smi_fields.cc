@@ -0,0 +1,576 @@
+/*
+ * Copyright (C) 2024 Advanced Micro Devices. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "amd_smi/impl/amd_smi_fields.h"
+#include "amd_smi/impl/amd_smi_common.h"
+#include "amd_smi/impl/amd_smi_system.h"
+#include "amd_smi/impl/amd_smi_utils.h"
+#include "rocm_smi/rocm_smi.h"
+#include "rocm_smi/rocm_smi_device.h"
+#include "rocm_smi/rocm_smi_gpu_metrics.h"
+#include "rocm_smi/rocm_smi_kfd.h"
+#include "rocm_smi/rocm_smi_main.h"
+#include "rocm_smi/rocm_smi_monitor.h"
+#include "rocm_smi/rocm_smi_utils.h"
+#include "rocm_smi/rocm_smi_logger.h"
+
+namespace {
+
+// Everything a batch reads from one GPU. The device (and its hwmon monitor
+// and KFD node) is looked up once per smi_amdgpu_get_fields() call, and the
+// fields are read through it directly rather than through the rsmi_dev_*
+// getters, which would look up, support check, lock and log again for every
+// field. Sources that serve more than one field (gpu_metrics, pp_dpm_*) are
+// read at most once.
+class GpuFieldSources {
+ public:
+    GpuFieldSources(uint32_t gpu_index, std::shared_ptr<amd::smi::Device> dev)
+        : gpu_index_(gpu_index), dev_(std::move(dev)) {}
+
+    uint32_t gpu_index() const { return gpu_index_; }
+    amd::smi::Device& dev() const { return *dev_; }
+
+    amdsmi_status_t gpu_metrics(const rsmi_gpu_metrics_t** metrics) {
+        if (!gpu_metrics_status_) {
+            gpu_metrics_status_ = amd::smi::rsmi_to_amdsmi_status(
+                amd::smi::dev_gpu_metrics_info_get(gpu_index_, *dev_, gpu_metrics_));
+        }
+        *metrics = &gpu_metrics_;
+        return *gpu_metrics_status_;
+    }
+
+    // Index of the current level in pp_dpm_sclk/pp_dpm_mclk, as
+    // rsmi_dev_gpu_clk_freq_get() reports it in rsmi_frequencies_t::current
+    amdsmi_status_t dpm_level(amd::smi::DevInfoTypes type, uint64_t* level) {
+        auto& dpm = (type == amd::smi::kDevGPUSClk) ? sclk_level_ : mclk_level_;
+        if (!dpm.status) {
+            dpm.status = read_dpm_level(type, &dpm.level);
+        }
+        *level = dpm.level;
+        return *dpm.status;
+    }
+
+    const std::shared_ptr<amd::smi::Monitor>& monitor() {
+        if (!monitor_looked_up_) {
+            monitor_ = dev_->monitor();
+            monitor_looked_up_ = true;
+        }
+        return monitor_;
+    }
+
+    amdsmi_status_t hwmon(amd::smi::MonitorTypes type, uint32_t sensor_ind, int64_t* value) {
+        const auto& mon = monitor();
+        if (mon == nullptr) {
+            return AMDSMI_STATUS_NOT_SUPPORTED;
+        }
+        std::string val_str;
+        const int ret = mon->readMonitor(type, sensor_ind, &val_str);
+        if (ret != 0) {
+            return amd::smi::rsmi_to_amdsmi_status(amd::smi::ErrnoToRsmiStatus(ret));
+        }
+        if (!amd::smi::IsInteger(val_str)) {
+            return AMDSMI_STATUS_UNEXPECTED_DATA;
+        }
+        *value = std::stoll(val_str);
+        return AMDSMI_STATUS_SUCCESS;
+    }
+
+    std::shared_ptr<amd::smi::KFDNode> kfd_node() {
+        if (!kfd_node_looked_up_) {
+            auto& kfd_nodes = amd::smi::RocmSMI::getInstance().kfd_node_map();
+            const auto it = kfd_nodes.find(dev_->kfd_gpu_id());
+            if (it != kfd_nodes.end()) {
+                kfd_node_ = it->second;
+            }
+            kfd_node_looked_up_ = true;
+        }
+        return kfd_node_;
+    }
+
+ private:
+    struct DpmLevel {
+        std::optional<amdsmi_status_t> status;
+        uint64_t level = 0;
+    };
+
+    amdsmi_status_t read_dpm_level(amd::smi::DevInfoTypes type, uint64_t* level) {
+        std::vector<std::string> lines;
+        const int ret = dev_->readDevInfo(type, &lines);
+        if (ret != 0) {
+            return amd::smi::rsmi_to_amdsmi_status(amd::smi::ErrnoToRsmiStatus(ret));
+        }
+        if (lines.empty()) {
+            return AMDSMI_STATUS_NOT_YET_IMPLEMENTED;
+        }
+        for (size_t i = 0; i < lines.size(); ++i) {
+            if (lines[i].find('*') != std::string::npos) {
+                *level = i;
+                return AMDSMI_STATUS_SUCCESS;
+            }
+        }
+        return AMDSMI_STATUS_UNEXPECTED_DATA;
+    }
+
+    uint32_t gpu_index_;
+    std::shared_ptr<amd::smi::Device> dev_;
+    std::optional<amdsmi_status_t> gpu_metrics_status_;
+    rsmi_gpu_metrics_t gpu_metrics_{};
+    DpmLevel sclk_level_;
+    DpmLevel mclk_level_;
+    bool monitor_looked_up_ = false;
+    std::shared_ptr<amd::smi::Monitor> monitor_;
+    bool kfd_node_looked_up_ = false;
+    std::shared_ptr<amd::smi::KFDNode> kfd_node_;
+};
+
+// gpu_metrics reports counters it does not support as all ones
+template <typename T>
+amdsmi_status_t metric_to_field(T metric_value, amdsmi_field_value_t* field) {
+    if (metric_value == std::numeric_limits<T>::max()) {
+        return AMDSMI_STATUS_NOT_SUPPORTED;
+    }
+    field->value.u64 = metric_value;
+    return AMDSMI_STATUS_SUCCESS;
+}
+
+amdsmi_status_t read_gpu_metrics_field(GpuFieldSources& sources, amdsmi_field_value_t* field) {
+    const rsmi_gpu_metrics_t* metrics = nullptr;
+    auto status = sources.gpu_metrics(&metrics);
+    if (status != AMDSMI_STATUS_SUCCESS) {
+        return status;
+    }
+
+    switch (field->field_id) {
+        case AMDSMI_FIELD_SOCKET_POWER:
+            if (metrics->current_socket_power != std::numeric_limits<uint16_t>::max()) {
+                return metric_to_field(metrics->current_socket_power, field);
+            }
+            return metric_to_field(metrics->average_socket_power, field);
+        case AMDSMI_FIELD_ENERGY_ACCUMULATOR:
+            return metric_to_field(metrics->energy_accumulator, field);
+        case AMDSMI_FIELD_GFX_ACTIVITY:
+            return metric_to_field(metrics->average_gfx_activity, field);
+        case AMDSMI_FIELD_UMC_ACTIVITY:
+            return metric_to_field(metrics->average_umc_activity, field);
+        case AMDSMI_FIELD_MM_ACTIVITY:
+            return metric_to_field(metrics->average_mm_activity, field);
+        case AMDSMI_FIELD_GFX_CLK:
+            if (metrics->current_gfxclk != std::numeric_limits<uint16_t>::max()) {
+                return metric_to_field(metrics->current_gfxclk, field);
+            }
+            return metric_to_field(metrics->current_gfxclks[0], field);
+        case AMDSMI_FIELD_MEM_CLK:
+            return metric_to_field(metrics->current_uclk, field);
+        case AMDSMI_FIELD_SOC_CLK:
+            if (metrics->current_socclk != std::numeric_limits<uint16_t>::max()) {
+                return metric_to_field(metrics->current_socclk, field);
+            }
+            return metric_to_field(metrics->current_socclks[0], field);
+        case AMDSMI_FIELD_THROTTLE_STATUS:
+            return metric_to_field(metrics->throttle_status, field);
+        case AMDSMI_FIELD_PCIE_LINK_WIDTH:
+            return metric_to_field(metrics->pcie_link_width, field);
+        case AMDSMI_FIELD_PCIE_LINK_SPEED:
+            return metric_to_field(metrics->pcie_link_speed, field);
+        default:
+            return AMDSMI_STATUS_INVAL;
+    }
+}
+
+bool is_hwmon_field(amdsmi_field_id_t field_id) {
+    switch (field_id) {
+        case AMDSMI_FIELD_TEMP_EDGE:
+        case AMDSMI_FIELD_TEMP_HOTSPOT:
+        case AMDSMI_FIELD_TEMP_VRAM:
+        case AMDSMI_FIELD_FAN_SPEED:
+        case AMDSMI_FIELD_FAN_RPMS:
+        case AMDSMI_FIELD_POWER_CAP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Reads the same hwmon files as rsmi_dev_temp_metric_get(RSMI_TEMP_CURRENT),
+// rsmi_dev_fan_speed_get(), rsmi_dev_fan_rpms_get() and
+// rsmi_dev_power_cap_get() for sensor 0
+amdsmi_status_t read_hwmon_field(GpuFieldSources& sources, amdsmi_field_value_t* field) {
+    int64_t value = 0;
+    amdsmi_status_t status = AMDSMI_STATUS_INVAL;
+    switch (field->field_id) {
+        case AMDSMI_FIELD_TEMP_EDGE:
+        case AMDSMI_FIELD_TEMP_HOTSPOT:
+        case AMDSMI_FIELD_TEMP_VRAM: {
+            static_assert(AMDSMI_FIELD_TEMP_HOTSPOT - AMDSMI_FIELD_TEMP_EDGE ==
+                          AMDSMI_TEMPERATURE_TYPE_HOTSPOT - AMDSMI_TEMPERATURE_TYPE_EDGE);
+            static_assert(AMDSMI_FIELD_TEMP_VRAM - AMDSMI_FIELD_TEMP_EDGE ==
+                          AMDSMI_TEMPERATURE_TYPE_VRAM - AMDSMI_TEMPERATURE_TYPE_EDGE);
+            const auto& monitor = sources.monitor();
+            if (monitor == nullptr) {
+                return AMDSMI_STATUS_NOT_SUPPORTED;
+            }
+            const auto sensor_type = static_cast<rsmi_temperature_type_t>(
+                AMDSMI_TEMPERATURE_TYPE_EDGE + (field->field_id - AMDSMI_FIELD_TEMP_EDGE));
+            uint32_t sensor_index = 0;
+            try {
+                sensor_index = monitor->getTempSensorIndex(sensor_type);
+            } catch (const std::out_of_range&) {
+                return AMDSMI_STATUS_NOT_SUPPORTED;
+            }
+            status = sources.hwmon(amd::smi::kMonTemp, sensor_index, &value);
+            if (status != AMDSMI_STATUS_SUCCESS) {
+                return status;
+            }
+            field->type = AMDSMI_FIELD_TYPE_INT64;
+            field->value.i64 = value / 1000;
+            return AMDSMI_STATUS_SUCCESS;
+        }
+        // fan and power sysfs files have 1-based indices
+        case AMDSMI_FIELD_FAN_SPEED:
+        case AMDSMI_FIELD_FAN_RPMS:
+            status = sources.hwmon((field->field_id == AMDSMI_FIELD_FAN_SPEED) ?
+                                       amd::smi::kMonFanSpeed : amd::smi::kMonFanRPMs,
+                                   1, &value);
+            if (status == AMDSMI_STATUS_SUCCESS) {
+                field->type = AMDSMI_FIELD_TYPE_INT64;
+                field->value.i64 = value;
+            }
+            return status;
+        case AMDSMI_FIELD_POWER_CAP:
+            status = sources.hwmon(amd::smi::kMonPowerCap, 1, &value);
+            if (status == AMDSMI_STATUS_SUCCESS) {
+                field->value.u64 = static_cast<uint64_t>(value);
+            }
+            return status;
+        default:
+            return AMDSMI_STATUS_INVAL;
+    }
+}
+
+// Same values as rsmi_dev_memory_total_get() and rsmi_dev_memory_usage_get(),
+// including their fallback to the KFD node for VRAM
+amdsmi_status_t read_memory_field(GpuFieldSources& sources, amdsmi_field_value_t* field) {
+    amd::smi::DevInfoTypes type;
+    switch (field->field_id) {
+        case AMDSMI_FIELD_VRAM_TOTAL:
+            type = amd::smi::kDevMemTotVRAM;
+            break;
+        case AMDSMI_FIELD_VRAM_USED:
+            type = amd::smi::kDevMemUsedVRAM;
+            break;
+        case AMDSMI_FIELD_VIS_VRAM_TOTAL:
+            type = amd::smi::kDevMemTotVisVRAM;
+            break;
+        case AMDSMI_FIELD_VIS_VRAM_USED:
+            type = amd::smi::kDevMemUsedVisVRAM;
+            break;
+        case AMDSMI_FIELD_GTT_TOTAL:
+            type = amd::smi::kDevMemTotGTT;
+            break;
+        case AMDSMI_FIELD_GTT_USED:
+            type = amd::smi::kDevMemUsedGTT;
+            break;
+        default:
+            return AMDSMI_STATUS_INVAL;
+    }
+
+    uint64_t bytes = 0;
+    int ret = sources.dev().readDevInfo(type, &bytes);
+    if (bytes == 0 && type == amd::smi::kDevMemTotVRAM) {
+        auto kfd_node = sources.kfd_node();
+        if (kfd_node != nullptr && kfd_node->get_total_memory(&bytes) == 0 && bytes > 0) {
+            ret = 0;
+        }
+    } else if (bytes == 0 && type == amd::smi::kDevMemUsedVRAM) {
+        // No VRAM used, or no VRAM at all (APUs): only the latter falls
+        // back to the memory KFD reports
+        uint64_t total = 0;
+        sources.dev().readDevInfo(amd::smi::kDevMemTotVRAM, &total);
+        auto kfd_node = sources.kfd_node();
+        if (total == 0 && kfd_node != nullptr && kfd_node->get_used_memory(&bytes) == 0) {
+            ret = 0;
+        }
+    }
+    if (ret != 0) {
+        return amd::smi::rsmi_to_amdsmi_status(amd::smi::ErrnoToRsmiStatus(ret));
+    }
+    field->value.u64 = bytes;
+    return AMDSMI_STATUS_SUCCESS;
+}
+
+amdsmi_status_t read_field(GpuFieldSources& sources, amdsmi_field_value_t* field) {
+    if (is_hwmon_field(field->field_id)) {
+        return read_hwmon_field(sources, field);
+    }
+    switch (field->field_id) {
+        case AMDSMI_FIELD_SOCKET_POWER:
+        case AMDSMI_FIELD_ENERGY_ACCUMULATOR:
+        case AMDSMI_FIELD_GFX_ACTIVITY:
+        case AMDSMI_FIELD_UMC_ACTIVITY:
+        case AMDSMI_FIELD_MM_ACTIVITY:
+        case AMDSMI_FIELD_GFX_CLK:
+        case AMDSMI_FIELD_MEM_CLK:
+        case AMDSMI_FIELD_SOC_CLK:
+        case AMDSMI_FIELD_THROTTLE_STATUS:
+        case AMDSMI_FIELD_PCIE_LINK_WIDTH:
+        case AMDSMI_FIELD_PCIE_LINK_SPEED:
+            return read_gpu_metrics_field(sources, field);
+        case AMDSMI_FIELD_GFX_CLK_LEVEL:
+        case AMDSMI_FIELD_MEM_CLK_LEVEL: {
+            uint64_t level = 0;
+            auto status = sources.dpm_level(
+                (field->field_id == AMDSMI_FIELD_GFX_CLK_LEVEL) ? amd::smi::kDevGPUSClk
+                                                                : amd::smi::kDevGPUMClk,
+                &level);
+            if (status == AMDSMI_STATUS_SUCCESS) {
+                field->value.u64 = level;
+            }
+            return status;
+        }
+        case AMDSMI_FIELD_VRAM_TOTAL:
+        case AMDSMI_FIELD_VRAM_USED:
+        case AMDSMI_FIELD_VIS_VRAM_TOTAL:
+        case AMDSMI_FIELD_VIS_VRAM_USED:
+        case AMDSMI_FIELD_GTT_TOTAL:
+        case AMDSMI_FIELD_GTT_USED:
+            return read_memory_field(sources, field);
+        default:
+            return AMDSMI_STATUS_INVAL;
+    }
+}
+
+// Device, monitor and sysfs reads may throw; report those per field
+amdsmi_status_t read_field_checked(GpuFieldSources& sources, amdsmi_field_value_t* field) {
+    try {
+        return read_field(sources, field);
+    } catch (...) {
+        return amd::smi::rsmi_to_amdsmi_status(amd::smi::handleException());
+    }
+}
+
+// hwmon and sysfs fields are checked against the device's support bitmap,
+// without reading them
+bool field_supported(const std::shared_ptr<amd::smi::Device>& dev,
+                     amdsmi_field_id_t field_id) {
+    switch (field_id) {
+        case AMDSMI_FIELD_TEMP_EDGE:
+        case AMDSMI_FIELD_TEMP_HOTSPOT:
+        case AMDSMI_FIELD_TEMP_VRAM: {
+            const auto& monitor = dev->monitor();
+            if (monitor == nullptr) {
+                return false;
+            }
+            const auto sensor_type = static_cast<rsmi_temperature_type_t>(
+                AMDSMI_TEMPERATURE_TYPE_EDGE + (field_id - AMDSMI_FIELD_TEMP_EDGE));
+            return dev->DeviceAPISupported(amd::smi::kSupportedFunc_rsmi_dev_temp_metric_get,
+                                           RSMI_TEMP_CURRENT,
+                                           monitor->getTempSensorIndex(sensor_type));
+        }
+        case AMDSMI_FIELD_FAN_SPEED:
+            // fan sysfs files have 1-based indices
+            return dev->DeviceAPISupported(amd::smi::kSupportedFunc_rsmi_dev_fan_speed_get,
+                                           RSMI_DEFAULT_VARIANT, 1);
+        case AMDSMI_FIELD_FAN_RPMS:
+            return dev->DeviceAPISupported(amd::smi::kSupportedFunc_rsmi_dev_fan_rpms_get,
+                                           RSMI_DEFAULT_VARIANT, 1);
+        case AMDSMI_FIELD_POWER_CAP:
+            return dev->DeviceAPISupported(amd::smi::kSupportedFunc_rsmi_dev_power_cap_get,
+                                           RSMI_DEFAULT_VARIANT, 1);
+        case AMDSMI_FIELD_GFX_CLK_LEVEL:
+            return dev->DeviceAPISupported(amd::smi::kSupportedFunc_rsmi_dev_gpu_clk_freq_get,
+                                           RSMI_CLK_TYPE_SYS, RSMI_DEFAULT_VARIANT);
+        case AMDSMI_FIELD_MEM_CLK_LEVEL:
+            return dev->DeviceAPISupported(amd::smi::kSupportedFunc_rsmi_dev_gpu_clk_freq_get,
+                                           RSMI_CLK_TYPE_MEM, RSMI_DEFAULT_VARIANT);
+        case AMDSMI_FIELD_VRAM_TOTAL:
+            return dev->DeviceAPISupported(amd::smi::kSupportedFunc_rsmi_dev_memory_total_get,
+                                           RSMI_MEM_TYPE_VRAM, RSMI_DEFAULT_VARIANT);
+        case AMDSMI_FIELD_VRAM_USED:
+            return dev->DeviceAPISupported(amd::smi::kSupportedFunc_rsmi_dev_memory_usage_get,
+                                           RSMI_MEM_TYPE_VRAM, RSMI_DEFAULT_VARIANT);
+        case AMDSMI_FIELD_VIS_VRAM_TOTAL:
+            return dev->DeviceAPISupported(amd::smi::kSupportedFunc_rsmi_dev_memory_total_get,
+                                           RSMI_MEM_TYPE_VIS_VRAM, RSMI_DEFAULT_VARIANT);
+        case AMDSMI_FIELD_VIS_VRAM_USED:
+            return dev->DeviceAPISupported(amd::smi::kSupportedFunc_rsmi_dev_memory_usage_get,
+                                           RSMI_MEM_TYPE_VIS_VRAM, RSMI_DEFAULT_VARIANT);
+        case AMDSMI_FIELD_GTT_TOTAL:
+            return dev->DeviceAPISupported(amd::smi::kSupportedFunc_rsmi_dev_memory_total_get,
+                                           RSMI_MEM_TYPE_GTT, RSMI_DEFAULT_VARIANT);
+        case AMDSMI_FIELD_GTT_USED:
+            return dev->DeviceAPISupported(amd::smi::kSupportedFunc_rsmi_dev_memory_usage_get,
+                                           RSMI_MEM_TYPE_GTT, RSMI_DEFAULT_VARIANT);
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+amdsmi_status_t smi_amdgpu_get_supported_fields(amd::smi::AMDSmiGPUDevice* device,
+                                                uint64_t *bitmap) {
+    static_assert(AMDSMI_FIELD__MAX <= 64, "amdsmi_field_id_t no longer fits a uint64_t");
+    if (device == nullptr || bitmap == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+
+    auto& smi = amd::smi::RocmSMI::getInstance();
+    const uint32_t gpu_index = device->get_gpu_id();
+    if (gpu_index >= smi.devices().size()) {
+        return AMDSMI_STATUS_INVAL;
+    }
+    const auto dev = smi.devices()[gpu_index];
+
+    SMIGPUDEVICE_READ_MUTEX(device)
+
+    *bitmap = 0;
+    GpuFieldSources sources(gpu_index, dev);
+    for (uint32_t id = AMDSMI_FIELD_FIRST; id < AMDSMI_FIELD__MAX; ++id) {
+        amdsmi_field_value_t field{};
+        field.field_id = static_cast<amdsmi_field_id_t>(id);
+        bool supported = false;
+        switch (field.field_id) {
+            case AMDSMI_FIELD_SOCKET_POWER:
+            case AMDSMI_FIELD_ENERGY_ACCUMULATOR:
+            case AMDSMI_FIELD_GFX_ACTIVITY:
+            case AMDSMI_FIELD_UMC_ACTIVITY:
+            case AMDSMI_FIELD_MM_ACTIVITY:
+            case AMDSMI_FIELD_GFX_CLK:
+            case AMDSMI_FIELD_MEM_CLK:
+            case AMDSMI_FIELD_SOC_CLK:
+            case AMDSMI_FIELD_THROTTLE_STATUS:
+            case AMDSMI_FIELD_PCIE_LINK_WIDTH:
+            case AMDSMI_FIELD_PCIE_LINK_SPEED:
+                // Whether these are set depends on the gpu_metrics version
+                // and the ASIC, so they are read (once, for all of them)
+                supported = (read_field_checked(sources, &field) == AMDSMI_STATUS_SUCCESS);
+                break;
+            default:
+                try {
+                    supported = field_supported(dev, field.field_id);
+                } catch (const std::exception& e) {
+                    supported = false;
+                }
+                break;
+        }
+        if (supported) {
+            *bitmap |= 1ULL << id;
+        }
+    }
+    return AMDSMI_STATUS_SUCCESS;
+}
+
+amdsmi_status_t smi_amdgpu_get_fields(amd::smi::AMDSmiGPUDevice* device,
+                                      amdsmi_field_value_t *fields, uint32_t num_fields) {
+    if (device == nullptr || fields == nullptr || num_fields == 0) {
+        return AMDSMI_STATUS_INVAL;
+    }
+
+    // The device is validated and locked once for the whole batch
+    auto& smi = amd::smi::RocmSMI::getInstance();
+    const uint32_t gpu_index = device->get_gpu_id();
+    if (gpu_index >= smi.devices().size()) {
+        return AMDSMI_STATUS_INVAL;
+    }
+    SMIGPUDEVICE_READ_MUTEX(device)
+
+    GpuFieldSources sources(gpu_index, smi.devices()[gpu_index]);
+    for (uint32_t i = 0; i < num_fields; ++i) {
+        fields[i].type = AMDSMI_FIELD_TYPE_UINT64;
+        fields[i].value.u64 = AMDSMI_FIELD_VALUE_INVALID;
+    }
+
+    // hwmon fields first, then the fields served by gpu_metrics and the
+    // other sysfs files
+    uint32_t num_read = 0;
+    for (const bool hwmon_pass : {true, false}) {
+        for (uint32_t i = 0; i < num_fields; ++i) {
+            auto& field = fields[i];
+            if (is_hwmon_field(field.field_id) != hwmon_pass) {
+                continue;
+            }
+            field.status = read_field_checked(sources, &field);
+            if (field.status == AMDSMI_STATUS_SUCCESS) {
+                ++num_read;
+            }
+        }
+    }
+
+    std::ostringstream ss;
+    ss << __PRETTY_FUNCTION__ << " | gpu_index: " << gpu_index
+       << " | fields read: " << num_read << "/" << num_fields;
+    LOG_INFO(ss);
+    return AMDSMI_STATUS_SUCCESS;
+}
+
+amdsmi_status_t smi_amdgpu_get_fields_multi(const std::vector<amd::smi::AMDSmiGPUDevice*>& devices,
+                                            const amdsmi_field_id_t *field_ids, uint32_t num_fields,
+                                            amdsmi_field_value_t *values) {
+    if (devices.empty() || field_ids == nullptr || num_fields == 0 || values == nullptr) {
+        return AMDSMI_STATUS_INVAL;
+    }
+
+    std::vector<amdsmi_status_t> device_status(devices.size(), AMDSMI_STATUS_SUCCESS);
+    std::vector<std::function<void()>> device_tasks;
+    device_tasks.reserve(devices.size());
+    for (size_t i = 0; i < devices.size(); ++i) {
+        auto* device_values = values + (i * num_fields);
+        for (uint32_t j = 0; j < num_fields; ++j) {
+            device_values[j].field_id = field_ids[j];
+        }
+        device_tasks.emplace_back([&devices, &device_status, device_values, num_fields, i]() {
+            device_status[i] = smi_amdgpu_get_fields(devices[i], device_values, num_fields);
+        });
+    }
+
+    // A single device does not need to go through the pool
+    if (device_tasks.size() == 1) {
+        device_tasks.front()();
+    } else {
+        auto worker_pool = amd::smi::AMDSmiSystem::getInstance().get_worker_pool();
+        worker_pool->run_all(device_tasks);
+    }
+
+    // A device that could not be locked reports its status on every field
+    for (size_t i = 0; i < devices.size(); ++i) {
+        if (device_status[i] == AMDSMI_STATUS_SUCCESS) {
+            continue;
+        }
+        auto* device_values = values + (i * num_fields);
+        for (uint32_t j = 0; j < num_fields; ++j) {
+            device_values[j].status = device_status[i];
+            device_values[j].type = AMDSMI_FIELD_TYPE_UINT64;
+            device_values[j].value.u64 = AMDSMI_FIELD_VALUE_INVALID;
+        }
+    }
+    return AMDSMI_STATUS_SUCCESS;
+}
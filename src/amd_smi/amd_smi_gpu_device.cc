@@ -59,22 +59,40 @@ uint32_t AMDSmiGPUDevice::get_gpu_id() const {
     return gpu_id_;
 }
 
-uint32_t AMDSmiGPUDevice::get_gpu_fd() const {
+uint32_t AMDSmiGPUDevice::get_gpu_fd() {
+    check_if_drm_is_supported();
     return fd_;
 }
 
 std::string& AMDSmiGPUDevice::get_gpu_path() {
+    check_if_drm_is_supported();
     return path_;
 }
 
 amdsmi_bdf_t AMDSmiGPUDevice::get_bdf() {
+    // With lazy init, bdf_ is rewritten inside the once-init
+    check_if_drm_is_supported();
     return bdf_;
 }
 
 uint32_t AMDSmiGPUDevice::get_vendor_id() {
+    check_if_drm_is_supported();
     return vendor_id_;
 }
 
+// With lazy init, DRM is only usable for this GPU once its own render node
+// has been opened.
+bool AMDSmiGPUDevice::check_if_drm_is_supported() {
+    if (!drm_.is_lazy()) {
+        return drm_.check_if_drm_is_supported();
+    }
+    std::call_once(drm_data_once_, [this]() {
+        drm_data_valid_ = drm_.check_if_drm_is_supported() &&
+                          get_drm_data() == AMDSMI_STATUS_SUCCESS;
+    });
+    return drm_data_valid_;
+}
+
 amdsmi_status_t AMDSmiGPUDevice::get_drm_data() {
     amdsmi_status_t ret;
     uint32_t fd = 0;
@@ -93,10 +111,36 @@ amdsmi_status_t AMDSmiGPUDevice::get_drm_data() {
     return AMDSMI_STATUS_SUCCESS;
 }
 
+// Without a DRM node (no libdrm, or a synthetic RSMI_FS_ROOT tree) the BDF
+// still comes from sysfs, so the processes can be matched by drm-pdev.
+amdsmi_status_t AMDSmiGPUDevice::get_rsmi_bdf() {
+    uint64_t bdf_rocm = 0;
+    rsmi_status_t ret = rsmi_dev_pci_id_get(gpu_id_, &bdf_rocm);
+    if (ret != RSMI_STATUS_SUCCESS) return amd::smi::rsmi_to_amdsmi_status(ret);
+
+    bdf_ = amd::smi::rsmi_bdf_to_amdsmi_bdf(bdf_rocm);
+
+    return AMDSMI_STATUS_SUCCESS;
+}
+
+bool AMDSmiGPUDevice::start_background_sampler(
+        std::shared_ptr<AMDSmiBackgroundSampler> sampler) {
+    std::shared_ptr<AMDSmiBackgroundSampler> no_sampler;
+    if (!std::atomic_compare_exchange_strong(&background_sampler_, &no_sampler, sampler)) {
+        return false;
+    }
+    sampler->start();
+    return true;
+}
+
 pthread_mutex_t* AMDSmiGPUDevice::get_mutex() {
     return amd::smi::GetMutex(gpu_id_);
 }
 
+shared_rwlock_t* AMDSmiGPUDevice::get_rwlock() {
+    return amd::smi::GetRWLock(gpu_id_);
+}
+
 amdsmi_status_t AMDSmiGPUDevice::amdgpu_query_info(unsigned info_id,
                     unsigned size, void *value) const {
     amdsmi_status_t ret;
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2024 Advanced Micro Devices. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "amd_smi/impl/amd_smi_link_rate.h"
+
+namespace amd {
+namespace smi {
+
+namespace {
+
+constexpr uint64_t kUnsupported = std::numeric_limits<uint64_t>::max();
+constexpr float kNotAvailable = -1.0f;
+
+// GB/s between two readings of a cumulative KB accumulator; bytes per
+// nanosecond is GB/s. The accumulators are 64 bits wide, so one that went
+// back was reset (GPU reset, driver reload) rather than wrapped, and the
+// interval is not available.
+float accumulator_rate(uint64_t from_kb, uint64_t to_kb, uint64_t window_ns) {
+    if (from_kb == kUnsupported || to_kb == kUnsupported || to_kb < from_kb) {
+        return kNotAvailable;
+    }
+    return static_cast<float>(static_cast<double>(to_kb - from_kb) * 1024 /
+                              static_cast<double>(window_ns));
+}
+
+float utilization(float gbps, float max_gbps) {
+    if (gbps < 0 || max_gbps <= 0) {
+        return kNotAvailable;
+    }
+    return gbps * 100 / max_gbps;
+}
+
+}  // namespace
+
+AMDSmiLinkRateTracker::AMDSmiLinkRateTracker()
+    : has_baseline_(false), baseline_{}, has_rates_(false), rates_{},
+      xgmi_kfd_max_known_(false), xgmi_kfd_max_gbps_(0) {
+}
+
+bool AMDSmiLinkRateTracker::update(const AMDSmiLinkSample& sample,
+                                   amdsmi_link_rates_t* rates) {
+    // No baseline yet, or the timestamp went back (driver reload)
+    if (!has_baseline_ || sample.time_ns < baseline_.time_ns) {
+        has_baseline_ = true;
+        baseline_ = sample;
+        has_rates_ = false;
+        return false;
+    }
+
+    // The firmware has not refreshed the metrics since the baseline
+    if (sample.time_ns == baseline_.time_ns) {
+        if (has_rates_) {
+            *rates = rates_;
+        }
+        return has_rates_;
+    }
+
+    rates_ = {};
+    rates_.window_ns = sample.time_ns - baseline_.time_ns;
+
+    for (uint32_t i = 0; i < AMDSMI_MAX_NUM_XGMI_LINKS; ++i) {
+        if (sample.xgmi_read_kb[i] == kUnsupported &&
+            sample.xgmi_write_kb[i] == kUnsupported) {
+            continue;
+        }
+        auto& link = rates_.links[rates_.num_links++];
+        link.link_type = AMDSMI_LINK_TYPE_XGMI;
+        link.link_index = i;
+        link.read_gbps = accumulator_rate(baseline_.xgmi_read_kb[i],
+                                          sample.xgmi_read_kb[i], rates_.window_ns);
+        link.write_gbps = accumulator_rate(baseline_.xgmi_write_kb[i],
+                                           sample.xgmi_write_kb[i], rates_.window_ns);
+        link.total_gbps = (link.read_gbps >= 0 && link.write_gbps >= 0)
+                              ? link.read_gbps + link.write_gbps : kNotAvailable;
+        link.max_gbps = sample.xgmi_max_gbps;
+        // The busier direction, and only when both are known
+        link.utilization = link.total_gbps >= 0
+                               ? utilization(std::max(link.read_gbps, link.write_gbps),
+                                             link.max_gbps)
+                               : kNotAvailable;
+    }
+
+    if (sample.pcie_bandwidth_inst != kUnsupported) {
+        auto& link = rates_.links[rates_.num_links++];
+        link.link_type = AMDSMI_LINK_TYPE_PCIE;
+        link.link_index = 0;
+        link.read_gbps = kNotAvailable;
+        link.write_gbps = kNotAvailable;
+        link.total_gbps = static_cast<float>(sample.pcie_bandwidth_inst);
+        link.max_gbps = sample.pcie_max_gbps;
+        link.utilization = utilization(link.total_gbps, link.max_gbps);
+    }
+
+    has_rates_ = true;
+    baseline_ = sample;
+    *rates = rates_;
+    return true;
+}
+
+}  // namespace smi
+}  // namespace amd
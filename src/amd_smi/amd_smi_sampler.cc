@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2024 Advanced Micro Devices. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "amd_smi/impl/amd_smi_sampler.h"
+#include "amd_smi/impl/amd_smi_fields.h"
+#include "amd_smi/impl/amd_smi_gpu_device.h"
+
+namespace amd {
+namespace smi {
+
+AMDSmiSampleRing::AMDSmiSampleRing(uint32_t depth)
+    : depth_(depth), ring_(new RingSlot[depth]), num_published_(0) {
+}
+
+AMDSmiBackgroundSampler::AMDSmiBackgroundSampler(AMDSmiGPUDevice* device,
+                            const amdsmi_field_id_t* field_ids, uint32_t num_fields,
+                            uint64_t period_us, uint32_t depth)
+    : device_(device), field_ids_(field_ids, field_ids + num_fields),
+      period_us_(period_us), ring_(depth), stopping_(false) {
+}
+
+AMDSmiBackgroundSampler::~AMDSmiBackgroundSampler() {
+    stop();
+}
+
+void AMDSmiBackgroundSampler::start() {
+    thread_ = std::thread(&AMDSmiBackgroundSampler::sampler_loop, this);
+}
+
+void AMDSmiBackgroundSampler::stop() {
+    {
+        std::lock_guard<std::mutex> guard(stop_mutex_);
+        stopping_ = true;
+    }
+    stop_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void AMDSmiBackgroundSampler::sampler_loop() {
+    const auto period = std::chrono::microseconds(period_us_);
+    const auto num_fields = static_cast<uint32_t>(field_ids_.size());
+    auto next_sample_time = std::chrono::steady_clock::now();
+
+    amdsmi_field_sample_t sample{};
+    sample.num_fields = num_fields;
+    for (uint32_t i = 0; i < num_fields; ++i) {
+        sample.fields[i].field_id = field_ids_[i];
+    }
+
+    while (true) {
+        sample.sequence = ring_.num_published();
+        sample.timestamp_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        const auto status = smi_amdgpu_get_fields(device_, sample.fields, num_fields);
+        if (status != AMDSMI_STATUS_SUCCESS) {
+            for (uint32_t i = 0; i < num_fields; ++i) {
+                sample.fields[i].status = status;
+            }
+        }
+        ring_.publish(sample);
+
+        //  Ticks missed because of a slow read are dropped, not bunched up
+        next_sample_time += period;
+        const auto now = std::chrono::steady_clock::now();
+        if (next_sample_time < now) {
+            next_sample_time = now;
+        }
+        std::unique_lock<std::mutex> lock(stop_mutex_);
+        if (stop_cv_.wait_until(lock, next_sample_time, [this]() { return stopping_; })) {
+            return;
+        }
+    }
+}
+
+void AMDSmiSampleRing::publish(const amdsmi_field_sample_t& sample) {
+    const auto sequence = sample.sequence;
+    auto& slot = ring_[sequence % depth_];
+
+    slot.m_sequence.store((2 * sequence) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&slot.m_sample, &sample, sizeof(sample));
+    slot.m_sequence.store((2 * sequence) + 2, std::memory_order_release);
+    num_published_.store(sequence + 1, std::memory_order_release);
+}
+
+uint32_t AMDSmiSampleRing::read(uint64_t* cursor, amdsmi_field_sample_t* samples,
+                                uint32_t max_samples) const {
+    // Records older than one ring behind the newest one are gone
+    auto oldest_kept = [this]() {
+        const auto num_published = num_published_.load(std::memory_order_acquire);
+        return (num_published > depth_) ? (num_published - depth_) : 0;
+    };
+
+    auto num_published = num_published_.load(std::memory_order_acquire);
+    auto next_sequence = std::max(*cursor, oldest_kept());
+    uint32_t num_read = 0;
+    while ((next_sequence < num_published) && (num_read < max_samples)) {
+        const auto& slot = ring_[next_sequence % depth_];
+        const auto expected_sequence = (2 * next_sequence) + 2;
+        if (slot.m_sequence.load(std::memory_order_acquire) == expected_sequence) {
+            std::memcpy(&samples[num_read], &slot.m_sample, sizeof(amdsmi_field_sample_t));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.m_sequence.load(std::memory_order_relaxed) == expected_sequence) {
+                ++num_read;
+                ++next_sequence;
+                continue;
+            }
+        }
+
+        //  The sampler wrapped around this slot while we were reading it
+        next_sequence = std::max(next_sequence + 1, oldest_kept());
+        num_published = num_published_.load(std::memory_order_acquire);
+    }
+
+    *cursor = next_sequence;
+    return num_read;
+}
+
+}  // namespace smi
+}  // namespace amd
@@ -42,6 +42,8 @@
  */
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <thread>
 #include "amd_smi/impl/amd_smi_system.h"
 #include "amd_smi/impl/amd_smi_gpu_device.h"
 #include "amd_smi/impl/amd_smi_common.h"
@@ -147,8 +149,19 @@ amdsmi_status_t AMDSmiSystem::populate_amd_cpus() {
     }
 
     amd_smi_status = get_nr_cpu_sockets(&sockets);
+    if (amd_smi_status != AMDSMI_STATUS_SUCCESS)
+        return amd_smi_status;
     amd_smi_status = get_nr_cpu_cores(&cpus);
+    if (amd_smi_status != AMDSMI_STATUS_SUCCESS)
+        return amd_smi_status;
     amd_smi_status = get_nr_threads_per_core(&threads);
+    if (amd_smi_status != AMDSMI_STATUS_SUCCESS)
+        return amd_smi_status;
+    if (sockets == 0 || threads == 0)
+        return AMDSMI_STATUS_NOT_FOUND;
+
+    cpu_sockets_ = sockets;
+    cpu_cores_per_socket_ = (cpus / threads) / sockets;
 
     for(uint32_t i = 0; i < sockets; i++) {
         std::string cpu_socket_id = std::to_string(i);
@@ -168,8 +181,10 @@ amdsmi_status_t AMDSmiSystem::populate_amd_cpus() {
         socket->add_processor(cpusocket);
         processors_.insert(cpusocket);
 
-       for (uint32_t k = 0; k < (cpus/threads)/sockets; k++) {
-            AMDSmiProcessor* core = new AMDSmiProcessor(AMDSMI_PROCESSOR_TYPE_AMD_CPU_CORE, k);
+       // esmi numbers cores across all sockets, so offset by the socket
+       for (uint32_t k = 0; k < cpu_cores_per_socket_; k++) {
+            AMDSmiProcessor* core = new AMDSmiProcessor(AMDSMI_PROCESSOR_TYPE_AMD_CPU_CORE,
+                                                        i * cpu_cores_per_socket_ + k);
             socket->add_processor(core);
             processors_.insert(core);
        }
@@ -182,7 +197,23 @@ amdsmi_status_t AMDSmiSystem::populate_amd_cpus() {
 amdsmi_status_t AMDSmiSystem::populate_amd_gpu_devices() {
     // init rsmi
     rsmi_driver_state_t state;
-    rsmi_status_t ret = rsmi_init(0);
+    uint64_t rsmi_flags = 0;
+    if (init_flag_ & AMDSMI_INIT_LAZY) {
+        rsmi_flags |= RSMI_INIT_FLAG_LAZY;
+    }
+    if (init_flag_ & AMDSMI_INIT_DISCOVERY_CACHE) {
+        rsmi_flags |= RSMI_INIT_FLAG_DISCOVERY_CACHE;
+    }
+    if (init_flag_ & AMDSMI_INIT_LOCKLESS_READS) {
+        rsmi_flags |= RSMI_INIT_FLAG_LOCKLESS_READS;
+    }
+    if (init_flag_ & AMDSMI_INIT_GPU_METRICS_CACHE) {
+        rsmi_flags |= RSMI_INIT_FLAG_GPU_METRICS_CACHE;
+    }
+    if (init_flag_ & AMDSMI_INIT_SYSFS_FD_CACHE) {
+        rsmi_flags |= RSMI_INIT_FLAG_SYSFS_FD_CACHE;
+    }
+    rsmi_status_t ret = rsmi_init(rsmi_flags);
     if (ret != RSMI_STATUS_SUCCESS) {
         if (rsmi_driver_status(&state) == RSMI_STATUS_SUCCESS &&
                 state != RSMI_DRIVER_MODULE_STATE_LIVE) {
@@ -193,7 +224,8 @@ amdsmi_status_t AMDSmiSystem::populate_amd_gpu_devices() {
 
     // The init of libdrm depends on rsmi_init
     // libdrm is optional, ignore the error even if init fail.
-    amdsmi_status_t amd_smi_status = drm_.init();
+    amdsmi_status_t amd_smi_status =
+        drm_.init(amd::smi::RocmSMI::getInstance().lazy_init());
 
     uint32_t device_count = 0;
     ret = rsmi_num_monitor_devices(&device_count);
@@ -266,6 +298,12 @@ amdsmi_status_t AMDSmiSystem::get_gpu_socket_id(uint32_t index,
 }
 
 amdsmi_status_t AMDSmiSystem::cleanup() {
+    {
+        // A caller still running tasks on the pool keeps it alive; it is
+        // stopped when that caller drops its reference.
+        std::lock_guard<std::mutex> guard(worker_pool_mutex_);
+        worker_pool_.reset();
+    }
 #ifdef ENABLE_ESMI_LIB
     if (init_flag_ & AMDSMI_INIT_AMD_CPUS) {
         for (uint32_t i = 0; i < sockets_.size(); i++) {
@@ -273,6 +311,8 @@ amdsmi_status_t AMDSmiSystem::cleanup() {
         }
         processors_.clear();
         sockets_.clear();
+        cpu_sockets_ = 0;
+        cpu_cores_per_socket_ = 0;
         esmi_exit();
         init_flag_ &= ~AMDSMI_INIT_AMD_CPUS;
     }
@@ -295,6 +335,25 @@ amdsmi_status_t AMDSmiSystem::cleanup() {
     return AMDSMI_STATUS_SUCCESS;
 }
 
+std::shared_ptr<AMDSmiWorkerPool> AMDSmiSystem::get_worker_pool() {
+    // One worker per GPU, bounded by the number of CPUs
+    static const uint32_t kMaxWorkerPoolSize = 16;
+
+    std::lock_guard<std::mutex> guard(worker_pool_mutex_);
+    if (!worker_pool_) {
+        uint32_t num_gpus = 0;
+        for (auto processor : processors_) {
+            if (processor->get_processor_type() == AMDSMI_PROCESSOR_TYPE_AMD_GPU) {
+                ++num_gpus;
+            }
+        }
+        const uint32_t num_cpus = std::max(std::thread::hardware_concurrency(), 1U);
+        worker_pool_ = std::make_shared<AMDSmiWorkerPool>(
+            std::min({num_gpus, num_cpus, kMaxWorkerPoolSize}));
+    }
+    return worker_pool_;
+}
+
 amdsmi_status_t AMDSmiSystem::handle_to_socket(
             amdsmi_socket_handle socket_handle,
             AMDSmiSocket** socket) {
@@ -320,8 +379,7 @@ amdsmi_status_t AMDSmiSystem::handle_to_processor(
     *processor = static_cast<AMDSmiProcessor*>(processor_handle);
 
     // double check handlers is here
-    if (std::find(processors_.begin(), processors_.end(), *processor)
-            != processors_.end()) {
+    if (processors_.find(*processor) != processors_.end()) {
         return AMDSMI_STATUS_SUCCESS;
     }
     return AMDSMI_STATUS_NOT_FOUND;
@@ -146,10 +146,10 @@ amdsmi_status_t smi_amdgpu_find_hwmon_dir(amd::smi::AMDSmiGPUDevice *device, std
     if (full_path == nullptr) {
         return AMDSMI_STATUS_API_FAILED;
     }
-    SMIGPUDEVICE_MUTEX(device->get_mutex())
+    SMIGPUDEVICE_READ_MUTEX(device)
         DIR *dh;
     struct dirent * contents;
-    std::string device_path = "/sys/class/drm/" + device->get_gpu_path();
+    std::string device_path = amd::smi::FsPath("/sys/class/drm/") + device->get_gpu_path();
     std::string directory_path = device_path + "/device/hwmon/";
 
     if (!isAMDGPU(device_path)) {
@@ -181,12 +181,12 @@ amdsmi_status_t smi_amdgpu_get_board_info(amd::smi::AMDSmiGPUDevice* device, amd
     if (!device->check_if_drm_is_supported()) {
         return AMDSMI_STATUS_NOT_SUPPORTED;
     }
-    SMIGPUDEVICE_MUTEX(device->get_mutex())
-    std::string model_number_path = "/sys/class/drm/" + device->get_gpu_path() + std::string("/device/product_number");
-    std::string product_serial_path = "/sys/class/drm/" + device->get_gpu_path() + std::string("/device/serial_number");
-    std::string fru_id_path = "/sys/class/drm/" + device->get_gpu_path() + std::string("/device/fru_id");
-    std::string manufacturer_name_path = "/sys/class/drm/" + device->get_gpu_path() + std::string("/device/manufacturer");
-    std::string product_name_path = "/sys/class/drm/" + device->get_gpu_path() + std::string("/device/product_name");
+    SMIGPUDEVICE_READ_MUTEX(device)
+    std::string model_number_path = amd::smi::FsPath("/sys/class/drm/") + device->get_gpu_path() + std::string("/device/product_number");
+    std::string product_serial_path = amd::smi::FsPath("/sys/class/drm/") + device->get_gpu_path() + std::string("/device/serial_number");
+    std::string fru_id_path = amd::smi::FsPath("/sys/class/drm/") + device->get_gpu_path() + std::string("/device/fru_id");
+    std::string manufacturer_name_path = amd::smi::FsPath("/sys/class/drm/") + device->get_gpu_path() + std::string("/device/manufacturer");
+    std::string product_name_path = amd::smi::FsPath("/sys/class/drm/") + device->get_gpu_path() + std::string("/device/product_name");
 
     openFileAndModifyBuffer(model_number_path, info->model_number, AMDSMI_256_LENGTH);
     openFileAndModifyBuffer(product_serial_path, info->product_serial, AMDSMI_NORMAL_STRING_LENGTH);
@@ -225,7 +225,7 @@ amdsmi_status_t smi_amdgpu_get_power_cap(amd::smi::AMDSmiGPUDevice* device, int
 
     ret = smi_amdgpu_find_hwmon_dir(device, &fullpath);
 
-    SMIGPUDEVICE_MUTEX(device->get_mutex())
+    SMIGPUDEVICE_READ_MUTEX(device)
 
     if (ret)
         return ret;
@@ -252,8 +252,8 @@ amdsmi_status_t smi_amdgpu_get_ranges(amd::smi::AMDSmiGPUDevice* device, amdsmi_
     if (!device->check_if_drm_is_supported()) {
         return AMDSMI_STATUS_NOT_SUPPORTED;
     }
-    SMIGPUDEVICE_MUTEX(device->get_mutex())
-        std::string fullpath = "/sys/class/drm/" + device->get_gpu_path() + "/device";
+    SMIGPUDEVICE_READ_MUTEX(device)
+        std::string fullpath = amd::smi::FsPath("/sys/class/drm/") + device->get_gpu_path() + "/device";
 
     switch (domain) {
         case AMDSMI_CLK_TYPE_GFX:
@@ -329,27 +329,12 @@ amdsmi_status_t smi_amdgpu_get_enabled_blocks(amd::smi::AMDSmiGPUDevice* device,
     if (!device->check_if_drm_is_supported()) {
         return AMDSMI_STATUS_NOT_SUPPORTED;
     }
-    SMIGPUDEVICE_MUTEX(device->get_mutex())
-        std::string fullpath = "/sys/class/drm/" + device->get_gpu_path() + "/device/ras/features";
-    std::ifstream f(fullpath.c_str());
-    std::string tmp_str;
-
-    if (f.fail()) {
+    // ras/features is parsed once per device and cached by rocm_smi
+    rsmi_status_t ret = rsmi_dev_ecc_enabled_get(device->get_gpu_id(), enabled_blocks);
+    if (ret != RSMI_STATUS_SUCCESS) {
         return AMDSMI_STATUS_API_FAILED;
     }
 
-    std::string line;
-    getline(f, line);
-
-    std::istringstream f1(line);
-
-    f1 >> tmp_str;  // ignore
-    f1 >> tmp_str;  // ignore
-    f1 >> tmp_str;
-
-    *enabled_blocks = strtoul(tmp_str.c_str(), nullptr, 16);
-    f.close();
-
     if (*enabled_blocks == 0 || *enabled_blocks == ULONG_MAX) {
         return AMDSMI_STATUS_API_FAILED;
     }
@@ -362,11 +347,11 @@ amdsmi_status_t smi_amdgpu_get_bad_page_info(amd::smi::AMDSmiGPUDevice* device,
     if (!device->check_if_drm_is_supported()) {
         return AMDSMI_STATUS_NOT_SUPPORTED;
     }
-    SMIGPUDEVICE_MUTEX(device->get_mutex())
+    SMIGPUDEVICE_READ_MUTEX(device)
         std::string line;
     std::vector<std::string> badPagesVec;
 
-    std::string fullpath = "/sys/class/drm/" + device->get_gpu_path() + std::string("/device/ras/gpu_vram_bad_pages");
+    std::string fullpath = amd::smi::FsPath("/sys/class/drm/") + device->get_gpu_path() + std::string("/device/ras/gpu_vram_bad_pages");
     std::ifstream fs(fullpath.c_str());
 
     if (fs.fail()) {
@@ -429,10 +414,10 @@ amdsmi_status_t smi_amdgpu_get_ecc_error_count(amd::smi::AMDSmiGPUDevice* device
     if (!device->check_if_drm_is_supported()) {
         return AMDSMI_STATUS_NOT_SUPPORTED;
     }
-    SMIGPUDEVICE_MUTEX(device->get_mutex())
+    SMIGPUDEVICE_READ_MUTEX(device)
         char str[10];
 
-    std::string fullpath = "/sys/class/drm/" + device->get_gpu_path() + std::string("/device/ras/umc_err_count");
+    std::string fullpath = amd::smi::FsPath("/sys/class/drm/") + device->get_gpu_path() + std::string("/device/ras/umc_err_count");
     std::ifstream f(fullpath.c_str());
 
     if (f.fail()) {
@@ -455,7 +440,7 @@ amdsmi_status_t smi_amdgpu_get_driver_version(amd::smi::AMDSmiGPUDevice* device,
     if (!device->check_if_drm_is_supported()) {
         return AMDSMI_STATUS_NOT_SUPPORTED;
     }
-    SMIGPUDEVICE_MUTEX(device->get_mutex())
+    SMIGPUDEVICE_READ_MUTEX(device)
         amdsmi_status_t status = AMDSMI_STATUS_SUCCESS;
     FILE *fp;
     char *tmp, *ptr, *token;
@@ -468,11 +453,11 @@ amdsmi_status_t smi_amdgpu_get_driver_version(amd::smi::AMDSmiGPUDevice* device,
     else
         len = AMDSMI_MAX_DRIVER_VERSION_LENGTH;
 
-    std::string path = "/sys/module/amdgpu/version";
+    std::string path = amd::smi::FsPath("/sys/module/amdgpu/version");
 
     fp = fopen(path.c_str(), "r");
     if (fp == nullptr){
-        fp = fopen("/proc/version", "r");
+        fp = fopen(amd::smi::FsPath("/proc/version").c_str(), "r");
         if (fp == nullptr) {
             status = AMDSMI_STATUS_IO;
             return status;
@@ -602,8 +587,8 @@ amdsmi_status_t smi_amdgpu_is_gpu_power_management_enabled(amd::smi::AMDSmiGPUDe
         return AMDSMI_STATUS_API_FAILED;
     }
 
-    SMIGPUDEVICE_MUTEX(device->get_mutex())
-    std::string fullpath = "/sys/class/drm/" + device->get_gpu_path() + std::string("/device/pp_features");
+    SMIGPUDEVICE_READ_MUTEX(device)
+    std::string fullpath = amd::smi::FsPath("/sys/class/drm/") + device->get_gpu_path() + std::string("/device/pp_features");
     std::ifstream fs(fullpath.c_str());
 
     if (fs.fail()) {
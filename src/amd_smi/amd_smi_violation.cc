@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2024 Advanced Micro Devices. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <limits>
+
+#include "amd_smi/impl/amd_smi_violation.h"
+
+namespace amd {
+namespace smi {
+
+namespace {
+
+constexpr uint64_t kUnsupported = std::numeric_limits<uint64_t>::max();
+
+// from must be older than to, with a lower accumulation counter
+AMDSmiViolationResidency residency_between(const AMDSmiViolationSample& from,
+                                           const AMDSmiViolationSample& to) {
+    AMDSmiViolationResidency residency;
+    residency.window_us = to.time_us - from.time_us;
+    const uint64_t acc_delta = to.acc_counter - from.acc_counter;
+    for (int i = 0; i < kViolationNumTypes; ++i) {
+        if (from.residency_acc[i] == kUnsupported || to.residency_acc[i] == kUnsupported ||
+            to.residency_acc[i] < from.residency_acc[i] || acc_delta == 0) {
+            residency.percent[i] = kUnsupported;
+            continue;
+        }
+        residency.percent[i] =
+            ((to.residency_acc[i] - from.residency_acc[i]) * 100) / acc_delta;
+    }
+    return residency;
+}
+
+}  // namespace
+
+AMDSmiViolationTracker::AMDSmiViolationTracker()
+    : has_baseline_(false), baseline_{}, has_residency_(false), residency_{},
+      history_{}, history_head_(0), history_count_(0) {
+}
+
+bool AMDSmiViolationTracker::update(const AMDSmiViolationSample& sample,
+                                    AMDSmiViolationResidency* residency) {
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    // No baseline yet, or the accumulators went back (driver reload)
+    if (!has_baseline_ || sample.acc_counter < baseline_.acc_counter) {
+        has_baseline_ = true;
+        baseline_ = sample;
+        has_residency_ = false;
+        history_count_ = 0;
+        push_history(sample);
+        return false;
+    }
+
+    // The firmware has not updated the accumulators since the baseline
+    if (sample.acc_counter == baseline_.acc_counter) {
+        if (has_residency_) {
+            *residency = residency_;
+        }
+        return has_residency_;
+    }
+
+    residency_ = residency_between(baseline_, sample);
+    has_residency_ = true;
+    baseline_ = sample;
+    push_history(sample);
+    *residency = residency_;
+    return true;
+}
+
+void AMDSmiViolationTracker::record(const AMDSmiViolationSample& sample) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    push_history(sample);
+}
+
+void AMDSmiViolationTracker::push_history(const AMDSmiViolationSample& sample) {
+    if (history_count_ > 0) {
+        const auto& last = history_[(history_head_ + kHistoryDepth - 1) % kHistoryDepth];
+        // The accumulators went back (driver reload); older samples are void
+        if (sample.acc_counter < last.acc_counter) {
+            history_count_ = 0;
+        } else if (sample.time_us < last.time_us ||
+                   sample.time_us - last.time_us < kHistorySpacingUs) {
+            return;
+        }
+    }
+    history_[history_head_] = sample;
+    history_head_ = (history_head_ + 1) % kHistoryDepth;
+    if (history_count_ < kHistoryDepth) {
+        ++history_count_;
+    }
+}
+
+void AMDSmiViolationTracker::window_stats(const AMDSmiViolationSample& now,
+                                          uint64_t window_us,
+                                          amdsmi_violation_window_stats_t* stats) const {
+    *stats = {};
+    stats->window_us = window_us;
+    stats->per_prochot_thrm = kUnsupported;
+    stats->per_ppt_pwr = kUnsupported;
+    stats->per_socket_thrm = kUnsupported;
+    stats->per_vr_thrm = kUnsupported;
+    stats->per_hbm_thrm = kUnsupported;
+
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    // Compare the caller's sample against the oldest kept sample that is
+    // still within the window.
+    const auto& newest = now;
+    const AMDSmiViolationSample* oldest = nullptr;
+    uint32_t num_samples = 0;
+    for (uint32_t i = 0; i < history_count_; ++i) {
+        const auto& sample =
+            history_[(history_head_ + kHistoryDepth - history_count_ + i) % kHistoryDepth];
+        if (sample.time_us > newest.time_us ||
+            newest.time_us - sample.time_us > window_us) {
+            continue;
+        }
+        if (sample.acc_counter >= newest.acc_counter) {
+            break;
+        }
+        if (oldest == nullptr) {
+            oldest = &sample;
+        }
+        ++num_samples;
+    }
+    if (oldest == nullptr) {
+        return;
+    }
+
+    const auto residency = residency_between(*oldest, newest);
+    stats->covered_us = residency.window_us;
+    stats->num_samples = num_samples + 1;
+    stats->per_prochot_thrm = residency.percent[kViolationProchotThrm];
+    stats->per_ppt_pwr = residency.percent[kViolationPptPwr];
+    stats->per_socket_thrm = residency.percent[kViolationSocketThrm];
+    stats->per_vr_thrm = residency.percent[kViolationVrThrm];
+    stats->per_hbm_thrm = residency.percent[kViolationHbmThrm];
+}
+
+}  // namespace smi
+}  // namespace amd
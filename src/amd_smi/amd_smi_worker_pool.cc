@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2024 Advanced Micro Devices. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "amd_smi/impl/amd_smi_worker_pool.h"
+
+namespace amd {
+namespace smi {
+
+AMDSmiWorkerPool::AMDSmiWorkerPool(uint32_t num_workers) : stopping_(false) {
+    if (num_workers == 0) {
+        num_workers = 1;
+    }
+    workers_.reserve(num_workers);
+    for (uint32_t i = 0; i < num_workers; ++i) {
+        workers_.emplace_back(&AMDSmiWorkerPool::worker_loop, this);
+    }
+}
+
+AMDSmiWorkerPool::~AMDSmiWorkerPool() {
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stopping_ = true;
+    }
+    task_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void AMDSmiWorkerPool::worker_loop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            task_cv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void AMDSmiWorkerPool::run_all(const std::vector<std::function<void()>>& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    auto num_pending = tasks.size();
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        for (const auto& task : tasks) {
+            tasks_.emplace_back([&task, &done_mutex, &done_cv, &num_pending]() {
+                task();
+                std::lock_guard<std::mutex> done_guard(done_mutex);
+                if (--num_pending == 0) {
+                    done_cv.notify_one();
+                }
+            });
+        }
+    }
+    task_cv_.notify_all();
+
+    std::unique_lock<std::mutex> done_lock(done_mutex);
+    done_cv.wait(done_lock, [&num_pending]() { return num_pending == 0; });
+}
+
+}  // namespace smi
+}  // namespace amd
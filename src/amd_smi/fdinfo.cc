@@ -19,9 +19,16 @@
  */
 
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <dirent.h>
+#include <fcntl.h>
 #include <unistd.h>
+#include <errno.h>
+#include <chrono>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <cstdlib>
 #include <fstream>
@@ -30,234 +37,704 @@
 
 #include "amd_smi/amdsmi.h"
 #include "amd_smi/impl/amd_smi_utils.h"
+#include "amd_smi/impl/fdinfo.h"
 
-extern "C" {
+namespace {
 
 static const char *container_type_name[AMDSMI_MAX_CONTAINER_TYPE] = {
 	[AMDSMI_CONTAINER_LXC] = "lxc",
 	[AMDSMI_CONTAINER_DOCKER] = "docker",
 };
 
-amdsmi_status_t gpuvsmi_pid_is_gpu(const std::string &path, const char *bdf)
+/* An fd is a DRM fd if it links to one of these device nodes */
+static const char *drm_node_names[] = {"/dri/renderD", "/dri/card"};
+
+/* Calls for all the GPUs made within this time share one pass over /proc */
+static const auto kFdinfoScanMaxAge = std::chrono::milliseconds(100);
+
+/*
+ * The fd directory of a process whose fd count did not change is walked
+ * again after this long anyway, to find a DRM fd that replaced another fd
+ */
+static const auto kFdDirMaxAge = std::chrono::seconds(5);
+
+/* Large enough for the fdinfo of a DRM fd and for /proc/<pid>/stat */
+static const size_t kProcFileBufferSize = 4096;
+
+/*
+ * Reads a (small) /proc file relative to dir_fd into buf, NUL terminated.
+ * Returns the number of bytes read, or -1 on failure.
+ */
+ssize_t read_proc_file(int dir_fd, const char *path, char *buf, size_t size)
 {
-	DIR *d;
-	struct dirent *dir;
-
-	d = opendir(path.c_str());
-	if (!d)
-		return AMDSMI_STATUS_NO_PERM;
-
-	/* iterate through all the fds, try to find
-	* a match for the GPU bdf
-	*/
-	while ((dir = readdir(d)) != NULL) {
-		std::string file = path + dir->d_name;
-		std::ifstream fdinfo(file.c_str());
-		for (std::string line; std::getline(fdinfo, line);) {
-			if (line.find(bdf) != std::string::npos) {
-				closedir(d);
-				return AMDSMI_STATUS_SUCCESS;
-			}
+	int fd = openat(dir_fd, path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return -1;
+
+	size_t len = 0;
+	while (len < size - 1) {
+		ssize_t n = read(fd, buf + len, size - 1 - len);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			close(fd);
+			return -1;
 		}
+		if (n == 0)
+			break;
+		len += static_cast<size_t>(n);
 	}
+	close(fd);
+	buf[len] = '\0';
 
-	closedir(d);
+	return static_cast<ssize_t>(len);
+}
 
-	return AMDSMI_STATUS_NOT_FOUND;
+/*
+ * Splits buf in place into "key: value" lines, and calls
+ * on_key_value(key, value) for each of them, with value stripped of its
+ * leading blanks.
+ */
+template <typename KeyValueFunc>
+void for_each_key_value(char *buf, KeyValueFunc on_key_value)
+{
+	char *line = buf;
+	while (*line != '\0') {
+		char *eol = strchr(line, '\n');
+		if (eol)
+			*eol = '\0';
+
+		char *colon = strchr(line, ':');
+		if (colon) {
+			char *value = colon + 1;
+			*colon = '\0';
+			while (*value == ' ' || *value == '\t')
+				value++;
+			on_key_value(line, value);
+		}
+
+		if (!eol)
+			break;
+		line = eol + 1;
+	}
 }
 
-amdsmi_status_t gpuvsmi_get_pids(const amdsmi_bdf_t &bdf, std::vector<long int> &pids, uint64_t *size)
+/* "1234 KiB" -> bytes */
+uint64_t parse_memory_size(const char *value)
 {
-	char bdf_str[13];
-	DIR *d;
-	struct dirent *dir;
+	char *unit;
+	uint64_t size = strtoull(value, &unit, 10);
+
+	while (*unit == ' ')
+		unit++;
+	if (strncmp(unit, "KiB", 3) == 0)
+		return size << 10;
+	if (strncmp(unit, "MiB", 3) == 0)
+		return size << 20;
+	if (strncmp(unit, "GiB", 3) == 0)
+		return size << 30;
+
+	return size;
+}
 
-	/* 0000:00:00.0 */
-	snprintf(bdf_str, 13, "%04x:%02x:%02x.%d",
-            bdf.domain_number & 0xffff,
-			bdf.bus_number & 0xff,
-			bdf.device_number & 0x1f,
-			bdf.function_number & 0x7);
+/*
+ * Returns the entry of items named name, adding it if there is room left;
+ * nullptr otherwise, or if name is empty.
+ */
+template <typename Item, size_t N>
+Item *find_or_add_named(Item (&items)[N], uint32_t &num_items, const char *name)
+{
+	if (*name == '\0')
+		return nullptr;
+	for (uint32_t i = 0; i < num_items; i++) {
+		if (strncmp(items[i].name, name, sizeof(items[i].name) - 1) == 0)
+			return &items[i];
+	}
+	if (num_items == N)
+		return nullptr;
 
-	d = opendir("/proc");
-	if (!d)
-		return AMDSMI_STATUS_NO_PERM;
+	Item &item = items[num_items++];
+	item = Item{};
+	strncpy(item.name, name, sizeof(item.name) - 1);
 
-	pids.clear();
-	/* Find the pid folders in /proc/ that we have access to */
-	while ((dir = readdir(d)) != NULL) {
-		if (dir->d_type == DT_DIR) {
-			/* Try to cast the name of the folder to a
-			* number, if it fails, it is not */
-			char *p;
-			long int pid;
+	return &item;
+}
 
-			pid = strtol(dir->d_name, &p, 10);
-			if (*p != 0)
-				continue;
+template <typename Item, size_t N>
+const Item *find_named(const Item (&items)[N], uint32_t num_items, const char *name)
+{
+	for (uint32_t i = 0; i < num_items; i++) {
+		if (strncmp(items[i].name, name, sizeof(items[i].name) - 1) == 0)
+			return &items[i];
+	}
 
-			/* Check if fdinfo is accesible */
-			std::string path = "/proc/" + std::string(dir->d_name) + "/fdinfo/";
+	return nullptr;
+}
 
-			if (access(path.c_str(), R_OK))
-				continue;
+/* Returns the part of key after prefix, or nullptr if key does not start with it */
+const char *key_suffix(const char *key, const char *prefix, size_t prefix_len)
+{
+	return (strncmp(key, prefix, prefix_len) == 0) ? key + prefix_len : nullptr;
+}
 
-			/* check if GPU is present */
-			if (gpuvsmi_pid_is_gpu(path, bdf_str))
-				continue;
-			pids.push_back(pid);
+}  // namespace
+
+namespace amd {
+namespace smi {
+
+void parse_drm_fdinfo(char *buf, DrmFdinfo &fdinfo)
+{
+	static const char engine_prefix[] = "drm-engine-";
+	static const char capacity_prefix[] = "drm-engine-capacity-";
+	static const char cycles_prefix[] = "drm-cycles-";
+	static const char memory_prefix[] = "drm-memory-";
+	static const char shared_prefix[] = "drm-shared-";
+	static const char resident_prefix[] = "drm-resident-";
+
+	for_each_key_value(buf, [&](const char *key, const char *value) {
+		const char *name;
+
+		if (strncmp(key, "drm-", 4) != 0) {
+			if (strcmp(key, "pasid") == 0) {
+				fdinfo.pasid = atoi(value);
+				fdinfo.has_pasid = true;
+			}
+		} else if (strcmp(key, "drm-pdev") == 0) {
+			fdinfo.pdev = value;
+		} else if (strcmp(key, "drm-client-id") == 0) {
+			fdinfo.client_id = strtoull(value, nullptr, 10);
+			fdinfo.has_client_id = true;
+		} else if (key_suffix(key, capacity_prefix, sizeof(capacity_prefix) - 1)) {
+			/* Number of engines of a kind, not a usage */
+		} else if ((name = key_suffix(key, engine_prefix, sizeof(engine_prefix) - 1))) {
+			auto engine = find_or_add_named(fdinfo.engines, fdinfo.num_engines, name);
+			if (engine)
+				engine->busy_ns += strtoull(value, nullptr, 10);
+		} else if ((name = key_suffix(key, cycles_prefix, sizeof(cycles_prefix) - 1))) {
+			auto engine = find_or_add_named(fdinfo.engines, fdinfo.num_engines, name);
+			if (engine)
+				engine->cycles += strtoull(value, nullptr, 10);
+		} else if ((name = key_suffix(key, memory_prefix, sizeof(memory_prefix) - 1))) {
+			auto region = find_or_add_named(fdinfo.memory_regions, fdinfo.num_memory_regions, name);
+			if (region)
+				region->total += parse_memory_size(value);
+		} else if ((name = key_suffix(key, shared_prefix, sizeof(shared_prefix) - 1))) {
+			auto region = find_or_add_named(fdinfo.memory_regions, fdinfo.num_memory_regions, name);
+			if (region)
+				region->shared += parse_memory_size(value);
+		} else if ((name = key_suffix(key, resident_prefix, sizeof(resident_prefix) - 1))) {
+			auto region = find_or_add_named(fdinfo.memory_regions, fdinfo.num_memory_regions, name);
+			if (region)
+				region->resident += parse_memory_size(value);
 		}
+	});
+}
+
+void add_drm_fdinfo(const DrmFdinfo &fdinfo, GpuUsage &usage)
+{
+	if (fdinfo.has_pasid &&
+	    std::find(usage.pasids.begin(), usage.pasids.end(), fdinfo.pasid) == usage.pasids.end())
+		usage.pasids.push_back(fdinfo.pasid);
+
+	/* All the fds of one client (e.g. after a dup()) show the same counters */
+	if (fdinfo.has_client_id) {
+		if (std::find(usage.client_ids.begin(), usage.client_ids.end(), fdinfo.client_id) !=
+		    usage.client_ids.end())
+			return;
+		usage.client_ids.push_back(fdinfo.client_id);
+	}
+	usage.num_clients++;
+
+	for (uint32_t i = 0; i < fdinfo.num_engines; i++) {
+		auto engine = find_or_add_named(usage.engines, usage.num_engines, fdinfo.engines[i].name);
+		if (!engine)
+			continue;
+		engine->busy_ns += fdinfo.engines[i].busy_ns;
+		engine->cycles += fdinfo.engines[i].cycles;
+	}
+	for (uint32_t i = 0; i < fdinfo.num_memory_regions; i++) {
+		auto region = find_or_add_named(usage.memory_regions, usage.num_memory_regions,
+						fdinfo.memory_regions[i].name);
+		if (!region)
+			continue;
+		region->total += fdinfo.memory_regions[i].total;
+		region->shared += fdinfo.memory_regions[i].shared;
+		region->resident += fdinfo.memory_regions[i].resident;
 	}
-	closedir(d);
+}
 
-	*size = pids.size();
-	return AMDSMI_STATUS_SUCCESS;
+void update_busy_percent(const GpuUsage &previous, GpuUsage &usage)
+{
+	auto interval = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			usage.scan_time - previous.scan_time).count();
+	if (interval <= 0)
+		return;
+
+	usage.interval_ns = static_cast<uint64_t>(interval);
+	for (uint32_t i = 0; i < usage.num_engines; i++) {
+		auto &engine = usage.engines[i];
+		auto previous_engine = find_named(previous.engines, previous.num_engines, engine.name);
+		/* Counters go back when a client is closed, count that as idle */
+		if (!previous_engine || engine.busy_ns <= previous_engine->busy_ns)
+			continue;
+		engine.busy_percent = static_cast<uint32_t>(
+				(engine.busy_ns - previous_engine->busy_ns) * 100 / usage.interval_ns);
+	}
 }
 
-amdsmi_status_t gpuvsmi_get_pid_info(const amdsmi_bdf_t &bdf, long int pid,
-		amdsmi_proc_info_t &info)
+}  // namespace smi
+}  // namespace amd
+
+namespace {
+
+using amd::smi::DrmFdinfo;
+using amd::smi::GpuUsage;
+
+/* A DRM fd of a process, and the inode it was open on */
+struct DrmFd {
+	std::string fd;
+	dev_t dev = 0;
+	ino_t ino = 0;
+};
+
+struct ProcessEntry {
+	/* Start time of the process, tells a reused pid apart */
+	uint64_t start_time = 0;
+	/* DRM fds found by the last walk of /proc/<pid>/fd */
+	std::vector<DrmFd> drm_fds;
+	/*
+	 * Size of /proc/<pid>/fd at that walk (its fd count), and its mtime,
+	 * which only changes in a synthetic tree; -1 if never walked
+	 */
+	off_t fd_dir_size = -1;
+	struct timespec fd_dir_mtime = {};
+	std::chrono::steady_clock::time_point fd_dir_time;
+	/* Name and container are read once per process */
+	bool has_names = false;
+	std::string name;
+	std::string container_name;
+	/* Usage found by the last pass, by GPU bdf */
+	std::map<std::string, GpuUsage> usage_by_bdf;
+};
+
+/* Field 22 of /proc/<pid>/stat; 0 if it cannot be read */
+uint64_t read_start_time(int proc_fd, long int pid)
 {
-	char bdf_str[13];
-	DIR *d;
-	struct dirent *dir;
+	char path[32];
+	char buf[kProcFileBufferSize];
 
-	/* 0000:00:00.0 */
-	snprintf(bdf_str, 13, "%04x:%02x:%02x.%d",
-            bdf.domain_number & 0xffff,
-			bdf.bus_number & 0xff,
-			bdf.device_number & 0x1f,
-			bdf.function_number & 0x7);
+	snprintf(path, sizeof(path), "%ld/stat", pid);
+	if (read_proc_file(proc_fd, path, buf, sizeof(buf)) <= 0)
+		return 0;
 
+	/* The name (field 2) may hold spaces and parentheses, skip past it */
+	char *p = strrchr(buf, ')');
+	if (!p)
+		return 0;
+	for (int field = 2; field < 22 && p; field++)
+		p = strchr(p + 1, ' ');
 
-	std::string path = "/proc/" + std::to_string(pid) + "/fdinfo/";
-	std::string name_path = "/proc/" + std::to_string(pid) + "/comm";
-	std::string cgroup_path = "/proc/" + std::to_string(pid) + "/cgroup";
+	return p ? strtoull(p + 1, nullptr, 10) : 0;
+}
+
+/*
+ * Gets the inode an fd of /proc/<pid>/fd is open on. A dangling link (only
+ * seen in a synthetic tree) is identified by the link itself.
+ */
+bool fd_inode(int proc_fd, const char *path, dev_t &dev, ino_t &ino)
+{
+	struct stat st;
+	if (fstatat(proc_fd, path, &st, 0) != 0 &&
+	    fstatat(proc_fd, path, &st, AT_SYMLINK_NOFOLLOW) != 0)
+		return false;
+	dev = st.st_dev;
+	ino = st.st_ino;
+
+	return true;
+}
 
-	if (gpuvsmi_pid_is_gpu(path.c_str(), bdf_str)) {
-		return AMDSMI_STATUS_INVAL;
+/*
+ * Keeps the DRM usage of all the processes, refreshed by one pass over
+ * /proc that is shared by all the GPUs.
+ *
+ * Every process is kept with the DRM fds found in its fd directory, keyed
+ * by fd and inode. A pass reads the start time of each process and stats
+ * its fd directory; the directory is only walked again, with one readlink
+ * per fd, when the pid was reused, its fd count (the size of
+ * /proc/<pid>/fd) or mtime changed, a known DRM fd no longer points to the same
+ * inode, or kFdDirMaxAge has passed. Otherwise only the fdinfo of the
+ * known DRM fds is read and parsed, with a fixed buffer. The fds of a
+ * process are summed per DRM client, and its engine counters are compared
+ * with the previous pass to get busy percents. The name and container of
+ * a process are read once, and kept until its pid is reused.
+ */
+class FdinfoScanner {
+ public:
+	static FdinfoScanner& getInstance()
+	{
+		static FdinfoScanner instance;
+		return instance;
 	}
 
-	d = opendir(path.c_str());
-	if (!d)
-		return AMDSMI_STATUS_NO_PERM;
+	amdsmi_status_t get_pids(const char *bdf, std::vector<long int> &pids)
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		amdsmi_status_t ret = scan_if_stale();
+		if (ret != AMDSMI_STATUS_SUCCESS)
+			return ret;
+
+		pids.clear();
+		for (const auto &process : processes_) {
+			if (process.second.usage_by_bdf.count(bdf))
+				pids.push_back(process.first);
+		}
 
-	/* Vectors to check if repated fd pasid */
-	std::vector<int> pasids;
+		return AMDSMI_STATUS_SUCCESS;
+	}
 
-	memset(&info, 0, sizeof(info));
-	/* Iterate through all fdinfos */
-	while ((dir = readdir(d)) != NULL) {
+	amdsmi_status_t get_pid_info(const char *bdf, long int pid, amdsmi_proc_info_t &info)
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		amdsmi_status_t ret = scan_if_stale();
+		if (ret != AMDSMI_STATUS_SUCCESS)
+			return ret;
+
+		auto process = processes_.find(pid);
+		if (process == processes_.end())
+			return AMDSMI_STATUS_INVAL;
+		auto usage = process->second.usage_by_bdf.find(bdf);
+		if (usage == process->second.usage_by_bdf.end())
+			return AMDSMI_STATUS_INVAL;
+
+		const GpuUsage &gpu_usage = usage->second;
+		auto memory_total = [&gpu_usage](const char *name) {
+			auto region = find_named(gpu_usage.memory_regions, gpu_usage.num_memory_regions, name);
+			return region ? region->total : 0;
+		};
+		auto engine_busy_ns = [&gpu_usage](const char *name) {
+			auto engine = find_named(gpu_usage.engines, gpu_usage.num_engines, name);
+			return engine ? engine->busy_ns : 0;
+		};
+
+		memset(&info, 0, sizeof(info));
+		info.memory_usage.gtt_mem = memory_total("gtt");
+		info.memory_usage.cpu_mem = memory_total("cpu");
+		info.memory_usage.vram_mem = memory_total("vram");
+		info.mem = info.memory_usage.gtt_mem + info.memory_usage.cpu_mem +
+			   info.memory_usage.vram_mem;
+		info.engine_usage.gfx = engine_busy_ns("gfx");
+		info.engine_usage.enc = engine_busy_ns("enc");
+
+		//  Note: If possible at all, try to get the name of the process/container.
+		//        In case the other info fail, get at least something.
+		ProcessEntry &entry = process->second;
+		if (!entry.has_names) {
+			read_names(pid, entry);
+		}
+		if (entry.name.empty())
+			return AMDSMI_STATUS_API_FAILED;
 
-		std::string file = path + dir->d_name;
-		std::ifstream fdinfo(file.c_str());
+		strncpy(info.name, entry.name.c_str(), std::min(
+					(unsigned long) AMDSMI_NORMAL_STRING_LENGTH,
+					entry.name.length()));
+		strncpy(info.container_name, entry.container_name.c_str(),
+				sizeof(info.container_name) - 1);
+		info.pid = (uint32_t)pid;
 
-		for (std::string bdfline; getline(fdinfo, bdfline);) {
-			if (bdfline.find("drm-pdev:") != std::string::npos) {
-				char fd_bdf_str[13];
+		if (!gpu_usage.pasids.size())
+			return AMDSMI_STATUS_NOT_FOUND;
 
-				/* Only check against fdinfo files that contain a bdf */
-				if (sscanf(bdfline.c_str(), "drm-pdev:       %s", &fd_bdf_str) != 1)
-					continue;
+		return AMDSMI_STATUS_SUCCESS;
+	}
 
-				/* Populate amdsmi_proc_info_t struct only if the bdf in
-				* the fdinfo file matches the passed bdf */
-				if (strncmp(bdf_str, fd_bdf_str, 13) == 0){
-					std::ifstream fdinfo(file.c_str());
+	amdsmi_status_t get_drm_usage(const char *bdf, std::vector<amdsmi_proc_drm_usage_t> &usage)
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		amdsmi_status_t ret = scan_if_stale();
+		if (ret != AMDSMI_STATUS_SUCCESS)
+			return ret;
+
+		usage.clear();
+		for (auto &process : processes_) {
+			auto gpu_usage = process.second.usage_by_bdf.find(bdf);
+			if (gpu_usage == process.second.usage_by_bdf.end())
+				continue;
 
-					for (std::string line; getline(fdinfo, line);) {
-						if (line.find("pasid:") != std::string::npos) {
-							int pasid;
+			ProcessEntry &entry = process.second;
+			if (!entry.has_names)
+				read_names(process.first, entry);
+
+			amdsmi_proc_drm_usage_t proc_usage = {};
+			proc_usage.pid = static_cast<amdsmi_process_handle_t>(process.first);
+			proc_usage.num_clients = gpu_usage->second.num_clients;
+			proc_usage.interval_ns = gpu_usage->second.interval_ns;
+			strncpy(proc_usage.container_name, entry.container_name.c_str(),
+					sizeof(proc_usage.container_name) - 1);
+			proc_usage.num_engines = gpu_usage->second.num_engines;
+			std::copy_n(gpu_usage->second.engines, proc_usage.num_engines, proc_usage.engines);
+			proc_usage.num_memory_regions = gpu_usage->second.num_memory_regions;
+			std::copy_n(gpu_usage->second.memory_regions, proc_usage.num_memory_regions,
+					proc_usage.memory_regions);
+			usage.push_back(proc_usage);
+		}
 
-							if (sscanf(line.c_str(), "pasid:  %d", &pasid) != 1)
-								continue;
+		return AMDSMI_STATUS_SUCCESS;
+	}
 
-							auto it = std::find(pasids.begin(), pasids.end(), pasid);
+ private:
+	FdinfoScanner() = default;
+
+	amdsmi_status_t scan_if_stale()
+	{
+		auto now = std::chrono::steady_clock::now();
+		if (has_scanned_ && (now - last_scan_time_) < kFdinfoScanMaxAge)
+			return AMDSMI_STATUS_SUCCESS;
+
+		int proc_fd = open(amd::smi::FsPath("/proc").c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (proc_fd < 0)
+			return AMDSMI_STATUS_NO_PERM;
+		DIR *d = fdopendir(proc_fd);
+		if (!d) {
+			close(proc_fd);
+			return AMDSMI_STATUS_NO_PERM;
+		}
 
-							if (it == pasids.end())
-								pasids.push_back(pasid);
-						} else if (line.find("drm-memory-gtt:") != std::string::npos) {
-							unsigned long mem;
+		/* Processes that are gone are dropped */
+		std::map<long int, ProcessEntry> previous;
+		previous.swap(processes_);
 
-							if (sscanf(line.c_str(), "drm-memory-gtt:  %lu", &mem) != 1)
-								continue;
+		struct dirent *dir;
+		while ((dir = readdir(d)) != NULL) {
+			if (dir->d_type != DT_DIR)
+				continue;
 
-							info.mem += mem * 1024;
-							info.memory_usage.gtt_mem += mem * 1024;
-						} else if (line.find("drm-memory-cpu:") != std::string::npos) {
-							unsigned long mem;
+			/* Try to cast the name of the folder to a
+			* number, if it fails, it is not */
+			char *p;
+			long int pid = strtol(dir->d_name, &p, 10);
+			if (*p != 0)
+				continue;
 
-							if (sscanf(line.c_str(), "drm-memory-cpu:  %lu", &mem) != 1)
-								continue;
+			ProcessEntry entry;
+			auto known = previous.find(pid);
+			if (known != previous.end())
+				entry = std::move(known->second);
+			if (scan_process(proc_fd, pid, now, entry))
+				processes_.emplace(pid, std::move(entry));
+		}
+		closedir(d);
 
-							info.mem += mem * 1024;
-							info.memory_usage.cpu_mem += mem * 1024;
-						} else if (line.find("drm-memory-vram:") != std::string::npos) {
-							unsigned long mem;
+		last_scan_time_ = now;
+		has_scanned_ = true;
 
-							if (sscanf(line.c_str(), "drm-memory-vram:  %lu", &mem) != 1)
-								continue;
+		return AMDSMI_STATUS_SUCCESS;
+	}
 
-							info.mem += mem * 1024;
-							info.memory_usage.vram_mem += mem * 1024;
-						} else if (line.find("drm-engine-gfx") != std::string::npos) {
-							uint64_t engine_gfx;
+	/* Returns false if the process is gone */
+	bool scan_process(int proc_fd, long int pid,
+			  std::chrono::steady_clock::time_point scan_time, ProcessEntry &entry)
+	{
+		char path[64 + NAME_MAX];
+		char buf[kProcFileBufferSize];
+
+		/* Kept to turn the engine counters into busy percents */
+		std::map<std::string, GpuUsage> previous_usage;
+		previous_usage.swap(entry.usage_by_bdf);
+
+		uint64_t start_time = read_start_time(proc_fd, pid);
+		if (start_time == 0)
+			return false;
+		if (start_time != entry.start_time) {
+			entry = ProcessEntry();
+			entry.start_time = start_time;
+			previous_usage.clear();
+		}
 
-							if (sscanf(line.c_str(), "drm-engine-gfx:  %lu", &engine_gfx) != 1)
-								continue;
+		struct stat st;
+		snprintf(path, sizeof(path), "%ld/fd", pid);
+		if (fstatat(proc_fd, path, &st, 0) != 0)
+			return false;
+
+		/* Kernels before 6.2 report a size of 0, their fd count is unknown */
+		bool walk = entry.fd_dir_size < 0 || st.st_size == 0 ||
+			    st.st_size != entry.fd_dir_size ||
+			    st.st_mtim.tv_sec != entry.fd_dir_mtime.tv_sec ||
+			    st.st_mtim.tv_nsec != entry.fd_dir_mtime.tv_nsec ||
+			    scan_time - entry.fd_dir_time >= kFdDirMaxAge;
+		for (size_t i = 0; i < entry.drm_fds.size() && !walk; i++) {
+			const DrmFd &drm_fd = entry.drm_fds[i];
+			dev_t dev;
+			ino_t ino;
+			snprintf(path, sizeof(path), "%ld/fd/%s", pid, drm_fd.fd.c_str());
+			walk = !fd_inode(proc_fd, path, dev, ino) ||
+			       dev != drm_fd.dev || ino != drm_fd.ino;
+		}
+		if (walk) {
+			entry.fd_dir_size = st.st_size;
+			entry.fd_dir_mtime = st.st_mtim;
+			entry.fd_dir_time = scan_time;
+			find_drm_fds(proc_fd, pid, entry.drm_fds);
+		}
 
-							info.engine_usage.gfx = engine_gfx;
-						} else if (line.find("drm-engine-enc") != std::string::npos) {
-							uint64_t engine_enc;
+		for (const DrmFd &drm_fd : entry.drm_fds) {
+			snprintf(path, sizeof(path), "%ld/fdinfo/%s", pid, drm_fd.fd.c_str());
+			if (read_proc_file(proc_fd, path, buf, sizeof(buf)) <= 0) {
+				/* Closed since the walk */
+				entry.fd_dir_size = -1;
+				continue;
+			}
 
-							if (sscanf(line.c_str(), "drm-engine-enc:  %lu", &engine_enc) != 1)
-								continue;
+			DrmFdinfo fdinfo;
+			parse_drm_fdinfo(buf, fdinfo);
+			if (!fdinfo.pdev)
+				continue;
 
-							info.engine_usage.enc = engine_enc;
-						}
-					}
-				}
+			auto usage = entry.usage_by_bdf.find(fdinfo.pdev);
+			if (usage == entry.usage_by_bdf.end()) {
+				usage = entry.usage_by_bdf.emplace(fdinfo.pdev, GpuUsage()).first;
+				usage->second.scan_time = scan_time;
 			}
+			add_drm_fdinfo(fdinfo, usage->second);
+		}
+
+		for (auto &usage : entry.usage_by_bdf) {
+			auto previous = previous_usage.find(usage.first);
+			if (previous != previous_usage.end())
+				update_busy_percent(previous->second, usage.second);
 		}
+
+		return true;
 	}
 
-	closedir(d);
+	/*
+	 * Walks /proc/<pid>/fd, with one readlink per fd, for the fds that
+	 * link to a DRM node. An unreadable directory (a process of another
+	 * user) has none.
+	 */
+	void find_drm_fds(int proc_fd, long int pid, std::vector<DrmFd> &drm_fds)
+	{
+		char path[64 + NAME_MAX];
+		char link[PATH_MAX];
+
+		drm_fds.clear();
+		snprintf(path, sizeof(path), "%ld/fd", pid);
+		int fd_dir_fd = openat(proc_fd, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (fd_dir_fd < 0)
+			return;
+		DIR *d = fdopendir(fd_dir_fd);
+		if (!d) {
+			close(fd_dir_fd);
+			return;
+		}
 
-  //  Note: If possible at all, try to get the name of the process/container.
-  //        In case the other info fail, get at least something.
-	std::ifstream filename(name_path.c_str());
-	std::string name;
+		struct dirent *dir;
+		while ((dir = readdir(d)) != NULL) {
+			if (dir->d_name[0] == '.')
+				continue;
 
-	getline(filename, name);
+			ssize_t len = readlinkat(fd_dir_fd, dir->d_name, link, sizeof(link) - 1);
+			if (len <= 0)
+				continue;
+			link[len] = '\0';
 
-	if (name.empty())
-		return AMDSMI_STATUS_API_FAILED;
+			bool is_drm = false;
+			for (const char *node_name : drm_node_names) {
+				if (strstr(link, node_name)) {
+					is_drm = true;
+					break;
+				}
+			}
+			if (!is_drm)
+				continue;
 
-	strncpy(info.name, name.c_str(), std::min(
-				(unsigned long) AMDSMI_NORMAL_STRING_LENGTH,
-				name.length()));
+			DrmFd drm_fd;
+			drm_fd.fd = dir->d_name;
+			if (!fd_inode(fd_dir_fd, dir->d_name, drm_fd.dev, drm_fd.ino))
+				continue;
+			drm_fds.push_back(std::move(drm_fd));
+		}
+		closedir(d);
+	}
+
+	void read_names(long int pid, ProcessEntry &entry)
+	{
+		std::string name_path = amd::smi::FsPath("/proc/") + std::to_string(pid) + "/comm";
+		std::string cgroup_path = amd::smi::FsPath("/proc/") + std::to_string(pid) + "/cgroup";
 
-	for (int i = 0; i < AMDSMI_MAX_CONTAINER_TYPE; i++) {
+		std::ifstream filename(name_path.c_str());
+		entry.name.clear();
+		getline(filename, entry.name);
+
+		entry.container_name.clear();
 		std::ifstream cgroup_info(cgroup_path.c_str());
-		std::string container_id;
-		for (std::string line; getline(cgroup_info, line);) {
-			if (line.find(container_type_name[i]) != std::string::npos) {
-				container_id = line.substr(line.find(container_type_name[i]) +
-						strlen(container_type_name[i]) + 1, 16);
-				strcpy(info.container_name, container_id.c_str());
-				break;
+		std::vector<std::string> cgroup_lines;
+		for (std::string line; getline(cgroup_info, line);)
+			cgroup_lines.push_back(line);
+		for (int i = 0; i < AMDSMI_MAX_CONTAINER_TYPE && entry.container_name.empty(); i++) {
+			for (const auto &line : cgroup_lines) {
+				auto pos = line.find(container_type_name[i]);
+				if (pos != std::string::npos) {
+					entry.container_name = line.substr(pos +
+							strlen(container_type_name[i]) + 1, 16);
+					break;
+				}
 			}
 		}
-		if (strlen(info.container_name) > 0)
-			break;
+
+		/* A process still starting up may not have its name yet */
+		entry.has_names = !entry.name.empty();
 	}
-	info.pid = (uint32_t)pid;
 
-	if (!pasids.size()) {
-		return AMDSMI_STATUS_NOT_FOUND;
-  }
+	std::mutex mutex_;
+	std::map<long int, ProcessEntry> processes_;
+	std::chrono::steady_clock::time_point last_scan_time_;
+	bool has_scanned_ = false;
+};
+
+/* 0000:00:00.0 */
+void format_bdf(const amdsmi_bdf_t &bdf, char (&bdf_str)[13])
+{
+	snprintf(bdf_str, sizeof(bdf_str), "%04x:%02x:%02x.%d",
+			bdf.domain_number & 0xffff,
+			bdf.bus_number & 0xff,
+			bdf.device_number & 0x1f,
+			bdf.function_number & 0x7);
+}
 
+}  // namespace
+
+extern "C" {
+
+amdsmi_status_t gpuvsmi_get_pids(const amdsmi_bdf_t &bdf, std::vector<long int> &pids, uint64_t *size)
+{
+	char bdf_str[13];
+	format_bdf(bdf, bdf_str);
+
+	amdsmi_status_t ret = FdinfoScanner::getInstance().get_pids(bdf_str, pids);
+	if (ret != AMDSMI_STATUS_SUCCESS)
+		return ret;
+
+	*size = pids.size();
 	return AMDSMI_STATUS_SUCCESS;
 }
 
+amdsmi_status_t gpuvsmi_get_pid_info(const amdsmi_bdf_t &bdf, long int pid,
+		amdsmi_proc_info_t &info)
+{
+	char bdf_str[13];
+	format_bdf(bdf, bdf_str);
+
+	return FdinfoScanner::getInstance().get_pid_info(bdf_str, pid, info);
+}
+
+amdsmi_status_t gpuvsmi_get_drm_usage(const amdsmi_bdf_t &bdf,
+		std::vector<amdsmi_proc_drm_usage_t> &usage)
+{
+	char bdf_str[13];
+	format_bdf(bdf, bdf_str);
+
+	return FdinfoScanner::getInstance().get_drm_usage(bdf_str, usage);
+}
+
 
 } // extern "C"
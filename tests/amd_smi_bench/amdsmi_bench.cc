@@ -0,0 +1,781 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+/**
+ *  Microbenchmarks of the API calls that exporters make on every scrape,
+ *  and of the internal parsers behind them.
+ *
+ *  Besides the time per call, each benchmark reports per iteration:
+ *    - allocs:   operator new calls made by the benchmarking thread
+ *    - syscalls: read and write syscalls of the benchmarking thread, taken
+ *                from /proc/thread-self/io (syscr + syscw)
+ *
+ *  Run it against a synthetic tree to be hardware independent:
+ *    python3 tools/fake_sysfs_tree.py -o /tmp/fake_root --gpus 8 --procs 2000
+ *    RSMI_FS_ROOT=/tmp/fake_root amdsmi_bench --benchmark_format=json
+ *  or build the "run_amdsmi_bench" target, which does both and writes
+ *  amdsmi_bench.json in the build directory. Calls that need a DRM node
+ *  (power, clock and VRAM info) are reported as errors on such a tree,
+ *  unless AMDSMI_LIBDRM_PATH names the fake libdrm of tests/fake_libdrm
+ *  (as run_amdsmi_bench does), which answers the VRAM queries.
+ */
+
+#include <benchmark/benchmark.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "amd_smi/amdsmi.h"
+#include "rocm_smi/rocm_smi.h"
+#include "rocm_smi/rocm_smi_binary_parser.h"
+#include "rocm_smi/rocm_smi_gpu_metrics.h"
+
+// Internal entry points of the library, not part of any public header
+namespace amd::smi {
+uint64_t freq_string_to_int(const std::vector<std::string> &freq_lines,
+                            bool *is_curr, uint32_t lanes[], uint32_t i);
+}  // namespace amd::smi
+rsmi_status_t rsmi_test_event_notification_fd_set(uint32_t dv_ind, int fd);
+
+namespace {
+
+thread_local uint64_t tls_alloc_count = 0;
+
+uint64_t syscall_count() {
+  uint64_t syscr = 0;
+  uint64_t syscw = 0;
+  FILE *f = fopen("/proc/thread-self/io", "r");
+  if (f == nullptr) {
+    return 0;
+  }
+  char line[128];
+  while (fgets(line, sizeof(line), f) != nullptr) {
+    sscanf(line, "syscr: %lu", &syscr);
+    sscanf(line, "syscw: %lu", &syscw);
+  }
+  fclose(f);
+  return syscr + syscw;
+}
+
+// Reading the counters costs syscalls of its own; measured once in main()
+uint64_t syscall_count_overhead = 0;
+
+/**
+ *  Counts allocations and syscalls between its construction and report(),
+ *  which adds them to the benchmark as per iteration averages.
+ */
+class CallCounter {
+ public:
+  CallCounter() : allocs_(tls_alloc_count), syscalls_(syscall_count()) {}
+
+  void report(benchmark::State &state) {
+    uint64_t syscalls = syscall_count() - syscalls_;
+    syscalls = syscalls > syscall_count_overhead ?
+               syscalls - syscall_count_overhead : 0;
+    state.counters["allocs"] = benchmark::Counter(
+        static_cast<double>(tls_alloc_count - allocs_),
+        benchmark::Counter::kAvgIterations);
+    state.counters["syscalls"] = benchmark::Counter(
+        static_cast<double>(syscalls), benchmark::Counter::kAvgIterations);
+  }
+
+ private:
+  uint64_t allocs_;
+  uint64_t syscalls_;
+};
+
+const uint64_t kInitFlags = AMDSMI_INIT_AMD_GPUS;
+
+// The first GPU, looked up again by each benchmark since the handles do
+// not survive the init/shut_down benchmark
+amdsmi_processor_handle first_gpu() {
+  uint32_t socket_count = 1;
+  amdsmi_socket_handle socket = nullptr;
+  if (amdsmi_get_socket_handles(&socket_count, &socket) != AMDSMI_STATUS_SUCCESS ||
+      socket_count == 0) {
+    return nullptr;
+  }
+  uint32_t processor_count = 1;
+  amdsmi_processor_handle processor = nullptr;
+  if (amdsmi_get_processor_handles(socket, &processor_count, &processor)
+      != AMDSMI_STATUS_SUCCESS || processor_count == 0) {
+    return nullptr;
+  }
+  return processor;
+}
+
+// The rocm_smi device index of gpu, matched by PCI id
+bool rsmi_device_index(amdsmi_processor_handle gpu, uint32_t *dv_ind) {
+  uint64_t bdfid = 0;
+  uint32_t num_devices = 0;
+  if (amdsmi_get_gpu_bdf_id(gpu, &bdfid) != AMDSMI_STATUS_SUCCESS ||
+      rsmi_num_monitor_devices(&num_devices) != RSMI_STATUS_SUCCESS) {
+    return false;
+  }
+  for (uint32_t i = 0; i < num_devices; ++i) {
+    uint64_t dev_bdfid = 0;
+    if (rsmi_dev_pci_id_get(i, &dev_bdfid) == RSMI_STATUS_SUCCESS &&
+        dev_bdfid == bdfid) {
+      *dv_ind = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+void skip_with_status(benchmark::State &state, amdsmi_status_t status) {
+  const char *status_str = nullptr;
+  amdsmi_status_code_to_string(status, &status_str);
+  state.SkipWithError(status_str != nullptr ? status_str : "call failed");
+}
+
+/**
+ *  Times call(handle) on the first GPU. A call that fails on the first
+ *  iteration (e.g. no DRM node in a synthetic tree) skips the benchmark.
+ */
+template <typename Call>
+void run_gpu_call(benchmark::State &state, Call call) {
+  amdsmi_processor_handle gpu = first_gpu();
+  if (gpu == nullptr) {
+    state.SkipWithError("no GPU found");
+    return;
+  }
+  amdsmi_status_t status = call(gpu);
+  if (status != AMDSMI_STATUS_SUCCESS) {
+    skip_with_status(state, status);
+    return;
+  }
+
+  CallCounter counter;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(call(gpu));
+  }
+  counter.report(state);
+}
+
+void BM_amdsmi_init_shut_down(benchmark::State &state) {
+  CallCounter counter;
+  for (auto _ : state) {
+    amdsmi_shut_down();
+    if (amdsmi_init(kInitFlags) != AMDSMI_STATUS_SUCCESS) {
+      state.SkipWithError("amdsmi_init failed");
+      break;
+    }
+  }
+  counter.report(state);
+}
+BENCHMARK(BM_amdsmi_init_shut_down)->Unit(benchmark::kMillisecond);
+
+void BM_amdsmi_init_shut_down_lazy(benchmark::State &state) {
+  CallCounter counter;
+  for (auto _ : state) {
+    amdsmi_shut_down();
+    if (amdsmi_init(kInitFlags | AMDSMI_INIT_LAZY) != AMDSMI_STATUS_SUCCESS) {
+      state.SkipWithError("amdsmi_init failed");
+      break;
+    }
+  }
+  counter.report(state);
+  // Leave the library initialized the way the other benchmarks expect
+  amdsmi_shut_down();
+  amdsmi_init(kInitFlags);
+}
+BENCHMARK(BM_amdsmi_init_shut_down_lazy)->Unit(benchmark::kMillisecond);
+
+// Where the library keeps its discovery cache in this run
+std::string discovery_cache_path() {
+  const char *path = getenv("RSMI_DISCOVERY_CACHE_PATH");
+  if (path != nullptr) {
+    return path;
+  }
+  const char *fs_root = getenv("RSMI_FS_ROOT");
+  return std::string(fs_root != nullptr ? fs_root : "") +
+         "/run/amdsmi/discovery.cache";
+}
+
+// A warm-up init writes the cache (unless it is already current), and every
+// timed init must read it: a miss would rewrite the file under a new inode.
+void BM_amdsmi_init_shut_down_discovery_cache(benchmark::State &state) {
+  const std::string cache_path = discovery_cache_path();
+  amdsmi_shut_down();
+  if (amdsmi_init(kInitFlags | AMDSMI_INIT_DISCOVERY_CACHE) !=
+                                                      AMDSMI_STATUS_SUCCESS) {
+    state.SkipWithError("amdsmi_init failed");
+    amdsmi_init(kInitFlags);
+    return;
+  }
+  struct stat cache_stat;
+  if (stat(cache_path.c_str(), &cache_stat) != 0) {
+    state.SkipWithError("discovery cache was not written");
+    amdsmi_shut_down();
+    amdsmi_init(kInitFlags);
+    return;
+  }
+
+  CallCounter counter;
+  for (auto _ : state) {
+    amdsmi_shut_down();
+    if (amdsmi_init(kInitFlags | AMDSMI_INIT_DISCOVERY_CACHE) !=
+                                                      AMDSMI_STATUS_SUCCESS) {
+      state.SkipWithError("amdsmi_init failed");
+      break;
+    }
+  }
+  counter.report(state);
+  struct stat after_stat;
+  if (stat(cache_path.c_str(), &after_stat) != 0 ||
+      after_stat.st_ino != cache_stat.st_ino) {
+    state.SkipWithError("discovery cache was missed");
+  }
+  amdsmi_shut_down();
+  amdsmi_init(kInitFlags);
+}
+BENCHMARK(BM_amdsmi_init_shut_down_discovery_cache)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_amdsmi_get_gpu_metrics_info(benchmark::State &state) {
+  amdsmi_gpu_metrics_t metrics;
+  run_gpu_call(state, [&metrics](amdsmi_processor_handle gpu) {
+    return amdsmi_get_gpu_metrics_info(gpu, &metrics);
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_metrics_info)->Unit(benchmark::kMicrosecond);
+
+void BM_amdsmi_get_temp_metric(benchmark::State &state) {
+  int64_t temperature = 0;
+  run_gpu_call(state, [&temperature](amdsmi_processor_handle gpu) {
+    return amdsmi_get_temp_metric(gpu, AMDSMI_TEMPERATURE_TYPE_HOTSPOT,
+                                  AMDSMI_TEMP_CURRENT, &temperature);
+  });
+}
+BENCHMARK(BM_amdsmi_get_temp_metric)->Unit(benchmark::kMicrosecond);
+
+// Several threads reading the same GPU; getters take the device lock
+// shared, so they shouldn't serialize. No call counters, since syscalls
+// are counted per process.
+void BM_amdsmi_get_temp_metric_threads(benchmark::State &state) {
+  amdsmi_processor_handle gpu = first_gpu();
+  if (gpu == nullptr) {
+    state.SkipWithError("no GPU found");
+    return;
+  }
+  int64_t temperature = 0;
+  for (auto _ : state) {
+    amdsmi_status_t status = amdsmi_get_temp_metric(gpu,
+        AMDSMI_TEMPERATURE_TYPE_HOTSPOT, AMDSMI_TEMP_CURRENT, &temperature);
+    if (status != AMDSMI_STATUS_SUCCESS) {
+      skip_with_status(state, status);
+      break;
+    }
+    benchmark::DoNotOptimize(temperature);
+  }
+}
+BENCHMARK(BM_amdsmi_get_temp_metric_threads)->Unit(benchmark::kMicrosecond)
+    ->ThreadRange(1, 8)->UseRealTime();
+
+void BM_amdsmi_get_power_info(benchmark::State &state) {
+  amdsmi_power_info_t info;
+  run_gpu_call(state, [&info](amdsmi_processor_handle gpu) {
+    return amdsmi_get_power_info(gpu, &info);
+  });
+}
+BENCHMARK(BM_amdsmi_get_power_info)->Unit(benchmark::kMicrosecond);
+
+void BM_amdsmi_get_clock_info(benchmark::State &state) {
+  amdsmi_clk_info_t info;
+  run_gpu_call(state, [&info](amdsmi_processor_handle gpu) {
+    return amdsmi_get_clock_info(gpu, AMDSMI_CLK_TYPE_GFX, &info);
+  });
+}
+BENCHMARK(BM_amdsmi_get_clock_info)->Unit(benchmark::kMicrosecond);
+
+void BM_amdsmi_get_gpu_activity(benchmark::State &state) {
+  amdsmi_engine_usage_t info;
+  run_gpu_call(state, [&info](amdsmi_processor_handle gpu) {
+    return amdsmi_get_gpu_activity(gpu, &info);
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_activity)->Unit(benchmark::kMicrosecond);
+
+void BM_amdsmi_get_gpu_process_list(benchmark::State &state) {
+  std::vector<amdsmi_proc_info_t> list(4096);
+  run_gpu_call(state, [&list](amdsmi_processor_handle gpu) {
+    uint32_t max_processes = static_cast<uint32_t>(list.size());
+    return amdsmi_get_gpu_process_list(gpu, &max_processes, list.data());
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_process_list)->Unit(benchmark::kMicrosecond);
+
+void BM_amdsmi_get_gpu_vram_usage(benchmark::State &state) {
+  amdsmi_vram_usage_t info;
+  run_gpu_call(state, [&info](amdsmi_processor_handle gpu) {
+    return amdsmi_get_gpu_vram_usage(gpu, &info);
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_vram_usage)->Unit(benchmark::kMicrosecond);
+
+void BM_amdsmi_get_gpu_memory_usage_info(benchmark::State &state) {
+  amdsmi_gpu_memory_usage_t info;
+  run_gpu_call(state, [&info](amdsmi_processor_handle gpu) {
+    return amdsmi_get_gpu_memory_usage_info(gpu, &info);
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_memory_usage_info)->Unit(benchmark::kMicrosecond);
+
+// A memory poller per GPU; DRM queries take no library-wide lock, so the
+// threads shouldn't convoy
+void BM_amdsmi_get_gpu_memory_usage_info_threads(benchmark::State &state) {
+  uint32_t socket_count = 0;
+  amdsmi_get_socket_handles(&socket_count, nullptr);
+  std::vector<amdsmi_socket_handle> sockets(socket_count);
+  amdsmi_get_socket_handles(&socket_count, sockets.data());
+  if (socket_count == 0) {
+    state.SkipWithError("no GPU found");
+    return;
+  }
+  uint32_t processor_count = 1;
+  amdsmi_processor_handle gpu = nullptr;
+  amdsmi_status_t status = amdsmi_get_processor_handles(
+      sockets[state.thread_index() % socket_count], &processor_count, &gpu);
+  if (status != AMDSMI_STATUS_SUCCESS || gpu == nullptr) {
+    state.SkipWithError("no GPU found");
+    return;
+  }
+  amdsmi_gpu_memory_usage_t info;
+  for (auto _ : state) {
+    status = amdsmi_get_gpu_memory_usage_info(gpu, &info);
+    if (status != AMDSMI_STATUS_SUCCESS) {
+      skip_with_status(state, status);
+      break;
+    }
+    benchmark::DoNotOptimize(info);
+  }
+}
+BENCHMARK(BM_amdsmi_get_gpu_memory_usage_info_threads)
+    ->Unit(benchmark::kMicrosecond)->ThreadRange(1, 8)->UseRealTime();
+
+// The ECC totals the way amdsmi_get_gpu_total_ecc_count() used to gather
+// them: a feature mask check and a counter read for every block
+void BM_amdsmi_get_gpu_ecc_count_per_block(benchmark::State &state) {
+  run_gpu_call(state, [](amdsmi_processor_handle gpu) {
+    amdsmi_error_count_t total = {};
+    for (auto block = AMDSMI_GPU_BLOCK_FIRST; block <= AMDSMI_GPU_BLOCK_LAST;
+         block = static_cast<amdsmi_gpu_block_t>(block * 2)) {
+      amdsmi_ras_err_state_t ras_state = AMDSMI_RAS_ERR_STATE_INVALID;
+      amdsmi_error_count_t ec = {};
+      if (amdsmi_get_gpu_ecc_status(gpu, block, &ras_state) == AMDSMI_STATUS_SUCCESS &&
+          ras_state == AMDSMI_RAS_ERR_STATE_ENABLED &&
+          amdsmi_get_gpu_ecc_count(gpu, block, &ec) == AMDSMI_STATUS_SUCCESS) {
+        total.correctable_count += ec.correctable_count;
+        total.uncorrectable_count += ec.uncorrectable_count;
+        total.deferred_count += ec.deferred_count;
+      }
+    }
+    benchmark::DoNotOptimize(total);
+    return AMDSMI_STATUS_SUCCESS;
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_ecc_count_per_block)->Unit(benchmark::kMicrosecond);
+
+void BM_amdsmi_get_gpu_ecc_count_all(benchmark::State &state) {
+  amdsmi_gpu_block_error_count_t counts[64];
+  run_gpu_call(state, [&counts](amdsmi_processor_handle gpu) {
+    uint32_t num_blocks = sizeof(counts) / sizeof(counts[0]);
+    return amdsmi_get_gpu_ecc_count_all(gpu, &num_blocks, counts);
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_ecc_count_all)->Unit(benchmark::kMicrosecond);
+
+void BM_amdsmi_get_gpu_total_ecc_count(benchmark::State &state) {
+  amdsmi_error_count_t ec;
+  run_gpu_call(state, [&ec](amdsmi_processor_handle gpu) {
+    return amdsmi_get_gpu_total_ecc_count(gpu, &ec);
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_total_ecc_count)->Unit(benchmark::kMicrosecond);
+
+// pm_metrics and reg_state, as allocated by the library for each call,
+// then into caller storage, then only the values that changed
+void BM_amdsmi_get_gpu_pm_metrics_info(benchmark::State &state) {
+  run_gpu_call(state, [](amdsmi_processor_handle gpu) {
+    amdsmi_name_value_t *kv = nullptr;
+    uint32_t num = 0;
+    amdsmi_status_t ret = amdsmi_get_gpu_pm_metrics_info(gpu, &kv, &num);
+    amdsmi_free_name_value_pairs(kv);
+    return ret;
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_pm_metrics_info)->Unit(benchmark::kMicrosecond);
+
+void BM_amdsmi_get_gpu_pm_metrics_values(benchmark::State &state) {
+  std::vector<amdsmi_name_value_t> kv(512);
+  run_gpu_call(state, [&kv](amdsmi_processor_handle gpu) {
+    uint32_t num = static_cast<uint32_t>(kv.size());
+    return amdsmi_get_gpu_pm_metrics_values(gpu, kv.data(), &num);
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_pm_metrics_values)->Unit(benchmark::kMicrosecond);
+
+void BM_amdsmi_get_gpu_reg_table_info(benchmark::State &state) {
+  run_gpu_call(state, [](amdsmi_processor_handle gpu) {
+    amdsmi_name_value_t *kv = nullptr;
+    uint32_t num = 0;
+    amdsmi_status_t ret =
+        amdsmi_get_gpu_reg_table_info(gpu, AMDSMI_REG_XGMI, &kv, &num);
+    amdsmi_free_name_value_pairs(kv);
+    return ret;
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_reg_table_info)->Unit(benchmark::kMicrosecond);
+
+void BM_amdsmi_get_gpu_reg_table_values(benchmark::State &state) {
+  std::vector<amdsmi_name_value_t> kv(512);
+  run_gpu_call(state, [&kv](amdsmi_processor_handle gpu) {
+    uint32_t num = static_cast<uint32_t>(kv.size());
+    return amdsmi_get_gpu_reg_table_values(gpu, AMDSMI_REG_XGMI, kv.data(),
+                                           &num);
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_reg_table_values)->Unit(benchmark::kMicrosecond);
+
+void BM_amdsmi_get_gpu_reg_table_changes(benchmark::State &state) {
+  std::vector<amdsmi_name_value_t> kv(512);
+  run_gpu_call(state, [&kv](amdsmi_processor_handle gpu) {
+    uint32_t num = static_cast<uint32_t>(kv.size());
+    return amdsmi_get_gpu_reg_table_changes(gpu, AMDSMI_REG_XGMI, kv.data(),
+                                            &num);
+  });
+}
+BENCHMARK(BM_amdsmi_get_gpu_reg_table_changes)->Unit(benchmark::kMicrosecond);
+
+/**
+ *  Event records written to a pipe that stands in for the KFD event file of
+ *  the first GPU, then drained: the cost of parsing and delivering them.
+ */
+void BM_amdsmi_get_gpu_event_notification(benchmark::State &state) {
+  amdsmi_processor_handle gpu = first_gpu();
+  int fds[2];
+  if (gpu == nullptr || pipe(fds) != 0) {
+    state.SkipWithError("no GPU found");
+    return;
+  }
+  uint32_t dv_ind = 0;
+  if (!rsmi_device_index(gpu, &dv_ind)) {
+    close(fds[0]);
+    close(fds[1]);
+    state.SkipWithError("no rocm_smi index for the GPU");
+    return;
+  }
+  // Takes fds[0], and closes it on failure
+  if (rsmi_test_event_notification_fd_set(dv_ind, fds[0]) != RSMI_STATUS_SUCCESS) {
+    close(fds[1]);
+    state.SkipWithError("event notification setup failed");
+    return;
+  }
+
+  constexpr uint32_t kRecords = 32;
+  std::string recs;
+  for (uint32_t i = 0; i < kRecords; ++i) {
+    recs += "5 ring gfx_0.0.0 timeout\n";
+  }
+  amdsmi_evt_notification_data_t data[kRecords];
+
+  CallCounter counter;
+  for (auto _ : state) {
+    if (write(fds[1], recs.data(), recs.size()) !=
+        static_cast<ssize_t>(recs.size())) {
+      state.SkipWithError("write failed");
+      break;
+    }
+    uint32_t got = 0;
+    while (got < kRecords) {
+      uint32_t num_elem = kRecords;
+      if (amdsmi_get_gpu_event_notification(1000, &num_elem, data) !=
+          AMDSMI_STATUS_SUCCESS) {
+        break;
+      }
+      got += num_elem;
+    }
+    benchmark::DoNotOptimize(data);
+  }
+  counter.report(state);
+
+  amdsmi_stop_gpu_event_notification(gpu);
+  close(fds[1]);
+}
+BENCHMARK(BM_amdsmi_get_gpu_event_notification)->Unit(benchmark::kMicrosecond);
+
+#ifdef ENABLE_ESMI_LIB
+/**
+ *  Re-initializes the library with the CPUs for the duration of a CPU
+ *  benchmark. Build with BUILD_ESMI_STUB to run them without an AMD CPU.
+ */
+class CpuInit {
+ public:
+  CpuInit() {
+    amdsmi_shut_down();
+    ok_ = amdsmi_init(kInitFlags | AMDSMI_INIT_AMD_CPUS) == AMDSMI_STATUS_SUCCESS;
+  }
+  ~CpuInit() {
+    amdsmi_shut_down();
+    amdsmi_init(kInitFlags);
+  }
+  bool ok() const { return ok_; }
+
+ private:
+  bool ok_;
+};
+
+// Energy and boost limit of every core, one handle at a time
+void BM_amdsmi_get_cpu_core_energy_all(benchmark::State &state) {
+  CpuInit init;
+  uint32_t core_count = 0;
+  if (!init.ok() ||
+      amdsmi_get_cpucore_handles(&core_count, nullptr) != AMDSMI_STATUS_SUCCESS) {
+    state.SkipWithError("no AMD CPU found");
+    return;
+  }
+  std::vector<amdsmi_processor_handle> cores(core_count);
+  amdsmi_get_cpucore_handles(&core_count, cores.data());
+
+  CallCounter counter;
+  for (auto _ : state) {
+    for (amdsmi_processor_handle core : cores) {
+      uint64_t energy = 0;
+      uint32_t boostlimit = 0;
+      benchmark::DoNotOptimize(amdsmi_get_cpu_core_energy(core, &energy));
+      benchmark::DoNotOptimize(amdsmi_get_cpu_core_boostlimit(core, &boostlimit));
+    }
+  }
+  counter.report(state);
+}
+BENCHMARK(BM_amdsmi_get_cpu_core_energy_all)->Unit(benchmark::kMicrosecond);
+
+// Same values, plus the socket ones, from one snapshot call
+void BM_amdsmi_get_cpu_telemetry(benchmark::State &state) {
+  CpuInit init;
+  uint32_t socket_count = 0;
+  uint32_t core_count = 0;
+  if (!init.ok() || amdsmi_get_cpu_telemetry(nullptr, &socket_count, nullptr,
+                                             &core_count) != AMDSMI_STATUS_SUCCESS) {
+    state.SkipWithError("no AMD CPU found");
+    return;
+  }
+  std::vector<amdsmi_cpu_socket_telemetry_t> sockets(socket_count);
+  std::vector<amdsmi_cpu_core_telemetry_t> cores(core_count);
+
+  CallCounter counter;
+  for (auto _ : state) {
+    uint32_t num_sockets = socket_count;
+    uint32_t num_cores = core_count;
+    benchmark::DoNotOptimize(amdsmi_get_cpu_telemetry(sockets.data(), &num_sockets,
+                                                      cores.data(), &num_cores));
+  }
+  counter.report(state);
+}
+BENCHMARK(BM_amdsmi_get_cpu_telemetry)->Unit(benchmark::kMicrosecond);
+#endif
+
+void BM_freq_string_to_int(benchmark::State &state) {
+  const std::vector<std::string> freq_lines = {
+    "0: 500Mhz",
+    "1: 1200Mhz *",
+    "2: 1700Mhz",
+    "3: 2100Mhz",
+  };
+  CallCounter counter;
+  for (auto _ : state) {
+    bool is_curr = false;
+    for (uint32_t i = 0; i < freq_lines.size(); i++) {
+      benchmark::DoNotOptimize(
+          amd::smi::freq_string_to_int(freq_lines, &is_curr, nullptr, i));
+    }
+  }
+  counter.report(state);
+  state.SetItemsProcessed(state.iterations() * freq_lines.size());
+}
+BENCHMARK(BM_freq_string_to_int);
+
+void BM_freq_string_to_int_pcie(benchmark::State &state) {
+  const std::vector<std::string> freq_lines = {
+    "0: 2.5GT/s, x1 97Mhz",
+    "1: 32.0GT/s, x16 619Mhz *",
+  };
+  uint32_t lanes[2] = {};
+  CallCounter counter;
+  for (auto _ : state) {
+    bool is_curr = false;
+    for (uint32_t i = 0; i < freq_lines.size(); i++) {
+      benchmark::DoNotOptimize(
+          amd::smi::freq_string_to_int(freq_lines, &is_curr, lanes, i));
+    }
+  }
+  counter.report(state);
+  state.SetItemsProcessed(state.iterations() * freq_lines.size());
+}
+BENCHMARK(BM_freq_string_to_int_pcie);
+
+/**
+ *  populate_metrics_dynamic_tbl() of one gpu_metrics version, on a raw
+ *  table with a valid header and non zero fields.
+ */
+template <typename GpuMetrics_t, typename RawMetrics_t>
+void BM_populate_metrics_dynamic_tbl(benchmark::State &state) {
+  GpuMetrics_t gpu_metrics;
+  auto raw = static_cast<RawMetrics_t *>(gpu_metrics.get_metrics_table().get());
+  auto raw_bytes = reinterpret_cast<uint8_t *>(raw);
+  for (size_t i = sizeof(raw->m_common_header); i < sizeof(RawMetrics_t); i++) {
+    raw_bytes[i] = static_cast<uint8_t>(i);
+  }
+  raw->m_common_header.m_structure_size = sizeof(RawMetrics_t);
+  raw->m_common_header.m_format_revision = 1;
+  gpu_metrics.set_device_id(0);
+  gpu_metrics.set_partition_id(0);
+
+  CallCounter counter;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(gpu_metrics.populate_metrics_dynamic_tbl());
+  }
+  counter.report(state);
+}
+BENCHMARK_TEMPLATE(BM_populate_metrics_dynamic_tbl,
+                   amd::smi::GpuMetricsBase_v13_t, amd::smi::AMDGpuMetrics_v13_t);
+BENCHMARK_TEMPLATE(BM_populate_metrics_dynamic_tbl,
+                   amd::smi::GpuMetricsBase_v14_t, amd::smi::AMDGpuMetrics_v14_t);
+BENCHMARK_TEMPLATE(BM_populate_metrics_dynamic_tbl,
+                   amd::smi::GpuMetricsBase_v15_t, amd::smi::AMDGpuMetrics_v15_t);
+BENCHMARK_TEMPLATE(BM_populate_metrics_dynamic_tbl,
+                   amd::smi::GpuMetricsBase_v16_t, amd::smi::AMDGpuMetrics_v16_t);
+
+void BM_parse_pmmetric_table(benchmark::State &state) {
+  // A pm_metrics file of pmmetrics_version 4, decoded into caller storage
+  std::vector<uint8_t> buf(65536);
+  const uint32_t pmmetrics_version = 4;
+  memcpy(&buf[12], &pmmetrics_version, sizeof(pmmetrics_version));
+  for (size_t i = 16; i < buf.size(); i++) {
+    buf[i] = static_cast<uint8_t>(i);
+  }
+  amd::smi::MetricsTableDecoder decoder;
+  std::vector<rsmi_name_value_t> kv(512);
+
+  CallCounter counter;
+  for (auto _ : state) {
+    uint32_t kvnum = static_cast<uint32_t>(kv.size());
+    int ret = decoder.decode(buf.data(), buf.size(), kv.data(), &kvnum, false);
+    if (ret != 0) {
+      state.SkipWithError("MetricsTableDecoder::decode failed");
+      break;
+    }
+    benchmark::DoNotOptimize(kvnum);
+  }
+  counter.report(state);
+}
+BENCHMARK(BM_parse_pmmetric_table);
+
+}  // namespace
+
+// Count the allocations of the library as well, which resolves to these
+void *operator new(std::size_t size) {
+  tls_alloc_count++;
+  void *p = malloc(size != 0 ? size : 1);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void *p) noexcept {
+  free(p);
+}
+
+void operator delete[](void *p) noexcept {
+  free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+  free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+  free(p);
+}
+
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  uint64_t before = syscall_count();
+  syscall_count_overhead = syscall_count() - before;
+
+  const char *fs_root = getenv("RSMI_FS_ROOT");
+  benchmark::AddCustomContext("RSMI_FS_ROOT", fs_root != nullptr ? fs_root : "");
+
+  amdsmi_status_t status = amdsmi_init(kInitFlags);
+  if (status != AMDSMI_STATUS_SUCCESS) {
+    fprintf(stderr, "amdsmi_init failed (%d); set RSMI_FS_ROOT to a tree made "
+                    "by tools/fake_sysfs_tree.py to run without a GPU\n", status);
+    return 1;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  amdsmi_shut_down();
+  return 0;
+}
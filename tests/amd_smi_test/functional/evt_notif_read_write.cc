@@ -43,13 +43,17 @@
  *
  */
 
+#include <poll.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
+#include <unistd.h>
 
 #include <iostream>
 
 #include <gtest/gtest.h>
 #include "amd_smi/amdsmi.h"
+#include "rocm_smi/rocm_smi.h"
 #include "evt_notif_read_write.h"
 #include "../test_common.h"
 #include "../test_utils.h"
@@ -83,6 +87,77 @@ void TestEvtNotifReadWrite::Close() {
   TestBase::Close();
 }
 
+// Internal test entry point of rocm_smi, not declared in any header
+extern rsmi_status_t
+rsmi_test_event_notification_fd_set(uint32_t dv_ind, int fd);
+
+// The rocm_smi device index of processor_handle, matched by PCI id
+static bool RsmiDeviceIndex(amdsmi_processor_handle processor_handle,
+                                                           uint32_t *dv_ind) {
+  uint64_t bdfid = 0;
+  uint32_t num_devices = 0;
+  if (amdsmi_get_gpu_bdf_id(processor_handle, &bdfid) != AMDSMI_STATUS_SUCCESS ||
+      rsmi_num_monitor_devices(&num_devices) != RSMI_STATUS_SUCCESS) {
+    return false;
+  }
+  for (uint32_t i = 0; i < num_devices; ++i) {
+    uint64_t dev_bdfid = 0;
+    if (rsmi_dev_pci_id_get(i, &dev_bdfid) == RSMI_STATUS_SUCCESS &&
+        dev_bdfid == bdfid) {
+      *dv_ind = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Feed kernel-style event records through a pipe standing in for the KFD
+// event file of processor_handle, and check that they are parsed and that
+// the notification fd reports them as ready.
+static void CheckPipeEvents(amdsmi_processor_handle processor_handle) {
+  amdsmi_status_t ret;
+  uint32_t dv_ind = 0;
+  int fds[2];
+
+  ASSERT_TRUE(RsmiDeviceIndex(processor_handle, &dv_ind));
+  ASSERT_EQ(pipe(fds), 0);
+  ASSERT_EQ(rsmi_test_event_notification_fd_set(dv_ind, fds[0]),
+                                                        RSMI_STATUS_SUCCESS);
+
+  const char recs[] = "3 reset in progress\n"
+                      "garbage\n"
+                      "5 ring gfx_0.0.0 timeout\n";
+  ASSERT_EQ(write(fds[1], recs, sizeof(recs) - 1),
+                                       static_cast<ssize_t>(sizeof(recs) - 1));
+
+  int evt_fd = -1;
+  ret = amdsmi_get_gpu_event_notification_fd(&evt_fd);
+  ASSERT_EQ(ret, AMDSMI_STATUS_SUCCESS);
+  struct pollfd pfd = {evt_fd, POLLIN, 0};
+  EXPECT_EQ(poll(&pfd, 1, 1000), 1);
+
+  amdsmi_evt_notification_data_t data[4];
+  uint32_t num_elem = 4;
+  ret = amdsmi_get_gpu_event_notification(0, &num_elem, data);
+  ASSERT_EQ(ret, AMDSMI_STATUS_SUCCESS);
+  ASSERT_EQ(num_elem, 2u);
+  EXPECT_EQ(data[0].event, AMDSMI_EVT_NOTIF_GPU_PRE_RESET);
+  EXPECT_STREQ(data[0].message, "reset in progress");
+  EXPECT_EQ(data[1].event, AMDSMI_EVT_NOTIF_RING_HANG);
+  EXPECT_STREQ(data[1].message, "ring gfx_0.0.0 timeout");
+  EXPECT_EQ(data[0].processor_handle, processor_handle);
+
+  num_elem = 4;
+  ret = amdsmi_get_gpu_event_notification(0, &num_elem, data);
+  EXPECT_EQ(ret, AMDSMI_STATUS_NO_DATA);
+  EXPECT_EQ(poll(&pfd, 1, 0), 0);
+
+  // Closes fds[0]
+  ret = amdsmi_stop_gpu_event_notification(processor_handle);
+  EXPECT_EQ(ret, AMDSMI_STATUS_SUCCESS);
+  close(fds[1]);
+}
+
 void TestEvtNotifReadWrite::Run(void) {
   amdsmi_status_t ret;
   uint32_t dv_ind;
@@ -100,6 +175,8 @@ void TestEvtNotifReadWrite::Run(void) {
     return;
   }
 
+  CheckPipeEvents(processor_handles_[0]);
+
   amdsmi_evt_notification_type_t evt_type = AMDSMI_EVT_NOTIF_FIRST;
   uint64_t mask = AMDSMI_EVENT_MASK_FROM_INDEX(evt_type);
   while (evt_type <= AMDSMI_EVT_NOTIF_LAST) {
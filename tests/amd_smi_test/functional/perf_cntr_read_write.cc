@@ -344,6 +344,71 @@ TestPerfCntrReadWrite::testEventsSimultaneously(amdsmi_processor_handle dv_ind)
   }
 }
 
+void
+TestPerfCntrReadWrite::testEventsGrouped(amdsmi_processor_handle dv_ind) {
+  amdsmi_status_t ret;
+  uint32_t avail_counters;
+
+  IF_VERB(STANDARD) {
+    std::cout << "****************************" << std::endl;
+    std::cout << "Test grouped events (device "   <<
+                                                   dv_ind << ")" << std::endl;
+    std::cout << "****************************" << std::endl;
+  }
+
+  for (PerfCntrEvtGrp grp : s_event_groups) {
+    ret = amdsmi_gpu_counter_group_supported(dv_ind, grp.group());
+    if (ret == AMDSMI_STATUS_NOT_SUPPORTED) {
+      continue;
+    }
+    ret =  amdsmi_get_gpu_available_counters(dv_ind, grp.group(),
+                                                             &avail_counters);
+    CHK_ERR_ASRT(ret)
+
+    std::vector<amdsmi_event_type_t> types;
+    for (uint32_t evnt = grp.first_evt();
+             evnt <= grp.last_evt() && types.size() < avail_counters; ++evnt) {
+      types.push_back(static_cast<amdsmi_event_type_t>(evnt));
+    }
+    if (types.empty()) {
+      continue;
+    }
+
+    amdsmi_event_group_handle_t grp_handle;
+    ret = amdsmi_gpu_create_counter_group(dv_ind, types.data(),
+                        static_cast<uint32_t>(types.size()), &grp_handle);
+    CHK_ERR_ASRT(ret)
+
+    ret = amdsmi_gpu_control_counter_group(grp_handle, AMDSMI_CNTR_CMD_START);
+    CHK_ERR_ASRT(ret)
+
+    sleep(1);
+
+    std::vector<amdsmi_counter_value_t> vals(types.size());
+    ret = amdsmi_gpu_read_counter_group(grp_handle, vals.data(),
+                                      static_cast<uint32_t>(vals.size() - 1));
+    ASSERT_EQ(ret, AMDSMI_STATUS_INSUFFICIENT_SIZE);
+
+    ret = amdsmi_gpu_read_counter_group(grp_handle, vals.data(),
+                                          static_cast<uint32_t>(vals.size()));
+    CHK_ERR_ASRT(ret)
+
+    // Every counter of the group was sampled by the same read
+    for (size_t j = 0; j < vals.size(); ++j) {
+      IF_VERB(STANDARD) {
+        std::cout << "	Counter: " << types[j] << " Value: " <<
+                            vals[j].value << " Time Running: " <<
+                                         vals[j].time_running << std::endl;
+      }
+      ASSERT_EQ(vals[j].time_enabled, vals[0].time_enabled);
+      ASSERT_EQ(vals[j].time_running, vals[0].time_running);
+    }
+
+    ret = amdsmi_gpu_destroy_counter_group(grp_handle);
+    CHK_ERR_ASRT(ret)
+  }
+}
+
 void TestPerfCntrReadWrite::Run(void) {
   TestBase::Run();
   if (setup_failed_) {
@@ -357,6 +422,7 @@ void TestPerfCntrReadWrite::Run(void) {
     try {
       testEventsIndividually(dev_handle);
       testEventsSimultaneously(dev_handle);
+      testEventsGrouped(dev_handle);
     } catch(amdsmi_status_t r) {
        switch (r) {
          case AMDSMI_STATUS_NOT_SUPPORTED:
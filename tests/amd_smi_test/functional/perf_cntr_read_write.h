@@ -77,6 +77,7 @@ class TestPerfCntrReadWrite : public TestBase {
                                                    int32_t sleep_sec = 1);
   void testEventsIndividually(amdsmi_processor_handle dv_ind);
   void testEventsSimultaneously(amdsmi_processor_handle dv_ind);
+  void testEventsGrouped(amdsmi_processor_handle dv_ind);
 };
 
 class PerfCntrEvtGrp {
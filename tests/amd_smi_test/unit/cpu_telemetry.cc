@@ -0,0 +1,119 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "amd_smi/amdsmi.h"
+
+#ifdef ENABLE_ESMI_LIB
+
+// Runs amdsmi_get_cpu_telemetry() against the ESMI stub (-DBUILD_ESMI_STUB=ON)
+// on 2 sockets of 4 cores with 2 threads each, and checks that every socket
+// and core entry carries the stub's values for its own index.
+TEST(amdsmitstUnit, CpuTelemetryEsmiStub) {
+#ifndef AMDSMITST_ESMI_STUB
+  GTEST_SKIP() << "needs a library built with -DBUILD_ESMI_STUB=ON";
+#else
+  constexpr uint32_t kSockets = 2;
+  constexpr uint32_t kCoresPerSocket = 4;
+  setenv("ESMI_STUB_SOCKETS", "2", 1);
+  setenv("ESMI_STUB_CPUS", "16", 1);
+  setenv("ESMI_STUB_THREADS", "2", 1);
+  ASSERT_EQ(amdsmi_init(AMDSMI_INIT_AMD_CPUS), AMDSMI_STATUS_SUCCESS);
+
+  uint32_t num_sockets = 0;
+  uint32_t num_cores = 0;
+  ASSERT_EQ(amdsmi_get_cpu_telemetry(nullptr, &num_sockets, nullptr, &num_cores),
+            AMDSMI_STATUS_SUCCESS);
+  EXPECT_EQ(num_sockets, kSockets);
+  EXPECT_EQ(num_cores, kSockets * kCoresPerSocket);
+
+  std::vector<amdsmi_cpu_socket_telemetry_t> sockets(num_sockets);
+  std::vector<amdsmi_cpu_core_telemetry_t> cores(num_cores);
+  ASSERT_EQ(amdsmi_get_cpu_telemetry(sockets.data(), &num_sockets,
+                                     cores.data(), &num_cores),
+            AMDSMI_STATUS_SUCCESS);
+  ASSERT_EQ(num_sockets, kSockets);
+  ASSERT_EQ(num_cores, kSockets * kCoresPerSocket);
+
+  for (uint32_t i = 0; i < num_sockets; ++i) {
+    const amdsmi_cpu_socket_telemetry_t& t = sockets[i];
+    EXPECT_EQ(t.socket_index, i);
+    EXPECT_EQ(t.power, 100000 + i * 1000);
+    EXPECT_EQ(t.power_cap, 280000U);
+    EXPECT_EQ(t.energy % 100, i);
+    EXPECT_EQ(t.freq_limit, 3500);
+    EXPECT_EQ(t.fmax, 3700);
+    EXPECT_EQ(t.fmin, 400);
+  }
+  for (uint32_t c = 0; c < num_cores; ++c) {
+    const amdsmi_cpu_core_telemetry_t& t = cores[c];
+    EXPECT_EQ(t.core_index, c);
+    EXPECT_EQ(t.socket_index, c / kCoresPerSocket);
+    EXPECT_EQ(t.boostlimit, 3000 + c);
+    EXPECT_EQ(t.freq_limit, 2000 + c);
+    EXPECT_NE(t.energy, UINT64_MAX);
+  }
+
+  // A smaller buffer is filled up to its size
+  num_sockets = 1;
+  num_cores = kCoresPerSocket + 1;
+  std::vector<amdsmi_cpu_core_telemetry_t> few(num_cores);
+  ASSERT_EQ(amdsmi_get_cpu_telemetry(sockets.data(), &num_sockets,
+                                     few.data(), &num_cores),
+            AMDSMI_STATUS_SUCCESS);
+  EXPECT_EQ(num_sockets, 1U);
+  ASSERT_EQ(num_cores, kCoresPerSocket + 1);
+  EXPECT_EQ(few[kCoresPerSocket].socket_index, 1U);
+  EXPECT_EQ(few[kCoresPerSocket].boostlimit, 3000 + kCoresPerSocket);
+
+  EXPECT_EQ(amdsmi_shut_down(), AMDSMI_STATUS_SUCCESS);
+#endif
+}
+
+#endif  // ENABLE_ESMI_LIB
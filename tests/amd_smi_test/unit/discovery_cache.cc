@@ -0,0 +1,258 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "rocm_smi/rocm_smi_common.h"
+#include "rocm_smi/rocm_smi_discovery_cache.h"
+
+namespace {
+
+const char kKey[] = "boot|amdgpu|r|300=/sys/class/drm/card0";
+
+// A temporary directory for the cache file
+class DiscoveryCacheDir {
+ public:
+  DiscoveryCacheDir() {
+    char tmpl[] = "/tmp/rsmi_discovery_cache_XXXXXX";
+    const char* root = mkdtemp(tmpl);
+    EXPECT_NE(root, nullptr);
+    root_ = root != nullptr ? root : "";
+    path_ = root_ + "/discovery.cache";
+  }
+  ~DiscoveryCacheDir() {
+    unlink(path_.c_str());
+    unlink((root_ + "/link.cache").c_str());
+    rmdir(root_.c_str());
+  }
+
+  const std::string& root(void) const { return root_; }
+  const std::string& path(void) const { return path_; }
+
+  std::string contents(void) const {
+    std::ifstream fs(path_, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(fs),
+                       std::istreambuf_iterator<char>());
+  }
+  // Replaces the file with data, keeping the 0644 mode Store() gives it
+  void set_contents(const std::string& data) const {
+    std::ofstream fs(path_, std::ios::binary | std::ios::trunc);
+    fs << data;
+  }
+
+ private:
+  std::string root_;
+  std::string path_;
+};
+
+std::vector<amd::smi::DiscoveryRecord> SampleRecords(void) {
+  std::vector<amd::smi::DiscoveryRecord> records(2);
+  records[0].bdfid = 0x300;
+  records[0].dev_path = "/sys/class/drm/card0";
+  records[0].hwmon_path = "/sys/class/drm/card0/device/hwmon/hwmon3";
+  records[0].temp_labels = {{1, 0}, {2, 1}, {3, 2}};
+  records[0].volt_labels = {{0, 0}};
+  records[0].event_groups = {0, 1};
+
+  auto subs = std::make_shared<SubVariant>();
+  subs->push_back(7);
+  subs->push_back(9);
+  auto variants = std::make_shared<VariantMap>();
+  (*variants)[1] = subs;
+  (*variants)[2] = nullptr;
+  records[0].supported_funcs["rsmi_dev_temp_metric_get"] = variants;
+  records[0].supported_funcs["rsmi_dev_id_get"] = nullptr;
+
+  // No hwmon, nothing supported
+  records[1].bdfid = 0x400;
+  records[1].dev_path = "/sys/class/drm/card1";
+  return records;
+}
+
+void ExpectSameRecords(const std::vector<amd::smi::DiscoveryRecord>& a,
+                       const std::vector<amd::smi::DiscoveryRecord>& b) {
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    EXPECT_EQ(a[i].bdfid, b[i].bdfid);
+    EXPECT_EQ(a[i].dev_path, b[i].dev_path);
+    EXPECT_EQ(a[i].hwmon_path, b[i].hwmon_path);
+    EXPECT_EQ(a[i].temp_labels, b[i].temp_labels);
+    EXPECT_EQ(a[i].volt_labels, b[i].volt_labels);
+    EXPECT_EQ(a[i].event_groups, b[i].event_groups);
+    ASSERT_EQ(a[i].supported_funcs.size(), b[i].supported_funcs.size());
+    for (const auto& func : a[i].supported_funcs) {
+      auto it = b[i].supported_funcs.find(func.first);
+      ASSERT_NE(it, b[i].supported_funcs.end()) << func.first;
+      ASSERT_EQ(func.second == nullptr, it->second == nullptr);
+      if (func.second == nullptr) {
+        continue;
+      }
+      ASSERT_EQ(func.second->size(), it->second->size());
+      for (const auto& var : *func.second) {
+        auto vit = it->second->find(var.first);
+        ASSERT_NE(vit, it->second->end());
+        ASSERT_EQ(var.second == nullptr, vit->second == nullptr);
+        if (var.second != nullptr) {
+          EXPECT_EQ(*var.second, *vit->second);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(amdsmitstUnit, DiscoveryCacheRoundTrip) {
+  DiscoveryCacheDir dir;
+  amd::smi::DiscoveryCache cache(dir.path());
+  std::vector<amd::smi::DiscoveryRecord> records;
+
+  // Nothing stored yet
+  EXPECT_FALSE(cache.Load(kKey, &records));
+
+  const std::vector<amd::smi::DiscoveryRecord> stored = SampleRecords();
+  ASSERT_EQ(cache.Store(kKey, stored), 0);
+  struct stat st;
+  ASSERT_EQ(stat(dir.path().c_str(), &st), 0);
+  EXPECT_EQ(st.st_mode & 0777, 0644U);
+
+  ASSERT_TRUE(cache.Load(kKey, &records));
+  ExpectSameRecords(stored, records);
+
+  // Another boot, module or device list is a miss
+  EXPECT_FALSE(cache.Load(std::string(kKey) + "|500=card2", &records));
+  EXPECT_TRUE(records.empty());
+  EXPECT_FALSE(cache.Load("", &records));
+  EXPECT_EQ(cache.Store("", stored), EINVAL);
+}
+
+TEST(amdsmitstUnit, DiscoveryCacheTruncated) {
+  DiscoveryCacheDir dir;
+  amd::smi::DiscoveryCache cache(dir.path());
+  ASSERT_EQ(cache.Store(kKey, SampleRecords()), 0);
+  const std::string data = dir.contents();
+  ASSERT_FALSE(data.empty());
+
+  // Cut anywhere, including inside a length or count, it is a miss
+  std::vector<amd::smi::DiscoveryRecord> records;
+  for (size_t len = 0; len < data.size(); ++len) {
+    dir.set_contents(data.substr(0, len));
+    EXPECT_FALSE(cache.Load(kKey, &records)) << "length " << len;
+    EXPECT_TRUE(records.empty());
+  }
+  // So is trailing garbage
+  dir.set_contents(data + "x");
+  EXPECT_FALSE(cache.Load(kKey, &records));
+
+  dir.set_contents(data);
+  EXPECT_TRUE(cache.Load(kKey, &records));
+}
+
+TEST(amdsmitstUnit, DiscoveryCacheWrongVersion) {
+  DiscoveryCacheDir dir;
+  amd::smi::DiscoveryCache cache(dir.path());
+  ASSERT_EQ(cache.Store(kKey, SampleRecords()), 0);
+  std::string data = dir.contents();
+
+  // The version follows the 8 byte magic
+  const size_t kVersionOffset = 8;
+  uint32_t version;
+  ASSERT_GE(data.size(), kVersionOffset + sizeof(version));
+  memcpy(&version, &data[kVersionOffset], sizeof(version));
+  ++version;
+  memcpy(&data[kVersionOffset], &version, sizeof(version));
+  dir.set_contents(data);
+
+  std::vector<amd::smi::DiscoveryRecord> records;
+  EXPECT_FALSE(cache.Load(kKey, &records));
+
+  // And so does a bad magic
+  data = dir.contents();
+  --version;
+  memcpy(&data[kVersionOffset], &version, sizeof(version));
+  data[0] = 'X';
+  dir.set_contents(data);
+  EXPECT_FALSE(cache.Load(kKey, &records));
+}
+
+TEST(amdsmitstUnit, DiscoveryCacheUntrustedFile) {
+  DiscoveryCacheDir dir;
+  amd::smi::DiscoveryCache cache(dir.path());
+  ASSERT_EQ(cache.Store(kKey, SampleRecords()), 0);
+  std::vector<amd::smi::DiscoveryRecord> records;
+  ASSERT_TRUE(cache.Load(kKey, &records));
+
+  // Writable by others
+  ASSERT_EQ(chmod(dir.path().c_str(), 0664), 0);
+  EXPECT_FALSE(cache.Load(kKey, &records));
+  ASSERT_EQ(chmod(dir.path().c_str(), 0646), 0);
+  EXPECT_FALSE(cache.Load(kKey, &records));
+  ASSERT_EQ(chmod(dir.path().c_str(), 0644), 0);
+
+  // Not opened through a symlink
+  const std::string link = dir.root() + "/link.cache";
+  ASSERT_EQ(symlink(dir.path().c_str(), link.c_str()), 0);
+  amd::smi::DiscoveryCache link_cache(link);
+  EXPECT_FALSE(link_cache.Load(kKey, &records));
+
+  // Owned by another unprivileged user; only root can set that up
+  if (geteuid() != 0) {
+    GTEST_SKIP() << "needs root to chown the cache file";
+  }
+  ASSERT_EQ(chown(dir.path().c_str(), 12345, 12345), 0);
+  EXPECT_FALSE(cache.Load(kKey, &records));
+  EXPECT_TRUE(records.empty());
+}
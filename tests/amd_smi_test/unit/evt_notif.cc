@@ -0,0 +1,221 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include "rocm_smi/rocm_smi.h"
+#include "rocm_smi/rocm_smi_evt_notif.h"
+
+namespace {
+
+// Copies s into the parser the way a read() of the event fd would
+void Feed(amd::smi::EvtRecordParser* parser, const std::string& s) {
+  std::size_t room = 0;
+  char* p = parser->space(&room);
+  ASSERT_GE(room, s.size());
+  std::memcpy(p, s.data(), s.size());
+  parser->commit(s.size());
+}
+
+// Writes s to the write end of a pipe
+void Send(int fd, const std::string& s) {
+  ASSERT_EQ(write(fd, s.data(), s.size()), static_cast<ssize_t>(s.size()));
+}
+
+}  // namespace
+
+TEST(amdsmitstUnit, EvtRecordParserRecords) {
+  amd::smi::EvtRecordParser parser;
+  rsmi_evt_notification_type_t event;
+  char msg[MAX_EVENT_NOTIFICATION_MSG_SIZE];
+
+  EXPECT_FALSE(parser.has_record());
+  Feed(&parser, "5 1234 migrate\n  a\tthrottle\nzz not a record\n");
+  ASSERT_TRUE(parser.has_record());
+  ASSERT_TRUE(parser.next(&event, msg, sizeof(msg)));
+  EXPECT_EQ(static_cast<uint32_t>(event), 5U);
+  EXPECT_STREQ(msg, "1234 migrate");
+  ASSERT_TRUE(parser.next(&event, msg, sizeof(msg)));
+  EXPECT_EQ(static_cast<uint32_t>(event), 0xaU);
+  EXPECT_STREQ(msg, "throttle");
+  // A line without a hex event is skipped
+  EXPECT_FALSE(parser.next(&event, msg, sizeof(msg)));
+  EXPECT_FALSE(parser.has_record());
+}
+
+TEST(amdsmitstUnit, EvtRecordParserSplitRecord) {
+  amd::smi::EvtRecordParser parser;
+  rsmi_evt_notification_type_t event;
+  char msg[MAX_EVENT_NOTIFICATION_MSG_SIZE];
+
+  // A record cut by a read() waits for its end
+  Feed(&parser, "1F gpu ");
+  EXPECT_FALSE(parser.has_record());
+  EXPECT_FALSE(parser.next(&event, msg, sizeof(msg)));
+  Feed(&parser, "reset\n2");
+  ASSERT_TRUE(parser.next(&event, msg, sizeof(msg)));
+  EXPECT_EQ(static_cast<uint32_t>(event), 0x1fU);
+  EXPECT_STREQ(msg, "gpu reset");
+  EXPECT_FALSE(parser.next(&event, msg, sizeof(msg)));
+  Feed(&parser, "\n");
+  ASSERT_TRUE(parser.next(&event, msg, sizeof(msg)));
+  EXPECT_EQ(static_cast<uint32_t>(event), 2U);
+  EXPECT_STREQ(msg, "");
+
+  // The message is truncated to the caller's buffer
+  char small[4];
+  Feed(&parser, "3 abcdef\n");
+  ASSERT_TRUE(parser.next(&event, small, sizeof(small)));
+  EXPECT_STREQ(small, "abc");
+}
+
+TEST(amdsmitstUnit, EvtRecordParserLongRecord) {
+  amd::smi::EvtRecordParser parser;
+  rsmi_evt_notification_type_t event;
+  char msg[MAX_EVENT_NOTIFICATION_MSG_SIZE];
+
+  // A record filling the whole buffer is returned truncated, and the rest
+  // of it, up to its newline, is dropped
+  const std::size_t kBufSz = amd::smi::EvtRecordParser::kBufSz;
+  Feed(&parser, "4 " + std::string(kBufSz - 2, 'x'));
+  ASSERT_TRUE(parser.has_record());
+  ASSERT_TRUE(parser.next(&event, msg, sizeof(msg)));
+  EXPECT_EQ(static_cast<uint32_t>(event), 4U);
+  EXPECT_EQ(std::string(msg), std::string(sizeof(msg) - 1, 'x'));
+  Feed(&parser, "yyyy\n6 next\n");
+  ASSERT_TRUE(parser.next(&event, msg, sizeof(msg)));
+  EXPECT_EQ(static_cast<uint32_t>(event), 6U);
+  EXPECT_STREQ(msg, "next");
+}
+
+TEST(amdsmitstUnit, EvtNotifierGet) {
+  amd::smi::EvtNotifier notifier;
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  ASSERT_EQ(notifier.add(3, fds[0]), 0);
+
+  rsmi_evt_notification_data_t data[4];
+  uint32_t num_elem = 4;
+  EXPECT_EQ(notifier.get(0, &num_elem, data), 0);
+  EXPECT_EQ(num_elem, 0U);
+
+  Send(fds[1], "1 first\n2 second\n");
+  num_elem = 4;
+  ASSERT_EQ(notifier.get(1000, &num_elem, data), 0);
+  ASSERT_EQ(num_elem, 2U);
+  EXPECT_EQ(data[0].dv_ind, 3U);
+  EXPECT_STREQ(data[0].message, "first");
+  EXPECT_STREQ(data[1].message, "second");
+
+  EXPECT_EQ(notifier.remove(3), 0);
+  EXPECT_EQ(notifier.remove(3), ENOENT);
+  close(fds[1]);
+}
+
+TEST(amdsmitstUnit, EvtNotifierResetWakesGet) {
+  amd::smi::EvtNotifier notifier;
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  ASSERT_EQ(notifier.add(0, fds[0]), 0);
+
+  // reset() closes the epoll fd only once the blocked get() has returned
+  std::atomic<bool> returned(false);
+  std::thread waiter([&notifier, &returned]() {
+    rsmi_evt_notification_data_t data[1];
+    uint32_t num_elem = 1;
+    EXPECT_EQ(notifier.get(-1, &num_elem, data), 0);
+    EXPECT_EQ(num_elem, 0U);
+    returned = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  notifier.reset();
+  EXPECT_TRUE(returned);
+  waiter.join();
+  close(fds[1]);
+}
+
+namespace {
+
+struct CallbackState {
+  amd::smi::EvtNotifier* notifier;
+  std::atomic<int> set_callback_ret;
+};
+
+void SetCallbackFromCallback(const rsmi_evt_notification_data_t*,
+                             void* user_data) {
+  CallbackState* state = static_cast<CallbackState*>(user_data);
+  state->set_callback_ret = state->notifier->set_callback(nullptr, nullptr);
+}
+
+}  // namespace
+
+TEST(amdsmitstUnit, EvtNotifierSetCallbackFromCallback) {
+  amd::smi::EvtNotifier notifier;
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  ASSERT_EQ(notifier.add(0, fds[0]), 0);
+
+  CallbackState state;
+  state.notifier = &notifier;
+  state.set_callback_ret = -1;
+  ASSERT_EQ(notifier.set_callback(SetCallbackFromCallback, &state), 0);
+  Send(fds[1], "1 event\n");
+  for (int i = 0; i < 1000 && state.set_callback_ret == -1; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  // Refused instead of joining the dispatch thread from itself
+  EXPECT_EQ(state.set_callback_ret, EBUSY);
+
+  EXPECT_EQ(notifier.set_callback(nullptr, nullptr), 0);
+  close(fds[1]);
+}
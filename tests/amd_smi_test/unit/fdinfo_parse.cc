@@ -0,0 +1,272 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "amd_smi/amdsmi.h"
+#include "amd_smi/impl/fdinfo.h"
+
+namespace {
+
+// parse_drm_fdinfo() works in place, so it gets a copy of the text
+class FdinfoBuffer {
+ public:
+  explicit FdinfoBuffer(const std::string& text) {
+    EXPECT_LT(text.size(), sizeof(buf_));
+    strncpy(buf_, text.c_str(), sizeof(buf_) - 1);
+  }
+  char* get() { return buf_; }
+
+ private:
+  char buf_[4096] = {};
+};
+
+const amdsmi_drm_engine_usage_t* FindEngine(const amd::smi::DrmFdinfo& fdinfo,
+                                            const char* name) {
+  for (uint32_t i = 0; i < fdinfo.num_engines; ++i) {
+    if (strcmp(fdinfo.engines[i].name, name) == 0) {
+      return &fdinfo.engines[i];
+    }
+  }
+  return nullptr;
+}
+
+const amdsmi_drm_engine_usage_t* FindEngine(const amd::smi::GpuUsage& usage,
+                                            const char* name) {
+  for (uint32_t i = 0; i < usage.num_engines; ++i) {
+    if (strcmp(usage.engines[i].name, name) == 0) {
+      return &usage.engines[i];
+    }
+  }
+  return nullptr;
+}
+
+const char kAmdgpuFdinfo[] =
+    "pos:\t0\n"
+    "flags:\t02100002\n"
+    "mnt_id:\t24\n"
+    "ino:\t1178\n"
+    "drm-driver:\tamdgpu\n"
+    "drm-client-id:\t42\n"
+    "drm-pdev:\t0000:c3:00.0\n"
+    "pasid:\t32770\n"
+    "drm-memory-vram:\t8192 KiB\n"
+    "drm-memory-gtt:\t2 MiB\n"
+    "drm-memory-cpu:\t0 KiB\n"
+    "drm-shared-vram:\t1024 KiB\n"
+    "drm-resident-vram:\t8192 KiB\n"
+    "amd-evicted-vram:\t0 KiB\n"
+    "drm-engine-gfx:\t1000000 ns\n"
+    "drm-engine-compute:\t250000 ns\n"
+    "drm-engine-capacity-compute:\t4\n"
+    "drm-engine-enc:\t0 ns\n"
+    "drm-cycles-gfx:\t777\n";
+
+}  // namespace
+
+TEST(amdsmitstUnit, FdinfoParseAllKeys) {
+  FdinfoBuffer buf(kAmdgpuFdinfo);
+  amd::smi::DrmFdinfo fdinfo;
+  amd::smi::parse_drm_fdinfo(buf.get(), fdinfo);
+
+  ASSERT_NE(fdinfo.pdev, nullptr);
+  EXPECT_STREQ(fdinfo.pdev, "0000:c3:00.0");
+  EXPECT_TRUE(fdinfo.has_client_id);
+  EXPECT_EQ(fdinfo.client_id, 42U);
+  EXPECT_TRUE(fdinfo.has_pasid);
+  EXPECT_EQ(fdinfo.pasid, 32770);
+
+  // The capacity key is not an engine of its own
+  ASSERT_EQ(fdinfo.num_engines, 3U);
+  auto gfx = FindEngine(fdinfo, "gfx");
+  ASSERT_NE(gfx, nullptr);
+  EXPECT_EQ(gfx->busy_ns, 1000000U);
+  EXPECT_EQ(gfx->cycles, 777U);
+  auto compute = FindEngine(fdinfo, "compute");
+  ASSERT_NE(compute, nullptr);
+  EXPECT_EQ(compute->busy_ns, 250000U);
+  EXPECT_EQ(compute->cycles, 0U);
+
+  ASSERT_EQ(fdinfo.num_memory_regions, 3U);
+  EXPECT_STREQ(fdinfo.memory_regions[0].name, "vram");
+  EXPECT_EQ(fdinfo.memory_regions[0].total, 8192ULL << 10);
+  EXPECT_EQ(fdinfo.memory_regions[0].shared, 1024ULL << 10);
+  EXPECT_EQ(fdinfo.memory_regions[0].resident, 8192ULL << 10);
+  EXPECT_STREQ(fdinfo.memory_regions[1].name, "gtt");
+  EXPECT_EQ(fdinfo.memory_regions[1].total, 2ULL << 20);
+}
+
+TEST(amdsmitstUnit, FdinfoParsePartialLines) {
+  // The last line has no newline, as when the read stopped at the end of
+  // the buffer; a key cut before its colon is dropped
+  {
+    FdinfoBuffer buf("drm-pdev:\t0000:03:00.0\ndrm-engine-gfx:\t1234");
+    amd::smi::DrmFdinfo fdinfo;
+    amd::smi::parse_drm_fdinfo(buf.get(), fdinfo);
+    ASSERT_NE(fdinfo.pdev, nullptr);
+    EXPECT_STREQ(fdinfo.pdev, "0000:03:00.0");
+    auto gfx = FindEngine(fdinfo, "gfx");
+    ASSERT_NE(gfx, nullptr);
+    EXPECT_EQ(gfx->busy_ns, 1234U);
+  }
+  {
+    FdinfoBuffer buf("drm-pdev:\t0000:03:00.0\ndrm-engine-gf");
+    amd::smi::DrmFdinfo fdinfo;
+    amd::smi::parse_drm_fdinfo(buf.get(), fdinfo);
+    EXPECT_EQ(fdinfo.num_engines, 0U);
+  }
+  {
+    FdinfoBuffer buf("");
+    amd::smi::DrmFdinfo fdinfo;
+    amd::smi::parse_drm_fdinfo(buf.get(), fdinfo);
+    EXPECT_EQ(fdinfo.pdev, nullptr);
+    EXPECT_FALSE(fdinfo.has_client_id);
+    EXPECT_FALSE(fdinfo.has_pasid);
+    EXPECT_EQ(fdinfo.num_engines, 0U);
+    EXPECT_EQ(fdinfo.num_memory_regions, 0U);
+  }
+}
+
+TEST(amdsmitstUnit, FdinfoParseMalformed) {
+  std::string text =
+      "no colon on this line\n"
+      "\n"
+      ":\t5\n"
+      "drm-engine-:\t99 ns\n"
+      "drm-memory-:\t1 KiB\n"
+      "drm-engine-gfx:\tnot a number\n"
+      "drm-memory-vram:\t\n"
+      "drm-memory-gtt:\t3 TiB\n"
+      "drm-client-id:\n";
+  // More engines than the table holds; the extra ones are dropped
+  for (int i = 0; i < AMDSMI_MAX_DRM_ENGINES + 4; ++i) {
+    text += "drm-engine-e" + std::to_string(i) + ":\t" + std::to_string(i) + " ns\n";
+  }
+  FdinfoBuffer buf(text);
+  amd::smi::DrmFdinfo fdinfo;
+  amd::smi::parse_drm_fdinfo(buf.get(), fdinfo);
+
+  EXPECT_EQ(fdinfo.pdev, nullptr);
+  EXPECT_TRUE(fdinfo.has_client_id);
+  EXPECT_EQ(fdinfo.client_id, 0U);
+
+  // Empty names are dropped, unparsable numbers read as 0
+  ASSERT_EQ(fdinfo.num_engines, static_cast<uint32_t>(AMDSMI_MAX_DRM_ENGINES));
+  auto gfx = FindEngine(fdinfo, "gfx");
+  ASSERT_NE(gfx, nullptr);
+  EXPECT_EQ(gfx->busy_ns, 0U);
+  EXPECT_EQ(FindEngine(fdinfo, ""), nullptr);
+  EXPECT_EQ(FindEngine(fdinfo, "e15"), nullptr);
+
+  // An unknown unit is taken as bytes
+  ASSERT_EQ(fdinfo.num_memory_regions, 2U);
+  EXPECT_STREQ(fdinfo.memory_regions[0].name, "vram");
+  EXPECT_EQ(fdinfo.memory_regions[0].total, 0U);
+  EXPECT_STREQ(fdinfo.memory_regions[1].name, "gtt");
+  EXPECT_EQ(fdinfo.memory_regions[1].total, 3U);
+}
+
+TEST(amdsmitstUnit, FdinfoSumClients) {
+  amd::smi::GpuUsage usage;
+
+  // Two fds of client 42 (a dup()) count once, client 43 adds up
+  for (const char* client : {"42", "42", "43"}) {
+    FdinfoBuffer buf(std::string("drm-pdev:\t0000:c3:00.0\npasid:\t7\ndrm-client-id:\t") +
+                     client + "\ndrm-engine-gfx:\t100 ns\ndrm-memory-vram:\t4 KiB\n");
+    amd::smi::DrmFdinfo fdinfo;
+    amd::smi::parse_drm_fdinfo(buf.get(), fdinfo);
+    amd::smi::add_drm_fdinfo(fdinfo, usage);
+  }
+
+  EXPECT_EQ(usage.num_clients, 2U);
+  ASSERT_EQ(usage.pasids.size(), 1U);
+  EXPECT_EQ(usage.pasids[0], 7);
+  auto gfx = FindEngine(usage, "gfx");
+  ASSERT_NE(gfx, nullptr);
+  EXPECT_EQ(gfx->busy_ns, 200U);
+  ASSERT_EQ(usage.num_memory_regions, 1U);
+  EXPECT_EQ(usage.memory_regions[0].total, 8U << 10);
+}
+
+TEST(amdsmitstUnit, FdinfoBusyPercent) {
+  auto make_usage = [](std::chrono::steady_clock::time_point scan_time,
+                       const std::string& text) {
+    amd::smi::GpuUsage usage;
+    usage.scan_time = scan_time;
+    FdinfoBuffer buf(text);
+    amd::smi::DrmFdinfo fdinfo;
+    amd::smi::parse_drm_fdinfo(buf.get(), fdinfo);
+    amd::smi::add_drm_fdinfo(fdinfo, usage);
+    return usage;
+  };
+  const auto start = std::chrono::steady_clock::time_point(std::chrono::seconds(1));
+  const auto end = start + std::chrono::milliseconds(100);
+
+  auto previous = make_usage(start,
+      "drm-engine-gfx:\t1000000 ns\ndrm-engine-compute:\t500000000 ns\n");
+  auto current = make_usage(end,
+      "drm-engine-gfx:\t51000000 ns\ndrm-engine-compute:\t400000000 ns\n"
+      "drm-engine-dec:\t90000000 ns\n");
+  amd::smi::update_busy_percent(previous, current);
+
+  EXPECT_EQ(current.interval_ns, 100000000U);
+  // 50 ms busy out of 100 ms
+  EXPECT_EQ(FindEngine(current, "gfx")->busy_percent, 50U);
+  // A counter that went back (a client was closed) counts as idle
+  EXPECT_EQ(FindEngine(current, "compute")->busy_percent, 0U);
+  // An engine with no previous value has no percent yet
+  EXPECT_EQ(FindEngine(current, "dec")->busy_percent, 0U);
+
+  // No time between the passes: nothing is computed
+  auto same_time = make_usage(start, "drm-engine-gfx:\t2000000 ns\n");
+  amd::smi::update_busy_percent(previous, same_time);
+  EXPECT_EQ(same_time.interval_ns, 0U);
+  EXPECT_EQ(FindEngine(same_time, "gfx")->busy_percent, 0U);
+}
@@ -0,0 +1,156 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+#include <stdint.h>
+
+#include <limits>
+
+#include <gtest/gtest.h>
+#include "amd_smi/amdsmi.h"
+#include "amd_smi/impl/amd_smi_link_rate.h"
+
+namespace {
+
+using amd::smi::AMDSmiLinkRateTracker;
+using amd::smi::AMDSmiLinkSample;
+
+constexpr uint64_t kUnsupported = std::numeric_limits<uint64_t>::max();
+constexpr uint64_t kSecondNs = 1000000000;
+
+// Link 0 reports read/write accumulators, the other links and PCIe do not
+AMDSmiLinkSample MakeSample(uint64_t time_ns, uint64_t read_kb, uint64_t write_kb) {
+  AMDSmiLinkSample sample{};
+  sample.time_ns = time_ns;
+  for (uint32_t i = 0; i < AMDSMI_MAX_NUM_XGMI_LINKS; ++i) {
+    sample.xgmi_read_kb[i] = kUnsupported;
+    sample.xgmi_write_kb[i] = kUnsupported;
+  }
+  sample.xgmi_read_kb[0] = read_kb;
+  sample.xgmi_write_kb[0] = write_kb;
+  sample.pcie_bandwidth_inst = kUnsupported;
+  sample.xgmi_max_gbps = 50;
+  return sample;
+}
+
+}  // namespace
+
+TEST(amdsmitstUnit, LinkRateTrackerFirstSample) {
+  AMDSmiLinkRateTracker tracker;
+  amdsmi_link_rates_t rates{};
+
+  // Only the baseline is taken
+  EXPECT_FALSE(tracker.update(MakeSample(kSecondNs, 0, 0), &rates));
+  EXPECT_EQ(rates.num_links, 0U);
+
+  // Firmware did not refresh the metrics yet: still no window
+  EXPECT_FALSE(tracker.update(MakeSample(kSecondNs, 100, 100), &rates));
+
+  ASSERT_TRUE(tracker.update(MakeSample(2 * kSecondNs, 1000000, 0), &rates));
+  EXPECT_EQ(rates.window_ns, kSecondNs);
+
+  // Timestamp went back (driver reload): a new baseline is taken
+  EXPECT_FALSE(tracker.update(MakeSample(kSecondNs / 2, 0, 0), &rates));
+  ASSERT_TRUE(tracker.update(MakeSample(kSecondNs, 0, 0), &rates));
+  EXPECT_EQ(rates.window_ns, kSecondNs / 2);
+}
+
+TEST(amdsmitstUnit, LinkRateTrackerRate) {
+  AMDSmiLinkRateTracker tracker;
+  amdsmi_link_rates_t rates{};
+
+  EXPECT_FALSE(tracker.update(MakeSample(0, 0, 0), &rates));
+
+  // 1000000 KB read and 500000 KB written in 1 s
+  AMDSmiLinkSample sample = MakeSample(kSecondNs, 1000000, 500000);
+  sample.pcie_bandwidth_inst = 8;
+  sample.pcie_max_gbps = 32;
+  ASSERT_TRUE(tracker.update(sample, &rates));
+  ASSERT_EQ(rates.num_links, 2U);
+
+  const amdsmi_link_rate_t& xgmi = rates.links[0];
+  EXPECT_EQ(xgmi.link_type, AMDSMI_LINK_TYPE_XGMI);
+  EXPECT_EQ(xgmi.link_index, 0U);
+  EXPECT_FLOAT_EQ(xgmi.read_gbps, 1.024f);
+  EXPECT_FLOAT_EQ(xgmi.write_gbps, 0.512f);
+  EXPECT_FLOAT_EQ(xgmi.total_gbps, 1.536f);
+  EXPECT_FLOAT_EQ(xgmi.max_gbps, 50.0f);
+  EXPECT_FLOAT_EQ(xgmi.utilization, 1.024f * 100 / 50);
+
+  const amdsmi_link_rate_t& pcie = rates.links[1];
+  EXPECT_EQ(pcie.link_type, AMDSMI_LINK_TYPE_PCIE);
+  EXPECT_LT(pcie.read_gbps, 0);
+  EXPECT_FLOAT_EQ(pcie.total_gbps, 8.0f);
+  EXPECT_FLOAT_EQ(pcie.utilization, 25.0f);
+
+  // Same timestamp: the last result is returned again
+  rates = {};
+  ASSERT_TRUE(tracker.update(MakeSample(kSecondNs, 1000000, 500000), &rates));
+  EXPECT_EQ(rates.window_ns, kSecondNs);
+  EXPECT_FLOAT_EQ(rates.links[0].read_gbps, 1.024f);
+}
+
+TEST(amdsmitstUnit, LinkRateTrackerReset) {
+  AMDSmiLinkRateTracker tracker;
+  amdsmi_link_rates_t rates{};
+
+  // The read accumulator went back (GPU reset) while time moved on: the
+  // window is not available for it, the write side still is
+  EXPECT_FALSE(tracker.update(MakeSample(0, 5000000, 0), &rates));
+  ASSERT_TRUE(tracker.update(MakeSample(kSecondNs, 1000, 1000000), &rates));
+  ASSERT_EQ(rates.num_links, 1U);
+  EXPECT_LT(rates.links[0].read_gbps, 0);
+  EXPECT_FLOAT_EQ(rates.links[0].write_gbps, 1.024f);
+  EXPECT_LT(rates.links[0].total_gbps, 0);
+  EXPECT_LT(rates.links[0].utilization, 0);
+
+  // The next window measures from the value after the reset
+  ASSERT_TRUE(tracker.update(MakeSample(2 * kSecondNs, 1001000, 1000000), &rates));
+  EXPECT_FLOAT_EQ(rates.links[0].read_gbps, 1.024f);
+  EXPECT_FLOAT_EQ(rates.links[0].write_gbps, 0.0f);
+
+  // An unsupported accumulator is not taken as a reset
+  ASSERT_TRUE(tracker.update(MakeSample(3 * kSecondNs, kUnsupported, 1000000), &rates));
+  EXPECT_LT(rates.links[0].read_gbps, 0);
+  EXPECT_LT(rates.links[0].total_gbps, 0);
+}
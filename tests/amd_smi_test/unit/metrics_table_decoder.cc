@@ -0,0 +1,322 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "rocm_smi/rocm_smi.h"
+#include "rocm_smi/rocm_smi_binary_parser.h"
+
+namespace {
+
+void PutLe(std::vector<uint8_t>* blob, size_t off, uint64_t v, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    (*blob)[off + i] = static_cast<uint8_t>(v >> (8 * i));
+  }
+}
+
+uint64_t GetLe(const std::vector<uint8_t>& blob, size_t off, size_t size) {
+  uint64_t v = 0;
+  for (size_t i = 0; i < size; ++i) {
+    v |= static_cast<uint64_t>(blob[off + i]) << (8 * i);
+  }
+  return v;
+}
+
+// The pm_metrics and reg_state blobs that tools/fake_sysfs_tree.py writes
+// for a GPU, built the same way
+constexpr size_t kPmMetricsSize = 1740;
+constexpr size_t kRegStateSectionSize = 0x1000;
+
+std::vector<uint8_t> PmMetricsBlob(uint32_t gpu) {
+  std::vector<uint8_t> blob(kPmMetricsSize);
+  for (size_t i = 0; i < blob.size(); ++i) {
+    blob[i] = static_cast<uint8_t>(i * 7 + gpu);
+  }
+  PutLe(&blob, 0, kPmMetricsSize, 2);
+  PutLe(&blob, 2, 0, 2);
+  PutLe(&blob, 4, 0x0d000006, 4);
+  PutLe(&blob, 8, 0x00556d00, 4);
+  PutLe(&blob, 12, 4, 4);   // pmmetrics_version
+  return blob;
+}
+
+// One reg_state section: a header, then per instance a header, the PCIe
+// status fields if any, and the registers
+std::vector<uint8_t> RegStateSection(uint32_t gpu, uint8_t section,
+                                     uint8_t instances, uint16_t regs,
+                                     bool pcie) {
+  std::vector<uint8_t> blob(kRegStateSectionSize);
+  size_t off = 8;
+  for (uint16_t inst = 0; inst < instances; ++inst) {
+    PutLe(&blob, off, inst, 2);
+    PutLe(&blob, off + 2, 1, 2);
+    PutLe(&blob, off + 4, regs, 2);
+    off += 8;
+    if (pcie) {
+      PutLe(&blob, off, 0x10, 2);
+      PutLe(&blob, off + 2, 0x1043, 2);
+      off += 16;
+    }
+    for (uint16_t reg = 0; reg < regs; ++reg) {
+      PutLe(&blob, off, 0x11a00000 + 0x100 * inst + 4 * reg, 8);
+      PutLe(&blob, off + 8, 1000 * (gpu + 1) + 16 * inst + reg, 4);
+      off += 16;
+    }
+  }
+  PutLe(&blob, 0, off, 2);
+  blob[2] = 1;
+  blob[4] = section;
+  blob[5] = instances;
+  return blob;
+}
+
+struct RegStateLayout {
+  uint8_t instances;
+  uint16_t regs;
+  bool pcie;
+};
+
+// XGMI, WAFL, PCIe, USR and USR_1, at 4 KB offsets
+const RegStateLayout kRegStateSections[] = {
+  {8, 2, false}, {2, 1, false}, {1, 4, true}, {1, 4, false}, {1, 4, false}};
+
+std::vector<uint8_t> RegStateBlob(uint32_t gpu) {
+  std::vector<uint8_t> blob;
+  uint8_t section = 0;
+  for (const auto& s : kRegStateSections) {
+    auto sec = RegStateSection(gpu, section++, s.instances, s.regs, s.pcie);
+    blob.insert(blob.end(), sec.begin(), sec.end());
+  }
+  return blob;
+}
+
+// Byte offset of a register value in an XGMI-like section
+size_t RegValueOffset(uint16_t regs, uint16_t inst, uint16_t reg) {
+  return 8 + inst * (8 + 16 * regs) + 8 + 16 * reg + 8;
+}
+
+std::vector<rsmi_name_value_t> Decode(amd::smi::MetricsTableDecoder* decoder,
+                                      const std::vector<uint8_t>& blob,
+                                      bool changes_only) {
+  uint32_t num = 0;
+  EXPECT_EQ(decoder->decode(blob.data(), blob.size(), nullptr, &num, false), 0);
+  std::vector<rsmi_name_value_t> kv(num);
+  EXPECT_EQ(decoder->decode(blob.data(), blob.size(), kv.data(), &num,
+                            changes_only), 0);
+  kv.resize(num);
+  return kv;
+}
+
+const rsmi_name_value_t* Find(const std::vector<rsmi_name_value_t>& kv,
+                              const char* name) {
+  for (const auto& e : kv) {
+    if (strcmp(e.name, name) == 0) {
+      return &e;
+    }
+  }
+  return nullptr;
+}
+
+void ExpectValue(const std::vector<rsmi_name_value_t>& kv, const char* name,
+                 uint64_t value) {
+  const rsmi_name_value_t* e = Find(kv, name);
+  ASSERT_NE(e, nullptr) << name;
+  EXPECT_EQ(e->value, value) << name;
+}
+
+}  // namespace
+
+TEST(amdsmitstUnit, MetricsTableDecoderPmMetrics) {
+  const auto blob = PmMetricsBlob(3);
+  amd::smi::MetricsTableDecoder decoder;
+  const auto kv = Decode(&decoder, blob, false);
+  ASSERT_GT(kv.size(), 10u);
+
+  EXPECT_STREQ(kv[0].name, "structure_size");
+  EXPECT_EQ(kv[0].value, kPmMetricsSize);
+  ExpectValue(kv, "mp1_ip_discovery_version", 0x0d000006);
+  ExpectValue(kv, "pmfw_version", 0x00556d00);
+  ExpectValue(kv, "pmmetrics_version", 4);
+  ExpectValue(kv, "AccumulationCounter", GetLe(blob, 16, 4));
+  ExpectValue(kv, "MaxSocketTemperatureAcc", GetLe(blob, 32, 8));
+  ExpectValue(kv, "Timestamp", GetLe(blob, 68, 8));
+  ExpectValue(kv, "SocclkFrequency[0]", GetLe(blob, 132, 4));
+  ExpectValue(kv, "SocclkFrequency[3]", GetLe(blob, 144, 4));
+  EXPECT_EQ(Find(kv, "SocclkFrequency[4]"), nullptr);
+}
+
+TEST(amdsmitstUnit, MetricsTableDecoderPmMetricsRejected) {
+  amd::smi::MetricsTableDecoder decoder;
+  auto blob = PmMetricsBlob(0);
+  uint32_t num = 0;
+  EXPECT_EQ(decoder.decode(blob.data(), 100, nullptr, &num, false), EINVAL);
+
+  PutLe(&blob, 12, 5, 4);
+  EXPECT_EQ(decoder.decode(blob.data(), blob.size(), nullptr, &num, false),
+            EINVAL);
+}
+
+TEST(amdsmitstUnit, MetricsTableDecoderRegStateXgmi) {
+  const uint32_t gpu = 2;
+  const auto blob = RegStateSection(gpu, 0, 8, 2, false);
+  amd::smi::MetricsTableDecoder decoder(RSMI_REG_XGMI);
+  const auto kv = Decode(&decoder, blob, false);
+
+  // The header, then per instance its header and three fields per register
+  ASSERT_EQ(kv.size(), 6u + 8 * (4 + 2 * 3));
+  ExpectValue(kv, "structure_size", 8 + 8 * (8 + 2 * 16));
+  ExpectValue(kv, "format_revision", 1);
+  ExpectValue(kv, "num_instances", 8);
+  ExpectValue(kv, "instance.instance[3]", 3);
+  ExpectValue(kv, "num_smn_regs.instance[3]", 2);
+  ExpectValue(kv, "addr.instance[3].smn[1]", 0x11a00000 + 0x300 + 4);
+  ExpectValue(kv, "value.instance[3].smn[1]", 1000 * (gpu + 1) + 16 * 3 + 1);
+  ExpectValue(kv, "value.instance[7].smn[0]", 1000 * (gpu + 1) + 16 * 7);
+  EXPECT_EQ(Find(kv, "value.instance[8].smn[0]"), nullptr);
+}
+
+TEST(amdsmitstUnit, MetricsTableDecoderRegStateFile) {
+  const uint32_t gpu = 1;
+  const auto blob = RegStateBlob(gpu);
+  char path[] = "/tmp/amdsmitst_reg_state.XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(write(fd, blob.data(), blob.size()),
+            static_cast<ssize_t>(blob.size()));
+  close(fd);
+
+  // The PCIe section is read from its own offset of the file
+  amd::smi::MetricsTableDecoder decoder(RSMI_REG_PCIE);
+  uint32_t num = 0;
+  EXPECT_EQ(decoder.read(path, nullptr, &num, false), 0);
+  ASSERT_EQ(num, 6u + 4 + 5 + 4 * 3);
+  std::vector<rsmi_name_value_t> kv(num);
+  EXPECT_EQ(decoder.read(path, kv.data(), &num, false), 0);
+  ExpectValue(kv, "state_type", 2);
+  ExpectValue(kv, "device_status.instance[0]", 0x10);
+  ExpectValue(kv, "link_status.instance[0]", 0x1043);
+  ExpectValue(kv, "addr.instance[0].smn[3]", 0x11a00000 + 4 * 3);
+  ExpectValue(kv, "value.instance[0].smn[3]", 1000 * (gpu + 1) + 3);
+
+  // Too small an array gets the number of values
+  num = 4;
+  EXPECT_EQ(decoder.read(path, kv.data(), &num, false), ENOSPC);
+  EXPECT_EQ(num, kv.size());
+
+  rsmi_name_value_t* alloc = nullptr;
+  amd::smi::MetricsTableDecoder wafl(RSMI_REG_WAFL);
+  EXPECT_EQ(wafl.read_alloc(path, &alloc, &num), 0);
+  ASSERT_NE(alloc, nullptr);
+  EXPECT_EQ(num, 6u + 2 * (4 + 1 * 3));
+  EXPECT_STREQ(alloc[num - 1].name, "pad.instance[1].smn[0]");
+  free(alloc);
+  unlink(path);
+}
+
+TEST(amdsmitstUnit, MetricsTableDecoderLayoutChange) {
+  amd::smi::MetricsTableDecoder decoder(RSMI_REG_XGMI);
+  auto kv = Decode(&decoder, RegStateSection(0, 0, 8, 2, false), false);
+  EXPECT_EQ(kv.size(), 6u + 8 * (4 + 2 * 3));
+
+  // Fewer instances with more registers each
+  kv = Decode(&decoder, RegStateSection(0, 0, 3, 4, false), false);
+  ASSERT_EQ(kv.size(), 6u + 3 * (4 + 4 * 3));
+  ExpectValue(kv, "num_instances", 3);
+  ExpectValue(kv, "value.instance[2].smn[3]", 1000 + 16 * 2 + 3);
+  EXPECT_EQ(Find(kv, "value.instance[3].smn[0]"), nullptr);
+
+  kv = Decode(&decoder, RegStateSection(0, 0, 8, 2, false), false);
+  EXPECT_EQ(kv.size(), 6u + 8 * (4 + 2 * 3));
+  ExpectValue(kv, "value.instance[7].smn[1]", 1000 + 16 * 7 + 1);
+}
+
+TEST(amdsmitstUnit, MetricsTableDecoderChangesOnly) {
+  amd::smi::MetricsTableDecoder decoder(RSMI_REG_XGMI);
+  auto blob = RegStateSection(0, 0, 8, 2, false);
+
+  // Everything the first time, then nothing until a value changes
+  auto kv = Decode(&decoder, blob, true);
+  EXPECT_EQ(kv.size(), 6u + 8 * (4 + 2 * 3));
+  kv = Decode(&decoder, blob, true);
+  EXPECT_TRUE(kv.empty());
+
+  PutLe(&blob, RegValueOffset(2, 5, 1), 0xbeef, 4);
+  kv = Decode(&decoder, blob, true);
+  ASSERT_EQ(kv.size(), 1u);
+  EXPECT_STREQ(kv[0].name, "value.instance[5].smn[1]");
+  EXPECT_EQ(kv[0].value, 0xbeefu);
+
+  // A read of all values does not reset what changes_only compares with
+  Decode(&decoder, RegStateSection(0, 0, 8, 2, false), false);
+  kv = Decode(&decoder, blob, true);
+  EXPECT_TRUE(kv.empty());
+
+  // Everything again after the layout changed
+  kv = Decode(&decoder, RegStateSection(0, 0, 3, 2, false), true);
+  EXPECT_EQ(kv.size(), 6u + 3 * (4 + 2 * 3));
+  kv = Decode(&decoder, RegStateSection(0, 0, 3, 2, false), true);
+  EXPECT_TRUE(kv.empty());
+}
+
+TEST(amdsmitstUnit, MetricsTableDecoderPmMetricsChangesOnly) {
+  amd::smi::MetricsTableDecoder decoder;
+  auto blob = PmMetricsBlob(0);
+  const auto all = Decode(&decoder, blob, true);
+  EXPECT_FALSE(all.empty());
+
+  PutLe(&blob, 16, GetLe(blob, 16, 4) + 1, 4);
+  PutLe(&blob, 68, 123456789, 8);
+  const auto kv = Decode(&decoder, blob, true);
+  ASSERT_EQ(kv.size(), 2u);
+  ExpectValue(kv, "AccumulationCounter", GetLe(blob, 16, 4));
+  ExpectValue(kv, "Timestamp", 123456789);
+}
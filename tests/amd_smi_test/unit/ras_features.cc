@@ -0,0 +1,162 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include "rocm_smi/rocm_smi.h"
+#include "rocm_smi/rocm_smi_common.h"
+#include "rocm_smi/rocm_smi_device.h"
+
+namespace {
+
+// A device directory with the RAS files tools/fake_sysfs_tree.py writes
+class RasFeaturesTree {
+ public:
+  RasFeaturesTree() {
+    char tmpl[] = "/tmp/rsmi_ras_XXXXXX";
+    const char* root = mkdtemp(tmpl);
+    EXPECT_NE(root, nullptr);
+    root_ = root != nullptr ? root : "";
+    card_ = root_ + "/card_ras_" + std::to_string(getpid());
+    mkdir(card_.c_str(), 0755);
+    mkdir((card_ + "/device").c_str(), 0755);
+    mkdir((card_ + "/device/ras").c_str(), 0755);
+  }
+  ~RasFeaturesTree() {
+    unlink((card_ + "/device/ras/features").c_str());
+    unlink((card_ + "/device/ras/umc_err_count").c_str());
+    rmdir((card_ + "/device/ras").c_str());
+    rmdir((card_ + "/device").c_str());
+    rmdir(card_.c_str());
+    rmdir(root_.c_str());
+  }
+
+  void write(const std::string& name, const std::string& content) {
+    std::ofstream fs(card_ + "/device/ras/" + name,
+                     std::ios::out | std::ios::trunc);
+    fs << content;
+  }
+  const std::string& card(void) const { return card_; }
+
+ private:
+  std::string root_;
+  std::string card_;
+};
+
+}  // namespace
+
+TEST(amdsmitstUnit, RasFeaturesMaskRefresh) {
+  RasFeaturesTree tree;
+  tree.write("features", "feature mask: 0x000000ff\n");
+  RocmSMI_env_vars env{};
+  amd::smi::Device dev(tree.card(), &env);
+
+  uint64_t mask = 0;
+  ASSERT_EQ(dev.ras_features_mask(&mask), 0);
+  EXPECT_EQ(mask, 0xffU);
+
+  // A block disabled through ras_ctrl is not seen within the TTL...
+  tree.write("features", "feature mask: 0x00000001\n");
+  ASSERT_EQ(dev.ras_features_mask(&mask), 0);
+  EXPECT_EQ(mask, 0xffU);
+
+  // ...and is seen once it has passed
+  std::this_thread::sleep_for(amd::smi::Device::kRasFeaturesTtl +
+                              std::chrono::milliseconds(50));
+  ASSERT_EQ(dev.ras_features_mask(&mask), 0);
+  EXPECT_EQ(mask, 0x1U);
+}
+
+TEST(amdsmitstUnit, RasFeaturesMaskErrors) {
+  RasFeaturesTree tree;
+  RocmSMI_env_vars env{};
+  amd::smi::Device dev(tree.card(), &env);
+
+  // No ras/features: the error is returned, and kept for the TTL
+  uint64_t mask = 1;
+  EXPECT_NE(dev.ras_features_mask(&mask), 0);
+  EXPECT_EQ(mask, 0U);
+  tree.write("features", "feature mask: 0x3\n");
+  EXPECT_NE(dev.ras_features_mask(&mask), 0);
+  std::this_thread::sleep_for(amd::smi::Device::kRasFeaturesTtl +
+                              std::chrono::milliseconds(50));
+  ASSERT_EQ(dev.ras_features_mask(&mask), 0);
+  EXPECT_EQ(mask, 0x3U);
+}
+
+TEST(amdsmitstUnit, RasErrCountParse) {
+  RasFeaturesTree tree;
+  RocmSMI_env_vars env{};
+  amd::smi::Device dev(tree.card(), &env);
+
+  rsmi_error_count_t ec{};
+  tree.write("umc_err_count", "ue: 1\nce: 12\nde: 2\n");
+  ASSERT_EQ(dev.readErrCount(amd::smi::kDevErrCntUMC, &ec), 0);
+  EXPECT_EQ(ec.uncorrectable_err, 1U);
+  EXPECT_EQ(ec.correctable_err, 12U);
+  EXPECT_EQ(ec.deferred_err, 2U);
+
+  // Kernels without deferred counts
+  tree.write("umc_err_count", "ue: 3\nce: 4\n");
+  ASSERT_EQ(dev.readErrCount(amd::smi::kDevErrCntUMC, &ec), 0);
+  EXPECT_EQ(ec.uncorrectable_err, 3U);
+  EXPECT_EQ(ec.correctable_err, 4U);
+  EXPECT_EQ(ec.deferred_err, 0U);
+
+  tree.write("umc_err_count", "ue: 3\n");
+  EXPECT_EQ(dev.readErrCount(amd::smi::kDevErrCntUMC, &ec), EBADF);
+
+  // A block without a counter file
+  EXPECT_NE(dev.readErrCount(amd::smi::kDevErrCntGFX, &ec), 0);
+}
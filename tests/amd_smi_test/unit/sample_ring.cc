@@ -0,0 +1,155 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "amd_smi/amdsmi.h"
+#include "amd_smi/impl/amd_smi_sampler.h"
+
+namespace {
+
+void PublishSamples(amd::smi::AMDSmiSampleRing* ring, uint64_t num_samples) {
+  for (uint64_t i = 0; i < num_samples; ++i) {
+    amdsmi_field_sample_t sample{};
+    sample.sequence = ring->num_published();
+    sample.timestamp_ns = sample.sequence * 1000;
+    sample.num_fields = 1;
+    sample.fields[0].field_id = AMDSMI_FIELD_GFX_ACTIVITY;
+    sample.fields[0].value.u64 = sample.sequence;
+    ring->publish(sample);
+  }
+}
+
+}  // namespace
+
+TEST(amdsmitstUnit, SampleRingReadInOrder) {
+  amd::smi::AMDSmiSampleRing ring(8);
+  amdsmi_field_sample_t samples[8];
+  uint64_t cursor = 0;
+
+  EXPECT_EQ(ring.read(&cursor, samples, 8), 0U);
+  EXPECT_EQ(cursor, 0U);
+
+  PublishSamples(&ring, 5);
+  ASSERT_EQ(ring.read(&cursor, samples, 3), 3U);
+  EXPECT_EQ(cursor, 3U);
+  for (uint32_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(samples[i].sequence, i);
+    EXPECT_EQ(samples[i].fields[0].value.u64, i);
+  }
+
+  // The next read picks up where the previous one stopped
+  ASSERT_EQ(ring.read(&cursor, samples, 8), 2U);
+  EXPECT_EQ(samples[0].sequence, 3U);
+  EXPECT_EQ(samples[1].sequence, 4U);
+  EXPECT_EQ(cursor, 5U);
+  EXPECT_EQ(ring.read(&cursor, samples, 8), 0U);
+}
+
+TEST(amdsmitstUnit, SampleRingWraparound) {
+  const uint32_t kDepth = 4;
+  amd::smi::AMDSmiSampleRing ring(kDepth);
+  amdsmi_field_sample_t samples[kDepth];
+  uint64_t cursor = 0;
+
+  // Every slot is overwritten more than once; only the last kDepth are kept
+  PublishSamples(&ring, 10);
+  EXPECT_EQ(ring.num_published(), 10U);
+  ASSERT_EQ(ring.read(&cursor, samples, kDepth), kDepth);
+  for (uint32_t i = 0; i < kDepth; ++i) {
+    EXPECT_EQ(samples[i].sequence, 6U + i);
+    EXPECT_EQ(samples[i].fields[0].value.u64, 6U + i);
+  }
+  EXPECT_EQ(cursor, 10U);
+
+  // A reader lapped while it was behind skips to the oldest record kept
+  uint64_t lapped_cursor = 7;
+  PublishSamples(&ring, 5);
+  ASSERT_EQ(ring.read(&lapped_cursor, samples, kDepth), kDepth);
+  EXPECT_EQ(samples[0].sequence, 11U);
+  EXPECT_EQ(samples[kDepth - 1].sequence, 14U);
+  EXPECT_EQ(lapped_cursor, 15U);
+
+  // A cursor past the newest record reads nothing
+  uint64_t future_cursor = 100;
+  EXPECT_EQ(ring.read(&future_cursor, samples, kDepth), 0U);
+  EXPECT_EQ(future_cursor, 100U);
+}
+
+TEST(amdsmitstUnit, SampleRingConcurrentReader) {
+  const uint64_t kNumSamples = 200000;
+  amd::smi::AMDSmiSampleRing ring(16);
+  std::atomic<bool> done(false);
+
+  std::thread writer([&ring, &done]() {
+    PublishSamples(&ring, kNumSamples);
+    done = true;
+  });
+
+  // Records read are complete, in order, and never repeated
+  amdsmi_field_sample_t samples[16];
+  uint64_t cursor = 0;
+  uint64_t last_sequence = 0;
+  bool has_last = false;
+  while (!done || cursor < ring.num_published()) {
+    const auto num_read = ring.read(&cursor, samples, 16);
+    for (uint32_t i = 0; i < num_read; ++i) {
+      EXPECT_EQ(samples[i].fields[0].value.u64, samples[i].sequence);
+      EXPECT_EQ(samples[i].timestamp_ns, samples[i].sequence * 1000);
+      if (has_last) {
+        EXPECT_GT(samples[i].sequence, last_sequence);
+      }
+      last_sequence = samples[i].sequence;
+      has_last = true;
+    }
+  }
+  writer.join();
+  EXPECT_EQ(last_sequence, kNumSamples - 1);
+}
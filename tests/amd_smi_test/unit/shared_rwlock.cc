@@ -0,0 +1,202 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include "shared_mutex.h"  // NOLINT
+
+namespace {
+
+// A shared rwlock on a fresh segment and a robust writer mutex in shared
+// anonymous memory, both inherited by forked children.
+class SharedRWLockFixture {
+ public:
+  SharedRWLockFixture() {
+    name_ = "/amdsmitst_rwlock_" + std::to_string(getpid());
+    void* addr = mmap(nullptr, sizeof(pthread_mutex_t), PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    EXPECT_NE(addr, MAP_FAILED);
+    writer_ = static_cast<pthread_mutex_t*>(addr);
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(writer_, &attr);
+    pthread_mutexattr_destroy(&attr);
+    rwlock_ = shared_rwlock_init(name_.c_str(), 0600, writer_);
+    EXPECT_NE(rwlock_.ptr, nullptr);
+  }
+  ~SharedRWLockFixture() {
+    shared_rwlock_close(rwlock_);
+    shm_unlink(name_.c_str());
+    munmap(writer_, sizeof(pthread_mutex_t));
+  }
+  shared_rwlock_t* rwlock() { return &rwlock_; }
+
+ private:
+  std::string name_;
+  pthread_mutex_t* writer_;
+  shared_rwlock_t rwlock_;
+};
+
+// Blocks until the other end writes one byte, or closes the pipe
+void WaitFor(int fd) {
+  char c;
+  while (read(fd, &c, 1) < 0 && errno == EINTR) {
+  }
+}
+
+void Signal(int fd) {
+  const char c = 1;
+  while (write(fd, &c, 1) < 0 && errno == EINTR) {
+  }
+}
+
+int ExitStatus(pid_t pid) {
+  int status = 0;
+  if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) {
+    return -1;
+  }
+  return WEXITSTATUS(status);
+}
+
+// Forks a reader that takes the lock, tells the parent, then either waits
+// to be told to release it or, with die_holding set, exits holding it.
+pid_t ForkReader(shared_rwlock_t* rwlock, int ready_fd, int release_fd, bool die_holding) {
+  pid_t pid = fork();
+  if (pid != 0) {
+    return pid;
+  }
+  int slot = -1;
+  if (shared_rwlock_rdlock(rwlock, true, &slot) != 0) {
+    _exit(1);
+  }
+  Signal(ready_fd);
+  if (die_holding) {
+    _exit(0);
+  }
+  WaitFor(release_fd);
+  shared_rwlock_rdunlock(rwlock, slot);
+  _exit(0);
+}
+
+}  // namespace
+
+TEST(amdsmitstUnit, SharedRWLockReadersShareWritersExclude) {
+  SharedRWLockFixture fixture;
+  shared_rwlock_t* rwlock = fixture.rwlock();
+  int ready[2];
+  int release[2];
+  ASSERT_EQ(pipe(ready), 0);
+  ASSERT_EQ(pipe(release), 0);
+
+  const pid_t reader = ForkReader(rwlock, ready[1], release[0], false);
+  ASSERT_GT(reader, 0);
+  WaitFor(ready[0]);
+
+  // Another process reads along with it, but can't write
+  int slot = -1;
+  ASSERT_EQ(shared_rwlock_rdlock(rwlock, false, &slot), 0);
+  EXPECT_GE(slot, 0);
+  shared_rwlock_rdunlock(rwlock, slot);
+  EXPECT_EQ(shared_rwlock_wrlock(rwlock, false), EBUSY);
+
+  Signal(release[1]);
+  EXPECT_EQ(ExitStatus(reader), 0);
+  ASSERT_EQ(shared_rwlock_wrlock(rwlock, false), 0);
+
+  // A reader in another process is kept out while it is held for writing
+  const pid_t blocked = fork();
+  ASSERT_GE(blocked, 0);
+  if (blocked == 0) {
+    int child_slot = -1;
+    _exit(shared_rwlock_rdlock(rwlock, false, &child_slot) == EBUSY ? 0 : 1);
+  }
+  EXPECT_EQ(ExitStatus(blocked), 0);
+  shared_rwlock_wrunlock(rwlock);
+
+  for (int fd : {ready[0], ready[1], release[0], release[1]}) {
+    close(fd);
+  }
+}
+
+TEST(amdsmitstUnit, SharedRWLockDeadReaderAndWriter) {
+  SharedRWLockFixture fixture;
+  shared_rwlock_t* rwlock = fixture.rwlock();
+  int ready[2];
+  ASSERT_EQ(pipe(ready), 0);
+
+  // A reader that exits holding the lock doesn't keep writers out
+  const pid_t reader = ForkReader(rwlock, ready[1], -1, true);
+  ASSERT_GT(reader, 0);
+  WaitFor(ready[0]);
+  EXPECT_EQ(ExitStatus(reader), 0);
+  ASSERT_EQ(shared_rwlock_wrlock(rwlock, false), 0);
+  shared_rwlock_wrunlock(rwlock);
+
+  // Neither does a writer that exits holding it
+  const pid_t writer = fork();
+  ASSERT_GE(writer, 0);
+  if (writer == 0) {
+    _exit(shared_rwlock_wrlock(rwlock, true) == 0 ? 0 : 1);
+  }
+  EXPECT_EQ(ExitStatus(writer), 0);
+  int slot = -1;
+  ASSERT_EQ(shared_rwlock_rdlock(rwlock, false, &slot), 0);
+  EXPECT_GE(slot, 0);
+  shared_rwlock_rdunlock(rwlock, slot);
+  ASSERT_EQ(shared_rwlock_wrlock(rwlock, false), 0);
+  shared_rwlock_wrunlock(rwlock);
+
+  close(ready[0]);
+  close(ready[1]);
+}
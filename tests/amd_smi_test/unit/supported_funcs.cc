@@ -0,0 +1,115 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include "rocm_smi/rocm_smi.h"
+#include "rocm_smi/rocm_smi_common.h"
+#include "rocm_smi/rocm_smi_device.h"
+#include "rocm_smi/rocm_smi_exception.h"
+#include "rocm_smi/rocm_smi_utils.h"
+
+namespace {
+
+// A bare device directory; functions without sysfs dependencies are
+// supported on it
+class SupportedFuncsTree {
+ public:
+  SupportedFuncsTree() {
+    char tmpl[] = "/tmp/rsmi_funcs_XXXXXX";
+    const char* root = mkdtemp(tmpl);
+    EXPECT_NE(root, nullptr);
+    root_ = root != nullptr ? root : "";
+    card_ = root_ + "/card_funcs_" + std::to_string(getpid());
+    mkdir(card_.c_str(), 0755);
+    mkdir((card_ + "/device").c_str(), 0755);
+  }
+  ~SupportedFuncsTree() {
+    rmdir((card_ + "/device").c_str());
+    rmdir(card_.c_str());
+    rmdir(root_.c_str());
+  }
+  const std::string& card(void) const { return card_; }
+
+ private:
+  std::string root_;
+  std::string card_;
+};
+
+// Named after the API so CHK_API_SUPPORT_ONLY looks up its entry, as the
+// nullptr query of rsmi_dev_counter_group_create() does
+rsmi_status_t rsmi_dev_counter_group_create(amd::smi::Device* dev,
+                                            rsmi_event_group_handle_t* grp_handle) {
+  CHK_API_SUPPORT_ONLY(grp_handle, RSMI_DEFAULT_VARIANT, RSMI_DEFAULT_VARIANT)
+  return RSMI_STATUS_SUCCESS;
+}
+
+}  // namespace
+
+TEST(amdsmitstUnit, SupportedFuncsCounterGroupCreate) {
+  const amd::smi::SupportedFuncId id =
+      amd::smi::SupportedFuncIdFromName("rsmi_dev_counter_group_create");
+  ASSERT_NE(id, amd::smi::kSupportedFuncInvalid);
+  EXPECT_EQ(amd::smi::SupportedFuncFamily(id), amd::smi::kSupportFamilyDevice);
+
+  SupportedFuncsTree tree;
+  RocmSMI_env_vars env{};
+  amd::smi::Device dev(tree.card(), &env);
+
+  // The support query of a supported function reports the nullptr argument
+  EXPECT_EQ(rsmi_dev_counter_group_create(&dev, nullptr),
+            RSMI_STATUS_INVALID_ARGS);
+
+  // ...and the function is listed with the others
+  uint64_t bitmap[amd::smi::kSupportedFuncWords] = {};
+  dev.supportedFuncBitmap(bitmap);
+  EXPECT_NE(bitmap[id / 64] & (1ULL << (id % 64)), 0U);
+}
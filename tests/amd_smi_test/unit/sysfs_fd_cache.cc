@@ -0,0 +1,208 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "rocm_smi/rocm_smi.h"
+#include "rocm_smi/rocm_smi_common.h"
+#include "rocm_smi/rocm_smi_device.h"
+
+namespace {
+
+// A bare device directory holding the attributes the test needs
+class SysfsFdCacheTree {
+ public:
+  SysfsFdCacheTree() {
+    char tmpl[] = "/tmp/rsmi_fd_cache_XXXXXX";
+    const char* root = mkdtemp(tmpl);
+    EXPECT_NE(root, nullptr);
+    root_ = root != nullptr ? root : "";
+    card_ = root_ + "/card_fd_cache_" + std::to_string(getpid());
+    mkdir(card_.c_str(), 0755);
+    mkdir((card_ + "/device").c_str(), 0755);
+  }
+  ~SysfsFdCacheTree() {
+    unlink((card_ + "/device/power_dpm_force_performance_level").c_str());
+    rmdir((card_ + "/device").c_str());
+    rmdir(card_.c_str());
+    rmdir(root_.c_str());
+  }
+
+  // Rewrites the attribute in place, as the kernel does; its inode and any
+  // open descriptor stay valid
+  void write_perf_level(const char* level) {
+    std::ofstream fs(card_ + "/device/power_dpm_force_performance_level",
+                     std::ios::out | std::ios::trunc);
+    fs << level << "\n";
+  }
+  const std::string& card(void) const { return card_; }
+
+ private:
+  std::string root_;
+  std::string card_;
+};
+
+rsmi_sysfs_fd_cache_stats_t Stats(amd::smi::Device* dev) {
+  rsmi_sysfs_fd_cache_stats_t stats{};
+  dev->sysfs_fd_cache_stats(&stats);
+  return stats;
+}
+
+}  // namespace
+
+TEST(amdsmitstUnit, SysfsFdCacheHitsAndMisses) {
+  SysfsFdCacheTree tree;
+  tree.write_perf_level("auto");
+  RocmSMI_env_vars env{};
+  amd::smi::Device dev(tree.card(), &env);
+  dev.set_sysfs_fd_cache_enabled(true);
+
+  std::string val;
+  ASSERT_EQ(dev.readDevInfo(amd::smi::kDevPerfLevel, &val), 0);
+  EXPECT_EQ(val, "auto");
+  rsmi_sysfs_fd_cache_stats_t stats = Stats(&dev);
+  EXPECT_EQ(stats.enabled, 1U);
+  EXPECT_EQ(stats.misses, 1U);
+  EXPECT_EQ(stats.hits, 0U);
+  EXPECT_EQ(stats.open_fds, 1U);
+
+  // Served from the open descriptor, which sees the new contents
+  tree.write_perf_level("manual");
+  ASSERT_EQ(dev.readDevInfo(amd::smi::kDevPerfLevel, &val), 0);
+  EXPECT_EQ(val, "manual");
+  stats = Stats(&dev);
+  EXPECT_EQ(stats.misses, 1U);
+  EXPECT_EQ(stats.hits, 1U);
+  EXPECT_EQ(stats.open_fds, 1U);
+
+  // A missing attribute is a miss every time and keeps no descriptor
+  EXPECT_NE(dev.readDevInfo(amd::smi::kDevVBiosVer, &val), 0);
+  EXPECT_NE(dev.readDevInfo(amd::smi::kDevVBiosVer, &val), 0);
+  stats = Stats(&dev);
+  EXPECT_EQ(stats.misses, 3U);
+  EXPECT_EQ(stats.hits, 1U);
+  EXPECT_EQ(stats.open_fds, 1U);
+}
+
+TEST(amdsmitstUnit, SysfsFdCacheInvalidation) {
+  SysfsFdCacheTree tree;
+  tree.write_perf_level("auto");
+  RocmSMI_env_vars env{};
+  amd::smi::Device dev(tree.card(), &env);
+  dev.set_sysfs_fd_cache_enabled(true);
+
+  std::string val;
+  ASSERT_EQ(dev.readDevInfo(amd::smi::kDevPerfLevel, &val), 0);
+  dev.invalidateSysfsFdCache();
+  rsmi_sysfs_fd_cache_stats_t stats = Stats(&dev);
+  EXPECT_EQ(stats.invalidations, 1U);
+  EXPECT_EQ(stats.open_fds, 0U);
+
+  // Nothing cached: a second invalidation is not counted
+  dev.invalidateSysfsFdCache();
+  EXPECT_EQ(Stats(&dev).invalidations, 1U);
+
+  // The next read opens the attribute again
+  ASSERT_EQ(dev.readDevInfo(amd::smi::kDevPerfLevel, &val), 0);
+  EXPECT_EQ(val, "auto");
+  stats = Stats(&dev);
+  EXPECT_EQ(stats.misses, 2U);
+  EXPECT_EQ(stats.open_fds, 1U);
+
+  // Disabling the cache closes everything; reads go through the stream path
+  dev.set_sysfs_fd_cache_enabled(false);
+  tree.write_perf_level("high");
+  ASSERT_EQ(dev.readDevInfo(amd::smi::kDevPerfLevel, &val), 0);
+  EXPECT_EQ(val, "high");
+  stats = Stats(&dev);
+  EXPECT_EQ(stats.enabled, 0U);
+  EXPECT_EQ(stats.open_fds, 0U);
+  EXPECT_EQ(stats.misses, 2U);
+  EXPECT_EQ(stats.hits, 0U);
+}
+
+TEST(amdsmitstUnit, SysfsFdCacheConcurrentInvalidation) {
+  SysfsFdCacheTree tree;
+  tree.write_perf_level("auto");
+  RocmSMI_env_vars env{};
+  amd::smi::Device dev(tree.card(), &env);
+  dev.set_sysfs_fd_cache_enabled(true);
+
+  // Readers keep their descriptor across an invalidation, so every read
+  // returns the attribute even while the cache is being dropped
+  std::atomic<uint32_t> bad_reads(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&dev, &bad_reads]() {
+      std::string val;
+      for (int i = 0; i < 2000; ++i) {
+        if (dev.readDevInfo(amd::smi::kDevPerfLevel, &val) != 0 ||
+            val != "auto") {
+          ++bad_reads;
+        }
+      }
+    });
+  }
+  for (int i = 0; i < 200; ++i) {
+    dev.invalidateSysfsFdCache();
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(bad_reads, 0U);
+  rsmi_sysfs_fd_cache_stats_t stats = Stats(&dev);
+  EXPECT_EQ(stats.hits + stats.misses, 4U * 2000U);
+  EXPECT_LE(stats.open_fds, 1U);
+}
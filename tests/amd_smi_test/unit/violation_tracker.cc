@@ -0,0 +1,175 @@
+/*
+ * =============================================================================
+ *   ROC Runtime Conformance Release License
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+#include <stdint.h>
+
+#include <limits>
+
+#include <gtest/gtest.h>
+#include "amd_smi/amdsmi.h"
+#include "amd_smi/impl/amd_smi_violation.h"
+
+namespace {
+
+using amd::smi::AMDSmiViolationResidency;
+using amd::smi::AMDSmiViolationSample;
+using amd::smi::AMDSmiViolationTracker;
+
+constexpr uint64_t kUnsupported = std::numeric_limits<uint64_t>::max();
+constexpr uint64_t kSecondUs = 1000000;
+
+// One accumulator tick per ms; PROCHOT is asserted prochot_pct of the time
+// since t = 0 and PPT is not reported.
+AMDSmiViolationSample MakeSample(uint64_t time_us, uint64_t prochot_pct) {
+  AMDSmiViolationSample sample{};
+  sample.time_us = time_us;
+  sample.acc_counter = time_us / 1000;
+  sample.residency_acc[amd::smi::kViolationProchotThrm] =
+      sample.acc_counter * prochot_pct / 100;
+  sample.residency_acc[amd::smi::kViolationPptPwr] = kUnsupported;
+  return sample;
+}
+
+}  // namespace
+
+TEST(amdsmitstUnit, ViolationTrackerUpdate) {
+  AMDSmiViolationTracker tracker;
+  AMDSmiViolationResidency residency{};
+
+  EXPECT_FALSE(tracker.update(MakeSample(kSecondUs, 40), &residency));
+  ASSERT_TRUE(tracker.update(MakeSample(2 * kSecondUs, 40), &residency));
+  EXPECT_EQ(residency.window_us, kSecondUs);
+  EXPECT_EQ(residency.percent[amd::smi::kViolationProchotThrm], 40U);
+  EXPECT_EQ(residency.percent[amd::smi::kViolationPptPwr], kUnsupported);
+  EXPECT_EQ(residency.percent[amd::smi::kViolationSocketThrm], 0U);
+
+  // Same accumulator counter: the last result is returned again
+  AMDSmiViolationSample stale = MakeSample(2 * kSecondUs, 40);
+  stale.time_us += 100;
+  ASSERT_TRUE(tracker.update(stale, &residency));
+  EXPECT_EQ(residency.window_us, kSecondUs);
+
+  // The accumulators went back: no result until the next sample
+  EXPECT_FALSE(tracker.update(MakeSample(kSecondUs / 2, 40), &residency));
+  ASSERT_TRUE(tracker.update(MakeSample(kSecondUs, 40), &residency));
+  EXPECT_EQ(residency.window_us, kSecondUs / 2);
+}
+
+TEST(amdsmitstUnit, ViolationTrackerWindows) {
+  AMDSmiViolationTracker tracker;
+  amdsmi_violation_window_stats_t stats{};
+
+  // Nothing kept yet
+  tracker.window_stats(MakeSample(kSecondUs, 50), kSecondUs, &stats);
+  EXPECT_EQ(stats.num_samples, 0U);
+  EXPECT_EQ(stats.per_prochot_thrm, kUnsupported);
+
+  // 20 s of samples every 100 ms; only every 250 ms or more is kept
+  for (uint64_t t = 0; t <= 20 * kSecondUs; t += kSecondUs / 10) {
+    tracker.record(MakeSample(t, 50));
+  }
+
+  const AMDSmiViolationSample now = MakeSample(20 * kSecondUs + 50000, 50);
+  tracker.window_stats(now, kSecondUs, &stats);
+  EXPECT_EQ(stats.window_us, kSecondUs);
+  EXPECT_LE(stats.covered_us, kSecondUs);
+  EXPECT_GE(stats.covered_us, kSecondUs - AMDSmiViolationTracker::kHistorySpacingUs);
+  EXPECT_EQ(stats.per_prochot_thrm, 50U);
+  EXPECT_EQ(stats.per_ppt_pwr, kUnsupported);
+  EXPECT_EQ(stats.per_hbm_thrm, 0U);
+
+  tracker.window_stats(now, 10 * kSecondUs, &stats);
+  EXPECT_GT(stats.covered_us, 9 * kSecondUs);
+  EXPECT_LE(stats.covered_us, 10 * kSecondUs);
+
+  // Longer than what was recorded: covers all kept samples
+  tracker.window_stats(now, 60 * kSecondUs, &stats);
+  EXPECT_EQ(stats.covered_us, now.time_us);
+  EXPECT_GT(stats.num_samples, 1U);
+
+  // Samples newer than the caller's are ignored
+  tracker.window_stats(MakeSample(10 * kSecondUs, 50), kSecondUs, &stats);
+  EXPECT_LE(stats.covered_us, kSecondUs);
+  EXPECT_EQ(stats.per_prochot_thrm, 50U);
+}
+
+TEST(amdsmitstUnit, ViolationTrackerWindowsKeepBaseline) {
+  AMDSmiViolationTracker tracker;
+  AMDSmiViolationResidency residency{};
+  amdsmi_violation_window_stats_t stats{};
+
+  EXPECT_FALSE(tracker.update(MakeSample(kSecondUs, 30), &residency));
+
+  // Another caller polls the windows in between
+  for (uint64_t t = kSecondUs; t <= 5 * kSecondUs; t += kSecondUs / 2) {
+    const AMDSmiViolationSample sample = MakeSample(t, 30);
+    tracker.record(sample);
+    tracker.window_stats(sample, kSecondUs, &stats);
+  }
+
+  // The residency still covers the interval since the previous update()
+  ASSERT_TRUE(tracker.update(MakeSample(6 * kSecondUs, 30), &residency));
+  EXPECT_EQ(residency.window_us, 5 * kSecondUs);
+  EXPECT_EQ(residency.percent[amd::smi::kViolationProchotThrm], 30U);
+}
+
+TEST(amdsmitstUnit, ViolationTrackerWindowsReset) {
+  AMDSmiViolationTracker tracker;
+  amdsmi_violation_window_stats_t stats{};
+
+  for (uint64_t t = 0; t <= 5 * kSecondUs; t += kSecondUs / 2) {
+    tracker.record(MakeSample(t, 10));
+  }
+
+  // Driver reload: accumulators restart, older samples must not be used
+  AMDSmiViolationSample restarted = MakeSample(0, 10);
+  restarted.time_us = 6 * kSecondUs;
+  tracker.record(restarted);
+  AMDSmiViolationSample now = MakeSample(kSecondUs / 2, 10);
+  now.time_us = 6 * kSecondUs + kSecondUs / 2;
+  tracker.window_stats(now, 10 * kSecondUs, &stats);
+  EXPECT_EQ(stats.covered_us, kSecondUs / 2);
+  EXPECT_EQ(stats.num_samples, 2U);
+}
@@ -0,0 +1,465 @@
+/*
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+/*
+ * Stub ESMI backend, built instead of the esmi_ib_library sources when
+ * BUILD_ESMI_STUB is ON. It implements the e_smi.h calls used by amd-smi with
+ * synthetic values so the CPU paths can be exercised without an AMD CPU or
+ * the hsmp/energy drivers. The topology is taken from the environment:
+ *
+ *   ESMI_STUB_SOCKETS   number of sockets          (default 2)
+ *   ESMI_STUB_CPUS      number of logical cpus     (default 128)
+ *   ESMI_STUB_THREADS   threads per core           (default 2)
+ *
+ * Energy counters grow with CLOCK_MONOTONIC so successive reads increase.
+ * Socket power and energy, and the core boost and frequency limits, are
+ * offset by the socket or core index.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <e_smi/e_smi.h>
+
+static uint32_t stub_sockets = 2;
+static uint32_t stub_cpus = 128;
+static uint32_t stub_threads = 2;
+
+static uint32_t stub_env_u32(const char *name, uint32_t def) {
+    const char *val = getenv(name);
+    if (val == NULL || *val == '\0')
+        return def;
+    unsigned long v = strtoul(val, NULL, 0);
+    return v ? (uint32_t)v : def;
+}
+
+static uint32_t stub_cores(void) {
+    return stub_cpus / stub_threads;
+}
+
+static esmi_status_t stub_check_socket(uint32_t sock_ind) {
+    return sock_ind < stub_sockets ? ESMI_SUCCESS : ESMI_INVALID_INPUT;
+}
+
+static esmi_status_t stub_check_core(uint32_t core_ind) {
+    return core_ind < stub_cores() ? ESMI_SUCCESS : ESMI_INVALID_INPUT;
+}
+
+/* Microseconds since boot, used as the base of the energy counters */
+static uint64_t stub_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+esmi_status_t esmi_init(void) {
+    stub_sockets = stub_env_u32("ESMI_STUB_SOCKETS", 2);
+    stub_cpus = stub_env_u32("ESMI_STUB_CPUS", 128);
+    stub_threads = stub_env_u32("ESMI_STUB_THREADS", 2);
+    if (stub_cpus < stub_threads * stub_sockets)
+        return ESMI_INVALID_INPUT;
+    return ESMI_SUCCESS;
+}
+
+void esmi_exit(void) {
+}
+
+char *esmi_get_err_msg(esmi_status_t esmi_err) {
+    switch (esmi_err) {
+    case ESMI_SUCCESS:
+        return "Success";
+    case ESMI_INVALID_INPUT:
+        return "Input value is invalid";
+    case ESMI_ARG_PTR_NULL:
+        return "Invalid buffer";
+    case ESMI_NOT_SUPPORTED:
+        return "Not supported by the ESMI stub";
+    default:
+        return "Unknown error";
+    }
+}
+
+/* Topology */
+esmi_status_t esmi_cpu_family_get(uint32_t *family) {
+    if (family == NULL)
+        return ESMI_ARG_PTR_NULL;
+    *family = 0x19;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_cpu_model_get(uint32_t *model) {
+    if (model == NULL)
+        return ESMI_ARG_PTR_NULL;
+    *model = 0x10;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_threads_per_core_get(uint32_t *threads) {
+    if (threads == NULL)
+        return ESMI_ARG_PTR_NULL;
+    *threads = stub_threads;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_number_of_cpus_get(uint32_t *cpus) {
+    if (cpus == NULL)
+        return ESMI_ARG_PTR_NULL;
+    *cpus = stub_cpus;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_number_of_sockets_get(uint32_t *sockets) {
+    if (sockets == NULL)
+        return ESMI_ARG_PTR_NULL;
+    *sockets = stub_sockets;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_first_online_core_on_socket(uint32_t socket_idx, uint32_t *pcore_ind) {
+    if (pcore_ind == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(socket_idx) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *pcore_ind = socket_idx * (stub_cores() / stub_sockets);
+    return ESMI_SUCCESS;
+}
+
+/* Energy */
+esmi_status_t esmi_core_energy_get(uint32_t core_ind, uint64_t *penergy) {
+    if (penergy == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_core(core_ind) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    /* ~1W per core */
+    *penergy = stub_now_us() + core_ind;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_socket_energy_get(uint32_t socket_idx, uint64_t *penergy) {
+    if (penergy == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(socket_idx) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    /* ~100W per socket */
+    *penergy = stub_now_us() * 100 + socket_idx;
+    return ESMI_SUCCESS;
+}
+
+/* HSMP system statistics */
+esmi_status_t esmi_hsmp_proto_ver_get(uint32_t *proto_ver) {
+    if (proto_ver == NULL)
+        return ESMI_ARG_PTR_NULL;
+    *proto_ver = 5;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_smu_fw_version_get(struct smu_fw_version *smu_fw) {
+    if (smu_fw == NULL)
+        return ESMI_ARG_PTR_NULL;
+    smu_fw->major = 1;
+    smu_fw->minor = 0;
+    smu_fw->debug = 0;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_prochot_status_get(uint32_t socket_idx, uint32_t *prochot) {
+    if (prochot == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(socket_idx) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *prochot = 0;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_fclk_mclk_get(uint32_t socket_idx, uint32_t *fclk, uint32_t *mclk) {
+    if (fclk == NULL || mclk == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(socket_idx) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *fclk = 2000;
+    *mclk = 2400;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_cclk_limit_get(uint32_t socket_idx, uint32_t *cclk) {
+    if (cclk == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(socket_idx) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *cclk = 3500;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_socket_current_active_freq_limit_get(uint32_t sock_ind, uint16_t *freq,
+                                                        char **src_type) {
+    if (freq == NULL || src_type == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(sock_ind) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *freq = 3500;
+    src_type[0] = "OPN Max";
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_socket_freq_range_get(uint8_t sock_ind, uint16_t *fmax, uint16_t *fmin) {
+    if (fmax == NULL || fmin == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(sock_ind) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *fmax = 3700;
+    *fmin = 400;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_current_freq_limit_core_get(uint32_t core_id, uint32_t *freq) {
+    if (freq == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_core(core_id) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *freq = 2000 + core_id;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_socket_c0_residency_get(uint32_t socket_idx, uint32_t *pc0_residency) {
+    if (pc0_residency == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(socket_idx) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *pc0_residency = 42;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_socket_temperature_get(uint32_t sock_ind, uint32_t *ptmon) {
+    if (ptmon == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(sock_ind) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    /* millidegrees Celsius */
+    *ptmon = 45000 + sock_ind * 1000;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_ddr_bw_get(struct ddr_bw_metrics *ddr_bw) {
+    if (ddr_bw == NULL)
+        return ESMI_ARG_PTR_NULL;
+    ddr_bw->max_bw = 400;
+    ddr_bw->utilized_bw = 100;
+    ddr_bw->utilized_pct = 25;
+    return ESMI_SUCCESS;
+}
+
+/* Power */
+esmi_status_t esmi_socket_power_get(uint32_t socket_idx, uint32_t *ppower) {
+    if (ppower == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(socket_idx) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *ppower = 100000 + socket_idx * 1000;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_socket_power_cap_get(uint32_t socket_idx, uint32_t *pcap) {
+    if (pcap == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(socket_idx) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *pcap = 280000;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_socket_power_cap_max_get(uint32_t socket_idx, uint32_t *pmax) {
+    if (pmax == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(socket_idx) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *pmax = 400000;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_pwr_svi_telemetry_all_rails_get(uint32_t sock_ind, uint32_t *power) {
+    if (power == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(sock_ind) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *power = 90000;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_core_boostlimit_get(uint32_t cpu_ind, uint32_t *pboostlimit) {
+    if (pboostlimit == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_core(cpu_ind) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    *pboostlimit = 3000 + cpu_ind;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_metrics_table_version_get(uint32_t *metrics_version) {
+    if (metrics_version == NULL)
+        return ESMI_ARG_PTR_NULL;
+    *metrics_version = 0;
+    return ESMI_SUCCESS;
+}
+
+esmi_status_t esmi_metrics_table_get(uint8_t sock_ind, struct hsmp_metric_table *metrics_table) {
+    if (metrics_table == NULL)
+        return ESMI_ARG_PTR_NULL;
+    if (stub_check_socket(sock_ind) != ESMI_SUCCESS)
+        return ESMI_INVALID_INPUT;
+    memset(metrics_table, 0, sizeof(*metrics_table));
+    return ESMI_SUCCESS;
+}
+
+/*
+ * Controls and platform specific queries are not emulated; they validate the
+ * arguments like the real library and report ESMI_NOT_SUPPORTED.
+ */
+esmi_status_t esmi_socket_power_cap_set(uint32_t socket_idx, uint32_t pcap) {
+    (void)pcap;
+    return stub_check_socket(socket_idx) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_pwr_efficiency_mode_set(uint8_t sock_ind, uint8_t mode) {
+    (void)mode;
+    return stub_check_socket(sock_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_core_boostlimit_set(uint32_t cpu_ind, uint32_t boostlimit) {
+    (void)boostlimit;
+    return stub_check_core(cpu_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_socket_boostlimit_set(uint32_t socket_idx, uint32_t boostlimit) {
+    (void)boostlimit;
+    return stub_check_socket(socket_idx) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_dimm_temp_range_and_refresh_rate_get(uint8_t sock_ind, uint8_t dimm_addr,
+                                                        struct temp_range_refresh_rate *rate) {
+    (void)dimm_addr;
+    if (rate == NULL)
+        return ESMI_ARG_PTR_NULL;
+    return stub_check_socket(sock_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_dimm_power_consumption_get(uint8_t sock_ind, uint8_t dimm_addr,
+                                              struct dimm_power *dimm_pow) {
+    (void)dimm_addr;
+    if (dimm_pow == NULL)
+        return ESMI_ARG_PTR_NULL;
+    return stub_check_socket(sock_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_dimm_thermal_sensor_get(uint8_t sock_ind, uint8_t dimm_addr,
+                                           struct dimm_thermal *dimm_temp) {
+    (void)dimm_addr;
+    if (dimm_temp == NULL)
+        return ESMI_ARG_PTR_NULL;
+    return stub_check_socket(sock_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_xgmi_width_set(uint8_t min, uint8_t max) {
+    return min > max ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_gmi3_link_width_range_set(uint8_t sock_ind, uint8_t min_link_width,
+                                             uint8_t max_link_width) {
+    if (min_link_width > max_link_width)
+        return ESMI_INVALID_INPUT;
+    return stub_check_socket(sock_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_apb_enable(uint32_t sock_ind) {
+    return stub_check_socket(sock_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_apb_disable(uint32_t sock_ind, uint8_t pstate) {
+    (void)pstate;
+    return stub_check_socket(sock_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_socket_lclk_dpm_level_set(uint32_t sock_ind, uint8_t nbio_id,
+                                             uint8_t min, uint8_t max) {
+    (void)nbio_id;
+    if (min > max)
+        return ESMI_INVALID_INPUT;
+    return stub_check_socket(sock_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_socket_lclk_dpm_level_get(uint8_t sock_ind, uint8_t nbio_id,
+                                             struct dpm_level *nbio) {
+    (void)nbio_id;
+    if (nbio == NULL)
+        return ESMI_ARG_PTR_NULL;
+    return stub_check_socket(sock_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_pcie_link_rate_set(uint8_t sock_ind, uint8_t rate_ctrl, uint8_t *prev_mode) {
+    (void)rate_ctrl;
+    if (prev_mode == NULL)
+        return ESMI_ARG_PTR_NULL;
+    return stub_check_socket(sock_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_df_pstate_range_set(uint8_t sock_ind, uint8_t max_pstate,
+                                       uint8_t min_pstate) {
+    if (max_pstate > min_pstate)
+        return ESMI_INVALID_INPUT;
+    return stub_check_socket(sock_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_current_io_bandwidth_get(uint8_t sock_ind, struct link_id_bw_type link,
+                                            uint32_t *io_bw) {
+    (void)link;
+    if (io_bw == NULL)
+        return ESMI_ARG_PTR_NULL;
+    return stub_check_socket(sock_ind) ? ESMI_INVALID_INPUT : ESMI_NOT_SUPPORTED;
+}
+
+esmi_status_t esmi_current_xgmi_bw_get(struct link_id_bw_type link, uint32_t *xgmi_bw) {
+    (void)link;
+    if (xgmi_bw == NULL)
+        return ESMI_ARG_PTR_NULL;
+    return ESMI_NOT_SUPPORTED;
+}
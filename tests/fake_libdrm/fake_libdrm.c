@@ -0,0 +1,202 @@
+/*
+ * =============================================================================
+ * The University of Illinois/NCSA
+ * Open Source License (NCSA)
+ *
+ * Copyright (c) 2024, Advanced Micro Devices, Inc.
+ * All rights reserved.
+ *
+ * Developed by:
+ *
+ *                 AMD Research and AMD ROC Software Development
+ *
+ *                 Advanced Micro Devices, Inc.
+ *
+ *                 www.amd.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal with the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ *  - Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimers.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimers in
+ *    the documentation and/or other materials provided with the distribution.
+ *  - Neither the names of <Name of Development Group, Name of Institution>,
+ *    nor the names of its contributors may be used to endorse or promote
+ *    products derived from this Software without specific prior written
+ *    permission.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE CONTRIBUTORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS WITH THE SOFTWARE.
+ *
+ */
+
+/*
+ * In-process stand-in for libdrm, for running amd-smi against a synthetic
+ * tree (tools/fake_sysfs_tree.py) where /dev/dri/renderD* are plain files.
+ * amd-smi dlopen()s it in place of libdrm.so.2 when AMDSMI_LIBDRM_PATH
+ * names it (non-Release or -DENABLE_TEST_OVERRIDES=ON builds only):
+ *
+ *   RSMI_FS_ROOT=/tmp/fake_root AMDSMI_LIBDRM_PATH=.../libfake_libdrm.so amd-smi
+ *
+ * It implements the entry points amd-smi loads and answers the memory and
+ * device info DRM_AMDGPU_INFO queries; all others fail with -EINVAL. Values
+ * depend on the render minor of the fd, so each GPU reports its own usage.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <xf86drm.h>
+
+#include "amd_smi/impl/amdgpu_drm.h"
+
+#define FAKE_GIB (1024ULL * 1024 * 1024)
+#define FAKE_MIB (1024ULL * 1024)
+#define FAKE_FIRST_RENDER_MINOR 128
+
+/* GPU index of a render node fd, from the renderD<minor> name it points to */
+static unsigned fake_gpu_index(int fd) {
+    char link[64];
+    char path[4096];
+    snprintf(link, sizeof(link), "/proc/self/fd/%d", fd);
+    ssize_t len = readlink(link, path, sizeof(path) - 1);
+    if (len <= 0)
+        return 0;
+    path[len] = '\0';
+    const char *name = strstr(path, "renderD");
+    if (name == NULL)
+        return 0;
+    unsigned minor = (unsigned)strtoul(name + strlen("renderD"), NULL, 10);
+    return minor >= FAKE_FIRST_RENDER_MINOR ? minor - FAKE_FIRST_RENDER_MINOR : 0;
+}
+
+static void fake_heap(struct drm_amdgpu_heap_info *heap, uint64_t total,
+                      uint64_t reserved, uint64_t usage) {
+    heap->total_heap_size = total;
+    heap->usable_heap_size = total - reserved;
+    heap->heap_usage = usage;
+    heap->max_allocation = heap->usable_heap_size * 3 / 4;
+}
+
+static void fake_memory_info(unsigned gpu, struct drm_amdgpu_memory_info *mem) {
+    memset(mem, 0, sizeof(*mem));
+    fake_heap(&mem->vram, 64 * FAKE_GIB, 512 * FAKE_MIB, (gpu + 1) * FAKE_GIB);
+    fake_heap(&mem->cpu_accessible_vram, 256 * FAKE_MIB, 0, (gpu + 1) * 8 * FAKE_MIB);
+    fake_heap(&mem->gtt, 128 * FAKE_GIB, 0, (gpu + 1) * 256 * FAKE_MIB);
+}
+
+/* Copies at most return_size bytes of the answer, like the kernel does */
+static int fake_reply(struct drm_amdgpu_info *request, const void *value, size_t size) {
+    void *out = (void *)(uintptr_t)request->return_pointer;
+    if (out == NULL)
+        return -EFAULT;
+    memcpy(out, value, size < request->return_size ? size : request->return_size);
+    return 0;
+}
+
+static int fake_amdgpu_info(int fd, struct drm_amdgpu_info *request) {
+    unsigned gpu = fake_gpu_index(fd);
+    struct drm_amdgpu_memory_info mem;
+    fake_memory_info(gpu, &mem);
+
+    switch (request->query) {
+    case AMDGPU_INFO_MEMORY:
+        return fake_reply(request, &mem, sizeof(mem));
+    case AMDGPU_INFO_VRAM_GTT: {
+        struct drm_amdgpu_info_vram_gtt vram_gtt;
+        vram_gtt.vram_size = mem.vram.usable_heap_size;
+        vram_gtt.vram_cpu_accessible_size = mem.cpu_accessible_vram.usable_heap_size;
+        vram_gtt.gtt_size = mem.gtt.usable_heap_size;
+        return fake_reply(request, &vram_gtt, sizeof(vram_gtt));
+    }
+    case AMDGPU_INFO_VRAM_USAGE:
+        return fake_reply(request, &mem.vram.heap_usage, sizeof(uint64_t));
+    case AMDGPU_INFO_VIS_VRAM_USAGE:
+        return fake_reply(request, &mem.cpu_accessible_vram.heap_usage, sizeof(uint64_t));
+    case AMDGPU_INFO_GTT_USAGE:
+        return fake_reply(request, &mem.gtt.heap_usage, sizeof(uint64_t));
+    case AMDGPU_INFO_DEV_INFO: {
+        struct drm_amdgpu_info_device dev_info;
+        memset(&dev_info, 0, sizeof(dev_info));
+        dev_info.device_id = 0x74a1;
+        dev_info.vram_type = AMDGPU_VRAM_TYPE_HBM;
+        dev_info.vram_bit_width = 8192;
+        return fake_reply(request, &dev_info, sizeof(dev_info));
+    }
+    default:
+        return -EINVAL;
+    }
+}
+
+int drmCommandWrite(int fd, unsigned long drmCommandIndex, void *data,
+                    unsigned long size) {
+    if (drmCommandIndex != DRM_AMDGPU_INFO || size != sizeof(struct drm_amdgpu_info))
+        return -EINVAL;
+    return fake_amdgpu_info(fd, (struct drm_amdgpu_info *)data);
+}
+
+drmVersionPtr drmGetVersion(int fd) {
+    (void)fd;
+    drmVersionPtr version = calloc(1, sizeof(*version));
+    if (version == NULL)
+        return NULL;
+    version->version_major = 3;
+    version->version_minor = 57;
+    version->name = strdup("amdgpu");
+    version->name_len = (int)strlen(version->name);
+    version->date = strdup("20150101");
+    version->date_len = (int)strlen(version->date);
+    version->desc = strdup("AMD GPU");
+    version->desc_len = (int)strlen(version->desc);
+    return version;
+}
+
+void drmFreeVersion(drmVersionPtr version) {
+    if (version == NULL)
+        return;
+    free(version->name);
+    free(version->date);
+    free(version->desc);
+    free(version);
+}
+
+int drmGetDevice(int fd, drmDevicePtr *device) {
+    if (device == NULL)
+        return -EINVAL;
+    /* One block, freed by drmFreeDevice(), like libdrm does */
+    struct fake_device {
+        drmDevice dev;
+        drmPciBusInfo bus;
+        drmPciDeviceInfo info;
+    } *fake = calloc(1, sizeof(*fake));
+    if (fake == NULL)
+        return -ENOMEM;
+    fake->bus.bus = (uint8_t)fake_gpu_index(fd);
+    fake->info.vendor_id = 0x1002;
+    fake->info.device_id = 0x74a1;
+    fake->dev.bustype = DRM_BUS_PCI;
+    fake->dev.businfo.pci = &fake->bus;
+    fake->dev.deviceinfo.pci = &fake->info;
+    *device = &fake->dev;
+    return 0;
+}
+
+void drmFreeDevice(drmDevicePtr *device) {
+    if (device == NULL)
+        return;
+    free(*device);
+    *device = NULL;
+}
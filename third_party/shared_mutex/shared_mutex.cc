@@ -38,6 +38,8 @@ THE SOFTWARE.
 #include <sys/types.h>
 #include <dirent.h>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -342,3 +344,224 @@ int shared_mutex_destroy(shared_mutex_t mutex) {
   free(mutex.name);
   return 0;
 }
+
+// Returns 0 if the robust mutex was locked
+static int lock_robust_mutex(pthread_mutex_t *mutex, bool blocking) {
+  int ret = blocking ? pthread_mutex_lock(mutex) : pthread_mutex_trylock(mutex);
+  if (ret == EOWNERDEAD) {
+    // The previous owner died holding it; we now own it
+    ret = pthread_mutex_consistent(mutex);
+  }
+  return ret;
+}
+
+// Initializes the robust reader slot mutexes of a new segment, once.
+// Returns 0 on success.
+static int init_reader_slots(shared_rwlock_data_t *data, pthread_mutex_t *writer) {
+  if (data->ready.load(std::memory_order_acquire)) {
+    return 0;
+  }
+  // A process that died half way leaves `ready` at 0; the next one redoes it
+  int ret = lock_robust_mutex(writer, true);
+  if (ret) {
+    return ret;
+  }
+  if (!data->ready.load(std::memory_order_relaxed)) {
+    pthread_mutexattr_t attr;
+    ret = pthread_mutexattr_init(&attr);
+    if (!ret) {
+      ret = pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    }
+    if (!ret) {
+      ret = pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    }
+    for (int i = 0; !ret && i < SHARED_RWLOCK_MAX_READERS; ++i) {
+      ret = pthread_mutex_init(&data->readers[i].owner, &attr);
+    }
+    pthread_mutexattr_destroy(&attr);
+    if (!ret) {
+      data->ready.store(1, std::memory_order_release);
+    }
+  }
+  pthread_mutex_unlock(writer);
+  return ret;
+}
+
+// Claims a free reader slot, or the slot of a reader that died, by locking
+// its mutex. Must be called with the writer mutex held, so no writer is
+// scanning the slots. Returns -1 if all are in use.
+static int claim_reader_slot(shared_rwlock_data_t *data) {
+  // Start where this thread found a free slot last time
+  static std::atomic<uint32_t> next_hint;
+  static thread_local int hint = static_cast<int>(
+      next_hint.fetch_add(1, std::memory_order_relaxed) % SHARED_RWLOCK_MAX_READERS);
+  for (int n = 0; n < SHARED_RWLOCK_MAX_READERS; ++n) {
+    const int i = (hint + n) % SHARED_RWLOCK_MAX_READERS;
+    if (lock_robust_mutex(&data->readers[i].owner, false) == 0) {
+      hint = i;
+      return i;
+    }
+  }
+  return -1;
+}
+
+shared_rwlock_t shared_rwlock_init(const char *name, mode_t mode,
+                                   pthread_mutex_t *writer) {
+  shared_rwlock_t rwlock = {nullptr, writer, -1, nullptr, 0, 0};
+  errno = 0;
+
+  int time_out = GetEnvVarUInteger(MUTEX_TIME_OUT_ENV_VAR);
+  rwlock.timeout_s = time_out < DEFAULT_MUTEX_TIMEOUT_SECONDS ?
+                                   DEFAULT_MUTEX_TIMEOUT_SECONDS : time_out;
+
+  amd::smi::RocmSMI& smi = amd::smi::RocmSMI::getInstance();
+
+  if (GetEnvVarUInteger(THREAD_ONLY_ENV_VAR) == 1 || smi.is_thread_only_mutex()) {
+    // RSMI_MUTEX_THREAD_ONLY = 1: only this process's threads use it
+    rwlock.ptr = new shared_rwlock_data_t();
+  } else {
+    rwlock.shm_fd = shm_open(name, O_RDWR, mode);
+    if (errno == ENOENT) {
+      rwlock.shm_fd = shm_open(name, O_RDWR|O_CREAT, mode);
+      rwlock.created = 1;
+      if (fchmod(rwlock.shm_fd, mode) != 0) {
+        perror("fchmod");
+      }
+    }
+    if (rwlock.shm_fd == -1) {
+      perror("shm_open");
+      return rwlock;
+    }
+
+    // A new segment is zero filled: slots not initialized yet
+    if (ftruncate(rwlock.shm_fd, sizeof(shared_rwlock_data_t)) != 0) {
+      perror("ftruncate");
+      close(rwlock.shm_fd);
+      return rwlock;
+    }
+
+    void *addr = mmap(
+      nullptr,
+      sizeof(shared_rwlock_data_t),
+      PROT_READ|PROT_WRITE,
+      MAP_SHARED,
+      rwlock.shm_fd,
+      0);
+
+    if (addr == MAP_FAILED) {
+      perror("mmap");
+      close(rwlock.shm_fd);
+      return rwlock;
+    }
+    rwlock.ptr = reinterpret_cast<shared_rwlock_data_t *>(addr);
+  }
+
+  errno = init_reader_slots(rwlock.ptr, writer);
+  if (errno) {
+    perror("pthread_mutex_init");
+    if (rwlock.shm_fd < 0) {
+      delete rwlock.ptr;
+    } else {
+      munmap(reinterpret_cast<void *>(rwlock.ptr), sizeof(shared_rwlock_data_t));
+      close(rwlock.shm_fd);
+    }
+    rwlock.ptr = nullptr;
+    return rwlock;
+  }
+
+  rwlock.name = reinterpret_cast<char *>(malloc(NAME_MAX+1));
+  (void)snprintf(rwlock.name, NAME_MAX + 1, "%s", name);
+  return rwlock;
+}
+
+int shared_rwlock_rdlock(shared_rwlock_t *rwlock, bool blocking, int *slot) {
+  int ret = lock_robust_mutex(rwlock->writer, blocking);
+  if (ret) {
+    return ret;
+  }
+
+  *slot = claim_reader_slot(rwlock->ptr);
+  if (*slot < 0) {
+    // Every slot is taken; keep the writer mutex for the whole read
+    return 0;
+  }
+  pthread_mutex_unlock(rwlock->writer);
+  return 0;
+}
+
+void shared_rwlock_rdunlock(shared_rwlock_t *rwlock, int slot) {
+  if (slot < 0) {
+    pthread_mutex_unlock(rwlock->writer);
+    return;
+  }
+  pthread_mutex_unlock(&rwlock->ptr->readers[slot].owner);
+}
+
+int shared_rwlock_wrlock(shared_rwlock_t *rwlock, bool blocking) {
+  int ret = lock_robust_mutex(rwlock->writer, blocking);
+  if (ret) {
+    return ret;
+  }
+
+  // No new reader can claim a slot now; wait for the current ones to leave
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  struct timespec deadline = now;
+  deadline.tv_sec += rwlock->timeout_s;
+  useconds_t wait_us = 10;
+  for (;;) {
+    bool busy = false;
+    for (auto &reader : rwlock->ptr->readers) {
+      ret = pthread_mutex_trylock(&reader.owner);
+      if (ret == EOWNERDEAD) {
+        // The reader died holding the lock; the kernel handed the slot to us
+        fprintf(stderr, "%d dropping the read hold of a dead thread on %s\n",
+                getpid(), rwlock->name);
+        ret = pthread_mutex_consistent(&reader.owner);
+      }
+      if (ret == 0) {
+        pthread_mutex_unlock(&reader.owner);
+      } else {
+        busy = true;
+      }
+    }
+    if (!busy) {
+      return 0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const bool expired = now.tv_sec > deadline.tv_sec ||
+        (now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec);
+    if (!blocking || expired) {
+      pthread_mutex_unlock(rwlock->writer);
+      return blocking ? ETIMEDOUT : EBUSY;
+    }
+    usleep(wait_us);
+    wait_us = std::min<useconds_t>(wait_us * 2, 1000);
+  }
+}
+
+void shared_rwlock_wrunlock(shared_rwlock_t *rwlock) {
+  pthread_mutex_unlock(rwlock->writer);
+}
+
+int shared_rwlock_close(shared_rwlock_t rwlock) {
+  if (rwlock.ptr == nullptr) {
+    return 0;
+  }
+  if (rwlock.shm_fd < 0) {
+    // thread only rwlock
+    delete rwlock.ptr;
+  } else {
+    if (munmap(reinterpret_cast<void *>(rwlock.ptr), sizeof(shared_rwlock_data_t))) {
+      perror("munmap");
+      return -1;
+    }
+    if (close(rwlock.shm_fd)) {
+      perror("close");
+      return -1;
+    }
+  }
+  free(rwlock.name);
+  return 0;
+}
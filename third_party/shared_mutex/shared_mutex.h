@@ -26,10 +26,13 @@ THE SOFTWARE.
 #define SRC_SHARED_MUTEX_SHARED_MUTEX_H_
 
 #include <sys/stat.h>
+#include <sys/types.h>
 
 #include <pthread.h>  // pthread_mutex_t, pthread_mutexattr_t,
                       // pthread_mutexattr_init, pthread_mutexattr_setpshared,
                       // pthread_mutex_init, pthread_mutex_destroy
+#include <atomic>
+#include <cstdint>
 
 // Structure of a shared mutex.
 typedef struct shared_mutex_t {
@@ -88,4 +91,69 @@ int shared_mutex_close(shared_mutex_t mutex);
 // **NOTE:** It will not unlock locked mutex.
 int shared_mutex_destroy(shared_mutex_t mutex);
 
+// Number of threads (of any process) that can hold a shared rwlock for
+// reading at once; further readers hold the writer mutex instead.
+#define SHARED_RWLOCK_MAX_READERS 64
+
+// Read hold of one thread on a shared rwlock. The reader holds `owner`, a
+// robust process-shared mutex, for its whole read hold, so the kernel tracks
+// who holds it, in any pid namespace, and reports its death (EOWNERDEAD).
+typedef struct shared_rwlock_slot_t {
+  pthread_mutex_t owner;
+} shared_rwlock_slot_t;
+
+// Shared memory part of a shared rwlock. A new segment is all zeros; the
+// slot mutexes are initialized once, by the first process to see `ready`
+// at 0, with the writer mutex held.
+typedef struct shared_rwlock_data_t {
+  std::atomic<uint32_t> ready;
+  shared_rwlock_slot_t readers[SHARED_RWLOCK_MAX_READERS];
+} shared_rwlock_data_t;
+
+// Structure of a shared reader/writer lock. It is built on a robust
+// process-shared mutex (`writer`), which writers hold for their whole hold
+// and readers only while claiming a free reader slot. A writer drops the
+// slot of a reader thread that died instead of waiting for it forever, the
+// same way the robust mutex recovers from a dead writer.
+typedef struct shared_rwlock_t {
+  shared_rwlock_data_t *ptr;  // Pointer to the shared memory segment.
+  pthread_mutex_t *writer;    // Robust mutex writers hold; not owned.
+  int shm_fd;                 // Descriptor of shared memory object.
+  char* name;                 // Name of the shared memory object.
+  int created;                // Equals 1 (true) if initialization
+                              // of this structure caused creation
+                              // of a new shared memory object.
+  int timeout_s;              // How long a writer waits for readers.
+} shared_rwlock_t;
+
+// Initialize a new shared rwlock with given `name`, or load the existing
+// one. `writer` must be a robust mutex shared by the same processes, e.g.
+// one from `shared_mutex_init`; it stays owned by the caller.
+//
+// Same error reporting and thread-safety caveats as `shared_mutex_init`.
+shared_rwlock_t shared_rwlock_init(const char *name, mode_t mode,
+                                   pthread_mutex_t *writer);
+
+// Take the rwlock for reading. `*slot` must be passed to
+// `shared_rwlock_rdunlock`, from the same thread. Not recursive.
+//
+// Returns 0, or EBUSY if `blocking` is false and a writer holds it.
+int shared_rwlock_rdlock(shared_rwlock_t *rwlock, bool blocking, int *slot);
+void shared_rwlock_rdunlock(shared_rwlock_t *rwlock, int slot);
+
+// Take the rwlock for writing. New readers are held off at once; readers
+// holding it are waited for, for up to RSMI_MUTEX_TIMEOUT seconds (default
+// 5). The holds of reader threads that no longer exist are dropped.
+//
+// Returns 0, EBUSY if `blocking` is false and it is held, or ETIMEDOUT if
+// live readers still hold it after the timeout.
+int shared_rwlock_wrlock(shared_rwlock_t *rwlock, bool blocking);
+void shared_rwlock_wrunlock(shared_rwlock_t *rwlock);
+
+// Close access to the shared rwlock and free the resources used by the
+// structure. The rwlock itself stays available to other processes.
+//
+// Returns 0 in case of success, -1 otherwise.
+int shared_rwlock_close(shared_rwlock_t rwlock);
+
 #endif  // SRC_SHARED_MUTEX_SHARED_MUTEX_H_
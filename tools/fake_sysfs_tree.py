@@ -0,0 +1,603 @@
+#
+# Copyright (C) 2024 Advanced Micro Devices. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+#
+
+
+"""
+Builds a synthetic sysfs/procfs/KFD tree that amdsmi can be pointed at
+with RSMI_FS_ROOT, so that the library can be exercised and benchmarked
+on a machine without an AMD GPU.
+
+The tree holds, per GPU, the PCI device directory (ids, gpu_metrics,
+pm_metrics and reg_state blobs, pp_dpm_* tables, memory and busy files,
+RAS error counters, hwmon), the
+drm card and render nodes, and the KFD topology node with its io_links.
+Processes get /proc/<pid>/fd symlinks to the render nodes with matching
+DRM fdinfo, and a KFD proc entry with a queue on their GPU.
+
+  python3 fake_sysfs_tree.py -o /tmp/fake_root --gpus 8 --procs 2000
+  RSMI_FS_ROOT=/tmp/fake_root amd-smi list
+
+RSMI_FS_ROOT is only read by non-Release builds of the library and by builds
+configured with -DENABLE_TEST_OVERRIDES=ON.
+
+Only files are created: opening /dev/dri/renderD* or /dev/kfd in the tree
+does not reach a driver, so the KFD ioctl paths report errors. The libdrm
+ones do too, unless AMDSMI_LIBDRM_PATH points amdsmi at the fake libdrm
+built from tests/fake_libdrm, which answers the memory and device info
+queries.
+"""
+
+import os
+import argparse
+import ctypes
+import shutil
+import struct
+
+
+AMD_VENDOR_ID = 0x1002
+FIRST_RENDER_MINOR = 128
+
+# These *must* match rocm_smi/include/rocm_smi/rocm_smi_gpu_metrics.h
+MAX_NUM_HBM_INSTANCES = 4
+MAX_NUM_XGMI_LINKS = 8
+MAX_NUM_GFX_CLKS = 8
+MAX_NUM_CLKS = 4
+MAX_NUM_VCNS = 4
+MAX_JPEG_ENGINES = 32
+MAX_NUM_XCC = 8
+MAX_NUM_XCP = 8
+
+KFD_IOLINK_TYPE_PCIEXPRESS = 2
+KFD_IOLINK_TYPE_XGMI = 11
+
+# The blocks with a ras/<block>_err_count file
+RAS_ERR_COUNT_BLOCKS = ["umc", "sdma", "gfx", "mmhub", "pcie_bif", "hdp", "xgmi_wafl"]
+
+
+class GpuMetricsHeader(ctypes.Structure):
+    _fields_ = [("structure_size", ctypes.c_uint16),
+                ("format_revision", ctypes.c_uint8),
+                ("content_revision", ctypes.c_uint8)]
+
+
+class GpuMetricsV13(ctypes.Structure):
+    _fields_ = [("common_header", GpuMetricsHeader),
+                ("temperature_edge", ctypes.c_uint16),
+                ("temperature_hotspot", ctypes.c_uint16),
+                ("temperature_mem", ctypes.c_uint16),
+                ("temperature_vrgfx", ctypes.c_uint16),
+                ("temperature_vrsoc", ctypes.c_uint16),
+                ("temperature_vrmem", ctypes.c_uint16),
+                ("average_gfx_activity", ctypes.c_uint16),
+                ("average_umc_activity", ctypes.c_uint16),
+                ("average_mm_activity", ctypes.c_uint16),
+                ("average_socket_power", ctypes.c_uint16),
+                ("energy_accumulator", ctypes.c_uint64),
+                ("system_clock_counter", ctypes.c_uint64),
+                ("average_gfxclk_frequency", ctypes.c_uint16),
+                ("average_socclk_frequency", ctypes.c_uint16),
+                ("average_uclk_frequency", ctypes.c_uint16),
+                ("average_vclk0_frequency", ctypes.c_uint16),
+                ("average_dclk0_frequency", ctypes.c_uint16),
+                ("average_vclk1_frequency", ctypes.c_uint16),
+                ("average_dclk1_frequency", ctypes.c_uint16),
+                ("current_gfxclk", ctypes.c_uint16),
+                ("current_socclk", ctypes.c_uint16),
+                ("current_uclk", ctypes.c_uint16),
+                ("current_vclk0", ctypes.c_uint16),
+                ("current_dclk0", ctypes.c_uint16),
+                ("current_vclk1", ctypes.c_uint16),
+                ("current_dclk1", ctypes.c_uint16),
+                ("throttle_status", ctypes.c_uint32),
+                ("current_fan_speed", ctypes.c_uint16),
+                ("pcie_link_width", ctypes.c_uint16),
+                ("pcie_link_speed", ctypes.c_uint16),
+                ("padding", ctypes.c_uint16),
+                ("gfx_activity_acc", ctypes.c_uint32),
+                ("mem_activity_acc", ctypes.c_uint32),
+                ("temperature_hbm", ctypes.c_uint16 * MAX_NUM_HBM_INSTANCES),
+                ("firmware_timestamp", ctypes.c_uint64),
+                ("voltage_soc", ctypes.c_uint16),
+                ("voltage_gfx", ctypes.c_uint16),
+                ("voltage_mem", ctypes.c_uint16),
+                ("padding1", ctypes.c_uint16),
+                ("indep_throttle_status", ctypes.c_uint64)]
+
+
+# The fields shared by v1.4 and v1.5 up to the XGMI accumulators
+def _v14_fields(with_jpeg):
+    fields = [("common_header", GpuMetricsHeader),
+              ("temperature_hotspot", ctypes.c_uint16),
+              ("temperature_mem", ctypes.c_uint16),
+              ("temperature_vrsoc", ctypes.c_uint16),
+              ("current_socket_power", ctypes.c_uint16),
+              ("average_gfx_activity", ctypes.c_uint16),
+              ("average_umc_activity", ctypes.c_uint16),
+              ("vcn_activity", ctypes.c_uint16 * MAX_NUM_VCNS)]
+    if with_jpeg:
+        fields += [("jpeg_activity", ctypes.c_uint16 * MAX_JPEG_ENGINES)]
+    fields += [("energy_accumulator", ctypes.c_uint64),
+               ("system_clock_counter", ctypes.c_uint64),
+               ("throttle_status", ctypes.c_uint32),
+               ("gfxclk_lock_status", ctypes.c_uint32),
+               ("pcie_link_width", ctypes.c_uint16),
+               ("pcie_link_speed", ctypes.c_uint16),
+               ("xgmi_link_width", ctypes.c_uint16),
+               ("xgmi_link_speed", ctypes.c_uint16),
+               ("gfx_activity_acc", ctypes.c_uint32),
+               ("mem_activity_acc", ctypes.c_uint32),
+               ("pcie_bandwidth_acc", ctypes.c_uint64),
+               ("pcie_bandwidth_inst", ctypes.c_uint64),
+               ("pcie_l0_to_recov_count_acc", ctypes.c_uint64),
+               ("pcie_replay_count_acc", ctypes.c_uint64),
+               ("pcie_replay_rover_count_acc", ctypes.c_uint64)]
+    if with_jpeg:
+        fields += [("pcie_nak_sent_count_acc", ctypes.c_uint32),
+                   ("pcie_nak_rcvd_count_acc", ctypes.c_uint32)]
+    fields += _xgmi_and_clock_fields()
+    return fields
+
+
+def _xgmi_and_clock_fields():
+    return [("xgmi_read_data_acc", ctypes.c_uint64 * MAX_NUM_XGMI_LINKS),
+            ("xgmi_write_data_acc", ctypes.c_uint64 * MAX_NUM_XGMI_LINKS),
+            ("firmware_timestamp", ctypes.c_uint64),
+            ("current_gfxclk", ctypes.c_uint16 * MAX_NUM_GFX_CLKS),
+            ("current_socclk", ctypes.c_uint16 * MAX_NUM_CLKS),
+            ("current_vclk0", ctypes.c_uint16 * MAX_NUM_CLKS),
+            ("current_dclk0", ctypes.c_uint16 * MAX_NUM_CLKS),
+            ("current_uclk", ctypes.c_uint16)]
+
+
+class GpuMetricsV14(ctypes.Structure):
+    _fields_ = _v14_fields(False) + [("padding", ctypes.c_uint16)]
+
+
+class GpuMetricsV15(ctypes.Structure):
+    _fields_ = _v14_fields(True) + [("padding", ctypes.c_uint16)]
+
+
+class XcpMetrics(ctypes.Structure):
+    _fields_ = [("gfx_busy_inst", ctypes.c_uint32 * MAX_NUM_XCC),
+                ("jpeg_busy", ctypes.c_uint16 * MAX_JPEG_ENGINES),
+                ("vcn_busy", ctypes.c_uint16 * MAX_NUM_VCNS),
+                ("gfx_busy_acc", ctypes.c_uint64 * MAX_NUM_XCC)]
+
+
+class GpuMetricsV16(ctypes.Structure):
+    _fields_ = [("common_header", GpuMetricsHeader),
+                ("temperature_hotspot", ctypes.c_uint16),
+                ("temperature_mem", ctypes.c_uint16),
+                ("temperature_vrsoc", ctypes.c_uint16),
+                ("current_socket_power", ctypes.c_uint16),
+                ("average_gfx_activity", ctypes.c_uint16),
+                ("average_umc_activity", ctypes.c_uint16),
+                ("energy_accumulator", ctypes.c_uint64),
+                ("system_clock_counter", ctypes.c_uint64),
+                ("accumulation_counter", ctypes.c_uint32),
+                ("prochot_residency_acc", ctypes.c_uint32),
+                ("ppt_residency_acc", ctypes.c_uint32),
+                ("socket_thm_residency_acc", ctypes.c_uint32),
+                ("vr_thm_residency_acc", ctypes.c_uint32),
+                ("hbm_thm_residency_acc", ctypes.c_uint32),
+                ("gfxclk_lock_status", ctypes.c_uint32),
+                ("pcie_link_width", ctypes.c_uint16),
+                ("pcie_link_speed", ctypes.c_uint16),
+                ("xgmi_link_width", ctypes.c_uint16),
+                ("xgmi_link_speed", ctypes.c_uint16),
+                ("gfx_activity_acc", ctypes.c_uint32),
+                ("mem_activity_acc", ctypes.c_uint32),
+                ("pcie_bandwidth_acc", ctypes.c_uint64),
+                ("pcie_bandwidth_inst", ctypes.c_uint64),
+                ("pcie_l0_to_recov_count_acc", ctypes.c_uint64),
+                ("pcie_replay_count_acc", ctypes.c_uint64),
+                ("pcie_replay_rover_count_acc", ctypes.c_uint64),
+                ("pcie_nak_sent_count_acc", ctypes.c_uint32),
+                ("pcie_nak_rcvd_count_acc", ctypes.c_uint32)] + \
+               _xgmi_and_clock_fields() + \
+               [("num_partition", ctypes.c_uint16),
+                ("xcp_stats", XcpMetrics * MAX_NUM_XCP),
+                ("pcie_lc_perf_other_end_recovery", ctypes.c_uint32)]
+
+
+GPU_METRICS = {3: GpuMetricsV13, 4: GpuMetricsV14, 5: GpuMetricsV15, 6: GpuMetricsV16}
+
+
+def gpu_metrics_blob(content_revision, gpu):
+    metrics_type = GPU_METRICS[content_revision]
+    metrics = metrics_type()
+    metrics.common_header.structure_size = ctypes.sizeof(metrics_type)
+    metrics.common_header.format_revision = 1
+    metrics.common_header.content_revision = content_revision
+
+    values = {"temperature_edge": 40 + gpu,
+              "temperature_hotspot": 45 + gpu,
+              "temperature_mem": 50 + gpu,
+              "temperature_vrsoc": 38,
+              "average_socket_power": 150,
+              "current_socket_power": 300 + gpu,
+              "average_gfx_activity": 10 * (gpu % 10),
+              "average_umc_activity": 5,
+              "energy_accumulator": 123456789 * (gpu + 1),
+              "system_clock_counter": 1000000000,
+              "firmware_timestamp": 1000000,
+              "accumulation_counter": 1000,
+              "gfx_activity_acc": 5000,
+              "mem_activity_acc": 2500,
+              "pcie_link_width": 16,
+              "pcie_link_speed": 320,
+              "xgmi_link_width": 16,
+              "xgmi_link_speed": 32,
+              "pcie_bandwidth_acc": 1 << 20,
+              "pcie_bandwidth_inst": 12,
+              "current_gfxclk": 1500,
+              "current_socclk": 1000,
+              "current_uclk": 1200,
+              "num_partition": 1}
+    for name, value in values.items():
+        field = dict(metrics._fields_).get(name)
+        if field is None:
+            continue
+        if hasattr(field, "_length_"):
+            for i in range(field._length_):
+                getattr(metrics, name)[i] = value
+        else:
+            setattr(metrics, name, value)
+
+    if content_revision >= 4:
+        for link in range(MAX_NUM_XGMI_LINKS):
+            metrics.xgmi_read_data_acc[link] = 1 << 30
+            metrics.xgmi_write_data_acc[link] = 1 << 29
+    if content_revision == 6:
+        metrics.xcp_stats[0].gfx_busy_inst[0] = 10 * (gpu % 10)
+    return bytes(metrics)
+
+
+# pm_metrics of pmmetrics_version 4 (smu_13_0_6_v8 in
+# rocm_smi/src/rocm_smi_binary_parser.cc), 1740 bytes long. The blobs of this
+# and reg_state_blob() are built the same way, and decoded, by
+# tests/amd_smi_test/unit/metrics_table_decoder.cc.
+PM_METRICS_VERSION = 4
+PM_METRICS_SIZE = 1740
+
+
+def pm_metrics_blob(gpu):
+    blob = bytearray((i * 7 + gpu) & 0xff for i in range(PM_METRICS_SIZE))
+    struct.pack_into("<HHIII", blob, 0, PM_METRICS_SIZE, 0, 0x0d000006,
+                     0x00556d00, PM_METRICS_VERSION)
+    return bytes(blob)
+
+
+# reg_state sections, each at a 4 KB offset: (instances, registers per
+# instance, PCIe status fields)
+REG_STATE_SECTIONS = [(8, 2, False),   # XGMI
+                      (2, 1, False),   # WAFL
+                      (1, 4, True),    # PCIe
+                      (1, 4, False),   # USR
+                      (1, 4, False)]   # USR_1
+
+
+def reg_state_blob(gpu):
+    blob = bytearray(len(REG_STATE_SECTIONS) * 0x1000)
+    for section, (instances, regs, pcie) in enumerate(REG_STATE_SECTIONS):
+        body = bytearray()
+        for inst in range(instances):
+            body += struct.pack("<HHHH", inst, 1, regs, 0)
+            if pcie:
+                body += struct.pack("<HHIII", 0x10, 0x1043, 0, 0, 0)
+            for reg in range(regs):
+                body += struct.pack("<QII", 0x11a00000 + 0x100 * inst + 4 * reg,
+                                    1000 * (gpu + 1) + 16 * inst + reg, 0)
+        header = struct.pack("<HBBBBH", 8 + len(body), 1, 0, section, instances, 0)
+        blob[section * 0x1000:section * 0x1000 + 8 + len(body)] = header + body
+    return bytes(blob)
+
+
+def write_file(path, content):
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    mode = "wb" if isinstance(content, bytes) else "w"
+    with open(path, mode) as f:
+        f.write(content)
+
+
+def symlink(target, path):
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    os.symlink(target, path)
+
+
+def dpm_table(levels, current):
+    return "".join("%d: %dMhz%s\n" % (i, level, " *" if i == current else "")
+                   for i, level in enumerate(levels))
+
+
+def make_gpu(root, gpu, args):
+    # One PCI bus per GPU, the bus number is 8 bits
+    bus = 0x10 + gpu
+    bdf = "0000:%02x:00.0" % bus
+    card = "card%d" % gpu
+    render = "renderD%d" % (FIRST_RENDER_MINOR + gpu)
+    unique_id = 0x1000 + gpu
+
+    dev_rel = os.path.join("sys", "devices", "pci0000:00", bdf)
+    dev = os.path.join(root, dev_rel)
+    files = {
+        "vendor": "0x%04x\n" % AMD_VENDOR_ID,
+        "device": "0x%04x\n" % args.device_id,
+        "revision": "0x00\n",
+        "subsystem_vendor": "0x%04x\n" % AMD_VENDOR_ID,
+        "subsystem_device": "0x0c34\n",
+        "unique_id": "%x\n" % unique_id,
+        "serial_number": "FAKE%012x\n" % unique_id,
+        "product_name": "Synthetic AMD Instinct\n",
+        "vbios_version": "113-FAKE-000\n",
+        "power_dpm_force_performance_level": "auto\n",
+        "pp_dpm_sclk": dpm_table([500, 1200, 1700, 2100], 1),
+        "pp_dpm_mclk": dpm_table([900, 1300], 1),
+        "pp_dpm_fclk": dpm_table([1200, 1600], 0),
+        "pp_dpm_socclk": dpm_table([800, 1100], 0),
+        "pp_dpm_pcie": "0: 2.5GT/s, x1 97Mhz\n1: 32.0GT/s, x16 619Mhz *\n",
+        "mem_info_vram_total": "%d\n" % (64 << 30),
+        "mem_info_vram_used": "%d\n" % ((1 << 30) * (gpu + 1)),
+        "mem_info_vis_vram_total": "%d\n" % (64 << 30),
+        "mem_info_vis_vram_used": "%d\n" % ((1 << 30) * (gpu + 1)),
+        "mem_info_gtt_total": "%d\n" % (128 << 30),
+        "mem_info_gtt_used": "%d\n" % (16 << 20),
+        "gpu_busy_percent": "%d\n" % (10 * (gpu % 10)),
+        "mem_busy_percent": "5\n",
+        "current_link_speed": "32.0 GT/s PCIe\n",
+        "current_link_width": "16\n",
+        "max_link_speed": "32.0 GT/s PCIe\n",
+        "max_link_width": "16\n",
+        "current_compute_partition": "SPX\n",
+        "available_compute_partition": "SPX, DPX, QPX, CPX\n",
+        "current_memory_partition": "NPS1\n",
+        "gpu_metrics": gpu_metrics_blob(args.metrics_version, gpu),
+        "pm_metrics": pm_metrics_blob(gpu),
+        "reg_state": reg_state_blob(gpu),
+    }
+    # Every block up to XGMI_WAFL has ECC enabled; ATHUB has no counter file
+    files["ras/features"] = "feature mask: 0x%08x\n" % 0xff
+    for i, block in enumerate(RAS_ERR_COUNT_BLOCKS):
+        files["ras/%s_err_count" % block] = "ue: %d\nce: %d\nde: %d\n" % (
+            gpu % 2, 10 * gpu + i, i % 3)
+    for name, content in files.items():
+        write_file(os.path.join(dev, name), content)
+
+    hwmon = os.path.join(dev, "hwmon", "hwmon%d" % gpu)
+    hwmon_files = {
+        "name": "amdgpu\n",
+        "temp1_input": "%d\n" % ((40 + gpu) * 1000),
+        "temp1_label": "edge\n",
+        "temp2_input": "%d\n" % ((45 + gpu) * 1000),
+        "temp2_label": "junction\n",
+        "temp3_input": "%d\n" % ((50 + gpu) * 1000),
+        "temp3_label": "mem\n",
+        "power1_average": "%d\n" % (300 * 1000000),
+        "power1_cap": "%d\n" % (750 * 1000000),
+        "power1_cap_max": "%d\n" % (750 * 1000000),
+        "in0_input": "800\n",
+        "in0_label": "vddgfx\n",
+        "fan1_input": "0\n",
+    }
+    for name, content in hwmon_files.items():
+        write_file(os.path.join(hwmon, name), content)
+    symlink(os.path.join("..", "..", "..", "..", "..", "class", "hwmon"),
+            os.path.join(hwmon, "subsystem"))
+    symlink(os.path.join("..", "..", "devices", "pci0000:00", bdf, "hwmon", "hwmon%d" % gpu),
+            os.path.join(root, "sys", "class", "hwmon", "hwmon%d" % gpu))
+
+    # drm/cardN/device -> the PCI device, as in the real sysfs
+    for node in (card, render):
+        os.makedirs(os.path.join(dev, "drm", node))
+        symlink(os.path.join("..", ".."), os.path.join(dev, "drm", node, "device"))
+        symlink(os.path.join("..", "..", "devices", "pci0000:00", bdf, "drm", node),
+                os.path.join(root, "sys", "class", "drm", node))
+    symlink(os.path.join("..", "..", "..", "devices", "pci0000:00", bdf),
+            os.path.join(root, "sys", "bus", "pci", "devices", bdf))
+    write_file(os.path.join(root, "dev", "dri", render), "")
+    write_file(os.path.join(root, "dev", "dri", card), "")
+
+    return {"bdf": bdf, "bus": bus, "unique_id": unique_id, "render": render,
+            "gpu_id": 0x8000 + gpu}
+
+
+def write_properties(path, props):
+    write_file(path, "".join("%s %d\n" % (key, value) for key, value in props))
+
+
+def make_kfd(root, gpus, args):
+    nodes = os.path.join(root, "sys", "class", "kfd", "kfd", "topology", "nodes")
+    os.makedirs(os.path.join(root, "sys", "class", "kfd", "kfd", "proc"), exist_ok=True)
+    write_file(os.path.join(root, "sys", "class", "kfd", "kfd", "topology",
+                            "generation_id"), "1\n")
+    write_file(os.path.join(root, "sys", "class", "kfd", "kfd", "topology",
+                            "system_properties"), "platform_oem 0\nplatform_id 0\n")
+
+    # Node 0 is the CPU (gpu_id 0), the GPUs follow
+    cpu = os.path.join(nodes, "0")
+    write_file(os.path.join(cpu, "gpu_id"), "0\n")
+    write_file(os.path.join(cpu, "name"), "\n")
+    write_properties(os.path.join(cpu, "properties"),
+                     [("cpu_cores_count", 64), ("simd_count", 0),
+                      ("mem_banks_count", 1), ("caches_count", 0),
+                      ("io_links_count", len(gpus)), ("location_id", 0),
+                      ("domain", 0), ("unique_id", 0)])
+    for i, gpu in enumerate(gpus):
+        write_properties(os.path.join(cpu, "io_links", str(i), "properties"),
+                         [("type", KFD_IOLINK_TYPE_PCIEXPRESS), ("version_major", 0),
+                          ("version_minor", 0), ("node_from", 0), ("node_to", i + 1),
+                          ("weight", 20), ("min_latency", 0), ("max_latency", 0),
+                          ("min_bandwidth", 312), ("max_bandwidth", 64000),
+                          ("recommended_transfer_size", 0), ("flags", 1)])
+
+    for i, gpu in enumerate(gpus):
+        node_id = i + 1
+        node = os.path.join(nodes, str(node_id))
+        write_file(os.path.join(node, "gpu_id"), "%d\n" % gpu["gpu_id"])
+        write_file(os.path.join(node, "name"), "gfx942\n")
+        location_id = gpu["bus"] << 8
+        write_properties(os.path.join(node, "properties"),
+                         [("cpu_cores_count", 0), ("simd_count", 1216),
+                          ("mem_banks_count", 1), ("caches_count", 1),
+                          ("io_links_count", len(gpus)), ("p2p_links_count", 0),
+                          ("cpu_core_id_base", 0), ("simd_id_base", 0x80000000 + i),
+                          ("max_waves_per_simd", 8), ("lds_size_in_kb", 64),
+                          ("gds_size_in_kb", 0), ("num_gws", 64),
+                          ("wave_front_size", 64), ("array_count", 32),
+                          ("simd_arrays_per_engine", 1), ("cu_per_simd_array", 10),
+                          ("simd_per_cu", 4), ("max_slots_scratch_cu", 32),
+                          ("gfx_target_version", 90402),
+                          ("vendor_id", AMD_VENDOR_ID), ("device_id", args.device_id),
+                          ("location_id", location_id), ("domain", 0),
+                          ("drm_render_minor", FIRST_RENDER_MINOR + i),
+                          ("hive_id", 0x7e57 if len(gpus) > 1 else 0),
+                          ("num_sdma_engines", 2), ("num_sdma_xgmi_engines", 14),
+                          ("num_sdma_queues_per_engine", 8), ("num_cp_queues", 24),
+                          ("max_engine_clk_fcompute", 2100),
+                          ("local_mem_size", 0), ("fw_version", 151),
+                          ("capability", 0x28a8000), ("debug_prop", 0),
+                          ("sdma_fw_version", 19), ("unique_id", gpu["unique_id"]),
+                          ("num_xcc", 8), ("max_engine_clk_ccompute", 3700)])
+        write_properties(os.path.join(node, "mem_banks", "0", "properties"),
+                         [("heap_type", 1), ("size_in_bytes", 64 << 30), ("flags", 0),
+                          ("width", 8192), ("mem_clk_max", 1300)])
+        write_properties(os.path.join(node, "caches", "0", "properties"),
+                         [("processor_id_low", 0x80000000 + i), ("level", 1),
+                          ("size", 32), ("cache_line_size", 128),
+                          ("cache_lines_per_tag", 1), ("association", 4),
+                          ("latency", 1), ("type", 5)])
+
+        # A PCIe link back to the CPU, and XGMI links to all the other GPUs
+        link = 0
+        write_properties(os.path.join(node, "io_links", str(link), "properties"),
+                         [("type", KFD_IOLINK_TYPE_PCIEXPRESS), ("version_major", 0),
+                          ("version_minor", 0), ("node_from", node_id), ("node_to", 0),
+                          ("weight", 20), ("min_latency", 0), ("max_latency", 0),
+                          ("min_bandwidth", 312), ("max_bandwidth", 64000),
+                          ("recommended_transfer_size", 0), ("flags", 1)])
+        for j in range(len(gpus)):
+            if j == i:
+                continue
+            link += 1
+            write_properties(os.path.join(node, "io_links", str(link), "properties"),
+                             [("type", KFD_IOLINK_TYPE_XGMI), ("version_major", 0),
+                              ("version_minor", 0), ("node_from", node_id),
+                              ("node_to", j + 1), ("weight", 15), ("min_latency", 0),
+                              ("max_latency", 0), ("min_bandwidth", 50000),
+                              ("max_bandwidth", 50000), ("recommended_transfer_size", 0),
+                              ("flags", 1)])
+
+    write_file(os.path.join(root, "dev", "kfd"), "")
+
+
+def make_procs(root, gpus, args):
+    proc = os.path.join(root, "proc")
+    write_file(os.path.join(proc, "version"),
+               "Linux version 6.8.0-fake (fake_sysfs_tree.py)\n")
+    write_file(os.path.join(proc, "cpuinfo"), "".join(
+        "processor\t: %d\nvendor_id\t: AuthenticAMD\nmodel name\t: Fake EPYC\n\n" % i
+        for i in range(4)))
+    # Keys the discovery cache (RSMI_DISCOVERY_CACHE)
+    write_file(os.path.join(proc, "sys", "kernel", "random", "boot_id"),
+               "00000000-0000-4000-8000-%012x\n" % len(gpus))
+
+    first_pid = 1000
+    for p in range(args.procs):
+        pid = first_pid + p
+        pid_dir = os.path.join(proc, str(pid))
+        write_file(os.path.join(pid_dir, "comm"), "fake_app_%d\n" % p)
+        write_file(os.path.join(pid_dir, "cgroup"), "0::/user.slice\n")
+        # Field 22 is the start time
+        write_file(os.path.join(pid_dir, "stat"), "%d (fake_app_%d) S %s\n"
+                   % (pid, p, " ".join(["0"] * 19 + [str(100 + p)])))
+        # A few non-DRM fds before the DRM one, as most processes have
+        os.makedirs(os.path.join(pid_dir, "fd"))
+        os.makedirs(os.path.join(pid_dir, "fdinfo"))
+        for fd in range(args.fds_per_proc):
+            os.symlink("/dev/null", os.path.join(pid_dir, "fd", str(fd)))
+            write_file(os.path.join(pid_dir, "fdinfo", str(fd)), "pos:\t0\nflags:\t02\n")
+        gpu = gpus[p % len(gpus)]
+        fd = args.fds_per_proc
+        os.symlink("/dev/dri/" + gpu["render"], os.path.join(pid_dir, "fd", str(fd)))
+        write_file(os.path.join(pid_dir, "fdinfo", str(fd)),
+                   "pos:\t0\nflags:\t02100002\nmnt_id:\t24\nino:\t%d\n"
+                   "drm-driver:\tamdgpu\n"
+                   "drm-client-id:\t%d\n"
+                   "drm-pdev:\t%s\n"
+                   "pasid:\t%d\n"
+                   "drm-memory-vram:\t%d KiB\n"
+                   "drm-memory-gtt:\t2048 KiB\n"
+                   "drm-memory-cpu:\t0 KiB\n"
+                   "drm-engine-gfx:\t%d ns\n"
+                   "drm-engine-compute:\t0 ns\n"
+                   "drm-engine-enc:\t0 ns\n"
+                   % (1000 + p, p + 1, gpu["bdf"], 32768 + p,
+                      1024 * (p % 64 + 1), 1000000 * (p + 1)))
+
+        # The KFD view of the same process, used for the compute process list
+        kfd_proc = os.path.join(root, "sys", "class", "kfd", "kfd", "proc", str(pid))
+        write_file(os.path.join(kfd_proc, "pasid"), "%d\n" % (32768 + p))
+        write_file(os.path.join(kfd_proc, "queues", "0", "gpuid"), "%d\n" % gpu["gpu_id"])
+        write_file(os.path.join(kfd_proc, "vram_%d" % gpu["gpu_id"]),
+                   "%d\n" % (1048576 * (p % 64 + 1)))
+        write_file(os.path.join(kfd_proc, "sdma_%d" % gpu["gpu_id"]), "0\n")
+        write_file(os.path.join(kfd_proc, "stats_%d" % gpu["gpu_id"], "cu_occupancy"),
+                   "%d\n" % (p % 10))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Build a synthetic sysfs/procfs/KFD tree for RSMI_FS_ROOT")
+    parser.add_argument("-o", "--output", required=True,
+                        help="root directory of the tree, replaced if it exists")
+    parser.add_argument("--gpus", type=int, default=8, help="number of GPUs")
+    parser.add_argument("--metrics-version", type=int, default=6,
+                        choices=sorted(GPU_METRICS.keys()),
+                        help="gpu_metrics v1.x content revision")
+    parser.add_argument("--procs", type=int, default=100,
+                        help="number of processes with a DRM fd")
+    parser.add_argument("--fds-per-proc", type=int, default=3,
+                        help="non-DRM fds per process")
+    parser.add_argument("--device-id", type=lambda s: int(s, 0), default=0x74a1,
+                        help="PCI device id of the GPUs")
+    args = parser.parse_args()
+
+    if args.gpus < 1 or args.gpus > 0xff - 0x10:
+        parser.error("--gpus must be between 1 and %d" % (0xff - 0x10))
+
+    root = os.path.abspath(args.output)
+    if os.path.exists(root):
+        shutil.rmtree(root)
+
+    write_file(os.path.join(root, "sys", "module", "amdgpu", "version"), "6.8.5\n")
+    write_file(os.path.join(root, "sys", "module", "amdgpu", "initstate"), "live\n")
+    os.makedirs(os.path.join(root, "sys", "kernel", "debug", "dri"))
+
+    gpus = [make_gpu(root, gpu, args) for gpu in range(args.gpus)]
+    make_kfd(root, gpus, args)
+    make_procs(root, gpus, args)
+
+    print("Created %d GPUs and %d processes under %s" % (args.gpus, args.procs, root))
+    print("Use it with: RSMI_FS_ROOT=%s" % root)
+
+
+if __name__ == "__main__":
+    main()